@@ -57,6 +57,24 @@ Target Device: cc23xx
 #include <ti/bleapp/menu_module/menu_module.h>
 #include <app_main.h>
 
+//*****************************************************************************
+//! Defines
+//*****************************************************************************
+// Size of the connection handle hash table, twice the number of slots keeps
+// the probe sequences short
+#define CONNECTION_MAP_SIZE         (2 * MAX_NUM_BLE_CONNS)
+
+// Empty entry of the connection handle hash table
+#define CONNECTION_MAP_EMPTY        0xFF
+
+// The extension storage is handed out in words
+#define CONNECTION_EXT_WORDS        ((CONNECTION_EXT_SIZE + 3) / 4)
+
+// Extension ids are word offsets held in a uint8_t, below CONNECTION_EXT_INVALID
+#if CONNECTION_EXT_WORDS >= CONNECTION_EXT_INVALID
+#error "CONNECTION_EXT_SIZE is too large for uint8_t extension ids"
+#endif
+
 //*****************************************************************************
 //! Prototypes
 //*****************************************************************************
@@ -65,6 +83,7 @@ void Connection_HciGAPEventHandler(uint32 event, BLEAppUtil_msgHdr_t *pMsgData);
 
 static uint8_t Connection_addConnInfo(uint16_t connHandle, uint8_t *pAddr);
 static uint8_t Connection_removeConnInfo(uint16_t connHandle);
+static uint8_t Connection_findMapEntry(uint16_t connHandle);
 
 //*****************************************************************************
 //! Globals
@@ -90,9 +109,22 @@ BLEAppUtil_EventHandler_t connectionHciGAPHandler =
                       BLEAPPUTIL_HCI_LE_EVENT_CODE
 };
 
-// Holds the connection handles
+// Holds the connection handles. An entry keeps its index for as long as
+// the connection is up, free entries have LINKDB_CONNHANDLE_INVALID.
 static App_connInfo connectionConnList[MAX_NUM_BLE_CONNS];
 
+// Open addressing hash table from connection handle to connectionConnList
+// index, CONNECTION_MAP_EMPTY for unused entries
+static uint8_t connectionHandleMap[CONNECTION_MAP_SIZE];
+
+// Stack of the free connectionConnList indexes
+static uint8_t connectionFreeSlots[MAX_NUM_BLE_CONNS];
+static uint8_t connectionNumFree;
+
+// Per connection storage of the modules registered with Connection_registerExt
+static uint32_t connectionExt[MAX_NUM_BLE_CONNS][CONNECTION_EXT_WORDS];
+static uint16_t connectionExtUsed;
+
 //*****************************************************************************
 //! Functions
 //*****************************************************************************
@@ -300,20 +332,30 @@ void Connection_HciGAPEventHandler(uint32 event, BLEAppUtil_msgHdr_t *pMsgData)
  */
 static uint8_t Connection_addConnInfo(uint16_t connHandle, uint8_t *pAddr)
 {
-  uint8_t i = 0;
+  uint8_t i;
+  uint8_t entry;
 
-  for (i = 0; i < MAX_NUM_BLE_CONNS; i++)
+  entry = Connection_findMapEntry(connHandle);
+  if (connectionHandleMap[entry] != CONNECTION_MAP_EMPTY)
   {
-    if (connectionConnList[i].connHandle == LINKDB_CONNHANDLE_INVALID)
-    {
-      // Found available entry to put a new connection info in
-      connectionConnList[i].connHandle = connHandle;
-      memcpy(connectionConnList[i].peerAddress, pAddr, B_ADDR_LEN);
+    // Already in the list
+    return connectionHandleMap[entry];
+  }
 
-      break;
-    }
+  if (connectionNumFree == 0)
+  {
+    return MAX_NUM_BLE_CONNS;
   }
 
+  // Take a free entry to put a new connection info in
+  i = connectionFreeSlots[--connectionNumFree];
+  connectionConnList[i].connHandle = connHandle;
+  connectionConnList[i].notifyCbCnt = 0;
+  memcpy(connectionConnList[i].peerAddress, pAddr, B_ADDR_LEN);
+  memset(connectionExt[i], 0, sizeof(connectionExt[i]));
+
+  connectionHandleMap[entry] = i;
+
   return i;
 }
 
@@ -328,43 +370,63 @@ static uint8_t Connection_addConnInfo(uint16_t connHandle, uint8_t *pAddr)
  */
 static uint8_t Connection_removeConnInfo(uint16_t connHandle)
 {
-  uint8_t i = 0;
-  uint8_t index = 0;
-  uint8_t maxNumConn = MAX_NUM_BLE_CONNS;
+  uint8_t index;
+  uint8_t entry;
+  uint8_t next;
 
-  for (i = 0; i < maxNumConn; i++)
+  entry = Connection_findMapEntry(connHandle);
+  index = connectionHandleMap[entry];
+  if (index == CONNECTION_MAP_EMPTY)
   {
-    if (connectionConnList[i].connHandle == connHandle)
-    {
-      // Mark the entry as deleted
-      connectionConnList[i].connHandle = LINKDB_CONNHANDLE_INVALID;
-
-      break;
-    }
+    return MAX_NUM_BLE_CONNS;
   }
 
-  // Save the index to return
-  index = i;
+  // Mark the entry as deleted, the other entries keep their index
+  connectionConnList[index].connHandle = LINKDB_CONNHANDLE_INVALID;
+  connectionFreeSlots[connectionNumFree++] = index;
 
-  // Shift the items in the array
-  for(i = 0; i < maxNumConn - 1; i++)
+  // Remove the handle from the hash table and move back the entries of the
+  // probe sequence that follows, so that lookups never need tombstones
+  connectionHandleMap[entry] = CONNECTION_MAP_EMPTY;
+  next = (entry + 1) % CONNECTION_MAP_SIZE;
+  while (connectionHandleMap[next] != CONNECTION_MAP_EMPTY)
   {
-      if (connectionConnList[i].connHandle == LINKDB_CONNHANDLE_INVALID &&
-          connectionConnList[i + 1].connHandle == LINKDB_CONNHANDLE_INVALID)
-      {
-        break;
-      }
-      if (connectionConnList[i].connHandle == LINKDB_CONNHANDLE_INVALID &&
-          connectionConnList[i + 1].connHandle != LINKDB_CONNHANDLE_INVALID)
-      {
-        memmove(&connectionConnList[i], &connectionConnList[i+1], sizeof(App_connInfo));
-        connectionConnList[i + 1].connHandle = LINKDB_CONNHANDLE_INVALID;
-      }
+    uint8_t moved = connectionHandleMap[next];
+    uint8_t home;
+
+    connectionHandleMap[next] = CONNECTION_MAP_EMPTY;
+    home = Connection_findMapEntry(connectionConnList[moved].connHandle);
+    connectionHandleMap[home] = moved;
+
+    next = (next + 1) % CONNECTION_MAP_SIZE;
   }
 
   return index;
 }
 
+/*********************************************************************
+ * @fn      Connection_findMapEntry
+ *
+ * @brief   Find the entry of a connection handle in the hash table
+ *
+ * @return  the entry holding connHandle, or the empty entry where it
+ *          should be added
+ */
+static uint8_t Connection_findMapEntry(uint16_t connHandle)
+{
+  // The stack hands out connection handles from 0, so in practice the
+  // first probe hits
+  uint8_t entry = connHandle % CONNECTION_MAP_SIZE;
+
+  while (connectionHandleMap[entry] != CONNECTION_MAP_EMPTY &&
+         connectionConnList[connectionHandleMap[entry]].connHandle != connHandle)
+  {
+    entry = (entry + 1) % CONNECTION_MAP_SIZE;
+  }
+
+  return entry;
+}
+
 /*********************************************************************
  * @fn      Connection_getConnList
  *
@@ -411,10 +473,17 @@ bStatus_t Connection_start()
     bStatus_t status = SUCCESS;
     uint8 i;
 
-    // Initialize the connList handles
+    // Initialize the connList handles, the lowest index is used first
     for (i = 0; i < MAX_NUM_BLE_CONNS; i++)
     {
         connectionConnList[i].connHandle = LINKDB_CONNHANDLE_INVALID;
+        connectionFreeSlots[i] = MAX_NUM_BLE_CONNS - 1 - i;
+    }
+    connectionNumFree = MAX_NUM_BLE_CONNS;
+
+    for (i = 0; i < CONNECTION_MAP_SIZE; i++)
+    {
+        connectionHandleMap[i] = CONNECTION_MAP_EMPTY;
     }
 
     status = BLEAppUtil_registerEventHandler(&connectionConnHandler);
@@ -442,17 +511,58 @@ bStatus_t Connection_start()
  */
 uint16_t Connection_getConnIndex(uint16_t connHandle)
 {
-  uint8_t i;
+  uint8_t index = connectionHandleMap[Connection_findMapEntry(connHandle)];
 
-  for (i = 0; i < MAX_NUM_BLE_CONNS; i++)
+  if (index == CONNECTION_MAP_EMPTY)
   {
-    if (connectionConnList[i].connHandle == connHandle)
-    {
-      return i;
-    }
+    return LL_INACTIVE_CONNECTIONS;
+  }
+
+  return index;
+}
+
+/*********************************************************************
+ * @fn      Connection_registerExt
+ *
+ * @brief   Reserve per connection storage for a module
+ *
+ * @return  extension id, or CONNECTION_EXT_INVALID if size is 0 or there
+ *          is no room
+ */
+uint8_t Connection_registerExt(uint16_t size)
+{
+  uint8_t extId = (uint8_t)connectionExtUsed;
+  uint32_t words = ((uint32_t)size + 3) / 4;
+
+  // An empty extension would share its id with the next one
+  if (words == 0 || words > CONNECTION_EXT_WORDS - connectionExtUsed)
+  {
+    return CONNECTION_EXT_INVALID;
+  }
+
+  connectionExtUsed += words;
+
+  // The id is the word offset of the storage in each connection
+  return extId;
+}
+
+/*********************************************************************
+ * @fn      Connection_getExt
+ *
+ * @brief   Get the storage of a module for a connection
+ *
+ * @return  pointer to the storage, NULL if connHandle is not in the list
+ */
+void *Connection_getExt(uint16_t connHandle, uint8_t extId)
+{
+  uint16_t index = Connection_getConnIndex(connHandle);
+
+  if (index == LL_INACTIVE_CONNECTIONS || extId >= connectionExtUsed)
+  {
+    return NULL;
   }
 
-  return LL_INACTIVE_CONNECTIONS;
+  return &connectionExt[index][extId];
 }
 
 #endif // ( HOST_CONFIG & (CENTRAL_CFG | PERIPHERAL_CFG) )
@@ -139,6 +139,8 @@ According to the User Guide
 #include "ti_ble_config.h"
 #include <ti/bleapp/ble_app_util/inc/bleapputil_api.h>
 #include <ti/bleapp/menu_module/menu_module.h>
+#include <ti/drivers/dpl/ClockP.h>
+#include "util.h"
 #include <app_main.h>
 
 /*********************************************************************
@@ -148,25 +150,100 @@ According to the User Guide
 /*********************************************************************
  * CONSTANTS
  */
+// Maximum number of channels served at the same time, over all connections
+#ifndef L2CAPCOC_MAX_CHANNELS
+#define L2CAPCOC_MAX_CHANNELS       MAX_NUM_BLE_CONNS
+#endif
+
+// Number of received SDUs that can wait for transmission on one channel.
+// The queue holds the received buffers themselves, no data is copied.
+#ifndef L2CAPCOC_TX_QUEUE_LEN
+#define L2CAPCOC_TX_QUEUE_LEN       4
+#endif
+
+// Data modes
+#define L2CAPCOC_MODE_ECHO          0   //!< Swap the case of each SDU and send it back
+#define L2CAPCOC_MODE_SINK          1   //!< Count and release received SDUs
+#define L2CAPCOC_MODE_BENCH         2   //!< Stream MTU sized SDUs as fast as credits allow
+
+#ifndef L2CAPCOC_DATA_MODE
+#define L2CAPCOC_DATA_MODE          L2CAPCOC_MODE_ECHO
+#endif
+
+// Interval between two per-channel throughput reports, in milliseconds
+#ifndef L2CAPCOC_REPORT_PERIOD_MS
+#define L2CAPCOC_REPORT_PERIOD_MS   1000
+#endif
+
+// Delay before sending again after the stack refused an SDU, in milliseconds
+#ifndef L2CAPCOC_RETRY_MS
+#define L2CAPCOC_RETRY_MS           100
+#endif
+
+// Number of menu lines available for per-channel reports
+#define L2CAPCOC_REPORT_LINES       (APP_MENU_PROFILE_STATUS_LINE4 - APP_MENU_PROFILE_STATUS_LINE2 + 1)
+
+#define L2CAPCOC_INVALID_CID        0
+
 /*********************************************************************
  * TYPEDEFS
  */
 /// @brief Application data format (src/dst CIDs are relative to sender of request).
 typedef struct
 {
-  uint16 connHandle;   //!< The connection handle
-  uint16 CID;          //!< L2CAP CID - characterizes given logical connection between this and the peer device
-  uint16 peerCID;      //!< L2CAP peer CID - characterizes given logical connection at the peer device
   uint16 PSM;          //!< PSM - Protocol/Service Multiplexer ID
   uint16 peerPSM;      //!< peer PSM - peer Protocol/Service Multiplexer ID
   uint8 taskId;        //!< Task registered with PSM
+  uint8 numConns;      //!< Number of connections the PSM is registered for
 } gL2CAPCOC_AppData_t;
 
+/// @brief SDU waiting for transmission, owned by the application
+typedef struct
+{
+  uint8 *pPayload;     //!< Buffer allocated by the stack
+  uint16 len;          //!< Length of the SDU
+} L2CAPCOC_sdu_t;
+
+/// @brief Per channel state
+typedef struct
+{
+  uint16 connHandle;   //!< The connection handle
+  uint16 CID;          //!< L2CAP CID, L2CAPCOC_INVALID_CID if the entry is free
+  uint16 peerCID;      //!< L2CAP peer CID
+  uint16 peerMtu;      //!< Largest SDU the peer can receive
+  uint8 txBusy;        //!< An SDU is being transmitted by the stack
+  uint8 creditsHeld;   //!< Returning credits to the peer is deferred
+  uint8 qHead;         //!< Oldest entry of txQueue
+  uint8 qCount;        //!< Number of entries in txQueue
+  L2CAPCOC_sdu_t txQueue[L2CAPCOC_TX_QUEUE_LEN];
+  uint32 txStart;      //!< Tick at which the SDU in flight was posted
+  uint32 txBytes;      //!< Bytes sent since the last report
+  uint32 rxBytes;      //!< Bytes received since the last report
+  uint32 txLatency;    //!< Sum of SDU completion times since the last report, in ticks
+  uint16 txSdus;       //!< SDUs completed since the last report
+  uint16 drops;        //!< SDUs dropped since the channel was opened
+} L2CAPCOC_channel_t;
+
 /*********************************************************************
  * GLOBAL VARIABLES
  */
 gL2CAPCOC_AppData_t gL2CAPCOC_AppData;
 
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+static L2CAPCOC_channel_t L2CAPCOC_channels[L2CAPCOC_MAX_CHANNELS];
+
+// System tick of the last throughput report
+static uint32 L2CAPCOC_lastReport;
+
+// Connections that counted in gL2CAPCOC_AppData.numConns, free entries
+// have LINKDB_CONNHANDLE_INVALID
+static uint16 L2CAPCOC_psmConns[MAX_NUM_BLE_CONNS];
+
+// Retries the transmission after the stack refused an SDU
+static Clock_Struct L2CAPCOC_retryClk;
+
 /*********************************************************************
  * EXTERNAL VARIABLES
  */
@@ -180,6 +257,17 @@ void L2CAPCOC_connEventHandler(uint32 event, BLEAppUtil_msgHdr_t *pMsgData);
 
 static bStatus_t L2CAPCOC_openCoc(uint16_t connHandle);
 static bStatus_t L2CAPCOC_closeCoc(uint16_t connHandle);
+static L2CAPCOC_channel_t *L2CAPCOC_findChannel(uint16 connHandle, uint16 CID);
+static void L2CAPCOC_releaseChannel(L2CAPCOC_channel_t *pChannel);
+static void L2CAPCOC_queueSdu(L2CAPCOC_channel_t *pChannel, uint8 *pPayload, uint16 len);
+static void L2CAPCOC_sendNext(L2CAPCOC_channel_t *pChannel);
+static void L2CAPCOC_report(void);
+static void L2CAPCOC_retry(char *pData);
+#ifdef FREERTOS
+static void L2CAPCOC_retryClockCB(uint32_t arg);
+#else
+static void L2CAPCOC_retryClockCB(UArg arg);
+#endif // FREERTOS
 
 // Events handlers struct, contains the handlers and event masks
 // of the L2CAP data packets
@@ -199,7 +287,8 @@ BLEAppUtil_EventHandler_t DSL2CAPsignalHandler =
     .eventMask      = BLEAPPUTIL_L2CAP_CHANNEL_ESTABLISHED_EVT       |
                       BLEAPPUTIL_L2CAP_CHANNEL_TERMINATED_EVT        |
                       BLEAPPUTIL_L2CAP_OUT_OF_CREDIT_EVT             |
-                      BLEAPPUTIL_L2CAP_PEER_CREDIT_THRESHOLD_EVT
+                      BLEAPPUTIL_L2CAP_PEER_CREDIT_THRESHOLD_EVT     |
+                      BLEAPPUTIL_L2CAP_SEND_SDU_DONE_EVT
 };
 
 // Events handlers struct, contains the handlers and event masks
@@ -226,6 +315,16 @@ BLEAppUtil_EventHandler_t DSL2CAPconnectionHandler =
 bStatus_t L2CAPCOC_start( void )
 {
   bStatus_t status = SUCCESS;
+  uint8 i;
+
+  for (i = 0; i < MAX_NUM_BLE_CONNS; i++)
+  {
+    L2CAPCOC_psmConns[i] = LINKDB_CONNHANDLE_INVALID;
+  }
+
+  // One-shot timer, started when the stack refuses an SDU
+  Util_constructClock(&L2CAPCOC_retryClk, L2CAPCOC_retryClockCB,
+                      L2CAPCOC_RETRY_MS, 0, false, 0);
 
   status = BLEAppUtil_registerEventHandler(&DSL2CAPdataHandler);
   if(status != SUCCESS)
@@ -303,7 +402,8 @@ void L2CAPCOC_connEventHandler(uint32 event, BLEAppUtil_msgHdr_t *pMsgData)
 /*********************************************************************
  * @fn      L2CAPCOC_dataHandler
  *
- * @brief   Handles the data received on the L2CAP channel
+ * @brief   Handles the data received on the L2CAP channels. The received
+ *          buffer is either queued for transmission as is, or released.
  *
  * @param   event - event to handle
  * @param   pMsgData - data to handle
@@ -312,7 +412,7 @@ void L2CAPCOC_connEventHandler(uint32 event, BLEAppUtil_msgHdr_t *pMsgData)
  */
 void L2CAPCOC_dataHandler(uint32 event, BLEAppUtil_msgHdr_t *pMsgData)
 {
-  uint16 i = 0;
+  L2CAPCOC_channel_t *pChannel;
 
   if (!pMsgData)
   {
@@ -320,47 +420,48 @@ void L2CAPCOC_dataHandler(uint32 event, BLEAppUtil_msgHdr_t *pMsgData)
     return;
   }
 
+  l2capDataEvent_t *pDataPkt = (l2capDataEvent_t *)pMsgData;
+
+  pChannel = L2CAPCOC_findChannel(pDataPkt->pkt.connHandle, pDataPkt->pkt.CID);
+  if (pChannel == NULL)
+  {
+    // Data for a channel that is not ours
+    BM_free(pDataPkt->pkt.pPayload);
+    return;
+  }
+
+  pChannel->rxBytes += pDataPkt->pkt.len;
+
+#if (L2CAPCOC_DATA_MODE == L2CAPCOC_MODE_ECHO)
+  uint16 i;
+  uint8 *pPayload = pDataPkt->pkt.pPayload;
+
   // Toggle LEDs to indicate that data was received
   GPIO_toggle( CONFIG_GPIO_LED_RED );
   GPIO_toggle( CONFIG_GPIO_LED_GREEN );
 
-  l2capDataEvent_t *pDataPkt = (l2capDataEvent_t *)pMsgData;
-
-  MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE2, 0,
-                    "L2CAP: connHandle: "
-                    MENU_MODULE_COLOR_YELLOW "%d " MENU_MODULE_COLOR_RESET
-                    " CID " MENU_MODULE_COLOR_YELLOW "0x%x " MENU_MODULE_COLOR_RESET
-                    "length: " MENU_MODULE_COLOR_YELLOW "%d " MENU_MODULE_COLOR_RESET,
-                    pDataPkt->pkt.connHandle,
-                    pDataPkt->pkt.CID,
-                    pDataPkt->pkt.len);
-//  MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE3, 0,
-//                    "Incoming Data: " MENU_MODULE_COLOR_YELLOW "%s" MENU_MODULE_COLOR_RESET,
-//                    pDataPkt->pkt.pPayload);
-
   // Change upper case to lower case and vice versa
   for ( i = 0; i < pDataPkt->pkt.len; i++ )
   {
-    if ( pDataPkt->pkt.pPayload[i] >= 'a' && pDataPkt->pkt.pPayload[i] <= 'z' )
+    if ( pPayload[i] >= 'a' && pPayload[i] <= 'z' )
     {
-      pDataPkt->pkt.pPayload[i] = pDataPkt->pkt.pPayload[i] - 32;
+      pPayload[i] = pPayload[i] - 32;
     }
-    else if ( pDataPkt->pkt.pPayload[i] >= 'A' && pDataPkt->pkt.pPayload[i] <= 'Z' )
+    else if ( pPayload[i] >= 'A' && pPayload[i] <= 'Z' )
     {
-      pDataPkt->pkt.pPayload[i] = pDataPkt->pkt.pPayload[i] + 32;
+      pPayload[i] = pPayload[i] + 32;
     }
   }
 
-//  MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE4, 0,
-//                    "Outgoing Data: " MENU_MODULE_COLOR_YELLOW "%s" MENU_MODULE_COLOR_RESET,
-//                    pDataPkt->pkt.pPayload);
-
   // The app takes the received data, changes the payload according to ( Upper-Case <---->lower-case )
-  // and sends it back to the peer device (loopback implementation).
-  // It is possible to expand this function to support multiple COC CID's
-  pDataPkt->pkt.connHandle = gL2CAPCOC_AppData.connHandle;
-  pDataPkt->pkt.CID = gL2CAPCOC_AppData.CID;
-  L2CAP_SendSDU( &pDataPkt->pkt );
+  // and sends the same buffer back on the channel it came from (loopback implementation).
+  L2CAPCOC_queueSdu(pChannel, pPayload, pDataPkt->pkt.len);
+#else
+  // Sink and benchmark modes only account for the received data
+  BM_free(pDataPkt->pkt.pPayload);
+#endif
+
+  L2CAPCOC_report();
 }
 
 /*********************************************************************
@@ -375,20 +476,43 @@ void L2CAPCOC_dataHandler(uint32 event, BLEAppUtil_msgHdr_t *pMsgData)
  */
 void L2CAPCOC_signalHandler(uint32 event, BLEAppUtil_msgHdr_t *pMsgData)
 {
+  L2CAPCOC_channel_t *pChannel;
+  uint8 i;
+
   if (!pMsgData)
   {
     // Caller needs to figure out by himself that pMsg is NULL
     return;
   }
 
+  uint16_t connHandle = ((l2capSignalEvent_t *)pMsgData)->connHandle;
+
   /*Handle the l2cap event */
   switch (event)
   {
     case BLEAPPUTIL_L2CAP_CHANNEL_ESTABLISHED_EVT:
     {
       l2capChannelEstEvt_t *pConnEvt = &((l2capSignalEvent_t *)pMsgData)->cmd.channelEstEvt;
-      gL2CAPCOC_AppData.CID        = pConnEvt->CID;
-      gL2CAPCOC_AppData.peerCID    = pConnEvt->info.peerCID;
+
+      if (pConnEvt->result != L2CAP_CONN_SUCCESS)
+      {
+        return;
+      }
+
+      // Take a free channel entry
+      pChannel = L2CAPCOC_findChannel(LINKDB_CONNHANDLE_INVALID, L2CAPCOC_INVALID_CID);
+      if (pChannel == NULL)
+      {
+        // No room to serve this channel
+        L2CAP_DisconnectReq(connHandle, pConnEvt->CID);
+        return;
+      }
+
+      memset(pChannel, 0, sizeof(L2CAPCOC_channel_t));
+      pChannel->connHandle = connHandle;
+      pChannel->CID        = pConnEvt->CID;
+      pChannel->peerCID    = pConnEvt->info.peerCID;
+      pChannel->peerMtu    = pConnEvt->info.peerMtu;
 
       MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE1, 0,
                         "L2CAP: COC established "
@@ -400,47 +524,85 @@ void L2CAPCOC_signalHandler(uint32 event, BLEAppUtil_msgHdr_t *pMsgData)
                         "mps "               MENU_MODULE_COLOR_YELLOW "0x%d " MENU_MODULE_COLOR_RESET,
                         gL2CAPCOC_AppData.PSM,
                         gL2CAPCOC_AppData.peerPSM,
-                        gL2CAPCOC_AppData.CID,
-                        gL2CAPCOC_AppData.peerCID,
+                        pChannel->CID,
+                        pChannel->peerCID,
                         pConnEvt->info.mtu,
                         pConnEvt->info.mps);
 
+#if (L2CAPCOC_DATA_MODE == L2CAPCOC_MODE_BENCH)
+      // Start streaming, L2CAPCOC_sendNext keeps the channel busy from now on
+      L2CAPCOC_sendNext(pChannel);
+#else
       /* Send the first packet to the peer device.
        * This packet will be echoed and sent back and forward until the connection will be destroyed.*/
       if (L2CAP_CONN_ESTABLISH_ROLE == L2CAPCOC_INITIATOR)
       {
-          l2capPacket_t packet;
-          packet.connHandle = gL2CAPCOC_AppData.connHandle;
-          packet.CID = gL2CAPCOC_AppData.CID;
-          packet.len = L2CAP_MAX_MTU;
-          packet.pPayload = L2CAP_bm_alloc( L2CAP_MAX_MTU );
-
-          memset (packet.pPayload, 0x41 /*"A"*/, L2CAP_MAX_MTU);
-
-          bStatus_t  status = L2CAP_SendSDU( &packet );
-          MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE2, 0,
-                            "L2CAP: Data Sent "
-                            "status "               MENU_MODULE_COLOR_YELLOW "%d " MENU_MODULE_COLOR_RESET
-                            "L2CAP_MAX_MTU "        MENU_MODULE_COLOR_YELLOW "%d " MENU_MODULE_COLOR_RESET,
-                            status,
-                            L2CAP_MAX_MTU);
+          uint8 *pPayload = L2CAP_bm_alloc( L2CAP_MAX_MTU );
 
+          if (pPayload != NULL)
+          {
+            memset (pPayload, 0x41 /*"A"*/, L2CAP_MAX_MTU);
+            L2CAPCOC_queueSdu(pChannel, pPayload, L2CAP_MAX_MTU);
+          }
       }
+#endif
       return;
     }
     case BLEAPPUTIL_L2CAP_PEER_CREDIT_THRESHOLD_EVT:
     {
       l2capCreditEvt_t *pCreditEvt = &((l2capSignalEvent_t *)pMsgData)->cmd.creditEvt;
-      uint16_t connHandle = ((l2capSignalEvent_t *)pMsgData)->connHandle;
+
+      pChannel = L2CAPCOC_findChannel(connHandle, pCreditEvt->CID);
+      if ((pChannel != NULL) && (pChannel->qCount == L2CAPCOC_TX_QUEUE_LEN))
+      {
+        // Back-pressure: the peer gets credits again once the queue drains
+        pChannel->creditsHeld = TRUE;
+        return;
+      }
 
       // Send credits to the peer device
       L2CAP_FlowCtrlCredit(connHandle, pCreditEvt->CID, L2CAP_NOF_CREDITS);
       return;
     }
-    case BLEAPPUTIL_L2CAP_OUT_OF_CREDIT_EVT:
-      /* Do nothing */
-    case BLEAPPUTIL_L2CAP_CHANNEL_TERMINATED_EVT:
     case BLEAPPUTIL_L2CAP_SEND_SDU_DONE_EVT:
+    {
+      l2capSendSduDoneEvt_t *pDoneEvt = &((l2capSignalEvent_t *)pMsgData)->cmd.sendSduDoneEvt;
+
+      pChannel = L2CAPCOC_findChannel(connHandle, pDoneEvt->CID);
+      if (pChannel == NULL)
+      {
+        return;
+      }
+
+      pChannel->txBusy = FALSE;
+      pChannel->txBytes += pDoneEvt->txLen;
+      pChannel->txLatency += ClockP_getSystemTicks() - pChannel->txStart;
+      pChannel->txSdus++;
+
+      // The stack is free again, give every waiting channel a chance
+      for (i = 0; i < L2CAPCOC_MAX_CHANNELS; i++)
+      {
+        if (L2CAPCOC_channels[i].CID != L2CAPCOC_INVALID_CID)
+        {
+          L2CAPCOC_sendNext(&L2CAPCOC_channels[i]);
+        }
+      }
+      L2CAPCOC_report();
+      return;
+    }
+    case BLEAPPUTIL_L2CAP_CHANNEL_TERMINATED_EVT:
+    {
+      l2capChannelTermEvt_t *pTermEvt = &((l2capSignalEvent_t *)pMsgData)->cmd.channelTermEvt;
+
+      pChannel = L2CAPCOC_findChannel(connHandle, pTermEvt->CID);
+      if (pChannel != NULL)
+      {
+        L2CAPCOC_releaseChannel(pChannel);
+      }
+      break;
+    }
+    case BLEAPPUTIL_L2CAP_OUT_OF_CREDIT_EVT:
+      /* Do nothing, the stack resumes the SDU when the peer returns credits */
     case BLEAPPUTIL_L2CAP_NUM_CTRL_DATA_PKT_EVT:
       /* No further actions required - we have handled the events. */
       break;
@@ -463,13 +625,15 @@ static bStatus_t L2CAPCOC_openCoc(uint16_t connHandle)
   uint8_t ret = SUCCESS;
   l2capPsm_t psm;
   l2capPsmInfo_t psmInfo;
-  MenuModule_clearLines(APP_MENU_PROFILE_STATUS_LINE, APP_MENU_PROFILE_STATUS_LINE4);
+  uint8 i;
 
   if (L2CAP_PsmInfo(L2CAP_PSM_ID, &psmInfo) == INVALIDPARAMETER)
   {
     l2capUserCfg_t l2capUserConfig;
     L2CAP_GetUserConfig(&l2capUserConfig);
 
+    MenuModule_clearLines(APP_MENU_PROFILE_STATUS_LINE, APP_MENU_PROFILE_STATUS_LINE4);
+
     // Prepare the PSM parameters
     psm.psm                 = L2CAP_PSM_ID;
     psm.mtu                 = L2CAP_MAX_MTU;
@@ -487,31 +651,56 @@ static bStatus_t L2CAPCOC_openCoc(uint16_t connHandle)
                       "Register PSM " MENU_MODULE_COLOR_YELLOW "%d " "%s" MENU_MODULE_COLOR_RESET,
                       psm.psm, ret ? "FAILED" : "SUCCEDED");
 
-    if (ret == SUCCESS)
+    if (ret != SUCCESS)
     {
-      if (L2CAP_CONN_ESTABLISH_ROLE == L2CAPCOC_INITIATOR)
+      return ret;
+    }
+
+    /* Store the l2cap app data */
+    gL2CAPCOC_AppData.PSM        = psm.psm;
+    gL2CAPCOC_AppData.peerPSM    = L2CAP_PEER_PSM_ID;
+    gL2CAPCOC_AppData.taskId     = psm.taskId;
+    gL2CAPCOC_AppData.numConns   = 0;
+  }
+
+  // Count each connection once, L2CAPCOC_closeCoc releases only those
+  for (i = 0; i < MAX_NUM_BLE_CONNS; i++)
+  {
+    if (L2CAPCOC_psmConns[i] == connHandle)
+    {
+      break;
+    }
+  }
+  if (i == MAX_NUM_BLE_CONNS)
+  {
+    for (i = 0; i < MAX_NUM_BLE_CONNS; i++)
+    {
+      if (L2CAPCOC_psmConns[i] == LINKDB_CONNHANDLE_INVALID)
       {
-        // Send the connection request to the peer
-        ret = L2CAP_ConnectReq(connHandle, psm.psm, L2CAP_PEER_PSM_ID);
-        MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE1, 0,
-                      "Connection request sent to PSM ID " MENU_MODULE_COLOR_YELLOW "%d ",
-                       L2CAP_PEER_PSM_ID );
+        L2CAPCOC_psmConns[i] = connHandle;
+        gL2CAPCOC_AppData.numConns++;
+        break;
       }
-      /* Store the l2cap app data */
-      gL2CAPCOC_AppData.connHandle = connHandle;
-      gL2CAPCOC_AppData.PSM        = psm.psm;
-      gL2CAPCOC_AppData.peerPSM    = L2CAP_PEER_PSM_ID;
-      gL2CAPCOC_AppData.taskId     = psm.taskId;
     }
   }
 
+  if (L2CAP_CONN_ESTABLISH_ROLE == L2CAPCOC_INITIATOR)
+  {
+    // Send the connection request to the peer
+    ret = L2CAP_ConnectReq(connHandle, L2CAP_PSM_ID, L2CAP_PEER_PSM_ID);
+    MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE1, 0,
+                  "Connection request sent to PSM ID " MENU_MODULE_COLOR_YELLOW "%d ",
+                   L2CAP_PEER_PSM_ID );
+  }
+
   return ret;
 }
 
 /*********************************************************************
 * @fn      L2CAPCOC_closeCoc
 *
-* @brief   Close a communication channel between peers
+* @brief   Close the communication channels of a connection, and the PSM
+*          once no connection uses it anymore
 *
 * @param   connHandle - connection handle
 *
@@ -520,19 +709,46 @@ static bStatus_t L2CAPCOC_openCoc(uint16_t connHandle)
 static bStatus_t L2CAPCOC_closeCoc(uint16_t connHandle)
 {
   bStatus_t ret = SUCCESS;
+  uint8 i;
+
+  for (i = 0; i < L2CAPCOC_MAX_CHANNELS; i++)
+  {
+    L2CAPCOC_channel_t *pChannel = &L2CAPCOC_channels[i];
+
+    if ((pChannel->CID == L2CAPCOC_INVALID_CID) || (pChannel->connHandle != connHandle))
+    {
+      continue;
+    }
+
+    ret |= L2CAP_DisconnectReq(connHandle, pChannel->CID);
 
-  ret = L2CAP_DisconnectReq(connHandle, gL2CAPCOC_AppData.CID);
+    MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE1, 0,
+                      "L2CAP: COC disconnected "
+                      "PSM "               MENU_MODULE_COLOR_YELLOW "%d " MENU_MODULE_COLOR_RESET
+                      "Peer PSM "          MENU_MODULE_COLOR_YELLOW "%d " MENU_MODULE_COLOR_RESET
+                      "CID "               MENU_MODULE_COLOR_YELLOW "0x%x " MENU_MODULE_COLOR_RESET
+                      "Peer CID "          MENU_MODULE_COLOR_YELLOW "0x%x " MENU_MODULE_COLOR_RESET,
+                      gL2CAPCOC_AppData.PSM,
+                      gL2CAPCOC_AppData.peerPSM,
+                      pChannel->CID,
+                      pChannel->peerCID);
 
-  MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE1, 0,
-                    "L2CAP: COC disconnected "
-                    "PSM "               MENU_MODULE_COLOR_YELLOW "%d " MENU_MODULE_COLOR_RESET
-                    "Peer PSM "          MENU_MODULE_COLOR_YELLOW "%d " MENU_MODULE_COLOR_RESET
-                    "CID "               MENU_MODULE_COLOR_YELLOW "0x%x " MENU_MODULE_COLOR_RESET
-                    "Peer CID "          MENU_MODULE_COLOR_YELLOW "0x%x " MENU_MODULE_COLOR_RESET,
-                    gL2CAPCOC_AppData.PSM,
-                    gL2CAPCOC_AppData.peerPSM,
-                    gL2CAPCOC_AppData.CID,
-                    gL2CAPCOC_AppData.peerCID);
+    L2CAPCOC_releaseChannel(pChannel);
+  }
+
+  // Only a connection counted by L2CAPCOC_openCoc holds the PSM
+  for (i = 0; i < MAX_NUM_BLE_CONNS; i++)
+  {
+    if (L2CAPCOC_psmConns[i] == connHandle)
+    {
+      L2CAPCOC_psmConns[i] = LINKDB_CONNHANDLE_INVALID;
+      break;
+    }
+  }
+  if ((i == MAX_NUM_BLE_CONNS) || (--gL2CAPCOC_AppData.numConns != 0))
+  {
+    return ret;
+  }
 
   ret |=  L2CAP_DeregisterPsm( gL2CAPCOC_AppData.taskId, gL2CAPCOC_AppData.PSM);
 
@@ -545,4 +761,264 @@ static bStatus_t L2CAPCOC_closeCoc(uint16_t connHandle)
   return ret;
 }
 
+/*********************************************************************
+* @fn      L2CAPCOC_findChannel
+*
+* @brief   Find the state of a channel
+*
+* @param   connHandle - connection handle, ignored when looking for a
+*                       free entry
+* @param   CID - local channel id, L2CAPCOC_INVALID_CID to find a free entry
+*
+* @return  pointer to the channel state, or NULL if not found
+*/
+static L2CAPCOC_channel_t *L2CAPCOC_findChannel(uint16 connHandle, uint16 CID)
+{
+  uint8 i;
+
+  for (i = 0; i < L2CAPCOC_MAX_CHANNELS; i++)
+  {
+    L2CAPCOC_channel_t *pChannel = &L2CAPCOC_channels[i];
+
+    if ((pChannel->CID == CID) &&
+        ((CID == L2CAPCOC_INVALID_CID) || (pChannel->connHandle == connHandle)))
+    {
+      return pChannel;
+    }
+  }
+
+  return NULL;
+}
+
+/*********************************************************************
+* @fn      L2CAPCOC_releaseChannel
+*
+* @brief   Free the SDUs still queued on a channel and release its entry
+*
+* @param   pChannel - channel to release
+*
+* @return  none
+*/
+static void L2CAPCOC_releaseChannel(L2CAPCOC_channel_t *pChannel)
+{
+  while (pChannel->qCount != 0)
+  {
+    BM_free(pChannel->txQueue[pChannel->qHead].pPayload);
+    pChannel->qHead = (pChannel->qHead + 1) % L2CAPCOC_TX_QUEUE_LEN;
+    pChannel->qCount--;
+  }
+
+  pChannel->CID = L2CAPCOC_INVALID_CID;
+}
+
+/*********************************************************************
+* @fn      L2CAPCOC_queueSdu
+*
+* @brief   Queue a stack allocated buffer for transmission on a channel.
+*          The buffer is handed to the stack without being copied.
+*          Ownership of the buffer passes to this module.
+*
+* @param   pChannel - channel to send on
+* @param   pPayload - buffer allocated by the stack
+* @param   len - length of the SDU
+*
+* @return  none
+*/
+static void L2CAPCOC_queueSdu(L2CAPCOC_channel_t *pChannel, uint8 *pPayload, uint16 len)
+{
+  if (pChannel->qCount == L2CAPCOC_TX_QUEUE_LEN)
+  {
+    BM_free(pPayload);
+    pChannel->drops++;
+    return;
+  }
+
+  pChannel->txQueue[(pChannel->qHead + pChannel->qCount) % L2CAPCOC_TX_QUEUE_LEN].pPayload = pPayload;
+  pChannel->txQueue[(pChannel->qHead + pChannel->qCount) % L2CAPCOC_TX_QUEUE_LEN].len = len;
+  pChannel->qCount++;
+
+  L2CAPCOC_sendNext(pChannel);
+}
+
+/*********************************************************************
+* @fn      L2CAPCOC_sendNext
+*
+* @brief   Hand the next queued SDU of a channel to the stack, if the
+*          stack is not already transmitting one on that channel. In
+*          benchmark mode a new SDU is generated when the queue is empty.
+*
+* @param   pChannel - channel to send on
+*
+* @return  none
+*/
+static void L2CAPCOC_sendNext(L2CAPCOC_channel_t *pChannel)
+{
+  l2capPacket_t packet;
+  bStatus_t status;
+
+  while (!pChannel->txBusy)
+  {
+#if (L2CAPCOC_DATA_MODE == L2CAPCOC_MODE_BENCH)
+    if (pChannel->qCount == 0)
+    {
+      uint8 *pPayload = L2CAP_bm_alloc(pChannel->peerMtu);
+
+      if (pPayload == NULL)
+      {
+        // Retried on the next SDU done event or by the retry timer
+        Util_startClock(&L2CAPCOC_retryClk);
+        return;
+      }
+      memset(pPayload, 0x55, pChannel->peerMtu);
+      pChannel->txQueue[pChannel->qHead].pPayload = pPayload;
+      pChannel->txQueue[pChannel->qHead].len = pChannel->peerMtu;
+      pChannel->qCount = 1;
+    }
+#endif
+    if (pChannel->qCount == 0)
+    {
+      return;
+    }
+
+    packet.connHandle = pChannel->connHandle;
+    packet.CID        = pChannel->CID;
+    packet.pPayload   = pChannel->txQueue[pChannel->qHead].pPayload;
+    packet.len        = pChannel->txQueue[pChannel->qHead].len;
+
+    status = L2CAP_SendSDU(&packet);
+    if (status == blePending)
+    {
+      // The stack is still segmenting an SDU of another channel, the
+      // done event of that SDU retries this one
+      return;
+    }
+
+    if (status == SUCCESS)
+    {
+      // The stack owns the buffer now
+      pChannel->txBusy  = TRUE;
+      pChannel->txStart = ClockP_getSystemTicks();
+    }
+    else
+    {
+      BM_free(packet.pPayload);
+      pChannel->drops++;
+    }
+
+    pChannel->qHead = (pChannel->qHead + 1) % L2CAPCOC_TX_QUEUE_LEN;
+    pChannel->qCount--;
+
+    // A slot is free again, let the peer send more
+    if (pChannel->creditsHeld)
+    {
+      pChannel->creditsHeld = FALSE;
+      L2CAP_FlowCtrlCredit(pChannel->connHandle, pChannel->CID, L2CAP_NOF_CREDITS);
+    }
+
+    if (status != SUCCESS)
+    {
+      // The stack refused the SDU (no link, no memory, ...), sending again
+      // right away would fail the same way
+      Util_startClock(&L2CAPCOC_retryClk);
+      return;
+    }
+  }
+}
+
+/*********************************************************************
+* @fn      L2CAPCOC_retry
+*
+* @brief   Send again on every channel after the stack refused an SDU.
+*          Runs in the BLEAppUtil context.
+*
+* @param   pData - unused
+*
+* @return  none
+*/
+static void L2CAPCOC_retry(char *pData)
+{
+  uint8 i;
+
+  for (i = 0; i < L2CAPCOC_MAX_CHANNELS; i++)
+  {
+    if (L2CAPCOC_channels[i].CID != L2CAPCOC_INVALID_CID)
+    {
+      L2CAPCOC_sendNext(&L2CAPCOC_channels[i]);
+    }
+  }
+}
+
+/*********************************************************************
+* @fn      L2CAPCOC_retryClockCB
+*
+* @brief   Retry timer callback, moves the retry to the BLEAppUtil context
+*
+* @param   arg - unused
+*
+* @return  none
+*/
+#ifdef FREERTOS
+static void L2CAPCOC_retryClockCB(uint32_t arg)
+#else
+static void L2CAPCOC_retryClockCB(UArg arg)
+#endif // FREERTOS
+{
+  BLEAppUtil_invokeFunctionNoData(L2CAPCOC_retry);
+}
+
+/*********************************************************************
+* @fn      L2CAPCOC_report
+*
+* @brief   Print the throughput of each channel once per
+*          L2CAPCOC_REPORT_PERIOD_MS and restart the counters
+*
+* @return  none
+*/
+static void L2CAPCOC_report(void)
+{
+  uint32 now = ClockP_getSystemTicks();
+  // 64 bits, a 32-bit product wraps after about 71 minutes without a report
+  uint64_t elapsedUs = (uint64_t)(now - L2CAPCOC_lastReport) * ClockP_getSystemTickPeriod();
+  uint8 i;
+  uint8 line = 0;
+
+  if (elapsedUs < (L2CAPCOC_REPORT_PERIOD_MS * 1000))
+  {
+    return;
+  }
+  L2CAPCOC_lastReport = now;
+
+  for (i = 0; i < L2CAPCOC_MAX_CHANNELS; i++)
+  {
+    L2CAPCOC_channel_t *pChannel = &L2CAPCOC_channels[i];
+
+    if (pChannel->CID == L2CAPCOC_INVALID_CID)
+    {
+      continue;
+    }
+
+    if (line < L2CAPCOC_REPORT_LINES)
+    {
+      MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE2 + line, 0,
+                        "L2CAP: CID "  MENU_MODULE_COLOR_YELLOW "0x%x " MENU_MODULE_COLOR_RESET
+                        "tx B/s "      MENU_MODULE_COLOR_YELLOW "%d " MENU_MODULE_COLOR_RESET
+                        "rx B/s "      MENU_MODULE_COLOR_YELLOW "%d " MENU_MODULE_COLOR_RESET
+                        "SDU us "      MENU_MODULE_COLOR_YELLOW "%d " MENU_MODULE_COLOR_RESET
+                        "drops "       MENU_MODULE_COLOR_YELLOW "%d " MENU_MODULE_COLOR_RESET,
+                        pChannel->CID,
+                        (uint32)((pChannel->txBytes * 1000000ULL) / elapsedUs),
+                        (uint32)((pChannel->rxBytes * 1000000ULL) / elapsedUs),
+                        pChannel->txSdus ?
+                          (pChannel->txLatency / pChannel->txSdus) * ClockP_getSystemTickPeriod() : 0,
+                        pChannel->drops);
+      line++;
+    }
+
+    pChannel->txBytes   = 0;
+    pChannel->rxBytes   = 0;
+    pChannel->txLatency = 0;
+    pChannel->txSdus    = 0;
+  }
+}
+
 #endif //(BLE_V41_FEATURES) && (BLE_V41_FEATURES & L2CAP_COC_CFG)
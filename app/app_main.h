@@ -53,6 +53,14 @@ Target Device: cc23xx
 //*****************************************************************************
 //! Defines
 //*****************************************************************************
+// Bytes of extension storage reserved in each connection slot, shared by
+// all the modules that register with Connection_registerExt
+#ifndef CONNECTION_EXT_SIZE
+#define CONNECTION_EXT_SIZE         32
+#endif
+
+// Returned by Connection_registerExt when the storage is exhausted
+#define CONNECTION_EXT_INVALID      0xFF
 
 //*****************************************************************************
 //! Typedefs
@@ -329,7 +337,7 @@ App_connInfo *Connection_getConnList(void);
  *
  * @brief   Find connHandle in the connected device list by index
  *
- * @param   index - the index of the connection in the @ref gConnectionConnList
+ * @param   index - the slot of the connection in the connection list
  *
  * @return  the connHandle found. If there is no match,
  *          MAX_NUM_BLE_CONNS will be returned.
@@ -339,7 +347,9 @@ uint16_t Connection_getConnhandle(uint8_t index);
 /*********************************************************************
  * @fn      Connection_getConnIndex
  *
- * @brief   Find index in the connected device list by connHandle
+ * @brief   Find index in the connected device list by connHandle.
+ *          The index of a connection does not change for as long as the
+ *          connection is up.
  *
  * @param   connHandle - the connection handle
  *
@@ -348,4 +358,31 @@ uint16_t Connection_getConnhandle(uint8_t index);
  */
 uint16_t Connection_getConnIndex(uint16_t connHandle);
 
+/*********************************************************************
+ * @fn      Connection_registerExt
+ *
+ * @brief   Reserve per connection storage for a module. The storage is
+ *          zeroed when a connection is added to the list.
+ *          Should be called once per module, before connections are made.
+ *
+ * @param   size - number of bytes needed in each connection, not 0
+ *
+ * @return  extension id to use with @ref Connection_getExt, or
+ *          CONNECTION_EXT_INVALID if size is 0 or CONNECTION_EXT_SIZE is
+ *          exhausted.
+ */
+uint8_t Connection_registerExt(uint16_t size);
+
+/*********************************************************************
+ * @fn      Connection_getExt
+ *
+ * @brief   Get the storage of a module for a connection
+ *
+ * @param   connHandle - the connection handle
+ * @param   extId - extension id returned by @ref Connection_registerExt
+ *
+ * @return  pointer to the storage, NULL if the connection is not in the list
+ */
+void *Connection_getExt(uint16_t connHandle, uint8_t extId);
+
 #endif /* APP_MAIN_H_ */
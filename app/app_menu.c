@@ -77,6 +77,8 @@ void Menu_disconnectCB(uint8 index);
 #if ( HOST_CONFIG & ( CENTRAL_CFG | PERIPHERAL_CFG ) )
 // The current connection handle the menu is working with
 static uint16 menuCurrentConnHandle;
+// The connection list index of each entry of the connected devices menu
+static uint8 menuConnSlots[MAX_NUM_BLE_CONNS];
 #endif // #if ( HOST_CONFIG & ( CENTRAL_CFG | PERIPHERAL_CFG ) )
 
 #if ( HOST_CONFIG & ( CENTRAL_CFG | OBSERVER_CFG ) )
@@ -360,10 +362,20 @@ void Menu_workWithCB(uint8 index)
         static MenuModule_Menu_t connAddrList[MAX_NUM_BLE_CONNS];
         // Get the list of connected devices
         App_connInfo * currConnList = Connection_getConnList();
-        for(i = 0; i < numConns; i++)
+        uint8 slot;
+
+        // The connection list has holes, only list the used entries
+        numConns = 0;
+        for(slot = 0; slot < MAX_NUM_BLE_CONNS; slot++)
         {
+            if (currConnList[slot].connHandle == LINKDB_CONNHANDLE_INVALID)
+            {
+                continue;
+            }
+            i = numConns++;
+            menuConnSlots[i] = slot;
             // Convert the addresses to strings
-            memcpy(connAddrsses[i], BLEAppUtil_convertBdAddr2Str(currConnList[i].peerAddress), BLEAPPUTIL_ADDR_STR_SIZE);
+            memcpy(connAddrsses[i], BLEAppUtil_convertBdAddr2Str(currConnList[slot].peerAddress), BLEAPPUTIL_ADDR_STR_SIZE);
             connAddrList[i].itemName = connAddrsses[i];
             connAddrList[i].itemCallback = &Menu_selectedDeviceCB;
             connAddrList[i].itemHelp = "";
@@ -389,7 +401,7 @@ void Menu_workWithCB(uint8 index)
  */
 void Menu_selectedDeviceCB(uint8 index)
 {
-    menuCurrentConnHandle = Connection_getConnhandle(index);
+    menuCurrentConnHandle = Connection_getConnhandle(menuConnSlots[index]);
     // Go to the last menu
     MenuModule_goBack();
     // Display the work with menu options
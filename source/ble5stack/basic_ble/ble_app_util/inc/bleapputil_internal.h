@@ -61,10 +61,18 @@ extern "C"
 
 /*POSIX*/
 #include <pthread.h>
-#include <mqueue.h>
+#include <semaphore.h>
 /*********************************************************************
  * MACROS
  */
+// Number of event handler types, see @ref BLEAppUtil_eventHandlerType_e
+#define BLEAPPUTIL_NUM_OF_HANDLER_TYPES     (BLEAPPUTIL_HANDOVER_TYPE + 1)
+
+// Number of messages in the BLEAppUtil message pool. This bounds the
+// number of events queued to the BLEAppUtil task at the same time.
+#ifndef BLEAPPUTIL_MSG_POOL_SIZE
+#define BLEAPPUTIL_MSG_POOL_SIZE            16
+#endif
 
 /*********************************************************************
  * TYPEDEFS
@@ -83,17 +91,25 @@ typedef enum BLEAppBLEAppUtil_Evt_e
     BLEAPPUTIL_EVT_CALL_IN_BLEAPPUTIL_CONTEXT // switch context and call callback
 } BLEAppBLEAppUtil_Evt_e;
 
-typedef struct
+// Immutable array of the handlers registered for one handler type.
+// Register/unregister build a new snapshot and publish it with a single
+// pointer store, so the dispatch path can walk it without the mutex.
+// Replaced snapshots are kept on a retired list until the BLEAppUtil
+// task is done dispatching and can free them.
+typedef struct BLEAppUtil_handlerSnapshot_t
 {
-    BLEAppUtil_EventHandler_t               *eventHandler;
-    struct BLEAppUtil_EventHandlersList_t   *next;
-} BLEAppUtil_EventHandlersList_t;
+    struct BLEAppUtil_handlerSnapshot_t *retiredNext;  // next item in the retired list
+    uint8_t                             numHandlers;  // number of items in handlers
+    BLEAppUtil_EventHandler_t           *handlers[];  // handlers in registration order
+} BLEAppUtil_handlerSnapshot_t;
 
 /** @internal data structure for the thread entity */
 typedef struct
 {
-    pthread_t threadId;
-    mqd_t     queueHandle;
+    pthread_t                       threadId;
+    sem_t                           queueSem;   // counts the queued messages
+    struct BLEAppUtil_poolMsg_t     *queueHead; // next message to process
+    struct BLEAppUtil_poolMsg_t     *queueTail; // last queued message
 } BLEAppUtil_TheardEntity_t;
 
 /** @internal data structure for callback context switch*/
@@ -105,12 +121,6 @@ typedef struct
     char                            *data;
 } BLEAppUtil_CallbackToInvoke_t;
 
-typedef struct
-{
-    uint8_t event;                // event type
-    void    *pData;               // pointer to message
-} BLEAppUtil_appEvt_t;
-
 // Used to pass the event from a "BLE App Util" event and it's handler
 typedef struct
 {
@@ -137,6 +147,29 @@ typedef struct
     uint32_t event;
     uint32_t status;
 } BLEAppUtil_handoverEvent_t;
+
+// The data of a message passed from the callbacks to the BLEAppUtil task
+typedef union
+{
+    BLEAppUtil_stackMsgData_t       stackMsg;
+    BLEAppUtil_connEventNoti_t      connEventNoti;
+    BLEAppUtil_AdvEventData_t       advData;
+    BLEAppUtil_ScanEventData_t      scanData;
+    BLEAppUtil_PairStateData_t      pairStateData;
+    BLEAppUtil_PasscodeData_t       passcodeData;
+    BLEAppUtil_CallbackToInvoke_t   callbackToInvoke;
+    uint8_t                         handoverData[sizeof(uint16_t) + sizeof(uint32_t)];
+} BLEAppUtil_msgPoolData_t;
+
+// A message of the BLEAppUtil message pool. The message is linked either
+// on the pool free list or on the BLEAppUtil task queue, and its data is
+// processed in place by the task.
+typedef struct BLEAppUtil_poolMsg_t
+{
+    struct BLEAppUtil_poolMsg_t     *next;      // next message in the list
+    uint8_t                         event;      // BLEAppUtil event type
+    BLEAppUtil_msgPoolData_t        data;       // the message data
+} BLEAppUtil_poolMsg_t;
 /*********************************************************************
  * GLOBAL VARIABLES
  */
@@ -147,7 +180,8 @@ extern BLEAppUtil_GeneralParams_t *BLEAppUtilLocal_GeneralParams;
 // Callback functions handlers
 extern ErrorHandler_t errorHandlerCb;
 extern StackInitDone_t appInitDoneHandler;
-extern BLEAppUtil_EventHandlersList_t *BLEAppUtilEventHandlersHead;
+extern BLEAppUtil_handlerSnapshot_t * volatile BLEAppUtilHandlerSnapshots[BLEAPPUTIL_NUM_OF_HANDLER_TYPES];
+extern volatile uint32_t BLEAppUtilHandlerEventMasks[BLEAPPUTIL_NUM_OF_HANDLER_TYPES];
 
 extern pthread_mutex_t mutex;
 extern BLEAppUtil_TheardEntity_t BLEAppUtil_theardEntity;
@@ -191,6 +225,9 @@ void BLEAppUtil_HandoverCNCB(uint16_t connHandle, uint32_t status);
 int BLEAppUtil_createBLEAppUtilTask(void);
 void BLEAppUtil_stackRegister(void);
 void BLEAppUtil_stackInit(void);
+void BLEAppUtil_initMsgPool(void);
+void *BLEAppUtil_allocMsg(void);
+void BLEAppUtil_releaseMsg(void *pData);
 status_t BLEAppUtil_enqueueMsg(uint8_t event, void *pData);
 
 /*********************************************************************
@@ -200,8 +237,7 @@ void BLEAppUtil_callEventHandler(uint32_t event, BLEAppUtil_msgHdr_t *pMsg,
                                  BLEAppUtil_eventHandlerType_e type);
 uint8_t BLEAppUtil_isEventEnabled(BLEAppUtil_eventHandlerType_e eventHandlerType,
                                   uint32_t event);
-BLEAppUtil_EventHandlersList_t *BLEAppUtil_getEventHandler(BLEAppUtil_EventHandlersList_t *handler,
-                                                           BLEAppUtil_eventHandlerType_e eventHandlerType);
+void BLEAppUtil_reclaimHandlerSnapshots(void);
 
 /*********************************************************************
  * Convert and validate received events before enqueue
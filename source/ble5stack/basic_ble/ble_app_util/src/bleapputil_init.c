@@ -81,7 +81,13 @@ BLEAppUtil_PeriCentParams_t *BLEAppUtilLocal_PeriCentParams = NULL;
 
 // Callback functions handlers
 ErrorHandler_t errorHandlerCb;
-BLEAppUtil_EventHandlersList_t *BLEAppUtilEventHandlersHead = NULL;
+
+// Per type handler snapshots and the OR of the event masks of each type
+BLEAppUtil_handlerSnapshot_t * volatile BLEAppUtilHandlerSnapshots[BLEAPPUTIL_NUM_OF_HANDLER_TYPES] = {NULL};
+volatile uint32_t BLEAppUtilHandlerEventMasks[BLEAPPUTIL_NUM_OF_HANDLER_TYPES] = {0};
+
+// Snapshots that were replaced and are waiting to be freed
+static BLEAppUtil_handlerSnapshot_t * volatile BLEAppUtilRetiredSnapshots = NULL;
 
 // GAP Bond Manager Callbacks
 gapBondCBs_t BLEAppUtil_bondMgrCBs =
@@ -107,6 +113,9 @@ pthread_mutex_t mutex;
 * LOCAL FUNCTIONS
 */
 static bStatus_t BLEAppUtil_createQueue(void);
+static BLEAppUtil_handlerSnapshot_t *BLEAppUtil_allocSnapshot(uint8_t numHandlers);
+static void BLEAppUtil_publishSnapshot(BLEAppUtil_eventHandlerType_e type,
+                                       BLEAppUtil_handlerSnapshot_t *newSnapshot);
 
 /*********************************************************************
  * EXTERN FUNCTIONS
@@ -149,7 +158,7 @@ void BLEAppUtil_init(ErrorHandler_t errorHandler, StackInitDone_t initDoneHandle
     BLEAppUtilLocal_GeneralParams = initGeneralParams;
     BLEAppUtilLocal_PeriCentParams = initPeriCentParams;
 
-    // Create a message queue for message to be sent to BLEAppUtil
+    // Create a message pool and queue for message to be sent to BLEAppUtil
     BLEAppUtil_createQueue();
 
     // Create BLE stack task
@@ -161,7 +170,7 @@ void BLEAppUtil_init(ErrorHandler_t errorHandler, StackInitDone_t initDoneHandle
     // Construct a mutex that will be used by the following functions:
     // BLEAppUtil_registerEventHandler
     // BLEAppUtil_unRegisterEventHandler
-    // BLEAppUtil_callEventHandler
+    // BLEAppUtil_reclaimHandlerSnapshots
     pthread_mutex_init(&mutex, NULL);
 }
 
@@ -176,43 +185,48 @@ void BLEAppUtil_init(ErrorHandler_t errorHandler, StackInitDone_t initDoneHandle
  */
 bStatus_t BLEAppUtil_registerEventHandler(BLEAppUtil_EventHandler_t *eventHandler)
 {
-    BLEAppUtil_EventHandlersList_t *newHandler;
+    BLEAppUtil_handlerSnapshot_t *curr;
+    BLEAppUtil_handlerSnapshot_t *newSnapshot;
+    uint8_t numHandlers = 0;
+    uint8_t i;
+
+    if((eventHandler == NULL) ||
+       (eventHandler->handlerType >= BLEAPPUTIL_NUM_OF_HANDLER_TYPES))
+    {
+        return FAILURE;
+    }
 
     // Lock the Mutex
     pthread_mutex_lock(&mutex);
 
-    // Allocate the new handler space
-    newHandler = (BLEAppUtil_EventHandlersList_t *)BLEAppUtil_malloc(sizeof(BLEAppUtil_EventHandlersList_t));
+    curr = BLEAppUtilHandlerSnapshots[eventHandler->handlerType];
+    if(curr != NULL)
+    {
+        numHandlers = curr->numHandlers;
+    }
+
+    // Allocate a snapshot with room for the new handler
+    newSnapshot = NULL;
+    if(numHandlers < 0xFF)
+    {
+        newSnapshot = BLEAppUtil_allocSnapshot(numHandlers + 1);
+    }
 
     // If the allocation failed, return an error
-    if(newHandler == NULL)
+    if(newSnapshot == NULL)
     {
+        pthread_mutex_unlock(&mutex);
         return FAILURE;
     }
 
-    // Set the parameters of the new item
-    newHandler->eventHandler = eventHandler;
-    newHandler->next = NULL;
-
-    // The head is NULL
-    if(BLEAppUtilEventHandlersHead == NULL)
+    // Copy the current handlers and add the new one to the end
+    for(i = 0; i < numHandlers; i++)
     {
-        BLEAppUtilEventHandlersHead = newHandler;
+        newSnapshot->handlers[i] = curr->handlers[i];
     }
-    else
-    {
-        // Add item to be the head of the list
-        BLEAppUtil_EventHandlersList_t *iter = BLEAppUtilEventHandlersHead;
-
-        // Iterate through the list to get to the last item
-        while(iter->next != NULL)
-        {
-          iter = (BLEAppUtil_EventHandlersList_t *)iter->next;
-        }
+    newSnapshot->handlers[numHandlers] = eventHandler;
 
-        // Add to the end of the list
-        iter->next = (struct BLEAppUtil_EventHandlersList_t *)newHandler;
-    }
+    BLEAppUtil_publishSnapshot(eventHandler->handlerType, newSnapshot);
 
     // Unlock the Mutex - item was added to the list
     pthread_mutex_unlock(&mutex);
@@ -227,47 +241,55 @@ bStatus_t BLEAppUtil_registerEventHandler(BLEAppUtil_EventHandler_t *eventHandle
  *
  * @param   eventHandler - The handler to un-register
  *
- * @return  SUCCESS, INVALIDPARAMETER
+ * @return  SUCCESS, INVALIDPARAMETER, FAILURE
  */
 bStatus_t BLEAppUtil_unRegisterEventHandler(BLEAppUtil_EventHandler_t *eventHandler)
 {
-    BLEAppUtil_EventHandlersList_t *curr = BLEAppUtilEventHandlersHead;
-    BLEAppUtil_EventHandlersList_t *prev = NULL;
+    BLEAppUtil_handlerSnapshot_t *curr;
+    BLEAppUtil_handlerSnapshot_t *newSnapshot = NULL;
     bStatus_t status = INVALIDPARAMETER;
+    uint8_t i;
+    uint8_t j;
+
+    if((eventHandler == NULL) ||
+       (eventHandler->handlerType >= BLEAPPUTIL_NUM_OF_HANDLER_TYPES))
+    {
+        return INVALIDPARAMETER;
+    }
 
     // Lock the Mutex
     pthread_mutex_lock(&mutex);
 
-    // Go over the handlers list
-    while(curr != NULL)
+    curr = BLEAppUtilHandlerSnapshots[eventHandler->handlerType];
+
+    // Go over the handlers of this type
+    for(i = 0; (curr != NULL) && (i < curr->numHandlers); i++)
     {
-        // The item containing the handler to un-register is found
-        if(curr->eventHandler == eventHandler)
+        // The handler to un-register is found
+        if(curr->handlers[i] == eventHandler)
         {
-            // The item is the head
-            if(prev == NULL)
+            // Build a snapshot without it, unless it was the last one
+            if(curr->numHandlers > 1)
             {
-                // Change the head to point the next item in the list
-                BLEAppUtilEventHandlersHead = (BLEAppUtil_EventHandlersList_t *)curr->next;
-            }
-            // The item is not the head
-            else
-            {
-                prev->next = curr->next;
+                newSnapshot = BLEAppUtil_allocSnapshot(curr->numHandlers - 1);
+                if(newSnapshot == NULL)
+                {
+                    status = FAILURE;
+                    break;
+                }
+
+                for(j = 0; j < newSnapshot->numHandlers; j++)
+                {
+                    newSnapshot->handlers[j] = curr->handlers[(j < i) ? j : (j + 1)];
+                }
             }
 
-            // Free the item
-            BLEAppUtil_free(curr);
+            BLEAppUtil_publishSnapshot(eventHandler->handlerType, newSnapshot);
 
             // Set the status to SUCCESS
             status = SUCCESS;
             break;
         }
-
-        // Update the prev item to point the current item
-        prev = curr;
-        // Update the current item to point the next item
-        curr = (BLEAppUtil_EventHandlersList_t *)prev->next;
     }
 
     // Unlock the Mutex - handler was removed from the list
@@ -276,6 +298,40 @@ bStatus_t BLEAppUtil_unRegisterEventHandler(BLEAppUtil_EventHandler_t *eventHand
     return status;
 }
 
+/*********************************************************************
+ * @fn      BLEAppUtil_reclaimHandlerSnapshots
+ *
+ * @brief   Free the handler snapshots replaced by register/un-register.
+ *          Must be called from the BLEAppUtil task between messages,
+ *          when no BLEAppUtil_callEventHandler is in progress.
+ *
+ * @return  None
+ */
+void BLEAppUtil_reclaimHandlerSnapshots(void)
+{
+    BLEAppUtil_handlerSnapshot_t *retired;
+
+    // Nothing to free - avoid taking the mutex
+    if(BLEAppUtilRetiredSnapshots == NULL)
+    {
+        return;
+    }
+
+    // Lock the Mutex
+    pthread_mutex_lock(&mutex);
+    retired = BLEAppUtilRetiredSnapshots;
+    BLEAppUtilRetiredSnapshots = NULL;
+    // Unlock the Mutex - the retired list was taken
+    pthread_mutex_unlock(&mutex);
+
+    while(retired != NULL)
+    {
+        BLEAppUtil_handlerSnapshot_t *next = retired->retiredNext;
+
+        BLEAppUtil_free(retired);
+        retired = next;
+    }
+}
 
 /*********************************************************************
  * @fn      BLEAppUtil_invokeFunctionNoData
@@ -317,8 +373,8 @@ bStatus_t BLEAppUtil_invokeFunction(InvokeFromBLEAppUtilContext_t callback, char
         return FAILURE;
     }
 
-    // Create a BLEAppUtil_CallbackToInvoke_t and assign parameters
-    pDataMsg = BLEAppUtil_malloc(sizeof(BLEAppUtil_CallbackToInvoke_t));
+    // Take a BLEAppUtil_CallbackToInvoke_t from the pool and assign parameters
+    pDataMsg = BLEAppUtil_allocMsg();
 
     // If the allocation failed, return an error
     if(pDataMsg == NULL)
@@ -340,7 +396,7 @@ bStatus_t BLEAppUtil_invokeFunction(InvokeFromBLEAppUtilContext_t callback, char
         {
             BLEAppUtil_free(pData);
         }
-        BLEAppUtil_free(pDataMsg);
+        BLEAppUtil_releaseMsg(pDataMsg);
         return FAILURE;
     }
     return SUCCESS;
@@ -437,29 +493,101 @@ BLEAppUtil_entityId_t BLEAppUtil_getSelfEntity(void)
     return BLEAppUtilSelfEntity;
 }
 
+/*********************************************************************
+ * @fn      BLEAppUtil_allocSnapshot
+ *
+ * @brief   Allocate a handler snapshot for the given number of handlers
+ *
+ * @param   numHandlers - Number of handlers the snapshot holds
+ *
+ * @return  The allocated snapshot, NULL if the allocation failed
+ */
+static BLEAppUtil_handlerSnapshot_t *BLEAppUtil_allocSnapshot(uint8_t numHandlers)
+{
+    BLEAppUtil_handlerSnapshot_t *snapshot;
+
+    snapshot = (BLEAppUtil_handlerSnapshot_t *)BLEAppUtil_malloc(sizeof(BLEAppUtil_handlerSnapshot_t) +
+                                                                 (numHandlers * sizeof(BLEAppUtil_EventHandler_t *)));
+    if(snapshot != NULL)
+    {
+        snapshot->retiredNext = NULL;
+        snapshot->numHandlers = numHandlers;
+    }
+
+    return snapshot;
+}
+
+/*********************************************************************
+ * @fn      BLEAppUtil_publishSnapshot
+ *
+ * @brief   Replace the handler snapshot of a type, update the type
+ *          event mask and move the old snapshot to the retired list.
+ *          Must be called with the mutex locked.
+ *
+ * @param   type        - The handler type
+ * @param   newSnapshot - The new snapshot, NULL if no handlers are left
+ *
+ * @return  None
+ */
+static void BLEAppUtil_publishSnapshot(BLEAppUtil_eventHandlerType_e type,
+                                       BLEAppUtil_handlerSnapshot_t *newSnapshot)
+{
+    BLEAppUtil_handlerSnapshot_t *oldSnapshot = BLEAppUtilHandlerSnapshots[type];
+    uint32_t eventMask = 0;
+    uint8_t i;
+
+    if(newSnapshot != NULL)
+    {
+        // PASSCODE and L2CAP_DATA handlers receive all the data of their type
+        if((type == BLEAPPUTIL_PASSCODE_TYPE) ||
+           (type == BLEAPPUTIL_L2CAP_DATA_TYPE))
+        {
+            eventMask = 0xFFFFFFFF;
+        }
+        else
+        {
+            for(i = 0; i < newSnapshot->numHandlers; i++)
+            {
+                eventMask |= newSnapshot->handlers[i]->eventMask;
+            }
+        }
+    }
+
+    // Publish the handlers before the mask, so an enabled event always
+    // finds its handler
+    BLEAppUtilHandlerSnapshots[type] = newSnapshot;
+    BLEAppUtilHandlerEventMasks[type] = eventMask;
+
+    // The old snapshot may still be used by a running dispatch
+    if(oldSnapshot != NULL)
+    {
+        oldSnapshot->retiredNext = BLEAppUtilRetiredSnapshots;
+        BLEAppUtilRetiredSnapshots = oldSnapshot;
+    }
+}
+
 /*********************************************************************
  * @fn      BLEAppUtil_createQueue
  *
- * @brief   Create a message queue for message to be sent to BLEAppUtil
+ * @brief   Create the message pool and queue for message to be sent
+ *          to BLEAppUtil
  *
  * @return  SUCCESS, FAILURE
  */
 static bStatus_t BLEAppUtil_createQueue(void)
 {
-     struct mq_attr attr;
-
-     attr.mq_flags = 0; // Parameter mq_flags is ignored when the queue is created with O_CREAT
-     attr.mq_curmsgs = 0;
-     attr.mq_maxmsg = 8;
-     attr.mq_msgsize = sizeof(BLEAppUtil_appEvt_t);
-
-     /* Create the message queue */
-     BLEAppUtil_theardEntity.queueHandle = mq_open("BLEAppUtil_theardQueue", O_CREAT , 0, &attr);
+     BLEAppUtil_theardEntity.queueHead = NULL;
+     BLEAppUtil_theardEntity.queueTail = NULL;
 
-     if (BLEAppUtil_theardEntity.queueHandle == (mqd_t)-1)
+     /* Create the semaphore counting the queued messages */
+     if (sem_init(&BLEAppUtil_theardEntity.queueSem, 0, 0) != 0)
      {
          return FAILURE;
      }
+
+     /* Messages can be allocated from now on */
+     BLEAppUtil_initMsgPool();
+
      return SUCCESS;
 }
 
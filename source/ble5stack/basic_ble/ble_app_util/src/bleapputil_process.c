@@ -1099,6 +1099,9 @@ uint8_t BLEAppUtil_isPairStateEventRequired(uint8_t event,
  *          type if it's eventMask contains the received event or
  *          if are from the type receiving data only:
  *          BLEAPPUTIL_PASSCODE_TYPE and BLEAPPUTIL_L2CAP_DATA_TYPE
+ *          The handlers are taken from the snapshot published for the
+ *          type, so no lock is taken. Must only be called from the
+ *          BLEAppUtil task, see @ref BLEAppUtil_reclaimHandlerSnapshots.
  *
  * @param   event   - The event the application handler will receive
  * @param   pMsg    - The msg the application handler will receive
@@ -1108,112 +1111,70 @@ uint8_t BLEAppUtil_isPairStateEventRequired(uint8_t event,
  */
 void BLEAppUtil_callEventHandler(uint32_t event, BLEAppUtil_msgHdr_t *pMsg, BLEAppUtil_eventHandlerType_e type)
 {
-    BLEAppUtil_EventHandlersList_t *handler = NULL;
+    BLEAppUtil_handlerSnapshot_t *snapshot;
+    uint8_t i;
 
-    // Lock the Mutex
-    pthread_mutex_lock(&mutex);
+    if(type >= BLEAPPUTIL_NUM_OF_HANDLER_TYPES)
+    {
+        return;
+    }
+
+    // Take the handlers registered for this type. A handler that registers
+    // or un-registers from within the loop publishes a new snapshot, this
+    // one stays valid until the dispatch is done.
+    snapshot = BLEAppUtilHandlerSnapshots[type];
+    if(snapshot == NULL)
+    {
+        return;
+    }
 
-    // Get the handler if exist
-    handler = BLEAppUtil_getEventHandler(handler, type);
-    // Iterate over the handlers list
-    while(handler != NULL)
+    // Iterate over the handlers of this type
+    for(i = 0; i < snapshot->numHandlers; i++)
     {
         // If the handler is from PASSCODE or L2CAP_DATA types or
         // (for all other types) the event is part of the event mask,
         // call the handler
         if((type == BLEAPPUTIL_PASSCODE_TYPE) ||
            (type == BLEAPPUTIL_L2CAP_DATA_TYPE) ||
-           (handler->eventHandler->eventMask & event))
+           (snapshot->handlers[i]->eventMask & event))
         {
-            handler->eventHandler->pEventHandler(event, pMsg);
+            snapshot->handlers[i]->pEventHandler(event, pMsg);
         }
-
-        // Get the next handler if exist
-        handler = BLEAppUtil_getEventHandler(handler, type);
     }
-
-    // Unlock the Mutex - handlers were called
-    pthread_mutex_unlock(&mutex);
 }
 
 /*********************************************************************
  * @fn      BLEAppUtil_isEventEnabled
  *
- * @brief   Returns the event mask of all registered event handlers from
- *          a specific event handler type.
+ * @brief   Check the combined event mask of all registered event
+ *          handlers from a specific event handler type.
+ *          The mask is kept up to date on register/un-register, so this
+ *          is safe to call from the stack callbacks context.
  *
  * @param   eventHandlerType - Handler type to get the event masks for
  * @param   event - The event to verify that is required
  *
- * @return  The bieMask of all relevant event handlers
+ * @return  TRUE if at least one handler requires the event, FALSE otherwise
  */
 uint8_t BLEAppUtil_isEventEnabled(BLEAppUtil_eventHandlerType_e eventHandlerType,
                                   uint32_t event)
 {
-    uint8_t isRequired = false;
-    BLEAppUtil_EventHandlersList_t *handler = NULL;
+    uint32_t eventMask;
 
-    // Get the handler if exist
-    handler = BLEAppUtil_getEventHandler(handler, eventHandlerType);
-    while(handler != NULL)
+    if(eventHandlerType >= BLEAPPUTIL_NUM_OF_HANDLER_TYPES)
     {
-        // Check if it's event mask contains the event
-        if((eventHandlerType == BLEAPPUTIL_PASSCODE_TYPE) ||
-           (eventHandlerType == BLEAPPUTIL_L2CAP_DATA_TYPE) ||
-           (handler->eventHandler->eventMask & event))
-        {
-            isRequired = true;
-            break;
-        }
-
-        // Get the next handler if exist
-        handler = BLEAppUtil_getEventHandler(handler, eventHandlerType);
+        return false;
     }
 
-    return isRequired;
-}
+    eventMask = BLEAppUtilHandlerEventMasks[eventHandlerType];
 
-/*********************************************************************
- * @fn      BLEAppUtil_getEventHandler
- *
- * @brief   Search for an event handler from a given type starting
- *          from the given handler pointer of from the head of the
- *          handlers list if NULL is received.
- *
- * @param   handler - The handler to start the search from (start from head if NULL)
- * @param   eventHandlerType - Handler type to get the event masks for
- *
- * @return  The bieMask of all relevant event handlers
- */
-BLEAppUtil_EventHandlersList_t *BLEAppUtil_getEventHandler(BLEAppUtil_EventHandlersList_t *handler,
-                                                           BLEAppUtil_eventHandlerType_e eventHandlerType)
-{
-    BLEAppUtil_EventHandlersList_t *iter = NULL;
-
-    // If the header value is NULL start the search from the head of the list
-    if(handler == NULL)
-    {
-        iter = BLEAppUtilEventHandlersHead;
-    }
-    // Start the search from the next handler
-    else
-    {
-        iter = (BLEAppUtil_EventHandlersList_t *)handler->next;
-    }
-
-    // Iterate over the handlers list
-    while(iter != NULL)
+    // PASSCODE and L2CAP_DATA handlers receive all the data of their type,
+    // their mask is set to all ones while at least one is registered
+    if((eventHandlerType == BLEAPPUTIL_PASSCODE_TYPE) ||
+       (eventHandlerType == BLEAPPUTIL_L2CAP_DATA_TYPE))
     {
-        // If this is an handler from the required type
-        if(iter->eventHandler->handlerType == eventHandlerType)
-        {
-            // Break from the loop to return the current item in the list
-            break;
-        }
-
-        // Next item in the list
-        iter = (BLEAppUtil_EventHandlersList_t *)iter->next;
+        return (eventMask != 0);
     }
 
-    return iter;
+    return ((eventMask & event) != 0);
 }
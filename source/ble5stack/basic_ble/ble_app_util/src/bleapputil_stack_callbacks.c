@@ -98,7 +98,8 @@ uint8_t BLEAppUtil_processStackMsgCB(uint8_t event, uint8_t *pMessage)
     // task function (there should be a few events with this behavior
     if(BLEAppUtil_isStackEventRequired((BLEAppUtil_msgHdr_t *)pMessage, &bleAppUtilEventAndHandle) == true)
     {
-        pData = BLEAppUtil_malloc(sizeof(BLEAppUtil_stackMsgData_t));
+        // Take the message from the pool, no allocation is done here
+        pData = BLEAppUtil_allocMsg();
 
         if (pData != NULL)
         {
@@ -112,7 +113,7 @@ uint8_t BLEAppUtil_processStackMsgCB(uint8_t event, uint8_t *pMessage)
                 // Indicate that it is safe to dealloc since the enqueue failed
                 safeToDealloc = true;
                 // Free the data
-                BLEAppUtil_free(pData);
+                BLEAppUtil_releaseMsg(pData);
             }
         }
     }
@@ -144,10 +145,10 @@ void BLEAppUtil_pairStateCB(uint16_t connHandle, uint8_t state, uint8_t status)
 
     if(BLEAppUtil_isPairStateEventRequired(state, &bleAppUtilEvent) == true)
     {
-        // Allocate the data if the the application is registered to it
-        pData = BLEAppUtil_malloc(sizeof(BLEAppUtil_PairStateData_t));
+        // Take the data from the pool if the the application is registered to it
+        pData = BLEAppUtil_allocMsg();
 
-        // Allocate space for the event data
+        // Fill the event data
         if (pData != NULL)
         {
             pData->connHandle = connHandle;
@@ -157,7 +158,7 @@ void BLEAppUtil_pairStateCB(uint16_t connHandle, uint8_t state, uint8_t status)
             // Queue the event
             if (BLEAppUtil_enqueueMsg(BLEAPPUTIL_EVT_PAIRING_STATE_CB, pData) != SUCCESS)
             {
-                BLEAppUtil_free(pData);
+                BLEAppUtil_releaseMsg(pData);
             }
         }
     }
@@ -190,8 +191,8 @@ void BLEAppUtil_passcodeCB(uint8_t *pDeviceAddr,
 
     if(BLEAppUtil_isEventEnabled(BLEAPPUTIL_PASSCODE_TYPE, 0))
     {
-        // Allocate space for the passcode event
-        pData = BLEAppUtil_malloc(sizeof(BLEAppUtil_PasscodeData_t));
+        // Take the passcode event from the pool
+        pData = BLEAppUtil_allocMsg();
         if (pData != NULL)
         {
             pData->connHandle = connHandle;
@@ -203,7 +204,7 @@ void BLEAppUtil_passcodeCB(uint8_t *pDeviceAddr,
             // Enqueue the event.
             if(BLEAppUtil_enqueueMsg(BLEAPPUTIL_EVT_PASSCODE_NEEDED_CB, pData) != SUCCESS)
             {
-                BLEAppUtil_free(pData);
+                BLEAppUtil_releaseMsg(pData);
             }
         }
     }
@@ -227,7 +228,7 @@ void BLEAppUtil_connEventCB(Gap_ConnEventRpt_t *pReport)
     // Check if the event is required by the application
     if(BLEAppUtil_isConnEventRequired(pReport, &event) == true)
     {
-        pData = BLEAppUtil_malloc(sizeof(BLEAppUtil_connEventNoti_t));
+        pData = BLEAppUtil_allocMsg();
 
         if(pData != NULL)
         {
@@ -241,7 +242,7 @@ void BLEAppUtil_connEventCB(Gap_ConnEventRpt_t *pReport)
             }
             else
             {
-                BLEAppUtil_free(pData);
+                BLEAppUtil_releaseMsg(pData);
             }
         }
     }
@@ -270,7 +271,7 @@ void BLEAppUtil_scanCB(uint32_t event, GapScan_data_t *pBuf, uint32_t *arg)
 
     if(BLEAppUtil_isEventEnabled(BLEAPPUTIL_GAP_SCAN_TYPE, event) == true)
     {
-        pData = BLEAppUtil_malloc(sizeof(BLEAppUtil_ScanEventData_t));
+        pData = BLEAppUtil_allocMsg();
 
         if (pData != NULL)
         {
@@ -285,7 +286,7 @@ void BLEAppUtil_scanCB(uint32_t event, GapScan_data_t *pBuf, uint32_t *arg)
             }
             else
             {
-                BLEAppUtil_free(pData);
+                BLEAppUtil_releaseMsg(pData);
             }
         }
     }
@@ -324,7 +325,7 @@ void BLEAppUtil_advCB(uint32_t event, GapAdv_data_t *pBuf, uint32_t *arg)
 
     if(BLEAppUtil_isEventEnabled(BLEAPPUTIL_GAP_ADV_TYPE, event) == true)
     {
-        pData = BLEAppUtil_malloc(sizeof(BLEAppUtil_AdvEventData_t));
+        pData = BLEAppUtil_allocMsg();
 
         if (pData != NULL)
         {
@@ -339,7 +340,7 @@ void BLEAppUtil_advCB(uint32_t event, GapAdv_data_t *pBuf, uint32_t *arg)
             }
             else
             {
-                BLEAppUtil_free(pData);
+                BLEAppUtil_releaseMsg(pData);
             }
         }
     }
@@ -368,7 +369,7 @@ void BLEAppUtil_HandoverSNCB(uint16_t connHandle, uint32_t status)
 {
     // Replace the callback to BLEAppUtill Event
     // Queue the event
-    uint8_t *pData = BLEAppUtil_malloc(sizeof(uint16_t) + sizeof(uint32_t));
+    uint8_t *pData = BLEAppUtil_allocMsg();
 
     if(pData != NULL)
     {
@@ -380,7 +381,10 @@ void BLEAppUtil_HandoverSNCB(uint16_t connHandle, uint32_t status)
         // Copy the status
         memcpy(pEvt, &status, sizeof(uint32_t));
 
-        BLEAppUtil_enqueueMsg(BLEAPPUTIL_EVT_HANDOVER_SN_EVENT_CB, pData);
+        if (BLEAppUtil_enqueueMsg(BLEAPPUTIL_EVT_HANDOVER_SN_EVENT_CB, pData) != SUCCESS)
+        {
+            BLEAppUtil_releaseMsg(pData);
+        }
     }
 }
 
@@ -398,7 +402,7 @@ void BLEAppUtil_HandoverCNCB(uint16_t connHandle, uint32_t status)
 {
     // Replace the callback to BLEAppUtill Event
     // Queue the event
-    uint8_t *pData = BLEAppUtil_malloc(sizeof(uint16_t) + sizeof(uint32_t));
+    uint8_t *pData = BLEAppUtil_allocMsg();
 
     if(pData != NULL)
     {
@@ -411,6 +415,9 @@ void BLEAppUtil_HandoverCNCB(uint16_t connHandle, uint32_t status)
         // Copy the status
         memcpy(pEvt, &status, sizeof(uint32_t));
 
-        BLEAppUtil_enqueueMsg(BLEAPPUTIL_EVT_HANDOVER_CN_EVENT_CB, pData);
+        if (BLEAppUtil_enqueueMsg(BLEAPPUTIL_EVT_HANDOVER_CN_EVENT_CB, pData) != SUCCESS)
+        {
+            BLEAppUtil_releaseMsg(pData);
+        }
     }
 }
@@ -49,12 +49,17 @@ Target Device: cc23xx
 /*********************************************************************
  * INCLUDES
  */
+#include <stddef.h>
+#include <ti/drivers/dpl/HwiP.h>
 #include <ti/bleapp/ble_app_util/inc/bleapputil_api.h>
 #include <ti/bleapp/ble_app_util/inc/bleapputil_internal.h>
 
 /*********************************************************************
  * MACROS
  */
+// Get the pool message holding the given message data
+#define BLEAPPUTIL_POOL_MSG(pData) \
+    ((BLEAppUtil_poolMsg_t *)((uint8_t *)(pData) - offsetof(BLEAppUtil_poolMsg_t, data)))
 
 
 /*********************************************************************
@@ -76,11 +81,16 @@ Target Device: cc23xx
 /*********************************************************************
 * LOCAL VARIABLES
 */
+// Message pool and its free list
+static BLEAppUtil_poolMsg_t BLEAppUtil_msgPool[BLEAPPUTIL_MSG_POOL_SIZE];
+static BLEAppUtil_poolMsg_t *BLEAppUtil_msgPoolFree = NULL;
+static BLEAppUtil_MsgPoolStats_t BLEAppUtil_msgPoolStats = {0};
 
 /*********************************************************************
 * LOCAL FUNCTIONS
 */
 void *BLEAppUtil_Task(void *arg);
+static BLEAppUtil_poolMsg_t *BLEAppUtil_dequeueMsg(void);
 
 /*********************************************************************
  * EXTERN FUNCTIONS
@@ -94,6 +104,32 @@ void *BLEAppUtil_Task(void *arg);
  * PUBLIC FUNCTIONS
  */
 
+/*********************************************************************
+ * @fn      BLEAppUtil_getMsgPoolStats
+ *
+ * @brief   Get the statistics of the message pool used to pass events
+ *          from the BLE stack callbacks to the BLEAppUtil task
+ *
+ * @param   pStats - Pointer to the statistics to fill
+ *
+ * @return  SUCCESS, INVALIDPARAMETER
+ */
+bStatus_t BLEAppUtil_getMsgPoolStats(BLEAppUtil_MsgPoolStats_t *pStats)
+{
+    uintptr_t key;
+
+    if(pStats == NULL)
+    {
+        return INVALIDPARAMETER;
+    }
+
+    key = HwiP_disable();
+    *pStats = BLEAppUtil_msgPoolStats;
+    HwiP_restore(key);
+
+    return SUCCESS;
+}
+
 /*********************************************************************
 * LOCAL FUNCTIONS
 */
@@ -125,35 +161,165 @@ int BLEAppUtil_createBLEAppUtilTask(void)
     return retVal;
 }
 
+/*********************************************************************
+ * @fn      BLEAppUtil_initMsgPool
+ *
+ * @brief   Link all the messages of the pool to the free list.
+ *          Until this is called @ref BLEAppUtil_allocMsg fails.
+ *
+ * @return  None
+ */
+void BLEAppUtil_initMsgPool(void)
+{
+    uint8_t i;
+
+    for(i = 0; i < BLEAPPUTIL_MSG_POOL_SIZE - 1; i++)
+    {
+        BLEAppUtil_msgPool[i].next = &BLEAppUtil_msgPool[i + 1];
+    }
+    BLEAppUtil_msgPool[BLEAPPUTIL_MSG_POOL_SIZE - 1].next = NULL;
+
+    BLEAppUtil_msgPoolFree = &BLEAppUtil_msgPool[0];
+    BLEAppUtil_msgPoolStats.poolSize = BLEAPPUTIL_MSG_POOL_SIZE;
+}
+
+/*********************************************************************
+ * @fn      BLEAppUtil_allocMsg
+ *
+ * @brief   Take a message from the pool. The caller fills the returned
+ *          data and passes it to @ref BLEAppUtil_enqueueMsg, or gives it
+ *          back with @ref BLEAppUtil_releaseMsg.
+ *          Can be called from any context.
+ *
+ * @return  Pointer to the message data, NULL if the pool is empty
+ */
+void *BLEAppUtil_allocMsg(void)
+{
+    BLEAppUtil_poolMsg_t *pMsg;
+    uintptr_t key;
+
+    key = HwiP_disable();
+
+    pMsg = BLEAppUtil_msgPoolFree;
+    if(pMsg != NULL)
+    {
+        BLEAppUtil_msgPoolFree = pMsg->next;
+
+        BLEAppUtil_msgPoolStats.inUse++;
+        if(BLEAppUtil_msgPoolStats.inUse > BLEAppUtil_msgPoolStats.highWater)
+        {
+            BLEAppUtil_msgPoolStats.highWater = BLEAppUtil_msgPoolStats.inUse;
+        }
+    }
+    else
+    {
+        BLEAppUtil_msgPoolStats.allocFailures++;
+    }
+
+    HwiP_restore(key);
+
+    return (pMsg != NULL) ? &pMsg->data : NULL;
+}
+
+/*********************************************************************
+ * @fn      BLEAppUtil_releaseMsg
+ *
+ * @brief   Return a message taken by @ref BLEAppUtil_allocMsg to the pool
+ *
+ * @param   pData - Pointer to the message data
+ *
+ * @return  None
+ */
+void BLEAppUtil_releaseMsg(void *pData)
+{
+    BLEAppUtil_poolMsg_t *pMsg;
+    uintptr_t key;
+
+    if(pData == NULL)
+    {
+        return;
+    }
+
+    pMsg = BLEAPPUTIL_POOL_MSG(pData);
+
+    key = HwiP_disable();
+    pMsg->next = BLEAppUtil_msgPoolFree;
+    BLEAppUtil_msgPoolFree = pMsg;
+    BLEAppUtil_msgPoolStats.inUse--;
+    HwiP_restore(key);
+}
+
 /*********************************************************************
  * @fn      BLEAppUtil_enqueueMsg
  *
  * @brief   Enqueue the message from the BLE stack to the application queue.
+ *          The message is linked to the queue in place, no copy is made.
  *
  * @param   event - message event.
- * @param   pData - pointer to the message from BLE stack.
+ * @param   pData - pointer to the message data, from @ref BLEAppUtil_allocMsg.
  *
  * @return  SUCCESS   - message was enqueued successfully
  * @return  otherwise - error value is returned
  */
 status_t BLEAppUtil_enqueueMsg(uint8_t event, void *pData)
 {
-    int8_t status = SUCCESS;
-    BLEAppUtil_appEvt_t msg;
+    BLEAppUtil_poolMsg_t *pMsg;
+    uintptr_t key;
 
-    // Check if the queue is valid
-    if (BLEAppUtil_theardEntity.queueHandle == (mqd_t)-1)
+    // Check if the message is valid
+    if (pData == NULL)
     {
         return(bleNotReady);
     }
 
-    msg.event = event;
-    msg.pData = pData;
+    pMsg = BLEAPPUTIL_POOL_MSG(pData);
+    pMsg->event = event;
+    pMsg->next = NULL;
 
-    // Send the msg to the application queue
-    status = mq_send(BLEAppUtil_theardEntity.queueHandle,(char*)&msg,sizeof(msg),1);
+    // Link the msg to the end of the application queue
+    key = HwiP_disable();
+    if (BLEAppUtil_theardEntity.queueTail == NULL)
+    {
+        BLEAppUtil_theardEntity.queueHead = pMsg;
+    }
+    else
+    {
+        BLEAppUtil_theardEntity.queueTail->next = pMsg;
+    }
+    BLEAppUtil_theardEntity.queueTail = pMsg;
+    HwiP_restore(key);
+
+    // Wake up the application task
+    sem_post(&BLEAppUtil_theardEntity.queueSem);
 
-    return status;
+    return SUCCESS;
+}
+
+/*********************************************************************
+ * @fn      BLEAppUtil_dequeueMsg
+ *
+ * @brief   Unlink the first message from the application queue
+ *
+ * @return  The message, NULL if the queue is empty
+ */
+static BLEAppUtil_poolMsg_t *BLEAppUtil_dequeueMsg(void)
+{
+    BLEAppUtil_poolMsg_t *pMsg;
+    uintptr_t key;
+
+    key = HwiP_disable();
+    pMsg = BLEAppUtil_theardEntity.queueHead;
+    if (pMsg != NULL)
+    {
+        BLEAppUtil_theardEntity.queueHead = pMsg->next;
+        if (BLEAppUtil_theardEntity.queueHead == NULL)
+        {
+            BLEAppUtil_theardEntity.queueTail = NULL;
+        }
+    }
+    HwiP_restore(key);
+
+    return pMsg;
 }
 
 /*********************************************************************
@@ -180,91 +346,88 @@ void *BLEAppUtil_Task(void *arg)
     // Application main loop
     for (;;)
     {
-        BLEAppUtil_appEvt_t pAppEvt;
-
-        // wait until receive queue message
-        if (mq_receive(BLEAppUtil_theardEntity.queueHandle, (char*)&pAppEvt, sizeof(pAppEvt), NULL) > 0)
+        // wait until a message is queued
+        if (sem_wait(&BLEAppUtil_theardEntity.queueSem) == 0)
         {
-            BLEAppUtil_msgHdr_t *pMsgData = (BLEAppUtil_msgHdr_t *)pAppEvt.pData;
-            bool freeMsg = FALSE;
+            BLEAppUtil_poolMsg_t *pAppEvt = BLEAppUtil_dequeueMsg();
+
+            if (pAppEvt == NULL)
+            {
+                continue;
+            }
 
-            switch (pAppEvt.event)
+            switch (pAppEvt->event)
             {
               case BLEAPPUTIL_EVT_STACK_CALLBACK:
               {
-                  // Cast to the stack MSG pointer format passed to the enqueue function
-                  BLEAppUtil_stackMsgData_t *stackMsg = (BLEAppUtil_stackMsgData_t *)pAppEvt.pData;
+                  // The stack MSG and its event passed to the enqueue function
+                  BLEAppUtil_stackMsgData_t *stackMsg = &pAppEvt->data.stackMsg;
 
-                  if(stackMsg != NULL)
+                  if(stackMsg->pMessage != NULL)
                   {
-                      // Set the flag to true to indicate that BLEAppUtil_freeMsg
-                      // should be used to free the msg
-                      freeMsg = TRUE;
-                      // Point to the msg that was received from the stack,
-                      // it will be freed in the end of this function
-                      pMsgData = stackMsg->pMessage;
-
                       // Process the stack event received
                       BLEAppUtil_processStackEvents(stackMsg->pMessage, stackMsg->eventAndHandlerType);
 
-                      // Free the stack msg
-                      BLEAppUtil_free(stackMsg);
+                      // Free the msg that was received from the stack
+                      BLEAppUtil_freeMsg(stackMsg->pMessage);
                   }
                 break;
               }
               case BLEAPPUTIL_EVT_ADV_CB_EVENT:
-                  BLEAppUtil_processAdvEventMsg(pMsgData);
+                  BLEAppUtil_processAdvEventMsg((bleStack_msgHdt_t *)&pAppEvt->data.advData);
                   break;
 
               case BLEAPPUTIL_EVT_SCAN_CB_EVENT:
-                  BLEAppUtil_processScanEventMsg(pMsgData);
+                  BLEAppUtil_processScanEventMsg((bleStack_msgHdt_t *)&pAppEvt->data.scanData);
                   break;
 
               case BLEAPPUTIL_EVT_PAIRING_STATE_CB:
-                  BLEAppUtil_processPairStateMsg(pMsgData);
+                  BLEAppUtil_processPairStateMsg((bleStack_msgHdt_t *)&pAppEvt->data.pairStateData);
                   break;
 
               case BLEAPPUTIL_EVT_PASSCODE_NEEDED_CB:
-                  BLEAppUtil_processPasscodeMsg(pMsgData);
+                  BLEAppUtil_processPasscodeMsg((bleStack_msgHdt_t *)&pAppEvt->data.passcodeData);
                   break;
 
               case BLEAPPUTIL_EVT_CONN_EVENT_CB:
               {
-                  // Cast to a msg from the type allocated in the callback
-                  BLEAppUtil_connEventNoti_t *connNotiData = (BLEAppUtil_connEventNoti_t *)pMsgData;
-
-                  // Point to the msg that was received from the stack,
-                  // it will be freed in the end of this function
-                  pMsgData = (BLEAppUtil_msgHdr_t *)connNotiData->connEventReport;
+                  BLEAppUtil_connEventNoti_t *connNotiData = &pAppEvt->data.connEventNoti;
 
                   BLEAppUtil_processConnEventMsg(connNotiData);
 
-                  // Free the data allocated in the callback
-                  BLEAppUtil_free(connNotiData);
+                  // Free the report that was received from the stack
+                  if(connNotiData->connEventReport != NULL)
+                  {
+                      BLEAppUtil_free(connNotiData->connEventReport);
+                  }
                   break;
               }
 
               case BLEAPPUTIL_EVT_CALL_IN_BLEAPPUTIL_CONTEXT:
               {
-                  ((BLEAppUtil_CallbackToInvoke_t *)pMsgData)->callback(((BLEAppUtil_CallbackToInvoke_t *)pMsgData)->data);
+                  BLEAppUtil_CallbackToInvoke_t *callbackToInvoke = &pAppEvt->data.callbackToInvoke;
+
+                  callbackToInvoke->callback(callbackToInvoke->data);
 
                   // Verify that the data is not NULL before freeing it
-                  if(((BLEAppUtil_CallbackToInvoke_t *)pMsgData)->data != NULL)
+                  if(callbackToInvoke->data != NULL)
                   {
-                      BLEAppUtil_free(((BLEAppUtil_CallbackToInvoke_t *)pMsgData)->data);
+                      BLEAppUtil_free(callbackToInvoke->data);
                   }
                   break;
               }
 
               case BLEAPPUTIL_EVT_HANDOVER_SN_EVENT_CB:
               {
-                  BLEAppUtil_processHandoverEventMsg(BLEAPPUTIL_HANDOVER_START_SERVING_EVENT_CODE, pMsgData);
+                  BLEAppUtil_processHandoverEventMsg(BLEAPPUTIL_HANDOVER_START_SERVING_EVENT_CODE,
+                                                     (BLEAppUtil_msgHdr_t *)pAppEvt->data.handoverData);
                   break;
               }
 
               case BLEAPPUTIL_EVT_HANDOVER_CN_EVENT_CB:
               {
-                  BLEAppUtil_processHandoverEventMsg(BLEAPPUTIL_HANDOVER_START_CANDIDATE_EVENT_CODE, pMsgData);
+                  BLEAppUtil_processHandoverEventMsg(BLEAPPUTIL_HANDOVER_START_CANDIDATE_EVENT_CODE,
+                                                     (BLEAppUtil_msgHdr_t *)pAppEvt->data.handoverData);
                   break;
               }
 
@@ -272,25 +435,12 @@ void *BLEAppUtil_Task(void *arg)
                   break;
             }
 
+            // Return the message to the pool
+            BLEAppUtil_releaseMsg(&pAppEvt->data);
 
-            // Free the data
-            if (pMsgData && freeMsg)
-            {
-                // Use freeMsg
-                BLEAppUtil_freeMsg(pMsgData);
-            }
-            else if (pMsgData)
-            {
-                // Use free
-                BLEAppUtil_free(pMsgData);
-                pMsgData = NULL;
-            }
-            else
-            {
-                /* this else clause is required, even if the
-                programmer expects this will never be reached
-                Fix Misra-C Required: MISRA.IF.NO_ELSE */
-            }
+            // No dispatch is in progress, free the handler snapshots
+            // replaced while processing this message
+            BLEAppUtil_reclaimHandlerSnapshots();
         }
     }
 }
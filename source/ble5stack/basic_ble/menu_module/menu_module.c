@@ -89,6 +89,9 @@ typedef enum
 #define MENU_MODULE_LONG_PRESS_DURATION     400
 #define MENU_MODULE_DEBOUNCE_DURATION       100
 
+#define MENU_MODULE_NAV_BAR_TITLE           "========================= Menu Navigation ========================="
+#define MENU_MODULE_SEPARATOR               "==================================================================="
+
 /******************************************************************************
  Globals
  *****************************************************************************/
@@ -213,16 +216,16 @@ void MenuModule_paramsInit(MenuModule_params_t* pParams)
  */
 void MenuModule_printMenuNavBar(void)
 {
-    // Print the menu navigation bar and separators rows
-    char menuNavigation[] = "========================= Menu Navigation =========================";
-    char menuSeparators[] = "===================================================================";
-    Display_printf(dispHandle, MENU_MODULE_NAV_BAR_HEADER, 0, "%s", menuNavigation);
+    // Print the menu navigation bar and separators rows. The rows are the
+    // format strings themselves, so deferred display backends keep them by
+    // reference instead of copying them
+    Display_printf(dispHandle, MENU_MODULE_NAV_BAR_HEADER, 0, MENU_MODULE_NAV_BAR_TITLE);
     Display_printf(dispHandle, MENU_MODULE_NAV_BAR_BTN_1, 0,
                    "|   BTN-1(Left) : Press ---> Next   | Long Press ---> Back        |");
     Display_printf(dispHandle, MENU_MODULE_NAV_BAR_BTN_2, 0,
                    "|   BTN-2(Right): Press ---> Select | Long Press ---> Main Menu   |");
-    Display_printf(dispHandle, MENU_MODULE_NAV_BAR_END, 0, "%s", menuSeparators);
-    Display_printf(dispHandle, MENU_MODULE_SEPARATE_ROW, 0, "%s", menuSeparators);
+    Display_printf(dispHandle, MENU_MODULE_NAV_BAR_END, 0, MENU_MODULE_SEPARATOR);
+    Display_printf(dispHandle, MENU_MODULE_SEPARATE_ROW, 0, MENU_MODULE_SEPARATOR);
 }
 
 /*********************************************************************
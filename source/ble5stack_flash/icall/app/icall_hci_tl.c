@@ -204,6 +204,33 @@
 
 #define HCI_MAX_TL_AE_DATA_LEN                   251
 
+#if defined(HOST_TL_ADV_RPT_BATCH) && !defined(BLE3_CMD)
+// Parameter length of a batched report event, opcode and status included.
+// Values above 255 are sent as HCI extended events.
+#if !defined(HOST_TL_ADV_BATCH_LEN)
+  #define HOST_TL_ADV_BATCH_LEN                  255
+#endif // !HOST_TL_ADV_BATCH_LEN
+
+// Maximum time (ms) a report is held before the batch is flushed
+#if !defined(HOST_TL_ADV_BATCH_FLUSH_MS)
+  #define HOST_TL_ADV_BATCH_FLUSH_MS             20
+#endif // !HOST_TL_ADV_BATCH_FLUSH_MS
+
+// Minimum RSSI change (dB) to forward a duplicate report, 0 to forward all
+#if !defined(HOST_TL_ADV_BATCH_RSSI_DELTA)
+  #define HOST_TL_ADV_BATCH_RSSI_DELTA           0
+#endif // !HOST_TL_ADV_BATCH_RSSI_DELTA
+
+// Number of advertisers tracked for duplicate suppression
+#if !defined(HOST_TL_ADV_DUP_TBL_SIZE)
+  #define HOST_TL_ADV_DUP_TBL_SIZE               16
+#endif // !HOST_TL_ADV_DUP_TBL_SIZE
+
+// Opcode (2), status and number of reports
+#define HOST_TL_ADV_BATCH_HDR_LEN                4
+#define HOST_TL_ADV_BATCH_MAX_REPORTS            0xFF
+#endif // HOST_TL_ADV_RPT_BATCH && !BLE3_CMD
+
 #define ADV_LEGACY_SET_HANDLE                    0
 #define ADV_INVALID_SET_HANDLE                   0xFF
 
@@ -246,6 +273,36 @@ typedef struct
   uint8_t* pData;
 }scanEvtCallback_t;
 
+#if defined(HOST_TL_ADV_RPT_BATCH) && !defined(BLE3_CMD)
+// Last report forwarded for an advertiser, used for duplicate suppression
+typedef struct
+{
+  uint8_t  addr[B_ADDR_LEN];
+  uint8_t  addrType;
+  uint8_t  evtType;
+  uint8_t  advSid;
+  int8_t   rssi;
+  uint16_t dataLen;
+  uint16_t dataHash;
+} hostTlAdvDupEntry_t;
+
+// Advertising report batch. buf holds the HCI event header followed by
+// HOST_TL_ADV_BATCH_HDR_LEN bytes and the serialized reports.
+typedef struct
+{
+  uint8_t             enable;
+  uint8_t             rssiDelta;
+  uint16_t            flushMs;
+  uint16_t            len;          // event parameter length queued in buf
+  uint8_t             numReports;
+  uint8_t             dupCount;     // valid entries in dupTbl
+  uint8_t             dupNext;      // next entry to replace once dupTbl is full
+  ICall_TimerID       timerId;
+  hostTlAdvDupEntry_t dupTbl[HOST_TL_ADV_DUP_TBL_SIZE];
+  uint8_t             buf[HCI_EVENT_MIN_LENGTH + HOST_TL_ADV_BATCH_LEN];
+} hostTlAdvBatch_t;
+#endif // HOST_TL_ADV_RPT_BATCH && !BLE3_CMD
+
 // Structure containing the parameter for the GAP advertiser Event callback
 typedef struct
 {
@@ -305,6 +362,17 @@ static aeEnableScanCmd_t    hci_tl_cmdScanEnable;
 
 #if ( HOST_CONFIG & ( CENTRAL_CFG | OBSERVER_CFG ) )
 static uint8_t              host_tl_gapScannerInitialized;
+
+#if defined(HOST_TL_ADV_RPT_BATCH) && !defined(BLE3_CMD)
+static hostTlAdvBatch_t     hostTlAdvBatch =
+{
+  .enable    = TRUE,
+  .rssiDelta = HOST_TL_ADV_BATCH_RSSI_DELTA,
+  .flushMs   = HOST_TL_ADV_BATCH_FLUSH_MS,
+  .len       = HOST_TL_ADV_BATCH_HDR_LEN,
+  .timerId   = ICALL_INVALID_TIMER_ID
+};
+#endif // HOST_TL_ADV_RPT_BATCH && !BLE3_CMD
 #endif
 
 #ifdef BLE3_CMD
@@ -481,6 +549,17 @@ static void      host_tl_advEvtCallbackProcess(advEvtCallback_t *advEvtCallback)
 static void      host_tl_scanEvtCallback(uint32_t event, void *pData, uintptr_t arg);
 static void      host_tl_scanEvtCallbackProcess(scanEvtCallback_t * scanEvtCallback);
 static void      host_tl_sendAdvReport(uint32_t event, GapScan_Evt_AdvRpt_t * advRpt);
+#ifndef BLE3_CMD
+static void      host_tl_buildAdvRptRecord(uint8_t *pBuf, GapScan_Evt_AdvRpt_t *advRpt,
+                                           uint16_t offset, uint16_t dataLen);
+#endif // !BLE3_CMD
+#if defined(HOST_TL_ADV_RPT_BATCH) && !defined(BLE3_CMD)
+static uint8_t   host_tl_advBatchIsDuplicate(GapScan_Evt_AdvRpt_t *advRpt);
+static uint8_t   host_tl_advBatchAdd(GapScan_Evt_AdvRpt_t *advRpt);
+static void      host_tl_advBatchFlush(void);
+static void      host_tl_advBatchTimeout(void *arg);
+static void      host_tl_advBatchTimeoutProcess(void *arg);
+#endif // HOST_TL_ADV_RPT_BATCH && !BLE3_CMD
 #endif // CENTRAL_CFG | OBSERVER_CFG
 
 #if ( HOST_CONFIG & ( PERIPHERAL_CFG | CENTRAL_CFG ) )
@@ -2613,6 +2692,21 @@ static void host_tl_scanEvtCallbackProcess(scanEvtCallback_t * scanEvtCallback)
     event = scanEvtCallback->event;
     pData = scanEvtCallback->pData;
 
+#if defined(HOST_TL_ADV_RPT_BATCH) && !defined(BLE3_CMD)
+    // Reports received so far must reach the host before any scanner event
+    if (event != GAP_EVT_ADV_REPORT)
+    {
+      host_tl_advBatchFlush();
+
+      if (event == GAP_EVT_SCAN_ENABLED)
+      {
+        // Each scan session starts without duplicate history
+        hostTlAdvBatch.dupCount = 0;
+        hostTlAdvBatch.dupNext  = 0;
+      }
+    }
+#endif // HOST_TL_ADV_RPT_BATCH && !BLE3_CMD
+
     //Only One event can be signal at a time
     switch(event)
     {
@@ -2774,6 +2868,25 @@ static void host_tl_sendAdvReport(uint32_t event, GapScan_Evt_AdvRpt_t * advRpt)
   {
       return;
   }
+
+#if defined(HOST_TL_ADV_RPT_BATCH) && !defined(BLE3_CMD)
+  if (hostTlAdvBatch.enable)
+  {
+    if (host_tl_advBatchIsDuplicate(advRpt) || host_tl_advBatchAdd(advRpt))
+    {
+      if (advRpt->pData)
+      {
+        ICall_free(advRpt->pData);
+      }
+      ICall_free(advRpt);
+      return;
+    }
+
+    // Too large to be batched, send it on its own after the queued reports
+    host_tl_advBatchFlush();
+  }
+#endif // HOST_TL_ADV_RPT_BATCH && !BLE3_CMD
+
   remainingLength = advRpt->dataLen;
 
   // Got the Report, Map it to the Extended Report Event...
@@ -2857,25 +2970,9 @@ static void host_tl_sendAdvReport(uint32_t event, GapScan_Evt_AdvRpt_t * advRpt)
       msg->pData[7] = BREAK_UINT32(event, 1);
       msg->pData[8] = BREAK_UINT32(event, 2);
       msg->pData[9] = BREAK_UINT32(event, 3);
-      msg->pData[10] = advRpt->evtType;  //Start of the event structure.
-      msg->pData[11] = advRpt->addrType;
-      memcpy(&msg->pData[12], advRpt->addr, B_ADDR_LEN);
-      msg->pData[18] = advRpt->primPhy;
-      msg->pData[19] = advRpt->secPhy;
-      msg->pData[20] = advRpt->advSid;
-      msg->pData[21] = advRpt->txPower;
-      msg->pData[22] = advRpt->rssi;
-      msg->pData[23] = advRpt->directAddrType;
-      memcpy(&msg->pData[24], advRpt->directAddr, B_ADDR_LEN);
-      msg->pData[30] = LO_UINT16(advRpt->periodicAdvInt);
-      msg->pData[31] = HI_UINT16(advRpt->periodicAdvInt);
-      msg->pData[32] = LO_UINT16(dataLen);
-      msg->pData[33] = HI_UINT16(dataLen);
-      // copy data
-      if (advRpt->dataLen)
-      {
-          memcpy(&msg->pData[34], advRpt->pData + (advRpt->dataLen - remainingLength) , dataLen);
-      }
+      //Start of the event structure.
+      host_tl_buildAdvRptRecord(&msg->pData[10], advRpt,
+                                advRpt->dataLen - remainingLength, dataLen);
 
       if (remainingLength > MAX_REPORT_DATA_SIZE)
       {
@@ -2912,6 +3009,308 @@ static void host_tl_sendAdvReport(uint32_t event, GapScan_Evt_AdvRpt_t * advRpt)
     ICall_free(advRpt);
   }
 }
+
+#ifndef BLE3_CMD
+/*********************************************************************
+ * @fn      host_tl_buildAdvRptRecord
+ *
+ * @brief   Serialize an advertisement report as carried by
+ *          HCI_EXT_GAP_ADV_SCAN_EVENT, followed by part of its payload.
+ *
+ * @param   pBuf    - destination, GAP_SCAN_EVENT_LENGTH + dataLen bytes.
+ *          advRpt  - pointer to the report.
+ *          offset  - offset of the first payload byte to copy.
+ *          dataLen - number of payload bytes to copy.
+ *
+ * @return  none
+ */
+static void host_tl_buildAdvRptRecord(uint8_t *pBuf, GapScan_Evt_AdvRpt_t *advRpt,
+                                      uint16_t offset, uint16_t dataLen)
+{
+  pBuf[0]  = advRpt->evtType;
+  pBuf[1]  = advRpt->addrType;
+  memcpy(&pBuf[2], advRpt->addr, B_ADDR_LEN);
+  pBuf[8]  = advRpt->primPhy;
+  pBuf[9]  = advRpt->secPhy;
+  pBuf[10] = advRpt->advSid;
+  pBuf[11] = advRpt->txPower;
+  pBuf[12] = advRpt->rssi;
+  pBuf[13] = advRpt->directAddrType;
+  memcpy(&pBuf[14], advRpt->directAddr, B_ADDR_LEN);
+  pBuf[20] = LO_UINT16(advRpt->periodicAdvInt);
+  pBuf[21] = HI_UINT16(advRpt->periodicAdvInt);
+  pBuf[22] = LO_UINT16(dataLen);
+  pBuf[23] = HI_UINT16(dataLen);
+  // copy data
+  if (dataLen)
+  {
+    memcpy(&pBuf[GAP_SCAN_EVENT_LENGTH], advRpt->pData + offset, dataLen);
+  }
+}
+#endif // !BLE3_CMD
+
+#if defined(HOST_TL_ADV_RPT_BATCH) && !defined(BLE3_CMD)
+/*********************************************************************
+ * @fn      host_tl_advBatchIsDuplicate
+ *
+ * @brief   Check if a report repeats the last one forwarded for the same
+ *          advertiser with an RSSI change below the configured threshold.
+ *          The duplicate table is updated with every forwarded report.
+ *
+ * @param   advRpt - pointer to the report.
+ *
+ * @return  TRUE if the report should be dropped, FALSE otherwise.
+ */
+static uint8_t host_tl_advBatchIsDuplicate(GapScan_Evt_AdvRpt_t *advRpt)
+{
+  hostTlAdvDupEntry_t *pEntry = NULL;
+  uint16_t hash = 0;
+  uint16_t i;
+  int16_t  rssiDiff;
+
+  // Incomplete or truncated reports are always forwarded
+  if ((hostTlAdvBatch.rssiDelta == 0) ||
+      (advRpt->evtType & ~AE_EVT_TYPE_COMPLETE_MASK))
+  {
+    return FALSE;
+  }
+
+  for (i = 0; i < advRpt->dataLen; i++)
+  {
+    hash = (hash * 31) + advRpt->pData[i];
+  }
+
+  for (i = 0; i < hostTlAdvBatch.dupCount; i++)
+  {
+    hostTlAdvDupEntry_t *pCur = &hostTlAdvBatch.dupTbl[i];
+
+    if ((pCur->addrType == advRpt->addrType) &&
+        (pCur->evtType  == advRpt->evtType)  &&
+        (pCur->advSid   == advRpt->advSid)   &&
+        (memcmp(pCur->addr, advRpt->addr, B_ADDR_LEN) == 0))
+    {
+      pEntry = pCur;
+      break;
+    }
+  }
+
+  if (pEntry != NULL)
+  {
+    rssiDiff = (int16_t)advRpt->rssi - pEntry->rssi;
+    if (rssiDiff < 0)
+    {
+      rssiDiff = -rssiDiff;
+    }
+
+    // The stored RSSI is only refreshed on forwarded reports so a slow
+    // drift is still reported once it exceeds the threshold.
+    if ((pEntry->dataLen == advRpt->dataLen) &&
+        (pEntry->dataHash == hash) &&
+        (rssiDiff < hostTlAdvBatch.rssiDelta))
+    {
+      return TRUE;
+    }
+  }
+  else
+  {
+    if (hostTlAdvBatch.dupCount < HOST_TL_ADV_DUP_TBL_SIZE)
+    {
+      pEntry = &hostTlAdvBatch.dupTbl[hostTlAdvBatch.dupCount++];
+    }
+    else
+    {
+      pEntry = &hostTlAdvBatch.dupTbl[hostTlAdvBatch.dupNext];
+      hostTlAdvBatch.dupNext = (hostTlAdvBatch.dupNext + 1) % HOST_TL_ADV_DUP_TBL_SIZE;
+    }
+
+    memcpy(pEntry->addr, advRpt->addr, B_ADDR_LEN);
+    pEntry->addrType = advRpt->addrType;
+    pEntry->evtType  = advRpt->evtType;
+    pEntry->advSid   = advRpt->advSid;
+  }
+
+  pEntry->rssi     = advRpt->rssi;
+  pEntry->dataLen  = advRpt->dataLen;
+  pEntry->dataHash = hash;
+
+  return FALSE;
+}
+
+/*********************************************************************
+ * @fn      host_tl_advBatchAdd
+ *
+ * @brief   Append a report to the batch, flushing the batch first if the
+ *          report does not fit in the space left.
+ *
+ * @param   advRpt - pointer to the report.
+ *
+ * @return  TRUE if the report was queued, FALSE if it can never fit in a
+ *          batch and must be sent on its own.
+ */
+static uint8_t host_tl_advBatchAdd(GapScan_Evt_AdvRpt_t *advRpt)
+{
+  uint16_t rptLen = GAP_SCAN_EVENT_LENGTH + advRpt->dataLen;
+
+  if (rptLen > (HOST_TL_ADV_BATCH_LEN - HOST_TL_ADV_BATCH_HDR_LEN))
+  {
+    return FALSE;
+  }
+
+  ICall_CSState key;
+  uint8_t numReports;
+
+  if (hostTlAdvBatch.len + rptLen > HOST_TL_ADV_BATCH_LEN)
+  {
+    host_tl_advBatchFlush();
+  }
+
+  // The flush timer may empty the batch, append under a critical section
+  key = ICall_enterCriticalSection();
+  host_tl_buildAdvRptRecord(&hostTlAdvBatch.buf[HCI_EVENT_MIN_LENGTH + hostTlAdvBatch.len],
+                            advRpt, 0, advRpt->dataLen);
+  hostTlAdvBatch.len += rptLen;
+  numReports = ++hostTlAdvBatch.numReports;
+  ICall_leaveCriticalSection(key);
+
+  if (numReports == HOST_TL_ADV_BATCH_MAX_REPORTS)
+  {
+    host_tl_advBatchFlush();
+  }
+  else if ((numReports == 1) && hostTlAdvBatch.flushMs)
+  {
+    // Bound the latency of the first report queued
+    if (ICall_setTimerMSecs(hostTlAdvBatch.flushMs, host_tl_advBatchTimeout,
+                            &hostTlAdvBatch, &hostTlAdvBatch.timerId) != ICALL_ERRNO_SUCCESS)
+    {
+      host_tl_advBatchFlush();
+    }
+  }
+
+  return TRUE;
+}
+
+/*********************************************************************
+ * @fn      host_tl_advBatchFlush
+ *
+ * @brief   Send the queued reports as one HCI_EXT_GAP_ADV_RPT_BATCH_EVENT.
+ *          May run from the flush timer when the callback event hook does
+ *          not switch context. The batch is emptied under a critical section
+ *          before it is sent: the timer cannot be preempted by the TL task,
+ *          and the TL task adds no report while it is sending, so buf is
+ *          stable until the send returns.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+static void host_tl_advBatchFlush(void)
+{
+  uint8_t *pBuf = hostTlAdvBatch.buf;
+  ICall_CSState key;
+  uint16_t len;
+  uint8_t  numReports;
+
+  key = ICall_enterCriticalSection();
+  len        = hostTlAdvBatch.len;
+  numReports = hostTlAdvBatch.numReports;
+  hostTlAdvBatch.len        = HOST_TL_ADV_BATCH_HDR_LEN;
+  hostTlAdvBatch.numReports = 0;
+  ICall_leaveCriticalSection(key);
+
+  if (numReports == 0)
+  {
+    return;
+  }
+
+  if (hostTlAdvBatch.timerId != ICALL_INVALID_TIMER_ID)
+  {
+    ICall_stopTimer(hostTlAdvBatch.timerId);
+  }
+
+  if (len < 0x100)
+  {
+    pBuf[0] = HCI_EVENT_PACKET;
+    pBuf[1] = HCI_VE_EVENT_CODE;
+    pBuf[2] = len;
+  }
+  else
+  {
+    pBuf[0] = HCI_EXTENDED_EVENT_PACKET;
+    pBuf[1] = LO_UINT16(len);
+    pBuf[2] = HI_UINT16(len);
+  }
+  pBuf[3] = LO_UINT16(HCI_EXT_GAP_ADV_RPT_BATCH_EVENT);
+  pBuf[4] = HI_UINT16(HCI_EXT_GAP_ADV_RPT_BATCH_EVENT);
+  pBuf[5] = SUCCESS;
+  pBuf[6] = numReports;
+
+  // Send to High Layer.
+  if (HCI_TL_CommandStatusCB)
+  {
+    HCI_TL_CommandStatusCB(pBuf, HCI_EVENT_MIN_LENGTH + len);
+  }
+}
+
+/*********************************************************************
+ * @fn      host_tl_advBatchTimeout
+ *
+ * @brief   Batch flush timer callback, called from the timer (Swi) context.
+ *          The flush is posted through the callback event hook so it runs
+ *          in the TL task when the hook queues it. Hooks that run the
+ *          callback in the caller context (HCI_ControllerToHostSendCallbackEvent)
+ *          flush from the timer, which host_tl_advBatchFlush allows.
+ *
+ * @param   arg - pointer to the batch.
+ *
+ * @return  none
+ */
+static void host_tl_advBatchTimeout(void *arg)
+{
+  if ((HCI_TL_CallbackEvtProcessCB == NULL) ||
+      !HCI_TL_CallbackEvtProcessCB(arg, (void*) host_tl_advBatchTimeoutProcess))
+  {
+    // Nowhere to post the flush, do not hold the reports any longer
+    host_tl_advBatchFlush();
+  }
+}
+
+/*********************************************************************
+ * @fn      host_tl_advBatchTimeoutProcess
+ *
+ * @brief   Flush the batch once its flush period has expired.
+ *
+ * @param   arg - pointer to the batch.
+ *
+ * @return  none
+ */
+static void host_tl_advBatchTimeoutProcess(void *arg)
+{
+  (void) arg;
+  host_tl_advBatchFlush();
+}
+
+/*********************************************************************
+ * @fn      HCI_TL_setAdvReportBatch
+ *
+ * @brief   Configure batching of GAP advertising reports.
+ *
+ * @param   enable    - TRUE to batch reports.
+ *          flushMs   - maximum time a report stays queued, 0 to disable.
+ *          rssiDelta - RSSI change to forward a duplicate, 0 to disable.
+ *
+ * @return  none.
+ */
+void HCI_TL_setAdvReportBatch(uint8_t enable, uint16_t flushMs, uint8_t rssiDelta)
+{
+  host_tl_advBatchFlush();
+
+  hostTlAdvBatch.enable    = enable;
+  hostTlAdvBatch.flushMs   = flushMs;
+  hostTlAdvBatch.rssiDelta = rssiDelta;
+  hostTlAdvBatch.dupCount  = 0;
+  hostTlAdvBatch.dupNext   = 0;
+}
+#endif // HOST_TL_ADV_RPT_BATCH && !BLE3_CMD
 #endif //CENTRAL_CFG | OBSERVER_CFG
 
 #if ( HOST_CONFIG & ( PERIPHERAL_CFG | BROADCASTER_CFG ) )
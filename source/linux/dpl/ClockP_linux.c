@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== ClockP_linux.c ========
+ *
+ *  ClockP on the virtual time of DPLLinux. Clock functions run in interrupt
+ *  context, from the thread that advanced time.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <ti/drivers/dpl/ClockP.h>
+
+#include "DPLLinux.h"
+
+/* Frequency reported by ClockP_getCpuFreq(), same as the CC23X0 CPU */
+#ifndef ClockPLinux_CPU_FREQ
+    #define ClockPLinux_CPU_FREQ 48000000
+#endif
+
+typedef struct ClockPLinux_Obj
+{
+    struct ClockPLinux_Obj *next; /* next running clock */
+    ClockP_Fxn fxn;
+    uintptr_t arg;
+    uint32_t timeout;
+    uint32_t period;
+    uint64_t expiry;
+    bool active;
+    bool isDynamic;
+} ClockPLinux_Obj;
+
+static_assert(sizeof(ClockPLinux_Obj) <= sizeof(ClockP_Struct), "ClockP object too small");
+
+/* Running clocks, unordered */
+static ClockPLinux_Obj *activeList;
+
+static void clockRemove(ClockPLinux_Obj *obj);
+
+/*
+ *  ======== ClockP_construct ========
+ */
+ClockP_Handle ClockP_construct(ClockP_Struct *clockP, ClockP_Fxn clockFxn, uint32_t timeout, ClockP_Params *params)
+{
+    ClockPLinux_Obj *obj = (ClockPLinux_Obj *)clockP;
+    ClockP_Params defaultParams;
+
+    if (params == NULL)
+    {
+        params = &defaultParams;
+        ClockP_Params_init(params);
+    }
+
+    obj->next      = NULL;
+    obj->fxn       = clockFxn;
+    obj->arg       = params->arg;
+    obj->timeout   = timeout;
+    obj->period    = params->period;
+    obj->expiry    = 0;
+    obj->active    = false;
+    obj->isDynamic = false;
+
+    if (params->startFlag)
+    {
+        ClockP_start((ClockP_Handle)obj);
+    }
+
+    return ((ClockP_Handle)obj);
+}
+
+/*
+ *  ======== ClockP_destruct ========
+ */
+void ClockP_destruct(ClockP_Struct *clockP)
+{
+    ClockP_stop((ClockP_Handle)clockP);
+}
+
+/*
+ *  ======== ClockP_create ========
+ */
+ClockP_Handle ClockP_create(ClockP_Fxn clockFxn, uint32_t timeout, ClockP_Params *params)
+{
+    ClockP_Struct *clockP = malloc(sizeof(ClockP_Struct));
+    ClockP_Handle handle  = NULL;
+
+    if (clockP != NULL)
+    {
+        handle = ClockP_construct(clockP, clockFxn, timeout, params);
+        ((ClockPLinux_Obj *)clockP)->isDynamic = true;
+    }
+
+    return (handle);
+}
+
+/*
+ *  ======== ClockP_delete ========
+ */
+void ClockP_delete(ClockP_Handle handle)
+{
+    ClockPLinux_Obj *obj = (ClockPLinux_Obj *)handle;
+
+    if ((obj != NULL) && obj->isDynamic)
+    {
+        ClockP_stop(handle);
+        free(obj);
+    }
+}
+
+/*
+ *  ======== ClockP_getCpuFreq ========
+ */
+void ClockP_getCpuFreq(ClockP_FreqHz *freq)
+{
+    freq->lo = (uint32_t)ClockPLinux_CPU_FREQ;
+    freq->hi = 0;
+}
+
+/*
+ *  ======== ClockP_getSystemTickPeriod ========
+ */
+uint32_t ClockP_getSystemTickPeriod(void)
+{
+    return (ClockP_TICK_PERIOD);
+}
+
+/*
+ *  ======== ClockP_getSystemTicks ========
+ */
+uint32_t ClockP_getSystemTicks(void)
+{
+    return ((uint32_t)DPLLinux_now());
+}
+
+/*
+ *  ======== ClockP_getSystemTicks64 ========
+ */
+uint64_t ClockP_getSystemTicks64(void)
+{
+    return (DPLLinux_now());
+}
+
+/*
+ *  ======== ClockP_getTicksUntilInterrupt ========
+ */
+uint32_t ClockP_getTicksUntilInterrupt(void)
+{
+    uint64_t next;
+    uint64_t now;
+
+    DPLLinux_enter();
+    next = ClockPLinux_nextExpiry();
+    now  = DPLLinux_now();
+    DPLLinux_leave();
+
+    if (next <= now)
+    {
+        return (0);
+    }
+    if ((next - now) > UINT32_MAX)
+    {
+        return (UINT32_MAX);
+    }
+
+    return ((uint32_t)(next - now));
+}
+
+/*
+ *  ======== ClockP_getTimeout ========
+ */
+uint32_t ClockP_getTimeout(ClockP_Handle handle)
+{
+    ClockPLinux_Obj *obj = (ClockPLinux_Obj *)handle;
+    uint32_t timeout;
+    uint64_t now;
+
+    DPLLinux_enter();
+    if (obj->active)
+    {
+        now     = DPLLinux_now();
+        timeout = (obj->expiry > now) ? (uint32_t)(obj->expiry - now) : 0;
+    }
+    else
+    {
+        timeout = obj->timeout;
+    }
+    DPLLinux_leave();
+
+    return (timeout);
+}
+
+/*
+ *  ======== ClockP_isActive ========
+ */
+bool ClockP_isActive(ClockP_Handle handle)
+{
+    return (((ClockPLinux_Obj *)handle)->active);
+}
+
+/*
+ *  ======== ClockP_Params_init ========
+ */
+void ClockP_Params_init(ClockP_Params *params)
+{
+    params->arg       = (uintptr_t)0;
+    params->startFlag = false;
+    params->period    = 0;
+}
+
+/*
+ *  ======== ClockP_setFunc ========
+ */
+void ClockP_setFunc(ClockP_Handle handle, ClockP_Fxn clockFxn, uintptr_t arg)
+{
+    ClockPLinux_Obj *obj = (ClockPLinux_Obj *)handle;
+
+    DPLLinux_enter();
+    obj->fxn = clockFxn;
+    obj->arg = arg;
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== ClockP_setTimeout ========
+ */
+void ClockP_setTimeout(ClockP_Handle handle, uint32_t timeout)
+{
+    ((ClockPLinux_Obj *)handle)->timeout = timeout;
+}
+
+/*
+ *  ======== ClockP_setPeriod ========
+ */
+void ClockP_setPeriod(ClockP_Handle handle, uint32_t period)
+{
+    ((ClockPLinux_Obj *)handle)->period = period;
+}
+
+/*
+ *  ======== ClockP_start ========
+ */
+void ClockP_start(ClockP_Handle handle)
+{
+    ClockPLinux_Obj *obj = (ClockPLinux_Obj *)handle;
+
+    DPLLinux_enter();
+
+    /* Restart the clock if it is already running */
+    clockRemove(obj);
+
+    obj->expiry = DPLLinux_now() + obj->timeout;
+    obj->active = true;
+    obj->next   = activeList;
+    activeList  = obj;
+
+    /* Waiters may now have an earlier time to advance to */
+    DPLLinux_signal();
+
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== ClockP_stop ========
+ */
+void ClockP_stop(ClockP_Handle handle)
+{
+    DPLLinux_enter();
+    clockRemove((ClockPLinux_Obj *)handle);
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== ClockP_usleep ========
+ */
+void ClockP_usleep(uint32_t usec)
+{
+    uint64_t deadline;
+
+    DPLLinux_enter();
+    deadline = DPLLinux_now() + (usec / ClockP_TICK_PERIOD);
+    while (DPLLinux_wait(deadline)) {}
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== ClockP_sleep ========
+ */
+void ClockP_sleep(uint32_t sec)
+{
+    uint64_t deadline;
+
+    DPLLinux_enter();
+    deadline = DPLLinux_now() + ((uint64_t)sec * 1000000U / ClockP_TICK_PERIOD);
+    while (DPLLinux_wait(deadline)) {}
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== ClockPLinux_nextExpiry ========
+ */
+uint64_t ClockPLinux_nextExpiry(void)
+{
+    ClockPLinux_Obj *obj;
+    uint64_t next = DPLLinux_WAIT_FOREVER;
+
+    for (obj = activeList; obj != NULL; obj = obj->next)
+    {
+        if (obj->expiry < next)
+        {
+            next = obj->expiry;
+        }
+    }
+
+    return (next);
+}
+
+/*
+ *  ======== ClockPLinux_expire ========
+ */
+void ClockPLinux_expire(uint64_t now)
+{
+    ClockPLinux_Obj *obj;
+    bool found = true;
+
+    /* A clock function may start or stop clocks, rescan after each one */
+    while (found)
+    {
+        found = false;
+        for (obj = activeList; obj != NULL; obj = obj->next)
+        {
+            if (obj->expiry <= now)
+            {
+                found = true;
+                break;
+            }
+        }
+
+        if (found)
+        {
+            if (obj->period != 0)
+            {
+                obj->expiry += obj->period;
+            }
+            else
+            {
+                clockRemove(obj);
+            }
+
+            DPLLinux_isrEnter();
+            obj->fxn(obj->arg);
+            DPLLinux_isrExit();
+        }
+    }
+}
+
+/*
+ *  ======== clockRemove ========
+ */
+static void clockRemove(ClockPLinux_Obj *obj)
+{
+    ClockPLinux_Obj **link;
+
+    for (link = &activeList; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == obj)
+        {
+            *link = obj->next;
+            break;
+        }
+    }
+
+    obj->next   = NULL;
+    obj->active = false;
+}
@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== DPLLinux.c ========
+ *
+ *  Lock, virtual time and blocking shared by the Linux DPL modules.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "DPLLinux.h"
+
+/* A thread blocked in DPLLinux_wait() */
+typedef struct DPLLinux_Waiter
+{
+    struct DPLLinux_Waiter *next;
+    uint64_t deadline;
+    bool isTask;
+    /* Counted in numBlockedTasks, cleared when the waiter is signaled */
+    bool blocked;
+} DPLLinux_Waiter;
+
+static pthread_mutex_t lock;
+static pthread_once_t lockOnce = PTHREAD_ONCE_INIT;
+static pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+
+static uint64_t ticks;
+static DPLLinux_Waiter *waiters;
+static uint32_t numTasks;
+static uint32_t numBlockedTasks;
+static bool started;
+
+static __thread void *currentTask;
+static __thread uint32_t isrDepth;
+
+static void advanceTo(uint64_t target);
+static void waitRemove(DPLLinux_Waiter *self);
+static void waitCancel(void *arg);
+
+/*
+ *  ======== lockInit ========
+ */
+static void lockInit(void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+/*
+ *  ======== DPLLinux_enter ========
+ */
+void DPLLinux_enter(void)
+{
+    pthread_once(&lockOnce, lockInit);
+    pthread_mutex_lock(&lock);
+}
+
+/*
+ *  ======== DPLLinux_leave ========
+ */
+void DPLLinux_leave(void)
+{
+    pthread_mutex_unlock(&lock);
+}
+
+/*
+ *  ======== DPLLinux_now ========
+ */
+uint64_t DPLLinux_now(void)
+{
+    uint64_t now;
+
+    DPLLinux_enter();
+    now = ticks;
+    DPLLinux_leave();
+
+    return (now);
+}
+
+/*
+ *  ======== DPLLinux_deadline ========
+ */
+uint64_t DPLLinux_deadline(uint32_t timeout)
+{
+    if (timeout == (uint32_t)~0)
+    {
+        return (DPLLinux_WAIT_FOREVER);
+    }
+
+    return (DPLLinux_now() + timeout);
+}
+
+/*
+ *  ======== DPLLinux_signal ========
+ */
+void DPLLinux_signal(void)
+{
+    DPLLinux_Waiter *waiter;
+
+    /*
+     *  Signaled tasks are runnable until they block again, so that time is
+     *  not advanced while they are still to re-check their condition.
+     */
+    for (waiter = waiters; waiter != NULL; waiter = waiter->next)
+    {
+        if (waiter->blocked)
+        {
+            waiter->blocked = false;
+            if (waiter->isTask)
+            {
+                numBlockedTasks--;
+            }
+        }
+    }
+
+    pthread_cond_broadcast(&cond);
+}
+
+/*
+ *  ======== DPLLinux_wait ========
+ */
+bool DPLLinux_wait(uint64_t deadline)
+{
+    DPLLinux_Waiter self;
+    DPLLinux_Waiter *waiter;
+    uint64_t next;
+
+    if (ticks >= deadline)
+    {
+        return (false);
+    }
+
+    self.deadline = deadline;
+    self.isTask   = (currentTask != NULL);
+    self.blocked  = true;
+    self.next     = waiters;
+    waiters       = &self;
+
+    if (self.isTask)
+    {
+        numBlockedTasks++;
+        TaskPLinux_setBlocked(currentTask, true);
+    }
+
+    /*
+     *  Before the scheduler is started, main() may still be creating tasks:
+     *  only a thread without tasks to wait for may move time on its own.
+     */
+    if ((numBlockedTasks == numTasks) && (started || (numTasks == 0)))
+    {
+        /* Nothing can run before the next timeout: move time to it */
+        next = ClockPLinux_nextExpiry();
+        for (waiter = waiters; waiter != NULL; waiter = waiter->next)
+        {
+            if (waiter->deadline < next)
+            {
+                next = waiter->deadline;
+            }
+        }
+
+        if (next != DPLLinux_WAIT_FOREVER)
+        {
+            advanceTo(next);
+        }
+    }
+
+    /* Waiting is a cancellation point for TaskP_delete() */
+    pthread_cleanup_push(waitCancel, &self);
+    while (self.blocked)
+    {
+        pthread_cond_wait(&cond, &lock);
+    }
+    pthread_cleanup_pop(0);
+
+    waitRemove(&self);
+
+    return (true);
+}
+
+/*
+ *  ======== waitRemove ========
+ */
+static void waitRemove(DPLLinux_Waiter *self)
+{
+    DPLLinux_Waiter **link;
+
+    for (link = &waiters; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == self)
+        {
+            *link = self->next;
+            break;
+        }
+    }
+
+    if (self->blocked && self->isTask)
+    {
+        numBlockedTasks--;
+    }
+
+    if (self->isTask)
+    {
+        TaskPLinux_setBlocked(currentTask, false);
+    }
+}
+
+/*
+ *  ======== waitCancel ========
+ *  The waiting task was deleted, pthread_cond_wait() returned with the lock.
+ */
+static void waitCancel(void *arg)
+{
+    waitRemove((DPLLinux_Waiter *)arg);
+    pthread_mutex_unlock(&lock);
+}
+
+/*
+ *  ======== advanceTo ========
+ *  Run the clocks expiring up to 'target', then move time to it.
+ */
+static void advanceTo(uint64_t target)
+{
+    uint64_t next;
+
+    while ((next = ClockPLinux_nextExpiry()) <= target)
+    {
+        if (next > ticks)
+        {
+            ticks = next;
+        }
+        ClockPLinux_expire(ticks);
+    }
+
+    if (target > ticks)
+    {
+        ticks = target;
+    }
+
+    DPLLinux_signal();
+}
+
+/*
+ *  ======== DPLLinux_advance ========
+ */
+void DPLLinux_advance(uint64_t count)
+{
+    DPLLinux_enter();
+    advanceTo(ticks + count);
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== DPLLinux_start ========
+ */
+void DPLLinux_start(void)
+{
+    DPLLinux_enter();
+    started = true;
+    /* Tasks already blocked re-check whether time can advance */
+    DPLLinux_signal();
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== DPLLinux_getNumTasks ========
+ */
+uint32_t DPLLinux_getNumTasks(void)
+{
+    uint32_t count;
+
+    DPLLinux_enter();
+    count = numTasks;
+    DPLLinux_leave();
+
+    return (count);
+}
+
+/*
+ *  ======== DPLLinux_taskAdd ========
+ */
+void DPLLinux_taskAdd(void)
+{
+    DPLLinux_enter();
+    numTasks++;
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== DPLLinux_taskRemove ========
+ */
+void DPLLinux_taskRemove(void)
+{
+    DPLLinux_enter();
+    numTasks--;
+    /* The remaining tasks may all be blocked now */
+    DPLLinux_signal();
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== DPLLinux_setCurrentTask ========
+ */
+void DPLLinux_setCurrentTask(void *task)
+{
+    currentTask = task;
+}
+
+/*
+ *  ======== DPLLinux_getCurrentTask ========
+ */
+void *DPLLinux_getCurrentTask(void)
+{
+    return (currentTask);
+}
+
+/*
+ *  ======== DPLLinux_isrEnter ========
+ */
+void DPLLinux_isrEnter(void)
+{
+    isrDepth++;
+}
+
+/*
+ *  ======== DPLLinux_isrExit ========
+ */
+void DPLLinux_isrExit(void)
+{
+    isrDepth--;
+}
+
+/*
+ *  ======== DPLLinux_inISR ========
+ */
+bool DPLLinux_inISR(void)
+{
+    return (isrDepth != 0);
+}
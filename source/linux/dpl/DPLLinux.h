@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== DPLLinux.h ========
+ *
+ *  Internal interface shared by the Linux (pthread) DPL modules, and the
+ *  simulation controls available to host programs.
+ *
+ *  All DPL objects are protected by a single recursive lock, which is also
+ *  what HwiP_disable() and TaskP_disableScheduler() take. Threads block on a
+ *  single condition variable and re-check their own condition when woken.
+ *
+ *  Time is virtual: the ClockP tick counter only moves when every thread
+ *  created with TaskP is blocked in a DPL call, once SystemP_startScheduler()
+ *  was called or while there is no task, or when DPLLinux_advance() is
+ *  called. It then jumps to the earliest ClockP expiry or pend timeout, runs
+ *  the expired ClockP functions in interrupt context and wakes the waiters.
+ *  Threads not created with TaskP, such as the program's main thread, do not
+ *  hold time back. Runs are therefore independent of the host load and a
+ *  timeout of several seconds costs no wall-clock time.
+ */
+
+#ifndef ti_dpl_DPLLinux__include
+#define ti_dpl_DPLLinux__include
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Deadline of a wait without timeout */
+#define DPLLinux_WAIT_FOREVER UINT64_MAX
+
+/*! ClockP tick period in microseconds, same as ClockPLPF3 */
+#define ClockP_TICK_PERIOD 1U
+
+/*!
+ *  @brief  Advance virtual time
+ *
+ *  Runs every ClockP function that expires within the next @a ticks ticks,
+ *  in expiry order, and wakes the threads whose timeout elapsed.
+ *
+ *  @param  ticks  Number of ClockP ticks to advance
+ */
+extern void DPLLinux_advance(uint64_t ticks);
+
+/*!
+ *  @brief  Number of threads created with TaskP that have not returned
+ */
+extern uint32_t DPLLinux_getNumTasks(void);
+
+/* The functions below are used by the DPL modules only */
+
+/* Take and release the DPL lock, recursive */
+extern void DPLLinux_enter(void);
+extern void DPLLinux_leave(void);
+
+/* Current virtual time, in ClockP ticks */
+extern uint64_t DPLLinux_now(void);
+
+/* Absolute deadline of a DPL timeout (~0 waits forever) */
+extern uint64_t DPLLinux_deadline(uint32_t timeout);
+
+/*
+ *  Block until another DPL call signals a change or the deadline is reached.
+ *  Must be called with the lock taken exactly once. Returns false once the
+ *  deadline has passed, true otherwise; the caller re-checks its condition.
+ */
+extern bool DPLLinux_wait(uint64_t deadline);
+
+/* Let time advance when every task is blocked, from SystemP_startScheduler() */
+extern void DPLLinux_start(void);
+
+/* Wake all waiters so they re-check their condition, lock taken */
+extern void DPLLinux_signal(void);
+
+/* Interrupt context, entered around HwiP, SwiP and ClockP functions */
+extern void DPLLinux_isrEnter(void);
+extern void DPLLinux_isrExit(void);
+extern bool DPLLinux_inISR(void);
+
+/* Task accounting, used by TaskP */
+extern void DPLLinux_taskAdd(void);
+extern void DPLLinux_taskRemove(void);
+extern void DPLLinux_setCurrentTask(void *task);
+extern void *DPLLinux_getCurrentTask(void);
+
+/* Implemented by TaskP: mark a task blocked in a DPL call or runnable */
+extern void TaskPLinux_setBlocked(void *task, bool blocked);
+
+/* Implemented by ClockP: earliest expiry of a running clock, and run the
+ * functions of the clocks expired at 'now' */
+extern uint64_t ClockPLinux_nextExpiry(void);
+extern void ClockPLinux_expire(uint64_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_dpl_DPLLinux__include */
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== EventP_linux.c ========
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <ti/drivers/dpl/EventP.h>
+
+#include "DPLLinux.h"
+
+typedef struct
+{
+    uint32_t events;
+    bool isDynamic;
+} EventPLinux_Obj;
+
+static_assert(sizeof(EventPLinux_Obj) <= sizeof(EventP_Struct), "EventP object too small");
+
+/*
+ *  ======== EventP_create ========
+ */
+EventP_Handle EventP_create(void)
+{
+    EventP_Struct *obj = malloc(sizeof(EventP_Struct));
+    EventP_Handle event = NULL;
+
+    if (obj != NULL)
+    {
+        event = EventP_construct(obj);
+        ((EventPLinux_Obj *)obj)->isDynamic = true;
+    }
+
+    return (event);
+}
+
+/*
+ *  ======== EventP_delete ========
+ */
+void EventP_delete(EventP_Handle handle)
+{
+    EventPLinux_Obj *obj = (EventPLinux_Obj *)handle;
+
+    if ((obj != NULL) && obj->isDynamic)
+    {
+        free(obj);
+    }
+}
+
+/*
+ *  ======== EventP_construct ========
+ */
+EventP_Handle EventP_construct(EventP_Struct *obj)
+{
+    EventPLinux_Obj *event = (EventPLinux_Obj *)obj;
+
+    event->events    = 0;
+    event->isDynamic = false;
+
+    return ((EventP_Handle)obj);
+}
+
+/*
+ *  ======== EventP_destruct ========
+ */
+void EventP_destruct(EventP_Struct *obj)
+{}
+
+/*
+ *  ======== EventP_pend ========
+ */
+uint32_t EventP_pend(EventP_Handle event, uint32_t eventMask, bool waitForAll, uint32_t timeout)
+{
+    EventPLinux_Obj *obj       = (EventPLinux_Obj *)event;
+    uint32_t consumedEventBits = 0;
+    uint32_t eventBits;
+    uint64_t deadline;
+
+    DPLLinux_enter();
+    deadline = DPLLinux_deadline(timeout);
+
+    while (true)
+    {
+        eventBits = obj->events & eventMask;
+        if ((eventBits == eventMask) || ((eventBits != 0) && (waitForAll == false)))
+        {
+            /* Consume the matching events */
+            obj->events &= ~eventBits;
+            consumedEventBits = eventBits;
+            break;
+        }
+
+        if (DPLLinux_inISR() || !DPLLinux_wait(deadline))
+        {
+            break;
+        }
+    }
+
+    DPLLinux_leave();
+
+    return (consumedEventBits);
+}
+
+/*
+ *  ======== EventP_post ========
+ */
+void EventP_post(EventP_Handle event, uint32_t eventMask)
+{
+    EventPLinux_Obj *obj = (EventPLinux_Obj *)event;
+
+    DPLLinux_enter();
+    obj->events |= eventMask;
+    DPLLinux_signal();
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== EventP_clear ========
+ */
+void EventP_clear(EventP_Handle event, uint32_t eventMask)
+{
+    EventPLinux_Obj *obj = (EventPLinux_Obj *)event;
+
+    DPLLinux_enter();
+    obj->events &= ~eventMask;
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== EventP_get ========
+ */
+uint32_t EventP_get(EventP_Handle event)
+{
+    return (((EventPLinux_Obj *)event)->events);
+}
@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== HwiP_linux.c ========
+ *
+ *  There is no interrupt controller on Linux: an interrupt is raised by
+ *  calling HwiP_post() from a test or a simulated peripheral, which runs the
+ *  function of the enabled HwiP on the calling thread, in interrupt context
+ *  and with the DPL lock taken.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <ti/drivers/dpl/HwiP.h>
+
+#include "DPLLinux.h"
+
+/* Number of interrupt lines that can be simulated */
+#ifndef HwiPLinux_NUM_INTERRUPTS
+    #define HwiPLinux_NUM_INTERRUPTS 64
+#endif
+
+typedef struct
+{
+    HwiP_Fxn fxn;
+    uintptr_t arg;
+    int intNum;
+    bool isDynamic;
+} HwiPLinux_Obj;
+
+static_assert(sizeof(HwiPLinux_Obj) <= sizeof(HwiP_Struct), "HwiP object too small");
+
+/* Not used by SwiP on Linux, kept for API compatibility */
+int HwiP_swiPIntNum = HwiPLinux_NUM_INTERRUPTS - 1;
+
+static HwiPLinux_Obj *hwiTable[HwiPLinux_NUM_INTERRUPTS];
+static bool hwiEnabled[HwiPLinux_NUM_INTERRUPTS];
+static bool hwiPending[HwiPLinux_NUM_INTERRUPTS];
+
+/*
+ *  ======== validIntNum ========
+ */
+static bool validIntNum(int interruptNum)
+{
+    return ((interruptNum >= 0) && (interruptNum < HwiPLinux_NUM_INTERRUPTS));
+}
+
+/*
+ *  ======== HwiP_construct ========
+ */
+HwiP_Handle HwiP_construct(HwiP_Struct *handle, int interruptNum, HwiP_Fxn hwiFxn, HwiP_Params *params)
+{
+    HwiPLinux_Obj *obj = (HwiPLinux_Obj *)handle;
+    HwiP_Params defaultParams;
+
+    if (!validIntNum(interruptNum))
+    {
+        return (NULL);
+    }
+
+    if (params == NULL)
+    {
+        HwiP_Params_init(&defaultParams);
+        params = &defaultParams;
+    }
+
+    obj->fxn       = hwiFxn;
+    obj->arg       = params->arg;
+    obj->intNum    = interruptNum;
+    obj->isDynamic = false;
+
+    DPLLinux_enter();
+    hwiTable[interruptNum]   = obj;
+    hwiEnabled[interruptNum] = params->enableInt;
+    DPLLinux_leave();
+
+    return ((HwiP_Handle)obj);
+}
+
+/*
+ *  ======== HwiP_destruct ========
+ */
+void HwiP_destruct(HwiP_Struct *hwiP)
+{
+    HwiPLinux_Obj *obj = (HwiPLinux_Obj *)hwiP;
+
+    DPLLinux_enter();
+    if (hwiTable[obj->intNum] == obj)
+    {
+        hwiTable[obj->intNum]   = NULL;
+        hwiEnabled[obj->intNum] = false;
+    }
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== HwiP_create ========
+ */
+HwiP_Handle HwiP_create(int interruptNum, HwiP_Fxn hwiFxn, HwiP_Params *params)
+{
+    HwiP_Struct *hwiP  = malloc(sizeof(HwiP_Struct));
+    HwiP_Handle handle = NULL;
+
+    if (hwiP != NULL)
+    {
+        handle = HwiP_construct(hwiP, interruptNum, hwiFxn, params);
+        if (handle == NULL)
+        {
+            free(hwiP);
+        }
+        else
+        {
+            ((HwiPLinux_Obj *)hwiP)->isDynamic = true;
+        }
+    }
+
+    return (handle);
+}
+
+/*
+ *  ======== HwiP_delete ========
+ */
+void HwiP_delete(HwiP_Handle handle)
+{
+    HwiPLinux_Obj *obj = (HwiPLinux_Obj *)handle;
+
+    if (obj != NULL)
+    {
+        HwiP_destruct((HwiP_Struct *)obj);
+        if (obj->isDynamic)
+        {
+            free(obj);
+        }
+    }
+}
+
+/*
+ *  ======== HwiP_Params_init ========
+ */
+void HwiP_Params_init(HwiP_Params *params)
+{
+    if (params != NULL)
+    {
+        params->arg       = 0;
+        params->priority  = (~0);
+        params->enableInt = true;
+    }
+}
+
+/*
+ *  ======== HwiP_disable ========
+ *  Interrupts are masked by holding the DPL lock, nesting is allowed.
+ */
+uintptr_t HwiP_disable(void)
+{
+    DPLLinux_enter();
+
+    return (0);
+}
+
+/*
+ *  ======== HwiP_restore ========
+ */
+void HwiP_restore(uintptr_t key)
+{
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== HwiP_enable ========
+ *  Every HwiP_disable() is paired with HwiP_restore(), nothing to do.
+ */
+void HwiP_enable(void)
+{}
+
+/*
+ *  ======== HwiP_interruptsEnabled ========
+ */
+bool HwiP_interruptsEnabled(void)
+{
+    return (true);
+}
+
+/*
+ *  ======== HwiP_inISR ========
+ */
+bool HwiP_inISR(void)
+{
+    return (DPLLinux_inISR());
+}
+
+/*
+ *  ======== HwiP_dispatchInterrupt ========
+ */
+void HwiP_dispatchInterrupt(int interruptNum)
+{
+    HwiPLinux_Obj *obj;
+
+    if (!validIntNum(interruptNum))
+    {
+        return;
+    }
+
+    DPLLinux_enter();
+
+    obj = hwiTable[interruptNum];
+    if ((obj != NULL) && (obj->fxn != NULL))
+    {
+        hwiPending[interruptNum] = false;
+        DPLLinux_isrEnter();
+        obj->fxn(obj->arg);
+        DPLLinux_isrExit();
+    }
+
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== HwiP_post ========
+ *  A disabled interrupt stays pending until it is enabled.
+ */
+void HwiP_post(int interruptNum)
+{
+    if (!validIntNum(interruptNum))
+    {
+        return;
+    }
+
+    DPLLinux_enter();
+
+    if (hwiEnabled[interruptNum])
+    {
+        HwiP_dispatchInterrupt(interruptNum);
+    }
+    else
+    {
+        hwiPending[interruptNum] = true;
+    }
+
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== HwiP_clearInterrupt ========
+ */
+void HwiP_clearInterrupt(int interruptNum)
+{
+    if (validIntNum(interruptNum))
+    {
+        DPLLinux_enter();
+        hwiPending[interruptNum] = false;
+        DPLLinux_leave();
+    }
+}
+
+/*
+ *  ======== HwiP_disableInterrupt ========
+ */
+void HwiP_disableInterrupt(int interruptNum)
+{
+    if (validIntNum(interruptNum))
+    {
+        DPLLinux_enter();
+        hwiEnabled[interruptNum] = false;
+        DPLLinux_leave();
+    }
+}
+
+/*
+ *  ======== HwiP_enableInterrupt ========
+ */
+void HwiP_enableInterrupt(int interruptNum)
+{
+    if (validIntNum(interruptNum))
+    {
+        DPLLinux_enter();
+        hwiEnabled[interruptNum] = true;
+        if (hwiPending[interruptNum])
+        {
+            HwiP_dispatchInterrupt(interruptNum);
+        }
+        DPLLinux_leave();
+    }
+}
+
+/*
+ *  ======== HwiP_plug ========
+ *  There is no vector table, HwiP_construct() installs the function.
+ */
+void HwiP_plug(int interruptNum, void *fxn)
+{}
+
+/*
+ *  ======== HwiP_setFunc ========
+ */
+void HwiP_setFunc(HwiP_Handle hwiP, HwiP_Fxn fxn, uintptr_t arg)
+{
+    HwiPLinux_Obj *obj = (HwiPLinux_Obj *)hwiP;
+
+    DPLLinux_enter();
+    obj->fxn = fxn;
+    obj->arg = arg;
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== HwiP_setPriority ========
+ *  Interrupts do not preempt each other on Linux.
+ */
+void HwiP_setPriority(int interruptNum, uint32_t priority)
+{}
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== MessageQueueP_linux.c ========
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ti/drivers/dpl/MessageQueueP.h>
+
+#include "DPLLinux.h"
+
+/* Ring buffer of msgCount messages of msgSize bytes */
+typedef struct
+{
+    uint8_t *buf;
+    size_t msgSize;
+    size_t msgCount;
+    size_t head;  /* index of the oldest message */
+    size_t count; /* number of queued messages */
+    bool isDynamic;
+} MessageQueuePLinux_Obj;
+
+static_assert(sizeof(MessageQueuePLinux_Obj) <= sizeof(MessageQueueP_Struct), "MessageQueueP object too small");
+
+/*
+ *  ======== MessageQueueP_create ========
+ */
+MessageQueueP_Handle MessageQueueP_create(size_t msgSize, size_t msgCount)
+{
+    MessageQueueP_Struct *queueStruct = malloc(sizeof(MessageQueueP_Struct));
+    void *msgBuf                      = malloc(msgSize * msgCount);
+    MessageQueueP_Handle handle;
+
+    if ((queueStruct == NULL) || (msgBuf == NULL))
+    {
+        free(queueStruct);
+        free(msgBuf);
+        return (NULL);
+    }
+
+    handle = MessageQueueP_construct(queueStruct, msgSize, msgCount, msgBuf);
+    ((MessageQueuePLinux_Obj *)queueStruct)->isDynamic = true;
+
+    return (handle);
+}
+
+/*
+ *  ======== MessageQueueP_construct ========
+ */
+MessageQueueP_Handle MessageQueueP_construct(MessageQueueP_Struct *queueStruct,
+                                             size_t msgSize,
+                                             size_t msgCount,
+                                             void *msgBuf)
+{
+    MessageQueuePLinux_Obj *obj = (MessageQueuePLinux_Obj *)queueStruct;
+
+    if ((msgBuf == NULL) || (msgSize == 0) || (msgCount == 0))
+    {
+        return (NULL);
+    }
+
+    obj->buf       = msgBuf;
+    obj->msgSize   = msgSize;
+    obj->msgCount  = msgCount;
+    obj->head      = 0;
+    obj->count     = 0;
+    obj->isDynamic = false;
+
+    return ((MessageQueueP_Handle)obj);
+}
+
+/*
+ *  ======== MessageQueueP_delete ========
+ */
+void MessageQueueP_delete(MessageQueueP_Handle handle)
+{
+    MessageQueuePLinux_Obj *obj = (MessageQueuePLinux_Obj *)handle;
+
+    if ((obj != NULL) && obj->isDynamic)
+    {
+        free(obj->buf);
+        free(obj);
+    }
+}
+
+/*
+ *  ======== MessageQueueP_destruct ========
+ */
+void MessageQueueP_destruct(MessageQueueP_Handle handle)
+{}
+
+/*
+ *  ======== receive ========
+ *  Copy out the oldest message, removing it from the queue unless peeking.
+ */
+static MessageQueueP_Status receive(MessageQueuePLinux_Obj *obj, void *message, uint32_t timeout, bool remove)
+{
+    MessageQueueP_Status status = MessageQueueP_TIMEOUT;
+    uint64_t deadline;
+
+    DPLLinux_enter();
+    deadline = DPLLinux_deadline(timeout);
+
+    while (true)
+    {
+        if (obj->count != 0)
+        {
+            memcpy(message, obj->buf + (obj->head * obj->msgSize), obj->msgSize);
+            if (remove)
+            {
+                obj->head = (obj->head + 1) % obj->msgCount;
+                obj->count--;
+                /* Wake senders waiting for room */
+                DPLLinux_signal();
+            }
+            status = MessageQueueP_OK;
+            break;
+        }
+
+        if (DPLLinux_inISR() || !DPLLinux_wait(deadline))
+        {
+            break;
+        }
+    }
+
+    DPLLinux_leave();
+
+    return (status);
+}
+
+/*
+ *  ======== send ========
+ *  Copy in a message at the back of the queue, or at the front.
+ */
+static MessageQueueP_Status send(MessageQueuePLinux_Obj *obj, const void *message, uint32_t timeout, bool front)
+{
+    MessageQueueP_Status status = MessageQueueP_TIMEOUT;
+    uint64_t deadline;
+    size_t index;
+
+    DPLLinux_enter();
+    deadline = DPLLinux_deadline(timeout);
+
+    while (true)
+    {
+        if (obj->count < obj->msgCount)
+        {
+            if (front)
+            {
+                obj->head = (obj->head + obj->msgCount - 1) % obj->msgCount;
+                index     = obj->head;
+            }
+            else
+            {
+                index = (obj->head + obj->count) % obj->msgCount;
+            }
+
+            memcpy(obj->buf + (index * obj->msgSize), message, obj->msgSize);
+            obj->count++;
+            DPLLinux_signal();
+            status = MessageQueueP_OK;
+            break;
+        }
+
+        if (DPLLinux_inISR() || !DPLLinux_wait(deadline))
+        {
+            break;
+        }
+    }
+
+    DPLLinux_leave();
+
+    return (status);
+}
+
+/*
+ *  ======== MessageQueueP_pend ========
+ */
+MessageQueueP_Status MessageQueueP_pend(MessageQueueP_Handle handle, void *message, uint32_t timeout)
+{
+    return (receive((MessageQueuePLinux_Obj *)handle, message, timeout, true));
+}
+
+/*
+ *  ======== MessageQueueP_peek ========
+ */
+MessageQueueP_Status MessageQueueP_peek(MessageQueueP_Handle handle, void *message, uint32_t timeout)
+{
+    return (receive((MessageQueuePLinux_Obj *)handle, message, timeout, false));
+}
+
+/*
+ *  ======== MessageQueueP_post ========
+ */
+MessageQueueP_Status MessageQueueP_post(MessageQueueP_Handle handle, const void *message, uint32_t timeout)
+{
+    return (send((MessageQueuePLinux_Obj *)handle, message, timeout, false));
+}
+
+/*
+ *  ======== MessageQueueP_postFront ========
+ */
+MessageQueueP_Status MessageQueueP_postFront(MessageQueueP_Handle handle, const void *message, uint32_t timeout)
+{
+    return (send((MessageQueuePLinux_Obj *)handle, message, timeout, true));
+}
+
+/*
+ *  ======== MessageQueueP_getPendingCount ========
+ */
+size_t MessageQueueP_getPendingCount(MessageQueueP_Handle handle)
+{
+    MessageQueuePLinux_Obj *obj = (MessageQueuePLinux_Obj *)handle;
+    size_t count;
+
+    DPLLinux_enter();
+    count = obj->count;
+    DPLLinux_leave();
+
+    return (count);
+}
+
+/*
+ *  ======== MessageQueueP_getFreeCount ========
+ */
+size_t MessageQueueP_getFreeCount(MessageQueueP_Handle handle)
+{
+    MessageQueuePLinux_Obj *obj = (MessageQueuePLinux_Obj *)handle;
+    size_t count;
+
+    DPLLinux_enter();
+    count = obj->msgCount - obj->count;
+    DPLLinux_leave();
+
+    return (count);
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== MutexP_linux.c ========
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include <ti/drivers/dpl/MutexP.h>
+
+#include "DPLLinux.h"
+
+typedef struct
+{
+    pthread_t owner;
+    uint32_t depth; /* recursive lock count, 0 when free */
+    bool isDynamic;
+} MutexPLinux_Obj;
+
+static_assert(sizeof(MutexPLinux_Obj) <= sizeof(MutexP_Struct), "MutexP object too small");
+
+/*
+ *  ======== MutexP_construct ========
+ */
+MutexP_Handle MutexP_construct(MutexP_Struct *handle, MutexP_Params *params)
+{
+    MutexPLinux_Obj *obj = (MutexPLinux_Obj *)handle;
+
+    obj->depth     = 0;
+    obj->isDynamic = false;
+
+    return ((MutexP_Handle)obj);
+}
+
+/*
+ *  ======== MutexP_destruct ========
+ */
+void MutexP_destruct(MutexP_Struct *mutexP)
+{}
+
+/*
+ *  ======== MutexP_create ========
+ */
+MutexP_Handle MutexP_create(MutexP_Params *params)
+{
+    MutexP_Struct *mutexP = malloc(sizeof(MutexP_Struct));
+    MutexP_Handle handle  = NULL;
+
+    if (mutexP != NULL)
+    {
+        handle = MutexP_construct(mutexP, params);
+        ((MutexPLinux_Obj *)mutexP)->isDynamic = true;
+    }
+
+    return (handle);
+}
+
+/*
+ *  ======== MutexP_delete ========
+ */
+void MutexP_delete(MutexP_Handle handle)
+{
+    MutexPLinux_Obj *obj = (MutexPLinux_Obj *)handle;
+
+    if ((obj != NULL) && obj->isDynamic)
+    {
+        free(obj);
+    }
+}
+
+/*
+ *  ======== MutexP_Params_init ========
+ */
+void MutexP_Params_init(MutexP_Params *params)
+{
+    params->callback = NULL;
+}
+
+/*
+ *  ======== MutexP_lock ========
+ */
+uintptr_t MutexP_lock(MutexP_Handle handle)
+{
+    MutexPLinux_Obj *obj = (MutexPLinux_Obj *)handle;
+    pthread_t self       = pthread_self();
+
+    DPLLinux_enter();
+
+    while ((obj->depth != 0) && !pthread_equal(obj->owner, self))
+    {
+        DPLLinux_wait(DPLLinux_WAIT_FOREVER);
+    }
+
+    obj->owner = self;
+    obj->depth++;
+
+    DPLLinux_leave();
+
+    return (0);
+}
+
+/*
+ *  ======== MutexP_unlock ========
+ */
+void MutexP_unlock(MutexP_Handle handle, uintptr_t key)
+{
+    MutexPLinux_Obj *obj = (MutexPLinux_Obj *)handle;
+
+    DPLLinux_enter();
+
+    if ((obj->depth != 0) && (--obj->depth == 0))
+    {
+        DPLLinux_signal();
+    }
+
+    DPLLinux_leave();
+}
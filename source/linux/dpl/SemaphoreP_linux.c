@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== SemaphoreP_linux.c ========
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+#include "DPLLinux.h"
+
+/*
+ *  Maximum count for a semaphore.
+ */
+#define MAXCOUNT 0xffff
+
+typedef struct
+{
+    unsigned int count;
+    SemaphoreP_Mode mode;
+    bool isDynamic;
+} SemaphorePLinux_Obj;
+
+static_assert(sizeof(SemaphorePLinux_Obj) <= sizeof(SemaphoreP_Struct), "SemaphoreP object too small");
+
+/* The pend callback (Power_idleFunc on the target) is not used on Linux */
+SemaphoreP_Params SemaphoreP_defaultParams = {
+    .mode     = SemaphoreP_Mode_COUNTING,
+    .callback = NULL,
+};
+
+/*
+ *  ======== SemaphoreP_construct ========
+ */
+SemaphoreP_Handle SemaphoreP_construct(SemaphoreP_Struct *handle, unsigned int count, SemaphoreP_Params *params)
+{
+    SemaphorePLinux_Obj *obj = (SemaphorePLinux_Obj *)handle;
+
+    if (params == NULL)
+    {
+        params = &SemaphoreP_defaultParams;
+    }
+
+    obj->mode      = params->mode;
+    obj->count     = ((obj->mode == SemaphoreP_Mode_BINARY) && (count != 0)) ? 1 : count;
+    obj->isDynamic = false;
+
+    return ((SemaphoreP_Handle)obj);
+}
+
+/*
+ *  ======== SemaphoreP_constructBinary ========
+ */
+SemaphoreP_Handle SemaphoreP_constructBinary(SemaphoreP_Struct *handle, unsigned int count)
+{
+    SemaphoreP_Params params;
+
+    SemaphoreP_Params_init(&params);
+    params.mode = SemaphoreP_Mode_BINARY;
+
+    return (SemaphoreP_construct(handle, count, &params));
+}
+
+/*
+ *  ======== SemaphoreP_destruct ========
+ */
+void SemaphoreP_destruct(SemaphoreP_Struct *semP)
+{}
+
+/*
+ *  ======== SemaphoreP_create ========
+ */
+SemaphoreP_Handle SemaphoreP_create(unsigned int count, SemaphoreP_Params *params)
+{
+    SemaphoreP_Struct *semP = malloc(sizeof(SemaphoreP_Struct));
+    SemaphoreP_Handle handle = NULL;
+
+    if (semP != NULL)
+    {
+        handle = SemaphoreP_construct(semP, count, params);
+        ((SemaphorePLinux_Obj *)semP)->isDynamic = true;
+    }
+
+    return (handle);
+}
+
+/*
+ *  ======== SemaphoreP_createBinary ========
+ */
+SemaphoreP_Handle SemaphoreP_createBinary(unsigned int count)
+{
+    SemaphoreP_Params params;
+
+    SemaphoreP_Params_init(&params);
+    params.mode = SemaphoreP_Mode_BINARY;
+
+    return (SemaphoreP_create(count, &params));
+}
+
+/*
+ *  ======== SemaphoreP_createBinaryCallback ========
+ */
+SemaphoreP_Handle SemaphoreP_createBinaryCallback(unsigned int count, void (*callback)(void))
+{
+    SemaphoreP_Params params;
+
+    SemaphoreP_Params_init(&params);
+    params.mode     = SemaphoreP_Mode_BINARY;
+    params.callback = callback;
+
+    return (SemaphoreP_create(count, &params));
+}
+
+/*
+ *  ======== SemaphoreP_delete ========
+ */
+void SemaphoreP_delete(SemaphoreP_Handle handle)
+{
+    SemaphorePLinux_Obj *obj = (SemaphorePLinux_Obj *)handle;
+
+    if ((obj != NULL) && obj->isDynamic)
+    {
+        free(obj);
+    }
+}
+
+/*
+ *  ======== SemaphoreP_Params_init ========
+ */
+void SemaphoreP_Params_init(SemaphoreP_Params *params)
+{
+    *params = SemaphoreP_defaultParams;
+}
+
+/*
+ *  ======== SemaphoreP_pend ========
+ */
+SemaphoreP_Status SemaphoreP_pend(SemaphoreP_Handle handle, uint32_t timeout)
+{
+    SemaphorePLinux_Obj *obj = (SemaphorePLinux_Obj *)handle;
+    SemaphoreP_Status status = SemaphoreP_TIMEOUT;
+    uint64_t deadline;
+
+    DPLLinux_enter();
+    deadline = DPLLinux_deadline(timeout);
+
+    while (true)
+    {
+        if (obj->count != 0)
+        {
+            obj->count--;
+            status = SemaphoreP_OK;
+            break;
+        }
+
+        if (DPLLinux_inISR() || !DPLLinux_wait(deadline))
+        {
+            break;
+        }
+    }
+
+    DPLLinux_leave();
+
+    return (status);
+}
+
+/*
+ *  ======== SemaphoreP_post ========
+ */
+void SemaphoreP_post(SemaphoreP_Handle handle)
+{
+    SemaphorePLinux_Obj *obj = (SemaphorePLinux_Obj *)handle;
+
+    DPLLinux_enter();
+
+    if (obj->mode == SemaphoreP_Mode_BINARY)
+    {
+        obj->count = 1;
+    }
+    else if (obj->count < MAXCOUNT)
+    {
+        obj->count++;
+    }
+
+    DPLLinux_signal();
+    DPLLinux_leave();
+}
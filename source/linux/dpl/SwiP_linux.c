@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== SwiP_linux.c ========
+ *
+ *  A posted SwiP runs on the posting thread, in interrupt context, as soon as
+ *  no other SwiP is running and SwiPs are not disabled. Otherwise it is left
+ *  pending and run in post order when the running SwiP returns or
+ *  SwiP_restore() re-enables SwiPs. Priorities are not used.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <ti/drivers/dpl/SwiP.h>
+
+#include "DPLLinux.h"
+
+typedef struct SwiPLinux_Obj
+{
+    struct SwiPLinux_Obj *next; /* next pending SwiP */
+    SwiP_Fxn fxn;
+    uintptr_t arg0;
+    uintptr_t arg1;
+    uint32_t initTrigger;
+    uint32_t trigger;
+    bool pending;
+    bool isDynamic;
+} SwiPLinux_Obj;
+
+static_assert(sizeof(SwiPLinux_Obj) <= sizeof(SwiP_Struct), "SwiP object too small");
+
+static const SwiP_Params SwiP_defaultParams = {
+    .arg0     = (uintptr_t)NULL,
+    .arg1     = (uintptr_t)NULL,
+    .priority = ~0, /* max priority */
+    .trigger  = 0,
+};
+
+static SwiPLinux_Obj *pendingHead;
+static SwiPLinux_Obj *pendingTail;
+static uint32_t disableCount;
+static SwiPLinux_Obj *runningSwi;
+static uint32_t runningTrigger;
+
+/*
+ *  ======== runPending ========
+ *  Run the pending SwiPs, with the DPL lock taken.
+ */
+static void runPending(void)
+{
+    SwiPLinux_Obj *obj;
+
+    while ((disableCount == 0) && (runningSwi == NULL) && (pendingHead != NULL))
+    {
+        obj         = pendingHead;
+        pendingHead = obj->next;
+        if (pendingHead == NULL)
+        {
+            pendingTail = NULL;
+        }
+
+        obj->pending = false;
+
+        /* The trigger is reset when the SwiP starts, SwiP_getTrigger()
+         * returns the value it had when posted */
+        runningTrigger = obj->trigger;
+        obj->trigger   = obj->initTrigger;
+        runningSwi     = obj;
+
+        DPLLinux_isrEnter();
+        obj->fxn(obj->arg0, obj->arg1);
+        DPLLinux_isrExit();
+
+        runningSwi = NULL;
+    }
+}
+
+/*
+ *  ======== SwiP_construct ========
+ */
+SwiP_Handle SwiP_construct(SwiP_Struct *handle, SwiP_Fxn swiFxn, SwiP_Params *params)
+{
+    SwiPLinux_Obj *obj = (SwiPLinux_Obj *)handle;
+
+    if (params == NULL)
+    {
+        params = (SwiP_Params *)&SwiP_defaultParams;
+    }
+
+    obj->next        = NULL;
+    obj->fxn         = swiFxn;
+    obj->arg0        = params->arg0;
+    obj->arg1        = params->arg1;
+    obj->initTrigger = params->trigger;
+    obj->trigger     = params->trigger;
+    obj->pending     = false;
+    obj->isDynamic   = false;
+
+    return ((SwiP_Handle)obj);
+}
+
+/*
+ *  ======== SwiP_destruct ========
+ */
+void SwiP_destruct(SwiP_Struct *swiP)
+{
+    SwiPLinux_Obj *obj  = (SwiPLinux_Obj *)swiP;
+    SwiPLinux_Obj *prev = NULL;
+    SwiPLinux_Obj *swi;
+
+    DPLLinux_enter();
+
+    for (swi = pendingHead; (swi != NULL) && obj->pending; prev = swi, swi = swi->next)
+    {
+        if (swi == obj)
+        {
+            if (prev == NULL)
+            {
+                pendingHead = obj->next;
+            }
+            else
+            {
+                prev->next = obj->next;
+            }
+
+            if (pendingTail == obj)
+            {
+                pendingTail = prev;
+            }
+            obj->pending = false;
+        }
+    }
+
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== SwiP_Params_init ========
+ */
+void SwiP_Params_init(SwiP_Params *params)
+{
+    /* structure copy */
+    *params = SwiP_defaultParams;
+}
+
+/*
+ *  ======== SwiP_create ========
+ */
+SwiP_Handle SwiP_create(SwiP_Fxn swiFxn, SwiP_Params *params)
+{
+    SwiP_Struct *swiP  = malloc(sizeof(SwiP_Struct));
+    SwiP_Handle handle = NULL;
+
+    if (swiP != NULL)
+    {
+        handle = SwiP_construct(swiP, swiFxn, params);
+        ((SwiPLinux_Obj *)swiP)->isDynamic = true;
+    }
+
+    return (handle);
+}
+
+/*
+ *  ======== SwiP_delete ========
+ */
+void SwiP_delete(SwiP_Handle handle)
+{
+    SwiPLinux_Obj *obj = (SwiPLinux_Obj *)handle;
+
+    if (obj != NULL)
+    {
+        SwiP_destruct((SwiP_Struct *)obj);
+        if (obj->isDynamic)
+        {
+            free(obj);
+        }
+    }
+}
+
+/*
+ *  ======== SwiP_disable ========
+ */
+uintptr_t SwiP_disable(void)
+{
+    DPLLinux_enter();
+    disableCount++;
+    DPLLinux_leave();
+
+    return (0);
+}
+
+/*
+ *  ======== SwiP_restore ========
+ */
+void SwiP_restore(uintptr_t key)
+{
+    DPLLinux_enter();
+    if (disableCount != 0)
+    {
+        disableCount--;
+    }
+    runPending();
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== SwiP_getTrigger ========
+ */
+uint32_t SwiP_getTrigger(void)
+{
+    return (runningTrigger);
+}
+
+/*
+ *  ======== SwiP_inISR ========
+ */
+bool SwiP_inISR(void)
+{
+    return (runningSwi != NULL);
+}
+
+/*
+ *  ======== SwiP_post ========
+ */
+void SwiP_post(SwiP_Handle handle)
+{
+    SwiPLinux_Obj *obj = (SwiPLinux_Obj *)handle;
+
+    DPLLinux_enter();
+
+    if (!obj->pending)
+    {
+        obj->pending = true;
+        obj->next    = NULL;
+        if (pendingTail == NULL)
+        {
+            pendingHead = obj;
+        }
+        else
+        {
+            pendingTail->next = obj;
+        }
+        pendingTail = obj;
+    }
+
+    runPending();
+
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== SwiP_andn ========
+ */
+void SwiP_andn(SwiP_Handle handle, uint32_t mask)
+{
+    SwiPLinux_Obj *obj = (SwiPLinux_Obj *)handle;
+
+    DPLLinux_enter();
+    if (obj->trigger != 0)
+    {
+        obj->trigger &= ~mask;
+        if (obj->trigger == 0)
+        {
+            SwiP_post(handle);
+        }
+    }
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== SwiP_dec ========
+ */
+void SwiP_dec(SwiP_Handle handle)
+{
+    SwiPLinux_Obj *obj = (SwiPLinux_Obj *)handle;
+
+    DPLLinux_enter();
+    if (obj->trigger != 0)
+    {
+        obj->trigger--;
+        if (obj->trigger == 0)
+        {
+            SwiP_post(handle);
+        }
+    }
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== SwiP_inc ========
+ */
+void SwiP_inc(SwiP_Handle handle)
+{
+    SwiPLinux_Obj *obj = (SwiPLinux_Obj *)handle;
+
+    DPLLinux_enter();
+    obj->trigger++;
+    SwiP_post(handle);
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== SwiP_or ========
+ */
+void SwiP_or(SwiP_Handle handle, uint32_t mask)
+{
+    SwiPLinux_Obj *obj = (SwiPLinux_Obj *)handle;
+
+    DPLLinux_enter();
+    obj->trigger |= mask;
+    SwiP_post(handle);
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== SwiP_setPriority ========
+ */
+void SwiP_setPriority(SwiP_Handle handle, uint32_t priority)
+{}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== SystemP_linux.c ========
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <ti/drivers/dpl/SystemP.h>
+
+#include "DPLLinux.h"
+
+/*
+ *  ======== SystemP_snprintf ========
+ */
+int SystemP_snprintf(char *buf, size_t n, const char *format, ...)
+{
+    va_list args;
+    int ret;
+
+    va_start(args, format);
+    ret = vsnprintf(buf, n, format, args);
+    va_end(args);
+
+    return (ret);
+}
+
+/*
+ *  ======== SystemP_vsnprintf ========
+ */
+int SystemP_vsnprintf(char *buf, size_t n, const char *format, va_list va)
+{
+    return (vsnprintf(buf, n, format, va));
+}
+
+/*
+ *  ======== SystemP_startScheduler ========
+ *  Tasks run as soon as they are created, but virtual time only advances on
+ *  its own once the scheduler is started. Block the calling thread until
+ *  every task has returned or has been deleted.
+ */
+void SystemP_startScheduler(void)
+{
+    DPLLinux_start();
+
+    DPLLinux_enter();
+
+    while (DPLLinux_getNumTasks() != 0)
+    {
+        DPLLinux_wait(DPLLinux_WAIT_FOREVER);
+    }
+
+    DPLLinux_leave();
+}
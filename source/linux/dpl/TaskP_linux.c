@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== TaskP_linux.c ========
+ *
+ *  Each TaskP is a pthread. The priority and stack of the task parameters
+ *  are ignored: threads run concurrently under the DPL lock and use the
+ *  default pthread stack size.
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#include <ti/drivers/dpl/TaskP.h>
+
+#include "DPLLinux.h"
+
+typedef struct
+{
+    pthread_t thread;
+    TaskP_Function fxn;
+    void *arg;
+    TaskP_State state;
+} TaskPLinux_Obj;
+
+static_assert(sizeof(TaskPLinux_Obj) <= sizeof(TaskP_Struct), "TaskP object too small");
+
+/*
+ *  ======== taskExit ========
+ *  The task function returned, or the task was deleted.
+ */
+static void taskExit(void *arg)
+{
+    TaskPLinux_Obj *obj = (TaskPLinux_Obj *)arg;
+
+    DPLLinux_enter();
+    obj->state = TaskP_State_DELETED;
+    DPLLinux_taskRemove();
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== taskMain ========
+ */
+static void *taskMain(void *arg)
+{
+    TaskPLinux_Obj *obj = (TaskPLinux_Obj *)arg;
+
+    DPLLinux_setCurrentTask(obj);
+
+    pthread_cleanup_push(taskExit, obj);
+    obj->fxn(obj->arg);
+    pthread_cleanup_pop(1);
+
+    return (NULL);
+}
+
+/*
+ *  ======== TaskP_construct ========
+ */
+TaskP_Handle TaskP_construct(TaskP_Struct *handle, TaskP_Function fxn, const TaskP_Params *params)
+{
+    TaskPLinux_Obj *obj = (TaskPLinux_Obj *)handle;
+    TaskP_Params defaultParams;
+
+    if (params == NULL)
+    {
+        TaskP_Params_init(&defaultParams);
+        params = &defaultParams;
+    }
+
+    obj->fxn   = fxn;
+    obj->arg   = params->arg;
+    obj->state = TaskP_State_READY;
+
+    /* Count the task before it runs so time cannot advance past its start */
+    DPLLinux_taskAdd();
+
+    if (pthread_create(&obj->thread, NULL, taskMain, obj) != 0)
+    {
+        DPLLinux_taskRemove();
+        return (NULL);
+    }
+
+    pthread_detach(obj->thread);
+
+    return ((TaskP_Handle)obj);
+}
+
+/*
+ *  ======== TaskP_destruct ========
+ */
+void TaskP_destruct(TaskP_Struct *obj)
+{
+    TaskP_delete((TaskP_Handle)obj);
+}
+
+/*
+ *  ======== TaskP_create ========
+ */
+TaskP_Handle TaskP_create(TaskP_Function fxn, const TaskP_Params *params)
+{
+    TaskP_Struct *obj   = malloc(sizeof(TaskP_Struct));
+    TaskP_Handle handle = NULL;
+
+    if (obj != NULL)
+    {
+        handle = TaskP_construct(obj, fxn, params);
+        if (handle == NULL)
+        {
+            free(obj);
+        }
+    }
+
+    return (handle);
+}
+
+/*
+ *  ======== TaskP_delete ========
+ *  A deleted task is cancelled at its next DPL wait. The object of a created
+ *  task is not freed, the thread may still reference it while unwinding.
+ */
+void TaskP_delete(TaskP_Handle task)
+{
+    TaskPLinux_Obj *obj = (TaskPLinux_Obj *)task;
+
+    if (obj == NULL)
+    {
+        return;
+    }
+
+    if ((TaskPLinux_Obj *)DPLLinux_getCurrentTask() == obj)
+    {
+        pthread_exit(NULL);
+    }
+
+    /* The thread is alive until its exit handler marked it deleted */
+    DPLLinux_enter();
+    if (obj->state != TaskP_State_DELETED)
+    {
+        pthread_cancel(obj->thread);
+    }
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== TaskP_getState ========
+ */
+TaskP_State TaskP_getState(TaskP_Handle task)
+{
+    TaskPLinux_Obj *obj = (TaskPLinux_Obj *)task;
+    TaskP_State state;
+
+    DPLLinux_enter();
+    state = obj->state;
+    if ((state == TaskP_State_READY) && ((TaskPLinux_Obj *)DPLLinux_getCurrentTask() == obj))
+    {
+        state = TaskP_State_RUNNING;
+    }
+    DPLLinux_leave();
+
+    return (state);
+}
+
+/*
+ *  ======== TaskP_getCurrentTask ========
+ */
+TaskP_Handle TaskP_getCurrentTask(void)
+{
+    return ((TaskP_Handle)DPLLinux_getCurrentTask());
+}
+
+/*
+ *  ======== TaskP_disableScheduler ========
+ *  Other threads are held off by the DPL lock until the scheduler is restored.
+ */
+uintptr_t TaskP_disableScheduler(void)
+{
+    DPLLinux_enter();
+
+    return (0);
+}
+
+/*
+ *  ======== TaskP_restoreScheduler ========
+ */
+void TaskP_restoreScheduler(uintptr_t key)
+{
+    DPLLinux_leave();
+}
+
+/*
+ *  ======== TaskP_yield ========
+ */
+void TaskP_yield(void)
+{
+    sched_yield();
+}
+
+/*
+ *  ======== TaskP_Params_init ========
+ */
+void TaskP_Params_init(TaskP_Params *params)
+{
+    params->name      = "NAME";
+    params->arg       = NULL;
+    params->priority  = 0;
+    params->stackSize = TaskP_DEFAULT_STACK_SIZE;
+    params->stack     = NULL;
+}
+
+/*
+ *  ======== TaskPLinux_setBlocked ========
+ */
+void TaskPLinux_setBlocked(void *task, bool blocked)
+{
+    TaskPLinux_Obj *obj = (TaskPLinux_Obj *)task;
+
+    if (obj->state != TaskP_State_DELETED)
+    {
+        obj->state = blocked ? TaskP_State_BLOCKED : TaskP_State_READY;
+    }
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== NVSRAMLinux.c ========
+ */
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ti/drivers/NVS.h>
+#include <ti/drivers/nvs/NVSRAM.h>
+
+#include "NVSRAMLinux.h"
+
+#define REGION_SIZE (NVSRAMLinux_SECTOR_SIZE * NVSRAMLinux_NUM_SECTORS)
+
+static void NVSRAMLinux_close(NVS_Handle handle);
+static void NVSRAMLinux_init(void);
+static NVS_Handle NVSRAMLinux_open(uint_least8_t index, NVS_Params *params);
+
+/* NVSRAM with the region mapped at init */
+static const NVS_FxnTable NVSRAMLinux_fxnTable = {NVSRAMLinux_close,
+                                                  NVSRAM_control,
+                                                  NVSRAM_erase,
+                                                  NVSRAM_getAttrs,
+                                                  NVSRAMLinux_init,
+                                                  NVSRAM_lock,
+                                                  NVSRAMLinux_open,
+                                                  NVSRAM_read,
+                                                  NVSRAM_unlock,
+                                                  NVSRAM_write};
+
+static NVSRAM_Object nvsRAMObjects[1];
+
+/* regionBase is set once the region is mapped */
+static NVSRAM_HWAttrs nvsRAMHWAttrs[1] = {
+    {
+        .regionBase = NULL,
+        .regionSize = REGION_SIZE,
+        .sectorSize = NVSRAMLinux_SECTOR_SIZE,
+    },
+};
+
+NVS_Config NVS_config[1] = {
+    {
+        .fxnTablePtr = &NVSRAMLinux_fxnTable,
+        .object      = &nvsRAMObjects[CONFIG_NVSINTERNAL],
+        .hwAttrs     = &nvsRAMHWAttrs[CONFIG_NVSINTERNAL],
+    },
+};
+
+const uint8_t NVS_count = 1;
+
+static const char *backingFile;
+
+/*
+ *  ======== NVSRAMLinux_setBackingFile ========
+ */
+int_fast16_t NVSRAMLinux_setBackingFile(const char *path)
+{
+    if (nvsRAMHWAttrs[CONFIG_NVSINTERNAL].regionBase != NULL)
+    {
+        return (NVS_STATUS_ERROR);
+    }
+
+    backingFile = path;
+
+    return (NVS_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== mapFile ========
+ *  Map the backing file, erasing the part of the region it does not cover.
+ */
+static void *mapFile(const char *path)
+{
+    struct stat st;
+    void *base;
+    int fd;
+
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+    {
+        return (MAP_FAILED);
+    }
+
+    if ((fstat(fd, &st) != 0) || ((st.st_size < REGION_SIZE) && (ftruncate(fd, REGION_SIZE) != 0)))
+    {
+        close(fd);
+        return (MAP_FAILED);
+    }
+
+    base = mmap(NULL, REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    /* The mapping stays valid after the descriptor is closed */
+    close(fd);
+
+    if ((base != MAP_FAILED) && (st.st_size < REGION_SIZE))
+    {
+        memset((uint8_t *)base + st.st_size, 0xFF, REGION_SIZE - st.st_size);
+    }
+
+    return (base);
+}
+
+/*
+ *  ======== NVSRAMLinux_init ========
+ */
+static void NVSRAMLinux_init(void)
+{
+    NVSRAM_HWAttrs *hwAttrs = &nvsRAMHWAttrs[CONFIG_NVSINTERNAL];
+    void *base;
+
+    if (hwAttrs->regionBase == NULL)
+    {
+        if (backingFile != NULL)
+        {
+            base = mapFile(backingFile);
+        }
+        else
+        {
+            base = mmap(NULL, REGION_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (base != MAP_FAILED)
+            {
+                memset(base, 0xFF, REGION_SIZE);
+            }
+        }
+
+        /* The region stays unmapped on error, NVSRAMLinux_open() fails */
+        if (base != MAP_FAILED)
+        {
+            hwAttrs->regionBase = base;
+        }
+    }
+
+    NVSRAM_init();
+}
+
+/*
+ *  ======== NVSRAMLinux_close ========
+ */
+static void NVSRAMLinux_close(NVS_Handle handle)
+{
+    NVSRAM_HWAttrs const *hwAttrs = handle->hwAttrs;
+
+    if (backingFile != NULL)
+    {
+        msync(hwAttrs->regionBase, hwAttrs->regionSize, MS_SYNC);
+    }
+
+    NVSRAM_close(handle);
+}
+
+/*
+ *  ======== NVSRAMLinux_open ========
+ */
+static NVS_Handle NVSRAMLinux_open(uint_least8_t index, NVS_Params *params)
+{
+    if ((index >= NVS_count) || (nvsRAMHWAttrs[index].regionBase == NULL))
+    {
+        return (NULL);
+    }
+
+    return (NVSRAM_open(index, params));
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/** ============================================================================
+ *  @file       NVSRAMLinux.h
+ *
+ *  @brief      NVS region for the Linux DPL port, backed by RAM or a file
+ *
+ *  This module provides the NVS_config[] table of a Linux host build. Its
+ *  single region (index 0, CONFIG_NVSINTERNAL) is managed by the NVSRAM
+ *  driver. By default the region lives in anonymous memory and its content
+ *  is lost when the process exits. When a backing file is set before
+ *  NVS_init(), the file is mapped instead so the content is kept across runs,
+ *  like the internal flash of the target.
+ *
+ *  The region and sector sizes match the NV area of the CC23X0 stack builds
+ *  and can be overridden with NVSRAMLinux_SECTOR_SIZE and
+ *  NVSRAMLinux_NUM_SECTORS.
+ *
+ *  @code
+ *  #include <ti/drivers/NVS.h>
+ *  #include <nvs/NVSRAMLinux.h>
+ *
+ *  NVSRAMLinux_setBackingFile("nv.bin");
+ *  NVS_init();
+ *  handle = NVS_open(CONFIG_NVSINTERNAL, NULL);
+ *  @endcode
+ *  ============================================================================
+ */
+
+#ifndef ti_linux_nvs_NVSRAMLinux__include
+#define ti_linux_nvs_NVSRAMLinux__include
+
+#include <stdint.h>
+
+#include <ti/drivers/NVS.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*! Index of the NVS region in NVS_config[] */
+#define CONFIG_NVSINTERNAL 0
+
+/*! Sector size of the region, the CC23X0 flash page size */
+#ifndef NVSRAMLinux_SECTOR_SIZE
+    #define NVSRAMLinux_SECTOR_SIZE 0x800
+#endif
+
+/*! Number of sectors in the region, NVOCMP_NVPAGES of the stack builds */
+#ifndef NVSRAMLinux_NUM_SECTORS
+    #define NVSRAMLinux_NUM_SECTORS 6
+#endif
+
+/*!
+ *  @brief  Keep the NVS region in a file
+ *
+ *  Must be called before NVS_init(). A missing or shorter file is extended to
+ *  the region size with erased (0xFF) bytes. Writes reach the file when the
+ *  region is closed, or earlier at the discretion of the kernel.
+ *
+ *  @param  path  Path of the backing file, NULL to use anonymous memory
+ *
+ *  @return #NVS_STATUS_SUCCESS, or #NVS_STATUS_ERROR when NVS is already
+ *          initialized.
+ */
+extern int_fast16_t NVSRAMLinux_setBackingFile(const char *path);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* ti_linux_nvs_NVSRAMLinux__include */
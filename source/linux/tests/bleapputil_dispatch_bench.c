@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== bleapputil_dispatch_bench.c ========
+ *
+ *  Cost of BLEAppUtil_callEventHandler() and BLEAppUtil_isEventEnabled()
+ *  against the number of registered event handlers, with the handler
+ *  snapshots of bleapputil_init.c. Events are dispatched to GAP connection
+ *  handlers that all take them, to the same handlers when only one takes
+ *  them, and to a type that has no handler while the others are registered
+ *  for every other type.
+ *
+ *  The stack calls of bleapputil_init.c and bleapputil_process.c are stubbed
+ *  out by bleapputil_host.c.
+ */
+
+#include <stdio.h>
+
+#include <ti/bleapp/ble_app_util/inc/bleapputil_api.h>
+#include <ti/bleapp/ble_app_util/inc/bleapputil_internal.h>
+
+#include "icall_host.h"
+#include "test_util.h"
+
+#define BENCH_EVENTS     200000
+#define BENCH_MAX        32
+#define BENCH_EVENT      BLEAPPUTIL_LINK_ESTABLISHED_EVENT
+#define BENCH_OTHER      BLEAPPUTIL_LINK_TERMINATED_EVENT
+
+static const int handlerCounts[] = {1, 2, 4, 8, 16, 32};
+
+static BLEAppUtil_EventHandler_t handlers[BENCH_MAX];
+static uint32_t calls;
+
+static void benchHandler(uint32 event, BLEAppUtil_msgHdr_t *pMsgData)
+{
+    calls++;
+}
+
+static void registerHandlers(int count, bool spread, uint32_t otherMask)
+{
+    int i;
+
+    for (i = 0; i < count; i++)
+    {
+        // Spread handlers skip the GAP connection type
+        handlers[i].handlerType   = spread ? (BLEAppUtil_eventHandlerType_e)(1 + (i % (BLEAPPUTIL_NUM_OF_HANDLER_TYPES - 1)))
+                                           : BLEAPPUTIL_GAP_CONN_TYPE;
+        handlers[i].pEventHandler = benchHandler;
+        handlers[i].eventMask     = (i == 0) ? BENCH_EVENT : otherMask;
+        CHECK(BLEAppUtil_registerEventHandler(&handlers[i]) == SUCCESS);
+    }
+    BLEAppUtil_reclaimHandlerSnapshots();
+}
+
+static void unregisterHandlers(int count)
+{
+    int i;
+
+    for (i = 0; i < count; i++)
+    {
+        CHECK(BLEAppUtil_unRegisterEventHandler(&handlers[i]) == SUCCESS);
+    }
+    BLEAppUtil_reclaimHandlerSnapshots();
+    CHECK(icallHostBlocks == 0);
+}
+
+/* Nanoseconds per dispatch of BENCH_EVENT, checks the handlers called */
+static double timeDispatch(uint32_t expectedCalls)
+{
+    BLEAppUtil_msgHdr_t msg = {0};
+    uint64_t start;
+    int i;
+
+    calls = 0;
+    start = testNowNs();
+    for (i = 0; i < BENCH_EVENTS; i++)
+    {
+        BLEAppUtil_callEventHandler(BENCH_EVENT, &msg, BLEAPPUTIL_GAP_CONN_TYPE);
+    }
+    start = testNowNs() - start;
+    CHECK(calls == expectedCalls * BENCH_EVENTS);
+    return (double)start / BENCH_EVENTS;
+}
+
+/* Nanoseconds per BLEAppUtil_isEventEnabled() of the GAP connection type */
+static double timeEnabled(bool expected)
+{
+    uint64_t start = testNowNs();
+    uint32_t enabled = 0;
+    int i;
+
+    for (i = 0; i < BENCH_EVENTS; i++)
+    {
+        enabled += BLEAppUtil_isEventEnabled(BLEAPPUTIL_GAP_CONN_TYPE, BENCH_EVENT);
+    }
+    start = testNowNs() - start;
+    CHECK(enabled == (expected ? BENCH_EVENTS : 0));
+    return (double)start / BENCH_EVENTS;
+}
+
+int main(void)
+{
+    double allNs;
+    double oneNs;
+    double otherNs;
+    double enabledNs;
+    size_t n;
+    int count;
+
+    // As BLEAppUtil_init() does
+    pthread_mutex_init(&mutex, NULL);
+
+    printf("BLEAppUtil dispatch, ns per event\n");
+    printf("  %8s %10s %10s %12s %10s\n", "handlers", "all take", "one takes", "other types", "enabled");
+    for (n = 0; n < sizeof(handlerCounts) / sizeof(handlerCounts[0]); n++)
+    {
+        count = handlerCounts[n];
+
+        registerHandlers(count, false, BENCH_EVENT);
+        allNs = timeDispatch(count);
+        unregisterHandlers(count);
+
+        registerHandlers(count, false, BENCH_OTHER);
+        oneNs     = timeDispatch(1);
+        enabledNs = timeEnabled(true);
+        unregisterHandlers(count);
+
+        registerHandlers(count, true, BENCH_EVENT);
+        otherNs = timeDispatch(0);
+        CHECK(timeEnabled(false) >= 0);
+        unregisterHandlers(count);
+
+        printf("  %8d %10.1f %10.1f %12.1f %10.1f\n", count, allNs, oneNs, otherNs, enabledNs);
+    }
+
+    return 0;
+}
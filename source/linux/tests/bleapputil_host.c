@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== bleapputil_host.c ========
+ *
+ *  BLE stack entry points and BLEAppUtil task functions referenced by
+ *  bleapputil_init.c and bleapputil_process.c when they are built for the
+ *  host benchmarks. There is no BLEAppUtil task and no stack: messages are
+ *  never queued, and the GAP, HCI and handover calls succeed and do nothing.
+ */
+
+#include <ti/bleapp/ble_app_util/inc/bleapputil_api.h>
+#include <ti/bleapp/ble_app_util/inc/bleapputil_internal.h>
+
+#include "osal_bufmgr.h"
+
+/*
+ *  ======== BLEAppUtil task and stack callbacks ========
+ */
+int BLEAppUtil_createBLEAppUtilTask(void)
+{
+    return 0;
+}
+
+void BLEAppUtil_initMsgPool(void)
+{
+}
+
+void *BLEAppUtil_allocMsg(void)
+{
+    return NULL;
+}
+
+void BLEAppUtil_releaseMsg(void *pData)
+{
+}
+
+status_t BLEAppUtil_enqueueMsg(uint8_t event, void *pData)
+{
+    return FAILURE;
+}
+
+uint8_t BLEAppUtil_processStackMsgCB(uint8_t event, uint8_t *pMsg)
+{
+    return TRUE;
+}
+
+void BLEAppUtil_passcodeCB(uint8_t *pDeviceAddr, uint16_t connHandle, uint8_t uiInputs, uint8_t uiOutputs,
+                           uint32_t numComparison)
+{
+}
+
+void BLEAppUtil_pairStateCB(uint16_t connHandle, uint8_t state, uint8_t status)
+{
+}
+
+void BLEAppUtil_connEventCB(Gap_ConnEventRpt_t *pReport)
+{
+}
+
+void BLEAppUtil_scanCB(uint32_t event, GapScan_data_t *pBuf, uint32_t *arg)
+{
+}
+
+void BLEAppUtil_advCB(uint32_t event, GapAdv_data_t *pBuf, uint32_t *arg)
+{
+}
+
+void BLEAppUtil_HandoverSNCB(uint16_t connHandle, uint32_t status)
+{
+}
+
+void BLEAppUtil_HandoverCNCB(uint16_t connHandle, uint32_t status)
+{
+}
+
+/*
+ *  ======== Stack ========
+ */
+bleStack_errno_t bleStack_register(uint8_t *selfEntity, appCallback_t appCallback)
+{
+    return SUCCESS;
+}
+
+void bleStack_createTasks()
+{
+}
+
+bStatus_t bleStack_initGap(uint8_t role, ICall_EntityID appSelfEntity, bleStk_pfnGapScanCB_t scanCallback,
+                           uint16_t paramUpdateDecision)
+{
+    return SUCCESS;
+}
+
+bStatus_t bleStack_initGapBond(gapBondParams_t *pGapBondParams, void *bleApp_bondMgrCBs)
+{
+    return SUCCESS;
+}
+
+bStatus_t bleStack_initGatt(uint8_t role, ICall_EntityID appSelfEntity, uint8_t *pAttDeviceName)
+{
+    return SUCCESS;
+}
+
+bStatus_t bleStk_initAdvSet(pfnBleStkAdvCB_t advCallback, uint8_t *advHandle, GapAdv_eventMaskFlags_t eventMask,
+                            GapAdv_params_t *advParams, uint16_t advDataLen, uint8_t *advData,
+                            uint16_t scanRespDataLen, uint8_t *scanRespData)
+{
+    return SUCCESS;
+}
+
+bStatus_t GAP_DeviceInit(uint8_t profileRole, uint8_t taskID, GAP_Addr_Modes_t addrMode, uint8_t *pRandomAddr)
+{
+    return SUCCESS;
+}
+
+bStatus_t GAP_TerminateLinkReq(uint16_t connectionHandle, uint8_t reason)
+{
+    return SUCCESS;
+}
+
+bStatus_t GAP_UpdateLinkParamReq(gapUpdateLinkParamReq_t *pParams)
+{
+    return SUCCESS;
+}
+
+bStatus_t GAP_UpdateLinkParamReqReply(gapUpdateLinkParamReqReply_t *pParams)
+{
+    return SUCCESS;
+}
+
+bStatus_t Gap_RegisterConnEventCb(pfnGapConnEvtCB_t cb, GAP_CB_Action_t action, GAP_CB_Event_e event,
+                                  uint16_t connHandle)
+{
+    return SUCCESS;
+}
+
+bStatus_t GapAdv_enable(uint8 handle, GapAdv_enableOptions_t enableOptions, uint16 durationOrMaxEvents)
+{
+    return SUCCESS;
+}
+
+bStatus_t GapAdv_disable(uint8 handle)
+{
+    return SUCCESS;
+}
+
+status_t GapInit_connect(GAP_Peer_Addr_Types_t peerAddrType, uint8_t *pPeerAddress, uint8_t phys, uint16_t timeout)
+{
+    return SUCCESS;
+}
+
+status_t GapInit_cancelConnect(void)
+{
+    return SUCCESS;
+}
+
+status_t GapInit_setPhyParam(uint8_t phys, GapInit_PhyParamId_t paramId, uint16_t value)
+{
+    return SUCCESS;
+}
+
+status_t GapScan_setPhyParams(uint8_t primPhys, GapScan_ScanType_t type, uint16_t interval, uint16_t window)
+{
+    return SUCCESS;
+}
+
+status_t GapScan_setParam(GapScan_ParamId_t paramId, void *pValue)
+{
+    return SUCCESS;
+}
+
+status_t GapScan_enable(uint16_t period, uint16_t duration, uint8_t maxNumReport)
+{
+    return SUCCESS;
+}
+
+status_t GapScan_disable(void)
+{
+    return SUCCESS;
+}
+
+hciStatus_t HCI_LE_SetPhyCmd(uint16 connHandle, uint8 allPhys, uint8 txPhy, uint8 rxPhy, uint16 phyOpts)
+{
+    return SUCCESS;
+}
+
+uint8_t Handover_RegisterSNCBs(const handoverSNCBs_t *pCBs)
+{
+    return SUCCESS;
+}
+
+uint8_t Handover_RegisterCNCBs(const handoverCNCBs_t *pCBs)
+{
+    return SUCCESS;
+}
+
+uint8 linkDB_GetInfo(uint16 connectionHandle, linkDBInfo_t *pInfo)
+{
+    return bleNotConnected;
+}
+
+void osal_bm_free(void *payload_ptr)
+{
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== display_async_test.c ========
+ *
+ *  Host test of the DisplayUart2Async display backend on the Linux DPL.
+ *  A task prints as a BLE application does, many times per refresh period,
+ *  and the output sent to the UART must hold the latest content of every
+ *  line, in writes at least one refresh period apart, while the printing
+ *  task never blocks. Also covered: the conversions the backend records,
+ *  %s buffers reused right after the call, the scrolling ring, clearLines,
+ *  lines too long for strBuf and DISPLAYUART2ASYNC_CMD_FLUSH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <ti/drivers/dpl/ClockP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+#include <ti/drivers/dpl/TaskP.h>
+
+#include "DPLLinux.h"
+#include "display_host.h"
+#include "test_util.h"
+
+#define TEST_PRINTS      1000
+#define TEST_BURST       100
+#define TEST_BURST_GAPUS 10000
+
+static DisplayHostUart *uart = &displayHostUart[DISPLAY_HOST_ASYNC];
+static Display_Handle display;
+static SemaphoreP_Handle done;
+
+/* Prints from the BLE task, between which only the bursts take time */
+static void testCoalescing(void)
+{
+    char peer[32];
+    uint64_t start;
+    uint32_t i;
+
+    displayHostReset(DISPLAY_HOST_ASYNC);
+    start = DPLLinux_now();
+    for (i = 0; i < TEST_PRINTS; i++)
+    {
+        // %s content is copied, the buffer is reused right after the call
+        strcpy(peer, "peer");
+        Display_printf(display, 3, 0, "pkt %d from %s rssi %i %x %5.2f %%", i, peer, -40, 0xABu, 1.5);
+        strcpy(peer, "XXXX");
+        Display_printf(display, 4, 2, "%*d|%-6s|%c|%p", 5, i, "ab", 'z', (void *)0x10);
+        Display_printf(display, DisplayUart2_SCROLLING, 0, "log %d", i);
+        if ((i % TEST_BURST) == (TEST_BURST - 1))
+        {
+            ClockP_usleep(TEST_BURST_GAPUS);
+        }
+    }
+    CHECK(DPLLinux_now() - start == (TEST_PRINTS / TEST_BURST) * TEST_BURST_GAPUS);
+    ClockP_usleep(4 * DISPLAY_HOST_REFRESH_US);
+
+    printf("%u prints: %u writes, %u bytes\n", 3 * TEST_PRINTS, uart->writes, (unsigned int)uart->bytes);
+    CHECK(uart->writes >= 2);
+    CHECK(uart->writes <= 2 + (TEST_PRINTS / TEST_BURST) * TEST_BURST_GAPUS / DISPLAY_HOST_REFRESH_US);
+    for (i = 1; (i < uart->writes) && (i < DISPLAY_HOST_WRITES_MAX); i++)
+    {
+        CHECK(uart->writeTimes[i] - uart->writeTimes[i - 1] >= DISPLAY_HOST_REFRESH_US);
+    }
+
+    CHECK(strstr(uart->out, "pkt 999 from peer rssi -40 ab  1.50 %") != NULL);
+    CHECK(strstr(uart->out, "  999|ab    |z|") != NULL);
+    CHECK(strstr(uart->out, "pkt 998") == NULL);
+    CHECK(strstr(uart->out, "XXXX") == NULL);
+    CHECK(strstr(uart->out, "\x1b[4;1H") != NULL);
+    CHECK(strstr(uart->out, "\x1b[5;3H") != NULL);
+
+    // The ring keeps the last scrolling lines, the older ones are counted
+    CHECK(strstr(uart->out, "log 999\r\n") != NULL);
+    CHECK(strstr(uart->out, "log 996\r\n") != NULL);
+    CHECK(strstr(uart->out, "log 995\r\n") == NULL);
+    CHECK(displayHostAsyncObject.droppedLines > 0);
+}
+
+/* An explicit flush sends what is pending in one write, without waiting */
+static void testFlush(void)
+{
+    char big[300];
+
+    displayHostReset(DISPLAY_HOST_ASYNC);
+    memset(big, 'A', sizeof(big) - 1);
+    big[sizeof(big) - 1] = '\0';
+
+    // %s content beyond DisplayUart2Async_STR_ARGS_LEN is truncated
+    Display_printf(display, 5, 0, "%s%s%s%s%s%s", big, big, big, big, big, big);
+    Display_printf(display, 6, 0, "static %s", "x");
+    Display_clearLines(display, 7, 8);
+    Display_control(display, DISPLAYUART2ASYNC_CMD_FLUSH, NULL);
+    ClockP_usleep(1000);
+
+    CHECK(uart->writes == 1);
+    CHECK(strstr(uart->out, "static x") != NULL);
+    CHECK(strstr(uart->out, "\x1b[8;1H\x1b[2K") != NULL);
+    CHECK(strlen(uart->out) < DISPLAY_HOST_STRBUF_LEN);
+}
+
+/* Changed lines that do not fit strBuf together go in several writes */
+static void testLongOutput(void)
+{
+    char expected[16];
+    int line;
+
+    // Let the refresh period of the flush above end first
+    ClockP_usleep(2 * DISPLAY_HOST_REFRESH_US);
+    displayHostReset(DISPLAY_HOST_ASYNC);
+    for (line = 0; line < DISPLAY_HOST_LINES; line++)
+    {
+        Display_printf(display, line, 0, "line %d %s", line, "0123456789012345678901234567890123456789");
+    }
+    // Beyond numLines, dropped
+    Display_printf(display, DISPLAY_HOST_LINES, 0, "beyond");
+    // Each full strBuf takes 22 ms on the line
+    ClockP_usleep(4 * DISPLAY_HOST_REFRESH_US);
+
+    CHECK(uart->writes > 1);
+    for (line = 0; line < DISPLAY_HOST_LINES; line++)
+    {
+        sprintf(expected, "line %d ", line);
+        CHECK(strstr(uart->out, expected) != NULL);
+    }
+    CHECK(strstr(uart->out, "beyond") == NULL);
+
+    // A clear is sent, and the lines printed before it are not
+    displayHostReset(DISPLAY_HOST_ASYNC);
+    Display_printf(display, 2, 0, "before clear");
+    Display_clear(display);
+    ClockP_usleep(2 * DISPLAY_HOST_REFRESH_US);
+    CHECK(uart->writes == 1);
+    CHECK(strstr(uart->out, "\x1b[2J") != NULL);
+    CHECK(strstr(uart->out, "before clear") == NULL);
+}
+
+static void appTask(void *arg)
+{
+    (void)arg;
+
+    testCoalescing();
+    testFlush();
+    testLongOutput();
+    SemaphoreP_post(done);
+}
+
+int main(void)
+{
+    Display_Params params;
+    TaskP_Params taskParams;
+
+    Display_init();
+    Display_Params_init(&params);
+    params.lineClearMode = DISPLAY_CLEAR_BOTH;
+    display = Display_open(DISPLAY_HOST_ASYNC, &params);
+    CHECK(display != NULL);
+
+    done = SemaphoreP_createBinary(0);
+    TaskP_Params_init(&taskParams);
+    taskParams.priority = 2;
+    CHECK(TaskP_create(appTask, &taskParams) != NULL);
+    DPLLinux_start();
+    CHECK(SemaphoreP_pend(done, SemaphoreP_WAIT_FOREVER) == SemaphoreP_OK);
+
+    printf("PASS\n");
+    return 0;
+}
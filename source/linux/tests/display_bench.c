@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== display_bench.c ========
+ *
+ *  Console output cost of a BLE data path that prints for every packet, as
+ *  L2CAPCOC_dataHandler() and DSS_sendNotification() do, with the
+ *  DisplayUart2Async and the DisplayUart2Ansi backends. Packets arrive at a
+ *  fixed interval in virtual time and the UART sends at its baud rate, so a
+ *  backend that blocks the data path caps the packet rate.
+ *
+ *  For each backend the benchmark reports the packet rate reached, the time
+ *  spent in Display_printf() by the data path, and the UART traffic. The
+ *  last content printed must be on the UART in the end.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <ti/drivers/dpl/ClockP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+#include <ti/drivers/dpl/TaskP.h>
+
+#include "DPLLinux.h"
+#include "display_host.h"
+#include "test_util.h"
+
+#define BENCH_PACKETS   20000
+#define BENCH_PACKET_US 400
+#define BENCH_SDU_LEN   244
+
+static SemaphoreP_Handle done;
+
+static void runBackend(int index, const char *name)
+{
+    DisplayHostUart *uart = &displayHostUart[index];
+    Display_Handle display = (Display_Handle)&Display_config[index];
+    uint64_t printNs = 0;
+    uint64_t start;
+    uint64_t elapsed;
+    uint32_t total = 0;
+    uint32_t i;
+    char last[64];
+
+    displayHostReset(index);
+    Display_clear(display);
+    start = DPLLinux_now();
+    for (i = 0; i < BENCH_PACKETS; i++)
+    {
+        uint64_t arrival = start + (uint64_t)i * BENCH_PACKET_US;
+        uint64_t t0;
+
+        // Wait for the next packet, unless the data path is already late
+        if (DPLLinux_now() < arrival)
+        {
+            ClockP_usleep((uint32_t)(arrival - DPLLinux_now()));
+        }
+
+        total += BENCH_SDU_LEN;
+        t0 = testNowNs();
+        Display_printf(display, 6, 0, "L2CAP CoC: SDU of %d bytes received, %u in total", BENCH_SDU_LEN, total);
+        Display_printf(display, 7, 0, "DSS: notification %u sent, status %d", i, 0);
+        printNs += testNowNs() - t0;
+    }
+    elapsed = DPLLinux_now() - start;
+
+    // Let the output drain and check that the last content made it
+    Display_control(display, DISPLAYUART2ASYNC_CMD_FLUSH, NULL);
+    ClockP_usleep(4 * DISPLAY_HOST_REFRESH_US);
+    snprintf(last, sizeof(last), "DSS: notification %u sent", BENCH_PACKETS - 1);
+    CHECK(strstr(uart->lastWrite, last) != NULL);
+
+    printf("%-16s %6.0f packets/s, %7.1f ns per print, %6u writes, %8lu bytes\n", name,
+           (BENCH_PACKETS * 1e6) / (double)elapsed, (double)printNs / (2 * BENCH_PACKETS), uart->writes,
+           (unsigned long)uart->bytes);
+}
+
+static void appTask(void *arg)
+{
+    Display_Params params;
+
+    (void)arg;
+
+    // DisplayUart2Ansi writes to the UART as it opens, which takes time
+    Display_Params_init(&params);
+    CHECK(Display_open(DISPLAY_HOST_ASYNC, &params) != NULL);
+    CHECK(Display_open(DISPLAY_HOST_ANSI, &params) != NULL);
+
+    printf("%d packets, one every %d us, %d baud\n", BENCH_PACKETS, BENCH_PACKET_US, DISPLAY_HOST_BAUD_RATE);
+    runBackend(DISPLAY_HOST_ASYNC, "DisplayUart2Async");
+    runBackend(DISPLAY_HOST_ANSI, "DisplayUart2Ansi");
+    SemaphoreP_post(done);
+}
+
+int main(void)
+{
+    TaskP_Params taskParams;
+
+    Display_init();
+
+    done = SemaphoreP_createBinary(0);
+    TaskP_Params_init(&taskParams);
+    taskParams.priority = 2;
+    CHECK(TaskP_create(appTask, &taskParams) != NULL);
+    DPLLinux_start();
+    CHECK(SemaphoreP_pend(done, SemaphoreP_WAIT_FOREVER) == SemaphoreP_OK);
+
+    printf("PASS\n");
+    return 0;
+}
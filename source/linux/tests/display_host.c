@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== display_host.c ========
+ */
+
+#include <string.h>
+
+#include <ti/drivers/UART2.h>
+#include <ti/drivers/dpl/ClockP.h>
+#include <ti/drivers/dpl/HwiP.h>
+
+#include "DPLLinux.h"
+#include "display_host.h"
+
+DisplayHostUart displayHostUart[DISPLAY_HOST_COUNT];
+
+const UART2_Config UART2_config[DISPLAY_HOST_COUNT] = {
+    {.object = &displayHostUart[DISPLAY_HOST_ASYNC], .hwAttrs = NULL},
+    {.object = &displayHostUart[DISPLAY_HOST_ANSI], .hwAttrs = NULL},
+};
+
+DisplayUart2Async_Object displayHostAsyncObject;
+static char asyncStrBuf[DISPLAY_HOST_STRBUF_LEN];
+static DisplayUart2Async_Line asyncLines[DISPLAY_HOST_LINES];
+static DisplayUart2Async_Line asyncScrollLines[DISPLAY_HOST_SCROLL];
+static uint8_t asyncTaskStack[4096];
+
+static const DisplayUart2Async_HWAttrs asyncHWAttrs = {
+    .uartIdx         = DISPLAY_HOST_ASYNC,
+    .baudRate        = DISPLAY_HOST_BAUD_RATE,
+    .strBuf          = asyncStrBuf,
+    .strBufLen       = DISPLAY_HOST_STRBUF_LEN,
+    .lines           = asyncLines,
+    .numLines        = DISPLAY_HOST_LINES,
+    .scrollLines     = asyncScrollLines,
+    .numScrollLines  = DISPLAY_HOST_SCROLL,
+    .refreshPeriodUs = DISPLAY_HOST_REFRESH_US,
+    .taskPriority    = 1,
+    .taskStack       = asyncTaskStack,
+    .taskStackSize   = sizeof(asyncTaskStack),
+};
+
+static DisplayUart2_Object ansiObject;
+static char ansiStrBuf[DISPLAY_HOST_STRBUF_LEN];
+
+static const DisplayUart2_HWAttrs ansiHWAttrs = {
+    .uartIdx      = DISPLAY_HOST_ANSI,
+    .baudRate     = DISPLAY_HOST_BAUD_RATE,
+    .mutexTimeout = SemaphoreP_WAIT_FOREVER,
+    .strBuf       = ansiStrBuf,
+    .strBufLen    = DISPLAY_HOST_STRBUF_LEN,
+};
+
+const Display_Config Display_config[DISPLAY_HOST_COUNT] = {
+    {.fxnTablePtr = &DisplayUart2Async_fxnTable, .object = &displayHostAsyncObject, .hwAttrs = &asyncHWAttrs},
+    {.fxnTablePtr = &DisplayUart2Ansi_fxnTable, .object = &ansiObject, .hwAttrs = &ansiHWAttrs},
+};
+
+const uint8_t Display_count = DISPLAY_HOST_COUNT;
+
+/*
+ *  ======== displayHostReset ========
+ */
+void displayHostReset(int uart)
+{
+    uintptr_t key = HwiP_disable();
+
+    displayHostUart[uart].outLen = 0;
+    displayHostUart[uart].out[0] = '\0';
+    displayHostUart[uart].bytes = 0;
+    displayHostUart[uart].writes = 0;
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== UART2_Params_init ========
+ */
+void UART2_Params_init(UART2_Params *params)
+{
+    memset(params, 0, sizeof(*params));
+    params->baudRate = 115200;
+}
+
+/*
+ *  ======== UART2_open ========
+ */
+UART2_Handle UART2_open(uint_least8_t index, UART2_Params *params)
+{
+    DisplayHostUart *uart;
+
+    if ((index >= DISPLAY_HOST_COUNT) || displayHostUart[index].open)
+    {
+        return NULL;
+    }
+
+    uart = &displayHostUart[index];
+    uart->open = true;
+    uart->baudRate = params->baudRate;
+    return (UART2_Handle)&UART2_config[index];
+}
+
+/*
+ *  ======== UART2_close ========
+ */
+void UART2_close(UART2_Handle handle)
+{
+    ((DisplayHostUart *)handle->object)->open = false;
+}
+
+/*
+ *  ======== UART2_write ========
+ *  Blocking mode: the caller waits for the start bit, 8 data bits and stop
+ *  bit of every byte.
+ */
+int_fast16_t UART2_write(UART2_Handle handle, const void *buffer, size_t size, size_t *bytesWritten)
+{
+    DisplayHostUart *uart = (DisplayHostUart *)handle->object;
+    uintptr_t key = HwiP_disable();
+    size_t keep = size;
+
+    if (uart->writes < DISPLAY_HOST_WRITES_MAX)
+    {
+        uart->writeTimes[uart->writes] = DPLLinux_now();
+    }
+    uart->writes++;
+    uart->bytes += size;
+    if (keep > DISPLAY_HOST_OUT_LEN - uart->outLen)
+    {
+        keep = DISPLAY_HOST_OUT_LEN - uart->outLen;
+    }
+    memcpy(&uart->out[uart->outLen], buffer, keep);
+    uart->outLen += keep;
+    uart->out[uart->outLen] = '\0';
+    keep = (size < DISPLAY_HOST_STRBUF_LEN) ? size : DISPLAY_HOST_STRBUF_LEN;
+    memcpy(uart->lastWrite, buffer, keep);
+    uart->lastWrite[keep] = '\0';
+    HwiP_restore(key);
+
+    ClockP_usleep((uint32_t)(((uint64_t)size * 10 * 1000000) / uart->baudRate));
+
+    if (bytesWritten != NULL)
+    {
+        *bytesWritten = size;
+    }
+    return UART2_STATUS_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== display_host.h ========
+ *
+ *  Display configuration and UART2 driver of the display host tests, see
+ *  display_host.c. Display_config[] holds a DisplayUart2Async display on
+ *  UART 0 and a DisplayUart2Ansi display on UART 1. UART2_write() blocks
+ *  its caller for the time the bytes take on the line at the baud rate, in
+ *  virtual time, and keeps what was sent.
+ */
+
+#ifndef ti_linux_tests_display_host__include
+#define ti_linux_tests_display_host__include
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ti/display/Display.h>
+#include <ti/display/DisplayUart2.h>
+#include <ti/display/DisplayUart2Async.h>
+
+/* Indexes in Display_config[] and UART2_config[] */
+#define DISPLAY_HOST_ASYNC      0
+#define DISPLAY_HOST_ANSI       1
+#define DISPLAY_HOST_COUNT      2
+
+/* Display geometry and buffers */
+#define DISPLAY_HOST_LINES      16
+#define DISPLAY_HOST_SCROLL     4
+#define DISPLAY_HOST_STRBUF_LEN 256
+#define DISPLAY_HOST_BAUD_RATE  115200
+#define DISPLAY_HOST_REFRESH_US 50000
+
+/* Bytes of output kept per UART, the rest is only counted */
+#define DISPLAY_HOST_OUT_LEN    65536
+#define DISPLAY_HOST_WRITES_MAX 256
+
+typedef struct
+{
+    /* Output since the last reset, NUL terminated */
+    char out[DISPLAY_HOST_OUT_LEN + 1];
+    size_t outLen;
+    uint64_t bytes;
+    /* UART2_write() calls, and the virtual time each started at */
+    uint32_t writes;
+    uint64_t writeTimes[DISPLAY_HOST_WRITES_MAX];
+    /* Content of the last write, NUL terminated */
+    char lastWrite[DISPLAY_HOST_STRBUF_LEN + 1];
+    uint32_t baudRate;
+    bool open;
+} DisplayHostUart;
+
+extern DisplayHostUart displayHostUart[DISPLAY_HOST_COUNT];
+
+extern const Display_Config Display_config[];
+
+extern DisplayUart2Async_Object displayHostAsyncObject;
+
+/* Forget the output and writes of a UART */
+extern void displayHostReset(int uart);
+
+#endif /* ti_linux_tests_display_host__include */
@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== dpl_test.c ========
+ *
+ *  Host test of the Linux DPL port: task scheduling on virtual time, the
+ *  blocking objects, SwiP and HwiP emulation, and the NVS region kept in a
+ *  backing file.
+ *
+ *  Usage: dpl_test <nv file> [reopen]
+ *
+ *  Without "reopen" the NV file is created anew and an NVOCMP item written
+ *  to it; with "reopen" the item written by the previous run must be read
+ *  back from the file.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <ti/drivers/dpl/ClockP.h>
+#include <ti/drivers/dpl/EventP.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/MessageQueueP.h>
+#include <ti/drivers/dpl/MutexP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+#include <ti/drivers/dpl/SwiP.h>
+#include <ti/drivers/dpl/SystemP.h>
+#include <ti/drivers/dpl/TaskP.h>
+#include <ti/drivers/NVS.h>
+#include <ti/common/nv/nvocmp.h>
+
+#include "DPLLinux.h"
+#include "nvs/NVSRAMLinux.h"
+#include "test_util.h"
+
+#define TEST_NV_VALUE   0x5A5A0001U
+#define TEST_NV_WRITES  2000
+
+static SemaphoreP_Handle clockSem;
+static EventP_Handle events;
+static MessageQueueP_Handle queue;
+static MutexP_Handle mutex;
+static int clockRuns;
+static uint32_t taskATicks;
+static uint32_t taskBTicks;
+static int counter;
+static int swiRuns;
+static uint32_t swiTrigger;
+static int hwiRuns;
+
+static void clockFxn(uintptr_t arg)
+{
+    clockRuns++;
+    CHECK(HwiP_inISR());
+    SemaphoreP_post(clockSem);
+}
+
+static void taskA(void *arg)
+{
+    int msg;
+    int i;
+
+    // Posted by the periodic clock after 100 ticks
+    CHECK(SemaphoreP_pend(clockSem, 1000) == SemaphoreP_OK);
+    taskATicks = ClockP_getSystemTicks();
+
+    CHECK(EventP_pend(events, 0x3, true, 5000) == 0x3);
+
+    // Message 7 was posted to the front
+    CHECK(MessageQueueP_pend(queue, &msg, MessageQueueP_WAIT_FOREVER) == MessageQueueP_OK);
+    CHECK(msg == 7);
+    CHECK(MessageQueueP_pend(queue, &msg, MessageQueueP_WAIT_FOREVER) == MessageQueueP_OK);
+    CHECK(msg == 8);
+
+    // Recursive locking
+    for (i = 0; i < 10000; i++)
+    {
+        MutexP_lock(mutex);
+        MutexP_lock(mutex);
+        counter++;
+        MutexP_unlock(mutex, 0);
+        MutexP_unlock(mutex, 0);
+    }
+}
+
+static void taskB(void *arg)
+{
+    uintptr_t key;
+    int msg;
+    int i;
+
+    ClockP_usleep(250);
+    taskBTicks = ClockP_getSystemTicks();
+    EventP_post(events, 0x1);
+    ClockP_usleep(10);
+    EventP_post(events, 0x2);
+
+    key = TaskP_disableScheduler();
+    msg = 8;
+    MessageQueueP_post(queue, &msg, 0);
+    msg = 7;
+    MessageQueueP_postFront(queue, &msg, 0);
+    TaskP_restoreScheduler(key);
+
+    for (i = 0; i < 10000; i++)
+    {
+        MutexP_lock(mutex);
+        counter++;
+        MutexP_unlock(mutex, 0);
+    }
+}
+
+static void blockedTask(void *arg)
+{
+    SemaphoreP_pend((SemaphoreP_Handle)arg, SemaphoreP_WAIT_FOREVER);
+    CHECK(0);
+}
+
+static void swiFxn(uintptr_t arg0, uintptr_t arg1)
+{
+    swiRuns++;
+    swiTrigger = SwiP_getTrigger();
+}
+
+static void hwiFxn(uintptr_t arg)
+{
+    hwiRuns += (int)arg;
+}
+
+static void testTasks(void)
+{
+    ClockP_Params clockParams;
+    TaskP_Params taskParams;
+    ClockP_Handle clock;
+    SemaphoreP_Handle sem;
+    uint64_t start;
+    int before;
+
+    clockSem = SemaphoreP_createBinary(0);
+    events   = EventP_create();
+    queue    = MessageQueueP_create(sizeof(int), 4);
+    mutex    = MutexP_create(NULL);
+
+    ClockP_Params_init(&clockParams);
+    clockParams.period = 100;
+    clock = ClockP_create(clockFxn, 100, &clockParams);
+    ClockP_start(clock);
+
+    TaskP_Params_init(&taskParams);
+    CHECK(TaskP_create(taskA, &taskParams) != NULL);
+    CHECK(TaskP_create(taskB, &taskParams) != NULL);
+    SystemP_startScheduler();
+
+    // Virtual time only moved when both tasks were blocked
+    CHECK(taskATicks == 100);
+    CHECK(taskBTicks == 250);
+    CHECK(counter == 20000);
+    ClockP_stop(clock);
+
+    // A timeout of the main thread costs no wall-clock time
+    start = DPLLinux_now();
+    sem = SemaphoreP_create(0, NULL);
+    CHECK(SemaphoreP_pend(sem, 12345) == SemaphoreP_TIMEOUT);
+    CHECK(DPLLinux_now() - start == 12345);
+    SemaphoreP_delete(sem);
+
+    // One-shot clock driven by DPLLinux_advance()
+    before = clockRuns;
+    ClockP_setTimeout(clock, 50);
+    ClockP_setPeriod(clock, 0);
+    ClockP_start(clock);
+    DPLLinux_advance(49);
+    CHECK(clockRuns == before);
+    DPLLinux_advance(1);
+    CHECK(clockRuns == before + 1);
+    DPLLinux_advance(1000);
+    CHECK(clockRuns == before + 1);
+    ClockP_delete(clock);
+}
+
+static void testQueueFull(void)
+{
+    MessageQueueP_Handle q = MessageQueueP_create(3, 2);
+    char msg[3] = "ab";
+
+    CHECK(MessageQueueP_post(q, msg, 0) == MessageQueueP_OK);
+    CHECK(MessageQueueP_post(q, msg, 0) == MessageQueueP_OK);
+    CHECK(MessageQueueP_post(q, msg, 10) == MessageQueueP_TIMEOUT);
+    CHECK(MessageQueueP_getFreeCount(q) == 0);
+    MessageQueueP_delete(q);
+}
+
+static void testSwiHwi(void)
+{
+    SwiP_Params swiParams;
+    HwiP_Params hwiParams;
+    SwiP_Handle swi;
+    HwiP_Handle hwi;
+    uintptr_t key;
+
+    SwiP_Params_init(&swiParams);
+    swiParams.trigger = 3;
+    swi = SwiP_create(swiFxn, &swiParams);
+    SwiP_dec(swi);
+    SwiP_dec(swi);
+    CHECK(swiRuns == 0);
+    SwiP_dec(swi);
+    CHECK(swiRuns == 1);
+    CHECK(swiTrigger == 0);
+    SwiP_andn(swi, 0);
+    CHECK(swiRuns == 1);
+
+    // Posted while disabled, runs on restore
+    key = SwiP_disable();
+    SwiP_or(swi, 0x10);
+    CHECK(swiRuns == 1);
+    SwiP_restore(key);
+    CHECK(swiRuns == 2);
+    CHECK(swiTrigger == 0x13);
+    SwiP_delete(swi);
+
+    HwiP_Params_init(&hwiParams);
+    hwiParams.arg = 2;
+    hwi = HwiP_create(5, hwiFxn, &hwiParams);
+    HwiP_post(5);
+    CHECK(hwiRuns == 2);
+    HwiP_disableInterrupt(5);
+    HwiP_post(5);
+    CHECK(hwiRuns == 2);
+    HwiP_enableInterrupt(5);
+    CHECK(hwiRuns == 4);
+    HwiP_delete(hwi);
+}
+
+static void testTaskDelete(void)
+{
+    SemaphoreP_Handle sem = SemaphoreP_createBinary(0);
+    TaskP_Params taskParams;
+    TaskP_Handle task;
+
+    TaskP_Params_init(&taskParams);
+    taskParams.arg = sem;
+    task = TaskP_create(blockedTask, &taskParams);
+    while (TaskP_getState(task) != TaskP_State_BLOCKED)
+    {
+        TaskP_yield();
+    }
+    TaskP_delete(task);
+    SystemP_startScheduler();
+    CHECK(TaskP_getState(task) == TaskP_State_DELETED);
+}
+
+static void testNvFile(const char *path, int reopen)
+{
+    NVINTF_itemID_t id = {.systemID = NVINTF_SYSID_APP, .itemID = 1, .subID = 0};
+    NVINTF_nvFuncts_t nv;
+    uint32_t value;
+    int i;
+
+    if (!reopen)
+    {
+        unlink(path);
+    }
+    CHECK(NVSRAMLinux_setBackingFile(path) == NVS_STATUS_SUCCESS);
+    NVOCMP_loadApiPtrs(&nv);
+    CHECK(nv.initNV(NULL) == NVINTF_SUCCESS);
+
+    if (reopen)
+    {
+        CHECK(nv.readItem(id, 0, sizeof(value), &value) == NVINTF_SUCCESS);
+        CHECK(value == TEST_NV_VALUE);
+        return;
+    }
+
+    CHECK(nv.readItem(id, 0, sizeof(value), &value) == NVINTF_NOTFOUND);
+    // Enough writes to compact the pages several times
+    for (i = 0; i < TEST_NV_WRITES; i++)
+    {
+        value = TEST_NV_VALUE - TEST_NV_WRITES + 1 + i;
+        CHECK(nv.writeItem(id, sizeof(value), &value) == NVINTF_SUCCESS);
+    }
+    CHECK(nv.readItem(id, 0, sizeof(value), &value) == NVINTF_SUCCESS);
+    CHECK(value == TEST_NV_VALUE);
+}
+
+int main(int argc, char **argv)
+{
+    int reopen = (argc > 2) && (0 == strcmp(argv[2], "reopen"));
+
+    if (argc < 2)
+    {
+        printf("usage: %s <nv file> [reopen]\n", argv[0]);
+        return 2;
+    }
+
+    if (!reopen)
+    {
+        testTasks();
+        testQueueFull();
+        testSwiHwi();
+        testTaskDelete();
+    }
+    testNvFile(argv[1], reopen);
+
+    printf("PASS\n");
+    return 0;
+}
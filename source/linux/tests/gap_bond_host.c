@@ -0,0 +1,521 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== gap_bond_host.c ========
+ *
+ *  BLE stack entry points referenced by gapbondmgr.c when it is built for the
+ *  host tests with HOST_CONFIG=PERIPHERAL_CFG. There are no connections and
+ *  no pairing: the GAP, SM, GATT and HCI calls succeed and do nothing, and
+ *  no address resolves. osal_snv_read() and osal_snv_read_each() are wrapped
+ *  to count the NV reads of the bond records.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "gap_bond_host.h"
+
+#include "icall.h"
+#include "bcomdef.h"
+#include "osal.h"
+#include "osal_memory.h"
+#include "osal_snv.h"
+#include "ll_enc.h"
+#include "ll_privacy.h"
+#include "l2cap.h"
+#include "sm.h"
+#include "linkdb.h"
+#include "linkdb_internal.h"
+#include "gap.h"
+#include "gap_internal.h"
+#include "gatt.h"
+#include "gatt_uuid.h"
+#include "hci.h"
+#include "gattservapp.h"
+#include "gapbondmgr.h"
+
+uint32_t gapBondHostBondReads;
+uint32_t gapBondHostReadEachs;
+uint32_t gapBondHostReadEachOks;
+
+const uint8 clientCharCfgUUID[ATT_BT_UUID_SIZE] = {LO_UINT16(GATT_CLIENT_CHAR_CFG_UUID),
+                                                   HI_UINT16(GATT_CLIENT_CHAR_CFG_UUID)};
+uint8 gapEndAppTaskID = 0xFF;
+uint8_t gapState;
+rlEntry_t *resolvingList;
+
+extern uint8 __real_osal_snv_read(osalSnvId_t id, osalSnvLen_t len, void *pBuf);
+extern uint8 __real_osal_snv_read_each(osalSnvId_t firstId, osalSnvId_t lastId, osalSnvLen_t len, void *pBuf,
+                                       osalSnvItemCB_t pfnItem);
+
+uint8 __wrap_osal_snv_read(osalSnvId_t id, osalSnvLen_t len, void *pBuf)
+{
+    if ((id >= BLE_NVID_GAP_BOND_START) && (id <= BLE_NVID_GAP_BOND_END))
+    {
+        gapBondHostBondReads++;
+    }
+    return __real_osal_snv_read(id, len, pBuf);
+}
+
+uint8 __wrap_osal_snv_read_each(osalSnvId_t firstId, osalSnvId_t lastId, osalSnvLen_t len, void *pBuf,
+                                osalSnvItemCB_t pfnItem)
+{
+    uint8 status = __real_osal_snv_read_each(firstId, lastId, len, pBuf, pfnItem);
+
+    gapBondHostReadEachs++;
+    if (status == SUCCESS)
+    {
+        gapBondHostReadEachOks++;
+    }
+    return status;
+}
+
+/*
+ *  ======== OSAL ========
+ */
+void *osal_mem_alloc(uint16 size)
+{
+    return ICall_malloc(size);
+}
+
+void osal_mem_free(void *ptr)
+{
+    ICall_free(ptr);
+}
+
+void *osal_memcpy(void *dst, const void GENERIC *src, unsigned int len)
+{
+    return memcpy(dst, src, len);
+}
+
+void *osal_revmemcpy(void *dst, const void GENERIC *src, unsigned int len)
+{
+    uint8 *pDst = dst;
+    const uint8 *pSrc = (const uint8 *)src + len;
+
+    while (len--)
+    {
+        *pDst++ = *--pSrc;
+    }
+    return dst;
+}
+
+void *osal_memdup(const void GENERIC *src, unsigned int len)
+{
+    void *pDst = osal_mem_alloc(len);
+
+    if (pDst != NULL)
+    {
+        memcpy(pDst, src, len);
+    }
+    return pDst;
+}
+
+uint8 osal_memcmp(const void GENERIC *src1, const void GENERIC *src2, unsigned int len)
+{
+    return (memcmp(src1, src2, len) == 0) ? TRUE : FALSE;
+}
+
+void *osal_memset(void *dest, uint8 value, int size)
+{
+    return memset(dest, value, size);
+}
+
+uint8 osal_isbufset(uint8 *buf, uint8 val, uint8 len)
+{
+    while (len--)
+    {
+        if (*buf++ != val)
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+uint8 osal_msg_send(uint8 destination_task, uint8 *msg_ptr)
+{
+    (void)destination_task;
+    (void)msg_ptr;
+    return FAILURE;
+}
+
+uint8 *osal_msg_receive(uint8 task_id)
+{
+    (void)task_id;
+    return NULL;
+}
+
+uint8 osal_msg_deallocate(uint8 *msg_ptr)
+{
+    (void)msg_ptr;
+    return SUCCESS;
+}
+
+uint8 osal_set_event(uint8 task_id, uint32 event_flag)
+{
+    (void)task_id;
+    (void)event_flag;
+    return SUCCESS;
+}
+
+/*
+ *  ======== GAP and SM ========
+ */
+void GAP_RegisterBondMgrCBs(gapBondMgrCBs_t *pCBs)
+{
+    (void)pCBs;
+}
+
+bStatus_t GAP_SetParamValue(uint16_t paramID, uint16_t paramValue)
+{
+    (void)paramID;
+    (void)paramValue;
+    return SUCCESS;
+}
+
+uint8_t GAP_NumActiveConnections(void)
+{
+    return 0;
+}
+
+uint8_t GAP_isPairing(void)
+{
+    return FALSE;
+}
+
+uint8_t *GAP_GetDevAddress(uint8 wantIA)
+{
+    static uint8_t addr[B_ADDR_LEN];
+
+    (void)wantIA;
+    return addr;
+}
+
+uint8_t *GAP_GetIRK(void)
+{
+    static uint8_t irk[KEYLEN];
+
+    return irk;
+}
+
+uint8 *gapGetSRK(void)
+{
+    static uint8_t srk[KEYLEN];
+
+    return srk;
+}
+
+GAP_Addr_Modes_t gapGetDevAddressMode(void)
+{
+    return ADDRMODE_PUBLIC;
+}
+
+bStatus_t GAP_Authenticate(gapAuthParams_t *pParams, gapPairingReq_t *pPairReq)
+{
+    (void)pParams;
+    (void)pPairReq;
+    return SUCCESS;
+}
+
+bStatus_t GAP_TerminateAuth(uint16_t connectionHandle, uint8_t reason)
+{
+    (void)connectionHandle;
+    (void)reason;
+    return SUCCESS;
+}
+
+bStatus_t GAP_TerminateLinkReq(uint16_t connectionHandle, uint8_t reason)
+{
+    (void)connectionHandle;
+    (void)reason;
+    return SUCCESS;
+}
+
+bStatus_t GAP_PasscodeUpdate(uint32_t passcode, uint16_t connectionHandle)
+{
+    (void)passcode;
+    (void)connectionHandle;
+    return SUCCESS;
+}
+
+bStatus_t GAP_SendPeripheralSecurityRequest(uint16_t connectionHandle, uint8_t authReq)
+{
+    (void)connectionHandle;
+    (void)authReq;
+    return SUCCESS;
+}
+
+bStatus_t GAP_Signable(uint16_t connectionHandle, uint8_t authenticated, smSigningInfo_t *pParams)
+{
+    (void)connectionHandle;
+    (void)authenticated;
+    (void)pParams;
+    return SUCCESS;
+}
+
+bStatus_t GAP_Bond(uint16_t connectionHandle, uint8_t authenticated, uint8_t secureConnections,
+                   smSecurityInfo_t *pParams, uint8_t startEncryption)
+{
+    (void)connectionHandle;
+    (void)authenticated;
+    (void)secureConnections;
+    (void)pParams;
+    (void)startEncryption;
+    return SUCCESS;
+}
+
+void SM_RegisterTask(uint8 taskID)
+{
+    (void)taskID;
+}
+
+bStatus_t SM_GetEccKeys(void)
+{
+    return SUCCESS;
+}
+
+bStatus_t SM_GetScConfirmOob(uint8 *publicKey, uint8 *oob, uint8 *pOut)
+{
+    (void)publicKey;
+    (void)oob;
+    (void)pOut;
+    return SUCCESS;
+}
+
+void SM_GenerateRandBuf(uint8 *random, uint8 len)
+{
+    memset(random, 0x5A, len);
+}
+
+void SM_SetAuthenPairingOnlyMode(uint8 state)
+{
+    (void)state;
+}
+
+void SM_SetAllowDebugKeysMode(uint8 state)
+{
+    (void)state;
+}
+
+void SM_SetECCRegenerationCount(uint8 count)
+{
+    (void)count;
+}
+
+/*
+ *  ======== GATT ========
+ */
+void GATT_RegisterClientSecurityCBs(gattClientSecCBs_t *pClientCallbacks)
+{
+    (void)pClientCallbacks;
+}
+
+gattAttribute_t *GATT_FindHandleUUID(uint16 startHandle, uint16 endHandle, const uint8 *pUUID, uint16 len,
+                                     uint16 *pHandle)
+{
+    (void)startHandle;
+    (void)endHandle;
+    (void)pUUID;
+    (void)len;
+    (void)pHandle;
+    return NULL;
+}
+
+gattAttribute_t *GATT_FindNextAttr(gattAttribute_t *pAttr, uint16 endHandle, uint16 service,
+                                   uint16 *pLastHandle)
+{
+    (void)pAttr;
+    (void)endHandle;
+    (void)service;
+    (void)pLastHandle;
+    return NULL;
+}
+
+bStatus_t GATT_ReadUsingCharUUID(uint16 connHandle, attReadByTypeReq_t *pReq, uint8 taskId)
+{
+    (void)connHandle;
+    (void)pReq;
+    (void)taskId;
+    return FAILURE;
+}
+
+bStatus_t GATT_RequestNextTransaction(uint16 connHandle, uint8 taskId)
+{
+    (void)connHandle;
+    (void)taskId;
+    return FAILURE;
+}
+
+void GATT_bm_free(gattMsg_t *pMsg, uint8 opcode)
+{
+    (void)pMsg;
+    (void)opcode;
+}
+
+void GATTServApp_RegisterForMsg(uint8 taskID)
+{
+    (void)taskID;
+}
+
+bStatus_t GATTServApp_SendServiceChangedInd(uint16 connHandle, uint8 taskId)
+{
+    (void)connHandle;
+    (void)taskId;
+    return FAILURE;
+}
+
+bStatus_t GATTServApp_UpdateCharCfg(uint16 connHandle, uint16 attrHandle, uint16 value)
+{
+    (void)connHandle;
+    (void)attrHandle;
+    (void)value;
+    return SUCCESS;
+}
+
+uint8 GATTServApp_ReadAttr(uint16 connHandle, gattAttribute_t *pAttr, uint16 service, uint8 *pValue,
+                           uint16 *pLen, uint16 offset, uint16 maxLen, uint8 method)
+{
+    (void)connHandle;
+    (void)pAttr;
+    (void)service;
+    (void)pValue;
+    (void)pLen;
+    (void)offset;
+    (void)maxLen;
+    (void)method;
+    return FAILURE;
+}
+
+uint16 L2CAP_GetMTU(void)
+{
+    return 23;
+}
+
+/*
+ *  ======== Link database ========
+ */
+linkDBItem_t *linkDB_Find(uint16 connectionHandle)
+{
+    (void)connectionHandle;
+    return NULL;
+}
+
+uint8 linkDB_GetInfo(uint16 connectionHandle, linkDBInfo_t *pInfo)
+{
+    (void)connectionHandle;
+    (void)pInfo;
+    return bleNotConnected;
+}
+
+void linkDB_PerformFunc(pfnPerformFuncCB_t cb)
+{
+    (void)cb;
+}
+
+void linkDB_SecurityModeSCOnly(uint8 state)
+{
+    (void)state;
+}
+
+/*
+ *  ======== HCI and LL ========
+ */
+hciStatus_t HCI_LE_AddAcceptListCmd(uint8 addrType, uint8 *devAddr)
+{
+    (void)addrType;
+    (void)devAddr;
+    return SUCCESS;
+}
+
+hciStatus_t HCI_LE_ClearAcceptListCmd(void)
+{
+    return SUCCESS;
+}
+
+hciStatus_t HCI_LE_AddDeviceToResolvingListCmd(uint8 peerIdAddrType, uint8 *peerIdAddr, uint8 *peerIRK,
+                                               uint8 *localIRK)
+{
+    (void)peerIdAddrType;
+    (void)peerIdAddr;
+    (void)peerIRK;
+    (void)localIRK;
+    return SUCCESS;
+}
+
+hciStatus_t HCI_LE_RemoveDeviceFromResolvingListCmd(uint8 peerIdAddrType, uint8 *peerIdAddr)
+{
+    (void)peerIdAddrType;
+    (void)peerIdAddr;
+    return SUCCESS;
+}
+
+hciStatus_t HCI_LE_ClearResolvingListCmd(void)
+{
+    return SUCCESS;
+}
+
+hciStatus_t HCI_LE_SetPrivacyModeCmd(uint8 peerIdAddrType, uint8 *peerIdAddr, uint8 privacyMode)
+{
+    (void)peerIdAddrType;
+    (void)peerIdAddr;
+    (void)privacyMode;
+    return SUCCESS;
+}
+
+void LL_ENC_ReverseBytes(uint8 *buf, uint8 len)
+{
+    uint8 i;
+
+    for (i = 0; i < len / 2; i++)
+    {
+        uint8 tmp = buf[i];
+
+        buf[i]           = buf[len - 1 - i];
+        buf[len - 1 - i] = tmp;
+    }
+}
+
+uint8 LL_PRIV_ResolveRPA(uint8 *rpa, uint8 *irk)
+{
+    (void)rpa;
+    (void)irk;
+    return FALSE;
+}
+
+uint8 LL_PRIV_FindPeerInRL(rlEntry_t *resolvingList, uint8 idType, uint8 *idAddr)
+{
+    (void)resolvingList;
+    (void)idType;
+    (void)idAddr;
+    return INVALID_RESOLVE_LIST_INDEX;
+}
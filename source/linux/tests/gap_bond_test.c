@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== gap_bond_test.c ========
+ *
+ *  Bond record index of the GAP bond manager: the address and IRK hash
+ *  buckets, the list of empty slots and the LRU list. gapbondmgr.c is
+ *  included so the test can reach its index. Bonds are imported, erased,
+ *  used and read back from NV after a reset in random order, and after each
+ *  step every lookup is checked against a plain model of the bond table.
+ *
+ *  The bond manager runs on the osal_snv wrapper over NVOCMP, with the
+ *  minimal NV API of the stack, and must read its bonds in one
+ *  osal_snv_read_each() pass.
+ */
+
+#include <string.h>
+
+#include <ti/ble5stack_flash/host/gapbondmgr.c>
+
+#include "nvintf.h"
+#include "gap_bond_host.h"
+#include "test_util.h"
+
+#define POOL_PEERS  64
+#define MAX_CHARCFG 4
+#define TASK_ID     1
+
+typedef struct
+{
+    uint8_t addr[B_ADDR_LEN];
+    uint8_t addrType;
+    uint8_t irk[KEYLEN];
+} Peer;
+
+/* Peer bonded in each slot, -1 for an empty slot, and whether its IRK is
+ * in the index */
+static int refPeer[256];
+static uint8_t refHasIrk[256];
+
+/* Slots from least to most recently used */
+static uint8_t refLru[256];
+
+static Peer peers[POOL_PEERS];
+static uint32_t seed = 18;
+
+extern NVINTF_nvFuncts_t nvFptrs;
+
+/*
+ *  ======== osal_snv_read_each ========
+ */
+#define EACH_FIRST 0x20
+#define EACH_LAST  0x2F
+#define EACH_LEN   16
+
+static uint8_t eachSeen[EACH_LAST + 1];
+static uint8_t eachData[EACH_LAST + 1][EACH_LEN];
+static osalSnvLen_t eachLen[EACH_LAST + 1];
+
+static void eachItem(osalSnvId_t id, osalSnvLen_t len, void *pBuf)
+{
+    CHECK((id >= EACH_FIRST) && (id <= EACH_LAST));
+    CHECK(len <= EACH_LEN);
+    CHECK(!eachSeen[id]);
+    CHECK(len == eachLen[id]);
+    CHECK(memcmp(pBuf, eachData[id], len) == 0);
+    eachSeen[id] = 1;
+}
+
+/* Every item of the range is read once, with its last value */
+static void testReadEach(void)
+{
+    uint8_t buf[EACH_LEN + 8];
+    uint8_t other = 0xA5;
+    int i;
+    int n;
+
+    CHECK(nvFptrs.eraseNV() == NVINTF_SUCCESS);
+    memset(eachLen, 0, sizeof(eachLen));
+    for (n = 0; n < 200; n++)
+    {
+        osalSnvId_t id   = EACH_FIRST + (testRand(&seed) % (EACH_LAST - EACH_FIRST + 1));
+        osalSnvLen_t len = 1 + (testRand(&seed) % (EACH_LEN + 4));
+
+        for (i = 0; i < len; i++)
+        {
+            buf[i] = testRand(&seed);
+        }
+        CHECK(osal_snv_write(id, len, buf) == SUCCESS);
+        eachLen[id] = len;
+        memcpy(eachData[id], buf, (len <= EACH_LEN) ? len : EACH_LEN);
+    }
+    CHECK(osal_snv_write(EACH_FIRST - 1, 1, &other) == SUCCESS);
+    CHECK(osal_snv_write(EACH_LAST + 1, 1, &other) == SUCCESS);
+
+    memset(eachSeen, 0, sizeof(eachSeen));
+    CHECK(osal_snv_read_each(EACH_FIRST, EACH_LAST, EACH_LEN, buf, eachItem) == SUCCESS);
+    for (i = EACH_FIRST; i <= EACH_LAST; i++)
+    {
+        /* Items longer than the buffer are skipped */
+        CHECK(eachSeen[i] == ((eachLen[i] != 0) && (eachLen[i] <= EACH_LEN)));
+    }
+}
+
+/*
+ *  ======== Bond index ========
+ */
+static void makePeers(void)
+{
+    int p;
+    int i;
+
+    for (p = 0; p < POOL_PEERS; p++)
+    {
+        for (i = 0; i < B_ADDR_LEN; i++)
+        {
+            peers[p].addr[i] = testRand(&seed);
+        }
+        peers[p].addrType = testRand(&seed) % 2;
+        for (i = 0; i < KEYLEN; i++)
+        {
+            peers[p].irk[i] = testRand(&seed);
+        }
+
+        /* Identity address only peers, and peers sharing an address with
+         * another address type */
+        if ((p % 7) == 0)
+        {
+            memset(peers[p].irk, 0, KEYLEN);
+        }
+        if ((p % 11) == 1)
+        {
+            memcpy(peers[p].addr, peers[p - 1].addr, B_ADDR_LEN);
+            peers[p].addrType = !peers[p - 1].addrType;
+        }
+    }
+}
+
+/* Reset: the bond manager builds its RAM shadow again from NV */
+static void bondReset(uint8_t maxBonds)
+{
+    uint8_t on = TRUE;
+
+    if (bonds != NULL)
+    {
+        osal_mem_free(bonds);
+        osal_mem_free(bondsToDelete);
+        osal_mem_free(gapBond_lruBondList);
+        osal_mem_free(bondIdxTbl);
+    }
+
+    gapBondHostBondReads   = 0;
+    gapBondHostReadEachs   = 0;
+    gapBondHostReadEachOks = 0;
+    GAPBondMgr_Init(TASK_ID, maxBonds, MAX_CHARCFG, FALSE, FALSE);
+    CHECK(GAPBondMgr_SetParameter(GAPBOND_LRU_BOND_REPLACEMENT, sizeof(on), &on) == SUCCESS);
+
+    /* One pass through NV, no record read one by one */
+    CHECK(gapBondHostReadEachs == 1);
+    CHECK(gapBondHostReadEachOks == 1);
+    CHECK(gapBondHostBondReads == 0);
+}
+
+static void refUse(uint8_t slot)
+{
+    int i;
+
+    for (i = 0; refLru[i] != slot; i++)
+    {
+    }
+    for (; i < gapBond_maxBonds - 1; i++)
+    {
+        refLru[i] = refLru[i + 1];
+    }
+    refLru[gapBond_maxBonds - 1] = slot;
+}
+
+static int refFindPeer(int p)
+{
+    int i;
+
+    for (i = 0; i < gapBond_maxBonds; i++)
+    {
+        if (refPeer[i] == p)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void bondImport(int p)
+{
+    gapBondRec_t rec;
+    int slot = refFindPeer(p);
+    uint8_t withIrk = testRand(&seed) % 2;
+    int i;
+
+    memcpy(rec.addr, peers[p].addr, B_ADDR_LEN);
+    rec.addrType   = peers[p].addrType;
+    rec.stateFlags = GAP_BONDED_STATE_AUTHENTICATED;
+    CHECK(gapBondMgrImportBond(&rec, NULL, NULL, withIrk ? peers[p].irk : NULL, NULL, 0, NULL) == SUCCESS);
+
+    /* Same slot for a known peer, else the lowest empty one, else the least
+     * recently used one */
+    if (slot < 0)
+    {
+        for (i = 0; (i < gapBond_maxBonds) && (refPeer[i] >= 0); i++)
+        {
+        }
+        slot = (i < gapBond_maxBonds) ? i : refLru[0];
+        refPeer[slot]   = p;
+        refHasIrk[slot] = FALSE;
+    }
+    if (withIrk && gapBondIsIrkValid(peers[p].irk))
+    {
+        refHasIrk[slot] = TRUE;
+    }
+    refUse(slot);
+}
+
+static void bondErase(int slot)
+{
+    uint8_t param[1 + B_ADDR_LEN];
+    const Peer *pPeer = &peers[refPeer[slot]];
+
+    param[0] = pPeer->addrType;
+    osal_revmemcpy(&param[1], pPeer->addr, B_ADDR_LEN);
+    CHECK(GAPBondMgr_SetParameter(GAPBOND_ERASE_SINGLEBOND, sizeof(param), param) == SUCCESS);
+    refPeer[slot]   = -1;
+    refHasIrk[slot] = FALSE;
+}
+
+static void checkBonds(void)
+{
+    uint8_t seen[256];
+    uint8_t lru[256];
+    uint8_t count = 0;
+    uint8_t irks  = 0;
+    uint8_t total;
+    uint8_t idx;
+    int p;
+    int i;
+
+    /* Lookups by address and by IRK */
+    for (p = 0; p < POOL_PEERS; p++)
+    {
+        int slot = refFindPeer(p);
+        uint8_t found;
+
+        if (GAPBondMgr_FindAddr(peers[p].addr, peers[p].addrType, &found, NULL, NULL) == SUCCESS)
+        {
+            CHECK(found == slot);
+        }
+        else
+        {
+            CHECK(slot < 0);
+        }
+
+        found = gapBondFindIrk(peers[p].irk);
+        CHECK(found == (((slot >= 0) && refHasIrk[slot]) ? slot : GAP_BOND_IDX_NONE));
+    }
+
+    /* Each slot is in its address bucket or in the empty list, and slots
+     * with an IRK are in their IRK bucket */
+    memset(seen, 0, sizeof(seen));
+    for (i = 0; i <= gapBond_hashMask; i++)
+    {
+        for (idx = bondAddrHash[i]; idx != GAP_BOND_IDX_NONE; idx = bondIdxTbl[idx].addrNext)
+        {
+            CHECK(refPeer[idx] >= 0);
+            CHECK(gapBondHashAddr(bonds[idx].addr, bonds[idx].addrType) == i);
+            CHECK(!seen[idx]);
+            seen[idx] = 1;
+            count++;
+        }
+        for (idx = bondIrkHash[i]; idx != GAP_BOND_IDX_NONE; idx = bondIdxTbl[idx].irkNext)
+        {
+            CHECK(refHasIrk[idx]);
+            CHECK(gapBondHashIrk(bondIdxTbl[idx].irk) == i);
+            CHECK(++irks <= gapBond_maxBonds);
+        }
+    }
+    for (idx = gapBond_emptyHead; idx != GAP_BOND_IDX_NONE; idx = bondIdxTbl[idx].addrNext)
+    {
+        CHECK(refPeer[idx] < 0);
+        CHECK(!seen[idx]);
+        seen[idx] = 1;
+    }
+    for (i = 0; i < gapBond_maxBonds; i++)
+    {
+        CHECK(seen[i]);
+    }
+    CHECK(GAPBondMgr_GetParameter(GAPBOND_BOND_COUNT, &total) == SUCCESS);
+    CHECK(total == count);
+
+    /* LRU order, in RAM both ways and in NV */
+    CHECK(gapBondMgrGetLruBondIndex() == refLru[0]);
+    CHECK(gapBond_lruTail == refLru[gapBond_maxBonds - 1]);
+    for (i = 0, idx = gapBond_lruHead; i < gapBond_maxBonds; i++, idx = bondIdxTbl[idx].lruNext)
+    {
+        CHECK(idx == refLru[i]);
+    }
+    CHECK(idx == GAP_BOND_IDX_NONE);
+    for (i = gapBond_maxBonds - 1, idx = gapBond_lruTail; i >= 0; i--, idx = bondIdxTbl[idx].lruPrev)
+    {
+        CHECK(idx == refLru[i]);
+    }
+    if (osal_snv_read(BLE_LRU_BOND_LIST, gapBond_maxBonds, lru) == SUCCESS)
+    {
+        CHECK(memcmp(lru, refLru, gapBond_maxBonds) == 0);
+    }
+}
+
+static void testBondIndex(uint8_t maxBonds, int steps)
+{
+    int i;
+    int n;
+
+    CHECK(nvFptrs.eraseNV() == NVINTF_SUCCESS);
+    for (i = 0; i < maxBonds; i++)
+    {
+        refPeer[i]   = -1;
+        refHasIrk[i] = FALSE;
+
+        /* Without a list in NV, slot 0 is the most recently used */
+        refLru[i] = maxBonds - 1 - i;
+    }
+
+    bondReset(maxBonds);
+    checkBonds();
+    for (n = 0; n < steps; n++)
+    {
+        uint32_t op = testRand(&seed) % 16;
+        int slot    = testRand(&seed) % maxBonds;
+
+        if (op < 8)
+        {
+            bondImport(testRand(&seed) % POOL_PEERS);
+        }
+        else if ((op < 11) && (refPeer[slot] >= 0))
+        {
+            bondErase(slot);
+        }
+        else if (op < 14)
+        {
+            gapBondMgrUpdateLruBondList(slot);
+            refUse(slot);
+        }
+        else if (op == 14)
+        {
+            bondReset(maxBonds);
+        }
+        checkBonds();
+    }
+}
+
+int main(void)
+{
+    static const uint8_t sizes[] = {1, 2, 3, 5, 8, 10, 16, 20};
+    int i;
+
+    CHECK(osal_snv_init() == SUCCESS);
+    testReadEach();
+
+    makePeers();
+    for (i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        testBondIndex(sizes[i], 600);
+    }
+
+    printf("PASS\n");
+    return 0;
+}
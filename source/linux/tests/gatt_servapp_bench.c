@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== gatt_servapp_bench.c ========
+ *
+ *  Cost of the GATTServApp lookups profiles make on read, write and notify,
+ *  built with and without the attribute and CCC indexes. A stream of CCC reads
+ *  and writes, notifications and attribute lookups runs against a database
+ *  of GATT_HOST_SERVICES services of GATT_HOST_CHARS characteristics, with
+ *  GATT_HOST_CONNS clients. Each request kind is timed on its own, with
+ *  requests spread evenly over all the characteristics and with most of them
+ *  on a few hot characteristics, as for a measurement notified periodically.
+ */
+
+#include <stdio.h>
+
+#include "gatt_servapp_host.h"
+#include "test_util.h"
+
+#define BENCH_REQUESTS 200000
+#define BENCH_KINDS    4
+#define BENCH_HOT      4
+/* Percentage of the requests on the hot characteristics */
+#define BENCH_HOT_PCT  90
+
+#if defined(GATT_ATTR_INDEX_SIZE) && (GATT_ATTR_INDEX_SIZE == 0)
+    #define BENCH_LOOKUP "table scan"
+#else
+    #define BENCH_LOOKUP "attribute and CCC index"
+#endif
+
+typedef struct
+{
+    uint8 service;
+    uint8 charIdx;
+    uint8 conn;
+} BenchRequest;
+
+static const char *const kindNames[BENCH_KINDS] = {"CCC read", "CCC write", "notify", "find attribute"};
+
+static BenchRequest requests[BENCH_REQUESTS];
+static BenchRequest hotRequests[BENCH_REQUESTS];
+static uint32_t seed = 0x7F4A7C15U;
+
+static void runRequest(int kind, const BenchRequest *pReq)
+{
+    GattHostService *pService = &gattHostDb[pReq->service];
+    uint8 value[2];
+
+    switch (kind)
+    {
+        case 0:
+            (void)GATTServApp_ReadCharCfg(pReq->conn, pService->ccc[pReq->charIdx]);
+            break;
+        case 1:
+            value[0] = 1 + (pReq->conn & 1);
+            value[1] = 0;
+            CHECK(GATTServApp_ProcessCCCWriteReq(pReq->conn, &pService->attrs[GATT_HOST_CCC_IDX(pReq->charIdx)],
+                                                 value, 2, 0,
+                                                 GATT_CLIENT_CFG_NOTIFY | GATT_CLIENT_CFG_INDICATE) == SUCCESS);
+            break;
+        case 2:
+            CHECK(GATTServApp_ProcessCharCfg(pService->ccc[pReq->charIdx], pService->values[pReq->charIdx], FALSE,
+                                             pService->attrs, GATT_HOST_SERVICE_ATTRS, 0,
+                                             gattHostReadAttrCB) == SUCCESS);
+            break;
+        default:
+            CHECK(GATTServApp_FindAttr(pService->attrs, GATT_HOST_SERVICE_ATTRS,
+                                       pService->values[pReq->charIdx]) != NULL);
+            break;
+    }
+}
+
+static double timeRequests(int kind, const BenchRequest *pReqs)
+{
+    uint64_t start = testNowNs();
+    int i;
+
+    for (i = 0; i < BENCH_REQUESTS; i++)
+    {
+        runRequest(kind, &pReqs[i]);
+    }
+    return (double)(testNowNs() - start) / BENCH_REQUESTS;
+}
+
+int main(void)
+{
+    BenchRequest hot[BENCH_HOT];
+    double uniformNs;
+    double hotNs;
+    int kind;
+    int i;
+
+    gattHostInitDb();
+    for (i = 0; i < BENCH_HOT; i++)
+    {
+        hot[i].service = testRand(&seed) % GATT_HOST_SERVICES;
+        hot[i].charIdx = testRand(&seed) % GATT_HOST_CHARS;
+    }
+    for (i = 0; i < BENCH_REQUESTS; i++)
+    {
+        requests[i].service = testRand(&seed) % GATT_HOST_SERVICES;
+        requests[i].charIdx = testRand(&seed) % GATT_HOST_CHARS;
+        requests[i].conn    = testRand(&seed) % GATT_HOST_CONNS;
+
+        hotRequests[i] = requests[i];
+        if ((testRand(&seed) % 100) < BENCH_HOT_PCT)
+        {
+            hotRequests[i].service = hot[i % BENCH_HOT].service;
+            hotRequests[i].charIdx = hot[i % BENCH_HOT].charIdx;
+        }
+    }
+
+    // Every client subscribes to every characteristic first
+    for (i = 0; i < BENCH_REQUESTS; i++)
+    {
+        runRequest(1, &requests[i]);
+    }
+
+    printf("GATTServApp, %d attributes, %d clients, %s\n", GATT_HOST_SERVICES * GATT_HOST_SERVICE_ATTRS,
+           GATT_HOST_CONNS, BENCH_LOOKUP);
+    for (kind = 0; kind < BENCH_KINDS; kind++)
+    {
+        uniformNs = timeRequests(kind, requests);
+        hotNs     = timeRequests(kind, hotRequests);
+        printf("  %-14s uniform %6.1f ns, hot %6.1f ns\n", kindNames[kind], uniformNs, hotNs);
+    }
+    CHECK(gattHostBlocks == 0);
+
+    return 0;
+}
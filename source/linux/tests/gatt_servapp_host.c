@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== gatt_servapp_host.c ========
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "gatt_servapp_host.h"
+#include "test_util.h"
+
+/* ATT_MTU of the connections, a notification carries ATT_MTU - 3 octets */
+#define GATT_HOST_MTU 23
+
+/* Declared by gatt_uuid.h, defined in the stack library */
+const uint8 primaryServiceUUID[ATT_BT_UUID_SIZE] = {LO_UINT16(GATT_PRIMARY_SERVICE_UUID),
+                                                   HI_UINT16(GATT_PRIMARY_SERVICE_UUID)};
+const uint8 characterUUID[ATT_BT_UUID_SIZE] = {LO_UINT16(GATT_CHARACTER_UUID), HI_UINT16(GATT_CHARACTER_UUID)};
+const uint8 clientCharCfgUUID[ATT_BT_UUID_SIZE] = {LO_UINT16(GATT_CLIENT_CHAR_CFG_UUID),
+                                                  HI_UINT16(GATT_CLIENT_CHAR_CFG_UUID)};
+
+static const uint8 valueUUID[ATT_BT_UUID_SIZE] = {0xF1, 0xFF};
+
+uint8 linkDBNumConns = GATT_HOST_CONNS;
+
+GattHostService gattHostDb[GATT_HOST_SERVICES];
+uint32_t gattHostNotis[GATT_HOST_HANDLES];
+uint32_t gattHostInds[GATT_HOST_HANDLES];
+uint16 gattHostLastHandle;
+int32_t gattHostBlocks;
+
+static void setAttr(gattAttribute_t *pAttr, const uint8 *pUUID, uint8 permissions, uint16 handle, uint8 *pValue)
+{
+    gattAttribute_t attr = {{ATT_BT_UUID_SIZE, pUUID}, permissions, handle, pValue};
+
+    /* pValue is const in gattAttribute_t */
+    memcpy(pAttr, &attr, sizeof(attr));
+}
+
+void gattHostInitDb(void)
+{
+    GattHostService *pService;
+    uint16 handle = 1;
+    int s;
+    int c;
+
+    for (s = 0; s < GATT_HOST_SERVICES; s++)
+    {
+        pService = &gattHostDb[s];
+        pService->type.len  = ATT_BT_UUID_SIZE;
+        pService->type.uuid = valueUUID;
+        setAttr(&pService->attrs[0], primaryServiceUUID, GATT_PERMIT_READ, handle++, (uint8 *)&pService->type);
+        for (c = 0; c < GATT_HOST_CHARS; c++)
+        {
+            pService->props[c]  = GATT_PROP_READ | GATT_PROP_NOTIFY | GATT_PROP_INDICATE;
+            pService->cccTbl[c] = pService->ccc[c];
+            CHECK((uintptr_t)pService->ccc[c] <= UINT32_MAX);
+            GATTServApp_InitCharCfg(LINKDB_CONNHANDLE_INVALID, pService->ccc[c]);
+
+            setAttr(&pService->attrs[GATT_HOST_VALUE_IDX(c) - 1], characterUUID, GATT_PERMIT_READ, handle++,
+                    &pService->props[c]);
+            setAttr(&pService->attrs[GATT_HOST_VALUE_IDX(c)], valueUUID, GATT_PERMIT_READ, handle++,
+                    pService->values[c]);
+            setAttr(&pService->attrs[GATT_HOST_CCC_IDX(c)], clientCharCfgUUID, GATT_PERMIT_READ | GATT_PERMIT_WRITE,
+                    handle++, (uint8 *)&pService->cccTbl[c]);
+        }
+
+        /* As GATTServApp_RegisterService() does once the stack assigned the handles */
+        GATTServApp_IndexService(pService->attrs, GATT_HOST_SERVICE_ATTRS);
+    }
+}
+
+bStatus_t gattHostReadAttrCB(uint16 connHandle, gattAttribute_t *pAttr, uint8 *pValue, uint16 *pLen,
+                             uint16 offset, uint16 maxLen, uint8 method)
+{
+    CHECK(maxLen >= GATT_HOST_VALUE_LEN);
+    memcpy(pValue, pAttr->pValue, GATT_HOST_VALUE_LEN);
+    *pLen = GATT_HOST_VALUE_LEN;
+    return SUCCESS;
+}
+
+void *GATT_bm_alloc(uint16 connHandle, uint8 opcode, uint16 size, uint16 *pSizeAlloc)
+{
+    uint16 len = (size < GATT_HOST_MTU - 3) ? size : GATT_HOST_MTU - 3;
+    void *ptr  = malloc(len);
+
+    if (ptr != NULL)
+    {
+        gattHostBlocks++;
+        *pSizeAlloc = len;
+    }
+    return ptr;
+}
+
+void GATT_bm_free(gattMsg_t *pMsg, uint8 opcode)
+{
+    attHandleValueNoti_t *pNoti = (attHandleValueNoti_t *)pMsg;
+
+    CHECK(opcode == ATT_HANDLE_VALUE_NOTI);
+    if (pNoti->pValue != NULL)
+    {
+        gattHostBlocks--;
+        free(pNoti->pValue);
+        pNoti->pValue = NULL;
+    }
+}
+
+/* The stack frees the value of a notification or indication it accepted */
+bStatus_t GATT_Notification(uint16 connHandle, attHandleValueNoti_t *pNoti, uint8 authenticated)
+{
+    CHECK(connHandle < GATT_HOST_HANDLES);
+    CHECK(pNoti->len == GATT_HOST_VALUE_LEN);
+    gattHostNotis[connHandle]++;
+    gattHostLastHandle = pNoti->handle;
+    GATT_bm_free((gattMsg_t *)pNoti, ATT_HANDLE_VALUE_NOTI);
+    return SUCCESS;
+}
+
+bStatus_t GATT_Indication(uint16 connHandle, attHandleValueInd_t *pInd, uint8 authenticated, uint8 taskId)
+{
+    CHECK(connHandle < GATT_HOST_HANDLES);
+    CHECK(pInd->len == GATT_HOST_VALUE_LEN);
+    gattHostInds[connHandle]++;
+    gattHostLastHandle = pInd->handle;
+    GATT_bm_free((gattMsg_t *)pInd, ATT_HANDLE_VALUE_NOTI);
+    return SUCCESS;
+}
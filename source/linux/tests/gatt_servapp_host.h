@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== gatt_servapp_host.h ========
+ *
+ *  GATT database and GATT stubs of the GATTServApp host tests, see
+ *  gatt_servapp_host.c. The database holds GATT_HOST_SERVICES services of
+ *  GATT_HOST_CHARS characteristics, each with a declaration, a value and a
+ *  CCC. Notifications and indications are counted per connection.
+ *
+ *  A CCC value holds a 32-bit pointer to its table (PTR_TYPE of
+ *  gattservapp.h), so the programs are linked without PIE and the database
+ *  is static, below 4 GB.
+ */
+
+#ifndef ti_linux_tests_gatt_servapp_host__include
+#define ti_linux_tests_gatt_servapp_host__include
+
+#include <stdint.h>
+
+#include "icall.h"
+#include "bcomdef.h"
+#include "icall_ble_api.h"
+
+/* linkDBNumConns, and the connection handles the tests use */
+#define GATT_HOST_CONNS         8
+#define GATT_HOST_HANDLES       (2 * GATT_HOST_CONNS)
+#define GATT_HOST_SERVICES      4
+#define GATT_HOST_CHARS         10
+#define GATT_HOST_SERVICE_ATTRS (1 + (3 * GATT_HOST_CHARS))
+
+/* Attribute index of the value and of the CCC of characteristic c */
+#define GATT_HOST_VALUE_IDX(c)  (2 + (3 * (c)))
+#define GATT_HOST_CCC_IDX(c)    (3 + (3 * (c)))
+
+/* Value length returned by the read callback */
+#define GATT_HOST_VALUE_LEN     2
+
+typedef struct
+{
+    gattAttribute_t attrs[GATT_HOST_SERVICE_ATTRS];
+    gattAttrType_t type;
+    uint8 props[GATT_HOST_CHARS];
+    uint8 values[GATT_HOST_CHARS][GATT_HOST_VALUE_LEN];
+    /* Values of the CCC attributes, as the profiles keep them */
+    gattCharCfg_t *cccTbl[GATT_HOST_CHARS];
+    gattCharCfg_t ccc[GATT_HOST_CHARS][GATT_HOST_CONNS];
+} GattHostService;
+
+extern GattHostService gattHostDb[GATT_HOST_SERVICES];
+
+/* Notifications and indications sent on each connection */
+extern uint32_t gattHostNotis[GATT_HOST_HANDLES];
+extern uint32_t gattHostInds[GATT_HOST_HANDLES];
+
+/* Attribute handle of the last notification or indication */
+extern uint16 gattHostLastHandle;
+
+/* Buffers from GATT_bm_alloc() not freed yet */
+extern int32_t gattHostBlocks;
+
+/* Build the database, handles are numbered from 1, clear the CCCs and
+ * register the services with the GATTServApp indexes */
+extern void gattHostInitDb(void);
+
+/* Read callback of the services, returns the value of the attribute */
+extern bStatus_t gattHostReadAttrCB(uint16 connHandle, gattAttribute_t *pAttr, uint8 *pValue, uint16 *pLen,
+                                    uint16 offset, uint16 maxLen, uint8 method);
+
+#endif /* ti_linux_tests_gatt_servapp_host__include */
@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== gatt_servapp_test.c ========
+ *
+ *  Host test of the GATTServApp attribute and CCC lookups, built with the
+ *  attribute and CCC indexes, with indexes too small for the database, and
+ *  without them. Random connections, disconnections, CCC reads and writes,
+ *  notifications and attribute lookups are checked against a model of the
+ *  CCC of every client.
+ *
+ *  Some disconnections leave the CCC entries of the client, so that the
+ *  tables fill up. Services are deregistered and registered again, and CCC
+ *  entries are moved and removed behind GATTServApp, as the stack does.
+ *  gattservapp_util.c is included so the test can check that every index
+ *  entry is reachable and belongs to a registered service.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gatt_servapp_host.h"
+
+#include <ti/ble5stack_flash/host/gattservapp_util.c>
+
+#include "test_util.h"
+
+#define MODEL_OPS   200000
+/* Operations between two checks of the indexes */
+#define CHECK_OPS   8
+#define VALID_CFG   (GATT_CLIENT_CFG_NOTIFY | GATT_CLIENT_CFG_INDICATE)
+
+static uint32_t seed = 0x9E3779B9U;
+
+/* CCC of each client, and whether it has an entry in the table */
+static uint16 model[GATT_HOST_SERVICES][GATT_HOST_CHARS][GATT_HOST_HANDLES];
+static bool modelUsed[GATT_HOST_SERVICES][GATT_HOST_CHARS][GATT_HOST_HANDLES];
+static bool connected[GATT_HOST_HANDLES];
+static int numConnected;
+static bool registered[GATT_HOST_SERVICES];
+
+/* Copy of a service, as after it was removed and added again elsewhere */
+static gattAttribute_t movedAttrs[GATT_HOST_SERVICE_ATTRS];
+
+static int usedEntries(int s, int c)
+{
+    int count = 0;
+    int h;
+
+    for (h = 0; h < GATT_HOST_HANDLES; h++)
+    {
+        count += modelUsed[s][c][h];
+    }
+    return count;
+}
+
+static void connect(void)
+{
+    uint16 h = testRand(&seed) % GATT_HOST_HANDLES;
+
+    if (!connected[h] && (numConnected < GATT_HOST_CONNS))
+    {
+        connected[h] = true;
+        numConnected++;
+    }
+}
+
+static void disconnect(uint16 h)
+{
+    int s;
+    int c;
+
+    connected[h] = false;
+    numConnected--;
+    if ((testRand(&seed) % 8) == 0)
+    {
+        // Entries left behind
+        return;
+    }
+    for (s = 0; s < GATT_HOST_SERVICES; s++)
+    {
+        for (c = 0; c < GATT_HOST_CHARS; c++)
+        {
+            GATTServApp_InitCharCfg(h, gattHostDb[s].ccc[c]);
+            model[s][c][h]     = GATT_CFG_NO_OPERATION;
+            modelUsed[s][c][h] = false;
+        }
+    }
+}
+
+static void writeCcc(uint16 h, int s, int c)
+{
+    static const uint16 values[] = {0, 0, 1, 1, 2, 3, 4, 0x8001};
+    uint16 value = values[testRand(&seed) % (sizeof(values) / sizeof(values[0]))];
+    uint16 len = ((testRand(&seed) % 16) == 0) ? 1 + 2 * (testRand(&seed) % 2) : 2;
+    uint16 offset = ((testRand(&seed) % 16) == 0) ? 1 : 0;
+    uint8 buf[3] = {LO_UINT16(value), HI_UINT16(value), 0};
+    bStatus_t expected = SUCCESS;
+    bStatus_t status;
+
+    status = GATTServApp_ProcessCCCWriteReq(h, &gattHostDb[s].attrs[GATT_HOST_CCC_IDX(c)], buf, len, offset,
+                                            VALID_CFG);
+    if (offset != 0)
+    {
+        expected = ATT_ERR_ATTR_NOT_LONG;
+    }
+    else if (len != 2)
+    {
+        expected = ATT_ERR_INVALID_VALUE_SIZE;
+    }
+    else if ((value & ~VALID_CFG) != 0)
+    {
+        expected = ATT_ERR_INVALID_VALUE;
+    }
+    else if (value != model[s][c][h])
+    {
+        if (!modelUsed[s][c][h] && (usedEntries(s, c) == GATT_HOST_CONNS))
+        {
+            expected = ATT_ERR_INSUFFICIENT_RESOURCES;
+        }
+        else
+        {
+            model[s][c][h]     = value;
+            modelUsed[s][c][h] = true;
+        }
+    }
+    CHECK(status == expected);
+}
+
+static void notify(int s, int c)
+{
+    uint32_t notis[GATT_HOST_HANDLES];
+    uint32_t inds[GATT_HOST_HANDLES];
+    bool sent = false;
+    int h;
+
+    memcpy(notis, gattHostNotis, sizeof(notis));
+    memcpy(inds, gattHostInds, sizeof(inds));
+    gattHostLastHandle = 0;
+
+    CHECK(GATTServApp_ProcessCharCfg(gattHostDb[s].ccc[c], gattHostDb[s].values[c], FALSE, gattHostDb[s].attrs,
+                                     GATT_HOST_SERVICE_ATTRS, 0, gattHostReadAttrCB) == SUCCESS);
+    for (h = 0; h < GATT_HOST_HANDLES; h++)
+    {
+        uint16 value = modelUsed[s][c][h] ? model[s][c][h] : 0;
+
+        CHECK(gattHostNotis[h] - notis[h] == ((value & GATT_CLIENT_CFG_NOTIFY) ? 1 : 0));
+        CHECK(gattHostInds[h] - inds[h] == ((value & GATT_CLIENT_CFG_INDICATE) ? 1 : 0));
+        sent |= (value != 0);
+    }
+    if (sent)
+    {
+        CHECK(gattHostLastHandle == gattHostDb[s].attrs[GATT_HOST_VALUE_IDX(c)].handle);
+    }
+    CHECK(gattHostBlocks == 0);
+}
+
+static int serviceOf(const gattAttribute_t *pAttr)
+{
+    int s;
+
+    for (s = 0; s < GATT_HOST_SERVICES; s++)
+    {
+        if ((pAttr >= gattHostDb[s].attrs) && (pAttr < &gattHostDb[s].attrs[GATT_HOST_SERVICE_ATTRS]))
+        {
+            return s;
+        }
+    }
+    return -1;
+}
+
+static void checkIndex(void)
+{
+#if GATT_SERVICE_INDEX
+    uint16 count;
+    uint16 slot;
+#endif
+#if (GATT_ATTR_INDEX_SIZE > 0)
+    int s;
+    int i;
+#endif
+
+#if (GATT_ATTR_INDEX_SIZE > 0)
+    count = 0;
+    for (slot = 0; slot < GATT_ATTR_INDEX_SIZE; slot++)
+    {
+        gattAttrIndexItem_t *pItem = &gattAttrIndex[slot];
+
+        if (pItem->pValue != NULL)
+        {
+            count++;
+            CHECK(gattServApp_FindAttrIndex(pItem->pValue) == slot);
+            CHECK(pItem->pAttr->pValue == pItem->pValue);
+            s = serviceOf(pItem->pAttr);
+            CHECK((s >= 0) && registered[s]);
+        }
+    }
+    CHECK(count == gattAttrIndexCount);
+
+    // With room for the whole database, every record is found in the index
+    if ((GATT_ATTR_INDEX_SIZE > (GATT_HOST_SERVICES * GATT_HOST_SERVICE_ATTRS)) &&
+        (GATT_INDEX_MAX_SERVICES >= GATT_HOST_SERVICES))
+    {
+        for (s = 0; s < GATT_HOST_SERVICES; s++)
+        {
+            for (i = 0; registered[s] && (i < GATT_HOST_SERVICE_ATTRS); i++)
+            {
+                slot = gattServApp_FindAttrIndex(gattHostDb[s].attrs[i].pValue);
+                CHECK((slot < GATT_ATTR_INDEX_SIZE) && (gattAttrIndex[slot].pAttr == &gattHostDb[s].attrs[i]));
+            }
+        }
+    }
+#endif
+
+#if (GATT_CCC_INDEX_SIZE > 0)
+    count = 0;
+    for (slot = 0; slot < GATT_CCC_INDEX_SIZE; slot++)
+    {
+        gattCccIndexItem_t *pItem = &gattCccIndex[slot];
+
+        if (pItem->pTbl != NULL)
+        {
+            count++;
+            CHECK(gattServApp_FindCccIndex(pItem->connHandle, pItem->pTbl) == slot);
+            CHECK(pItem->connHandle != LINKDB_CONNHANDLE_INVALID);
+            CHECK(pItem->idx < GATT_HOST_CONNS);
+        }
+    }
+    CHECK(count == gattCccIndexCount);
+#endif
+}
+
+static void reregister(int s)
+{
+    gattAttribute_t *pAttrs = gattHostDb[s].attrs;
+#if (GATT_CCC_INDEX_SIZE > 0)
+    int slot;
+#endif
+
+    // As GATTServApp_DeregisterService() and GATTServApp_RegisterService() do
+    if (registered[s])
+    {
+        GATTServApp_UnindexService(pAttrs[0].handle);
+
+#if (GATT_CCC_INDEX_SIZE > 0)
+        // The CCC entries of the service are dropped with it, if it was tracked
+        for (slot = 0; slot < GATT_CCC_INDEX_SIZE; slot++)
+        {
+            gattCharCfg_t *pTbl = gattCccIndex[slot].pTbl;
+
+            CHECK((GATT_INDEX_MAX_SERVICES < GATT_HOST_SERVICES) || (pTbl == NULL) ||
+                  (pTbl < gattHostDb[s].ccc[0]) || (pTbl > gattHostDb[s].ccc[GATT_HOST_CHARS - 1]));
+        }
+#endif
+    }
+    else
+    {
+        GATTServApp_IndexService(pAttrs, GATT_HOST_SERVICE_ATTRS);
+    }
+    registered[s] = !registered[s];
+}
+
+static void stackChange(int s, int c)
+{
+    gattCharCfg_t *pTbl = gattHostDb[s].ccc[c];
+    int i = testRand(&seed) % GATT_HOST_CONNS;
+    int j = testRand(&seed) % GATT_HOST_CONNS;
+    gattCharCfg_t item;
+
+    if (testRand(&seed) % 2)
+    {
+        // Entries swapped
+        item    = pTbl[i];
+        pTbl[i] = pTbl[j];
+        pTbl[j] = item;
+    }
+    else if (pTbl[i].connHandle != LINKDB_CONNHANDLE_INVALID)
+    {
+        // Entry removed
+        model[s][c][pTbl[i].connHandle]     = GATT_CFG_NO_OPERATION;
+        modelUsed[s][c][pTbl[i].connHandle] = false;
+        pTbl[i].connHandle                  = LINKDB_CONNHANDLE_INVALID;
+        pTbl[i].value                       = GATT_CFG_NO_OPERATION;
+    }
+}
+
+static void findAttr(int s)
+{
+    gattAttribute_t *pAttrs = gattHostDb[s].attrs;
+    int other = (s + 1 + (testRand(&seed) % (GATT_HOST_SERVICES - 1))) % GATT_HOST_SERVICES;
+    int idx = testRand(&seed) % GATT_HOST_SERVICE_ATTRS;
+
+    CHECK(GATTServApp_FindAttr(pAttrs, GATT_HOST_SERVICE_ATTRS, pAttrs[idx].pValue) == &pAttrs[idx]);
+
+    // Not in the table, or beyond the number of attributes given
+    CHECK(GATTServApp_FindAttr(gattHostDb[other].attrs, GATT_HOST_SERVICE_ATTRS, pAttrs[idx].pValue) == NULL);
+    CHECK(GATTServApp_FindAttr(pAttrs, idx, pAttrs[idx].pValue) == NULL);
+
+    // The same values in another table
+    memcpy(movedAttrs, pAttrs, sizeof(movedAttrs));
+    CHECK(GATTServApp_FindAttr(movedAttrs, GATT_HOST_SERVICE_ATTRS, pAttrs[idx].pValue) == &movedAttrs[idx]);
+    CHECK(GATTServApp_FindAttr(pAttrs, GATT_HOST_SERVICE_ATTRS, pAttrs[idx].pValue) == &pAttrs[idx]);
+}
+
+int main(void)
+{
+    uint32_t notis = 0;
+    uint32_t inds = 0;
+    uint16 h;
+    int op;
+    int r;
+    int s;
+    int c;
+
+    gattHostInitDb();
+    for (s = 0; s < GATT_HOST_SERVICES; s++)
+    {
+        registered[s] = true;
+    }
+
+    for (op = 0; op < MODEL_OPS; op++)
+    {
+        r = testRand(&seed) % 100;
+        h = testRand(&seed) % GATT_HOST_HANDLES;
+        s = testRand(&seed) % GATT_HOST_SERVICES;
+        c = testRand(&seed) % GATT_HOST_CHARS;
+
+        if (r < 5)
+        {
+            connect();
+        }
+        else if (r < 8)
+        {
+            if (connected[h])
+            {
+                disconnect(h);
+            }
+        }
+        else if (r < 40)
+        {
+            if (connected[h])
+            {
+                writeCcc(h, s, c);
+            }
+        }
+        else if (r < 70)
+        {
+            CHECK(GATTServApp_ReadCharCfg(h, gattHostDb[s].ccc[c]) == (modelUsed[s][c][h] ? model[s][c][h] : 0));
+        }
+        else if (r < 85)
+        {
+            notify(s, c);
+        }
+        else if (r < 86)
+        {
+            reregister(s);
+        }
+        else if (r < 88)
+        {
+            stackChange(s, c);
+        }
+        else
+        {
+            findAttr(s);
+        }
+
+        if ((op % CHECK_OPS) == 0)
+        {
+            checkIndex();
+        }
+    }
+    checkIndex();
+
+    for (h = 0; h < GATT_HOST_HANDLES; h++)
+    {
+        notis += gattHostNotis[h];
+        inds += gattHostInds[h];
+    }
+    printf("%u notifications, %u indications\n", (unsigned)notis, (unsigned)inds);
+    CHECK((notis > 0) && (inds > 0));
+
+    printf("PASS\n");
+    return 0;
+}
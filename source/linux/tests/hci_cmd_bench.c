@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== hci_cmd_bench.c ========
+ *
+ *  Replay of an HCI command trace through the command lookup of
+ *  hci_tl_cmd.c, on a table of the opcodes of the full TL hciCmdTable[].
+ *  Every command packet of the trace is dispatched as
+ *  hciProcessHostToCtrlCmd() does, once with the command index and once
+ *  with the scan hciFindCmd() falls back to, which is the lookup the TL did
+ *  before the index. Both must dispatch the same commands.
+ *
+ *  Usage: hci_cmd_bench <trace file>
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hci_cmd_host.h"
+#include "test_util.h"
+
+#define BENCH_CMDS_MAX  4096
+#define BENCH_CMD_LEN   (4 + 255)
+#define BENCH_MIN_CMDS  2000000
+#define BENCH_RUNS      5
+
+static uint8 cmds[BENCH_CMDS_MAX][BENCH_CMD_LEN];
+static int numCmds;
+
+static hciCmdFunc_t table[HCI_CMD_HOST_NUM_OPCODES + 1];
+
+/* Commands each table entry was dispatched, and unknown commands */
+static unsigned long dispatched[HCI_CMD_HOST_NUM_OPCODES];
+static unsigned long unknown;
+
+static hciStatus_t benchCmd(uint8 *pBuf)
+{
+    // The parameter length is just before the parameters
+    CHECK(pBuf[-1] < BENCH_CMD_LEN - 4);
+    return HCI_SUCCESS;
+}
+
+/* Command packets of the trace, one H4 packet per line in hex */
+static void loadTrace(const char *path)
+{
+    char line[4 * BENCH_CMD_LEN];
+    FILE *fp = fopen(path, "r");
+
+    CHECK(fp != NULL);
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        uint8 *pCmd = cmds[numCmds];
+        unsigned int byte;
+        char *p = line;
+        int used;
+        int len = 0;
+
+        if ((line[0] == '#') || (line[0] == '\n'))
+        {
+            continue;
+        }
+        CHECK(numCmds < BENCH_CMDS_MAX);
+        while ((len < BENCH_CMD_LEN) && (sscanf(p, "%2x%n", &byte, &used) == 1))
+        {
+            pCmd[len++] = (uint8)byte;
+            p += used;
+        }
+        CHECK((len >= 4) && (pCmd[0] == HCI_CMD_PACKET) && (len == 4 + pCmd[3]));
+        numCmds++;
+    }
+    fclose(fp);
+    CHECK(numCmds > 0);
+}
+
+/* One pass over the trace, as hciProcessHostToCtrlCmd() dispatches it */
+static void replay(uint8 useIdx)
+{
+    int i;
+
+    for (i = 0; i < numCmds; i++)
+    {
+        uint8 *pData = cmds[i];
+        uint16 opCode = BUILD_UINT16(pData[1], pData[2]);
+        cmdPktTable_t *pCmd = useIdx ? hciFindCmd(opCode) : hciScanCmd(table, opCode);
+
+        if (pCmd != NULL)
+        {
+            (void)(pCmd->hciFunc)(&pData[4]);
+            dispatched[pCmd - table]++;
+        }
+        else
+        {
+            unknown++;
+        }
+    }
+}
+
+/* Best time per command over a few runs */
+static double run(uint8 useIdx, unsigned long *pDispatched, unsigned long *pUnknown)
+{
+    double best = 0;
+    int passes = (BENCH_MIN_CMDS + numCmds - 1) / numCmds;
+    int r;
+    int i;
+
+    memset(dispatched, 0, sizeof(dispatched));
+    unknown = 0;
+
+    for (r = 0; r < BENCH_RUNS; r++)
+    {
+        uint64_t t0;
+        double ns;
+
+        CHECK(hciBuildCmdIdx(table) == TRUE);
+
+        t0 = testNowNs();
+        for (i = 0; i < passes; i++)
+        {
+            replay(useIdx);
+        }
+        ns = (double)(testNowNs() - t0) / ((double)passes * numCmds);
+        if ((r == 0) || (ns < best))
+        {
+            best = ns;
+        }
+    }
+
+    memcpy(pDispatched, dispatched, sizeof(dispatched));
+    *pUnknown = unknown;
+    return best;
+}
+
+int main(int argc, char *argv[])
+{
+    static unsigned long idxDispatched[HCI_CMD_HOST_NUM_OPCODES];
+    static unsigned long scanDispatched[HCI_CMD_HOST_NUM_OPCODES];
+    unsigned long idxUnknown;
+    unsigned long scanUnknown;
+    unsigned long position = 0;
+    unsigned long total = 0;
+    double idxNs;
+    double scanNs;
+    int i;
+
+    if (argc < 2)
+    {
+        printf("usage: %s <trace file>\n", argv[0]);
+        return 2;
+    }
+    loadTrace(argv[1]);
+
+    for (i = 0; i < (int)HCI_CMD_HOST_NUM_OPCODES; i++)
+    {
+        table[i].opCode = hciCmdHostOpcodes[i].opCode;
+        table[i].hciFunc = benchCmd;
+    }
+    table[i].opCode = 0xFFFF;
+    table[i].hciFunc = NULL;
+
+    idxNs = run(TRUE, idxDispatched, &idxUnknown);
+    scanNs = run(FALSE, scanDispatched, &scanUnknown);
+
+    CHECK(memcmp(idxDispatched, scanDispatched, sizeof(idxDispatched)) == 0);
+    CHECK(idxUnknown == scanUnknown);
+
+    // Entries the scan passes for an average command of the trace
+    for (i = 0; i < (int)HCI_CMD_HOST_NUM_OPCODES; i++)
+    {
+        total += scanDispatched[i];
+        position += scanDispatched[i] * (i + 1);
+    }
+    total += scanUnknown;
+    position += scanUnknown * HCI_CMD_HOST_NUM_OPCODES;
+
+    printf("%d commands in the trace, %d in the table: %.1f%% unknown, %.1f entries scanned per command\n", numCmds,
+           (int)HCI_CMD_HOST_NUM_OPCODES, (100.0 * scanUnknown) / total, (double)position / total);
+    printf("index: %.1f ns per command, scan: %.1f ns per command\n", idxNs, scanNs);
+
+    printf("PASS\n");
+    return 0;
+}
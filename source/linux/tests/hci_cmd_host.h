@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== hci_cmd_host.h ========
+ *
+ *  Opcodes of the full TL hciCmdTable[] for the host tests of the command
+ *  index in hci_tl_cmd.c. The opcodes come from the same hci_tl_cmd_table.h
+ *  list hci_tl.c builds its table from, with every controller configuration
+ *  set by CMake.
+ */
+
+#ifndef ti_linux_tests_hci_cmd_host__include
+#define ti_linux_tests_hci_cmd_host__include
+
+#include <stdint.h>
+
+#include "hal_types.h"
+#include "hci_tl.h"
+#include "hci_tl_cmd.h"
+
+/* Opcode of the deprecated HCI_EXT_SetMaxDtmTxPowerCmd, which the TL table
+   still lists but hci_tl.h no longer defines */
+#ifndef HCI_EXT_SET_MAX_DTM_TX_POWER
+#define HCI_EXT_SET_MAX_DTM_TX_POWER 0xFC11
+#endif
+
+typedef struct
+{
+    uint16 opCode;
+    const char *name;
+} HciCmdHostOpcode;
+
+/* Opcodes of the full TL hciCmdTable[], in table order */
+#define HCI_TL_CMD(opCode, hciFunc) {opCode, #opCode},
+static const HciCmdHostOpcode hciCmdHostOpcodes[] = {
+#include "hci_tl_cmd_table.h"
+};
+#undef HCI_TL_CMD
+
+#define HCI_CMD_HOST_NUM_OPCODES \
+    (sizeof(hciCmdHostOpcodes) / sizeof(hciCmdHostOpcodes[0]))
+
+#endif /* ti_linux_tests_hci_cmd_host__include */
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== hci_cmd_test.c ========
+ *
+ *  Host test of the HCI command index of hci_tl_cmd.c. For the opcodes of
+ *  the full TL hciCmdTable[] and for random tables, with repeated opcodes
+ *  and more commands than the index holds, hciFindCmd() and hciScanCmd()
+ *  must return the entry a scan of the table from the start finds: the
+ *  first one for the opcode, or NULL.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hci_cmd_host.h"
+#include "test_util.h"
+
+#define RANDOM_TABLES     2000
+#define RANDOM_MAX_CMDS   300
+#define RANDOM_LOOKUPS    500
+
+static uint32_t seed = 0x2545F491U;
+
+static hciCmdFunc_t table[RANDOM_MAX_CMDS + 1];
+
+static hciStatus_t testCmd(uint8 *pBuf)
+{
+    (void)pBuf;
+    return HCI_SUCCESS;
+}
+
+/* Lookup of hciProcessHostToCtrlCmd() before the index */
+static cmdPktTable_t *refFind(uint16 opCode)
+{
+    int i;
+
+    for (i = 0; (table[i].opCode != 0xFFFF) && (table[i].hciFunc != NULL); i++)
+    {
+        if (table[i].opCode == opCode)
+        {
+            return &table[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void setTable(const uint16 *opCodes, int num)
+{
+    int i;
+
+    for (i = 0; i < num; i++)
+    {
+        table[i].opCode = opCodes[i];
+        table[i].hciFunc = testCmd;
+    }
+    table[num].opCode = 0xFFFF;
+    table[num].hciFunc = NULL;
+
+    // One slot of the index stays empty to end the probes
+    CHECK(hciBuildCmdIdx(table) == ((num < HCI_CMD_IDX_SIZE) ? TRUE : FALSE));
+}
+
+static void checkFind(uint16 opCode)
+{
+    CHECK(hciFindCmd(opCode) == refFind(opCode));
+
+    // The scan hciFindCmd() falls back to as well
+    CHECK(hciScanCmd(table, opCode) == refFind(opCode));
+}
+
+/* Another opcode with the same home slot in the index */
+static uint16 collide(uint16 opCode)
+{
+    uint16 other;
+
+    do
+    {
+        other = (uint16)testRand(&seed);
+    } while ((other == opCode) || (other == 0xFFFF) ||
+             (HCI_CMD_IDX_HASH(other) != HCI_CMD_IDX_HASH(opCode)));
+
+    return other;
+}
+
+static void testTlTable(void)
+{
+    uint16 opCodes[HCI_CMD_HOST_NUM_OPCODES];
+    uint32_t opCode;
+    int repeated = 0;
+    int i;
+
+    CHECK(HCI_CMD_HOST_NUM_OPCODES <= RANDOM_MAX_CMDS);
+    for (i = 0; i < (int)HCI_CMD_HOST_NUM_OPCODES; i++)
+    {
+        opCodes[i] = hciCmdHostOpcodes[i].opCode;
+    }
+    setTable(opCodes, HCI_CMD_HOST_NUM_OPCODES);
+
+    for (opCode = 0; opCode <= 0xFFFF; opCode++)
+    {
+        checkFind((uint16)opCode);
+    }
+
+    for (i = 0; i < (int)HCI_CMD_HOST_NUM_OPCODES; i++)
+    {
+        if (hciFindCmd(opCodes[i]) != &table[i])
+        {
+            repeated++;
+        }
+    }
+
+    printf("TL table: %d commands, %d repeated opcodes\n", (int)HCI_CMD_HOST_NUM_OPCODES, repeated);
+}
+
+static void testRandomTables(void)
+{
+    uint16 opCodes[RANDOM_MAX_CMDS];
+    int trial;
+
+    for (trial = 0; trial < RANDOM_TABLES; trial++)
+    {
+        int num = testRand(&seed) % (RANDOM_MAX_CMDS + 1);
+        int i;
+
+        // Opcodes of the TL table, repeats, and opcodes sharing a home slot
+        for (i = 0; i < num; i++)
+        {
+            uint32_t r = testRand(&seed);
+
+            switch (r % 4)
+            {
+                case 0:
+                    opCodes[i] = hciCmdHostOpcodes[(r >> 8) % HCI_CMD_HOST_NUM_OPCODES].opCode;
+                    break;
+                case 1:
+                    opCodes[i] = (i > 0) ? opCodes[(r >> 8) % i] : 0x0C03;
+                    break;
+                case 2:
+                    opCodes[i] = collide((i > 0) ? opCodes[(r >> 8) % i] : 0xFC01);
+                    break;
+                default:
+                    opCodes[i] = (uint16)(r >> 8);
+                    if (opCodes[i] == 0xFFFF)
+                    {
+                        opCodes[i] = 0xFFFE;
+                    }
+                    break;
+            }
+        }
+        setTable(opCodes, num);
+
+        for (i = 0; i < num; i++)
+        {
+            checkFind(opCodes[i]);
+        }
+        for (i = 0; i < RANDOM_LOOKUPS; i++)
+        {
+            checkFind((uint16)testRand(&seed));
+        }
+    }
+}
+
+int main(void)
+{
+    testTlTable();
+    testRandomTables();
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== hci_tl_batch_test.c ========
+ *
+ *  Host test of the advertising report batching of the host TL, built from
+ *  icall_hci_tl.c with HOST_TL_ADV_RPT_BATCH. Scanning is started with an
+ *  HCI_EXT_GAP_SCAN_ENABLE command and reports are fed through the scanner
+ *  callback the TL registers. Every report sent to the host, batched or not,
+ *  must arrive exactly once and in order.
+ *
+ *  The flush timer is fired as the ICall Swi would: right after the TL leaves
+ *  a critical section, while it sends an event and as it stops the timer to
+ *  flush the batch itself. The callback event hook either runs the flush in
+ *  the caller context, like HCI_ControllerToHostSendCallbackEvent(), or
+ *  queues it for the TL task.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "icall.h"
+#include "hci_tl.h"
+#include "hci_ext.h"
+#include "gap_scanner.h"
+#include "icall_hci_tl.h"
+#include "hci_tl_host.h"
+#include "icall_host.h"
+#include "test_util.h"
+
+#define TEST_RECORD_LEN   24
+#define TEST_BATCH_LEN    255
+#define TEST_MAX_EVENTS   4096
+#define TEST_MAX_REPORTS  8192
+#define TEST_MAX_DATA     31
+#define TEST_QUEUE_LEN    64
+
+typedef struct
+{
+    void *pData;
+    void (*fn)(void *);
+} TestQueued;
+
+/* Reports decoded from the events sent to the host, in order */
+static uint32_t rxSeq[TEST_MAX_REPORTS];
+static int8_t rxRssi[TEST_MAX_REPORTS];
+static uint32_t rxCount;
+static uint32_t rxBatchEvents;
+static uint32_t rxSingleEvents;
+static uint32_t rxScanEvents;
+static uint32_t rxCmdStatus;
+
+static TestQueued queue[TEST_QUEUE_LEN];
+static uint32_t queueHead;
+static uint32_t queueTail;
+static bool queueEvents;
+
+static bool preemptOnCsExit;
+static bool preemptInSend;
+static uint32_t sendDepth;
+
+/* Host side */
+
+static void checkRecord(const uint8_t *pRec, uint16_t dataLen)
+{
+    uint32_t seq = pRec[2] | (pRec[3] << 8) | (pRec[4] << 16);
+    uint16_t i;
+
+    CHECK(rxCount < TEST_MAX_REPORTS);
+    CHECK(dataLen == (seq % (TEST_MAX_DATA + 1)));
+    for (i = 0; i < dataLen; i++)
+    {
+        CHECK(pRec[TEST_RECORD_LEN + i] == (uint8_t)(seq + i));
+    }
+    rxRssi[rxCount] = (int8_t)pRec[12];
+    rxSeq[rxCount++] = seq;
+}
+
+static void decodeEvent(const uint8_t *pBuf, uint16_t len)
+{
+    const uint8_t *pParam;
+    uint16_t paramLen;
+    uint16_t opcode;
+
+    if (pBuf[0] == HCI_EVENT_PACKET)
+    {
+        CHECK(pBuf[1] == HCI_VE_EVENT_CODE);
+        paramLen = pBuf[2];
+    }
+    else
+    {
+        CHECK(pBuf[0] == HCI_EXTENDED_EVENT_PACKET);
+        paramLen = pBuf[1] | (pBuf[2] << 8);
+    }
+    CHECK(len == HCI_EVENT_MIN_LENGTH + paramLen);
+    pParam = &pBuf[HCI_EVENT_MIN_LENGTH];
+    opcode = pParam[0] | (pParam[1] << 8);
+
+    if (opcode == HCI_EXT_GAP_ADV_RPT_BATCH_EVENT)
+    {
+        uint16_t pos = 4;
+        uint8_t n;
+
+        CHECK(paramLen <= TEST_BATCH_LEN);
+        CHECK(pParam[2] == SUCCESS);
+        CHECK(pParam[3] > 0);
+        for (n = 0; n < pParam[3]; n++)
+        {
+            uint16_t dataLen;
+
+            CHECK(pos + TEST_RECORD_LEN <= paramLen);
+            dataLen = pParam[pos + 22] | (pParam[pos + 23] << 8);
+            CHECK(pos + TEST_RECORD_LEN + dataLen <= paramLen);
+            checkRecord(&pParam[pos], dataLen);
+            pos += TEST_RECORD_LEN + dataLen;
+        }
+        CHECK(pos == paramLen);
+        rxBatchEvents++;
+    }
+    else if (opcode == HCI_EXT_GAP_ADV_SCAN_EVENT)
+    {
+        uint32_t event = pParam[3] | (pParam[4] << 8) | (pParam[5] << 16) |
+                         ((uint32_t)pParam[6] << 24);
+
+        if (event == GAP_EVT_ADV_REPORT)
+        {
+            uint16_t dataLen = pParam[7 + 22] | (pParam[7 + 23] << 8);
+
+            CHECK(paramLen == 7 + TEST_RECORD_LEN + dataLen);
+            checkRecord(&pParam[7], dataLen);
+            rxSingleEvents++;
+        }
+        else
+        {
+            rxScanEvents++;
+        }
+    }
+    else
+    {
+        CHECK(opcode == HCI_EXT_GAP_CMD_STATUS_EVENT);
+        CHECK(pParam[2] == SUCCESS);
+        rxCmdStatus++;
+    }
+}
+
+static void hostSend(uint8_t *pBuf, uint16_t len)
+{
+    /* Nothing may be sent with interrupts disabled */
+    CHECK(icallHostCsDepth == 0);
+
+    sendDepth++;
+    decodeEvent(pBuf, len);
+    if (preemptInSend)
+    {
+        /* The timer expires while this event is sent */
+        icallHostFireTimers();
+    }
+    sendDepth--;
+}
+
+/* Callback event hook of the TL */
+
+static uint8_t evtHook(void *pData, void *callbackFctPtr)
+{
+    if (queueEvents)
+    {
+        if (queueTail - queueHead == TEST_QUEUE_LEN)
+        {
+            return FALSE;
+        }
+        queue[queueTail % TEST_QUEUE_LEN].pData = pData;
+        queue[queueTail % TEST_QUEUE_LEN].fn = (void (*)(void *))callbackFctPtr;
+        queueTail++;
+    }
+    else
+    {
+        ((void (*)(void *))callbackFctPtr)(pData);
+    }
+    return TRUE;
+}
+
+static void runTask(void)
+{
+    while (queueHead != queueTail)
+    {
+        TestQueued *pQueued = &queue[queueHead++ % TEST_QUEUE_LEN];
+
+        pQueued->fn(pQueued->pData);
+    }
+}
+
+static void csExit(void)
+{
+    /* A timer that expired in a critical section runs when it is left */
+    if (preemptOnCsExit && (sendDepth == 0))
+    {
+        icallHostFireTimers();
+    }
+}
+
+/* Controller side */
+
+static void scanEvent(uint32_t event)
+{
+    void *pData = NULL;
+
+    if (event == GAP_EVT_SCAN_DISABLED)
+    {
+        GapScan_Evt_End_t *pEnd = ICall_malloc(sizeof(GapScan_Evt_End_t));
+
+        CHECK(pEnd != NULL);
+        pEnd->reason = 0;
+        pEnd->numReport = 0;
+        pData = pEnd;
+    }
+    hciTlHostScanCb(event, pData, 0);
+    runTask();
+}
+
+static void advReport(uint32_t seq, uint16_t dataLen, int8_t rssi)
+{
+    GapScan_Evt_AdvRpt_t *pRpt = ICall_malloc(sizeof(GapScan_Evt_AdvRpt_t));
+    uint16_t i;
+
+    CHECK(pRpt != NULL);
+    memset(pRpt, 0, sizeof(*pRpt));
+    pRpt->evtType = 0x13;
+    pRpt->addrType = 0;
+    pRpt->addr[0] = (uint8_t)seq;
+    pRpt->addr[1] = (uint8_t)(seq >> 8);
+    pRpt->addr[2] = (uint8_t)(seq >> 16);
+    pRpt->advSid = 0xFF;
+    pRpt->rssi = rssi;
+    pRpt->dataLen = dataLen;
+    pRpt->pData = NULL;
+    if (dataLen)
+    {
+        pRpt->pData = ICall_malloc(dataLen);
+        CHECK(pRpt->pData != NULL);
+        for (i = 0; i < dataLen; i++)
+        {
+            pRpt->pData[i] = (uint8_t)(seq + i);
+        }
+    }
+    hciTlHostScanCb(GAP_EVT_ADV_REPORT, pRpt, 0);
+    runTask();
+}
+
+static void sendReports(uint32_t first, uint32_t count, uint32_t timerEvery)
+{
+    uint32_t seq;
+
+    for (seq = first; seq < first + count; seq++)
+    {
+        advReport(seq, seq % (TEST_MAX_DATA + 1), (int8_t)(-40 - (int8_t)(seq % 8)));
+        if (timerEvery && ((seq % timerEvery) == 0))
+        {
+            icallHostFireTimers();
+            runTask();
+        }
+    }
+}
+
+static void checkReceived(uint32_t count)
+{
+    uint32_t i;
+
+    CHECK(rxCount == count);
+    for (i = 0; i < count; i++)
+    {
+        CHECK(rxSeq[i] == i);
+        CHECK(rxRssi[i] == (int8_t)(-40 - (int8_t)(i % 8)));
+    }
+}
+
+static void resetHost(void)
+{
+    rxCount = 0;
+    rxBatchEvents = 0;
+    rxSingleEvents = 0;
+    rxScanEvents = 0;
+}
+
+static void startScan(void)
+{
+    /* Extension commands reach the TL without the vendor specific OGF */
+    uint16_t opcode = (HCI_EXT_GAP_SUBGRP << 7) | HCI_EXT_GAP_SCAN_ENABLE;
+    uint8_t cmd[] = {HCI_CMD_PACKET, LO_UINT16(opcode), HI_UINT16(opcode), 5, 0, 0, 0, 0, 0};
+    hciPacket_t msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.hdr.event = HCI_EXT_CMD_EVENT;
+    msg.pData = cmd;
+    HCI_TL_SendToStack((uint8_t *)&msg);
+    CHECK(hciTlHostScanCb != NULL);
+    scanEvent(GAP_EVT_SCAN_ENABLED);
+}
+
+/* Scenarios */
+
+static void testTimerFlush(bool queued)
+{
+    resetHost();
+    queueEvents = queued;
+    HCI_TL_setAdvReportBatch(TRUE, 20, 0);
+
+    /* A single report stays queued until the timer expires */
+    advReport(0, 0, -40);
+    CHECK(rxCount == 0);
+    CHECK(icallHostArmedTimers() == 1);
+    CHECK(icallHostFireTimers() == 1);
+    if (queued)
+    {
+        /* Only posted from the timer, the TL task sends it */
+        CHECK(rxCount == 0);
+        runTask();
+    }
+    checkReceived(1);
+    CHECK(rxBatchEvents == 1);
+
+    /* An expired timer that finds the batch already sent does nothing */
+    advReport(1, 1, -41);
+    scanEvent(GAP_EVT_SCAN_DISABLED);
+    checkReceived(2);
+    CHECK(icallHostArmedTimers() == 0);
+    icallHostFireTimers();
+    runTask();
+    checkReceived(2);
+    CHECK(rxScanEvents == 1);
+}
+
+static void testRaces(bool queued)
+{
+    const uint32_t count = 3000;
+
+    resetHost();
+    queueEvents = queued;
+    HCI_TL_setAdvReportBatch(TRUE, 20, 0);
+    scanEvent(GAP_EVT_SCAN_ENABLED);
+
+    /* The timer expires at every point the TL task can be preempted */
+    preemptOnCsExit = true;
+    preemptInSend = true;
+    icallHostExpireOnStop = true;
+    sendReports(0, count, 7);
+    preemptOnCsExit = false;
+    preemptInSend = false;
+    icallHostExpireOnStop = false;
+
+    scanEvent(GAP_EVT_SCAN_DISABLED);
+    checkReceived(count);
+    CHECK(rxBatchEvents > 0);
+    CHECK(rxSingleEvents == 0);
+    CHECK(rxScanEvents == 2);
+    printf("%s hook: %u reports in %u batch events\n", queued ? "queued" : "inline",
+           (unsigned)count, (unsigned)rxBatchEvents);
+}
+
+static void testBatchSizes(void)
+{
+    const uint32_t count = 500;
+
+    resetHost();
+    queueEvents = false;
+    HCI_TL_setAdvReportBatch(TRUE, 0, 0);
+    scanEvent(GAP_EVT_SCAN_ENABLED);
+
+    /* Without a flush period only a full batch or a scanner event sends */
+    sendReports(0, count, 0);
+    CHECK(icallHostArmedTimers() == 0);
+    scanEvent(GAP_EVT_SCAN_DISABLED);
+    checkReceived(count);
+    CHECK(rxBatchEvents < count / 4);
+
+    /* Disabled, every report gets its own event */
+    resetHost();
+    HCI_TL_setAdvReportBatch(FALSE, 20, 0);
+    scanEvent(GAP_EVT_SCAN_ENABLED);
+    sendReports(0, 50, 0);
+    scanEvent(GAP_EVT_SCAN_DISABLED);
+    checkReceived(50);
+    CHECK(rxBatchEvents == 0);
+    CHECK(rxSingleEvents == 50);
+}
+
+static void testDuplicates(void)
+{
+    resetHost();
+    queueEvents = false;
+    HCI_TL_setAdvReportBatch(TRUE, 0, 6);
+    scanEvent(GAP_EVT_SCAN_ENABLED);
+
+    /* Same advertiser and data: forwarded again once the RSSI moved by 6 */
+    advReport(0, 0, -40);
+    advReport(0, 0, -45);
+    advReport(0, 0, -35);
+    advReport(0, 0, -34);
+    advReport(0, 0, -34);
+    scanEvent(GAP_EVT_SCAN_DISABLED);
+    CHECK(rxCount == 2);
+    CHECK(rxRssi[0] == -40);
+    CHECK(rxRssi[1] == -34);
+
+    /* A new scan forwards it again */
+    resetHost();
+    scanEvent(GAP_EVT_SCAN_ENABLED);
+    advReport(0, 0, -40);
+    scanEvent(GAP_EVT_SCAN_DISABLED);
+    CHECK(rxCount == 1);
+    HCI_TL_setAdvReportBatch(TRUE, 20, 0);
+}
+
+int main(void)
+{
+    int32_t blocks = icallHostBlocks;
+
+    HCI_TL_Init(NULL, hostSend, evtHook, 0);
+    icallHostCsExitHook = csExit;
+    startScan();
+    CHECK(rxCmdStatus == 1);
+    CHECK(hciTlHostScanEnables == 1);
+
+    testTimerFlush(false);
+    testTimerFlush(true);
+    testRaces(false);
+    testRaces(true);
+    testBatchSizes();
+    testDuplicates();
+
+    CHECK(icallHostBlocks == blocks);
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== hci_tl_host.c ========
+ *
+ *  BLE stack entry points referenced by the host TL (icall_hci_tl.c) when it
+ *  is built for the host tests with HOST_CONFIG=OBSERVER_CFG and HCI_TL_FULL.
+ *  Only the scanner is modeled: GapScan_registerCb() keeps the callback so a
+ *  test can feed scanner events, and GapScan_enable() succeeds. Every other
+ *  call fails.
+ */
+
+#include <string.h>
+
+#include "hci_tl_host.h"
+
+#include "icall.h"
+#include "gap.h"
+#include "gap_scanner.h"
+#include "gapgattserver.h"
+#include "hci.h"
+#include "ll.h"
+#include "osal.h"
+#include "osal_memory.h"
+#include "osal_snv.h"
+#include "ble_dispatch_lite.h"
+
+pfnGapCB_t hciTlHostScanCb;
+uint32_t hciTlHostScanEnables;
+
+status_t GapScan_registerCb(pfnGapCB_t cb, uintptr_t arg)
+{
+    (void)arg;
+    hciTlHostScanCb = cb;
+    return SUCCESS;
+}
+
+status_t GapScan_enable(uint16_t period, uint16_t duration, uint8_t maxNumReport)
+{
+    (void)period;
+    (void)duration;
+    (void)maxNumReport;
+    hciTlHostScanEnables++;
+    return SUCCESS;
+}
+
+status_t GapScan_disable(void)
+{
+    return FAILURE;
+}
+
+status_t GapScan_getAdvReport(uint8_t rptIdx, GapScan_Evt_AdvRpt_t *pAdvRpt)
+{
+    (void)rptIdx;
+    (void)pAdvRpt;
+    return FAILURE;
+}
+
+status_t GapScan_getParam(GapScan_ParamId_t paramId, void *pValue, uint8_t *pLen)
+{
+    (void)paramId;
+    (void)pValue;
+    (void)pLen;
+    return FAILURE;
+}
+
+status_t GapScan_setParam(GapScan_ParamId_t paramId, void *pValue)
+{
+    (void)paramId;
+    (void)pValue;
+    return FAILURE;
+}
+
+status_t GapScan_getPhyParams(uint8_t primPhy, GapScan_ScanType_t *pType, uint16_t *pInterval,
+                              uint16_t *pWindow)
+{
+    (void)primPhy;
+    (void)pType;
+    (void)pInterval;
+    (void)pWindow;
+    return FAILURE;
+}
+
+status_t GapScan_setPhyParams(uint8_t primPhys, GapScan_ScanType_t type, uint16_t interval,
+                              uint16_t window)
+{
+    (void)primPhys;
+    (void)type;
+    (void)interval;
+    (void)window;
+    return FAILURE;
+}
+
+void GapScan_setEventMask(GapScan_EventMask_t eventMask)
+{
+    (void)eventMask;
+}
+
+uint8_t GapScan_PeriodicAdvCreateSync(uint8 advSID,
+                                      GapScan_PeriodicAdvCreateSyncParams_t *createSyncParams)
+{
+    (void)advSID;
+    (void)createSyncParams;
+    return FAILURE;
+}
+
+bStatus_t GapScan_PeriodicAdvCreateSyncCancel(void)
+{
+    return FAILURE;
+}
+
+bStatus_t GapScan_PeriodicAdvTerminateSync(uint16 syncHandle)
+{
+    (void)syncHandle;
+    return FAILURE;
+}
+
+bStatus_t GapScan_SetPeriodicAdvReceiveEnable(uint16 syncHandle, uint8 enable)
+{
+    (void)syncHandle;
+    (void)enable;
+    return FAILURE;
+}
+
+bStatus_t GapScan_AddDeviceToPeriodicAdvList(uint8 advAddrType, uint8 advAddress[6], uint8 advSID)
+{
+    (void)advAddrType;
+    (void)advAddress;
+    (void)advSID;
+    return FAILURE;
+}
+
+bStatus_t GapScan_RemoveDeviceFromPeriodicAdvList(uint8 advAddrType, uint8 advAddress[6],
+                                                  uint8 advSID)
+{
+    (void)advAddrType;
+    (void)advAddress;
+    (void)advSID;
+    return FAILURE;
+}
+
+hciStatus_t GapScan_ReadPeriodicAdvListSize(void)
+{
+    return FAILURE;
+}
+
+bStatus_t GapScan_ClearPeriodicAdvList(void)
+{
+    return FAILURE;
+}
+
+bStatus_t GAP_DeviceInit(uint8_t profileRole, uint8_t taskID, GAP_Addr_Modes_t addrMode,
+                         uint8_t *pRandomAddr)
+{
+    (void)profileRole;
+    (void)taskID;
+    (void)addrMode;
+    (void)pRandomAddr;
+    return FAILURE;
+}
+
+uint8_t *GAP_GetIRK(void)
+{
+    return NULL;
+}
+
+uint8_t *GAP_GetSRK(void)
+{
+    return NULL;
+}
+
+uint16_t GAP_GetParamValue(uint16_t paramID)
+{
+    (void)paramID;
+    return 0;
+}
+
+bStatus_t GAP_SetParamValue(uint16_t paramID, uint16_t paramValue)
+{
+    (void)paramID;
+    (void)paramValue;
+    return FAILURE;
+}
+
+bStatus_t GAP_SetPrivacyMode(GAP_Peer_Addr_Types_t addrType, uint8_t *pAddr, uint8_t mode)
+{
+    (void)addrType;
+    (void)pAddr;
+    (void)mode;
+    return FAILURE;
+}
+
+bStatus_t GapConfig_SetParameter(Gap_configParamIds_t param, void *pValue)
+{
+    (void)param;
+    (void)pValue;
+    return FAILURE;
+}
+
+void GGS_SetParamValue(uint16 value)
+{
+    (void)value;
+}
+
+hciStatus_t HCI_CMD_Parser(uint8 *pData)
+{
+    (void)pData;
+    return FAILURE;
+}
+
+void HCI_CommandCompleteEvent(uint16 opcode, uint8 numParam, uint8 *param)
+{
+    (void)opcode;
+    (void)numParam;
+    (void)param;
+}
+
+llStatus_t LL_IsRandomAddressConfigured(void)
+{
+    return FALSE;
+}
+
+uint8 buildRevision(ICall_BuildRevision *pBuildRev)
+{
+    (void)pBuildRev;
+    return FAILURE;
+}
+
+void *osal_mem_alloc(uint16 size)
+{
+    return ICall_malloc(size);
+}
+
+void osal_mem_free(void *ptr)
+{
+    ICall_free(ptr);
+}
+
+void *osal_memcpy(void *dst, const void GENERIC *src, unsigned int len)
+{
+    return memcpy(dst, src, len);
+}
+
+uint8 osal_snv_read(osalSnvId_t id, osalSnvLen_t len, void *pBuf)
+{
+    (void)id;
+    (void)len;
+    (void)pBuf;
+    return FAILURE;
+}
+
+uint8 osal_snv_write(osalSnvId_t id, osalSnvLen_t len, void *pBuf)
+{
+    (void)id;
+    (void)len;
+    (void)pBuf;
+    return FAILURE;
+}
+
+/*
+ *  icall_hci_tl.c declares this static but only defines it for controller
+ *  only builds, while HCI_TL_SendToStack() references it in every build.
+ */
+void HCI_TL_SendDataPkt(uint8_t *pMsg)
+{
+    (void)pMsg;
+}
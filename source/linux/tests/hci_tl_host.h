@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== hci_tl_host.h ========
+ *
+ *  Scanner model of the host TL tests, see hci_tl_host.c. Also force-included
+ *  in icall_hci_tl.c for the ICall and stack functions icall.h only declares
+ *  with ICALL_JT, which the host tests do not use.
+ */
+
+#ifndef ti_linux_tests_hci_tl_host__include
+#define ti_linux_tests_hci_tl_host__include
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "icall.h"
+#include "bcomdef.h"
+#include "icall_ble_apimsg.h"
+#include "gap.h"
+
+/* Callback registered by the TL through GapScan_registerCb(), NULL before */
+extern pfnGapCB_t hciTlHostScanCb;
+
+/* Number of GapScan_enable() calls */
+extern uint32_t hciTlHostScanEnables;
+
+#ifndef ICALL_JT
+extern void *ICall_mallocLimited(uint_least16_t size);
+extern void *ICall_allocMsgLimited(size_t size);
+extern void ICall_getHeapStats(ICall_heapStats_t *stats);
+extern uint8 buildRevision(ICall_BuildRevision *pBuildRev);
+#endif
+
+#endif /* ti_linux_tests_hci_tl_host__include */
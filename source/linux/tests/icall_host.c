@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== icall_host.c ========
+ */
+
+#include <stdlib.h>
+
+#include "icall.h"
+#include "icall_host.h"
+
+#define ICALL_HOST_NUM_TIMERS 4
+
+typedef struct
+{
+    ICall_TimerCback cback;
+    void *arg;
+    uint32_t msecs;
+    bool used;
+    bool armed;
+} IcallHostTimer;
+
+int32_t icallHostBlocks;
+uint32_t icallHostCsDepth;
+void (*icallHostCsExitHook)(void);
+bool icallHostExpireOnStop;
+
+static IcallHostTimer icallHostTimers[ICALL_HOST_NUM_TIMERS];
+
+static void *icallHostAlloc(size_t size)
+{
+    void *ptr = malloc(size);
+
+    if (NULL != ptr)
+    {
+        icallHostBlocks++;
+    }
+    return ptr;
+}
+
+static void icallHostFree(void *ptr)
+{
+    if (NULL != ptr)
+    {
+        icallHostBlocks--;
+        free(ptr);
+    }
+}
+
+static ICall_Errno icallHostSetTimer(ICall_SetTimerArgs *pArgs)
+{
+    IcallHostTimer *pTimer = (IcallHostTimer *)pArgs->timerid;
+    int i;
+
+    if (NULL == pTimer)
+    {
+        for (i = 0; i < ICALL_HOST_NUM_TIMERS; i++)
+        {
+            if (!icallHostTimers[i].used)
+            {
+                pTimer = &icallHostTimers[i];
+                pTimer->used = true;
+                break;
+            }
+        }
+        if (NULL == pTimer)
+        {
+            return ICALL_ERRNO_NO_RESOURCE;
+        }
+    }
+
+    pTimer->cback = pArgs->cback;
+    pTimer->arg = pArgs->arg;
+    pTimer->msecs = pArgs->timeout;
+    pTimer->armed = true;
+    pArgs->timerid = pTimer;
+
+    return ICALL_ERRNO_SUCCESS;
+}
+
+static ICall_Errno icallHostDispatch(ICall_FuncArgsHdr *args)
+{
+    switch (args->func)
+    {
+        case ICALL_PRIMITIVE_FUNC_MALLOC:
+        case ICALL_PRIMITIVE_FUNC_MSG_ALLOC:
+        {
+            ICall_AllocArgs *pArgs = (ICall_AllocArgs *)args;
+
+            pArgs->ptr = icallHostAlloc(pArgs->size);
+            return ICALL_ERRNO_SUCCESS;
+        }
+        case ICALL_PRIMITIVE_FUNC_FREE:
+        case ICALL_PRIMITIVE_FUNC_MSG_FREE:
+        {
+            ICall_FreeArgs *pArgs = (ICall_FreeArgs *)args;
+
+            icallHostFree(pArgs->ptr);
+            return ICALL_ERRNO_SUCCESS;
+        }
+        case ICALL_PRIMITIVE_FUNC_SET_TIMER_MSECS:
+            return icallHostSetTimer((ICall_SetTimerArgs *)args);
+        case ICALL_PRIMITIVE_FUNC_STOP_TIMER:
+        {
+            IcallHostTimer *pTimer = (IcallHostTimer *)((ICall_StopTimerArgs *)args)->timerid;
+
+            if ((NULL != pTimer) && pTimer->armed)
+            {
+                pTimer->armed = false;
+                if (icallHostExpireOnStop)
+                {
+                    /* Expired just before it could be stopped */
+                    pTimer->cback(pTimer->arg);
+                }
+            }
+            return ICALL_ERRNO_SUCCESS;
+        }
+        default:
+            return ICALL_ERRNO_INVALID_FUNCTION;
+    }
+}
+
+static ICall_CSState icallHostEnterCs(void)
+{
+    return icallHostCsDepth++;
+}
+
+static void icallHostLeaveCs(ICall_CSState key)
+{
+    icallHostCsDepth = key;
+    if ((0 == icallHostCsDepth) && (NULL != icallHostCsExitHook))
+    {
+        icallHostCsExitHook();
+    }
+}
+
+ICall_Dispatcher ICall_dispatcher = icallHostDispatch;
+ICall_EnterCS ICall_enterCriticalSection = icallHostEnterCs;
+ICall_LeaveCS ICall_leaveCriticalSection = icallHostLeaveCs;
+
+void *ICall_mallocLimited(uint_least16_t size)
+{
+    return icallHostAlloc(size);
+}
+
+void *ICall_allocMsgLimited(size_t size)
+{
+    return icallHostAlloc(size);
+}
+
+void ICall_getHeapStats(ICall_heapStats_t *stats)
+{
+    stats->totalSize = 0;
+    stats->totalFreeSize = 0;
+    stats->largestFreeSize = 0;
+}
+
+int icallHostFireTimers(void)
+{
+    int fired = 0;
+    int i;
+
+    for (i = 0; i < ICALL_HOST_NUM_TIMERS; i++)
+    {
+        if (icallHostTimers[i].armed)
+        {
+            icallHostTimers[i].armed = false;
+            icallHostTimers[i].cback(icallHostTimers[i].arg);
+            fired++;
+        }
+    }
+    return fired;
+}
+
+int icallHostArmedTimers(void)
+{
+    int armed = 0;
+    int i;
+
+    for (i = 0; i < ICALL_HOST_NUM_TIMERS; i++)
+    {
+        armed += icallHostTimers[i].armed;
+    }
+    return armed;
+}
+
+bool BLE_isInvokeRequired(void)
+{
+    return false;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== icall_host.h ========
+ *
+ *  ICall dispatcher of the host tests. The heap and message primitives are
+ *  served from the C library heap, and the blocks in use are counted so tests
+ *  can check for leaks. Timers only run when a test fires them or, on request,
+ *  when they are stopped. Critical sections are counted so a test can run
+ *  code, as a pending Swi would, once the outermost one is left.
+ */
+
+#ifndef ti_linux_tests_icall_host__include
+#define ti_linux_tests_icall_host__include
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Blocks allocated with ICall_malloc() and not freed yet */
+extern int32_t icallHostBlocks;
+
+/* Critical sections currently entered */
+extern uint32_t icallHostCsDepth;
+
+/* Called each time the outermost critical section is left, may be NULL */
+extern void (*icallHostCsExitHook)(void);
+
+/* When set, stopping an armed timer runs its callback, as when it expires
+ * right before ICall_stopTimer() */
+extern bool icallHostExpireOnStop;
+
+/* Run the callbacks of all armed timers, returns how many ran */
+extern int icallHostFireTimers(void);
+
+/* Number of timers armed and not expired */
+extern int icallHostArmedTimers(void);
+
+#endif /* ti_linux_tests_icall_host__include */
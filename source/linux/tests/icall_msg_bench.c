@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== icall_msg_bench.c ========
+ *
+ *  Cost of an ICall_send()/ICall_fetchMsg() round trip against the number of
+ *  tasks enrolled in ICall, with icall_POSIX.c built for FreeRTOS on the DPL
+ *  port. Built with the task number cache of the calling task's entry, and
+ *  with ICALL_NO_TASK_NUMBER_CACHE for the scan of the task table.
+ *
+ *  Task k is enrolled k-th, so it sits in entry k - 1 of the task table and
+ *  the scan walks k entries to find it. Tasks that are done stay alive, so
+ *  their entries stay in use. They, and the main thread, wait outside the
+ *  DPL: every DPL post wakes all the threads blocked in the DPL, which would
+ *  be measured instead.
+ *
+ *  The best of BENCH_RUNS runs is reported, with the critical sections taken
+ *  per round trip, counted on HwiP_disable().
+ */
+
+#include <semaphore.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/TaskP.h>
+
+#include "icall.h"
+
+#include "test_util.h"
+
+#define BENCH_ROUNDS   20000
+#define BENCH_RUNS     5
+#define BENCH_MSG_SIZE 16
+
+#ifdef ICALL_NO_TASK_NUMBER_CACHE
+    #define BENCH_LOOKUP "scan"
+#else
+    #define BENCH_LOOKUP "task number cache"
+#endif
+
+static sem_t doneSem;
+static uint32_t benchTask;
+static uint64_t benchNs;
+static uint32_t benchCs;
+static uint32_t criticalSections;
+
+extern uintptr_t __real_HwiP_disable(void);
+
+uintptr_t __wrap_HwiP_disable(void)
+{
+    criticalSections++;
+    return __real_HwiP_disable();
+}
+
+static void benchTaskFxn(void *arg)
+{
+    ICall_EntityID entity;
+    ICall_SyncHandle syncHandle;
+    ICall_EntityID src;
+    ICall_EntityID dest;
+    void *msg;
+    void *fetched;
+    uint64_t start;
+    uint64_t ns;
+    int run;
+    int i;
+
+    CHECK(ICall_registerApp(&entity, &syncHandle) == ICALL_ERRNO_SUCCESS);
+#ifdef ICALL_NO_TASK_NUMBER_CACHE
+    CHECK(uxTaskGetTaskNumber(xTaskGetCurrentTaskHandle()) == 0);
+#else
+    CHECK(uxTaskGetTaskNumber(xTaskGetCurrentTaskHandle()) == benchTask);
+#endif
+
+    benchNs = UINT64_MAX;
+    criticalSections = 0;
+    for (run = 0; run < BENCH_RUNS; run++)
+    {
+        start = testNowNs();
+        for (i = 0; i < BENCH_ROUNDS; i++)
+        {
+            msg = ICall_allocMsg(BENCH_MSG_SIZE);
+            CHECK(msg != NULL);
+            CHECK(ICall_send(entity, entity, ICALL_MSG_FORMAT_KEEP, msg) == ICALL_ERRNO_SUCCESS);
+            CHECK(ICall_fetchMsg(&src, &dest, &fetched) == ICALL_ERRNO_SUCCESS);
+            CHECK((fetched == msg) && (src == entity) && (dest == entity));
+            ICall_freeMsg(fetched);
+        }
+        ns = testNowNs() - start;
+        if (ns < benchNs)
+        {
+            benchNs = ns;
+        }
+    }
+
+    benchCs = criticalSections / (BENCH_RUNS * BENCH_ROUNDS);
+    CHECK(ICall_fetchMsg(&src, &dest, &fetched) == ICALL_ERRNO_NOMSG);
+
+    /* Keep the task, and its entry, until the program exits */
+    sem_post(&doneSem);
+    for (;;)
+    {
+        pause();
+    }
+}
+
+int main(void)
+{
+    TaskP_Params taskParams;
+    uint32_t firstCs = 0;
+
+    CHECK(sem_init(&doneSem, 0, 0) == 0);
+    ICall_init();
+
+    printf("ICall send/fetch round trip, %s\n", BENCH_LOOKUP);
+    TaskP_Params_init(&taskParams);
+    for (benchTask = 1; benchTask <= ICALL_MAX_NUM_TASKS; benchTask++)
+    {
+        CHECK(TaskP_create(benchTaskFxn, &taskParams) != NULL);
+        CHECK(sem_wait(&doneSem) == 0);
+        if (benchTask == 1)
+        {
+            firstCs = benchCs;
+        }
+        CHECK(benchCs == firstCs);
+        if ((benchTask == 1) || ((benchTask % 4) == 0))
+        {
+            printf("  %2u tasks: %6.1f ns, %u critical sections\n", (unsigned)benchTask,
+                   (double)benchNs / BENCH_ROUNDS, (unsigned)benchCs);
+        }
+    }
+
+    return 0;
+}
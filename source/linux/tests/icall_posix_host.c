@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== icall_posix_host.c ========
+ *
+ *  The FreeRTOS task number is kept per thread: ICall only sets the number
+ *  of the calling task, and only the calling task reads it back.
+ */
+
+#include <stdbool.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <ti/drivers/dpl/TaskP.h>
+
+#include "icall.h"
+#include "icall_addrs.h"
+#include "icall_platform.h"
+#include "icall_posix_host.h"
+
+/* Referenced by the remote task table, no stack task is created here */
+icall_userCfg_t user0Cfg;
+
+static __thread UBaseType_t icallPosixHostTaskNumber;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return (TaskHandle_t)TaskP_getCurrentTask();
+}
+
+UBaseType_t uxTaskGetTaskNumber(TaskHandle_t xTask)
+{
+    return (xTask == xTaskGetCurrentTaskHandle()) ? icallPosixHostTaskNumber : 0;
+}
+
+void vTaskSetTaskNumber(TaskHandle_t xTask, const UBaseType_t uxHandle)
+{
+    if (xTask == xTaskGetCurrentTaskHandle())
+    {
+        icallPosixHostTaskNumber = uxHandle;
+    }
+}
+
+void vPortGetHeapStats(HeapStats_t *pxHeapStats)
+{
+    pxHeapStats->xAvailableHeapSpaceInBytes = configTOTAL_HEAP_SIZE;
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = configTOTAL_HEAP_SIZE;
+}
+
+uint32_t Event_pend(EventP_Handle event, uint32_t andMask, uint32_t orMask, uint32_t timeout)
+{
+    return EventP_pend(event, andMask | orMask, (0 != andMask), timeout);
+}
+
+void Event_post(EventP_Handle event, uint32_t eventMask)
+{
+    EventP_post(event, eventMask);
+}
+
+/* No power management on the host */
+ICall_Errno ICallPlatform_pwrUpdActivityCounter(ICall_PwrUpdActivityCounterArgs *args)
+{
+    return ICALL_ERRNO_SUCCESS;
+}
+
+ICall_Errno ICallPlatform_pwrRegisterNotify(ICall_PwrRegisterNotifyArgs *args)
+{
+    return ICALL_ERRNO_SUCCESS;
+}
+
+ICall_Errno ICallPlatform_pwrConfigACAction(ICall_PwrBitmapArgs *args)
+{
+    return ICALL_ERRNO_SUCCESS;
+}
+
+ICall_Errno ICallPlatform_pwrRequire(ICall_PwrBitmapArgs *args)
+{
+    return ICALL_ERRNO_SUCCESS;
+}
+
+ICall_Errno ICallPlatform_pwrDispense(ICall_PwrBitmapArgs *args)
+{
+    return ICALL_ERRNO_SUCCESS;
+}
+
+ICall_Errno ICallPlatform_pwrIsStableXOSCHF(ICall_GetBoolArgs *args)
+{
+    args->value = true;
+    return ICALL_ERRNO_SUCCESS;
+}
+
+ICall_Errno ICallPlatform_pwrSwitchXOSCHF(ICall_FuncArgsHdr *args)
+{
+    return ICALL_ERRNO_SUCCESS;
+}
+
+ICall_Errno ICallPlatform_pwrGetXOSCStartupTime(ICall_PwrGetXOSCStartupTimeArgs *args)
+{
+    args->value = 0;
+    return ICALL_ERRNO_SUCCESS;
+}
+
+ICall_Errno ICallPlatform_pwrGetTransitionState(ICall_PwrGetTransitionStateArgs *args)
+{
+    args->state = 0;
+    return ICALL_ERRNO_SUCCESS;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== image.h ========
+ *
+ *  The part of the MCUboot bootutil/image.h used by the stack, for the host
+ *  tests. MCUboot itself is not part of this tree.
+ */
+
+#ifndef H_IMAGE_
+#define H_IMAGE_
+
+#include <stdint.h>
+
+#define IMAGE_MAGIC             0x96f3b83d
+
+#define IMAGE_TLV_INFO_MAGIC    0x6907
+#define IMAGE_TLV_PROT_INFO_MAGIC 0x6908
+
+#define IMAGE_TLV_KEYHASH       0x01
+#define IMAGE_TLV_SHA256        0x10
+#define IMAGE_TLV_ECDSA_SIG     0x22
+
+struct image_version
+{
+    uint8_t  iv_major;
+    uint8_t  iv_minor;
+    uint16_t iv_revision;
+    uint32_t iv_build_num;
+};
+
+/* Image header, all fields little endian */
+struct image_header
+{
+    uint32_t ih_magic;
+    uint32_t ih_load_addr;
+    uint16_t ih_hdr_size;           /* Size of the image header */
+    uint16_t ih_protect_tlv_size;   /* Size of the protected TLV area */
+    uint32_t ih_img_size;           /* Does not include the header */
+    uint32_t ih_flags;
+    struct image_version ih_ver;
+    uint32_t _pad1;
+};
+
+/* TLV info, starts each TLV area */
+struct image_tlv_info
+{
+    uint16_t it_magic;
+    uint16_t it_tlv_tot;            /* Size of the TLV area, info included */
+};
+
+struct image_tlv
+{
+    uint16_t it_type;
+    uint16_t it_len;                /* Data length, not including the TLV header */
+};
+
+#endif /* H_IMAGE_ */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== hal_types.h ========
+ *
+ *  hal_types.h of the stack for the host tests. The target header defines
+ *  uint32 as unsigned long, which is 64 bits wide on a 64-bit host and
+ *  changes the layout of the structs kept in flash. This one uses the
+ *  fixed-width types; the include directory of the tests comes before the
+ *  stack directories so it is found first.
+ */
+
+#ifndef _HAL_TYPES_H
+#define _HAL_TYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef int8_t   int8;
+typedef uint8_t  uint8;
+typedef int16_t  int16;
+typedef uint16_t uint16;
+typedef int32_t  int32;
+typedef uint32_t uint32;
+
+typedef uint32   halDataAlign_t;
+
+#define ASM_NOP  __asm__ __volatile__ ("nop")
+
+#ifndef TRUE
+#define TRUE 1
+#endif
+
+#ifndef UTRUE
+#define UTRUE 1U
+#endif
+
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+#ifndef UFALSE
+#define UFALSE 0U
+#endif
+
+#ifndef NULL
+#define NULL 0L
+#endif
+
+#define ALIGNED                             __attribute__((aligned(4)))
+#define PACKED                              __attribute__((__packed__))
+#define PACKED_STRUCT                       struct PACKED
+#define PACKED_TYPEDEF_STRUCT               typedef struct PACKED
+#define PACKED_TYPEDEF_CONST_STRUCT         typedef const struct PACKED
+#define PACKED_TYPEDEF_UNION                typedef union PACKED
+#define PACKED_ALIGNED                      __attribute__((packed,aligned(4)))
+#define PACKED_ALIGNED_TYPEDEF_STRUCT       typedef struct PACKED_ALIGNED
+
+#endif /* _HAL_TYPES_H */
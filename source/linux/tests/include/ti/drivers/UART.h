@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== UART.h ========
+ *
+ *  Stand-in for the UART driver of TI-RTOS, which the NPI UART transport
+ *  still uses but this SDK no longer ships. Only the API the transport
+ *  calls is declared; the host tests implement it.
+ */
+
+#ifndef ti_linux_tests_drivers_UART__include
+#define ti_linux_tests_drivers_UART__include
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define UART_STATUS_SUCCESS 0
+#define UART_ERROR          (-1)
+
+typedef struct UART_Config_ *UART_Handle;
+
+typedef void (*UART_Callback)(UART_Handle handle, void *buf, size_t count);
+
+typedef enum
+{
+    UART_MODE_BLOCKING,
+    UART_MODE_CALLBACK
+} UART_Mode;
+
+typedef struct
+{
+    UART_Mode readMode;
+    UART_Mode writeMode;
+    uint32_t readTimeout;
+    uint32_t writeTimeout;
+    UART_Callback readCallback;
+    UART_Callback writeCallback;
+    uint32_t baudRate;
+    void *custom;
+} UART_Params;
+
+typedef struct UART_Config_
+{
+    void *object;
+    void const *hwAttrs;
+} UART_Config;
+
+extern void UART_init(void);
+extern void UART_Params_init(UART_Params *params);
+extern UART_Handle UART_open(uint_least8_t index, UART_Params *params);
+extern void UART_close(UART_Handle handle);
+extern int_fast16_t UART_control(UART_Handle handle, uint_fast16_t cmd, void *arg);
+extern int_fast32_t UART_read(UART_Handle handle, void *buffer, size_t size);
+extern void UART_readCancel(UART_Handle handle);
+extern int_fast32_t UART_write(UART_Handle handle, const void *buffer, size_t size);
+extern void UART_writeCancel(UART_Handle handle);
+
+#endif /* ti_linux_tests_drivers_UART__include */
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== json_stream_bench.c ========
+ *
+ *  Peak heap of a JSON document received in MTU-sized chunks, beyond the
+ *  template and object: reassembled and parsed with Json_parse(), or fed
+ *  chunk by chunk to the push-style parser. malloc() and free() are wrapped
+ *  at link time to track the bytes in use.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ti/utils/json/json.h"
+#include "ti/utils/json/json_engine.h"
+#include "test_util.h"
+
+#define BENCH_MTU        244
+#define BENCH_TOKEN_SIZE 80
+#define BENCH_DOC_MAX    20000
+#define BENCH_TMPL_MAX   4096
+#define BENCH_HDR        16
+
+void *__real_malloc(size_t size);
+void __real_free(void *ptr);
+
+static size_t heapInUse;
+static size_t heapPeak;
+
+void *__wrap_malloc(size_t size)
+{
+    uint8_t *p = __real_malloc(size + BENCH_HDR);
+
+    if (p == NULL)
+    {
+        return NULL;
+    }
+    *(size_t *)p = size;
+    heapInUse += size;
+    if (heapInUse > heapPeak)
+    {
+        heapPeak = heapInUse;
+    }
+    return p + BENCH_HDR;
+}
+
+void __wrap_free(void *ptr)
+{
+    uint8_t *p = (uint8_t *)ptr - BENCH_HDR;
+
+    if (ptr != NULL)
+    {
+        heapInUse -= *(size_t *)p;
+        __real_free(p);
+    }
+}
+
+static char tmplText[BENCH_TMPL_MAX];
+static char doc[BENCH_DOC_MAX];
+
+/* Document with an array of numItems strings of itemLen digits */
+static uint16_t makeDoc(Json_Handle *pTmpl, uint16_t numItems, uint16_t itemLen)
+{
+    uint16_t tmplLen = 0;
+    uint16_t len = 0;
+    uint16_t i;
+
+    tmplLen += snprintf(&tmplText[tmplLen], BENCH_TMPL_MAX - tmplLen, "{\"id\":uint32,\"items\":[");
+    len += snprintf(&doc[len], BENCH_DOC_MAX - len, "{\"id\": 1234, \"items\": [");
+    for (i = 0; i < numItems; i++)
+    {
+        tmplLen += snprintf(&tmplText[tmplLen], BENCH_TMPL_MAX - tmplLen, "%sstring",
+                            (i != 0) ? "," : "");
+        len += snprintf(&doc[len], BENCH_DOC_MAX - len, "%s\"%0*u\"", (i != 0) ? ", " : "",
+                        (int)itemLen, i);
+    }
+    tmplLen += snprintf(&tmplText[tmplLen], BENCH_TMPL_MAX - tmplLen, "]}");
+    len += snprintf(&doc[len], BENCH_DOC_MAX - len, "]}");
+    CHECK(tmplLen < BENCH_TMPL_MAX);
+    CHECK(len < BENCH_DOC_MAX);
+
+    CHECK(Json_createTemplate(pTmpl, tmplText, tmplLen) == JSON_RC__OK);
+    return len;
+}
+
+static size_t peakWhole(Json_Handle obj, uint16_t len)
+{
+    size_t base = heapInUse;
+    char *pRx;
+    uint16_t i;
+
+    heapPeak = heapInUse;
+    pRx = malloc(len);
+    CHECK(pRx != NULL);
+    for (i = 0; i < len; i += BENCH_MTU)
+    {
+        memcpy(&pRx[i], &doc[i], ((len - i) < BENCH_MTU) ? (len - i) : BENCH_MTU);
+    }
+    CHECK(Json_parse(obj, pRx, len) == JSON_RC__OK);
+    free(pRx);
+
+    return heapPeak - base;
+}
+
+static size_t peakStream(Json_Handle obj, uint16_t len)
+{
+    size_t base = heapInUse;
+    Json_Handle parser;
+    char *pRx;
+    uint16_t i;
+
+    heapPeak = heapInUse;
+    pRx = malloc(BENCH_MTU);
+    CHECK(pRx != NULL);
+    CHECK(Json_createParser(&parser, obj, BENCH_TOKEN_SIZE) == JSON_RC__OK);
+    for (i = 0; i < len; i += BENCH_MTU)
+    {
+        uint16_t chunkLen = ((len - i) < BENCH_MTU) ? (len - i) : BENCH_MTU;
+
+        memcpy(pRx, &doc[i], chunkLen);
+        CHECK(Json_parseChunk(parser, pRx, chunkLen) == JSON_RC__OK);
+    }
+    CHECK(Json_parseFinish(parser) == JSON_RC__OK);
+    CHECK(Json_destroyParser(parser) == JSON_RC__OK);
+    free(pRx);
+
+    return heapPeak - base;
+}
+
+int main(void)
+{
+    static const uint16_t sizes[][2] = {
+        {4, 8}, {16, 8}, {64, 8}, {128, 16}, {250, 16}, {250, 40}, {250, 64}};
+    size_t streamFirst = 0;
+    unsigned s;
+
+    printf("parser context %u bytes, %u byte chunks, %u byte token buffer\n",
+           (unsigned)__JSON_ParseStreamContextSize(), BENCH_MTU, BENCH_TOKEN_SIZE);
+    printf("%8s %8s | %16s | %16s\n", "members", "docSize", "Json_parse peak", "stream peak");
+
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        uint16_t numItems = sizes[s][0];
+        uint16_t objSize = 64 + numItems * (sizes[s][1] + 8);
+        Json_Handle tmpl;
+        Json_Handle obj;
+        uint16_t len;
+        size_t whole;
+        size_t stream;
+
+        len = makeDoc(&tmpl, numItems, sizes[s][1]);
+
+        CHECK(Json_createObject(&obj, tmpl, objSize) == JSON_RC__OK);
+        whole = peakWhole(obj, len);
+        CHECK(Json_destroyObject(obj) == JSON_RC__OK);
+
+        CHECK(Json_createObject(&obj, tmpl, objSize) == JSON_RC__OK);
+        stream = peakStream(obj, len);
+        CHECK(Json_destroyObject(obj) == JSON_RC__OK);
+        CHECK(Json_destroyTemplate(tmpl) == JSON_RC__OK);
+
+        printf("%8u %8u | %16zu | %16zu\n", numItems, len, whole, stream);
+
+        /* The stream needs the same memory whatever the document size */
+        if (s == 0)
+        {
+            streamFirst = stream;
+        }
+        CHECK(stream == streamFirst);
+    }
+    CHECK(heapInUse == 0);
+
+    return 0;
+}
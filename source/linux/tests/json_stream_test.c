@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== json_stream_test.c ========
+ *
+ *  Host test of the push-style JSON parser. Each document is parsed with
+ *  Json_parse() in one buffer, then fed to Json_parseChunk() split at every
+ *  single point, byte by byte, and in random chunks. The return code, and
+ *  the Json_build() output on success, must be the same every time. Each
+ *  chunk is copied to its own heap block so a sanitizer build catches reads
+ *  past the chunk.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ti/utils/json/json.h"
+#include "ti/utils/json/json_engine.h"
+#include "test_util.h"
+
+#define TEST_OUT_MAX     1024
+#define TEST_CUTS_MAX    1024
+#define TEST_RAND_SPLITS 200
+
+typedef struct
+{
+    const char *tmpl;
+    const char *doc;
+} TestCase;
+
+static const TestCase cases[] = {
+    {"{\"name\":string,\"age\":int32,\"job\":string,\"citizen\":boolean}",
+     "{\"name\": \"John\", \"age\": 32, \"job\": \"Plumber\", \"citizen\": true}"},
+    /* White space, escapes, null and unknown members */
+    {"{\"name\":string,\"age\":int32,\"job\":string,\"citizen\":boolean}",
+     "  \r\n{\n  \"name\" :\t\"J\\\"o\\\\hn\" ,\n  \"age\" : -1234567 ,\"job\":null,"
+     "\"citizen\":false , \"extra\": {\"a\":[1,2,{\"b\":3}]}, \"x\":\"y\"}\n  "},
+    /* Nested objects and arrays */
+    {"{\"id\":uint32,\"cfg\":{\"mode\":string,\"levels\":[int32,int32,int32,int32],"
+     "\"on\":boolean},\"tags\":[string,string,string]}",
+     "{\"id\":4000000000,\"cfg\":{\"mode\":\"fast\",\"levels\":[1,-2,30000,-400000],"
+     "\"on\":true},\"tags\":[\"a\",\"bb\",\"ccc\"]}"},
+    /* Raw values */
+    {"{\"id\":uint32,\"blob\":raw,\"after\":int32}",
+     "{\"id\":7,\"blob\":{\"k\":[1,{\"z\":\"}\"}],\"q\":{}} ,\"after\":99}"},
+    {"{\"blob\":raw}", "{\"blob\":{\"k\":1}}"},
+    /* Top-level array */
+    {"{\"#\":[int32,int32,int32]}", "  [10, 20,30]"},
+    /* Too deep nesting is skipped */
+    {"{\"a\":{\"b\":{\"c\":int32}}}",
+     "{\"a\":{\"b\":{\"c\":5}},\"deep\":[[[[[[[[[[[[[[[[[[[[[[[[1]]]]]]]]]]]]]]]]]]]]]]]]}"},
+    {"{\"a\":{\"b\":{\"c\":int32}}}",
+     "{\"d0\":{\"d1\":{\"d2\":{\"d3\":{\"d4\":{\"d5\":{\"d6\":{\"d7\":{\"d8\":{\"d9\":"
+     "{\"d10\":{\"d11\":{\"d12\":{\"d13\":{\"d14\":{\"d15\":{\"d16\":{\"d17\":{\"d18\":"
+     "{\"d19\":{\"d20\":{\"d21\":{\"d22\":{\"d23\":{\"v\":1}}}}}}}}}}}}}}}}}}}}}}}},"
+     "\"a\":{\"b\":{\"c\":5}}}"},
+    /* Malformed or truncated */
+    {"{\"name\":string,\"age\":int32}", "{\"name\":\"Jo"},
+    {"{\"name\":string,\"age\":int32}", "{\"name\" \"Jo\",\"age\":3}"},
+    {"{\"name\":string,\"age\":int32}", "{\"name\":\"Jo\",\"age\":3"},
+    {"{\"name\":string,\"age\":int32}", "{\"name\":\"Jo\",\"age\":3}}"},
+    {"{\"name\":string,\"age\":int32}", "{\"name\":\"Jo\",\"age\":3x}"},
+    {"{\"name\":string,\"age\":int32}", ""},
+};
+
+static char refOut[TEST_OUT_MAX];
+static char gotOut[TEST_OUT_MAX];
+static uint16_t cuts[TEST_CUTS_MAX];
+
+static void buildText(Json_Handle obj, char *pOut)
+{
+    uint16_t len = TEST_OUT_MAX - 1;
+
+    CHECK(Json_build(obj, pOut, &len) == JSON_RC__OK);
+    pOut[len] = '\0';
+}
+
+/* Parse doc in the chunks ending at cuts[0..numCuts-1] and at its end */
+static int16_t streamParse(Json_Handle obj, const char *doc, uint16_t numCuts)
+{
+    uint16_t len = strlen(doc);
+    uint16_t prev = 0;
+    Json_Handle parser;
+    int16_t rc;
+    uint16_t i;
+
+    CHECK(Json_createParser(&parser, obj, 0) == JSON_RC__OK);
+    rc = JSON_RC__OK;
+    for (i = 0; (i <= numCuts) && (rc == JSON_RC__OK); i++)
+    {
+        uint16_t end = (i < numCuts) ? cuts[i] : len;
+        char *pChunk = malloc((end - prev) + 1);
+
+        CHECK(pChunk != NULL);
+        memcpy(pChunk, &doc[prev], end - prev);
+        rc = Json_parseChunk(parser, pChunk, end - prev);
+        free(pChunk);
+        prev = end;
+    }
+    if (rc == JSON_RC__OK)
+    {
+        rc = Json_parseFinish(parser);
+    }
+    CHECK(Json_destroyParser(parser) == JSON_RC__OK);
+
+    gotOut[0] = '\0';
+    if (rc == JSON_RC__OK)
+    {
+        buildText(obj, gotOut);
+    }
+    return rc;
+}
+
+static void checkSame(unsigned caseIdx, const char *what, unsigned split, int16_t rcRef,
+                      int16_t rc)
+{
+    if ((rc != rcRef) || ((rcRef == JSON_RC__OK) && (strcmp(refOut, gotOut) != 0)))
+    {
+        printf("FAIL case %u %s %u: rc %d, expected %d\n  expected: %s\n  got:      %s\n",
+               caseIdx, what, split, rc, rcRef, refOut, gotOut);
+        exit(1);
+    }
+}
+
+/* Json_parse() result, the reference the stream must match */
+static int16_t wholeParse(Json_Handle obj, const char *doc)
+{
+    const char *pText = doc;
+    char *pWhole;
+    int16_t rc;
+
+    if (doc[0] == '\0')
+    {
+        /* Json_parse() does not take empty text, the stream finds no value */
+        return JSON_RC__PARSING_FAILURE;
+    }
+
+    while ((*pText != '\0') && (*pText <= ' '))
+    {
+        pText++;
+    }
+    pWhole = malloc(strlen(pText) + 8);
+    CHECK(pWhole != NULL);
+    if (*pText == '[')
+    {
+        /* Same wrapping as Json_parse(), done here since its copy has no
+         * room left for the terminating NUL of sprintf() */
+        sprintf(pWhole, "{\"#\":%s}", pText);
+    }
+    else
+    {
+        strcpy(pWhole, doc);
+    }
+    rc = Json_parse(obj, pWhole, strlen(pWhole));
+    free(pWhole);
+    return rc;
+}
+
+static void testCase(unsigned caseIdx, uint32_t *pSeed)
+{
+    const TestCase *pCase = &cases[caseIdx];
+    uint16_t len = strlen(pCase->doc);
+    Json_Handle tmpl;
+    Json_Handle obj;
+    int16_t rcRef;
+    uint16_t i;
+    unsigned r;
+
+    CHECK(len < TEST_CUTS_MAX);
+    CHECK(Json_createTemplate(&tmpl, pCase->tmpl, strlen(pCase->tmpl)) == JSON_RC__OK);
+    CHECK(Json_createObject(&obj, tmpl, 0) == JSON_RC__OK);
+
+    rcRef = wholeParse(obj, pCase->doc);
+    refOut[0] = '\0';
+    if (rcRef == JSON_RC__OK)
+    {
+        buildText(obj, refOut);
+    }
+    printf("case %u: rc %d %s\n", caseIdx, rcRef, refOut);
+
+    /* Two chunks, split at every point */
+    for (i = 0; i <= len; i++)
+    {
+        cuts[0] = i;
+        checkSame(caseIdx, "split at", i, rcRef, streamParse(obj, pCase->doc, 1));
+    }
+
+    /* One byte per chunk */
+    for (i = 0; i < len; i++)
+    {
+        cuts[i] = i + 1;
+    }
+    checkSame(caseIdx, "bytewise", 0, rcRef, streamParse(obj, pCase->doc, (len > 0) ? len - 1 : 0));
+
+    /* Random chunks of 1 to 7 bytes */
+    for (r = 0; r < TEST_RAND_SPLITS; r++)
+    {
+        uint16_t numCuts = 0;
+        uint16_t pos = 0;
+
+        while ((pos += 1 + (testRand(pSeed) % 7)) < len)
+        {
+            cuts[numCuts++] = pos;
+        }
+        checkSame(caseIdx, "random", r, rcRef, streamParse(obj, pCase->doc, numCuts));
+    }
+
+    CHECK(Json_destroyObject(obj) == JSON_RC__OK);
+    CHECK(Json_destroyTemplate(tmpl) == JSON_RC__OK);
+}
+
+static void testTokenSize(void)
+{
+    const char *pTmpl = "{\"name\":string}";
+    const char *pDoc = "{\"name\":\"0123456789\"}";
+    Json_Handle tmpl;
+    Json_Handle obj;
+    Json_Handle parser;
+
+    CHECK(Json_createTemplate(&tmpl, pTmpl, strlen(pTmpl)) == JSON_RC__OK);
+    CHECK(Json_createObject(&obj, tmpl, 0) == JSON_RC__OK);
+
+    /* A token longer than the token buffer */
+    CHECK(Json_createParser(&parser, obj, 8) == JSON_RC__OK);
+    CHECK(Json_parseChunk(parser, pDoc, strlen(pDoc)) == JSON_RC__PARSING_BUFFER_SIZE_EXCEEDED);
+    CHECK(Json_destroyParser(parser) == JSON_RC__OK);
+
+    /* A token that just fits, quotes included */
+    CHECK(Json_createParser(&parser, obj, 12) == JSON_RC__OK);
+    CHECK(Json_parseChunk(parser, pDoc, strlen(pDoc)) == JSON_RC__OK);
+    CHECK(Json_parseFinish(parser) == JSON_RC__OK);
+    CHECK(Json_destroyParser(parser) == JSON_RC__OK);
+
+    CHECK(Json_parseChunk(0, pDoc, 1) == JSON_RC__INVALID_PARSER_HANDLE);
+
+    CHECK(Json_destroyObject(obj) == JSON_RC__OK);
+    CHECK(Json_destroyTemplate(tmpl) == JSON_RC__OK);
+}
+
+int main(void)
+{
+    uint32_t seed = 1;
+    unsigned i;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        testCase(i, &seed);
+    }
+    testTokenSize();
+
+    printf("PASS\n");
+    return 0;
+}
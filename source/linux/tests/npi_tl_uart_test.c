@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== npi_tl_uart_test.c ========
+ *
+ *  Host test of the NPI UART transport without flow control. Frames are
+ *  fed to the read callback the way the UART driver returns partial reads,
+ *  and every frame must be handed to the TL once, whole and in order:
+ *    - a small frame and the start of a frame that only fits the RX buffer
+ *      from offset 0, in one read
+ *    - a SOF byte at the end of a read, and a read of the SOF alone
+ *    - a length field split across reads
+ *    - frames packed by NPITLUART_writeTransport(), cut at random points
+ *
+ *  The UART driver, the critical sections and the TL buffers of npi_tl.c
+ *  are provided here.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <ti/drivers/uart/UARTCC26XX.h>
+
+#include "npi_data.h"
+#include "npi_util.h"
+#include "npi_tl_uart.h"
+#include "test_util.h"
+
+#define TEST_SOF            0xFE
+#define TEST_MAX_FRAMES     64
+#define TEST_MAX_FRAME_LEN  300
+#define TEST_RANDOM_TRIALS  2000
+
+/* TL buffers, as npi_tl.c defines them */
+uint8_t *npiRxBuf;
+uint8_t *npiTxBuf;
+uint16_t npiBufSize;
+uint16_t npiRxBufOffset;
+
+static uint8_t rxBuf[1024];
+static uint8_t txBuf[1024];
+
+/* UART driver state */
+static UART_Config uartConfig;
+static UART_Callback readCallback;
+static uint8_t *readBuf;
+static size_t readSize;
+static uint8_t wire[1024];
+static size_t wireLen;
+
+/* Frames handed to the TL: length field, command and payload */
+static uint8_t rxFrames[TEST_MAX_FRAMES][TEST_MAX_FRAME_LEN];
+static uint16_t rxFrameLen[TEST_MAX_FRAMES];
+static int numRxFrames;
+
+static uint32_t seed = 0x1B873593U;
+
+void UART_init(void)
+{
+}
+
+UART_Handle UART_open(uint_least8_t index, UART_Params *params)
+{
+    (void)index;
+    readCallback = params->readCallback;
+    return &uartConfig;
+}
+
+void UART_close(UART_Handle handle)
+{
+    (void)handle;
+}
+
+int_fast16_t UART_control(UART_Handle handle, uint_fast16_t cmd, void *arg)
+{
+    (void)handle;
+    (void)arg;
+    CHECK(cmd == UARTCC26XX_CMD_RETURN_PARTIAL_ENABLE);
+    return UART_STATUS_SUCCESS;
+}
+
+int_fast32_t UART_read(UART_Handle handle, void *buffer, size_t size)
+{
+    (void)handle;
+    readBuf = buffer;
+    readSize = size;
+    return 0;
+}
+
+int_fast32_t UART_write(UART_Handle handle, const void *buffer, size_t size)
+{
+    (void)handle;
+    CHECK(size <= sizeof(wire));
+    memcpy(wire, buffer, size);
+    wireLen = size;
+    return 0;
+}
+
+void UART_readCancel(UART_Handle handle)
+{
+    (void)handle;
+}
+
+void UART_writeCancel(UART_Handle handle)
+{
+    (void)handle;
+}
+
+_npiCSKey_t NPIUtil_EnterCS(void)
+{
+    _npiCSKey_t key = {0, 0};
+
+    return key;
+}
+
+void NPIUtil_ExitCS(_npiCSKey_t key)
+{
+    (void)key;
+}
+
+/* npiTransmitCB: the TL takes the frame in place at npiRxBufOffset */
+static void transmitCB(uint16_t rxLen, uint16_t txLen)
+{
+    (void)txLen;
+    if (rxLen == 0)
+    {
+        return;
+    }
+    CHECK(numRxFrames < TEST_MAX_FRAMES);
+    CHECK(rxLen <= TEST_MAX_FRAME_LEN);
+    CHECK(npiRxBufOffset + rxLen <= npiBufSize);
+    memcpy(rxFrames[numRxFrames], &npiRxBuf[npiRxBufOffset], rxLen);
+    rxFrameLen[numRxFrames++] = rxLen;
+}
+
+/* One read returned by the UART driver */
+static void feed(const uint8_t *data, size_t len)
+{
+    CHECK((len > 0) && (len <= readSize));
+    memcpy(readBuf, data, len);
+    readCallback(&uartConfig, readBuf, len);
+}
+
+/* Length field, command and payload of a frame */
+static uint16_t makeFrame(uint8_t *pFrame, uint16_t payloadLen, uint8_t tag)
+{
+    uint16_t i;
+
+    pFrame[0] = (uint8_t)payloadLen;
+    pFrame[1] = (uint8_t)(payloadLen >> 8);
+    pFrame[2] = 0x55;
+    pFrame[3] = tag;
+    for (i = 0; i < payloadLen; i++)
+    {
+        pFrame[4 + i] = (uint8_t)(tag + i);
+    }
+    return payloadLen + 4;
+}
+
+/* SOF, frame and FCS as sent on the line */
+static size_t wireFrame(uint8_t *pOut, const uint8_t *pFrame, uint16_t frameLen)
+{
+    uint8_t fcs = 0;
+    uint16_t i;
+
+    pOut[0] = TEST_SOF;
+    for (i = 0; i < frameLen; i++)
+    {
+        pOut[1 + i] = pFrame[i];
+        fcs ^= pFrame[i];
+    }
+    pOut[1 + frameLen] = fcs;
+    return frameLen + 2;
+}
+
+static void openTransport(uint16_t bufSize)
+{
+    UART_Params params;
+
+    memset(&params, 0, sizeof(params));
+    npiRxBuf = rxBuf;
+    npiTxBuf = txBuf;
+    npiBufSize = bufSize;
+    npiRxBufOffset = 0;
+    numRxFrames = 0;
+    NPITLUART_openTransport(0, &params, transmitCB);
+    NPITLUART_readTransport();
+}
+
+static void checkFrame(int index, const uint8_t *pFrame, uint16_t frameLen)
+{
+    CHECK(index < numRxFrames);
+    CHECK(rxFrameLen[index] == frameLen);
+    CHECK(memcmp(rxFrames[index], pFrame, frameLen) == 0);
+}
+
+/* A whole small frame and the start of a frame that needs the whole buffer */
+static void testTwoFramesInOneRead(void)
+{
+    uint8_t small[16];
+    uint8_t large[80];
+    uint8_t line[128];
+    uint16_t smallLen = makeFrame(small, 2, 0x10);
+    uint16_t largeLen = makeFrame(large, 59, 0x20);
+    size_t lineLen;
+
+    openTransport(64);
+    lineLen = wireFrame(line, small, smallLen);
+    lineLen += wireFrame(&line[lineLen], large, largeLen);
+
+    feed(line, 40);
+    CHECK(numRxFrames == 1);
+    feed(&line[40], lineLen - 40);
+    CHECK(numRxFrames == 2);
+    checkFrame(0, small, smallLen);
+    checkFrame(1, large, largeLen);
+}
+
+/* The SOF of the next frame at the end of a read, and alone in a read */
+static void testSofSplit(void)
+{
+    uint8_t frames[3][16];
+    uint16_t frameLen[3];
+    uint8_t line[64];
+    size_t lineLen = 0;
+    size_t sof1;
+    size_t sof2;
+    int i;
+
+    openTransport(64);
+    for (i = 0; i < 3; i++)
+    {
+        frameLen[i] = makeFrame(frames[i], 3 + i, (uint8_t)(0x30 + i));
+    }
+    lineLen = wireFrame(line, frames[0], frameLen[0]);
+    sof1 = lineLen;
+    lineLen += wireFrame(&line[lineLen], frames[1], frameLen[1]);
+    sof2 = lineLen;
+    lineLen += wireFrame(&line[lineLen], frames[2], frameLen[2]);
+
+    // Frame 0 and the SOF of frame 1
+    feed(line, sof1 + 1);
+    CHECK(numRxFrames == 1);
+    // Frame 1 without its SOF, then the SOF of frame 2 alone
+    feed(&line[sof1 + 1], sof2 - sof1 - 1);
+    CHECK(numRxFrames == 2);
+    feed(&line[sof2], 1);
+    feed(&line[sof2 + 1], lineLen - sof2 - 1);
+    CHECK(numRxFrames == 3);
+    for (i = 0; i < 3; i++)
+    {
+        checkFrame(i, frames[i], frameLen[i]);
+    }
+}
+
+/* The two bytes of the length field in different reads */
+static void testLengthSplit(void)
+{
+    uint8_t frames[2][64];
+    uint16_t frameLen[2];
+    uint8_t line[160];
+    size_t lineLen;
+    size_t start2;
+
+    openTransport(128);
+    frameLen[0] = makeFrame(frames[0], 40, 0x40);
+    frameLen[1] = makeFrame(frames[1], 50, 0x50);
+    lineLen = wireFrame(line, frames[0], frameLen[0]);
+    start2 = lineLen;
+    lineLen += wireFrame(&line[lineLen], frames[1], frameLen[1]);
+
+    // SOF and low length byte of frame 0
+    feed(line, 2);
+    CHECK(numRxFrames == 0);
+    // Frame 0, SOF and low length byte of frame 1
+    feed(&line[2], start2);
+    CHECK(numRxFrames == 1);
+    feed(&line[start2 + 2], lineLen - start2 - 2);
+    CHECK(numRxFrames == 2);
+    checkFrame(0, frames[0], frameLen[0]);
+    checkFrame(1, frames[1], frameLen[1]);
+}
+
+/* Frames packed back to back by the TX side, read back in random pieces */
+static void testRandomStreams(void)
+{
+    static uint8_t frames[TEST_MAX_FRAMES][TEST_MAX_FRAME_LEN];
+    static uint16_t frameLen[TEST_MAX_FRAMES];
+    int trial;
+
+    for (trial = 0; trial < TEST_RANDOM_TRIALS; trial++)
+    {
+        int numFrames = 1 + (testRand(&seed) % 8);
+        uint16_t len = 0;
+        size_t pos = 0;
+        int i;
+
+        openTransport(256);
+        for (i = 0; i < numFrames; i++)
+        {
+            uint16_t payloadLen = testRand(&seed) % 60;
+
+            if (testRand(&seed) % 8 == 0)
+            {
+                // Payload bytes equal to the SOF
+                payloadLen = 3;
+            }
+            frameLen[i] = makeFrame(frames[i], payloadLen, (uint8_t)testRand(&seed));
+            if (payloadLen == 3)
+            {
+                frames[i][5] = TEST_SOF;
+            }
+
+            // Frame at len + 1, after the SOF, then room for the FCS
+            if (i > 0)
+            {
+                len += 2;
+            }
+            memcpy(&txBuf[len + 1], frames[i], frameLen[i]);
+            len += frameLen[i];
+        }
+        NPITLUART_writeTransport(len);
+        CHECK(wireLen == (size_t)len + 2);
+
+        while (pos < wireLen)
+        {
+            size_t chunk = 1 + (testRand(&seed) % 40);
+
+            if (chunk > wireLen - pos)
+            {
+                chunk = wireLen - pos;
+            }
+            feed(&wire[pos], chunk);
+            pos += chunk;
+        }
+
+        CHECK(numRxFrames == numFrames);
+        for (i = 0; i < numFrames; i++)
+        {
+            checkFrame(i, frames[i], frameLen[i]);
+        }
+    }
+}
+
+int main(void)
+{
+    testTwoFramesInOneRead();
+    testSofSplit();
+    testLengthSplit();
+    testRandomStreams();
+
+    printf("PASS\n");
+    return 0;
+}
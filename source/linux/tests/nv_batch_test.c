@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== nv_batch_test.c ========
+ *
+ *  Host test of the NVOCMP writeItems() group write, on the file backed NVS
+ *  region. NVS_write() and NVS_erase() are wrapped at link time to count the
+ *  flash operations, to program bits from 1 to 0 only as the flash does, and
+ *  to cut the power after a given number of operations.
+ *
+ *  Usage: nv_batch_test <nv file>
+ *
+ *  The power loss cases run the driver in child processes that share the NV
+ *  file: one stores a group and is stopped part way, the next initializes
+ *  NVOCMP from what was left and must find either the whole group or none
+ *  of it.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <ti/drivers/NVS.h>
+#include <ti/common/nv/nvocmp.h>
+
+#include "nvs/NVSRAMLinux.h"
+#include "test_util.h"
+
+#define REGION_SIZE      (NVSRAMLinux_SECTOR_SIZE * NVSRAMLinux_NUM_SECTORS)
+#define GROUP_ITEMS      3
+/* Largest group, the default NVOCMP_BATCHMAX */
+#define GROUP_MAX        8
+#define ITEM_MAX         100
+#define MODEL_IDS        24
+#define MODEL_OPS        20000
+#define POWER_CUTS_MAX   400
+
+/* Child exit codes of the power loss cases */
+#define EXIT_POWER_LOST  7
+#define EXIT_STORED      5
+#define EXIT_GEN_BASE    20
+
+int_fast16_t __real_NVS_write(NVS_Handle handle, size_t offset, void *buffer, size_t bufferSize, uint_fast16_t flags);
+int_fast16_t __real_NVS_erase(NVS_Handle handle, size_t offset, size_t size);
+
+static NVINTF_nvFuncts_t nv;
+static uint32_t seed = 0x2B7E1516U;
+static unsigned long flashWrites;
+static unsigned long flashErases;
+/* Operations left before the power is cut, or -1 */
+static long powerBudget = -1;
+
+/* Bond record, CCCD table and CSRK sized items */
+static const uint16_t groupLen[GROUP_ITEMS] = {40, 5, 100};
+
+int_fast16_t __wrap_NVS_write(NVS_Handle handle, size_t offset, void *buffer, size_t bufferSize, uint_fast16_t flags)
+{
+    uint8_t cell[ITEM_MAX + 64];
+    const uint8_t *src = buffer;
+    size_t len = bufferSize;
+    size_t i;
+
+    CHECK(bufferSize <= sizeof(cell));
+    flashWrites++;
+    if (powerBudget == 0)
+    {
+        // Torn write: only a random part of the bytes is programmed
+        len = testRand(&seed) % (bufferSize + 1);
+    }
+    else if (powerBudget > 0)
+    {
+        powerBudget--;
+    }
+
+    NVS_read(handle, offset, cell, len);
+    for (i = 0; i < len; i++)
+    {
+        cell[i] &= src[i];
+    }
+    if (len > 0)
+    {
+        CHECK(__real_NVS_write(handle, offset, cell, len, flags & ~NVS_WRITE_PRE_VERIFY) == NVS_STATUS_SUCCESS);
+    }
+
+    if (powerBudget == 0 && len < bufferSize)
+    {
+        _exit(EXIT_POWER_LOST);
+    }
+    return (NVS_STATUS_SUCCESS);
+}
+
+int_fast16_t __wrap_NVS_erase(NVS_Handle handle, size_t offset, size_t size)
+{
+    flashErases++;
+    if (powerBudget == 0)
+    {
+        _exit(EXIT_POWER_LOST);
+    }
+    else if (powerBudget > 0)
+    {
+        powerBudget--;
+    }
+    return (__real_NVS_erase(handle, offset, size));
+}
+
+static NVINTF_itemID_t itemId(uint16_t itemID, uint16_t subID)
+{
+    NVINTF_itemID_t id = {.systemID = NVINTF_SYSID_BLE, .itemID = itemID, .subID = subID};
+
+    return id;
+}
+
+static void fill(uint8_t *buf, uint16_t len, int gen)
+{
+    uint16_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = (uint8_t)((gen * 31) + i);
+    }
+}
+
+/*
+ *  ======== Model test ========
+ *  Random single writes, groups, deletes and reads, checked against a copy
+ *  of the stored items. Runs in a child so the NV file starts erased.
+ */
+static uint8_t model[MODEL_IDS][ITEM_MAX];
+static uint16_t modelLen[MODEL_IDS];
+
+static void checkModel(int n)
+{
+    uint8_t buf[ITEM_MAX];
+    uint32_t len = nv.getItemLen(itemId(0x20, n));
+
+    CHECK(len == modelLen[n]);
+    if (len > 0)
+    {
+        CHECK(nv.readItem(itemId(0x20, n), 0, (uint16_t)len, buf) == NVINTF_SUCCESS);
+        CHECK(memcmp(buf, model[n], len) == 0);
+    }
+}
+
+static void storeGroup(void)
+{
+    static uint8_t buf[GROUP_MAX][ITEM_MAX];
+    NVINTF_batchItem_t items[GROUP_MAX];
+    int ids[GROUP_MAX];
+    int count = 1 + (testRand(&seed) % GROUP_MAX);
+    int i;
+    int j;
+
+    for (i = 0; i < count; i++)
+    {
+        // Distinct items, each of random length and content
+        do
+        {
+            ids[i] = testRand(&seed) % MODEL_IDS;
+            for (j = 0; (j < i) && (ids[j] != ids[i]); j++)
+            {
+            }
+        } while (j < i);
+        items[i].id     = itemId(0x20, ids[i]);
+        items[i].len    = 1 + (testRand(&seed) % ITEM_MAX);
+        items[i].buffer = buf[i];
+        for (j = 0; j < items[i].len; j++)
+        {
+            buf[i][j] = (uint8_t)testRand(&seed);
+        }
+    }
+    CHECK(nv.writeItems(items, (uint8_t)count) == NVINTF_SUCCESS);
+    for (i = 0; i < count; i++)
+    {
+        memcpy(model[ids[i]], buf[i], items[i].len);
+        modelLen[ids[i]] = items[i].len;
+    }
+}
+
+static void testModel(void)
+{
+    uint8_t buf[ITEM_MAX];
+    int i;
+
+    for (i = 0; i < MODEL_OPS; i++)
+    {
+        int n = testRand(&seed) % MODEL_IDS;
+        uint32_t op = testRand(&seed) % 10;
+
+        if (op < 3)
+        {
+            storeGroup();
+        }
+        else if (op < 5)
+        {
+            uint16_t len = 1 + (testRand(&seed) % ITEM_MAX);
+
+            fill(buf, len, (int)testRand(&seed));
+            CHECK(nv.writeItem(itemId(0x20, n), len, buf) == NVINTF_SUCCESS);
+            memcpy(model[n], buf, len);
+            modelLen[n] = len;
+        }
+        else if (op < 6)
+        {
+            CHECK(nv.deleteItem(itemId(0x20, n)) == (modelLen[n] ? NVINTF_SUCCESS : NVINTF_NOTFOUND));
+            modelLen[n] = 0;
+        }
+        else
+        {
+            checkModel(n);
+        }
+    }
+    for (i = 0; i < MODEL_IDS; i++)
+    {
+        checkModel(i);
+    }
+}
+
+/*
+ *  ======== Flash operations ========
+ *  A bond sized group replacing stored items, against the same items written
+ *  one by one. The group pays for its atomicity with the commit of its
+ *  marker, the VALID bit of each item and the retirement of the marker.
+ */
+static void testFlashOps(void)
+{
+    uint8_t buf[GROUP_ITEMS][ITEM_MAX];
+    NVINTF_batchItem_t items[GROUP_ITEMS];
+    unsigned long single;
+    unsigned long group;
+    int i;
+
+    for (i = 0; i < GROUP_ITEMS; i++)
+    {
+        fill(buf[i], groupLen[i], 1);
+        items[i].id     = itemId(0x30, i);
+        items[i].len    = groupLen[i];
+        items[i].buffer = buf[i];
+        CHECK(nv.writeItem(items[i].id, items[i].len, items[i].buffer) == NVINTF_SUCCESS);
+    }
+    CHECK(nv.compactNV(0) == NVINTF_SUCCESS);
+
+    flashWrites = 0;
+    for (i = 0; i < GROUP_ITEMS; i++)
+    {
+        fill(buf[i], groupLen[i], 2);
+        CHECK(nv.writeItem(items[i].id, items[i].len, items[i].buffer) == NVINTF_SUCCESS);
+    }
+    single = flashWrites;
+
+    CHECK(nv.compactNV(0) == NVINTF_SUCCESS);
+    flashWrites = 0;
+    for (i = 0; i < GROUP_ITEMS; i++)
+    {
+        fill(buf[i], groupLen[i], 3);
+    }
+    CHECK(nv.writeItems(items, GROUP_ITEMS) == NVINTF_SUCCESS);
+    group = flashWrites;
+
+    printf("%d item bond update: %lu NVS_write() one by one, %lu with writeItems()\n", GROUP_ITEMS, single, group);
+    CHECK(group <= single + GROUP_ITEMS + 2);
+}
+
+/*
+ *  ======== Power loss ========
+ */
+static const char *nvFile;
+
+static int runChild(void (*fxn)(int arg), int arg)
+{
+    pid_t pid;
+    int status;
+
+    fflush(stdout);
+    pid = fork();
+    CHECK(pid >= 0);
+    if (pid == 0)
+    {
+        CHECK(NVSRAMLinux_setBackingFile(nvFile) == NVS_STATUS_SUCCESS);
+        NVOCMP_loadApiPtrsExt(&nv);
+        CHECK(nv.initNV(NULL) == NVINTF_SUCCESS);
+        fxn(arg);
+        fflush(stdout);
+        _exit(0);
+    }
+    CHECK(waitpid(pid, &status, 0) == pid);
+    CHECK(WIFEXITED(status));
+    return (WEXITSTATUS(status));
+}
+
+static void childModel(int arg)
+{
+    testModel();
+    testFlashOps();
+}
+
+/* Other items, for compaction to move, then generation 1 of the group */
+static void childSetup(int arg)
+{
+    uint8_t buf[ITEM_MAX];
+    int i;
+
+    for (i = 0; i < 40; i++)
+    {
+        fill(buf, 30, i);
+        CHECK(nv.writeItem(itemId(0x40, i % 10), 30, buf) == NVINTF_SUCCESS);
+    }
+    for (i = 0; i < GROUP_ITEMS; i++)
+    {
+        fill(buf, groupLen[i], 1);
+        CHECK(nv.writeItem(itemId(0x30, i), groupLen[i], buf) == NVINTF_SUCCESS);
+    }
+}
+
+/* Generation 2 of the group, with the power cut after arg operations */
+static void childStore(int arg)
+{
+    uint8_t buf[GROUP_ITEMS][ITEM_MAX];
+    NVINTF_batchItem_t items[GROUP_ITEMS];
+    int i;
+
+    for (i = 0; i < GROUP_ITEMS; i++)
+    {
+        fill(buf[i], groupLen[i], 2);
+        items[i].id     = itemId(0x30, i);
+        items[i].len    = groupLen[i];
+        items[i].buffer = buf[i];
+    }
+    seed += arg;
+    powerBudget = arg;
+    CHECK(nv.writeItems(items, GROUP_ITEMS) == NVINTF_SUCCESS);
+    powerBudget = -1;
+    _exit(EXIT_STORED);
+}
+
+/* Exits with EXIT_GEN_BASE plus the generation found for the whole group */
+static int groupGeneration(void)
+{
+    uint8_t buf[ITEM_MAX];
+    uint8_t expect[ITEM_MAX];
+    int found = -1;
+    int gen;
+    int i;
+
+    for (i = 0; i < GROUP_ITEMS; i++)
+    {
+        int match = -1;
+
+        CHECK(nv.getItemLen(itemId(0x30, i)) == groupLen[i]);
+        CHECK(nv.readItem(itemId(0x30, i), 0, groupLen[i], buf) == NVINTF_SUCCESS);
+        for (gen = 1; gen <= 2; gen++)
+        {
+            fill(expect, groupLen[i], gen);
+            if (memcmp(buf, expect, groupLen[i]) == 0)
+            {
+                match = gen;
+            }
+        }
+        CHECK(match > 0);
+        CHECK((found < 0) || (found == match));
+        found = match;
+    }
+    return (found);
+}
+
+static void childCheck(int arg)
+{
+    uint8_t buf[ITEM_MAX];
+    int gen = groupGeneration();
+    int i;
+
+    // The group must survive compactions of the recovered pages
+    for (i = 0; i < 300; i++)
+    {
+        fill(buf, 30, i);
+        CHECK(nv.writeItem(itemId(0x40, i % 10), 30, buf) == NVINTF_SUCCESS);
+    }
+    CHECK(groupGeneration() == gen);
+    _exit(EXIT_GEN_BASE + gen);
+}
+
+static void testPowerLoss(void)
+{
+    static uint8_t snapshot[REGION_SIZE];
+    int oldGroups = 0;
+    int newGroups = 0;
+    FILE *fp;
+    int cut;
+
+    CHECK(runChild(childSetup, 0) == 0);
+    fp = fopen(nvFile, "rb");
+    CHECK(fp != NULL);
+    CHECK(fread(snapshot, 1, REGION_SIZE, fp) == REGION_SIZE);
+    fclose(fp);
+
+    for (cut = 0; cut < POWER_CUTS_MAX; cut++)
+    {
+        int store;
+        int check;
+
+        fp = fopen(nvFile, "r+b");
+        CHECK(fp != NULL);
+        CHECK(fwrite(snapshot, 1, REGION_SIZE, fp) == REGION_SIZE);
+        fclose(fp);
+
+        store = runChild(childStore, cut);
+        CHECK((store == EXIT_POWER_LOST) || (store == EXIT_STORED));
+        check = runChild(childCheck, 0);
+        CHECK((check == EXIT_GEN_BASE + 1) || (check == EXIT_GEN_BASE + 2));
+        if (check == EXIT_GEN_BASE + 1)
+        {
+            CHECK(store == EXIT_POWER_LOST);
+            oldGroups++;
+        }
+        else
+        {
+            newGroups++;
+        }
+        if (store == EXIT_STORED)
+        {
+            break;
+        }
+    }
+    CHECK(cut < POWER_CUTS_MAX);
+    printf("%d power cuts: %d left the old group, %d the new one\n", cut, oldGroups, newGroups);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        printf("usage: %s <nv file>\n", argv[0]);
+        return 2;
+    }
+    nvFile = argv[1];
+
+    unlink(nvFile);
+    CHECK(runChild(childModel, 0) == 0);
+
+    unlink(nvFile);
+    testPowerLoss();
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== nv_index_bench.c ========
+ *
+ *  Item lookup latency of NVOCMP on the RAM-backed NVS region. The same
+ *  source is built against NVOCMP with and without NVOCMP_RAM_INDEX; each
+ *  build first runs random writes, deletes and reads against a model of the
+ *  stored items, then times getItemLen() and readItem() of random items once
+ *  the pages hold many superseded copies.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <ti/common/nv/nvocmp.h>
+
+#include "test_util.h"
+
+#define BENCH_ITEMS      48
+#define BENCH_ITEM_MAX   64
+#define BENCH_MODEL_OPS  20000
+#define BENCH_LOOKUPS    50000
+
+#ifdef NVOCMP_RAM_INDEX
+    #define BENCH_VARIANT "with RAM index"
+#else
+    #define BENCH_VARIANT "without RAM index"
+#endif
+
+static NVINTF_nvFuncts_t nv;
+static uint8_t model[BENCH_ITEMS][BENCH_ITEM_MAX];
+static uint16_t modelLen[BENCH_ITEMS];
+static uint32_t seed = 0x1D3A5E77U;
+
+static NVINTF_itemID_t itemId(int n)
+{
+    NVINTF_itemID_t id = {.systemID = NVINTF_SYSID_BLE, .itemID = 0x20 + (n / 8), .subID = n % 8};
+
+    return id;
+}
+
+static void writeRandom(int n)
+{
+    uint8_t buf[BENCH_ITEM_MAX];
+    uint16_t len = 1 + (testRand(&seed) % BENCH_ITEM_MAX);
+    uint16_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = (uint8_t)testRand(&seed);
+    }
+    CHECK(nv.writeItem(itemId(n), len, buf) == NVINTF_SUCCESS);
+    memcpy(model[n], buf, len);
+    modelLen[n] = len;
+}
+
+static void checkItem(int n)
+{
+    uint8_t buf[BENCH_ITEM_MAX];
+    uint32_t len = nv.getItemLen(itemId(n));
+
+    CHECK(len == modelLen[n]);
+    if (len == 0)
+    {
+        CHECK(nv.readItem(itemId(n), 0, 1, buf) == NVINTF_NOTFOUND);
+        return;
+    }
+    CHECK(nv.readItem(itemId(n), 0, (uint16_t)len, buf) == NVINTF_SUCCESS);
+    CHECK(memcmp(buf, model[n], len) == 0);
+}
+
+/* Random operations, compacting the pages many times over */
+static void testModel(void)
+{
+    int i;
+
+    for (i = 0; i < BENCH_MODEL_OPS; i++)
+    {
+        int n = testRand(&seed) % BENCH_ITEMS;
+        uint32_t op = testRand(&seed) % 10;
+
+        if (op < 4)
+        {
+            writeRandom(n);
+        }
+        else if (op < 5)
+        {
+            CHECK(nv.deleteItem(itemId(n)) == (modelLen[n] ? NVINTF_SUCCESS : NVINTF_NOTFOUND));
+            modelLen[n] = 0;
+        }
+        else
+        {
+            checkItem(n);
+        }
+    }
+    for (i = 0; i < BENCH_ITEMS; i++)
+    {
+        checkItem(i);
+    }
+}
+
+static void benchLookups(void)
+{
+    uint8_t buf[BENCH_ITEM_MAX];
+    uint64_t t0;
+    uint64_t elapsed;
+    int i;
+
+    // Every item stored, then rewritten until the active page is nearly full
+    // of superseded copies, the worst case for the page traversal
+    for (i = 0; i < BENCH_ITEMS; i++)
+    {
+        writeRandom(i);
+    }
+    CHECK(nv.compactNV(0) == NVINTF_SUCCESS);
+    for (i = 0; i < BENCH_ITEMS; i++)
+    {
+        writeRandom(i % 4);
+    }
+
+    t0 = testNowNs();
+    for (i = 0; i < BENCH_LOOKUPS; i++)
+    {
+        int n = testRand(&seed) % BENCH_ITEMS;
+
+        CHECK(nv.getItemLen(itemId(n)) == modelLen[n]);
+        CHECK(nv.readItem(itemId(n), 0, modelLen[n], buf) == NVINTF_SUCCESS);
+    }
+    elapsed = testNowNs() - t0;
+
+    printf("%d items, %s: %.0f ns per getItemLen() + readItem()\n",
+           BENCH_ITEMS, BENCH_VARIANT, (double)elapsed / BENCH_LOOKUPS);
+    for (i = 0; i < BENCH_ITEMS; i++)
+    {
+        checkItem(i);
+    }
+}
+
+int main(void)
+{
+    NVOCMP_loadApiPtrsExt(&nv);
+    CHECK(nv.initNV(NULL) == NVINTF_SUCCESS);
+
+    testModel();
+    benchLookups();
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== oad_stream_test.c ========
+ *
+ *  Host round-trip test of the compressed and delta OAD image streams of
+ *  sw_update.c. The test first writes a running image and a new image
+ *  edited from it; CTest packs the new image with tools/oad/oad_image_pack.py,
+ *  alone and against the running image, and the test then writes both
+ *  streams back through SwUpdate_WriteBlock() and compares the flash with
+ *  the new image. Streams that would write past the image, or end before
+ *  it, must be rejected.
+ *
+ *  Usage: oad_stream_test <file prefix> [images]
+ *
+ *  Files: <prefix>_base.bin and <prefix>_image.bin, written with "images",
+ *  and the <prefix>_image.oadz and <prefix>_image.oadd streams of the packer.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hal_types.h"
+#include "comdef.h"
+#include "flash_interface.h"
+#include "ti/bleapp/util/sw_update/sw_update.h"
+#include "icall_host.h"
+#include "sw_update_host.h"
+#include "test_util.h"
+
+#define TEST_BODY_LEN   (60 * 1024)
+#define TEST_IMAGE_MAX  (TEST_BODY_LEN + 0x1000)
+#define TEST_STREAM_MAX (2 * TEST_IMAGE_MAX)
+
+#define OP_LITERAL      0
+#define OP_COPY         1
+#define LEN_MASK        0x3F
+#define MIN_COPY        4
+#define TEST_PATH_MAX   512
+
+static uint8_t oldBody[TEST_BODY_LEN];
+static uint8_t newBody[TEST_BODY_LEN];
+static uint8_t image[TEST_IMAGE_MAX];
+static uint32_t imgLen;
+static uint8_t stream[TEST_STREAM_MAX];
+
+static const char *filePrefix;
+
+/* Files shared with the packer */
+
+static const char *filePath(const char *suffix)
+{
+    static char path[TEST_PATH_MAX];
+
+    CHECK(snprintf(path, sizeof(path), "%s%s", filePrefix, suffix) < (int)sizeof(path));
+    return path;
+}
+
+static uint32_t readFile(const char *suffix, uint8_t *pBuf, uint32_t max)
+{
+    FILE *fp = fopen(filePath(suffix), "rb");
+    size_t len;
+
+    CHECK(fp != NULL);
+    len = fread(pBuf, 1, max, fp);
+    // The whole file fits
+    CHECK(fgetc(fp) == EOF);
+    fclose(fp);
+    return (uint32_t)len;
+}
+
+static void writeFile(const char *suffix, const uint8_t *pData, uint32_t len)
+{
+    FILE *fp = fopen(filePath(suffix), "wb");
+
+    CHECK(fp != NULL);
+    CHECK(fwrite(pData, 1, len, fp) == len);
+    CHECK(fclose(fp) == 0);
+}
+
+/* Hand-built streams */
+
+static uint32_t putVarint(uint8_t *p, uint32_t value)
+{
+    uint32_t n = 0;
+
+    while (value >= 0x80)
+    {
+        p[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    p[n++] = (uint8_t)value;
+    return n;
+}
+
+static uint32_t putToken(uint8_t *p, uint8_t op, uint32_t len, uint32_t bias)
+{
+    len -= bias;
+    if (len < LEN_MASK)
+    {
+        p[0] = (uint8_t)((op << 6) | len);
+        return 1;
+    }
+    p[0] = (uint8_t)((op << 6) | LEN_MASK);
+    return 1 + putVarint(p + 1, len - LEN_MASK);
+}
+
+static uint32_t putLiterals(uint8_t *p, const uint8_t *pData, uint32_t len)
+{
+    uint32_t n = 0;
+
+    if (len > 0)
+    {
+        n = putToken(p, OP_LITERAL, len, 1);
+        memcpy(p + n, pData, len);
+        n += len;
+    }
+    return n;
+}
+
+/* Decoder side */
+
+static Status_t writeStream(uint8_t format, uint32_t len, uint16_t blkLen)
+{
+    Status_t status;
+    uint32_t pos;
+
+    CHECK(SwUpdate_CheckImageHeader(image) > 0);
+    status = SwUpdate_SetImageFormat(format, len);
+    for (pos = 0; (SUCCESS == status) && (pos < len); pos += blkLen)
+    {
+        uint16_t n = (len - pos > blkLen) ? blkLen : (uint16_t)(len - pos);
+
+        status = SwUpdate_WriteBlock(pos, n, &stream[pos]);
+    }
+    return status;
+}
+
+/* Nothing written after the image, nor erased: the flash is not erased at 0 */
+static void checkNothingPast(uint32_t imgLen)
+{
+    uint32_t end = (imgLen + INTFLASH_PAGE_SIZE - 1) & INTFLASH_PAGE_MASK;
+    uint32_t i;
+
+    for (i = end; i < end + 2 * INTFLASH_PAGE_SIZE; i++)
+    {
+        CHECK(0 == swUpdateHostFlash[i]);
+    }
+}
+
+static void testRoundTrip(uint8_t format, const char *suffix)
+{
+    static const uint16_t blkLens[] = {1, 17, 240, INTFLASH_PAGE_SIZE};
+    uint32_t len = readFile(suffix, stream, sizeof(stream));
+    uint32_t i;
+
+    printf("%s: image %u bytes, stream %u bytes\n", suffix, imgLen, len);
+
+    for (i = 0; i < sizeof(blkLens) / sizeof(blkLens[0]); i++)
+    {
+        swUpdateHostFlashReset(0);
+        CHECK(writeStream(format, len, blkLens[i]) == SUCCESS);
+        CHECK(0 == memcmp(swUpdateHostFlash, image, imgLen));
+        checkNothingPast(imgLen);
+        CHECK(SwUpdate_VerifyImage() == SUCCESS);
+    }
+}
+
+static void testBounds(void)
+{
+    uint32_t len;
+
+    // One literal byte past the image
+    len = putLiterals(stream, image, imgLen);
+    len += putLiterals(&stream[len], image, 1);
+    swUpdateHostFlashReset(0);
+    CHECK(writeStream(SW_UPDATE_IMG_FORMAT_PACKED, len, 240) != SUCCESS);
+    checkNothingPast(imgLen);
+
+    // A copy running past the image
+    len = putLiterals(stream, image, imgLen - 8);
+    len += putToken(&stream[len], OP_COPY, 16, MIN_COPY);
+    len += putVarint(&stream[len], 100);
+    swUpdateHostFlashReset(0);
+    CHECK(writeStream(SW_UPDATE_IMG_FORMAT_PACKED, len, 240) != SUCCESS);
+    checkNothingPast(imgLen);
+
+    // A huge copy length, from a varint
+    len = putLiterals(stream, image, 100);
+    len += putToken(&stream[len], OP_COPY, 0x7FFFFFF0, MIN_COPY);
+    len += putVarint(&stream[len], 50);
+    swUpdateHostFlashReset(0);
+    CHECK(writeStream(SW_UPDATE_IMG_FORMAT_PACKED, len, 240) != SUCCESS);
+    checkNothingPast(imgLen);
+
+    // A stream that ends before the image
+    len = putLiterals(stream, image, imgLen - 1);
+    swUpdateHostFlashReset(0);
+    CHECK(writeStream(SW_UPDATE_IMG_FORMAT_PACKED, len, 240) != SUCCESS);
+
+    // No stream
+    CHECK(SwUpdate_CheckImageHeader(image) > 0);
+    CHECK(SwUpdate_SetImageFormat(SW_UPDATE_IMG_FORMAT_PACKED, 0) == INVALIDPARAMETER);
+
+    // Raw blocks past the image
+    CHECK(SwUpdate_CheckImageHeader(image) == (int)imgLen);
+    CHECK(SwUpdate_WriteBlock(imgLen - 4, 4, image) == FLASH_SUCCESS);
+    CHECK(SwUpdate_WriteBlock(imgLen - 4, 5, image) == FLASH_FAILURE);
+    CHECK(SwUpdate_WriteBlock(imgLen + 1, 1, image) == FLASH_FAILURE);
+}
+
+/* Bodies with repeated runs, the new one edited from the old one */
+static void makeImages(void)
+{
+    uint32_t seed = 17;
+    uint32_t src;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(oldBody);)
+    {
+        uint32_t run = 8 + (testRand(&seed) % 32);
+
+        if ((i > 4096) && (testRand(&seed) % 4))
+        {
+            uint32_t src = testRand(&seed) % (i - run);
+
+            for (; run > 0 && i < sizeof(oldBody); run--)
+            {
+                oldBody[i++] = oldBody[src++];
+            }
+        }
+        else
+        {
+            oldBody[i++] = (uint8_t)testRand(&seed);
+        }
+    }
+    // Code moved both ways, with runs repeated and removed, and a few edits
+    for (i = 0, src = 0; i < sizeof(newBody); i++)
+    {
+        uint32_t r = testRand(&seed) % 512;
+        uint32_t move = 1 + (testRand(&seed) % 8);
+
+        if ((r == 0) && (src >= move))
+        {
+            src -= move;
+        }
+        else if (r == 1)
+        {
+            src += move;
+        }
+        newBody[i] = ((r == 2) || (src >= sizeof(oldBody))) ? (uint8_t)testRand(&seed) : oldBody[src];
+        src++;
+    }
+
+    writeFile("_base.bin", image, swUpdateHostMakeImage(image, oldBody, sizeof(oldBody)));
+    writeFile("_image.bin", image, swUpdateHostMakeImage(image, newBody, sizeof(newBody)));
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t baseLen;
+
+    if (argc < 2)
+    {
+        printf("usage: %s <file prefix> [images]\n", argv[0]);
+        return 2;
+    }
+    filePrefix = argv[1];
+
+    if ((argc > 2) && (0 == strcmp(argv[2], "images")))
+    {
+        makeImages();
+        printf("PASS\n");
+        return 0;
+    }
+
+    baseLen = readFile("_base.bin", swUpdateHostBaseImage, sizeof(swUpdateHostBaseImage));
+    CHECK(SW_UPDATE_IMAGE_LENGTH((struct image_header *)swUpdateHostBaseImage) == baseLen);
+    imgLen = readFile("_image.bin", image, sizeof(image));
+    CHECK(SW_UPDATE_IMAGE_LENGTH((struct image_header *)image) == imgLen);
+
+    CHECK(SwUpdate_Open(SW_UPDATE_SOURCE_OAD) == FLASH_SUCCESS);
+    testRoundTrip(SW_UPDATE_IMG_FORMAT_PACKED, "_image.oadz");
+    testRoundTrip(SW_UPDATE_IMG_FORMAT_DELTA, "_image.oadd");
+    testBounds();
+    SwUpdate_Close();
+
+    // Only the module data stays allocated
+    CHECK(1 == icallHostBlocks);
+
+    printf("PASS\n");
+    return 0;
+}
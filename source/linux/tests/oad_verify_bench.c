@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== oad_verify_bench.c ========
+ *
+ *  Host test and benchmark of the OAD image verification of sw_update.c
+ *  (SW_UPDATE_STREAM_VERIFY): the image length given to the OAD profile,
+ *  the digest computed while the blocks are written, and the fallback that
+ *  hashes the image back from flash.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hal_types.h"
+#include "comdef.h"
+#include "flash_interface.h"
+#include "ti/bleapp/util/sw_update/sw_update.h"
+#include "icall_host.h"
+#include "sw_update_host.h"
+#include "test_util.h"
+
+#define BENCH_BODY_LEN  (200 * 1024)
+#define BENCH_BLOCK_LEN 240
+#define BENCH_RUNS      20
+
+// Defined by sw_update.c, sw_update.h declares it as SwUpdate_EraseFlash
+extern Status_t SwUpdate_EraseImageSlot(uint8 imageSlot);
+
+static uint8_t body[BENCH_BODY_LEN];
+static uint8_t image[BENCH_BODY_LEN + 0x1000];
+
+/* Download the image with OAD sized blocks, swapping two blocks if asked */
+static uint32_t download(uint32_t imgLen, int outOfOrder)
+{
+    uint32_t addr;
+
+    CHECK(SwUpdate_CheckImageHeader(image) == (int)imgLen);
+    CHECK(SwUpdate_EraseImageSlot(INT_PRIMARY_SLOT) == FLASH_SUCCESS);
+    for (addr = 0; addr < imgLen; addr += BENCH_BLOCK_LEN)
+    {
+        uint32_t blk = addr;
+        uint16_t len;
+
+        if (outOfOrder && (addr == BENCH_BLOCK_LEN))
+        {
+            blk = 2 * BENCH_BLOCK_LEN;
+        }
+        else if (outOfOrder && (addr == 2 * BENCH_BLOCK_LEN))
+        {
+            blk = BENCH_BLOCK_LEN;
+        }
+        len = (imgLen - blk > BENCH_BLOCK_LEN) ? BENCH_BLOCK_LEN : (uint16_t)(imgLen - blk);
+        CHECK(SwUpdate_WriteBlock(blk, len, &image[blk]) == FLASH_SUCCESS);
+    }
+    return imgLen;
+}
+
+static void bench(const char *name, uint32_t imgLen, int outOfOrder)
+{
+    uint64_t total = 0;
+    uint32_t reads = 0;
+    int run;
+
+    for (run = 0; run < BENCH_RUNS; run++)
+    {
+        uint64_t start;
+
+        download(imgLen, outOfOrder);
+        swUpdateHostReadBytes = 0;
+        start = testNowNs();
+        CHECK(SwUpdate_VerifyImage() == SUCCESS);
+        total += testNowNs() - start;
+        reads = swUpdateHostReadBytes;
+    }
+    printf("verify %-12s image %u bytes: %8.1f us, %6u flash bytes read\n", name, imgLen,
+           (double)total / BENCH_RUNS / 1000.0, reads);
+}
+
+int main(void)
+{
+    struct image_header *pHdr = (struct image_header *)image;
+    struct image_tlv_info info;
+    uint32_t seed = 16;
+    uint32_t imgLen;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(body); i++)
+    {
+        body[i] = (uint8_t)testRand(&seed);
+    }
+    imgLen = swUpdateHostMakeImage(image, body, sizeof(body));
+    swUpdateHostFlashReset(0xFF);
+    CHECK(SwUpdate_Open(SW_UPDATE_SOURCE_OAD) == FLASH_SUCCESS);
+
+    // The download covers the TLV area, that the verification reads
+    CHECK(imgLen == SW_UPDATE_IMAGE_LENGTH(pHdr));
+    CHECK(imgLen == SW_UPDATE_HOST_HDR_SIZE + sizeof(body) + SW_UPDATE_TLV_AREA_SIZE);
+    CHECK(SwUpdate_CheckImageHeader(image) == (int)imgLen);
+    swUpdateHostErases = 0;
+    CHECK(SwUpdate_EraseImageSlot(INT_PRIMARY_SLOT) == FLASH_SUCCESS);
+    CHECK(swUpdateHostErases == (imgLen + INTFLASH_PAGE_SIZE - 1) / INTFLASH_PAGE_SIZE);
+    download(imgLen, 0);
+    CHECK(0 == memcmp(swUpdateHostFlash, image, imgLen));
+    CHECK(SwUpdate_VerifyImage() == SUCCESS);
+
+    // A second verification hashes the image from flash
+    CHECK(SwUpdate_VerifyImage() == SUCCESS);
+
+    // Corrupted body
+    image[SW_UPDATE_HOST_HDR_SIZE + 1000] ^= 1;
+    download(imgLen, 0);
+    CHECK(SwUpdate_VerifyImage() == FAILURE);
+    download(imgLen, 1);
+    CHECK(SwUpdate_VerifyImage() == FAILURE);
+    image[SW_UPDATE_HOST_HDR_SIZE + 1000] ^= 1;
+
+    // A TLV area that does not end the image
+    memcpy(&info, &image[imgLen - SW_UPDATE_TLV_AREA_SIZE], sizeof(info));
+    info.it_tlv_tot -= 4;
+    memcpy(&image[imgLen - SW_UPDATE_TLV_AREA_SIZE], &info, sizeof(info));
+    download(imgLen, 0);
+    CHECK(SwUpdate_VerifyImage() == FAILURE);
+    info.it_tlv_tot += 4;
+    memcpy(&image[imgLen - SW_UPDATE_TLV_AREA_SIZE], &info, sizeof(info));
+
+    bench("in order", imgLen, 0);
+    bench("out of order", imgLen, 1);
+
+    SwUpdate_Close();
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== osal_heap_bench.c ========
+ *
+ *  Replay of recorded OSAL heap traces, built with the first-fit heap and
+ *  with OSALMEM_SIZE_CLASSES. The trace is the output of a
+ *  DPRINTF_OSALHEAPTRACE build; its allocations and frees are replayed in
+ *  order, the content of every block is checked before it is freed, and
+ *  the heap metrics must be back to where they started after each pass.
+ *
+ *  Usage: osal_heap_bench <trace file>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "comdef.h"
+#include "osal.h"
+#include "osal_memory.h"
+
+#include "icall_host.h"
+#include "test_util.h"
+
+#define BENCH_OPS_MAX   100000
+#define BENCH_LIVE_MAX  512
+#define BENCH_MIN_OPS   1000000
+
+#ifdef OSALMEM_SIZE_CLASSES
+    #define BENCH_HEAP "size classes"
+#else
+    #define BENCH_HEAP "first-fit"
+#endif
+
+typedef struct
+{
+    bool alloc;
+    uint16 size;
+    uint16 slot;
+} BenchOp;
+
+static BenchOp ops[BENCH_OPS_MAX];
+static int numOps;
+static int numSlots;
+
+static uint8 *slotPtr[BENCH_LIVE_MAX];
+static uint16 slotSize[BENCH_LIVE_MAX];
+
+void halAssertHandler(void)
+{
+    printf("FAIL HAL_ASSERT\n");
+    exit(1);
+}
+
+/* Turn the trace addresses into slots, reused once freed */
+static void loadTrace(const char *path)
+{
+    static unsigned long slotAddr[BENCH_LIVE_MAX];
+    static bool slotLive[BENCH_LIVE_MAX];
+    char line[256];
+    unsigned long addr;
+    unsigned int size;
+    FILE *fp = fopen(path, "r");
+    int slot;
+
+    CHECK(fp != NULL);
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        if (sscanf(line, "osal_mem_alloc(%u)->%lx", &size, &addr) == 2)
+        {
+            for (slot = 0; (slot < numSlots) && slotLive[slot]; slot++)
+            {
+            }
+            CHECK(slot < BENCH_LIVE_MAX);
+            if (slot == numSlots)
+            {
+                numSlots++;
+            }
+            slotAddr[slot] = addr;
+            slotLive[slot] = true;
+            CHECK(numOps < BENCH_OPS_MAX);
+            ops[numOps++] = (BenchOp){.alloc = true, .size = (uint16)size, .slot = (uint16)slot};
+        }
+        else if (sscanf(line, "osal_mem_free(%lx)", &addr) == 1)
+        {
+            for (slot = 0; (slot < numSlots) && !(slotLive[slot] && (slotAddr[slot] == addr)); slot++)
+            {
+            }
+            // Blocks allocated before the trace started are not replayed
+            if (slot == numSlots)
+            {
+                continue;
+            }
+            slotLive[slot] = false;
+            CHECK(numOps < BENCH_OPS_MAX);
+            ops[numOps++] = (BenchOp){.alloc = false, .slot = (uint16)slot};
+        }
+    }
+    fclose(fp);
+    CHECK(numOps > 0);
+}
+
+static void fillBlock(int slot)
+{
+    uint16 i;
+
+    for (i = 0; i < slotSize[slot]; i++)
+    {
+        slotPtr[slot][i] = (uint8)(slot + i);
+    }
+}
+
+static void checkBlock(int slot)
+{
+    uint16 i;
+
+    for (i = 0; i < slotSize[slot]; i++)
+    {
+        CHECK(slotPtr[slot][i] == (uint8)(slot + i));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t allocNs = 0;
+    uint64_t freeNs  = 0;
+    unsigned long allocs = 0;
+    unsigned long frees  = 0;
+    unsigned long fails  = 0;
+    unsigned long passes = 0;
+    uint16 usedAtStart;
+    uint16 blocksAtStart;
+    void *big;
+    int slot;
+    int i;
+
+    if (argc < 2)
+    {
+        printf("usage: %s <trace file>\n", argv[0]);
+        return 2;
+    }
+    loadTrace(argv[1]);
+
+    osal_mem_init();
+    osal_mem_kick();
+    usedAtStart   = osal_heap_mem_used();
+    blocksAtStart = osal_heap_block_cnt();
+
+    while ((allocs + frees) < BENCH_MIN_OPS)
+    {
+        for (i = 0; i < numOps; i++)
+        {
+            const BenchOp *op = &ops[i];
+            uint64_t t0;
+
+            if (op->alloc)
+            {
+                t0 = testNowNs();
+                slotPtr[op->slot] = osal_mem_alloc(op->size);
+                allocNs += testNowNs() - t0;
+                allocs++;
+                if (slotPtr[op->slot] == NULL)
+                {
+                    fails++;
+                    continue;
+                }
+                slotSize[op->slot] = op->size;
+                fillBlock(op->slot);
+            }
+            else
+            {
+                if (slotPtr[op->slot] == NULL)
+                {
+                    continue;
+                }
+                checkBlock(op->slot);
+                t0 = testNowNs();
+                osal_mem_free(slotPtr[op->slot]);
+                freeNs += testNowNs() - t0;
+                frees++;
+                slotPtr[op->slot] = NULL;
+            }
+            CHECK(icallHostCsDepth == 0);
+        }
+
+        // Blocks the trace kept, as connection state, go back between passes
+        for (slot = 0; slot < numSlots; slot++)
+        {
+            if (slotPtr[slot] != NULL)
+            {
+                checkBlock(slot);
+                osal_mem_free(slotPtr[slot]);
+                slotPtr[slot] = NULL;
+            }
+        }
+        CHECK(osal_heap_mem_used() == usedAtStart);
+        passes++;
+    }
+
+    printf("%s, %d byte heap, %lu passes: %.1f ns per alloc, %.1f ns per free, %lu of %lu allocations failed\n",
+           BENCH_HEAP, MAXMEMHEAP, passes, (double)allocNs / allocs, (double)freeNs / frees, fails, allocs);
+    printf("metrics: %u blocks, %u free, %u max, %u bytes used\n", osal_heap_block_cnt(), osal_heap_block_free(),
+           osal_heap_block_max(), osal_heap_mem_used());
+    CHECK(osal_heap_block_cnt() >= blocksAtStart);
+    CHECK(fails == 0);
+
+    // Nothing is lost to the churn, the big-block region is whole again
+    big = osal_mem_alloc(MAXMEMHEAP / 2);
+    CHECK(big != NULL);
+    osal_mem_free(big);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== osal_timer_bench.c ========
+ *
+ *  Cost of a 1 ms OSAL clock tick against the number of running timers,
+ *  built with the timer list and with the OSAL_TIMER_WHEEL backend. Reports
+ *  the time and the critical sections taken per tick.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "comdef.h"
+#include "osal.h"
+#include "osal_timers.h"
+
+#include "icall_host.h"
+#include "test_util.h"
+
+#define BENCH_TICKS 100000
+
+#ifdef OSAL_TIMER_WHEEL
+    #define BENCH_BACKEND "wheel"
+#else
+    #define BENCH_BACKEND "list"
+#endif
+
+static const int benchTimers[] = {8, 16, 32, 64, 128, 256};
+
+static uint32 events;
+static uint32 criticalSections;
+
+void *osal_mem_alloc(uint16 size)
+{
+    return (malloc(size));
+}
+
+void osal_mem_free(void *ptr)
+{
+    free(ptr);
+}
+
+uint8 osal_set_event(uint8 task_id, uint32 event_flag)
+{
+    if (event_flag != 0)
+    {
+        events++;
+    }
+    return (SUCCESS);
+}
+
+uint32 TimerElapsed(void)
+{
+    return (0);
+}
+
+static void countCriticalSection(void)
+{
+    criticalSections++;
+}
+
+static uint32 period(int i)
+{
+    return (100 + ((i * 37) % 5000));
+}
+
+int main(void)
+{
+    unsigned int n;
+
+    osalTimerInit();
+    icallHostCsExitHook = countCriticalSection;
+
+    for (n = 0; n < sizeof(benchTimers) / sizeof(benchTimers[0]); n++)
+    {
+        int timers       = benchTimers[n];
+        uint32 expected  = 0;
+        uint64_t t0;
+        uint64_t elapsed;
+        int i;
+
+        // Reload timers, as connection and GATT timeouts
+        for (i = 0; i < timers; i++)
+        {
+            CHECK(osal_start_reload_timer(i % 16, 1 << (i / 16), period(i)) == SUCCESS);
+            expected += BENCH_TICKS / period(i);
+        }
+
+        events           = 0;
+        criticalSections = 0;
+        t0               = testNowNs();
+        for (i = 0; i < BENCH_TICKS; i++)
+        {
+            osalTimerUpdate(1);
+        }
+        elapsed = testNowNs() - t0;
+
+        printf("%s, %3d timers: %6.1f ns and %5.1f critical sections per tick\n", BENCH_BACKEND, timers,
+               (double)elapsed / BENCH_TICKS, (double)criticalSections / BENCH_TICKS);
+        CHECK(events == expected);
+
+        for (i = 0; i < timers; i++)
+        {
+            CHECK(osal_stop_timerEx(i % 16, 1 << (i / 16)) == SUCCESS);
+        }
+        osalTimerUpdate(0);
+        CHECK(osal_timer_num_active() == 0);
+    }
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== osal_timer_test.c ========
+ *
+ *  Host test of the OSAL timers. The same source is built with the timer
+ *  list and with the OSAL_TIMER_WHEEL backend; random starts, reloads, stops
+ *  and clock updates are checked against a model of the timers: the events
+ *  set, the remaining timeouts, the number of active timers and the next
+ *  timeout.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "comdef.h"
+#include "osal.h"
+#include "osal_timers.h"
+
+#include "icall_host.h"
+#include "test_util.h"
+
+#define TEST_TASKS  6
+#define TEST_EVENTS 16
+#define TEST_OPS    200000
+
+/* OSAL_TIMER_POOL_SIZE of osal_timers.c */
+#define TEST_POOL_SIZE 16
+
+typedef struct
+{
+    bool used;
+    uint32 remaining;
+    uint32 reload;
+} ModelTimer;
+
+static ModelTimer model[TEST_TASKS][TEST_EVENTS];
+static uint32 modelFired[TEST_TASKS][TEST_EVENTS];
+static uint32 fired[TEST_TASKS][TEST_EVENTS];
+static uint32 heapAllocs;
+static int32 heapBlocks;
+static uint32 seed = 0x6A09E667U;
+
+void *osal_mem_alloc(uint16 size)
+{
+    heapAllocs++;
+    heapBlocks++;
+    return (malloc(size));
+}
+
+void osal_mem_free(void *ptr)
+{
+    heapBlocks--;
+    free(ptr);
+}
+
+uint8 osal_set_event(uint8 task_id, uint32 event_flag)
+{
+    // The list backend sets no event for a stopped timer it frees
+    if (event_flag == 0)
+    {
+        return (SUCCESS);
+    }
+    CHECK(task_id < TEST_TASKS);
+    CHECK((event_flag != 0) && ((event_flag & (event_flag - 1)) == 0));
+    fired[task_id][__builtin_ctz(event_flag)]++;
+    return (SUCCESS);
+}
+
+uint32 TimerElapsed(void)
+{
+    return (0);
+}
+
+static void modelStart(int t, int e, uint32 timeout, bool reload)
+{
+    if (!model[t][e].used)
+    {
+        model[t][e].used   = true;
+        model[t][e].reload = 0;
+    }
+    model[t][e].remaining = timeout;
+    if (reload)
+    {
+        model[t][e].reload = timeout;
+    }
+}
+
+static void modelUpdate(uint32 elapsed)
+{
+    int t;
+    int e;
+
+    for (t = 0; t < TEST_TASKS; t++)
+    {
+        for (e = 0; e < TEST_EVENTS; e++)
+        {
+            ModelTimer *m = &model[t][e];
+
+            if (!m->used)
+            {
+                continue;
+            }
+            m->remaining = (m->remaining > elapsed) ? (m->remaining - elapsed) : 0;
+            if (m->remaining == 0)
+            {
+                modelFired[t][e]++;
+                if (m->reload)
+                {
+                    m->remaining = m->reload;
+                }
+                else
+                {
+                    m->used = false;
+                }
+            }
+        }
+    }
+}
+
+static void checkState(void)
+{
+    uint32 next   = OSAL_TIMERS_MAX_TIMEOUT;
+    uint32 active = 0;
+    int t;
+    int e;
+
+    CHECK(memcmp(fired, modelFired, sizeof(fired)) == 0);
+    for (t = 0; t < TEST_TASKS; t++)
+    {
+        for (e = 0; e < TEST_EVENTS; e++)
+        {
+            if (model[t][e].used)
+            {
+                active++;
+                if (model[t][e].remaining < next)
+                {
+                    next = model[t][e].remaining;
+                }
+            }
+            CHECK(osal_get_timeoutEx(t, 1 << e) == (model[t][e].used ? model[t][e].remaining : 0));
+        }
+    }
+    CHECK(osal_timer_num_active() == active);
+    CHECK(osal_next_timeout() == (active ? next : 0));
+}
+
+static uint32 randomTimeout(void)
+{
+    switch (testRand(&seed) % 8)
+    {
+        case 0:
+            // Beyond a turn of the wheel
+            return (testRand(&seed) % 100000);
+        case 1:
+            return (testRand(&seed) % 3000);
+        default:
+            return (testRand(&seed) % 100);
+    }
+}
+
+static void testModel(void)
+{
+    int i;
+
+    for (i = 0; i < TEST_OPS; i++)
+    {
+        uint32 op = testRand(&seed) % 10;
+        int t     = testRand(&seed) % TEST_TASKS;
+        int e     = testRand(&seed) % TEST_EVENTS;
+
+        if (op < 3)
+        {
+            uint32 timeout = randomTimeout();
+
+            CHECK(osal_start_timerEx(t, 1 << e, timeout) == SUCCESS);
+            modelStart(t, e, timeout, false);
+        }
+        else if (op < 4)
+        {
+            uint32 timeout = 1 + (testRand(&seed) % 200);
+
+            CHECK(osal_start_reload_timer(t, 1 << e, timeout) == SUCCESS);
+            modelStart(t, e, timeout, true);
+        }
+        else if (op < 5)
+        {
+            CHECK(osal_stop_timerEx(t, 1 << e) == (model[t][e].used ? SUCCESS : INVALID_EVENT_ID));
+            model[t][e].used = false;
+        }
+        else if (op < 6)
+        {
+            CHECK(osal_get_timeoutEx(t, 1 << e) == (model[t][e].used ? model[t][e].remaining : 0));
+        }
+        else
+        {
+            uint32 elapsed = (testRand(&seed) % 8 == 0) ? (testRand(&seed) % 5000) : (testRand(&seed) % 4);
+
+            osalTimerUpdate(elapsed);
+            modelUpdate(elapsed);
+            checkState();
+        }
+        CHECK(icallHostCsDepth == 0);
+    }
+}
+
+/* Stopped timers free their records, and a full pool leaves the heap alone */
+static void testRecords(void)
+{
+    int t;
+    int e;
+
+    for (t = 0; t < TEST_TASKS; t++)
+    {
+        for (e = 0; e < TEST_EVENTS; e++)
+        {
+            osal_stop_timerEx(t, 1 << e);
+            model[t][e].used = false;
+        }
+    }
+    osalTimerUpdate(0);
+    CHECK(osal_timer_num_active() == 0);
+    CHECK(heapBlocks == 0);
+
+#ifdef OSAL_TIMER_WHEEL
+    heapAllocs = 0;
+    for (e = 0; e < TEST_POOL_SIZE; e++)
+    {
+        CHECK(osal_start_reload_timer(e % TEST_TASKS, 1 << e, 10 + e) == SUCCESS);
+    }
+    osalTimerUpdate(1000);
+    for (e = 0; e < TEST_POOL_SIZE; e++)
+    {
+        CHECK(osal_stop_timerEx(e % TEST_TASKS, 1 << e) == SUCCESS);
+    }
+    CHECK(heapAllocs == 0);
+#endif
+}
+
+int main(void)
+{
+    osalTimerInit();
+
+    testModel();
+    testRecords();
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== record_store_bench.c ========
+ *
+ *  Cost of a RACP "greater or equal" query on the record store of the
+ *  glucose and CGM databases, against the number of records in the NVS
+ *  region. The binary search of RecordStore_find() and RecordStore_countFrom()
+ *  is compared with a linear scan of the records, as the RAM arrays of the
+ *  databases were searched. NVS_read() is wrapped at link time to count the
+ *  flash reads of each query.
+ */
+
+#include <stdio.h>
+
+#include <ti/drivers/NVS.h>
+#include <ti/bleapp/util/record_store/record_store.h>
+
+#include "nvs/NVSRAMLinux.h"
+#include "test_util.h"
+
+/* GLS_MEAS_MAX_RECORD_LEN */
+#define REC_SIZE       20
+#define QUERIES        2000
+#define BATCH          8
+
+int_fast16_t __real_NVS_read(NVS_Handle handle, size_t offset, void *buffer, size_t bufferSize);
+
+static const uint32_t benchRecords[] = {50, 100, 200, 300};
+static uint32_t seed = 0x13198A2EU;
+static unsigned long flashReads;
+
+int_fast16_t __wrap_NVS_read(NVS_Handle handle, size_t offset, void *buffer, size_t bufferSize)
+{
+    flashReads++;
+    return (__real_NVS_read(handle, offset, buffer, bufferSize));
+}
+
+/* Number of records with a key greater than or equal to key, by reading
+ * every record */
+static uint32_t linearCount(RecordStore_t *pStore, uint32_t key)
+{
+    uint8_t recs[BATCH][REC_SIZE];
+    uint32_t keys[BATCH];
+    uint32_t seq = pStore->headSeq;
+    uint32_t count = 0;
+    uint16_t n;
+    uint16_t i;
+
+    while ((n = RecordStore_read(pStore, &seq, UINT32_MAX, recs, keys, BATCH)) > 0)
+    {
+        for (i = 0; i < n; i++)
+        {
+            count += (keys[i] >= key);
+        }
+    }
+    return count;
+}
+
+int main(void)
+{
+    const RecordStore_config_t config = {.nvsIndex = CONFIG_NVSINTERNAL, .recSize = REC_SIZE};
+    RecordStore_t store;
+    uint8_t rec[REC_SIZE] = {0};
+    unsigned long indexReads;
+    unsigned long scanReads;
+    uint64_t indexNs;
+    uint64_t scanNs;
+    uint64_t start;
+    uint32_t records = 0;
+    uint32_t key;
+    uint32_t count;
+    size_t b;
+    int q;
+
+    CHECK(RecordStore_open(&store, &config) == SUCCESS);
+    CHECK(RecordStore_clear(&store) == SUCCESS);
+
+    printf("RACP greater or equal query, per query\n");
+    for (b = 0; b < sizeof(benchRecords) / sizeof(benchRecords[0]); b++)
+    {
+        // Sequence numbers as keys, a record every other number
+        for (; records < benchRecords[b]; records++)
+        {
+            CHECK(RecordStore_append(&store, 2 * records, rec) == SUCCESS);
+        }
+        CHECK(RecordStore_count(&store) == records);
+
+        indexReads = flashReads;
+        start      = testNowNs();
+        for (q = 0; q < QUERIES; q++)
+        {
+            key   = testRand(&seed) % (2 * records);
+            count = RecordStore_countFrom(&store, key);
+            CHECK(count == records - ((key + 1) / 2));
+            (void)RecordStore_find(&store, key);
+        }
+        indexNs    = testNowNs() - start;
+        indexReads = flashReads - indexReads;
+
+        scanReads = flashReads;
+        start     = testNowNs();
+        for (q = 0; q < QUERIES; q++)
+        {
+            key = testRand(&seed) % (2 * records);
+            CHECK(linearCount(&store, key) == records - ((key + 1) / 2));
+        }
+        scanNs    = testNowNs() - start;
+        scanReads = flashReads - scanReads;
+
+        printf("  %3u records: index %5.1f reads %7.1f ns, scan %5.1f reads %8.1f ns\n", (unsigned)records,
+               (double)indexReads / QUERIES, (double)indexNs / QUERIES, (double)scanReads / QUERIES,
+               (double)scanNs / QUERIES);
+    }
+
+    NVS_close(store.hNvs);
+    return 0;
+}
@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== record_store_test.c ========
+ *
+ *  Host test of the record store behind the glucose and CGM databases, on
+ *  the NVS region of the Linux port. NVS_write() is wrapped at link time to
+ *  program bits from 1 to 0 only, as the flash does, and to cut the power
+ *  part way through a write.
+ *
+ *  Random appends, resets, power cuts and clears are checked against a copy
+ *  of the records: every record whose append returned SUCCESS must be read
+ *  back until its sector is dropped, and range queries must return the same
+ *  records as a linear scan of the copy. The RAM store is checked to keep
+ *  the record counts of the databases, and the 16-bit keys to keep the
+ *  history across a wrap.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <ti/drivers/NVS.h>
+#include <ti/bleapp/util/record_store/record_store.h>
+
+#include "nvs/NVSRAMLinux.h"
+#include "test_util.h"
+
+#define REC_SIZE         13
+#define WRITE_MAX        64
+#define MODEL_OPS        20000
+#define MODEL_MAX        4096
+#define QUERIES          20
+#define BATCH            5
+
+/* GL_DB_MAX_NUM_OF_RECORDS and CGM_DB_MAX_NUM_OF_RECORDS */
+#define GL_DB_RECORDS    210
+#define CGM_DB_RECORDS   100
+
+int_fast16_t __real_NVS_write(NVS_Handle handle, size_t offset, void *buffer, size_t bufferSize, uint_fast16_t flags);
+
+static uint32_t seed = 0x3243F6A8U;
+/* Bytes programmed before the power is cut, or -1 */
+static long powerBudget = -1;
+
+static const RecordStore_config_t nvsConfig = {.nvsIndex = CONFIG_NVSINTERNAL, .recSize = REC_SIZE};
+
+/* Records appended with SUCCESS and not cleared, oldest first */
+static uint32_t modelKey[MODEL_MAX];
+static uint32_t modelSeq[MODEL_MAX];
+static uint8_t modelRec[MODEL_MAX][REC_SIZE];
+static int modelCount;
+
+int_fast16_t __wrap_NVS_write(NVS_Handle handle, size_t offset, void *buffer, size_t bufferSize, uint_fast16_t flags)
+{
+    uint8_t cell[WRITE_MAX];
+    const uint8_t *src = buffer;
+    size_t len = bufferSize;
+    size_t i;
+
+    CHECK(bufferSize <= sizeof(cell));
+    if (powerBudget >= 0)
+    {
+        len = ((size_t)powerBudget < bufferSize) ? (size_t)powerBudget : bufferSize;
+        powerBudget -= len;
+    }
+
+    NVS_read(handle, offset, cell, len);
+    for (i = 0; i < len; i++)
+    {
+        cell[i] &= src[i];
+    }
+    if (len > 0)
+    {
+        CHECK(__real_NVS_write(handle, offset, cell, len, flags & ~NVS_WRITE_PRE_VERIFY) == NVS_STATUS_SUCCESS);
+    }
+    return (len < bufferSize) ? NVS_STATUS_ERROR : NVS_STATUS_SUCCESS;
+}
+
+/* A reset: the store is rebuilt from the flash */
+static void reopen(RecordStore_t *pStore)
+{
+    NVS_close(pStore->hNvs);
+    CHECK(RecordStore_open(pStore, &nvsConfig) == SUCCESS);
+}
+
+static void checkModel(RecordStore_t *pStore)
+{
+    uint8_t recs[BATCH][REC_SIZE];
+    uint32_t keys[BATCH];
+    uint32_t seq = 0;
+    uint32_t key;
+    uint32_t expSeq;
+    uint32_t found;
+    uint16_t n;
+    int first = 0;
+    int count;
+    int expCount;
+    int i;
+    int q;
+
+    // Records of the sectors dropped to make room are gone
+    while ((first < modelCount) && (modelSeq[first] < pStore->headSeq))
+    {
+        first++;
+    }
+
+    // Whole store, in batches
+    i = first;
+    while ((n = RecordStore_read(pStore, &seq, UINT32_MAX, recs, keys, BATCH)) > 0)
+    {
+        for (q = 0; q < n; q++, i++)
+        {
+            CHECK(i < modelCount);
+            CHECK(keys[q] == modelKey[i]);
+            CHECK(memcmp(recs[q], modelRec[i], REC_SIZE) == 0);
+        }
+    }
+    CHECK(i == modelCount);
+    CHECK(seq == pStore->nextSeq);
+    CHECK(RecordStore_count(pStore) >= (uint32_t)(modelCount - first));
+
+    // Range queries, as a RACP "greater or equal" and "within range"
+    for (q = 0; q < QUERIES; q++)
+    {
+        if (first < modelCount)
+        {
+            key = modelKey[first + (testRand(&seed) % (modelCount - first))] + (testRand(&seed) % 3) - 1;
+        }
+        else
+        {
+            key = testRand(&seed) % 100;
+        }
+
+        expSeq = pStore->nextSeq;
+        for (i = first; i < modelCount; i++)
+        {
+            if (modelKey[i] >= key)
+            {
+                expSeq = modelSeq[i];
+                break;
+            }
+        }
+        // Only slots left by a power cut may come before the expected record
+        found = RecordStore_find(pStore, key);
+        CHECK(found <= expSeq);
+        for (i = first; i < modelCount; i++)
+        {
+            CHECK((modelSeq[i] < found) || (modelSeq[i] >= expSeq));
+        }
+
+        count = 0;
+        seq   = found;
+        while ((n = RecordStore_read(pStore, &seq, key + 5, recs, keys, BATCH)) > 0)
+        {
+            for (i = 0; i < n; i++)
+            {
+                CHECK((keys[i] >= key) && (keys[i] <= key + 5));
+                count++;
+            }
+        }
+        expCount = 0;
+        for (i = first; i < modelCount; i++)
+        {
+            if ((modelKey[i] >= key) && (modelKey[i] <= key + 5))
+            {
+                expCount++;
+            }
+        }
+        CHECK(count == expCount);
+    }
+}
+
+static void testModel(void)
+{
+    RecordStore_t store;
+    RecordStore_t reopened;
+    uint8_t rec[REC_SIZE];
+    uint32_t key = 0;
+    uint32_t seq;
+    bStatus_t status;
+    int cuts = 0;
+    int cut;
+    int op;
+    int r;
+    int i;
+
+    CHECK(RecordStore_open(&store, &nvsConfig) == SUCCESS);
+    CHECK(RecordStore_clear(&store) == SUCCESS);
+
+    for (op = 0; op < MODEL_OPS; op++)
+    {
+        r = testRand(&seed) % 100;
+        if (r < 85)
+        {
+            for (i = 0; i < REC_SIZE; i++)
+            {
+                rec[i] = (uint8_t)testRand(&seed);
+            }
+            key += testRand(&seed) % 3;
+            seq = store.nextSeq;
+
+            cut = ((testRand(&seed) % 50) == 0);
+            if (cut)
+            {
+                powerBudget = testRand(&seed) % (REC_SIZE + 10);
+            }
+            status = RecordStore_append(&store, key, rec);
+            if (cut)
+            {
+                powerBudget = -1;
+                cuts++;
+                reopen(&store);
+            }
+            else
+            {
+                CHECK(status == SUCCESS);
+            }
+
+            if (status == SUCCESS)
+            {
+                modelKey[modelCount] = key;
+                modelSeq[modelCount] = seq;
+                memcpy(modelRec[modelCount], rec, REC_SIZE);
+                modelCount++;
+            }
+        }
+        else if (r < 97)
+        {
+            // A reset rebuilds the same state
+            reopened = store;
+            reopen(&reopened);
+            CHECK(reopened.nextSeq == store.nextSeq);
+            CHECK(reopened.headSeq == store.headSeq);
+            CHECK(reopened.lastKey == store.lastKey);
+            store = reopened;
+        }
+        else if ((testRand(&seed) % 30) == 0)
+        {
+            CHECK(RecordStore_clear(&store) == SUCCESS);
+            modelCount = 0;
+            key        = 0;
+        }
+
+        if (modelCount == MODEL_MAX)
+        {
+            // Far older than anything the store keeps
+            memmove(modelKey, modelKey + (MODEL_MAX / 2), (MODEL_MAX / 2) * sizeof(modelKey[0]));
+            memmove(modelSeq, modelSeq + (MODEL_MAX / 2), (MODEL_MAX / 2) * sizeof(modelSeq[0]));
+            memmove(modelRec, modelRec + (MODEL_MAX / 2), (MODEL_MAX / 2) * sizeof(modelRec[0]));
+            modelCount -= MODEL_MAX / 2;
+        }
+        checkModel(&store);
+    }
+
+    printf("%d operations, %d power cuts, %u records kept\n", MODEL_OPS, cuts, (unsigned)RecordStore_count(&store));
+    NVS_close(store.hNvs);
+}
+
+/* The RAM areas of the databases always keep their record counts */
+static void testRamSize(uint32_t numRecs, uint16_t recSize)
+{
+    static uint8_t ram[8192];
+    uint8_t rec[64] = {0};
+    RecordStore_config_t config = {.pRam = ram, .ramSize = RECORD_STORE_RAM_SIZE(numRecs, recSize),
+                                   .recSize = recSize};
+    RecordStore_t store;
+    uint32_t i;
+
+    CHECK(config.ramSize <= sizeof(ram));
+    CHECK(recSize <= sizeof(rec));
+    CHECK(RecordStore_open(&store, &config) == SUCCESS);
+    for (i = 0; i < 10 * numRecs; i++)
+    {
+        CHECK(RecordStore_append(&store, i, rec) == SUCCESS);
+        CHECK(RecordStore_count(&store) >= ((i + 1 < numRecs) ? i + 1 : numRecs));
+    }
+}
+
+/* Sequence numbers wrapping around keep the records kept before */
+static void testKeyWrap(void)
+{
+    static uint8_t ram[RECORD_STORE_RAM_SIZE(GL_DB_RECORDS, REC_SIZE)];
+    RecordStore_config_t config = {.pRam = ram, .ramSize = sizeof(ram), .recSize = REC_SIZE};
+    RecordStore_t store;
+    uint8_t recs[BATCH][REC_SIZE];
+    uint32_t keys[BATCH];
+    uint8_t rec[REC_SIZE] = {0};
+    uint16_t seqNum = 0xFF00;
+    uint16_t first;
+    uint32_t cursor;
+    uint32_t count = 0;
+    uint16_t n;
+    int i;
+
+    CHECK(RecordStore_open(&store, &config) == SUCCESS);
+    for (i = 0; i < 1000; i++, seqNum++)
+    {
+        memcpy(rec, &seqNum, sizeof(seqNum));
+        CHECK(RecordStore_append(&store, RecordStore_extendKey(&store, seqNum), rec) == SUCCESS);
+    }
+
+    // All the records from the oldest sequence number to the newest one
+    first  = (uint16_t)RecordStore_firstKey(&store);
+    cursor = RecordStore_find(&store, RecordStore_matchMinKey(&store, first));
+    while ((n = RecordStore_read(&store, &cursor, RecordStore_matchMaxKey(&store, seqNum - 1), recs, keys,
+                                 BATCH)) > 0)
+    {
+        for (i = 0; i < n; i++, count++)
+        {
+            CHECK(memcmp(recs[i], &(uint16_t){first + count}, sizeof(uint16_t)) == 0);
+        }
+    }
+    CHECK(count >= GL_DB_RECORDS);
+    CHECK(count == RecordStore_count(&store));
+    CHECK(RecordStore_countFrom(&store, RecordStore_matchMinKey(&store, first)) == count);
+}
+
+int main(void)
+{
+    testModel();
+    testRamSize(GL_DB_RECORDS, 20);
+    testRamSize(CGM_DB_RECORDS, 17);
+    testKeyWrap();
+
+    printf("PASS\n");
+    return 0;
+}
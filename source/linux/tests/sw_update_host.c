@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== sw_update_host.c ========
+ */
+
+#include <string.h>
+
+#include <ti/drivers/SHA2.h>
+
+#include "hal_types.h"
+#include "comdef.h"
+#include "flash_interface.h"
+#include "ti/bleapp/util/sw_update/sw_update.h"
+#include "sw_update_host.h"
+
+uint8_t swUpdateHostFlash[SW_UPDATE_HOST_FLASH_SIZE];
+uint8_t swUpdateHostBaseImage[SW_UPDATE_HOST_FLASH_SIZE];
+uint32_t swUpdateHostReadBytes;
+uint32_t swUpdateHostWriteBytes;
+uint32_t swUpdateHostErases;
+
+/* Flash interface */
+
+void swUpdateHostFlashReset(uint8_t value)
+{
+    memset(swUpdateHostFlash, value, sizeof(swUpdateHostFlash));
+    swUpdateHostReadBytes  = 0;
+    swUpdateHostWriteBytes = 0;
+    swUpdateHostErases     = 0;
+}
+
+bool flash_open(void)
+{
+    return true;
+}
+
+void flash_close(void)
+{
+}
+
+bool hasExternalFlash(void)
+{
+    return false;
+}
+
+uint8_t readFlash(uint_least32_t addr, uint8_t *pBuf, size_t len)
+{
+    if (addr + len > sizeof(swUpdateHostFlash))
+    {
+        return FLASH_FAILURE;
+    }
+    memcpy(pBuf, &swUpdateHostFlash[addr], len);
+    swUpdateHostReadBytes += len;
+    return FLASH_SUCCESS;
+}
+
+uint8_t writeFlash(uint_least32_t addr, uint8_t *pBuf, size_t len)
+{
+    size_t i;
+
+    if (addr + len > sizeof(swUpdateHostFlash))
+    {
+        return FLASH_FAILURE;
+    }
+    // Programming only clears bits
+    for (i = 0; i < len; i++)
+    {
+        swUpdateHostFlash[addr + i] &= pBuf[i];
+    }
+    swUpdateHostWriteBytes += len;
+    return FLASH_SUCCESS;
+}
+
+uint8_t readFlashPg(uint8_t page, uint32_t offset, uint8_t *pBuf, uint16_t len)
+{
+    // Like the flash driver, an access may run into the next page
+    return readFlash(FLASH_ADDRESS(page, offset), pBuf, len);
+}
+
+uint8_t writeFlashPg(uint8_t page, uint32_t offset, uint8_t *pBuf, uint16_t len)
+{
+    return writeFlash(FLASH_ADDRESS(page, offset), pBuf, len);
+}
+
+uint8_t eraseFlashPg(uint8_t page)
+{
+    memset(&swUpdateHostFlash[FLASH_ADDRESS(page, 0)], 0xFF, INTFLASH_PAGE_SIZE);
+    swUpdateHostErases++;
+    return FLASH_SUCCESS;
+}
+
+/* SHA-256 */
+
+typedef struct
+{
+    uint32_t state[8];
+    uint64_t length;
+    uint8_t  block[64];
+    uint32_t fill;
+} swUpdateHostSha256_t;
+
+static const uint32_t sha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define ROR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sha256Block(swUpdateHostSha256_t *pCtx, const uint8_t *pBlock)
+{
+    uint32_t w[64];
+    uint32_t s[8];
+    int i;
+
+    for (i = 0; i < 16; i++)
+    {
+        w[i] = ((uint32_t)pBlock[4 * i] << 24) | ((uint32_t)pBlock[4 * i + 1] << 16) |
+               ((uint32_t)pBlock[4 * i + 2] << 8) | pBlock[4 * i + 3];
+    }
+    for (i = 16; i < 64; i++)
+    {
+        uint32_t s0 = ROR32(w[i - 15], 7) ^ ROR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROR32(w[i - 2], 17) ^ ROR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    memcpy(s, pCtx->state, sizeof(s));
+    for (i = 0; i < 64; i++)
+    {
+        uint32_t t1 = s[7] + (ROR32(s[4], 6) ^ ROR32(s[4], 11) ^ ROR32(s[4], 25)) +
+                      ((s[4] & s[5]) ^ (~s[4] & s[6])) + sha256K[i] + w[i];
+        uint32_t t2 = (ROR32(s[0], 2) ^ ROR32(s[0], 13) ^ ROR32(s[0], 22)) +
+                      ((s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]));
+
+        memmove(&s[1], &s[0], 7 * sizeof(uint32_t));
+        s[4] += t1;
+        s[0] = t1 + t2;
+    }
+    for (i = 0; i < 8; i++)
+    {
+        pCtx->state[i] += s[i];
+    }
+}
+
+static void sha256Reset(swUpdateHostSha256_t *pCtx)
+{
+    static const uint32_t init[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                     0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+    memcpy(pCtx->state, init, sizeof(init));
+    pCtx->length = 0;
+    pCtx->fill   = 0;
+}
+
+static void sha256Add(swUpdateHostSha256_t *pCtx, const uint8_t *pData, size_t len)
+{
+    pCtx->length += len;
+    while (len > 0)
+    {
+        size_t n = sizeof(pCtx->block) - pCtx->fill;
+
+        if (n > len)
+        {
+            n = len;
+        }
+        memcpy(&pCtx->block[pCtx->fill], pData, n);
+        pCtx->fill += n;
+        pData += n;
+        len -= n;
+        if (pCtx->fill == sizeof(pCtx->block))
+        {
+            sha256Block(pCtx, pCtx->block);
+            pCtx->fill = 0;
+        }
+    }
+}
+
+static void sha256Finish(swUpdateHostSha256_t *pCtx, uint8_t *pDigest)
+{
+    uint64_t bits = pCtx->length * 8;
+    uint8_t pad = 0x80;
+    uint8_t lenBytes[8];
+    int i;
+
+    sha256Add(pCtx, &pad, 1);
+    pad = 0;
+    while (pCtx->fill != 56)
+    {
+        sha256Add(pCtx, &pad, 1);
+    }
+    for (i = 0; i < 8; i++)
+    {
+        lenBytes[i] = (uint8_t)(bits >> (56 - 8 * i));
+    }
+    sha256Add(pCtx, lenBytes, sizeof(lenBytes));
+    for (i = 0; i < 32; i++)
+    {
+        pDigest[i] = (uint8_t)(pCtx->state[i / 4] >> (24 - 8 * (i % 4)));
+    }
+}
+
+void swUpdateHostSha256(const void *pData, size_t len, uint8_t *pDigest)
+{
+    swUpdateHostSha256_t ctx;
+
+    sha256Reset(&ctx);
+    sha256Add(&ctx, pData, len);
+    sha256Finish(&ctx, pDigest);
+}
+
+/* SHA2 driver, one software instance whatever the config */
+
+static swUpdateHostSha256_t sha2HostCtx;
+
+void SHA2_init(void)
+{
+}
+
+void SHA2_Params_init(SHA2_Params *params)
+{
+    memset(params, 0, sizeof(*params));
+}
+
+SHA2_Handle SHA2_construct(SHA2_Config *config, const SHA2_Params *params)
+{
+    sha256Reset(&sha2HostCtx);
+    return config;
+}
+
+void SHA2_reset(SHA2_Handle handle)
+{
+    sha256Reset(&sha2HostCtx);
+}
+
+int_fast16_t SHA2_addData(SHA2_Handle handle, const void *data, size_t length)
+{
+    sha256Add(&sha2HostCtx, data, length);
+    return SHA2_STATUS_SUCCESS;
+}
+
+int_fast16_t SHA2_finalize(SHA2_Handle handle, void *digest)
+{
+    sha256Finish(&sha2HostCtx, digest);
+    return SHA2_STATUS_SUCCESS;
+}
+
+/* Images */
+
+static uint8_t *swUpdateHostAddTlv(uint8_t *p, uint16_t type, uint16_t len, uint8_t fill)
+{
+    struct image_tlv tlv = {.it_type = type, .it_len = len};
+
+    memcpy(p, &tlv, sizeof(tlv));
+    memset(p + sizeof(tlv), fill, len);
+    return p + sizeof(tlv) + len;
+}
+
+uint32_t swUpdateHostMakeImage(uint8_t *pImage, const uint8_t *pBody, uint32_t bodyLen)
+{
+    struct image_header hdr = {0};
+    struct image_tlv_info info = {.it_magic = IMAGE_TLV_INFO_MAGIC, .it_tlv_tot = SW_UPDATE_TLV_AREA_SIZE};
+    uint8_t *p;
+
+    hdr.ih_magic    = IMAGE_MAGIC;
+    hdr.ih_hdr_size = SW_UPDATE_HOST_HDR_SIZE;
+    hdr.ih_img_size = bodyLen;
+    memset(pImage, 0, SW_UPDATE_HOST_HDR_SIZE);
+    memcpy(pImage, &hdr, sizeof(hdr));
+    memcpy(pImage + SW_UPDATE_HOST_HDR_SIZE, pBody, bodyLen);
+
+    p = pImage + SW_UPDATE_HOST_HDR_SIZE + bodyLen;
+    memcpy(p, &info, sizeof(info));
+    p += sizeof(info);
+    p = swUpdateHostAddTlv(p, IMAGE_TLV_SHA256, 32, 0);
+    swUpdateHostSha256(pImage, SW_UPDATE_HOST_HDR_SIZE + bodyLen, p - 32);
+    p = swUpdateHostAddTlv(p, IMAGE_TLV_KEYHASH, 32, 0x4B);
+    p = swUpdateHostAddTlv(p, IMAGE_TLV_ECDSA_SIG, 72, 0x53);
+
+    return (uint32_t)(p - pImage);
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== sw_update_host.h ========
+ *
+ *  Flash, SHA2 and running image of the host tests of sw_update.c. The
+ *  internal flash is an array, written with AND semantics like NOR flash,
+ *  and the SHA2 driver is a plain software SHA-256.
+ *
+ *  This header is also force-included when sw_update.c is built for the
+ *  tests, for the running image used by delta streams (APP_HDR_ADDR).
+ */
+
+#ifndef ti_linux_tests_sw_update_host__include
+#define ti_linux_tests_sw_update_host__include
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Size of the internal flash array, the CC23X0R53 flash */
+#define SW_UPDATE_HOST_FLASH_SIZE   (256 * 0x800)
+
+/* Header size of the images built by swUpdateHostMakeImage() */
+#define SW_UPDATE_HOST_HDR_SIZE     0x100
+
+extern uint8_t swUpdateHostFlash[SW_UPDATE_HOST_FLASH_SIZE];
+
+/* Image running on the target, APP_HDR_ADDR of the tests */
+extern uint8_t swUpdateHostBaseImage[SW_UPDATE_HOST_FLASH_SIZE];
+
+/* Bytes read from and written to swUpdateHostFlash, pages erased */
+extern uint32_t swUpdateHostReadBytes;
+extern uint32_t swUpdateHostWriteBytes;
+extern uint32_t swUpdateHostErases;
+
+/* Set the flash to 'value' and clear the counters */
+extern void swUpdateHostFlashReset(uint8_t value);
+
+/* SHA-256 of a buffer */
+extern void swUpdateHostSha256(const void *pData, size_t len, uint8_t *pDigest);
+
+/*
+ *  Build a signed-like MCUboot image around a body: a header, the body and a
+ *  TLV area of SW_UPDATE_TLV_AREA_SIZE bytes holding the SHA256 TLV of the
+ *  header and body, then key hash and signature TLVs of filler bytes.
+ *  Returns the image length, SW_UPDATE_IMAGE_LENGTH of its header.
+ */
+extern uint32_t swUpdateHostMakeImage(uint8_t *pImage, const uint8_t *pBody, uint32_t bodyLen);
+
+#endif /* ti_linux_tests_sw_update_host__include */
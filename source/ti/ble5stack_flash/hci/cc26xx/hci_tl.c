@@ -78,6 +78,7 @@
 
 #include "hci_event.h"
 #include "hci_tl.h"
+#include "hci_tl_cmd.h"
 #include "osal_bufmgr.h"
 #include "map_direct.h"
 
@@ -103,16 +104,6 @@ extern uint8 hciPTMenabled;
  * TYPEDEFS
  */
 
-typedef hciStatus_t (*hciFunc_t)( uint8 *pBuf );
-
-typedef struct
-{
-  uint16    opCode;
-  hciFunc_t hciFunc;
-} hciCmdFunc_t;
-
-typedef const hciCmdFunc_t cmdPktTable_t;
-
 /*******************************************************************************
  * LOCAL VARIABLES
  */
@@ -357,202 +348,9 @@ hciStatus_t hciExtLLTestMode                       ( uint8 *pBuf );
 // HCI Packet Opcode Jump Table
 cmdPktTable_t hciCmdTable[] =
 {
-  // Linker Control Commands
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
-  {HCI_DISCONNECT                           , hciDisconnect                    },
-  {HCI_READ_REMOTE_VERSION_INFO             , hciReadRemoteVersionInfo         },
-#endif // ADV_CONN_CFG | INIT_CFG
-
-  // Controller and Baseband Commands
-  {HCI_SET_EVENT_MASK                       , hciSetEventMask                  },
-  {HCI_SET_EVENT_MASK_PAGE_2                , hciSetEventMaskPage2             },
-  {HCI_RESET                                , hciReset                         },
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
-  {HCI_READ_TRANSMIT_POWER                  , hciReadTransmitPowerLevel        },
-  {HCI_SET_CONTROLLER_TO_HOST_FLOW_CONTROL  , hciSetControllerToHostFlowCtrl   },
-  {HCI_HOST_BUFFER_SIZE                     , hciHostBufferSize                },
-  {HCI_HOST_NUM_COMPLETED_PACKETS           , hciHostNumCompletedPkt           },
-#endif // ADV_CONN_CFG | INIT_CFG
-
-// Informational Parameters
-  {HCI_READ_LOCAL_VERSION_INFO              , hciReadLocalVersionInfo          },
-  {HCI_READ_LOCAL_SUPPORTED_COMMANDS        , hciReadLocalSupportedCommands    },
-  {HCI_READ_LOCAL_SUPPORTED_FEATURES        , hciReadLocalSupportedFeatures    },
-  {HCI_READ_BDADDR                          , hciReadBDADDR                    },
-  {HCI_READ_RSSI                            , hciReadRssi                      },
-
-  // LE Commands
-  {HCI_LE_SET_EVENT_MASK                    , hciLESetEventMask                },
-  {HCI_LE_READ_BUFFER_SIZE                  , hciLEReadBufSize                 },
-  {HCI_LE_READ_LOCAL_SUPPORTED_FEATURES     , hciLEReadLocalSupportedFeatures  },
-  {HCI_LE_SET_RANDOM_ADDR                   , hciLESetRandomAddr               },
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_NCONN_CFG | ADV_CONN_CFG))
-  {HCI_LE_SET_ADV_PARAM                     , hciLESetAdvParam                 },
-  {HCI_LE_SET_ADV_DATA                      , hciLESetAdvData                  },
-  {HCI_LE_SET_SCAN_RSP_DATA                 , hciLESetScanRspData              },
-  {HCI_LE_SET_ADV_ENABLE                    , hciLESetAdvEnab                  },
-  {HCI_LE_READ_ADV_CHANNEL_TX_POWER         , hciLEReadAdvChanTxPower          },
-#endif // ADV_NCONN_CFG | ADV_CONN_CFG
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & SCAN_CFG)
-  {HCI_LE_SET_SCAN_PARAM                    , hciLESetScanParam                },
-  {HCI_LE_SET_SCAN_ENABLE                   , hciLESetScanEnable               },
-#endif // SCAN_CFG
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & INIT_CFG)
-  {HCI_LE_CREATE_CONNECTION                 , hciLECreateConn                  },
-  {HCI_LE_CREATE_CONNECTION_CANCEL          , hciLECreateConnCancel            },
-#endif // INIT_CFG
-  {HCI_LE_READ_ACCEPT_LIST_SIZE              , hciLEReadAcceptListSize          },
-  {HCI_LE_CLEAR_ACCEPT_LIST                  , hciLEClearAcceptList             },
-  {HCI_LE_ADD_ACCEPT_LIST                    , hciLEAddAcceptList               },
-  {HCI_LE_REMOVE_ACCEPT_LIST                 , hciLERemoveAcceptList            },
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
-  {HCI_LE_CONNECTION_UPDATE                 , hciLEConnUpdate                  },
-#endif // ADV_CONN_CFG | INIT_CFG
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & INIT_CFG)
-  {HCI_LE_SET_HOST_CHANNEL_CLASSIFICATION   , hciLESetHostChanClass            },
-  {HCI_LE_READ_CHANNEL_MAP                  , hciLEReadChanMap                 },
-  {HCI_LE_READ_REMOTE_USED_FEATURES         , hciLEReadRemoteUsedFeatures      },
-#endif // INIT_CFG
-  {HCI_LE_ENCRYPT                           , hciLEEncrypt                     },
-  {HCI_LE_RAND                              , hciLERand                        },
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & INIT_CFG)
-  {HCI_LE_START_ENCRYPTION                  , hciLEStartEncrypt                },
-#endif // INIT_CFG
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & ADV_CONN_CFG)
-  {HCI_LE_LTK_REQ_REPLY                     , hciLELtkReqReply                 },
-  {HCI_LE_LTK_REQ_NEG_REPLY                 , hciLELtkReqNegReply              },
-#endif // ADV_CONN_CFG
-  {HCI_LE_READ_SUPPORTED_STATES             , hciLEReadSupportedStates         },
-  {HCI_LE_RECEIVER_TEST                     , hciLEReceiverTest                },
-  {HCI_LE_TRANSMITTER_TEST                  , hciLETransmitterTest             },
-  {HCI_LE_TEST_END                          , hciLETestEnd                     },
-
-// V4.1
-
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
-  {HCI_READ_AUTH_PAYLOAD_TIMEOUT            , hciReadAuthPayloadTimeout        },
-  {HCI_WRITE_AUTH_PAYLOAD_TIMEOUT           , hciWriteAuthPayloadTimeout       },
-#endif // (ADV_CONN_CFG | INIT_CFG)
-
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
-  {HCI_LE_REMOTE_CONN_PARAM_REQ_REPLY       , hciLERemoteConnParamReqReply     },
-  {HCI_LE_REMOTE_CONN_PARAM_REQ_NEG_REPLY   , hciLERemoteConnParamReqNegReply  },
-#endif // (ADV_CONN_CFG | INIT_CFG)
-
-// V4.2 - Extended Data Length
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
-  {HCI_LE_SET_DATA_LENGTH                   ,  hciLESetDataLen                 },
-  {HCI_LE_READ_SUGGESTED_DEFAULT_DATA_LENGTH,  hciLEReadSuggestedDefaultDataLen},
-  {HCI_LE_WRITE_SUGGESTED_DEFAULT_DATA_LENGTH, hciLEWriteSuggestedDefaultDataLen},
-  {HCI_LE_READ_MAX_DATA_LENGTH              ,  hciLEReadMaxDataLen             },
-#endif // (ADV_CONN_CFG | INIT_CFG)
-
-// V4.2 - Secure Connections
-  {HCI_LE_READ_LOCAL_P256_PUBLIC_KEY        ,  hciLEReadLocalP256PubicKey      },
-  {HCI_LE_GENERATE_DHKEY                    ,  hciLEGenerateDHKey              },
-
-// V4.2 - Privacy 1.2
-  {HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST      ,  hciLEAddDeviceToResolvingList   },
-  {HCI_LE_REMOVE_DEVICE_FROM_RESOLVING_LIST ,  hciLERemoveDeviceFromResolvingList},
-  {HCI_LE_CLEAR_RESOLVING_LIST              ,  hciLEClearResolvingList         },
-  {HCI_LE_READ_RESOLVING_LIST_SIZE          ,  hciLEReadResolvingListSize      },
-  {HCI_LE_READ_PEER_RESOLVABLE_ADDRESS      ,  hciLEReadPeerResolvableAddress  },
-  {HCI_LE_READ_LOCAL_RESOLVABLE_ADDRESS     ,  hciLEReadLocalResolvableAddress },
-  {HCI_LE_SET_ADDRESS_RESOLUTION_ENABLE     ,  hciLESetAddressResolutionEnable },
-  {HCI_LE_SET_RESOLVABLE_PRIVATE_ADDRESS_TIMEOUT,  hciLESetResolvablePrivateAddressTimeout},
-  {HCI_LE_SET_PRIVACY_MODE                  ,  hciLESetPrivacyMode             },
-
-// V5.0 - 2M and Coded PHY
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
-  {HCI_LE_READ_PHY                          , hciLEReadPhy                     },
-  {HCI_LE_SET_DEFAULT_PHY                   , hciLESetDefaultPhy               },
-  {HCI_LE_SET_PHY                           , hciLESetPhy                      },
-  {HCI_LE_ENHANCED_RECEIVER_TEST            , hciLEEnhancedRxTest              },
-  {HCI_LE_ENHANCED_TRANSMITTER_TEST         , hciLEEnhancedTxTest              },
-#endif // (ADV_CONN_CFG | INIT_CFG)
-
-  {HCI_LE_READ_TX_POWER                     , hciLEReadTxPower                 },
-  {HCI_LE_READ_RF_PATH_COMPENSATION         , hciLEReadRfPathCompCmd           },
-  {HCI_LE_WRITE_RF_PATH_COMPENSATION        , hciLEWriteRfPathCompCmd          },
-
-  (HCI_LE_SET_CONNECTION_CTE_RECEIVE_PARAMS , hciLESetConnectionCteReceiveParams},
-  (HCI_LE_SET_CONNECTION_CTE_TRANSMIT_PARAMS, hciLESetConnectionCteTransmitParams},
-  (HCI_LE_SET_CONNECTION_CTE_REQUEST_ENABLE , hciLESetConnectionCteRequestEnable},
-  (HCI_LE_SET_CONNECTION_CTE_RESPONSE_ENABLE, hciLESetConnectionCteResponseEnable},
-  (HCI_LE_READ_ANTENNA_INFORMATION,           hciLEReadAntennaInformation},
-
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_NCONN_CFG | ADV_CONN_CFG))
-  (HCI_LE_SET_PERIODIC_ADV_PARAMETERS        ,hciLESetPeriodicAdvParams},
-  (HCI_LE_SET_PERIODIC_ADV_DATA              ,hciLESetPeriodicAdvData},
-  (HCI_LE_SET_PERIODIC_ADV_ENABLE            ,hciLESetPeriodicAdvEnable},
-  (HCI_LE_SET_CONNECTIONLESS_CTE_TRANSMIT_PARAMS,hciLESetConnectionlessCteTransmitParams},
-  (HCI_LE_SET_CONNECTIONLESS_CTE_TRANSMIT_ENABLE,hciLESetConnectionlessCteTransmitEnable},
-#endif // ADV_NCONN_CFG | ADV_CONN_CFG
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & SCAN_CFG)
-  (HCI_LE_PERIODIC_ADV_CREATE_SYNC            ,hciLEPeriodicAdvCreateSync          },
-  (HCI_LE_PERIODIC_ADV_CREATE_SYNC_CANCEL     ,hciLEPeriodicAdvCreateSyncCancel    },
-  (HCI_LE_PERIODIC_ADV_TERMINATE_SYNC         ,hciLEPeriodicAdvTerminateSync       },
-  (HCI_LE_ADD_DEVICE_TO_PERIODIC_ADV_LIST     ,hciLEAddDeviceToPeriodicAdvList     },
-  (HCI_LE_REMOVE_DEVICE_FROM_PERIODIC_ADV_LIST,hciLERemoveDeviceFromPeriodicAdvList},
-  (HCI_LE_CLEAR_PERIODIC_ADV_LIST             ,hciLEClearPeriodicAdvList           },
-  (HCI_LE_READ_PERIODIC_ADV_LIST_SIZE         ,hciLEReadPeriodicAdvListSize        },
-  (HCI_LE_SET_PERIODIC_ADV_RECEIVE_ENABLE     ,hciLESetPeriodicAdvReceiveEnable    },
-  (HCI_LE_SET_CONNECTIONLESS_IQ_SAMPLING_ENABLE,hciLESetConnectionlessIqSamplingEnable},
-#endif
-
-  // Vendor Specific Commands
-  {HCI_EXT_SET_RX_GAIN                      , hciExtSetRxGain                  },
-  {HCI_EXT_SET_TX_POWER                     , hciExtSetTxPower                 },
-  {HCI_EXT_SET_TX_POWER_DBM                 , hciExtSetTxPowerDbm              },
-  {HCI_EXT_EXTEND_RF_RANGE                  , hciExtExtendRfRange              },
-  {HCI_EXT_HALT_DURING_RF                   , hciExtHaltDuringRf               },
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
-  {HCI_EXT_ONE_PKT_PER_EVT                  , hciExtOnePktPerEvt               },
-#endif // ADV_CONN_CFG | INIT_CFG
-  {HCI_EXT_CLK_DIVIDE_ON_HALT               , hciExtClkDivOnHalt               },
-  {HCI_EXT_DECLARE_NV_USAGE                 , hciExtDeclareNvUsage             },
-  {HCI_EXT_DECRYPT                          , hciExtDecrypt                    },
-  {HCI_EXT_SET_LOCAL_SUPPORTED_FEATURES     , hciExtSetLocalSupportedFeatures  },
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & ADV_CONN_CFG)
-  {HCI_EXT_SET_FAST_TX_RESP_TIME            , hciExtSetFastTxResponseTime      },
-  {HCI_EXT_OVERRIDE_PL                      , hciExtSetPeripheralLatencyOverride},
-#endif // ADV_CONN_CFG
-#if !defined(CTRL_V50_CONFIG)
-  {HCI_EXT_MODEM_TEST_TX                    , hciExtModemTestTx                },
-  {HCI_EXT_MODEM_HOP_TEST_TX                , hciExtModemHopTestTx             },
-  {HCI_EXT_MODEM_TEST_RX                    , hciExtModemtestRx                },
-  {HCI_EXT_END_MODEM_TEST                   , hciExtEndModemTest               },
-#endif // !CTRL_V50_CONFIG
-  {HCI_EXT_SET_BDADDR                       , hciExtSetBDADDR                  },
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
-  {HCI_EXT_SET_SCA                          , hciExtSetSCA                     },
-#endif // ADV_CONN_CFG | INIT_CFG
-  {HCI_EXT_SET_MAX_DTM_TX_POWER             , hciExtSetMaxDtmTxPower           },
-  {HCI_EXT_SET_MAX_DTM_TX_POWER_DBM         , hciExtSetMaxDtmTxPowerDbm        },
-  {HCI_EXT_MAP_PM_IO_PORT                   , hciExtMapPmIoPort                },
-  {HCI_EXT_SET_FREQ_TUNE                    , hciExtSetFreqTune                },
-  {HCI_EXT_SAVE_FREQ_TUNE                   , hciExtSaveFreqTune               },
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
-  {HCI_EXT_DISCONNECT_IMMED                 , hciExtDisconnectImmed            },
-  {HCI_EXT_PER                              , hciExtPER                        },
-  {HCI_EXT_OVERLAPPED_PROCESSING            , hciExtOverlappedProcessing       },
-  {HCI_EXT_NUM_COMPLETED_PKTS_LIMIT         , hciExtNumComplPktsLimit          },
-  {HCI_EXT_GET_CONNECTION_INFO              , hciExtGetConnInfo                },
-#endif // ADV_CONN_CFG | INIT_CFG
-  {HCI_EXT_BUILD_REVISION                   , hciExtBuildRevision              },
-  {HCI_EXT_DELAY_SLEEP                      , hciExtDelaySleep                 },
-  // TEMP: OVERLAPPED PROCESSING HOLDER
-  {HCI_EXT_RESET_SYSTEM                     , hciExtResetSystem                },
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & ADV_NCONN_CFG )
-  {HCI_EXT_LE_SET_EXT_VIRTUAL_ADV_ADDRESS   , hciExtSetVirtualAdvAddr          },
-#endif // ADV_NCONN_CFG
-#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
-  {HCI_EXT_SET_MAX_DATA_LENGTH              , hciExtSetMaxDataLen             },
-#endif // (ADV_CONN_CFG | INIT_CFG)
-#ifdef LL_TEST_MODE
-  {HCI_EXT_LL_TEST_MODE                     , hciExtLLTestMode                 },
-#endif // LL_TEST_MODE
-  {HCI_EXT_READ_RAND_ADDR                   , hciExtReadRandAddr               },
+#define HCI_TL_CMD( opCode, hciFunc )  { opCode, hciFunc },
+#include "hci_tl_cmd_table.h"
+#undef HCI_TL_CMD
 
   // Last Table Entry Delimiter
   {0xFFFF                                   , NULL                             }
@@ -597,6 +395,11 @@ void HCI_Init( uint8 taskID )
   // disable HCI Vendor Specific Event Mask
   hciVsEvtMask = NO_FEATURES_ENABLED;
 
+#if !defined(HCI_TL_NONE) && !defined(ICALL_LITE)
+  // index the command table by opcode
+  (void)hciBuildCmdIdx( hciCmdTable );
+#endif // !HCI_TL_NONE && !ICALL_LITE
+
   return;
 }
 
@@ -762,32 +565,22 @@ void HCI_SMPTaskRegister( uint8 taskID )
  */
 void hciProcessHostToCtrlCmd( hciPacket_t *pMsg )
 {
-  uint16 cmdOpCode;
-  uint8  status;
-  uint8  i = 0;
+  uint16         cmdOpCode;
+  uint8          status;
+  cmdPktTable_t *pCmd;
 
   // retrieve opcode
   cmdOpCode = BUILD_UINT16 (pMsg->pData[1], pMsg->pData[2]);
 
   // lookup corresponding function
-  while ((hciCmdTable[i].opCode != 0xFFFF) && (hciCmdTable[i].hciFunc != NULL))
-  {
-    // there's a valid entry at this index, but check if it's the one we want
-    if (hciCmdTable[i].opCode == cmdOpCode)
-    {
-      // it is, so jump to this function
-      (void)(hciCmdTable[i].hciFunc)(&pMsg->pData[4]);
+  pCmd = hciFindCmd( cmdOpCode );
 
-      // done
-      break;
-    }
-
-    // next...
-    i++;
+  if ( pCmd != NULL )
+  {
+    // jump to this function
+    (void)(pCmd->hciFunc)(&pMsg->pData[4]);
   }
-
-  // check if a matching opcode was found
-  if ((hciCmdTable[i].opCode == 0xFFFF) && (hciCmdTable[i].hciFunc == NULL))
+  else
   {
     // none found, so return error
     status = HCI_ERROR_CODE_UNKNOWN_HCI_CMD;
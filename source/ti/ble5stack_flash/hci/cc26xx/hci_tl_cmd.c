@@ -0,0 +1,202 @@
+/******************************************************************************
+
+ @file  hci_tl_cmd.c
+
+ @brief This file includes the opcode index of the HCI Transport Layer
+        command table, used to dispatch HCI commands received from the Host.
+
+ Group: WCS, BTS
+ Target Device: cc23xx
+
+ ******************************************************************************
+ 
+ Copyright (c) 2009-2024, Texas Instruments Incorporated
+
+ All rights reserved not granted herein.
+ Limited License.
+
+ Texas Instruments Incorporated grants a world-wide, royalty-free,
+ non-exclusive license under copyrights and patents it now or hereafter
+ owns or controls to make, have made, use, import, offer to sell and sell
+ ("Utilize") this software subject to the terms herein. With respect to the
+ foregoing patent license, such license is granted solely to the extent that
+ any such patent is necessary to Utilize the software alone. The patent
+ license shall not apply to any combinations which include this software,
+ other than combinations with devices manufactured by or for TI ("TI
+ Devices"). No hardware patent is licensed hereunder.
+
+ Redistributions must preserve existing copyright notices and reproduce
+ this license (including the above copyright notice and the disclaimer and
+ (if applicable) source code license limitations below) in the documentation
+ and/or other materials provided with the distribution.
+
+ Redistribution and use in binary form, without modification, are permitted
+ provided that the following conditions are met:
+
+   * No reverse engineering, decompilation, or disassembly of this software
+     is permitted with respect to any software provided in binary form.
+   * Any redistribution and use are licensed by TI for use only with TI Devices.
+   * Nothing shall obligate TI to provide you with source code for the software
+     licensed and provided to you in object code.
+
+ If software source code is provided to you, modification and redistribution
+ of the source code are permitted provided that the following conditions are
+ met:
+
+   * Any redistribution and use of the source code, including any resulting
+     derivative works, are licensed by TI for use only with TI Devices.
+   * Any redistribution and use of any object code compiled from the source
+     code and any resulting derivative works, are licensed by TI for use
+     only with TI Devices.
+
+ Neither the name of Texas Instruments Incorporated nor the names of its
+ suppliers may be used to endorse or promote products derived from this
+ software without specific prior written permission.
+
+ DISCLAIMER.
+
+ THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ 
+ 
+ *****************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include "hci_tl_cmd.h"
+
+/*******************************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Open addressed index of the command table by opcode, built from the table
+// so that the table stays the only list of supported commands
+static uint8 hciCmdIdx[HCI_CMD_IDX_SIZE];
+
+// Command table last passed to hciBuildCmdIdx
+static cmdPktTable_t *hciCmdIdxTable = NULL;
+
+// Set once hciCmdIdx covers the whole command table
+static uint8 hciCmdIdxValid = FALSE;
+
+/*
+** Command Index API
+*/
+
+/*******************************************************************************
+ * This routine builds the opcode index of a command table.
+ *
+ * Public function defined in hci_tl_cmd.h.
+ */
+uint8 hciBuildCmdIdx( cmdPktTable_t *pCmdTable )
+{
+  uint16 i;
+  uint16 slot;
+
+  hciCmdIdxTable = pCmdTable;
+  hciCmdIdxValid = FALSE;
+
+  for ( slot = 0; slot < HCI_CMD_IDX_SIZE; slot++ )
+  {
+    hciCmdIdx[slot] = HCI_CMD_IDX_EMPTY;
+  }
+
+  for ( i = 0; (pCmdTable[i].opCode != 0xFFFF) && (pCmdTable[i].hciFunc != NULL); i++ )
+  {
+    // keep at least one slot empty to terminate lookups
+    if ( i >= (HCI_CMD_IDX_SIZE - 1) )
+    {
+      return ( FALSE );
+    }
+
+    slot = HCI_CMD_IDX_HASH( pCmdTable[i].opCode );
+
+    while ( (hciCmdIdx[slot] != HCI_CMD_IDX_EMPTY) &&
+            (pCmdTable[hciCmdIdx[slot]].opCode != pCmdTable[i].opCode) )
+    {
+      slot = (slot + 1) & (HCI_CMD_IDX_SIZE - 1);
+    }
+
+    // the first entry for an opcode wins, as with a scan of the table
+    if ( hciCmdIdx[slot] == HCI_CMD_IDX_EMPTY )
+    {
+      hciCmdIdx[slot] = (uint8)i;
+    }
+  }
+
+  hciCmdIdxValid = TRUE;
+
+  return ( TRUE );
+}
+
+
+/*******************************************************************************
+ * This routine finds the entry for an opcode in the indexed command table.
+ *
+ * Public function defined in hci_tl_cmd.h.
+ */
+cmdPktTable_t *hciFindCmd( uint16 opCode )
+{
+  uint16 i;
+
+  if ( hciCmdIdxValid == TRUE )
+  {
+    i = HCI_CMD_IDX_HASH( opCode );
+
+    while ( hciCmdIdx[i] != HCI_CMD_IDX_EMPTY )
+    {
+      if ( hciCmdIdxTable[hciCmdIdx[i]].opCode == opCode )
+      {
+        return ( &hciCmdIdxTable[hciCmdIdx[i]] );
+      }
+
+      i = (i + 1) & (HCI_CMD_IDX_SIZE - 1);
+    }
+
+    return ( NULL );
+  }
+
+  if ( hciCmdIdxTable == NULL )
+  {
+    return ( NULL );
+  }
+
+  return ( hciScanCmd( hciCmdIdxTable, opCode ) );
+}
+
+
+/*******************************************************************************
+ * This routine finds the entry for an opcode by scanning a command table.
+ *
+ * Public function defined in hci_tl_cmd.h.
+ */
+cmdPktTable_t *hciScanCmd( cmdPktTable_t *pCmdTable, uint16 opCode )
+{
+  uint16 i;
+
+  for ( i = 0; (pCmdTable[i].opCode != 0xFFFF) && (pCmdTable[i].hciFunc != NULL); i++ )
+  {
+    if ( pCmdTable[i].opCode == opCode )
+    {
+      return ( &pCmdTable[i] );
+    }
+  }
+
+  return ( NULL );
+}
+
+
+/*******************************************************************************
+ */
@@ -125,6 +125,9 @@
 #define MIN_ENC_KEYSIZE                     7  //!< Minimum number of bytes for the encryption key
 #define MAX_ENC_KEYSIZE                     16 //!< Maximum number of bytes for the encryption key
 
+// No bond record index, ends the lists of the bond record index
+#define GAP_BOND_IDX_NONE                               0xFF
+
 // Pairing Queue States
 typedef enum gbmPairFSM
 {
@@ -154,6 +157,18 @@ typedef struct gapBondStateQueueNode
 
 typedef gapBondStateNode_t *gapBondStateNodePtr_t;
 
+// RAM index of a bond record slot. The lists are linked by slot number.
+typedef struct
+{
+  uint8_t used;             // TRUE if the slot holds a bond
+  uint8_t addrNext;         // Next slot in the same address bucket, or next empty slot
+  uint8_t irkNext;          // Next slot in the same IRK bucket
+  uint8_t lruPrev;          // Less recently used slot
+  uint8_t lruNext;          // More recently used slot
+  uint8_t hasIrk;           // TRUE if irk holds the peer's IRK
+  uint8_t irk[KEYLEN];      // Peer's IRK, as stored in NV
+} gapBondIndex_t;
+
 /*********************************************************************
  * GLOBAL VARIABLES
  */
@@ -265,6 +280,17 @@ static const gapBondCBs_t *pGapBondCB = NULL;
 // Local RAM shadowed bond records
 static gapBondRec_t *bonds = NULL;      //will hold gapBond_maxBonds elements
 
+// Index of the bond records: address and IRK hash buckets, empty slots and
+// least recently used order
+static gapBondIndex_t *bondIdxTbl = NULL;   //will hold gapBond_maxBonds elements
+static uint8_t *bondAddrHash = NULL;        //will hold gapBond_hashMask + 1 elements
+static uint8_t *bondIrkHash = NULL;         //will hold gapBond_hashMask + 1 elements
+static uint8_t gapBond_hashMask = 0;
+static uint8_t gapBond_emptyHead = GAP_BOND_IDX_NONE;
+static uint8_t gapBond_lruHead = GAP_BOND_IDX_NONE;  // Least recently used
+static uint8_t gapBond_lruTail = GAP_BOND_IDX_NONE;  // Most recently used
+static uint8_t gapBond_numBonds = 0;
+
 static uint8_t autoSyncAcceptList = FALSE;
 
 static uint8_t eraseAllBonds = FALSE;
@@ -303,12 +329,21 @@ static uint8_t gapBondMgrSaveBond(uint8_t bondIdx, gapBondRec_t* pBondRec,
                                   gapBondLTK_t* pLocalLtk, gapBondLTK_t* pDevLtk,
                                   uint8_t* pIRK, uint8_t* pSRK, uint32_t signCount,
                                   int8_t syncRL);
-static uint8_t gapBondFindIrkResolvingList( uint8_t* pIRK );
+static uint8_t gapBondFindIrk( uint8_t* pIRK );
 static uint8_t gapBondMgrAddBond(gapBondRec_t *pBondRec,
                                  gapAuthCompleteEvent_t *pPkt);
 static uint8_t gapBondMgrGetStateFlags(uint8_t idx);
 
 static void gapBondMgrReadBonds(void);
+static void gapBondMgrReadBondItem(osalSnvId_t id, osalSnvLen_t len, void *pBuf);
+static uint8_t gapBondIsIrkValid(uint8_t *pIRK);
+static uint8_t gapBondHashAddr(uint8_t *pAddr, uint8_t addrType);
+static uint8_t gapBondHashIrk(uint8_t *pIRK);
+static void gapBondIndexBuild(void);
+static void gapBondIndexAdd(uint8_t idx);
+static void gapBondIndexRemove(uint8_t idx);
+static void gapBondIndexSetIrk(uint8_t idx, uint8_t *pIRK);
+static void gapBondIndexUnlink(uint8_t *pLink, uint8_t idx, uint8_t isIrk);
 static uint8_t gapBondMgrFindEmpty(void);
 static uint8_t gapBondMgrBondTotal(void);
 static bStatus_t gapBondMgrEraseAllBondings(void);
@@ -330,6 +365,8 @@ static uint8_t gapBondMgr_SyncCharCfg(uint16_t connHandle);
 static void gapBondMgrReadLruBondList(void);
 static uint8_t gapBondMgrGetLruBondIndex(void);
 static void gapBondMgrUpdateLruBondList(uint8_t bondIndex);
+static void gapBondMgrBuildLruList(void);
+static void gapBondMgrStoreLruList(void);
 
 //#if !defined GATT_NO_SERVICE_CHANGED || !defined GATT_NO_CLIENT
 static uint8_t gapBondMgrChangeState(uint8_t idx, uint16_t state, uint8_t set);
@@ -1007,12 +1044,14 @@ bStatus_t GAPBondMgr_FindAddr(uint8_t *pDevAddr,
     return ( bleInvalidRange );
   }
 
-  uint8_t idx = gapBond_maxBonds;
+  uint8_t idx;
 
-  // Search through bonding table
-  for(idx = 0; idx < gapBond_maxBonds; idx++)
+  // Compare against the addresses stored in the bonding records of the
+  // address bucket
+  for(idx = bondAddrHash[gapBondHashAddr(pDevAddr, addrType)];
+      idx != GAP_BOND_IDX_NONE;
+      idx = bondIdxTbl[idx].addrNext)
   {
-    // Compare against address stored in bonding record.
     if(MAP_osal_memcmp(bonds[idx].addr, pDevAddr, B_ADDR_LEN) &&
        (addrType == bonds[idx].addrType))
     {
@@ -1022,14 +1061,24 @@ bStatus_t GAPBondMgr_FindAddr(uint8_t *pDevAddr,
       }
       return (SUCCESS);
     }
-    // The public address in the bonding table could be an identity address if we
-    // received the identity information during pairing so try to resolve the
-    // address if it is random private resolvable.
-    if ((addrType == PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID) && (GAP_IS_ADDR_RPR(pDevAddr)))
+  }
+
+  // The public address in the bonding table could be an identity address if we
+  // received the identity information during pairing so try to resolve the
+  // address if it is random private resolvable. Most recently used bonds
+  // are tried first.
+  if ((addrType != PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID) || !(GAP_IS_ADDR_RPR(pDevAddr)))
+  {
+    return (bleGAPNotFound);
+  }
+
+  for(idx = gapBond_lruTail; idx != GAP_BOND_IDX_NONE; idx = bondIdxTbl[idx].lruPrev)
+  {
+    if (bondIdxTbl[idx].hasIrk)
     {
-      // Read the IRK from NV
       uint8_t tempIRK[KEYLEN];
-      osal_snv_read(DEV_IRK_NV_ID(idx), KEYLEN, tempIRK);
+
+      MAP_osal_memcpy(tempIRK, bondIdxTbl[idx].irk, KEYLEN);
 
       // Reverse it (in place) to pass to controller
       MAP_LL_ENC_ReverseBytes(tempIRK, KEYLEN);
@@ -2336,14 +2385,29 @@ static uint8_t gapBondMgrSaveBond(uint8_t bondIdx,
 
   snvErrorCode |= osal_snv_write(GATT_CFG_NV_ID(bondIdx), sizeof(gapBondCharCfg_t) * gapBond_maxCharCfg, charCfg);
 
+  // A slot reused for another device gets a new index entry
+  if ((bondIdxTbl[bondIdx].used == TRUE) &&
+      ((bonds[bondIdx].addrType != pBondRec->addrType) ||
+       (MAP_osal_memcmp(bonds[bondIdx].addr, pBondRec->addr, B_ADDR_LEN) == FALSE)))
+  {
+    gapBondIndexRemove(bondIdx);
+  }
+
   // Update Bond RAM Shadow just with the newly added bond entry
   VOID MAP_osal_memcpy(&(bonds[bondIdx]), pBondRec, sizeof(gapBondRec_t));
 
+  if (bondIdxTbl[bondIdx].used == FALSE)
+  {
+    gapBondIndexAdd(bondIdx);
+  }
+
   if (pIRK)
   {
     // Check if the IRK is all zeros, don't add it to the resolving List
     if (MAP_osal_isbufset(pIRK, 0x00, KEYLEN) == FALSE)
 	{
+      gapBondIndexSetIrk(bondIdx, pIRK);
+
       // Add device to resolving list
       if ((HCI_LE_AddDeviceToResolvingListCmd((pBondRec->addrType & MASK_ADDRTYPE_ID),
                                                pBondRec->addr, pIRK, NULL) != SUCCESS) && syncRL)
@@ -2385,38 +2449,35 @@ static uint8_t gapBondMgrSaveBond(uint8_t bondIdx,
 }
 
 /*********************************************************************
- * @fn      gapBondFindIrkResolvingList
+ * @fn      gapBondFindIrk
  *
- * @brief   Search the IRK given in the resolving list
+ * @brief   Search the bond records for the IRK given
  *
- * @param   pIRK - IRK to search for
+ * @param   pIRK - IRK to search for, as stored in NV
  *
- * @return index if IRK was added
- *         INVALID_RESOLVE_LIST_INDEX if IRK was not found
+ * @return index of the bond record with this IRK
+ *         GAP_BOND_IDX_NONE if IRK was not found
  */
-static uint8_t gapBondFindIrkResolvingList( uint8_t* pIRK )
+static uint8_t gapBondFindIrk( uint8_t* pIRK )
 {
   uint8_t idx;
-  uint8_t tempIRK[KEYLEN];
-
-  MAP_osal_memcpy(tempIRK, pIRK, KEYLEN);
 
-  // Reverse it (in place) to pass to controller
-  MAP_LL_ENC_ReverseBytes(tempIRK, KEYLEN);
+  if (gapBondIsIrkValid(pIRK) == FALSE)
+  {
+    return GAP_BOND_IDX_NONE;
+  }
 
-  for( idx = 0; idx < BLE_RESOLVING_LIST_SIZE; idx++ )
+  for(idx = bondIrkHash[gapBondHashIrk(pIRK)];
+      idx != GAP_BOND_IDX_NONE;
+      idx = bondIdxTbl[idx].irkNext)
   {
-    // check if the Resolving List entry is valid
-    if ( resolvingList[idx].idAddrType != EMPTY_RESOLVE_LIST_ENTRY )
+    if (MAP_osal_memcmp(pIRK, bondIdxTbl[idx].irk, KEYLEN) == TRUE)
     {
-      if( MAP_osal_memcmp(tempIRK, resolvingList[idx].IRK, KEYLEN) == TRUE )
-      {
-        return idx;
-      }
+      return idx;
     }
   }
 
-  return INVALID_RESOLVE_LIST_INDEX;
+  return GAP_BOND_IDX_NONE;
 }
 
 /*********************************************************************
@@ -2439,20 +2500,20 @@ static uint8_t gapBondMgrAddBond(gapBondRec_t *pBondRec,
                                  gapAuthCompleteEvent_t *pPkt)
 {
   uint8_t bondIdx;
-  uint8_t rlIndex = INVALID_RESOLVE_LIST_INDEX;
+  uint8_t irkIdx = GAP_BOND_IDX_NONE;
   uint8_t snvErrorCode = SUCCESS;
 
-  // Check if the IRK can be found in the Resolving List
+  // Check if the IRK can be found in another bond
   if(pPkt->pIdentityInfo)
   {
-    rlIndex = gapBondFindIrkResolvingList( pPkt->pIdentityInfo->irk );
+    irkIdx = gapBondFindIrk( pPkt->pIdentityInfo->irk );
   }
 
   // Check if the bond information
   bStatus_t findStatus = GAPBondMgr_FindAddr(pBondRec->addr, pBondRec->addrType,
                                              &bondIdx, NULL, NULL);
 
-  if( ( rlIndex != INVALID_RESOLVE_LIST_INDEX ) &&
+  if( ( irkIdx != GAP_BOND_IDX_NONE ) &&
       ( findStatus == bleGAPNotFound ) )
   {
     // This means we have two different Identity Addresses with the same IRK
@@ -2460,14 +2521,7 @@ static uint8_t gapBondMgrAddBond(gapBondRec_t *pBondRec,
     {
       case GAPBOND_SAME_IRK_UPDATE_BOND_REC:
       {
-        findStatus = GAPBondMgr_FindAddr(resolvingList[rlIndex].idAddr,
-                                         (GAP_Peer_Addr_Types_t)resolvingList[rlIndex].idAddrType,
-                                         &bondIdx, NULL, NULL);
-
-        if( findStatus != SUCCESS )
-        {
-          break;
-        }
+        bondIdx = irkIdx;
         snvErrorCode = gapBondMgrEraseBonding(bondIdx);
 
         if( snvErrorCode != SUCCESS )
@@ -2795,25 +2849,288 @@ void gapBondMgr_gapIdle(void)
 static void gapBondMgrReadBonds(void)
 {
   uint8_t idx;
+  union
+  {
+    gapBondRec_t bondRec;
+    uint8_t irk[KEYLEN];
+  } item;
 
   for(idx = 0; idx < gapBond_maxBonds; idx++)
   {
-    // See if the entry exists in NV
-    if(osal_snv_read(MAIN_RECORD_NV_ID(idx), sizeof(gapBondRec_t),
-       &(bonds[idx])) != SUCCESS)
+    // Entries not found in NV don't exist
+    VOID MAP_osal_memset(bonds[idx].addr, 0xFF, B_ADDR_LEN);
+    bonds[idx].stateFlags = 0;
+    bondIdxTbl[idx].hasIrk = FALSE;
+  }
+
+  // Read the bond records and the IRKs in one pass through NV
+  if(osal_snv_read_each(BLE_NVID_GAP_BOND_START,
+                        MAIN_RECORD_NV_ID(gapBond_maxBonds) - 1,
+                        sizeof(item), &item, gapBondMgrReadBondItem) != SUCCESS)
+  {
+    // Else read them one by one
+    for(idx = 0; idx < gapBond_maxBonds; idx++)
     {
-      // Can't read the entry, assume that it doesn't exist
-      VOID MAP_osal_memset(bonds[idx].addr, 0xFF, B_ADDR_LEN);
-      bonds[idx].stateFlags = 0;
+      // See if the entry exists in NV
+      if(osal_snv_read(MAIN_RECORD_NV_ID(idx), sizeof(gapBondRec_t),
+         &(bonds[idx])) != SUCCESS)
+      {
+        // Can't read the entry, assume that it doesn't exist
+        VOID MAP_osal_memset(bonds[idx].addr, 0xFF, B_ADDR_LEN);
+        bonds[idx].stateFlags = 0;
+      }
+      else if(osal_snv_read(DEV_IRK_NV_ID(idx), KEYLEN, item.irk) == SUCCESS)
+      {
+        gapBondMgrReadBondItem(DEV_IRK_NV_ID(idx), KEYLEN, item.irk);
+      }
     }
   }
 
+  gapBondIndexBuild();
+
   if(autoSyncAcceptList)
   {
     gapBondMgr_SyncAcceptList();
   }
 }
 
+/*********************************************************************
+ * @fn      gapBondMgrReadBondItem
+ *
+ * @brief   Store a bond NV item read by gapBondMgrReadBonds in RAM.
+ *
+ * @param   id - NV ID of the item
+ * @param   len - length of the item
+ * @param   pBuf - item
+ *
+ * @return  none
+ */
+static void gapBondMgrReadBondItem(osalSnvId_t id, osalSnvLen_t len, void *pBuf)
+{
+  uint8_t idx = (id - BLE_NVID_GAP_BOND_START) / GAP_BOND_REC_IDS;
+  uint8_t offset = (id - BLE_NVID_GAP_BOND_START) % GAP_BOND_REC_IDS;
+
+  if(idx >= gapBond_maxBonds)
+  {
+    return;
+  }
+
+  if((offset == GAP_BOND_REC_ID_OFFSET) && (len == sizeof(gapBondRec_t)))
+  {
+    VOID MAP_osal_memcpy(&(bonds[idx]), pBuf, sizeof(gapBondRec_t));
+  }
+  else if((offset == GAP_BOND_DEV_IRK_OFFSET) && (len == KEYLEN))
+  {
+    // Linked to the IRK buckets by gapBondIndexBuild
+    VOID MAP_osal_memcpy(bondIdxTbl[idx].irk, pBuf, KEYLEN);
+    bondIdxTbl[idx].hasIrk = gapBondIsIrkValid(pBuf);
+  }
+}
+
+/*********************************************************************
+ * @fn      gapBondIsIrkValid
+ *
+ * @brief   Check that an IRK is set. Erased IRKs are all 0xFF's and
+ *          identity address only peers have an IRK of all zeros.
+ *
+ * @param   pIRK - IRK
+ *
+ * @return  TRUE if the IRK can resolve addresses
+ */
+static uint8_t gapBondIsIrkValid(uint8_t *pIRK)
+{
+  return ((MAP_osal_isbufset(pIRK, 0xFF, KEYLEN) == FALSE) &&
+          (MAP_osal_isbufset(pIRK, 0x00, KEYLEN) == FALSE));
+}
+
+/*********************************************************************
+ * @fn      gapBondHashAddr
+ *
+ * @brief   Get the address bucket of a peer
+ *
+ * @param   pAddr - peer's address
+ * @param   addrType - peer's address type
+ *
+ * @return  bucket
+ */
+static uint8_t gapBondHashAddr(uint8_t *pAddr, uint8_t addrType)
+{
+  uint8_t hash = addrType;
+  uint8_t i;
+
+  for(i = 0; i < B_ADDR_LEN; i++)
+  {
+    hash = (uint8_t)((hash * 31) + pAddr[i]);
+  }
+
+  return (hash & gapBond_hashMask);
+}
+
+/*********************************************************************
+ * @fn      gapBondHashIrk
+ *
+ * @brief   Get the IRK bucket of an IRK. IRKs are random, a few of their
+ *          bytes are enough.
+ *
+ * @param   pIRK - IRK
+ *
+ * @return  bucket
+ */
+static uint8_t gapBondHashIrk(uint8_t *pIRK)
+{
+  return ((pIRK[0] ^ pIRK[KEYLEN / 2] ^ pIRK[KEYLEN - 1]) & gapBond_hashMask);
+}
+
+/*********************************************************************
+ * @fn      gapBondIndexBuild
+ *
+ * @brief   Build the bond record index from the RAM shadow. IRKs must
+ *          already be in the index.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+static void gapBondIndexBuild(void)
+{
+  uint8_t idx;
+
+  VOID MAP_osal_memset(bondAddrHash, GAP_BOND_IDX_NONE, gapBond_hashMask + 1);
+  VOID MAP_osal_memset(bondIrkHash, GAP_BOND_IDX_NONE, gapBond_hashMask + 1);
+  gapBond_emptyHead = GAP_BOND_IDX_NONE;
+  gapBond_numBonds = 0;
+
+  // Walk down so that the lowest empty slot is used first
+  for(idx = gapBond_maxBonds; idx > 0; idx--)
+  {
+    gapBondIndex_t *pEntry = &bondIdxTbl[idx - 1];
+
+    if(MAP_osal_isbufset(bonds[idx - 1].addr, 0xFF, B_ADDR_LEN))
+    {
+      pEntry->used = FALSE;
+      pEntry->hasIrk = FALSE;
+      pEntry->addrNext = gapBond_emptyHead;
+      gapBond_emptyHead = idx - 1;
+    }
+    else
+    {
+      uint8_t bucket = gapBondHashAddr(bonds[idx - 1].addr, bonds[idx - 1].addrType);
+
+      pEntry->used = TRUE;
+      pEntry->addrNext = bondAddrHash[bucket];
+      bondAddrHash[bucket] = idx - 1;
+      gapBond_numBonds++;
+
+      if(pEntry->hasIrk)
+      {
+        bucket = gapBondHashIrk(pEntry->irk);
+        pEntry->irkNext = bondIrkHash[bucket];
+        bondIrkHash[bucket] = idx - 1;
+      }
+    }
+  }
+}
+
+/*********************************************************************
+ * @fn      gapBondIndexAdd
+ *
+ * @brief   Add the bond just stored in the RAM shadow to the index
+ *
+ * @param   idx - bond record index
+ *
+ * @return  none
+ */
+static void gapBondIndexAdd(uint8_t idx)
+{
+  uint8_t bucket = gapBondHashAddr(bonds[idx].addr, bonds[idx].addrType);
+
+  // The slot is usually the first empty one
+  gapBondIndexUnlink(&gapBond_emptyHead, idx, FALSE);
+
+  bondIdxTbl[idx].used = TRUE;
+  bondIdxTbl[idx].hasIrk = FALSE;
+  bondIdxTbl[idx].addrNext = bondAddrHash[bucket];
+  bondAddrHash[bucket] = idx;
+  gapBond_numBonds++;
+}
+
+/*********************************************************************
+ * @fn      gapBondIndexRemove
+ *
+ * @brief   Remove a bond from the index, its slot becomes empty
+ *
+ * @param   idx - bond record index
+ *
+ * @return  none
+ */
+static void gapBondIndexRemove(uint8_t idx)
+{
+  gapBondIndexSetIrk(idx, NULL);
+  gapBondIndexUnlink(&bondAddrHash[gapBondHashAddr(bonds[idx].addr, bonds[idx].addrType)],
+                     idx, FALSE);
+
+  bondIdxTbl[idx].used = FALSE;
+  bondIdxTbl[idx].addrNext = gapBond_emptyHead;
+  gapBond_emptyHead = idx;
+  gapBond_numBonds--;
+}
+
+/*********************************************************************
+ * @fn      gapBondIndexSetIrk
+ *
+ * @brief   Set the IRK of a bond in the index
+ *
+ * @param   idx - bond record index
+ * @param   pIRK - IRK, NULL to clear it
+ *
+ * @return  none
+ */
+static void gapBondIndexSetIrk(uint8_t idx, uint8_t *pIRK)
+{
+  gapBondIndex_t *pEntry = &bondIdxTbl[idx];
+
+  if(pEntry->hasIrk)
+  {
+    gapBondIndexUnlink(&bondIrkHash[gapBondHashIrk(pEntry->irk)], idx, TRUE);
+    pEntry->hasIrk = FALSE;
+  }
+
+  if((pIRK != NULL) && gapBondIsIrkValid(pIRK))
+  {
+    uint8_t bucket = gapBondHashIrk(pIRK);
+
+    VOID MAP_osal_memcpy(pEntry->irk, pIRK, KEYLEN);
+    pEntry->hasIrk = TRUE;
+    pEntry->irkNext = bondIrkHash[bucket];
+    bondIrkHash[bucket] = idx;
+  }
+}
+
+/*********************************************************************
+ * @fn      gapBondIndexUnlink
+ *
+ * @brief   Remove a slot from a list of the index
+ *
+ * @param   pLink - head of the list
+ * @param   idx - bond record index
+ * @param   isIrk - TRUE for an IRK bucket, FALSE for an address bucket
+ *                  or the empty slots
+ *
+ * @return  none
+ */
+static void gapBondIndexUnlink(uint8_t *pLink, uint8_t idx, uint8_t isIrk)
+{
+  while((*pLink != GAP_BOND_IDX_NONE) && (*pLink != idx))
+  {
+    pLink = isIrk ? &bondIdxTbl[*pLink].irkNext : &bondIdxTbl[*pLink].addrNext;
+  }
+
+  if(*pLink == idx)
+  {
+    *pLink = isIrk ? bondIdxTbl[idx].irkNext : bondIdxTbl[idx].addrNext;
+  }
+}
+
 /*********************************************************************
  * @fn      gapBondMgrReadLruBondList
  *
@@ -2837,6 +3154,91 @@ static void gapBondMgrReadLruBondList(void)
       gapBond_lruBondList[idx] = gapBond_maxBonds - idx - 1;
     }
   }
+
+  gapBondMgrBuildLruList();
+}
+
+/*********************************************************************
+ * @fn      gapBondMgrBuildLruList
+ *
+ * @brief   Link the bond records in the order of the LRU list read from
+ *          NV. Slots missing from it are the least recently used.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+static void gapBondMgrBuildLruList(void)
+{
+  uint8_t idx;
+
+  for(idx = 0; idx < gapBond_maxBonds; idx++)
+  {
+    bondIdxTbl[idx].lruPrev = GAP_BOND_IDX_NONE;
+    bondIdxTbl[idx].lruNext = GAP_BOND_IDX_NONE;
+  }
+  gapBond_lruHead = GAP_BOND_IDX_NONE;
+  gapBond_lruTail = GAP_BOND_IDX_NONE;
+
+  for(uint8_t i = 0; i < gapBond_maxBonds; i++)
+  {
+    idx = gapBond_lruBondList[i];
+
+    // Skip invalid and repeated entries, as left by erasing local info
+    if((idx < gapBond_maxBonds) && (idx != gapBond_lruHead) &&
+       (bondIdxTbl[idx].lruPrev == GAP_BOND_IDX_NONE))
+    {
+      bondIdxTbl[idx].lruPrev = gapBond_lruTail;
+      if(gapBond_lruTail != GAP_BOND_IDX_NONE)
+      {
+        bondIdxTbl[gapBond_lruTail].lruNext = idx;
+      }
+      else
+      {
+        gapBond_lruHead = idx;
+      }
+      gapBond_lruTail = idx;
+    }
+  }
+
+  for(idx = 0; idx < gapBond_maxBonds; idx++)
+  {
+    if((idx != gapBond_lruHead) && (bondIdxTbl[idx].lruPrev == GAP_BOND_IDX_NONE))
+    {
+      bondIdxTbl[idx].lruNext = gapBond_lruHead;
+      if(gapBond_lruHead != GAP_BOND_IDX_NONE)
+      {
+        bondIdxTbl[gapBond_lruHead].lruPrev = idx;
+      }
+      else
+      {
+        gapBond_lruTail = idx;
+      }
+      gapBond_lruHead = idx;
+    }
+  }
+
+  gapBondMgrStoreLruList();
+}
+
+/*********************************************************************
+ * @fn      gapBondMgrStoreLruList
+ *
+ * @brief   Copy the LRU order to the list stored in NV
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+static void gapBondMgrStoreLruList(void)
+{
+  uint8_t idx = gapBond_lruHead;
+
+  for(uint8_t i = 0; i < gapBond_maxBonds; i++)
+  {
+    gapBond_lruBondList[i] = idx;
+    idx = bondIdxTbl[idx].lruNext;
+  }
 }
 
 /*********************************************************************
@@ -2853,7 +3255,7 @@ static void gapBondMgrReadLruBondList(void)
 static uint8_t gapBondMgrGetLruBondIndex(void)
 {
   // Return bond record index found in the LRU position.
-  return gapBond_lruBondList[0];
+  return gapBond_lruHead;
 }
 
 /*********************************************************************
@@ -2868,34 +3270,35 @@ static uint8_t gapBondMgrGetLruBondIndex(void)
  */
 static void gapBondMgrUpdateLruBondList(uint8_t bondIndex)
 {
-  uint8_t updateIdx = gapBond_maxBonds;
+  gapBondIndex_t *pEntry = &bondIdxTbl[bondIndex];
 
-  // Find the index
-  for(uint8_t i = gapBond_maxBonds; i > 0; i--)
+  // Nothing to do if it already is the most recently used
+  if((bondIndex >= gapBond_maxBonds) || (bondIndex == gapBond_lruTail))
   {
-    if(gapBond_lruBondList[i - 1] == bondIndex)
-    {
-      // Found.
-      updateIdx = i - 1;
-      break;
-    }
+    return;
   }
 
-  // Update list to make bondIndex the most recently used.
-  for(uint8_t i = updateIdx ; i < gapBond_maxBonds - 1; i++)
+  // Unlink it
+  if(pEntry->lruPrev != GAP_BOND_IDX_NONE)
   {
-    uint8_t swap = gapBond_lruBondList[i];
-    gapBond_lruBondList[i] = gapBond_lruBondList[i + 1];
-    gapBond_lruBondList[i + 1] = swap;
+    bondIdxTbl[pEntry->lruPrev].lruNext = pEntry->lruNext;
   }
-
-  // If there was any change to the list
-  if(updateIdx < gapBond_maxBonds - 1)
+  else
   {
-    // Store updated list in NV
-    osal_snv_write(BLE_LRU_BOND_LIST, sizeof(uint8_t) * gapBond_maxBonds,
-                   gapBond_lruBondList);
+    gapBond_lruHead = pEntry->lruNext;
   }
+  bondIdxTbl[pEntry->lruNext].lruPrev = pEntry->lruPrev;
+
+  // Make it the most recently used
+  pEntry->lruPrev = gapBond_lruTail;
+  pEntry->lruNext = GAP_BOND_IDX_NONE;
+  bondIdxTbl[gapBond_lruTail].lruNext = bondIndex;
+  gapBond_lruTail = bondIndex;
+
+  // Store updated list in NV
+  gapBondMgrStoreLruList();
+  osal_snv_write(BLE_LRU_BOND_LIST, sizeof(uint8_t) * gapBond_maxBonds,
+                 gapBond_lruBondList);
 }
 
 /*********************************************************************
@@ -2910,16 +3313,12 @@ static void gapBondMgrUpdateLruBondList(uint8_t bondIndex)
  */
 static uint8_t gapBondMgrFindEmpty(void)
 {
-  // Item doesn't exist, so create all the items
   uint8_t idx;
 
-  for(idx = 0; idx < gapBond_maxBonds; idx++)
+  // Lowest empty slot first
+  if(gapBond_emptyHead != GAP_BOND_IDX_NONE)
   {
-    // Look for public address of all 0xFF's
-    if(MAP_osal_isbufset(bonds[idx].addr, 0xFF, B_ADDR_LEN))
-    {
-      return (idx);   // Found one
-    }
+    return (gapBond_emptyHead);
   }
 
   // If all bonding records are used and LRU bond removal is permitted,
@@ -2946,20 +3345,8 @@ static uint8_t gapBondMgrFindEmpty(void)
  */
 static uint8_t gapBondMgrBondTotal(void)
 {
-  uint8_t idx;
-  uint8_t numBonds = 0;
-
-  // Item doesn't exist, so create all the items
-  for(idx = 0; idx < gapBond_maxBonds; idx++)
-  {
-    // Look for public address that are not 0xFF's
-    if(MAP_osal_isbufset(bonds[idx].addr, 0xFF, B_ADDR_LEN) == FALSE)
-    {
-      numBonds++; // Found one
-    }
-  }
-
-  return (numBonds);
+  // Kept up to date by the bond record index
+  return (gapBond_numBonds);
 }
 
 /*********************************************************************
@@ -3056,6 +3443,14 @@ static bStatus_t gapBondMgrEraseBonding(uint8_t idx)
     ret = SUCCESS;
   }
 
+  // Keep the RAM shadow and its index in line with NV
+  if(bondIdxTbl[idx].used == TRUE)
+  {
+    gapBondIndexRemove(idx);
+    VOID MAP_osal_memset(bonds[idx].addr, 0xFF, B_ADDR_LEN);
+    bonds[idx].stateFlags = 0;
+  }
+
   return (ret);
 }
 
@@ -3144,6 +3539,26 @@ void GAPBondMgr_Init(uint8_t task_id, uint8_t cfg_gapBond_maxBonds, uint8_t cfg_
   }
   MAP_osal_memset(gapBond_lruBondList, 0, sizeof (uint8_t) * gapBond_maxBonds);
 
+  // Hash buckets for the bond record index, a power of two at least as
+  // large as the number of bonds
+  for(gapBond_hashMask = 1; gapBond_hashMask < gapBond_maxBonds; gapBond_hashMask <<= 1);
+  gapBond_hashMask -= 1;
+
+  //static gapBondIndex_t bondIdxTbl[GAP_BONDINGS_MAX];
+  bondIdxTbl = (gapBondIndex_t *)MAP_osal_mem_alloc( (sizeof (gapBondIndex_t) * gapBond_maxBonds) +
+                                                     (2 * (gapBond_hashMask + 1)) );
+  if (bondIdxTbl == NULL)
+  {
+    MAP_osal_mem_free(bonds);
+    MAP_osal_mem_free(bondsToDelete);
+    MAP_osal_mem_free(gapBond_lruBondList);
+    HAL_ASSERT( HAL_ASSERT_CAUSE_OUT_OF_MEMORY );
+    return;
+  }
+  MAP_osal_memset(bondIdxTbl, 0, sizeof (gapBondIndex_t) * gapBond_maxBonds);
+  bondAddrHash = (uint8_t *)&bondIdxTbl[gapBond_maxBonds];
+  bondIrkHash = bondAddrHash + gapBond_hashMask + 1;
+
   // Register Call Back functions for GAP
   MAP_GAP_RegisterBondMgrCBs(&gapCBs);
 
@@ -3380,37 +3795,28 @@ bStatus_t gapBondMgr_syncResolvingList(void)
   // Write bond addresses into the Resolving List
   for(i = 0; i < gapBond_maxBonds; i++)
   {
-    // Make sure empty addresses are not added to the Resolving List
-    if(MAP_osal_isbufset(bonds[i].addr, 0xFF, B_ADDR_LEN) == FALSE)
+    // Only bonds with a valid IRK, not all 0xFF's and not all zeros as
+    // for an Identity address, go to the Resolving List. The index keeps
+    // a copy of the NV IRK records.
+    if(bondIdxTbl[i].used && bondIdxTbl[i].hasIrk)
     {
       uint8_t IRK[KEYLEN];
 
-      // Read in NV IRK Record
-      if(osal_snv_read(DEV_IRK_NV_ID(i), KEYLEN, IRK) == SUCCESS)
+      MAP_osal_memcpy(IRK, bondIdxTbl[i].irk, KEYLEN);
+
+      // Resolving list does not use ID addr types so must mask away bit
+      // prior to adding device to list
+      HCI_LE_AddDeviceToResolvingListCmd((bonds[i].addrType &
+                                         MASK_ADDRTYPE_ID),
+                                         bonds[i].addr, IRK, NULL);
+
+      // If not explicitly Network Privacy Mode, set to Device Privacy Mode
+      if(!(bonds[i].stateFlags & GAP_BONDED_STATE_RPA_ONLY))
       {
-        // Make sure read NV IRK is valid
-        if(MAP_osal_isbufset(IRK, 0xFF, KEYLEN) == FALSE)
-        {
-          // If IRK is all Zeros than this is Identity address don't
-          // add it to the Resolving List
-          if( MAP_osal_isbufset(IRK, 0x00, KEYLEN) == FALSE )
-          {
-            // Resolving list does not use ID addr types so must mask away bit
-            // prior to adding device to list
-            HCI_LE_AddDeviceToResolvingListCmd((bonds[i].addrType &
-                                               MASK_ADDRTYPE_ID),
-                                               bonds[i].addr, IRK, NULL);
-
-            // If not explicitly Network Privacy Mode, set to Device Privacy Mode
-            if(!(bonds[i].stateFlags & GAP_BONDED_STATE_RPA_ONLY))
-            {
-              MAP_HCI_LE_SetPrivacyModeCmd((bonds[i].addrType &
-                                            MASK_ADDRTYPE_ID),
-                                            bonds[i].addr,
-                                            GAP_PRIVACY_MODE_DEVICE);
-            }
-          }
-        }
+        MAP_HCI_LE_SetPrivacyModeCmd((bonds[i].addrType &
+                                      MASK_ADDRTYPE_ID),
+                                      bonds[i].addr,
+                                      GAP_PRIVACY_MODE_DEVICE);
       }
     }
   }
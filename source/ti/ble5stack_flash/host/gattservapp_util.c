@@ -82,14 +82,74 @@
  * MACROS
  */
 
+// Attribute index slot for a given attribute value pointer
+#define GATT_ATTR_INDEX_SLOT( pValue )  ( ( ( (uint32)(uintptr_t)(pValue) *      \
+                                              0x9E3779B1UL ) >> 16 ) &            \
+                                          ( GATT_ATTR_INDEX_SIZE - 1 ) )
+
+// CCC index slot for a given CCC table and connection handle
+#define GATT_CCC_INDEX_SLOT( pTbl, connHandle )                                 \
+                                ( ( ( ( (uint32)(uintptr_t)(pTbl) ^              \
+                                        ( (uint32)(connHandle) << 20 ) ) *       \
+                                      0x9E3779B1UL ) >> 16 ) &                   \
+                                  ( GATT_CCC_INDEX_SIZE - 1 ) )
+
 /*********************************************************************
  * CONSTANTS
  */
 
+// Number of attribute records the attribute index holds (power of 2, 0 to
+// disable). Records that don't fit are found by scanning their table.
+#ifndef GATT_ATTR_INDEX_SIZE
+  #define GATT_ATTR_INDEX_SIZE          64
+#endif
+
+// Number of client entries the CCC index holds (power of 2, 0 to disable)
+#ifndef GATT_CCC_INDEX_SIZE
+  #define GATT_CCC_INDEX_SIZE           32
+#endif
+
+// Number of registered services tracked to drop their index entries
+#ifndef GATT_INDEX_MAX_SERVICES
+  #define GATT_INDEX_MAX_SERVICES       8
+#endif
+
+// Registered services are tracked if either index is enabled
+#define GATT_SERVICE_INDEX  ( ( GATT_ATTR_INDEX_SIZE > 0 ) || ( GATT_CCC_INDEX_SIZE > 0 ) )
+
 /*********************************************************************
  * TYPEDEFS
  */
 
+#if ( GATT_ATTR_INDEX_SIZE > 0 )
+// Attribute index entry, free if pValue is NULL
+typedef struct
+{
+  uint8 *pValue;             // Attribute value pointer, the key
+  gattAttribute_t *pAttr;    // First record of its table with that value
+} gattAttrIndexItem_t;
+#endif
+
+#if GATT_SERVICE_INDEX
+// Registered service whose records are in the indexes
+typedef struct
+{
+  gattAttribute_t *pAttrs;   // Attribute table of the service
+  uint16 numAttrs;           // Number of attributes in the table
+  uint16 handle;             // Handle of the service
+} gattIndexService_t;
+#endif
+
+#if ( GATT_CCC_INDEX_SIZE > 0 )
+// CCC index entry, free if pTbl is NULL
+typedef struct
+{
+  gattCharCfg_t *pTbl;       // CCC table, the key with connHandle
+  uint16 connHandle;         // Connection handle of the client
+  uint8 idx;                 // Entry of the client within the table
+} gattCccIndexItem_t;
+#endif
+
 /*********************************************************************
  * GLOBAL VARIABLES
  */
@@ -106,6 +166,27 @@
  * LOCAL VARIABLES
  */
 
+#if GATT_SERVICE_INDEX
+// Registered services in the indexes
+static gattIndexService_t gattIndexServices[GATT_INDEX_MAX_SERVICES];
+static uint8 gattIndexNumServices = 0;
+#endif
+
+#if ( GATT_ATTR_INDEX_SIZE > 0 )
+// Value pointer to attribute record index of the registered services,
+// open addressed with linear probing. One entry is always left free.
+static gattAttrIndexItem_t gattAttrIndex[GATT_ATTR_INDEX_SIZE];
+static uint16 gattAttrIndexCount = 0;
+#endif
+
+#if ( GATT_CCC_INDEX_SIZE > 0 )
+// Table and connection handle to CCC entry index, open addressed with
+// linear probing. One entry is always left free. Entries are validated
+// against the table on every hit, since the stack may also change it.
+static gattCccIndexItem_t gattCccIndex[GATT_CCC_INDEX_SIZE];
+static uint16 gattCccIndexCount = 0;
+#endif
+
 /*********************************************************************
  * LOCAL FUNCTIONS
  */
@@ -115,6 +196,18 @@ static gattCharCfg_t *gattServApp_FindCharCfgItem( uint16 connHandle,
 static bStatus_t gattServApp_SendNotiInd( uint16 connHandle, uint8 cccValue,
                                           uint8 authenticated, gattAttribute_t *pAttr,
                                           uint8 taskId, pfnGATTReadAttrCB_t pfnReadAttrCB );
+#if ( GATT_ATTR_INDEX_SIZE > 0 )
+static uint16 gattServApp_FindAttrIndex( uint8 *pValue );
+static void gattServApp_AddAttrIndex( gattAttribute_t *pAttr );
+static void gattServApp_DelAttrIndex( uint16 slot );
+#endif
+#if ( GATT_CCC_INDEX_SIZE > 0 )
+static uint16 gattServApp_FindCccIndex( uint16 connHandle, gattCharCfg_t *charCfgTbl );
+static void gattServApp_AddCccIndex( uint16 connHandle, gattCharCfg_t *charCfgTbl,
+                                     uint8 idx );
+static void gattServApp_DelCccIndex( uint16 slot );
+static void gattServApp_DropCccIndex( gattCharCfg_t *charCfgTbl );
+#endif
 
 /*********************************************************************
  * API FUNCTIONS
@@ -146,6 +239,10 @@ void GATTServApp_InitCharCfg( uint16 connHandle, gattCharCfg_t *charCfgTbl )
       charCfgTbl[i].connHandle = LINKDB_CONNHANDLE_INVALID;
       charCfgTbl[i].value = GATT_CFG_NO_OPERATION;
     }
+
+#if ( GATT_CCC_INDEX_SIZE > 0 )
+    gattServApp_DropCccIndex( charCfgTbl );
+#endif
   }
   else
   {
@@ -154,6 +251,10 @@ void GATTServApp_InitCharCfg( uint16 connHandle, gattCharCfg_t *charCfgTbl )
     {
       pItem->connHandle = LINKDB_CONNHANDLE_INVALID;
       pItem->value = GATT_CFG_NO_OPERATION;
+
+#if ( GATT_CCC_INDEX_SIZE > 0 )
+      gattServApp_DelCccIndex( gattServApp_FindCccIndex( connHandle, charCfgTbl ) );
+#endif
     }
   }
 }
@@ -179,6 +280,7 @@ bStatus_t GATTServApp_ProcessCharCfg( gattCharCfg_t *charCfgTbl, uint8 *pValue,
                                       pfnGATTReadAttrCB_t pfnReadAttrCB )
 {
   uint8 i;
+  gattAttribute_t *pAttr;
   bStatus_t status = SUCCESS;
 
   // Verify input parameters
@@ -188,6 +290,13 @@ bStatus_t GATTServApp_ProcessCharCfg( gattCharCfg_t *charCfgTbl, uint8 *pValue,
     return ( INVALIDPARAMETER );
   }
 
+  // Find the characteristic value attribute
+  pAttr = GATTServApp_FindAttr( attrTbl, numAttrs, pValue );
+  if ( pAttr == NULL )
+  {
+    return ( status );
+  }
+
   for ( i = 0; i < linkDBNumConns; i++ )
   {
     gattCharCfg_t *pItem = &(charCfgTbl[i]);
@@ -195,23 +304,16 @@ bStatus_t GATTServApp_ProcessCharCfg( gattCharCfg_t *charCfgTbl, uint8 *pValue,
     if ( ( pItem->connHandle != LINKDB_CONNHANDLE_INVALID ) &&
          ( pItem->value != GATT_CFG_NO_OPERATION ) )
     {
-      gattAttribute_t *pAttr;
-
-      // Find the characteristic value attribute
-      pAttr = GATTServApp_FindAttr( attrTbl, numAttrs, pValue );
-      if ( pAttr != NULL )
+      if ( pItem->value & GATT_CLIENT_CFG_NOTIFY )
       {
-        if ( pItem->value & GATT_CLIENT_CFG_NOTIFY )
-        {
-           status |= gattServApp_SendNotiInd( pItem->connHandle, GATT_CLIENT_CFG_NOTIFY,
-                                              authenticated, pAttr, taskId, pfnReadAttrCB );
-        }
+         status |= gattServApp_SendNotiInd( pItem->connHandle, GATT_CLIENT_CFG_NOTIFY,
+                                            authenticated, pAttr, taskId, pfnReadAttrCB );
+      }
 
-        if ( pItem->value & GATT_CLIENT_CFG_INDICATE )
-        {
-           status |= gattServApp_SendNotiInd( pItem->connHandle, GATT_CLIENT_CFG_INDICATE,
-                                              authenticated, pAttr, taskId, pfnReadAttrCB );
-        }
+      if ( pItem->value & GATT_CLIENT_CFG_INDICATE )
+      {
+         status |= gattServApp_SendNotiInd( pItem->connHandle, GATT_CLIENT_CFG_INDICATE,
+                                            authenticated, pAttr, taskId, pfnReadAttrCB );
       }
     }
   } // for
@@ -229,12 +331,28 @@ bStatus_t GATTServApp_ProcessCharCfg( gattCharCfg_t *charCfgTbl, uint8 *pValue,
  * @param       numAttrs - number of attributes in attribute table
  * @param       pValue - pointer to attribute value
  *
+ *              Note: The records of registered services are found through
+ *                    the attribute index. Other tables, and records the
+ *                    index had no room for, are scanned.
+ *
  * @return      Pointer to attribute record. NULL, if not found.
  */
 gattAttribute_t *GATTServApp_FindAttr( gattAttribute_t *pAttrTbl,
                                        uint16 numAttrs, uint8 *pValue )
 {
   uint16  i;
+#if ( GATT_ATTR_INDEX_SIZE > 0 )
+  i = gattServApp_FindAttrIndex( pValue );
+
+  // The indexed record is the first with this value in its own table
+  if ( ( i < GATT_ATTR_INDEX_SIZE ) &&
+       ( gattAttrIndex[i].pAttr >= pAttrTbl ) &&
+       ( gattAttrIndex[i].pAttr < &(pAttrTbl[numAttrs]) ) )
+  {
+    return ( gattAttrIndex[i].pAttr );
+  }
+#endif
+
   for ( i = 0; i < numAttrs; i++ )
   {
     if ( pAttrTbl[i].pValue == pValue )
@@ -247,6 +365,103 @@ gattAttribute_t *GATTServApp_FindAttr( gattAttribute_t *pAttrTbl,
   return ( (gattAttribute_t *)NULL );
 }
 
+/*********************************************************************
+ * @fn          GATTServApp_IndexService
+ *
+ * @brief       Add the records of a registered service to the attribute
+ *              index, once the stack has assigned their handles.
+ *
+ * @param       pAttrs - array of attribute records of the service
+ * @param       numAttrs - number of attributes in array
+ *
+ * @return      none
+ */
+void GATTServApp_IndexService( gattAttribute_t *pAttrs, uint16 numAttrs )
+{
+#if GATT_SERVICE_INDEX
+  gattIndexService_t *pService;
+#if ( GATT_ATTR_INDEX_SIZE > 0 )
+  uint16 i;
+#endif
+
+  // Services that can't be tracked are left out, their tables are scanned
+  if ( ( pAttrs == NULL ) || ( numAttrs == 0 ) ||
+       ( gattIndexNumServices == GATT_INDEX_MAX_SERVICES ) )
+  {
+    return;
+  }
+
+  pService = &(gattIndexServices[gattIndexNumServices++]);
+  pService->pAttrs = pAttrs;
+  pService->numAttrs = numAttrs;
+  pService->handle = pAttrs[0].handle;
+
+#if ( GATT_ATTR_INDEX_SIZE > 0 )
+  for ( i = 0; i < numAttrs; i++ )
+  {
+    gattServApp_AddAttrIndex( &(pAttrs[i]) );
+  }
+#endif
+#endif // GATT_SERVICE_INDEX
+}
+
+/*********************************************************************
+ * @fn          GATTServApp_UnindexService
+ *
+ * @brief       Remove the records and the CCC entries of a deregistered
+ *              service from the indexes, before its table is freed.
+ *
+ * @param       handle - handle of the service
+ *
+ * @return      none
+ */
+void GATTServApp_UnindexService( uint16 handle )
+{
+#if GATT_SERVICE_INDEX
+  gattAttribute_t *pAttrs;
+  uint16 i;
+  uint8 s;
+
+  for ( s = 0; s < gattIndexNumServices; s++ )
+  {
+    if ( gattIndexServices[s].handle == handle )
+    {
+      break;
+    }
+  }
+
+  if ( s == gattIndexNumServices )
+  {
+    return;
+  }
+
+  pAttrs = gattIndexServices[s].pAttrs;
+  for ( i = 0; i < gattIndexServices[s].numAttrs; i++ )
+  {
+#if ( GATT_ATTR_INDEX_SIZE > 0 )
+    uint16 slot = gattServApp_FindAttrIndex( pAttrs[i].pValue );
+
+    if ( ( slot < GATT_ATTR_INDEX_SIZE ) &&
+         ( gattAttrIndex[slot].pAttr == &(pAttrs[i]) ) )
+    {
+      gattServApp_DelAttrIndex( slot );
+    }
+#endif
+
+#if ( GATT_CCC_INDEX_SIZE > 0 )
+    if ( ( pAttrs[i].type.len == ATT_BT_UUID_SIZE ) &&
+         ( BUILD_UINT16( pAttrs[i].type.uuid[0], pAttrs[i].type.uuid[1] ) ==
+           GATT_CLIENT_CHAR_CFG_UUID ) )
+    {
+      gattServApp_DropCccIndex( GATT_CCC_TBL( pAttrs[i].pValue ) );
+    }
+#endif
+  }
+
+  gattIndexServices[s] = gattIndexServices[--gattIndexNumServices];
+#endif // GATT_SERVICE_INDEX
+}
+
 /*********************************************************************
  * @fn      GATTServApp_ProcessCCCWriteReq
  *
@@ -366,6 +581,10 @@ uint8 GATTServApp_WriteCharCfg( uint16 connHandle, gattCharCfg_t *charCfgTbl,
     }
 
     pItem->connHandle = connHandle;
+
+#if ( GATT_CCC_INDEX_SIZE > 0 )
+    gattServApp_AddCccIndex( connHandle, charCfgTbl, (uint8)( pItem - charCfgTbl ) );
+#endif
   }
 
   // Write the new value for this client
@@ -381,6 +600,9 @@ uint8 GATTServApp_WriteCharCfg( uint16 connHandle, gattCharCfg_t *charCfgTbl,
  *          Uses the connection handle to search the characteristic
  *          configuration table of a client.
  *
+ *          Clients are looked up in the CCC index first. The table is
+ *          scanned on a miss, and the index is updated from the result.
+ *
  * @param   connHandle - connection handle (0xFFFF for empty entry)
  * @param   charCfgTbl - characteristic configuration table.
  *
@@ -390,16 +612,44 @@ static gattCharCfg_t *gattServApp_FindCharCfgItem( uint16 connHandle,
                                                    gattCharCfg_t *charCfgTbl )
 {
   uint8 i;
+#if ( GATT_CCC_INDEX_SIZE > 0 )
+  uint16 slot = GATT_CCC_INDEX_SIZE;
+
+  if ( connHandle != LINKDB_CONNHANDLE_INVALID )
+  {
+    slot = gattServApp_FindCccIndex( connHandle, charCfgTbl );
+    if ( slot < GATT_CCC_INDEX_SIZE )
+    {
+      i = gattCccIndex[slot].idx;
+      if ( ( i < linkDBNumConns ) && ( charCfgTbl[i].connHandle == connHandle ) )
+      {
+        return ( &(charCfgTbl[i]) );
+      }
+    }
+  }
+#endif
 
   for ( i = 0; i < linkDBNumConns; i++ )
   {
     if ( charCfgTbl[i].connHandle == connHandle )
     {
+#if ( GATT_CCC_INDEX_SIZE > 0 )
+      if ( connHandle != LINKDB_CONNHANDLE_INVALID )
+      {
+        gattServApp_AddCccIndex( connHandle, charCfgTbl, i );
+      }
+#endif
+
       // Entry found
       return ( &(charCfgTbl[i]) );
     }
   }
 
+#if ( GATT_CCC_INDEX_SIZE > 0 )
+  // The stack removed the client
+  gattServApp_DelCccIndex( slot );
+#endif
+
   return ( (gattCharCfg_t *)NULL );
 }
 
@@ -462,6 +712,256 @@ static bStatus_t gattServApp_SendNotiInd( uint16 connHandle, uint8 cccValue,
   return ( status );
 }
 
+#if ( GATT_ATTR_INDEX_SIZE > 0 )
+/*********************************************************************
+ * @fn      gattServApp_FindAttrIndex
+ *
+ * @brief   Find the attribute index entry of a value pointer.
+ *
+ * @param   pValue - pointer to attribute value
+ *
+ * @return  Slot of the entry. GATT_ATTR_INDEX_SIZE, if not found.
+ */
+static uint16 gattServApp_FindAttrIndex( uint8 *pValue )
+{
+  uint16 slot = GATT_ATTR_INDEX_SLOT( pValue );
+
+  if ( pValue != NULL )
+  {
+    // A free entry always ends the probe sequence
+    while ( gattAttrIndex[slot].pValue != NULL )
+    {
+      if ( gattAttrIndex[slot].pValue == pValue )
+      {
+        return ( slot );
+      }
+
+      slot = ( slot + 1 ) & ( GATT_ATTR_INDEX_SIZE - 1 );
+    }
+  }
+
+  return ( GATT_ATTR_INDEX_SIZE );
+}
+
+/*********************************************************************
+ * @fn      gattServApp_AddAttrIndex
+ *
+ * @brief   Add an attribute record to the attribute index, unless a
+ *          record with the same value is already there. It is then
+ *          an earlier one of the same table, or the record of another
+ *          table, which lookups in this table don't take.
+ *
+ * @param   pAttr - pointer to attribute record
+ *
+ * @return  none
+ */
+static void gattServApp_AddAttrIndex( gattAttribute_t *pAttr )
+{
+  uint16 slot = GATT_ATTR_INDEX_SLOT( pAttr->pValue );
+
+  if ( ( pAttr->pValue == NULL ) ||
+       ( gattAttrIndexCount == ( GATT_ATTR_INDEX_SIZE - 1 ) ) )
+  {
+    return;
+  }
+
+  while ( gattAttrIndex[slot].pValue != NULL )
+  {
+    if ( gattAttrIndex[slot].pValue == pAttr->pValue )
+    {
+      return;
+    }
+
+    slot = ( slot + 1 ) & ( GATT_ATTR_INDEX_SIZE - 1 );
+  }
+
+  gattAttrIndex[slot].pValue = pAttr->pValue;
+  gattAttrIndex[slot].pAttr = pAttr;
+  gattAttrIndexCount++;
+}
+
+/*********************************************************************
+ * @fn      gattServApp_DelAttrIndex
+ *
+ * @brief   Remove an entry from the attribute index. The entries after
+ *          it in the probe sequence are moved back so that lookups
+ *          still reach them.
+ *
+ * @param   slot - slot of the entry (GATT_ATTR_INDEX_SIZE for none)
+ *
+ * @return  none
+ */
+static void gattServApp_DelAttrIndex( uint16 slot )
+{
+  uint16 next = slot;
+  uint16 home;
+
+  if ( slot >= GATT_ATTR_INDEX_SIZE )
+  {
+    return;
+  }
+
+  for ( ;; )
+  {
+    next = ( next + 1 ) & ( GATT_ATTR_INDEX_SIZE - 1 );
+    if ( gattAttrIndex[next].pValue == NULL )
+    {
+      break;
+    }
+
+    // Move the entry unless its home slot lies between slot and next
+    home = GATT_ATTR_INDEX_SLOT( gattAttrIndex[next].pValue );
+    if ( ( ( next - home ) & ( GATT_ATTR_INDEX_SIZE - 1 ) ) >=
+         ( ( next - slot ) & ( GATT_ATTR_INDEX_SIZE - 1 ) ) )
+    {
+      gattAttrIndex[slot] = gattAttrIndex[next];
+      slot = next;
+    }
+  }
+
+  gattAttrIndex[slot].pValue = NULL;
+  gattAttrIndexCount--;
+}
+#endif // GATT_ATTR_INDEX_SIZE
+
+#if ( GATT_CCC_INDEX_SIZE > 0 )
+/*********************************************************************
+ * @fn      gattServApp_FindCccIndex
+ *
+ * @brief   Find the CCC index entry of a client.
+ *
+ * @param   connHandle - connection handle.
+ * @param   charCfgTbl - characteristic configuration table.
+ *
+ * @return  Slot of the entry. GATT_CCC_INDEX_SIZE, if not found.
+ */
+static uint16 gattServApp_FindCccIndex( uint16 connHandle, gattCharCfg_t *charCfgTbl )
+{
+  uint16 slot = GATT_CCC_INDEX_SLOT( charCfgTbl, connHandle );
+
+  // A free entry always ends the probe sequence
+  while ( gattCccIndex[slot].pTbl != NULL )
+  {
+    if ( ( gattCccIndex[slot].pTbl == charCfgTbl ) &&
+         ( gattCccIndex[slot].connHandle == connHandle ) )
+    {
+      return ( slot );
+    }
+
+    slot = ( slot + 1 ) & ( GATT_CCC_INDEX_SIZE - 1 );
+  }
+
+  return ( GATT_CCC_INDEX_SIZE );
+}
+
+/*********************************************************************
+ * @fn      gattServApp_AddCccIndex
+ *
+ * @brief   Add or update the CCC index entry of a client.
+ *
+ * @param   connHandle - connection handle.
+ * @param   charCfgTbl - characteristic configuration table.
+ * @param   idx - entry of the client within the table.
+ *
+ * @return  none
+ */
+static void gattServApp_AddCccIndex( uint16 connHandle, gattCharCfg_t *charCfgTbl,
+                                     uint8 idx )
+{
+  uint16 slot = GATT_CCC_INDEX_SLOT( charCfgTbl, connHandle );
+
+  while ( gattCccIndex[slot].pTbl != NULL )
+  {
+    if ( ( gattCccIndex[slot].pTbl == charCfgTbl ) &&
+         ( gattCccIndex[slot].connHandle == connHandle ) )
+    {
+      gattCccIndex[slot].idx = idx;
+      return;
+    }
+
+    slot = ( slot + 1 ) & ( GATT_CCC_INDEX_SIZE - 1 );
+  }
+
+  if ( gattCccIndexCount < ( GATT_CCC_INDEX_SIZE - 1 ) )
+  {
+    gattCccIndex[slot].pTbl = charCfgTbl;
+    gattCccIndex[slot].connHandle = connHandle;
+    gattCccIndex[slot].idx = idx;
+    gattCccIndexCount++;
+  }
+}
+
+/*********************************************************************
+ * @fn      gattServApp_DelCccIndex
+ *
+ * @brief   Remove an entry from the CCC index. The entries after it in
+ *          the probe sequence are moved back so that lookups still
+ *          reach them.
+ *
+ * @param   slot - slot of the entry (GATT_CCC_INDEX_SIZE for none)
+ *
+ * @return  none
+ */
+static void gattServApp_DelCccIndex( uint16 slot )
+{
+  uint16 next = slot;
+  uint16 home;
+
+  if ( slot >= GATT_CCC_INDEX_SIZE )
+  {
+    return;
+  }
+
+  for ( ;; )
+  {
+    next = ( next + 1 ) & ( GATT_CCC_INDEX_SIZE - 1 );
+    if ( gattCccIndex[next].pTbl == NULL )
+    {
+      break;
+    }
+
+    // Move the entry unless its home slot lies between slot and next
+    home = GATT_CCC_INDEX_SLOT( gattCccIndex[next].pTbl, gattCccIndex[next].connHandle );
+    if ( ( ( next - home ) & ( GATT_CCC_INDEX_SIZE - 1 ) ) >=
+         ( ( next - slot ) & ( GATT_CCC_INDEX_SIZE - 1 ) ) )
+    {
+      gattCccIndex[slot] = gattCccIndex[next];
+      slot = next;
+    }
+  }
+
+  gattCccIndex[slot].pTbl = NULL;
+  gattCccIndexCount--;
+}
+
+/*********************************************************************
+ * @fn      gattServApp_DropCccIndex
+ *
+ * @brief   Remove the CCC index entries of all the clients of a table.
+ *
+ * @param   charCfgTbl - characteristic configuration table.
+ *
+ * @return  none
+ */
+static void gattServApp_DropCccIndex( gattCharCfg_t *charCfgTbl )
+{
+  uint16 slot = 0;
+
+  while ( ( slot < GATT_CCC_INDEX_SIZE ) && ( gattCccIndexCount > 0 ) )
+  {
+    // Entries moved back into slot are checked again
+    if ( gattCccIndex[slot].pTbl == charCfgTbl )
+    {
+      gattServApp_DelCccIndex( slot );
+    }
+    else
+    {
+      slot++;
+    }
+  }
+}
+#endif // GATT_CCC_INDEX_SIZE
+
 #endif // ( CENTRAL_CFG | PERIPHERAL_CFG )
 
 /****************************************************************************
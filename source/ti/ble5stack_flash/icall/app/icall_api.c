@@ -839,6 +839,8 @@ bStatus_t GATTServApp_RegisterService(gattAttribute_t *pAttrs,
                                       uint16 numAttrs, uint8 encKeySize,
                                       const gattServiceCBs_t *pServiceCBs)
 {
+  bStatus_t status;
+
   // Allocate message buffer space
   ICall_GSA_RegService *msg =
     (ICall_GSA_RegService *)ICall_allocMsg(sizeof(ICall_GSA_RegService));
@@ -855,7 +857,17 @@ bStatus_t GATTServApp_RegisterService(gattAttribute_t *pAttrs,
     msg->pServiceCBs = pServiceCBs;
 
     // Send the message
-    return sendWaitMatchCS(ICall_getEntityId(), msg, matchGSARegisterServiceCS);
+    status = sendWaitMatchCS(ICall_getEntityId(), msg, matchGSARegisterServiceCS);
+
+#if defined(HOST_CONFIG) && (HOST_CONFIG & (CENTRAL_CFG | PERIPHERAL_CFG))
+    // The stack has assigned the handles, index the records
+    if (status == SUCCESS)
+    {
+      GATTServApp_IndexService(pAttrs, numAttrs);
+    }
+#endif
+
+    return status;
   }
 
   return MSG_BUFFER_NOT_AVAIL;
@@ -869,6 +881,8 @@ bStatus_t GATTServApp_RegisterService(gattAttribute_t *pAttrs,
  */
 bStatus_t GATTServApp_DeregisterService(uint16 handle, gattAttribute_t **p2pAttrs)
 {
+  bStatus_t status;
+
   // Allocate message buffer space
   ICall_GSA_DeregService *msg =
     (ICall_GSA_DeregService *)ICall_allocMsg(sizeof(ICall_GSA_DeregService));
@@ -883,7 +897,17 @@ bStatus_t GATTServApp_DeregisterService(uint16 handle, gattAttribute_t **p2pAttr
     msg->p2pAttrs = p2pAttrs;
 
     // Send the message
-    return sendWaitMatchCS(ICall_getEntityId(), msg, matchGSADeregisterServiceCS);
+    status = sendWaitMatchCS(ICall_getEntityId(), msg, matchGSADeregisterServiceCS);
+
+#if defined(HOST_CONFIG) && (HOST_CONFIG & (CENTRAL_CFG | PERIPHERAL_CFG))
+    // Drop the index entries before the caller frees the attribute list
+    if (status == SUCCESS)
+    {
+      GATTServApp_UnindexService(handle);
+    }
+#endif
+
+    return status;
   }
 
   return MSG_BUFFER_NOT_AVAIL;
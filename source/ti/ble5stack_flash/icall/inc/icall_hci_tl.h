@@ -78,6 +78,9 @@ extern "C"
 #define HCI_STATUS_ERROR_INVALID_PACKET_TYPE      (-3)
 #define HCI_STATUS_ERROR_INVALID_PACKET_BUFFER    (-4)
 
+// Batched advertising reports (HOST_TL_ADV_RPT_BATCH)
+#define HCI_EXT_GAP_ADV_RPT_BATCH_EVENT        0x0627
+
 #ifdef BLE3_CMD
 // Advertising event types
 #define GAP_ADTYPE_ADV_IND                0x00  //!< Connectable undirected advertisement
@@ -245,6 +248,32 @@ extern void HCI_TL_SendToStack(uint8_t *pHciMsg);
  */
 extern uint8_t HCI_TL_processStructuredEvent(ICall_Hdr *pEvt);
 
+#if defined(HOST_TL_ADV_RPT_BATCH) && !defined(BLE3_CMD)
+/*********************************************************************
+ * @fn      HCI_TL_setAdvReportBatch
+ *
+ * @brief   Configure batching of GAP advertising reports. When enabled,
+ *          reports are packed into a single HCI_EXT_GAP_ADV_RPT_BATCH_EVENT
+ *          which is sent when it is full, when flushMs elapsed since the
+ *          first report was queued, or when any other scanner event is
+ *          received. Any pending batch is flushed before the new
+ *          configuration takes effect.
+ *          Must be called from the task that runs the HCI TL.
+ *
+ * @param   enable    - TRUE to batch reports, FALSE to send one event per
+ *                      report.
+ *          flushMs   - maximum time a report stays queued, 0 to flush only
+ *                      on size or scanner events.
+ *          rssiDelta - minimum RSSI change (dB) for a report carrying the
+ *                      same data from the same advertiser to be forwarded
+ *                      again, 0 to forward every report.
+ *
+ * @return  none.
+ */
+extern void HCI_TL_setAdvReportBatch(uint8_t enable, uint16_t flushMs,
+                                     uint8_t rssiDelta);
+#endif // HOST_TL_ADV_RPT_BATCH && !BLE3_CMD
+
 #ifdef BLE3_CMD
 status_t BLE3ToAgama_setParam( uint16_t id, uint16_t value );
 uint16_t getBLE3ToAgamaEventProp( uint8_t eventType);
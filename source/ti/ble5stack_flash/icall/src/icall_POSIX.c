@@ -52,6 +52,7 @@
 
 #ifdef FREERTOS
 #include <FreeRTOS.h>
+#include <task.h>
 
 #else // Zephyr
 #include <zephyr/kernel.h>
@@ -108,6 +109,19 @@
 #define ICALL_MAX_NUM_TASKS        2
 #endif
 
+#if defined(FREERTOS) && (configUSE_TRACE_FACILITY == 1) && \
+    !defined(ICALL_NO_TASK_NUMBER_CACHE)
+/**
+ * @internal
+ * Cache the index of each task entry in the FreeRTOS task number so that the
+ * receive path finds the calling task's entry without scanning
+ * @ref ICall_tasks. The thread local storage pointers and the application
+ * task tag are already owned by the POSIX layer.
+ * Define ICALL_NO_TASK_NUMBER_CACHE if a trace tool owns the task number.
+ */
+#define ICALL_TASK_NUMBER_CACHE
+#endif
+
 /**
  * @internal
  * Service class value used to indicate an invalid (unused) entry
@@ -450,6 +464,27 @@ static ICall_TaskEntry *ICall_searchTask(TaskP_Handle taskhandle)
   return NULL;
 }
 
+/**
+ * @internal Returns the task entry of the calling task.
+ * @return Pointer to task entry when found, or NULL.
+ */
+static ICall_TaskEntry *ICall_currentTask(void)
+{
+#ifdef ICALL_TASK_NUMBER_CACHE
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  UBaseType_t number = uxTaskGetTaskNumber(self);
+
+  /* The entry is validated since entries are never moved, but a task number
+   * set by someone else must not be trusted. */
+  if ((number != 0) && (number <= ICALL_MAX_NUM_TASKS) &&
+      (ICall_tasks[number - 1].task == (TaskP_Handle) self))
+  {
+    return &ICall_tasks[number - 1];
+  }
+#endif /* ICALL_TASK_NUMBER_CACHE */
+  return ICall_searchTask(ICall_taskSelf());
+}
+
 /**
  * @internal Searches for a task entry within @ref ICall_tasks or
  *           build an entry if the entry table is empty.
@@ -478,11 +513,17 @@ static ICall_TaskEntry *ICall_newTask(TaskP_Handle taskhandle)
         /* abort */
         ICALL_HOOK_ABORT_FUNC();
       }
+#ifdef ICALL_TASK_NUMBER_CACHE
+      vTaskSetTaskNumber((TaskHandle_t) taskhandle, (UBaseType_t) (i + 1));
+#endif /* ICALL_TASK_NUMBER_CACHE */
       ICall_leaveCSImpl(key);
       return taskentry;
     }
     if (taskhandle == ICall_tasks[i].task)
     {
+#ifdef ICALL_TASK_NUMBER_CACHE
+      vTaskSetTaskNumber((TaskHandle_t) taskhandle, (UBaseType_t) (i + 1));
+#endif /* ICALL_TASK_NUMBER_CACHE */
       ICall_leaveCSImpl(key);
       return &ICall_tasks[i];
     }
@@ -1200,8 +1241,7 @@ ICall_fetchServiceMsg(ICall_ServiceEnum *src,
  */
 ICall_Errno ICall_wait(uint_fast32_t milliseconds)
 {
-    TaskP_Handle taskhandle = ICall_taskSelf();
-    ICall_TaskEntry *taskentry = ICall_searchTask(taskhandle);
+    ICall_TaskEntry *taskentry = ICall_currentTask();
     uint32_t timeout;
 
     uint32_t retVal = 0;
@@ -1584,8 +1624,7 @@ ICall_Errno ICall_fetchMsg(ICall_EntityID *src,
                                          void **msg)
 {
   void *msgTemp;
-  TaskP_Handle taskhandle = ICall_taskSelf();
-  ICall_TaskEntry *taskentry = ICall_searchTask(taskhandle);
+  ICall_TaskEntry *taskentry = ICall_currentTask();
   ICall_MsgHdr *hdr;
 
   if (!taskentry)
@@ -1616,8 +1655,7 @@ ICall_Errno ICall_fetchMsg(ICall_EntityID *src,
  */
 uint8 ICall_IsQueueEmpty()
 {
-  TaskP_Handle taskhandle = ICall_taskSelf();
-  ICall_TaskEntry *taskentry = ICall_searchTask(taskhandle);
+  ICall_TaskEntry *taskentry = ICall_currentTask();
   if(taskentry->queue == NULL)
       return true;
   else
@@ -2320,8 +2358,7 @@ ICall_waitMatch(uint_least32_t milliseconds,
                 ICall_EntityID *dest,
                 void **msg)
 {
-  TaskP_Handle taskhandle = ICall_taskSelf();
-  ICall_TaskEntry *taskentry = ICall_searchTask(taskhandle);
+  ICall_TaskEntry *taskentry = ICall_currentTask();
   ICall_MsgQueue prependQueue = NULL;
 #ifndef ICALL_EVENTS
   uint_fast16_t consumedCount = 0;
@@ -505,6 +505,31 @@ bStatus_t GATTServApp_DeregisterService( uint16 handle, gattAttribute_t **p2pAtt
  */
 extern gattAttribute_t *GATTServApp_FindAttr( gattAttribute_t *pAttrTbl,
                                               uint16 numAttrs, uint8 *pValue );
+
+/**
+ * @brief   Add the records of a registered service to the attribute index
+ *          of @ref GATTServApp_FindAttr.
+ *
+ * @note
+ * Called by @ref GATTServApp_RegisterService once the service is registered.
+ *
+ * @param   pAttrs - Array of attribute records of the service
+ * @param   numAttrs - Number of attributes in array
+ */
+extern void GATTServApp_IndexService( gattAttribute_t *pAttrs, uint16 numAttrs );
+
+/**
+ * @brief   Remove the records and the client characteristic configurations
+ *          of a service from the attribute and CCC indexes.
+ *
+ * @note
+ * Called by @ref GATTServApp_DeregisterService once the service is
+ * deregistered, before the caller frees the attribute list.
+ *
+ * @param   handle - handle of the service
+ */
+extern void GATTServApp_UnindexService( uint16 handle );
+
 /**
  * @brief   Add function for the GATT Service.
  *
@@ -0,0 +1,188 @@
+/******************************************************************************
+
+ @file  hci_tl_cmd.h
+
+ @brief This file contains the HCI Transport Layer command table types and
+        the opcode index of the command table.
+
+ Group: WCS, BTS
+ Target Device: cc23xx
+
+ ******************************************************************************
+ 
+ Copyright (c) 2009-2024, Texas Instruments Incorporated
+
+ All rights reserved not granted herein.
+ Limited License.
+
+ Texas Instruments Incorporated grants a world-wide, royalty-free,
+ non-exclusive license under copyrights and patents it now or hereafter
+ owns or controls to make, have made, use, import, offer to sell and sell
+ ("Utilize") this software subject to the terms herein. With respect to the
+ foregoing patent license, such license is granted solely to the extent that
+ any such patent is necessary to Utilize the software alone. The patent
+ license shall not apply to any combinations which include this software,
+ other than combinations with devices manufactured by or for TI ("TI
+ Devices"). No hardware patent is licensed hereunder.
+
+ Redistributions must preserve existing copyright notices and reproduce
+ this license (including the above copyright notice and the disclaimer and
+ (if applicable) source code license limitations below) in the documentation
+ and/or other materials provided with the distribution.
+
+ Redistribution and use in binary form, without modification, are permitted
+ provided that the following conditions are met:
+
+   * No reverse engineering, decompilation, or disassembly of this software
+     is permitted with respect to any software provided in binary form.
+   * Any redistribution and use are licensed by TI for use only with TI Devices.
+   * Nothing shall obligate TI to provide you with source code for the software
+     licensed and provided to you in object code.
+
+ If software source code is provided to you, modification and redistribution
+ of the source code are permitted provided that the following conditions are
+ met:
+
+   * Any redistribution and use of the source code, including any resulting
+     derivative works, are licensed by TI for use only with TI Devices.
+   * Any redistribution and use of any object code compiled from the source
+     code and any resulting derivative works, are licensed by TI for use
+     only with TI Devices.
+
+ Neither the name of Texas Instruments Incorporated nor the names of its
+ suppliers may be used to endorse or promote products derived from this
+ software without specific prior written permission.
+
+ DISCLAIMER.
+
+ THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ 
+ 
+ *****************************************************************************/
+
+#ifndef HCI_TL_CMD_H
+#define HCI_TL_CMD_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include "hci.h"
+
+/*******************************************************************************
+ * MACROS
+ */
+
+// Home slot of an opcode in the command index
+#define HCI_CMD_IDX_HASH( opCode )                                             \
+  ( (uint8)( (uint16)( (opCode) * 40503U ) >> 8 ) & ( HCI_CMD_IDX_SIZE - 1 ) )
+
+/*******************************************************************************
+ * CONSTANTS
+ */
+
+// Size of the command index (power of 2, larger than the command table)
+#define HCI_CMD_IDX_SIZE               256
+
+// Unused command index slot
+#define HCI_CMD_IDX_EMPTY              0xFF
+
+/*******************************************************************************
+ * TYPEDEFS
+ */
+
+typedef hciStatus_t (*hciFunc_t)( uint8 *pBuf );
+
+typedef struct
+{
+  uint16    opCode;
+  hciFunc_t hciFunc;
+} hciCmdFunc_t;
+
+typedef const hciCmdFunc_t cmdPktTable_t;
+
+/*******************************************************************************
+ * FUNCTIONS
+ */
+
+/*******************************************************************************
+ * @fn          hciBuildCmdIdx
+ *
+ * @brief       This routine builds the opcode index of a command table, ended
+ *              by an entry with opcode 0xFFFF or a NULL function. Each opcode
+ *              is placed at its hash slot, or the next free slot after it.
+ *              If the table does not fit, the index is left invalid and
+ *              hciFindCmd falls back to scanning the table.
+ *
+ * input parameters
+ *
+ * @param       pCmdTable - Command table to index.
+ *
+ * output parameters
+ *
+ * @param       None.
+ *
+ * @return      TRUE if the index covers the whole table, else FALSE.
+ */
+extern uint8 hciBuildCmdIdx( cmdPktTable_t *pCmdTable );
+
+/*******************************************************************************
+ * @fn          hciFindCmd
+ *
+ * @brief       This routine finds the entry for an opcode in the command
+ *              table last passed to hciBuildCmdIdx.
+ *
+ * input parameters
+ *
+ * @param       opCode - HCI command opcode.
+ *
+ * output parameters
+ *
+ * @param       None.
+ *
+ * @return      Pointer to the first command table entry for the opcode, or
+ *              NULL if not supported.
+ */
+extern cmdPktTable_t *hciFindCmd( uint16 opCode );
+
+/*******************************************************************************
+ * @fn          hciScanCmd
+ *
+ * @brief       This routine finds the entry for an opcode by scanning a
+ *              command table from the start.
+ *
+ * input parameters
+ *
+ * @param       pCmdTable - Command table to scan.
+ * @param       opCode    - HCI command opcode.
+ *
+ * output parameters
+ *
+ * @param       None.
+ *
+ * @return      Pointer to the first command table entry for the opcode, or
+ *              NULL if not supported.
+ */
+extern cmdPktTable_t *hciScanCmd( cmdPktTable_t *pCmdTable, uint16 opCode );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HCI_TL_CMD_H */
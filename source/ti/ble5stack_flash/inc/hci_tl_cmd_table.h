@@ -0,0 +1,273 @@
+/******************************************************************************
+
+ @file  hci_tl_cmd_table.h
+
+ @brief This file lists the commands of the full HCI Transport Layer command
+        table, as HCI_TL_CMD( opcode, function ) entries. The includer defines
+        HCI_TL_CMD to expand each entry, and the controller configuration
+        selects the entries that are listed.
+
+ Group: WCS, BTS
+ Target Device: cc23xx
+
+ ******************************************************************************
+ 
+ Copyright (c) 2009-2024, Texas Instruments Incorporated
+
+ All rights reserved not granted herein.
+ Limited License.
+
+ Texas Instruments Incorporated grants a world-wide, royalty-free,
+ non-exclusive license under copyrights and patents it now or hereafter
+ owns or controls to make, have made, use, import, offer to sell and sell
+ ("Utilize") this software subject to the terms herein. With respect to the
+ foregoing patent license, such license is granted solely to the extent that
+ any such patent is necessary to Utilize the software alone. The patent
+ license shall not apply to any combinations which include this software,
+ other than combinations with devices manufactured by or for TI ("TI
+ Devices"). No hardware patent is licensed hereunder.
+
+ Redistributions must preserve existing copyright notices and reproduce
+ this license (including the above copyright notice and the disclaimer and
+ (if applicable) source code license limitations below) in the documentation
+ and/or other materials provided with the distribution.
+
+ Redistribution and use in binary form, without modification, are permitted
+ provided that the following conditions are met:
+
+   * No reverse engineering, decompilation, or disassembly of this software
+     is permitted with respect to any software provided in binary form.
+   * Any redistribution and use are licensed by TI for use only with TI Devices.
+   * Nothing shall obligate TI to provide you with source code for the software
+     licensed and provided to you in object code.
+
+ If software source code is provided to you, modification and redistribution
+ of the source code are permitted provided that the following conditions are
+ met:
+
+   * Any redistribution and use of the source code, including any resulting
+     derivative works, are licensed by TI for use only with TI Devices.
+   * Any redistribution and use of any object code compiled from the source
+     code and any resulting derivative works, are licensed by TI for use
+     only with TI Devices.
+
+ Neither the name of Texas Instruments Incorporated nor the names of its
+ suppliers may be used to endorse or promote products derived from this
+ software without specific prior written permission.
+
+ DISCLAIMER.
+
+ THIS SOFTWARE IS PROVIDED BY TI AND TI'S LICENSORS "AS IS" AND ANY EXPRESS
+ OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL TI AND TI'S LICENSORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ 
+ 
+ *****************************************************************************/
+
+// No include guard: the list is expanded once per HCI_TL_CMD definition
+
+  // Linker Control Commands
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
+  HCI_TL_CMD( HCI_DISCONNECT                              , hciDisconnect                          )
+  HCI_TL_CMD( HCI_READ_REMOTE_VERSION_INFO                , hciReadRemoteVersionInfo               )
+#endif // ADV_CONN_CFG | INIT_CFG
+
+  // Controller and Baseband Commands
+  HCI_TL_CMD( HCI_SET_EVENT_MASK                          , hciSetEventMask                        )
+  HCI_TL_CMD( HCI_SET_EVENT_MASK_PAGE_2                   , hciSetEventMaskPage2                   )
+  HCI_TL_CMD( HCI_RESET                                   , hciReset                               )
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
+  HCI_TL_CMD( HCI_READ_TRANSMIT_POWER                     , hciReadTransmitPowerLevel              )
+  HCI_TL_CMD( HCI_SET_CONTROLLER_TO_HOST_FLOW_CONTROL     , hciSetControllerToHostFlowCtrl         )
+  HCI_TL_CMD( HCI_HOST_BUFFER_SIZE                        , hciHostBufferSize                      )
+  HCI_TL_CMD( HCI_HOST_NUM_COMPLETED_PACKETS              , hciHostNumCompletedPkt                 )
+#endif // ADV_CONN_CFG | INIT_CFG
+
+// Informational Parameters
+  HCI_TL_CMD( HCI_READ_LOCAL_VERSION_INFO                 , hciReadLocalVersionInfo                )
+  HCI_TL_CMD( HCI_READ_LOCAL_SUPPORTED_COMMANDS           , hciReadLocalSupportedCommands          )
+  HCI_TL_CMD( HCI_READ_LOCAL_SUPPORTED_FEATURES           , hciReadLocalSupportedFeatures          )
+  HCI_TL_CMD( HCI_READ_BDADDR                             , hciReadBDADDR                          )
+  HCI_TL_CMD( HCI_READ_RSSI                               , hciReadRssi                            )
+
+  // LE Commands
+  HCI_TL_CMD( HCI_LE_SET_EVENT_MASK                       , hciLESetEventMask                      )
+  HCI_TL_CMD( HCI_LE_READ_BUFFER_SIZE                     , hciLEReadBufSize                       )
+  HCI_TL_CMD( HCI_LE_READ_LOCAL_SUPPORTED_FEATURES        , hciLEReadLocalSupportedFeatures        )
+  HCI_TL_CMD( HCI_LE_SET_RANDOM_ADDR                      , hciLESetRandomAddr                     )
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_NCONN_CFG | ADV_CONN_CFG))
+  HCI_TL_CMD( HCI_LE_SET_ADV_PARAM                        , hciLESetAdvParam                       )
+  HCI_TL_CMD( HCI_LE_SET_ADV_DATA                         , hciLESetAdvData                        )
+  HCI_TL_CMD( HCI_LE_SET_SCAN_RSP_DATA                    , hciLESetScanRspData                    )
+  HCI_TL_CMD( HCI_LE_SET_ADV_ENABLE                       , hciLESetAdvEnab                        )
+  HCI_TL_CMD( HCI_LE_READ_ADV_CHANNEL_TX_POWER            , hciLEReadAdvChanTxPower                )
+#endif // ADV_NCONN_CFG | ADV_CONN_CFG
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & SCAN_CFG)
+  HCI_TL_CMD( HCI_LE_SET_SCAN_PARAM                       , hciLESetScanParam                      )
+  HCI_TL_CMD( HCI_LE_SET_SCAN_ENABLE                      , hciLESetScanEnable                     )
+#endif // SCAN_CFG
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & INIT_CFG)
+  HCI_TL_CMD( HCI_LE_CREATE_CONNECTION                    , hciLECreateConn                        )
+  HCI_TL_CMD( HCI_LE_CREATE_CONNECTION_CANCEL             , hciLECreateConnCancel                  )
+#endif // INIT_CFG
+  HCI_TL_CMD( HCI_LE_READ_ACCEPT_LIST_SIZE                , hciLEReadAcceptListSize                )
+  HCI_TL_CMD( HCI_LE_CLEAR_ACCEPT_LIST                    , hciLEClearAcceptList                   )
+  HCI_TL_CMD( HCI_LE_ADD_ACCEPT_LIST                      , hciLEAddAcceptList                     )
+  HCI_TL_CMD( HCI_LE_REMOVE_ACCEPT_LIST                   , hciLERemoveAcceptList                  )
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
+  HCI_TL_CMD( HCI_LE_CONNECTION_UPDATE                    , hciLEConnUpdate                        )
+#endif // ADV_CONN_CFG | INIT_CFG
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & INIT_CFG)
+  HCI_TL_CMD( HCI_LE_SET_HOST_CHANNEL_CLASSIFICATION      , hciLESetHostChanClass                  )
+  HCI_TL_CMD( HCI_LE_READ_CHANNEL_MAP                     , hciLEReadChanMap                       )
+  HCI_TL_CMD( HCI_LE_READ_REMOTE_USED_FEATURES            , hciLEReadRemoteUsedFeatures            )
+#endif // INIT_CFG
+  HCI_TL_CMD( HCI_LE_ENCRYPT                              , hciLEEncrypt                           )
+  HCI_TL_CMD( HCI_LE_RAND                                 , hciLERand                              )
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & INIT_CFG)
+  HCI_TL_CMD( HCI_LE_START_ENCRYPTION                     , hciLEStartEncrypt                      )
+#endif // INIT_CFG
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & ADV_CONN_CFG)
+  HCI_TL_CMD( HCI_LE_LTK_REQ_REPLY                        , hciLELtkReqReply                       )
+  HCI_TL_CMD( HCI_LE_LTK_REQ_NEG_REPLY                    , hciLELtkReqNegReply                    )
+#endif // ADV_CONN_CFG
+  HCI_TL_CMD( HCI_LE_READ_SUPPORTED_STATES                , hciLEReadSupportedStates               )
+  HCI_TL_CMD( HCI_LE_RECEIVER_TEST                        , hciLEReceiverTest                      )
+  HCI_TL_CMD( HCI_LE_TRANSMITTER_TEST                     , hciLETransmitterTest                   )
+  HCI_TL_CMD( HCI_LE_TEST_END                             , hciLETestEnd                           )
+
+// V4.1
+
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
+  HCI_TL_CMD( HCI_READ_AUTH_PAYLOAD_TIMEOUT               , hciReadAuthPayloadTimeout              )
+  HCI_TL_CMD( HCI_WRITE_AUTH_PAYLOAD_TIMEOUT              , hciWriteAuthPayloadTimeout             )
+#endif // (ADV_CONN_CFG | INIT_CFG)
+
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
+  HCI_TL_CMD( HCI_LE_REMOTE_CONN_PARAM_REQ_REPLY          , hciLERemoteConnParamReqReply           )
+  HCI_TL_CMD( HCI_LE_REMOTE_CONN_PARAM_REQ_NEG_REPLY      , hciLERemoteConnParamReqNegReply        )
+#endif // (ADV_CONN_CFG | INIT_CFG)
+
+// V4.2 - Extended Data Length
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
+  HCI_TL_CMD( HCI_LE_SET_DATA_LENGTH                      , hciLESetDataLen                        )
+  HCI_TL_CMD( HCI_LE_READ_SUGGESTED_DEFAULT_DATA_LENGTH   , hciLEReadSuggestedDefaultDataLen       )
+  HCI_TL_CMD( HCI_LE_WRITE_SUGGESTED_DEFAULT_DATA_LENGTH  , hciLEWriteSuggestedDefaultDataLen      )
+  HCI_TL_CMD( HCI_LE_READ_MAX_DATA_LENGTH                 , hciLEReadMaxDataLen                    )
+#endif // (ADV_CONN_CFG | INIT_CFG)
+
+// V4.2 - Secure Connections
+  HCI_TL_CMD( HCI_LE_READ_LOCAL_P256_PUBLIC_KEY           , hciLEReadLocalP256PubicKey             )
+  HCI_TL_CMD( HCI_LE_GENERATE_DHKEY                       , hciLEGenerateDHKey                     )
+
+// V4.2 - Privacy 1.2
+  HCI_TL_CMD( HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST         , hciLEAddDeviceToResolvingList          )
+  HCI_TL_CMD( HCI_LE_REMOVE_DEVICE_FROM_RESOLVING_LIST    , hciLERemoveDeviceFromResolvingList     )
+  HCI_TL_CMD( HCI_LE_CLEAR_RESOLVING_LIST                 , hciLEClearResolvingList                )
+  HCI_TL_CMD( HCI_LE_READ_RESOLVING_LIST_SIZE             , hciLEReadResolvingListSize             )
+  HCI_TL_CMD( HCI_LE_READ_PEER_RESOLVABLE_ADDRESS         , hciLEReadPeerResolvableAddress         )
+  HCI_TL_CMD( HCI_LE_READ_LOCAL_RESOLVABLE_ADDRESS        , hciLEReadLocalResolvableAddress        )
+  HCI_TL_CMD( HCI_LE_SET_ADDRESS_RESOLUTION_ENABLE        , hciLESetAddressResolutionEnable        )
+  HCI_TL_CMD( HCI_LE_SET_RESOLVABLE_PRIVATE_ADDRESS_TIMEOUT, hciLESetResolvablePrivateAddressTimeout )
+  HCI_TL_CMD( HCI_LE_SET_PRIVACY_MODE                     , hciLESetPrivacyMode                    )
+
+// V5.0 - 2M and Coded PHY
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
+  HCI_TL_CMD( HCI_LE_READ_PHY                             , hciLEReadPhy                           )
+  HCI_TL_CMD( HCI_LE_SET_DEFAULT_PHY                      , hciLESetDefaultPhy                     )
+  HCI_TL_CMD( HCI_LE_SET_PHY                              , hciLESetPhy                            )
+  HCI_TL_CMD( HCI_LE_ENHANCED_RECEIVER_TEST               , hciLEEnhancedRxTest                    )
+  HCI_TL_CMD( HCI_LE_ENHANCED_TRANSMITTER_TEST            , hciLEEnhancedTxTest                    )
+#endif // (ADV_CONN_CFG | INIT_CFG)
+
+  HCI_TL_CMD( HCI_LE_READ_TX_POWER                        , hciLEReadTxPower                       )
+  HCI_TL_CMD( HCI_LE_READ_RF_PATH_COMPENSATION            , hciLEReadRfPathCompCmd                 )
+  HCI_TL_CMD( HCI_LE_WRITE_RF_PATH_COMPENSATION           , hciLEWriteRfPathCompCmd                )
+
+  HCI_TL_CMD( HCI_LE_SET_CONNECTION_CTE_RECEIVE_PARAMS    , hciLESetConnectionCteReceiveParams     )
+  HCI_TL_CMD( HCI_LE_SET_CONNECTION_CTE_TRANSMIT_PARAMS   , hciLESetConnectionCteTransmitParams    )
+  HCI_TL_CMD( HCI_LE_SET_CONNECTION_CTE_REQUEST_ENABLE    , hciLESetConnectionCteRequestEnable     )
+  HCI_TL_CMD( HCI_LE_SET_CONNECTION_CTE_RESPONSE_ENABLE   , hciLESetConnectionCteResponseEnable    )
+  HCI_TL_CMD( HCI_LE_READ_ANTENNA_INFORMATION             , hciLEReadAntennaInformation            )
+
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_NCONN_CFG | ADV_CONN_CFG))
+  HCI_TL_CMD( HCI_LE_SET_PERIODIC_ADV_PARAMETERS          , hciLESetPeriodicAdvParams              )
+  HCI_TL_CMD( HCI_LE_SET_PERIODIC_ADV_DATA                , hciLESetPeriodicAdvData                )
+  HCI_TL_CMD( HCI_LE_SET_PERIODIC_ADV_ENABLE              , hciLESetPeriodicAdvEnable              )
+  HCI_TL_CMD( HCI_LE_SET_CONNECTIONLESS_CTE_TRANSMIT_PARAMS, hciLESetConnectionlessCteTransmitParams )
+  HCI_TL_CMD( HCI_LE_SET_CONNECTIONLESS_CTE_TRANSMIT_ENABLE, hciLESetConnectionlessCteTransmitEnable )
+#endif // ADV_NCONN_CFG | ADV_CONN_CFG
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & SCAN_CFG)
+  HCI_TL_CMD( HCI_LE_PERIODIC_ADV_CREATE_SYNC             , hciLEPeriodicAdvCreateSync             )
+  HCI_TL_CMD( HCI_LE_PERIODIC_ADV_CREATE_SYNC_CANCEL      , hciLEPeriodicAdvCreateSyncCancel       )
+  HCI_TL_CMD( HCI_LE_PERIODIC_ADV_TERMINATE_SYNC          , hciLEPeriodicAdvTerminateSync          )
+  HCI_TL_CMD( HCI_LE_ADD_DEVICE_TO_PERIODIC_ADV_LIST      , hciLEAddDeviceToPeriodicAdvList        )
+  HCI_TL_CMD( HCI_LE_REMOVE_DEVICE_FROM_PERIODIC_ADV_LIST , hciLERemoveDeviceFromPeriodicAdvList   )
+  HCI_TL_CMD( HCI_LE_CLEAR_PERIODIC_ADV_LIST              , hciLEClearPeriodicAdvList              )
+  HCI_TL_CMD( HCI_LE_READ_PERIODIC_ADV_LIST_SIZE          , hciLEReadPeriodicAdvListSize           )
+  HCI_TL_CMD( HCI_LE_SET_PERIODIC_ADV_RECEIVE_ENABLE      , hciLESetPeriodicAdvReceiveEnable       )
+  HCI_TL_CMD( HCI_LE_SET_CONNECTIONLESS_IQ_SAMPLING_ENABLE, hciLESetConnectionlessIqSamplingEnable )
+#endif
+
+  // Vendor Specific Commands
+  HCI_TL_CMD( HCI_EXT_SET_RX_GAIN                         , hciExtSetRxGain                        )
+  HCI_TL_CMD( HCI_EXT_SET_TX_POWER                        , hciExtSetTxPower                       )
+  HCI_TL_CMD( HCI_EXT_SET_TX_POWER_DBM                    , hciExtSetTxPowerDbm                    )
+  HCI_TL_CMD( HCI_EXT_EXTEND_RF_RANGE                     , hciExtExtendRfRange                    )
+  HCI_TL_CMD( HCI_EXT_HALT_DURING_RF                      , hciExtHaltDuringRf                     )
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
+  HCI_TL_CMD( HCI_EXT_ONE_PKT_PER_EVT                     , hciExtOnePktPerEvt                     )
+#endif // ADV_CONN_CFG | INIT_CFG
+  HCI_TL_CMD( HCI_EXT_CLK_DIVIDE_ON_HALT                  , hciExtClkDivOnHalt                     )
+  HCI_TL_CMD( HCI_EXT_DECLARE_NV_USAGE                    , hciExtDeclareNvUsage                   )
+  HCI_TL_CMD( HCI_EXT_DECRYPT                             , hciExtDecrypt                          )
+  HCI_TL_CMD( HCI_EXT_SET_LOCAL_SUPPORTED_FEATURES        , hciExtSetLocalSupportedFeatures        )
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & ADV_CONN_CFG)
+  HCI_TL_CMD( HCI_EXT_SET_FAST_TX_RESP_TIME               , hciExtSetFastTxResponseTime            )
+  HCI_TL_CMD( HCI_EXT_OVERRIDE_PL                         , hciExtSetPeripheralLatencyOverride     )
+#endif // ADV_CONN_CFG
+#if !defined(CTRL_V50_CONFIG)
+  HCI_TL_CMD( HCI_EXT_MODEM_TEST_TX                       , hciExtModemTestTx                      )
+  HCI_TL_CMD( HCI_EXT_MODEM_HOP_TEST_TX                   , hciExtModemHopTestTx                   )
+  HCI_TL_CMD( HCI_EXT_MODEM_TEST_RX                       , hciExtModemtestRx                      )
+  HCI_TL_CMD( HCI_EXT_END_MODEM_TEST                      , hciExtEndModemTest                     )
+#endif // !CTRL_V50_CONFIG
+  HCI_TL_CMD( HCI_EXT_SET_BDADDR                          , hciExtSetBDADDR                        )
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
+  HCI_TL_CMD( HCI_EXT_SET_SCA                             , hciExtSetSCA                           )
+#endif // ADV_CONN_CFG | INIT_CFG
+  HCI_TL_CMD( HCI_EXT_SET_MAX_DTM_TX_POWER                , hciExtSetMaxDtmTxPower                 )
+  HCI_TL_CMD( HCI_EXT_SET_MAX_DTM_TX_POWER_DBM            , hciExtSetMaxDtmTxPowerDbm              )
+  HCI_TL_CMD( HCI_EXT_MAP_PM_IO_PORT                      , hciExtMapPmIoPort                      )
+  HCI_TL_CMD( HCI_EXT_SET_FREQ_TUNE                       , hciExtSetFreqTune                      )
+  HCI_TL_CMD( HCI_EXT_SAVE_FREQ_TUNE                      , hciExtSaveFreqTune                     )
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
+  HCI_TL_CMD( HCI_EXT_DISCONNECT_IMMED                    , hciExtDisconnectImmed                  )
+  HCI_TL_CMD( HCI_EXT_PER                                 , hciExtPER                              )
+  HCI_TL_CMD( HCI_EXT_OVERLAPPED_PROCESSING               , hciExtOverlappedProcessing             )
+  HCI_TL_CMD( HCI_EXT_NUM_COMPLETED_PKTS_LIMIT            , hciExtNumComplPktsLimit                )
+  HCI_TL_CMD( HCI_EXT_GET_CONNECTION_INFO                 , hciExtGetConnInfo                      )
+#endif // ADV_CONN_CFG | INIT_CFG
+  HCI_TL_CMD( HCI_EXT_BUILD_REVISION                      , hciExtBuildRevision                    )
+  HCI_TL_CMD( HCI_EXT_DELAY_SLEEP                         , hciExtDelaySleep                       )
+  // TEMP: OVERLAPPED PROCESSING HOLDER
+  HCI_TL_CMD( HCI_EXT_RESET_SYSTEM                        , hciExtResetSystem                      )
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & ADV_NCONN_CFG )
+  HCI_TL_CMD( HCI_EXT_LE_SET_EXT_VIRTUAL_ADV_ADDRESS      , hciExtSetVirtualAdvAddr                )
+#endif // ADV_NCONN_CFG
+#if defined(CTRL_CONFIG) && (CTRL_CONFIG & (ADV_CONN_CFG | INIT_CFG))
+  HCI_TL_CMD( HCI_EXT_SET_MAX_DATA_LENGTH                 , hciExtSetMaxDataLen                    )
+#endif // (ADV_CONN_CFG | INIT_CFG)
+#ifdef LL_TEST_MODE
+  HCI_TL_CMD( HCI_EXT_LL_TEST_MODE                        , hciExtLLTestMode                       )
+#endif // LL_TEST_MODE
+  HCI_TL_CMD( HCI_EXT_READ_RAND_ADDR                      , hciExtReadRandAddr                     )
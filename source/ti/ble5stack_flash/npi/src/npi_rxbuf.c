@@ -140,12 +140,18 @@ uint16 NPIRxBuf_GetRxBufAvail(void)
 // -----------------------------------------------------------------------------
 uint16 NPIRxBuf_ReadFromRxBuf(uint8_t *buf, uint16 len)
 {
-	uint16_t idx;
-    for (idx = 0; idx < len; idx++)
+    uint16 partialLen = 0;
+
+    // Need to make two copies due to wrap around of circular buffer
+    if ((len + RxBufHead) > NPI_TL_BUF_SIZE)
     {
-        *buf++ = RxBuf[RxBufHead];
-        NPIRXBUF_RXHEAD_INC(1)
+        partialLen = NPI_TL_BUF_SIZE - RxBufHead;
+        memcpy(buf, &RxBuf[RxBufHead], partialLen);
+        RxBufHead = 0;
     }
 
+    memcpy(&buf[partialLen], &RxBuf[RxBufHead], len - partialLen);
+    NPIRXBUF_RXHEAD_INC(len - partialLen)
+
     return len;
 }
@@ -151,6 +151,27 @@
 #define OSALMEM_PROFILER_LL        FALSE  // Special profiling of the Long-Lived bucket.
 #endif
 
+#if defined OSALMEM_SIZE_CLASSES
+/* Block lengths, including the header, of the size classes. Blocks of these lengths are kept on
+ * per-class free lists when freed and handed out again without walking the heap, so list the
+ * sizes of the high frequency messages (HCI events, GAP/GATT messages) profiled for the system.
+ * The sizes must be ascending, larger than OSALMEM_SMALL_BLKSZ and even multiples of
+ * OSALMEM_HDRSZ. Smaller allocations keep using the small-block bucket, bigger ones the
+ * big-block region.
+ * Requests are rounded up to their class size, so leave some heap headroom: when the heap runs
+ * out the kept blocks are given back, but a nearly full heap fragments sooner than first-fit.
+ */
+#if !defined OSALMEM_CLASS_SIZES
+#define OSALMEM_CLASS_SIZES       24, 32, 48, 64, 96, 128, 160, 256
+#endif
+#define OSALMEM_CLASS_CNT         (sizeof(osalMemClassLen) / sizeof(osalMemClassLen[0]))
+
+// Maximum number of free blocks kept per size class, the others go back to the heap.
+#if !defined OSALMEM_CLASS_MAX_FREE
+#define OSALMEM_CLASS_MAX_FREE    4
+#endif
+#endif
+
 #if OSALMEM_PROFILER
 #define OSALMEM_INIT              'X'
 #define OSALMEM_ALOC              'A'
@@ -193,6 +214,14 @@ static osalMemHdr_t *ff1;  // First free block in the small-block bucket.
 
 static uint8 osalMemStat;            // Discrete status flags: 0x01 = kicked.
 
+#if defined OSALMEM_SIZE_CLASSES
+static const uint16 osalMemClassLen[] = { OSALMEM_CLASS_SIZES };
+// Free lists of the size classes. The blocks stay marked in-use in the heap, the link to the next
+// block of the list is stored in the data area.
+static osalMemHdr_t *osalMemClassFree[OSALMEM_CLASS_CNT];
+static uint8 osalMemClassFreeCnt[OSALMEM_CLASS_CNT];
+#endif
+
 #if OSALMEM_METRICS
 static uint16 blkMax;  // Max cnt of all blocks ever seen at once.
 static uint16 blkCnt;  // Current cnt of all blocks.
@@ -224,6 +253,16 @@ static uint16 proSmallBlkMiss;
 extern int dprintf(const char *fmt, ...);
 #endif /* DPRINTF_HEAPTRACE */
 
+/* ------------------------------------------------------------------------------------------------
+ *                                           Local Functions
+ * ------------------------------------------------------------------------------------------------
+ */
+
+static osalMemHdr_t *osalMemFindBlock(osalMemHdr_t *hdr, uint16 size);
+#if defined OSALMEM_SIZE_CLASSES
+static uint8 osalMemClassFlush(void);
+#endif
+
 /**************************************************************************************************
  * @fn          osal_mem_init
  *
@@ -262,6 +301,18 @@ void osal_mem_init(void)
   // Setup the wilderness.
   theHeap[OSALMEM_BIGBLK_IDX].val = OSALMEM_BIGBLK_SZ;  // Set 'len' & clear 'inUse' field.
 
+#if defined OSALMEM_SIZE_CLASSES
+  {
+    uint8 idx;
+
+    for ( idx = 0; idx < OSALMEM_CLASS_CNT; idx++ )
+    {
+      osalMemClassFree[idx] = NULL;
+      osalMemClassFreeCnt[idx] = 0;
+    }
+  }
+#endif
+
 #if ( OSALMEM_METRICS )
   /* Start with the small-block bucket and the wilderness - don't count the
    * end-of-heap NULL block nor the end-of-small-block NULL block.
@@ -307,6 +358,121 @@ void osal_mem_kick(void)
   HAL_EXIT_CRITICAL_SECTION(intState);  // Re-enable interrupts.
 }
 
+/**************************************************************************************************
+ * @fn          osalMemFindBlock
+ *
+ * @brief       First-fit search for a free block, coalescing free blocks on the way.
+ *              Ints must be disabled.
+ *
+ * input parameters
+ *
+ * @param hdr - the block to start the search from.
+ * @param size - the total block size needed, including the header.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      The block found, NULL if none is big enough.
+ */
+static osalMemHdr_t *osalMemFindBlock(osalMemHdr_t *hdr, uint16 size)
+{
+  osalMemHdr_t *prev = NULL;
+  uint8 coal = 0;
+
+  do
+  {
+    if ( hdr->hdr.inUse )
+    {
+      coal = 0;
+    }
+    else
+    {
+      if ( coal != 0 )
+      {
+#if ( OSALMEM_METRICS )
+        blkCnt--;
+        blkFree--;
+#endif
+
+        prev->hdr.len += hdr->hdr.len;
+
+        if ( prev->hdr.len >= size )
+        {
+          hdr = prev;
+          break;
+        }
+      }
+      else
+      {
+        if ( hdr->hdr.len >= size )
+        {
+          break;
+        }
+
+        coal = 1;
+        prev = hdr;
+      }
+    }
+
+    hdr = (osalMemHdr_t *)((uint8 *)hdr + hdr->hdr.len);
+
+    if ( hdr->val == 0 )
+    {
+      hdr = NULL;
+      break;
+    }
+  } while (1);
+
+  return hdr;
+}
+
+#if defined OSALMEM_SIZE_CLASSES
+/**************************************************************************************************
+ * @fn          osalMemClassFlush
+ *
+ * @brief       Give all the blocks kept on the size class free lists back to the heap, so they
+ *              can be coalesced and used for any size.
+ *              Ints must be disabled.
+ *
+ * input parameters
+ *
+ * None.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      TRUE if any block was given back, FALSE otherwise.
+ */
+static uint8 osalMemClassFlush(void)
+{
+  uint8 flushed = FALSE;
+  uint8 idx;
+
+  for ( idx = 0; idx < OSALMEM_CLASS_CNT; idx++ )
+  {
+    while ( osalMemClassFree[idx] != NULL )
+    {
+      osalMemHdr_t *hdr = osalMemClassFree[idx];
+
+      osalMemClassFree[idx] = *(osalMemHdr_t **)(hdr + 1);
+      osalMemClassFreeCnt[idx]--;
+
+      // The block was already counted free in the metrics when it was put on the list.
+      hdr->hdr.inUse = FALSE;
+      if (ff1 > hdr)
+      {
+        ff1 = hdr;
+      }
+      flushed = TRUE;
+    }
+  }
+
+  return flushed;
+}
+#endif
+
 /**************************************************************************************************
  * @fn          osal_mem_alloc
  *
@@ -328,10 +494,8 @@ void *osal_mem_alloc_dbg( uint16 size, const char *fname, unsigned lnum )
 void *osal_mem_alloc( uint16 size )
 #endif /* DPRINTF_OSALHEAPTRACE */
 {
-  osalMemHdr_t *prev = NULL;
   osalMemHdr_t *hdr;
   halIntState_t intState;
-  uint8 coal = 0;
   uint16 allocSize;
 
   allocSize = size;
@@ -359,62 +523,75 @@ void *osal_mem_alloc( uint16 size )
     }
   }
 
+#if defined OSALMEM_SIZE_CLASSES
+  // After the long-lived allocations, sizes served by a size class are first taken from the
+  // class free list, and otherwise carved from the heap at the full class size for later reuse.
+  if ((osalMemStat != 0) && (size > OSALMEM_SMALL_BLKSZ) &&
+      (size <= osalMemClassLen[OSALMEM_CLASS_CNT - 1]))
+  {
+    uint8 cls;
+
+    for ( cls = 0; osalMemClassLen[cls] < size; cls++ );
+
+    HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
+
+    hdr = osalMemClassFree[cls];
+    if ( hdr != NULL )
+    {
+      osalMemClassFree[cls] = *(osalMemHdr_t **)(hdr + 1);
+      osalMemClassFreeCnt[cls]--;
+
+#if ( OSALMEM_METRICS )
+      memAlo += hdr->hdr.len;
+      blkFree--;
+      if ( memMax < memAlo )
+      {
+        memMax = memAlo;
+      }
+#endif
+    }
+
+    HAL_EXIT_CRITICAL_SECTION( intState );  // Re-enable interrupts.
+
+    if ( hdr != NULL )
+    {
+#ifdef DPRINTF_OSALHEAPTRACE
+      dprintf("osal_mem_alloc(%u)->%lx:%s:%u\n", size, (unsigned) (hdr + 1), fname, lnum);
+#endif /* DPRINTF_OSALHEAPTRACE */
+      return (void *)(hdr + 1);
+    }
+
+    size = osalMemClassLen[cls];
+  }
+#endif
+
   HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
 
   // Smaller allocations are first attempted in the small-block bucket, and all long-lived
   // allocations are channelled into the LL block reserved within this bucket.
   if ((osalMemStat == 0) || (size <= OSALMEM_SMALL_BLKSZ))
   {
-    hdr = ff1;
+    hdr = osalMemFindBlock(ff1, size);
   }
   else
   {
-    hdr = (theHeap + OSALMEM_BIGBLK_IDX);
+    hdr = osalMemFindBlock((theHeap + OSALMEM_BIGBLK_IDX), size);
   }
 
-  do
+#if defined OSALMEM_SIZE_CLASSES
+  // The heap is exhausted - give the blocks kept by the size classes back and search again.
+  if ( (hdr == NULL) && (osalMemClassFlush() == TRUE) )
   {
-    if ( hdr->hdr.inUse )
+    if ((osalMemStat == 0) || (size <= OSALMEM_SMALL_BLKSZ))
     {
-      coal = 0;
+      hdr = osalMemFindBlock(ff1, size);
     }
     else
     {
-      if ( coal != 0 )
-      {
-#if ( OSALMEM_METRICS )
-        blkCnt--;
-        blkFree--;
-#endif
-
-        prev->hdr.len += hdr->hdr.len;
-
-        if ( prev->hdr.len >= size )
-        {
-          hdr = prev;
-          break;
-        }
-      }
-      else
-      {
-        if ( hdr->hdr.len >= size )
-        {
-          break;
-        }
-
-        coal = 1;
-        prev = hdr;
-      }
-    }
-
-    hdr = (osalMemHdr_t *)((uint8 *)hdr + hdr->hdr.len);
-
-    if ( hdr->val == 0 )
-    {
-      hdr = NULL;
-      break;
+      hdr = osalMemFindBlock((theHeap + OSALMEM_BIGBLK_IDX), size);
     }
-  } while (1);
+  }
+#endif
 
   if ( hdr != NULL )
   {
@@ -542,6 +719,35 @@ void osal_mem_free(void *ptr)
   HAL_ASSERT(hdr->hdr.inUse);
 
   HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
+
+#if defined OSALMEM_SIZE_CLASSES
+  // Blocks carved for a size class go back to the class free list, still marked in-use.
+  if ((osalMemStat != 0) && (hdr->hdr.len >= osalMemClassLen[0]) &&
+      (hdr->hdr.len < (osalMemClassLen[OSALMEM_CLASS_CNT - 1] + OSALMEM_MIN_BLKSZ)))
+  {
+    uint8 cls;
+
+    // The class with the largest length not bigger than the block
+    for ( cls = OSALMEM_CLASS_CNT - 1; osalMemClassLen[cls] > hdr->hdr.len; cls-- );
+
+    if ((hdr->hdr.len < (osalMemClassLen[cls] + OSALMEM_MIN_BLKSZ)) &&
+        (osalMemClassFreeCnt[cls] < OSALMEM_CLASS_MAX_FREE))
+    {
+      *(osalMemHdr_t **)(hdr + 1) = osalMemClassFree[cls];
+      osalMemClassFree[cls] = hdr;
+      osalMemClassFreeCnt[cls]++;
+
+#if OSALMEM_METRICS
+      memAlo -= hdr->hdr.len;
+      blkFree++;
+#endif
+
+      HAL_EXIT_CRITICAL_SECTION( intState );  // Re-enable interrupts.
+      return;
+    }
+  }
+#endif
+
   hdr->hdr.inUse = FALSE;
 
   if (ff1 > hdr)
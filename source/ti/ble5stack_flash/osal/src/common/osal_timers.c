@@ -62,11 +62,46 @@
  * MACROS
  */
 
+#ifdef OSAL_TIMER_WHEEL
+// Wheel slot of an absolute time in milliseconds
+#define OSAL_TIMER_SLOT( t )              ( (t) & (OSAL_TIMER_WHEEL_SLOTS - 1) )
+
+// Lookup hash bucket of a task/event pair
+#define OSAL_TIMER_HASH( task_id, event_flag ) \
+  ( ((task_id) ^ (event_flag) ^ ((event_flag) >> 4) ^ \
+     ((event_flag) >> 8) ^ ((event_flag) >> 12)) & (OSAL_TIMER_HASH_BUCKETS - 1) )
+
+// TRUE if the absolute time a is at or before b, wrap safe
+#define OSAL_TIMER_DUE( a, b )            ( (int32)((a) - (b)) <= 0 )
+
+#define OSAL_TIMERS_EMPTY()               ( osalTimerCount == 0 )
+#else
+#define OSAL_TIMERS_EMPTY()               ( timerHead == NULL )
+#endif /* OSAL_TIMER_WHEEL */
+
 /*********************************************************************
  * CONSTANTS
  */
 #define MILLS_IN_MICROS                   1000
 
+#ifdef OSAL_TIMER_WHEEL
+// Number of slots of the timer wheel (1 ms each), must be a power of 2
+// and at most 256
+#ifndef OSAL_TIMER_WHEEL_SLOTS
+  #define OSAL_TIMER_WHEEL_SLOTS          64
+#endif
+
+// Number of buckets of the task/event lookup hash, must be a power of 2
+#ifndef OSAL_TIMER_HASH_BUCKETS
+  #define OSAL_TIMER_HASH_BUCKETS         16
+#endif
+
+// Number of pre-allocated timer records, the heap is used once exhausted
+#ifndef OSAL_TIMER_POOL_SIZE
+  #define OSAL_TIMER_POOL_SIZE            16
+#endif
+#endif /* OSAL_TIMER_WHEEL */
+
 /*********************************************************************
  * TYPEDEFS
  */
@@ -77,6 +112,21 @@ typedef union {
   uint8 time8[4];
 } osalTime_t;
 
+#ifdef OSAL_TIMER_WHEEL
+// Timer records are linked both in a wheel slot (by expiry time) and in
+// a lookup hash bucket (by task_id/event_flag).
+typedef struct
+{
+  void   *next;           // next record in the wheel slot
+  void   *prev;           // previous record in the wheel slot
+  void   *hashNext;       // next record in the hash bucket
+  uint32 expiry;          // absolute expiry time, in osal_systemClock ms
+  uint32 event_flag;
+  uint8  task_id;
+  uint8  slot;            // wheel slot the timer is linked to
+  uint32 reloadTimeout;
+} osalTimerRec_t;
+#else
 typedef struct
 {
   void   *next;
@@ -85,12 +135,15 @@ typedef struct
   uint8  task_id;
   uint32 reloadTimeout;
 } osalTimerRec_t;
+#endif /* OSAL_TIMER_WHEEL */
 
 /*********************************************************************
  * GLOBAL VARIABLES
  */
 
+#ifndef OSAL_TIMER_WHEEL
 osalTimerRec_t *timerHead;
+#endif /* OSAL_TIMER_WHEEL */
 
 // Last read tick count value reflected into the OSAL timer
 uint_least32_t osal_last_timestamp;
@@ -109,12 +162,31 @@ uint_least32_t osal_last_timestamp;
 // Milliseconds since last reboot
 static uint32 osal_systemClock;
 
+#ifdef OSAL_TIMER_WHEEL
+// Timer wheel, slot N holds the timers expiring at N modulo the wheel size
+static osalTimerRec_t *osalTimerWheel[OSAL_TIMER_WHEEL_SLOTS];
+
+// Task/event lookup hash
+static osalTimerRec_t *osalTimerHash[OSAL_TIMER_HASH_BUCKETS];
+
+// Timer record pool and its free list
+static osalTimerRec_t osalTimerPool[OSAL_TIMER_POOL_SIZE];
+static osalTimerRec_t *osalTimerFree;
+
+// Number of active timers
+static uint16 osalTimerCount;
+#endif /* OSAL_TIMER_WHEEL */
+
 /*********************************************************************
  * LOCAL FUNCTION PROTOTYPES
  */
 osalTimerRec_t  *osalAddTimer( uint8 task_id, uint32 event_flag, uint32 timeout );
 osalTimerRec_t *osalFindTimer( uint8 task_id, uint32 event_flag );
 void osalDeleteTimer( osalTimerRec_t *rmTimer );
+#ifdef OSAL_TIMER_WHEEL
+static void osalTimerLink( osalTimerRec_t *timer );
+static void osalTimerUnlink( osalTimerRec_t *timer );
+#endif /* OSAL_TIMER_WHEEL */
 
 /*********************************************************************
  * FUNCTIONS
@@ -133,12 +205,248 @@ void osalTimerInit( void )
 {
   osal_systemClock = 0;
 
+#ifdef OSAL_TIMER_WHEEL
+  {
+    uint16 i;
+
+    for ( i = 0; i < OSAL_TIMER_WHEEL_SLOTS; i++ )
+    {
+      osalTimerWheel[i] = NULL;
+    }
+
+    for ( i = 0; i < OSAL_TIMER_HASH_BUCKETS; i++ )
+    {
+      osalTimerHash[i] = NULL;
+    }
+
+    // Link all the pool records to the free list
+    osalTimerFree = NULL;
+    for ( i = 0; i < OSAL_TIMER_POOL_SIZE; i++ )
+    {
+      osalTimerPool[i].next = osalTimerFree;
+      osalTimerFree = &osalTimerPool[i];
+    }
+
+    osalTimerCount = 0;
+  }
+#endif /* OSAL_TIMER_WHEEL */
+
 #ifdef USE_ICALL
   // Initialize variables used to track timing and provide OSAL timer service
   osal_last_timestamp = (uint_least32_t) ICall_getTicks();
 #endif /* USE_ICALL */
 }
 
+#ifdef OSAL_TIMER_WHEEL
+/*********************************************************************
+ * @fn      osalTimerLink
+ *
+ * @brief   Link a timer to the wheel slot of its expiry time.
+ *          A timer already due is linked to the next slot to be
+ *          processed by osalTimerUpdate().
+ *          Ints must be disabled.
+ *
+ * @param   timer
+ *
+ * @return  none
+ */
+static void osalTimerLink( osalTimerRec_t *timer )
+{
+  osalTimerRec_t **slot;
+
+  if ( OSAL_TIMER_DUE( timer->expiry, osal_systemClock ) )
+  {
+    timer->slot = OSAL_TIMER_SLOT( osal_systemClock + 1 );
+  }
+  else
+  {
+    timer->slot = OSAL_TIMER_SLOT( timer->expiry );
+  }
+
+  slot = &osalTimerWheel[timer->slot];
+  timer->prev = NULL;
+  timer->next = *slot;
+  if ( *slot )
+  {
+    (*slot)->prev = timer;
+  }
+  *slot = timer;
+}
+
+/*********************************************************************
+ * @fn      osalTimerUnlink
+ *
+ * @brief   Take a timer out of its wheel slot.
+ *          Ints must be disabled.
+ *
+ * @param   timer
+ *
+ * @return  none
+ */
+static void osalTimerUnlink( osalTimerRec_t *timer )
+{
+  osalTimerRec_t *next = timer->next;
+  osalTimerRec_t *prev = timer->prev;
+
+  if ( next )
+  {
+    next->prev = prev;
+  }
+
+  if ( prev )
+  {
+    prev->next = next;
+  }
+  else
+  {
+    // The timer is the head of its slot
+    osalTimerWheel[timer->slot] = next;
+  }
+
+  timer->next = NULL;
+  timer->prev = NULL;
+}
+
+/*********************************************************************
+ * @fn      osalAddTimer
+ *
+ * @brief   Add a timer to the timer wheel.
+ *          Ints must be disabled.
+ *
+ * @param   task_id
+ * @param   event_flag
+ * @param   timeout
+ *
+ * @return  osalTimerRec_t * - pointer to newly created timer
+ */
+osalTimerRec_t * osalAddTimer( uint8 task_id, uint32 event_flag, uint32 timeout )
+{
+  osalTimerRec_t *newTimer;
+
+  // Look for an existing timer first
+  newTimer = osalFindTimer( task_id, event_flag );
+  if ( newTimer )
+  {
+    // Timer is found - move it to its new slot
+    osalTimerUnlink( newTimer );
+    newTimer->expiry = osal_systemClock + timeout;
+    osalTimerLink( newTimer );
+
+    return ( newTimer );
+  }
+
+  // New Timer, take it from the pool first
+  newTimer = osalTimerFree;
+  if ( newTimer )
+  {
+    osalTimerFree = newTimer->next;
+  }
+  else
+  {
+    newTimer = osal_mem_alloc( sizeof( osalTimerRec_t ) );
+  }
+
+  if ( newTimer )
+  {
+    uint8 bucket = OSAL_TIMER_HASH( task_id, event_flag );
+
+    // Fill in new timer
+    newTimer->task_id = task_id;
+    newTimer->event_flag = event_flag;
+    newTimer->expiry = osal_systemClock + timeout;
+    newTimer->reloadTimeout = 0;
+
+    // Add it to the wheel and to the lookup hash
+    osalTimerLink( newTimer );
+    newTimer->hashNext = osalTimerHash[bucket];
+    osalTimerHash[bucket] = newTimer;
+
+    osalTimerCount++;
+  }
+
+  return ( newTimer );
+}
+
+/*********************************************************************
+ * @fn      osalFindTimer
+ *
+ * @brief   Find a timer in the lookup hash.
+ *          Ints must be disabled.
+ *
+ * @param   task_id
+ * @param   event_flag
+ *
+ * @return  osalTimerRec_t *
+ */
+osalTimerRec_t *osalFindTimer( uint8 task_id, uint32 event_flag )
+{
+  osalTimerRec_t *srchTimer;
+
+  srchTimer = osalTimerHash[OSAL_TIMER_HASH( task_id, event_flag )];
+
+  // Stop when found or at the end of the bucket
+  while ( srchTimer )
+  {
+    if ( srchTimer->event_flag == event_flag &&
+         srchTimer->task_id == task_id )
+    {
+      break;
+    }
+
+    srchTimer = srchTimer->hashNext;
+  }
+
+  return ( srchTimer );
+}
+
+/*********************************************************************
+ * @fn      osalDeleteTimer
+ *
+ * @brief   Delete a timer and return its record to the pool.
+ *          Ints must be disabled.
+ *
+ * @param   rmTimer
+ *
+ * @return  none
+ */
+void osalDeleteTimer( osalTimerRec_t *rmTimer )
+{
+  osalTimerRec_t **srchTimer;
+
+  if ( rmTimer == NULL )
+  {
+    return;
+  }
+
+  osalTimerUnlink( rmTimer );
+
+  // Take out of the lookup hash
+  srchTimer = &osalTimerHash[OSAL_TIMER_HASH( rmTimer->task_id, rmTimer->event_flag )];
+  while ( *srchTimer )
+  {
+    if ( *srchTimer == rmTimer )
+    {
+      *srchTimer = rmTimer->hashNext;
+      break;
+    }
+    srchTimer = (osalTimerRec_t **)&(*srchTimer)->hashNext;
+  }
+
+  osalTimerCount--;
+
+  // Return the record to the pool, or to the heap if it came from there
+  if ( (rmTimer >= &osalTimerPool[0]) &&
+       (rmTimer < &osalTimerPool[OSAL_TIMER_POOL_SIZE]) )
+  {
+    rmTimer->next = osalTimerFree;
+    osalTimerFree = rmTimer;
+  }
+  else
+  {
+    osal_mem_free( rmTimer );
+  }
+}
+#else
 /*********************************************************************
  * @fn      osalAddTimer
  *
@@ -262,6 +570,8 @@ void osalDeleteTimer( osalTimerRec_t *rmTimer )
   }
 }
 
+#endif /* OSAL_TIMER_WHEEL */
+
 #ifdef USE_ICALL
 /*********************************************************************
  * @fn      osal_timer_refTimeUpdate
@@ -324,7 +634,7 @@ uint8 osal_start_timerEx( uint8 taskID, uint16 event_id, uint32 timeout_value )
   osalTimerRec_t *newTimer;
 
 #ifdef USE_ICALL
-  if ( timerHead == NULL )
+  if ( OSAL_TIMERS_EMPTY() )
   {
     osal_timer_refTimeUpdate();
   }
@@ -430,7 +740,14 @@ uint32 osal_get_timeoutEx( uint8 task_id, uint16 event_id )
 
   if ( tmr )
   {
+#ifdef OSAL_TIMER_WHEEL
+    if ( !OSAL_TIMER_DUE( tmr->expiry, osal_systemClock ) )
+    {
+      rtrn = tmr->expiry - osal_systemClock;
+    }
+#else
     rtrn = tmr->timeout.time32;
+#endif /* OSAL_TIMER_WHEEL */
   }
 
   HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
@@ -449,6 +766,9 @@ uint32 osal_get_timeoutEx( uint8 task_id, uint16 event_id )
  */
 uint8 osal_timer_num_active( void )
 {
+#ifdef OSAL_TIMER_WHEEL
+  return ( (osalTimerCount > 0xFF) ? 0xFF : (uint8)osalTimerCount );
+#else
   halIntState_t intState;
   uint8 num_timers = 0;
   osalTimerRec_t *srchTimer;
@@ -468,8 +788,90 @@ uint8 osal_timer_num_active( void )
   HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
 
   return num_timers;
+#endif /* OSAL_TIMER_WHEEL */
 }
 
+#ifdef OSAL_TIMER_WHEEL
+/*********************************************************************
+ * @fn      osalTimerUpdate
+ *
+ * @brief   Update the timer structures for a timer tick.
+ *          Only the wheel slots the elapsed time went over are visited,
+ *          the timers of a slot are processed in a single critical
+ *          section.
+ *
+ * @param   updateTime - elapsed time in milliseconds
+ *
+ * @return  none
+ *********************************************************************/
+void osalTimerUpdate( uint32 updateTime )
+{
+  halIntState_t intState;
+  osalTimerRec_t *srchTimer;
+  osalTimerRec_t *nextTimer;
+  uint32 prevTime;
+  uint32 numSlots;
+  uint32 i;
+
+  HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
+  // Update the system time
+  prevTime = osal_systemClock;
+  osal_systemClock += updateTime;
+  HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
+
+  if ( OSAL_TIMERS_EMPTY() )
+  {
+    return;
+  }
+
+  // Visit the slots from the previous time up to the new one, at least
+  // the next slot (timers started with a zero timeout) and at most one
+  // turn of the wheel
+  numSlots = updateTime;
+  if ( numSlots == 0 )
+  {
+    numSlots = 1;
+  }
+  else if ( numSlots > OSAL_TIMER_WHEEL_SLOTS )
+  {
+    numSlots = OSAL_TIMER_WHEEL_SLOTS;
+  }
+
+  for ( i = 1; i <= numSlots; i++ )
+  {
+    HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
+
+    srchTimer = osalTimerWheel[OSAL_TIMER_SLOT( prevTime + i )];
+    while ( srchTimer )
+    {
+      nextTimer = srchTimer->next;
+
+      // Timers of a later turn of the wheel stay in the slot
+      if ( OSAL_TIMER_DUE( srchTimer->expiry, osal_systemClock ) )
+      {
+        // Notify the task of a timeout
+        osal_set_event( srchTimer->task_id, srchTimer->event_flag );
+
+        if ( srchTimer->reloadTimeout )
+        {
+          // Reload the timer timeout value
+          osalTimerUnlink( srchTimer );
+          srchTimer->expiry = osal_systemClock + srchTimer->reloadTimeout;
+          osalTimerLink( srchTimer );
+        }
+        else
+        {
+          osalDeleteTimer( srchTimer );
+        }
+      }
+
+      srchTimer = nextTimer;
+    }
+
+    HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
+  }
+}
+#else
 /*********************************************************************
  * @fn      osalTimerUpdate
  *
@@ -594,6 +996,8 @@ void osalTimerUpdate( uint32 updateTime )
   }
 }
 
+#endif /* OSAL_TIMER_WHEEL */
+
 #ifdef POWER_SAVING
 /*********************************************************************
  * @fn      osal_adjust_timers
@@ -608,7 +1012,7 @@ void osal_adjust_timers( void )
 {
   uint32 eTime;
 
-  if ( timerHead != NULL )
+  if ( !OSAL_TIMERS_EMPTY() )
   {
     // Compute elapsed time (msec)
     eTime = TimerElapsed() / TICK_COUNT;
@@ -638,7 +1042,53 @@ uint32 osal_next_timeout( void )
 {
   uint32 nextTimeout;
   osalTimerRec_t *srchTimer;
+#ifdef OSAL_TIMER_WHEEL
+  halIntState_t intState;
+  uint8 found = FALSE;
+  uint32 i;
+
+  if ( OSAL_TIMERS_EMPTY() )
+  {
+    // No timers
+    return ( 0 );
+  }
+
+  nextTimeout = OSAL_TIMERS_MAX_TIMEOUT;
+
+  HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
+
+  // The first slot holding a timer that expires within one turn of the
+  // wheel holds the lowest timeout
+  for ( i = 1; (i <= OSAL_TIMER_WHEEL_SLOTS) && (found == FALSE); i++ )
+  {
+    srchTimer = osalTimerWheel[OSAL_TIMER_SLOT( osal_systemClock + i )];
+    while ( srchTimer != NULL )
+    {
+      if ( OSAL_TIMER_DUE( srchTimer->expiry, osal_systemClock + i ) )
+      {
+        nextTimeout = OSAL_TIMER_DUE( srchTimer->expiry, osal_systemClock ) ?
+                      0 : (srchTimer->expiry - osal_systemClock);
+        found = TRUE;
+        break;
+      }
+      srchTimer = srchTimer->next;
+    }
+  }
 
+  // All the timers expire after one turn of the wheel, check them all
+  for ( i = 0; (i < OSAL_TIMER_WHEEL_SLOTS) && (found == FALSE); i++ )
+  {
+    for ( srchTimer = osalTimerWheel[i]; srchTimer != NULL; srchTimer = srchTimer->next )
+    {
+      if ( (srchTimer->expiry - osal_systemClock) < nextTimeout )
+      {
+        nextTimeout = srchTimer->expiry - osal_systemClock;
+      }
+    }
+  }
+
+  HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
+#else
   if ( timerHead != NULL )
   {
     // Head of the timer list
@@ -661,6 +1111,7 @@ uint32 osal_next_timeout( void )
     // No timers
     nextTimeout = 0;
   }
+#endif /* OSAL_TIMER_WHEEL */
 
   return ( nextTimeout );
 }
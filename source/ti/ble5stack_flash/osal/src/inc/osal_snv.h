@@ -79,6 +79,9 @@ extern "C"
   typedef uint16 osalSnvId_t;
   typedef uint16 osalSnvLen_t;
 
+  // Called by osal_snv_read_each() for each item read
+  typedef void (*osalSnvItemCB_t)(osalSnvId_t id, osalSnvLen_t len, void *pBuf);
+
 /*********************************************************************
  * GLOBAL VARIABLES
  */
@@ -112,6 +115,27 @@ extern uint8 osal_snv_init(void);
  */
 extern uint8 osal_snv_read( osalSnvId_t id, osalSnvLen_t len, void *pBuf);
 
+/*********************************************************************
+ * @fn      osal_snv_read_each
+ *
+ * @brief   Read all the NV items of an ID range in one pass through NV.
+ *          Items longer than len are skipped. NV stays locked during the
+ *          pass, pfnItem must not call the NV driver.
+ *
+ * @param   firstId - First NV item Id of the range.
+ * @param   lastId  - Last NV item Id of the range.
+ * @param   len     - Length of pBuf.
+ * @param   *pBuf   - Each item is read into this buffer.
+ * @param   pfnItem - Called with each item read.
+ *
+ * @return  SUCCESS if successful.
+ *          Otherwise, NV_OPER_FAILED if the NV driver can't read in one
+ *          pass, the items must then be read one by one.
+ */
+extern uint8 osal_snv_read_each( osalSnvId_t firstId, osalSnvId_t lastId,
+                                 osalSnvLen_t len, void *pBuf,
+                                 osalSnvItemCB_t pfnItem );
+
 /*********************************************************************
  * @fn      osal_snv_write
  *
@@ -110,6 +110,55 @@ uint8 osal_snv_read( osalSnvId_t id, osalSnvLen_t len, void *pBuf)
   return nvFptrs.readItem(nv_id, 0, len, pBuf);
 }
 
+/*********************************************************************
+ * @fn      osal_snv_read_each
+ *
+ * @brief   Read all the NV items of an ID range in one pass through NV.
+ *          Items longer than len are skipped. NV is locked for the whole
+ *          pass, so writes from other tasks can't move items under it.
+ *
+ * @param   firstId - First NV item Id of the range.
+ * @param   lastId  - Last NV item Id of the range.
+ * @param   len     - Length of pBuf.
+ * @param   *pBuf   - Each item is read into this buffer.
+ * @param   pfnItem - Called with each item read.
+ *
+ * @return  NVINTF_SUCCESS or other nvintf error code.
+ */
+uint8 osal_snv_read_each( osalSnvId_t firstId, osalSnvId_t lastId,
+                          osalSnvLen_t len, void *pBuf,
+                          osalSnvItemCB_t pfnItem )
+{
+  NVINTF_nvProxy_t nvProxy;
+  int32 key;
+  uint8 status;
+
+  if ((nvFptrs.doNext == NULL) || (nvFptrs.lockNV == NULL) ||
+      (nvFptrs.unlockNV == NULL))
+  {
+    return NVINTF_FAILURE;
+  }
+
+  nvProxy.sysid  = SYSTEM_ID;
+  nvProxy.buffer = pBuf;
+  nvProxy.len    = len;
+  nvProxy.flag   = NVINTF_DOSTART | NVINTF_DOSYSID | NVINTF_DOREAD;
+
+  // Items come newest first, each of them only once
+  key = nvFptrs.lockNV();
+  while ((status = nvFptrs.doNext(&nvProxy)) == NVINTF_SUCCESS)
+  {
+    if ((nvProxy.itemid >= firstId) && (nvProxy.itemid <= lastId) &&
+        (nvProxy.subid == 0) && (nvProxy.len <= len))
+    {
+      pfnItem(nvProxy.itemid, nvProxy.len, pBuf);
+    }
+  }
+  nvFptrs.unlockNV(key);
+
+  return (status == NVINTF_NOTFOUND) ? NVINTF_SUCCESS : status;
+}
+
 /*********************************************************************
  * @fn      osal_snv_write
  *
@@ -668,6 +668,20 @@ typedef struct
     uint32_t                        eventMask;      //!< Events mask
 } BLEAppUtil_EventHandler_t;
 
+/**
+ * @brief BLEAppUtil message pool statistics
+ *
+ * Returned by @ref BLEAppUtil_getMsgPoolStats. Use highWater to size
+ * BLEAPPUTIL_MSG_POOL_SIZE for the application load.
+ */
+typedef struct
+{
+    uint16_t    poolSize;       //!< Number of messages in the pool
+    uint16_t    inUse;          //!< Messages currently queued or being processed
+    uint16_t    highWater;      //!< Highest number of messages in use at the same time
+    uint32_t    allocFailures;  //!< Events dropped since the pool was empty
+} BLEAppUtil_MsgPoolStats_t;
+
 /** @} End BLEAppUtil_Structures */
 
 /*********************************************************************
@@ -1016,6 +1030,16 @@ bStatus_t BLEAppUtil_registerSNCB(void);
  */
 bStatus_t BLEAppUtil_registerCNCB(void);
 
+/**
+ * @brief   Get the statistics of the message pool used to pass events
+ *          from the BLE stack callbacks to the BLEAppUtil task
+ *
+ * @param   pStats - Pointer to the statistics to fill
+ *
+ * @return  SUCCESS, INVALIDPARAMETER
+ */
+bStatus_t BLEAppUtil_getMsgPoolStats(BLEAppUtil_MsgPoolStats_t *pStats);
+
 /** @} End BLEAppUtil_Functions */
 
 /*********************************************************************
@@ -53,6 +53,11 @@
 /* This Header file contains all BLE API and icall structure definition */
 #include "icall_ble_api.h"
 
+#ifdef CGM_DB_NVS_INDEX
+#include "ti_drivers_config.h"
+#endif
+
+#include <ti/bleapp/util/record_store/record_store.h>
 #include <ti/bleapp/profiles/continuous_glucose_monitoring/cgm_db.h>
 
 /*********************************************************************
@@ -67,11 +72,16 @@
  * LOCAL VARIABLES
  */
 
-// CGM Measurements Data Base Array Of All Records
-static CGMS_measRecord_t               cgm_db_measRecordsArray[CGM_DB_MAX_NUM_OF_RECORDS];
+// CGM Measurements Data Base, keyed by time offset
+static RecordStore_t                   cgm_db_store;
+
+#ifndef CGM_DB_NVS_INDEX
+// CGM Measurements Data Base Storage when no NVS region is assigned
+static uint8                           cgm_db_ram[CGM_DB_RAM_SIZE];
+#endif
 
-// CGM Current Number Of Measurements
-static CGMS_DB_recordsInfo_entry_t     cgm_db_recordsInfo;
+// Record returned by CGM_DB_getMeasRecord
+static CGMS_measRecord_t               cgm_db_measRecord;
 
 /*********************************************************************
  * GLOBAL VARIABLES
@@ -100,50 +110,29 @@ uint16 cgm_samplingInterval = 1;
  */
 uint16 CGM_DB_getCurrentNumOfRecords(void)
 {
-    return cgm_db_recordsInfo.measDBMaxNumRecords;
+    return (uint16)RecordStore_count(&cgm_db_store);
 }// End of CGM_DB_getCurrentNumOfRecords().
 
 /*********************************************************************
- * @fn      CGM_DB_getCurrentNumOfRecords
+ * @fn      CGM_DB_getNumOfRecordsGreaterOrEqual
  *
- * @brief   This function gets the current number of measurements records
- *          in the data base.
+ * @brief   This function gets the number of measurements records
+ *          in the data base with a time offset greater or equal than
+ *          timeOffset.
  *
- * @param   None.
+ * @param   timeOffset - minimum time offset.
  *
  * @return  cgm_DB_NumOfRecords ValueGREATER
  */
 uint16 CGM_DB_getNumOfRecordsGreaterOrEqual( uint16 timeOffset)
 {
-    uint16 numOfRecords = 0;
-    // The index of the input timeOffset.
-    uint16 timeOffsetRecArrayIndex = ((timeOffset / cgm_samplingInterval) % CGM_DB_MAX_NUM_OF_RECORDS);
-
-    if( (timeOffsetRecArrayIndex > cgm_db_recordsInfo.measDBTail) ||
-        (timeOffsetRecArrayIndex < cgm_db_recordsInfo.measDBHead) ||
-        (CGM_DB_getCurrentNumOfRecords() == 0) )
-    {
-        return  numOfRecords;
-    }
-    // Check valid input.
-    // In case the measRecordNum is NOT in between the head index and tail index record number or the array is empty,
-    // return ERROR
-    if (cgm_db_measRecordsArray[timeOffsetRecArrayIndex].timeOffset < timeOffset)
-    {
-       timeOffsetRecArrayIndex++;
-    }
-
-    for (uint16 i = timeOffsetRecArrayIndex; i < cgm_db_recordsInfo.measDBTail; i++)
-    {
-        numOfRecords++;
-    }
-    return numOfRecords;
-}// End of CGM_DB_getCurrentNumOfRecords().
+    return (uint16)RecordStore_countFrom(&cgm_db_store, RecordStore_matchMinKey(&cgm_db_store, timeOffset));
+}// End of CGM_DB_getNumOfRecordsGreaterOrEqual().
 
 /*********************************************************************
  * @fn      CGM_DB_getMinTimeOffset
  *
- * @brief   This function gets the current index of the minimum record - Head
+ * @brief   This function gets the time offset of the minimum record - Head
  *
  *
  * @param   None.
@@ -152,14 +141,15 @@ uint16 CGM_DB_getNumOfRecordsGreaterOrEqual( uint16 timeOffset)
  */
 uint16 CGM_DB_getMinTimeOffset(void)
 {
-    return cgm_db_measRecordsArray[cgm_db_recordsInfo.measDBHead].timeOffset;
+    return (uint16)RecordStore_firstKey(&cgm_db_store);
 }// End of CGM_DB_getMinTimeOffset().
 
 /*********************************************************************
  * @fn      CGM_DB_initDataBase
  *
  * @brief   This function initializes the CGM's measurements records
- *          data base variables and array.
+ *          data base. When the data base is kept in NVS the records
+ *          stored before a reset are kept.
  *
  * @param   samplingInterval - Current Measurements Interval.
  *
@@ -167,91 +157,29 @@ uint16 CGM_DB_getMinTimeOffset(void)
  */
 bStatus_t CGM_DB_initDataBase( uint16 samplingInterval )
 {
-    uint32 i = 0;
-    bStatus_t status = SUCCESS;
+    RecordStore_config_t config = {0};
 
-    // Go over all records in the data base.
-    for (i = 0; i < CGM_DB_MAX_NUM_OF_RECORDS; i++)
-    {
-        // Update the record to be 0
-        cgm_db_measRecordsArray[i].flags                = 0;
-        cgm_db_measRecordsArray[i].glucoseConcen        = 0;
-        cgm_db_measRecordsArray[i].size                 = 0;
-        cgm_db_measRecordsArray[i].status.calibTemp     = 0;
-        cgm_db_measRecordsArray[i].status.status        = 0;
-        cgm_db_measRecordsArray[i].status.warning       = 0;
-        cgm_db_measRecordsArray[i].timeOffset           = 0;
-    }
-
-    // Reset the records info variables.
-    cgm_db_recordsInfo.measDBMaxNumRecords = 0;
-    cgm_db_recordsInfo.measDBHead          = 0;
-    cgm_db_recordsInfo.measDBTail          = 0;
+#ifdef CGM_DB_NVS_INDEX
+    config.nvsIndex = CGM_DB_NVS_INDEX;
+#else
+    config.pRam     = cgm_db_ram;
+    config.ramSize  = sizeof(cgm_db_ram);
+#endif
+    config.recSize  = CGMS_MEAS_MAX_RECORD_LEN;
 
     // Update measurements Interval
     cgm_samplingInterval = samplingInterval;
 
-    return status;
+    return RecordStore_open(&cgm_db_store, &config);
 }// End of CGM_DB_initDataBase().
 
-/*********************************************************************
- * @fn      CGM_DB_isFull
- *
- * @brief   This function returns if the data base is full or not.
- *
- * @param   None.
- *
- * @return  TRUE in case of DB full, FALSE in case of DB not full.
- */
-static bStatus_t CGM_DB_isFull(void)
-{
-    return (cgm_db_recordsInfo.measDBMaxNumRecords == CGM_DB_MAX_NUM_OF_RECORDS);
-}// END of CGM_DB_isFull().
-
-/*********************************************************************
- * @fn      CGM_DB_advanceIndexes
- *
- * @brief   This function advances the head and tail of the DB array.
- *
- * @param   None.
- *
- * @return  SUCCESS or stack call status.
- */
-static bStatus_t CGM_DB_advanceIndexes(void)
-{
-    bStatus_t status = SUCCESS;
-
-    // Check if after the increment of the tail index we have reached the max number of records.
-    if (++(cgm_db_recordsInfo.measDBTail) == CGM_DB_MAX_NUM_OF_RECORDS)
-    {
-        // Wraparound.
-        cgm_db_recordsInfo.measDBTail = 0;
-        cgm_db_recordsInfo.measDBHead = 1;
-    }
-
-    // Increment the head only in case we are full.
-    if (CGM_DB_isFull())
-    {
-        if (++(cgm_db_recordsInfo.measDBHead) == CGM_DB_MAX_NUM_OF_RECORDS)
-        {
-            cgm_db_recordsInfo.measDBHead = 0;
-        }
-    }
-    // Increment the number of records in case we are not full
-    else
-    {
-        cgm_db_recordsInfo.measDBMaxNumRecords++;
-    }
-
-    return (status);
-
-}// End of CGM_DB_AdvanceIndexes().
-
 /*********************************************************************
  * @fn      CGM_DB_addMeasRecord
  *
  * @brief   This function add a measurement record to the data base.
- *
+ *          The oldest records are dropped when the data base is full.
+ *          A time offset lower than the newest one (new session or wrap
+ *          around) keeps the records in order after the previous ones.
  *
  * @param   pMeasRecord - pointer to the record's structure info.
  *
@@ -266,21 +194,14 @@ bStatus_t CGM_DB_addMeasRecord( CGMS_measRecord_t *pMeasRecord )
     {
         status = INVALIDPARAMETER;
     }
-    // Check we have enough space to insert the record in the data base.
-    // If not, We need to perform an insert in a cyclic manner.
     else
     {
-        // Insert the record in the incremented tail.
-        memcpy( cgm_db_measRecordsArray + cgm_db_recordsInfo.measDBTail, pMeasRecord, CGMS_MEAS_MAX_RECORD_LEN);
-        //cgm_DB_MeasRecordsArray[cgm_DB_RecordsInfo.measDBTail] = *pMeasRecord;
-
-        // Advance the tail and head of the DB Array.
-        // In case the DB is full both head and tail are incremented.
-        // In case the DB is not full only the tail is incremented and the max
-        // number of records.
-        CGM_DB_advanceIndexes();
-
-       }// End of else.
+        // Keyed by the time offset extended to 32 bits, so a new session
+        // or a wrap around keeps the history
+        status = RecordStore_append(&cgm_db_store,
+                                    RecordStore_extendKey(&cgm_db_store, pMeasRecord->timeOffset),
+                                    pMeasRecord);
+    }// End of else.
 
     return status;
 }// End of CGM_DB_AddMeasRecord().
@@ -293,47 +214,58 @@ bStatus_t CGM_DB_addMeasRecord( CGMS_measRecord_t *pMeasRecord )
  *
  * @param   timeOffset    - the time offset of the wanted record to extract.
  * @param   pMeasRecord   - pointer to the record's structure info that
- *                          would be filled.
+ *                          would be filled. Valid until the next call.
  *
  * @return  SUCCESS or stack call status
  */
 bStatus_t CGM_DB_getMeasRecord(uint16 timeOffset, CGMS_measRecord_t **pMeasRecord)
 {
-    bStatus_t status = SUCCESS;
-    // The index of the input timeOffset.
-    uint16 timeOffsetRecArrayIndex = ((timeOffset / cgm_samplingInterval) % CGM_DB_MAX_NUM_OF_RECORDS);
-    uint16 HeadOffsetNum;
-    uint16 TailOffsetNum;
-    // if database is in cyclic event
-    if(CGM_DB_isFull())
-    {
-      HeadOffsetNum = cgm_db_measRecordsArray[(cgm_db_recordsInfo.measDBHead-1) % CGM_DB_MAX_NUM_OF_RECORDS].timeOffset;
-      TailOffsetNum = cgm_db_measRecordsArray[(cgm_db_recordsInfo.measDBTail-1) % CGM_DB_MAX_NUM_OF_RECORDS].timeOffset;
-    }
-    else
-    {
-      HeadOffsetNum = cgm_db_measRecordsArray[cgm_db_recordsInfo.measDBHead].timeOffset;
-      TailOffsetNum = cgm_db_measRecordsArray[(cgm_db_recordsInfo.measDBTail-1) % CGM_DB_MAX_NUM_OF_RECORDS].timeOffset;
-    }
+    uint32 cursor = CGM_DB_findMeasRecords(timeOffset);
 
-    // Check valid input.
-    // In case the measRecordNum is NOT in between the head index and tail index record number or the array is empty,
-    // return ERROR
-
-    if ((timeOffset > TailOffsetNum) || (timeOffset < HeadOffsetNum) ||
-        (CGM_DB_getCurrentNumOfRecords() == 0) ||
-        (cgm_db_measRecordsArray[timeOffsetRecArrayIndex].timeOffset != timeOffset))
+    if (CGM_DB_readMeasRecords(&cursor, timeOffset, &cgm_db_measRecord, 1) == 0)
     {
-        status = INVALIDPARAMETER;
-    }
-    else
-    {
-        // Copy the record's info from the measurements array
-        *pMeasRecord = cgm_db_measRecordsArray + timeOffsetRecArrayIndex;
+        return INVALIDPARAMETER;
     }
 
-    return status;
+    *pMeasRecord = &cgm_db_measRecord;
+
+    return SUCCESS;
 }// End of CGM_DB_GetMeasRecord().
 
+/*********************************************************************
+ * @fn      CGM_DB_findMeasRecords
+ *
+ * @brief   This function finds the oldest record with a time offset
+ *          greater or equal than minTimeOffset, in O(log n).
+ *
+ * @param   minTimeOffset - minimum time offset.
+ *
+ * @return  cursor to pass to CGM_DB_readMeasRecords
+ */
+uint32 CGM_DB_findMeasRecords(uint16 minTimeOffset)
+{
+    return RecordStore_find(&cgm_db_store, RecordStore_matchMinKey(&cgm_db_store, minTimeOffset));
+}// End of CGM_DB_findMeasRecords().
+
+/*********************************************************************
+ * @fn      CGM_DB_readMeasRecords
+ *
+ * @brief   This function reads the next batch of measurement records,
+ *          in time offset order.
+ *
+ * @param   pCursor       - cursor from CGM_DB_findMeasRecords, updated.
+ * @param   maxTimeOffset - maximum time offset to read.
+ * @param   pMeasRecords  - array of numRecords records to fill.
+ * @param   numRecords    - maximum number of records to read.
+ *
+ * @return  number of records read, 0 at the end of the range
+ */
+uint16 CGM_DB_readMeasRecords(uint32 *pCursor, uint16 maxTimeOffset,
+                              CGMS_measRecord_t *pMeasRecords, uint16 numRecords)
+{
+    return RecordStore_read(&cgm_db_store, pCursor, RecordStore_matchMaxKey(&cgm_db_store, maxTimeOffset),
+                            pMeasRecords, NULL, numRecords);
+}// End of CGM_DB_readMeasRecords().
+
 /*********************************************************************
 *********************************************************************/
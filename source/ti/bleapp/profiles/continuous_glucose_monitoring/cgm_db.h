@@ -57,6 +57,7 @@ extern "C"
  */
 
 #include <ti/bleapp/services/continuous_glucose_monitoring/cgm_server.h>
+#include <ti/bleapp/util/record_store/record_store.h>
 
 /*********************************************************************
  * MACROS
@@ -66,17 +67,22 @@ extern "C"
  * TYPEDEFS
  */
 
-// Max Number of Records in the DB
+// The measurements are kept in the NVS region CGM_DB_NVS_INDEX when it is
+// defined (a CONFIG_NVS_* index added in SysConfig), and survive resets.
+// Otherwise they are kept in a RAM area of CGM_DB_RAM_SIZE bytes, sized to
+// always keep CGM_DB_MAX_NUM_OF_RECORDS records.
+#ifndef CGM_DB_MAX_NUM_OF_RECORDS
 #define CGM_DB_MAX_NUM_OF_RECORDS   100
+#endif
 
-// CGM Measurements Data Base Records Info
-// (This is due to the cyclic manner of the data base)
-typedef struct
-{
-  uint16               measDBMaxNumRecords;    // The current max number of records in the data base
-  uint16               measDBHead;             // The index of the minimum record - Head
-  uint16               measDBTail;             // The index of the maximum record - Tail
-} CGMS_DB_recordsInfo_entry_t;
+#ifndef CGM_DB_RAM_SIZE
+#define CGM_DB_RAM_SIZE             RECORD_STORE_RAM_SIZE(CGM_DB_MAX_NUM_OF_RECORDS, CGMS_MEAS_MAX_RECORD_LEN)
+#endif
+
+// Number of records read from the DB at a time when sending records
+#ifndef CGM_DB_READ_BATCH_SIZE
+#define CGM_DB_READ_BATCH_SIZE      4
+#endif
 
 /*********************************************************************
  * Profile Callback
@@ -90,7 +96,8 @@ typedef struct
  * @fn      CGM_DB_initDataBase
  *
  * @brief   This function initializes the CGM's measurements records
- *          data base variables and array.
+ *          data base. When the data base is kept in NVS the records
+ *          stored before a reset are kept.
  *
  * @param   samplingInterval - Current Measurements Interval.
  *
@@ -118,12 +125,40 @@ bStatus_t CGM_DB_addMeasRecord( CGMS_measRecord_t *pMeasRecord );
  *
  * @param   timeOffset    - the time offset of the wanted record to extract.
  * @param   pMeasRecord   - pointer to the record's structure info that
- *                          would be filled.
+ *                          would be filled. Valid until the next call.
  *
  * @return  SUCCESS or stack call status
  */
 bStatus_t CGM_DB_getMeasRecord(uint16 timeOffset, CGMS_measRecord_t **pMeasRecord);
 
+/*********************************************************************
+ * @fn      CGM_DB_findMeasRecords
+ *
+ * @brief   This function finds the oldest record with a time offset
+ *          greater or equal than minTimeOffset, in O(log n).
+ *
+ * @param   minTimeOffset - minimum time offset.
+ *
+ * @return  cursor to pass to CGM_DB_readMeasRecords
+ */
+uint32 CGM_DB_findMeasRecords(uint16 minTimeOffset);
+
+/*********************************************************************
+ * @fn      CGM_DB_readMeasRecords
+ *
+ * @brief   This function reads the next batch of measurement records,
+ *          in time offset order.
+ *
+ * @param   pCursor       - cursor from CGM_DB_findMeasRecords, updated.
+ * @param   maxTimeOffset - maximum time offset to read.
+ * @param   pMeasRecords  - array of numRecords records to fill.
+ * @param   numRecords    - maximum number of records to read.
+ *
+ * @return  number of records read, 0 at the end of the range
+ */
+uint16 CGM_DB_readMeasRecords(uint32 *pCursor, uint16 maxTimeOffset,
+                              CGMS_measRecord_t *pMeasRecords, uint16 numRecords);
+
 /*********************************************************************
  * @fn      CGM_DB_GetCurrentNumOfRecords
  *
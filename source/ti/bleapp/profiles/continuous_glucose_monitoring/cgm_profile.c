@@ -781,28 +781,35 @@ static void CGMP_sendCgmcpRsp( uint8 opCode, uint8 reqOpCode, uint8 rspCodeValue
  */
 static void CGMP_sendRecords( uint16 minTimeOffset, uint16 maxTimeOffset )
 {
+  CGMS_measRecord_t measRecords[CGM_DB_READ_BATCH_SIZE];
   CGMS_measRecord_t *measRecord = NULL;
   uint8 pBuf[CGMS_MEAS_MAX_RECORD_LEN] = {0};
+  uint32 cursor = 0;
+  uint16 numRecords = 0;
   uint16 i = 0;
   uint8 len = 0;
 
   // Mark RACP procedure as in progress
   cgmp_racpProc |= RACP_PROC_INPROGRESS;
 
-  // Find all CGM measurement records with corresponding time offset
-  for ( i = minTimeOffset; i <= maxTimeOffset; i++ )
+  // Find the first CGM measurement record in range, then read the
+  // records in batches
+  cursor = CGM_DB_findMeasRecords( minTimeOffset );
+  while ( ( numRecords = CGM_DB_readMeasRecords( &cursor, maxTimeOffset, measRecords,
+                                                 CGM_DB_READ_BATCH_SIZE ) ) > 0 )
   {
-    if ( cgmp_racpProc & RACP_PROC_ABORT )
+    for ( i = 0; i < numRecords; i++ )
     {
-      return;
-    }
+      if ( cgmp_racpProc & RACP_PROC_ABORT )
+      {
+        return;
+      }
 
-    // Set measurement record length to minimum length
-    len = CGMS_MEAS_MIN_RECORD_LEN;
+      measRecord = &measRecords[i];
+
+      // Set measurement record length to minimum length
+      len = CGMS_MEAS_MIN_RECORD_LEN;
 
-    // Check if the record with time offset i exist in the data base
-    if ( CGM_DB_getMeasRecord( i, &measRecord ) == SUCCESS )
-    {
       // Allocate buffer with the actual size of the CGM measurement record
       VOID memcpy( pBuf, measRecord, len );
 
@@ -74,6 +74,8 @@ static DSP_cb_t *dsp_appCB = NULL;
  */
 static void DSP_onCccUpdateCB( char *pValue );
 static void DSP_incomingDataCB( char *pValue );
+static void DSP_streamDoneCB( uint8 *pValue, uint16 len );
+static void DSP_streamClosedCB( uint16 connHandle, DSS_streamStats_t *pStats );
 
 /*********************************************************************
  * PROFILE CALLBACKS
@@ -82,7 +84,9 @@ static void DSP_incomingDataCB( char *pValue );
 static DSS_cb_t dsp_serverCB =
 {
   DSP_onCccUpdateCB,
-  DSP_incomingDataCB
+  DSP_incomingDataCB,
+  DSP_streamDoneCB,
+  DSP_streamClosedCB
 };
 
 /*********************************************************************
@@ -152,6 +156,36 @@ bStatus_t DSP_sendData( uint8 *pValue, uint16 len )
   return ( status );
 }
 
+/*********************************************************************
+ * @fn      DSP_streamData
+ *
+ * @brief   Stream data over GATT notifications, see DSS_streamData
+ *
+ * @param   pValue - pointer to data to send
+ * @param   len - length of data to send
+ *
+ * @return  SUCCESS, blePending or stack call status
+ */
+bStatus_t DSP_streamData( uint8 *pValue, uint16 len )
+{
+  return ( DSS_streamData( pValue, len ) );
+}
+
+/*********************************************************************
+ * @fn      DSP_getStreamStats
+ *
+ * @brief   Get the streaming throughput counters of a connection
+ *
+ * @param   connHandle - connection handle
+ * @param   pStats - counters output
+ *
+ * @return  SUCCESS or INVALIDPARAMETER
+ */
+bStatus_t DSP_getStreamStats( uint16 connHandle, DSS_streamStats_t *pStats )
+{
+  return ( DSS_getStreamStats( connHandle, pStats ) );
+}
+
 /*********************************************************************
  * @fn      DSP_onCccUpdateCB
  *
@@ -191,5 +225,43 @@ static void DSP_incomingDataCB( char *pValue )
   }
 }
 
+/*********************************************************************
+ * @fn      DSP_streamDoneCB
+ *
+ * @brief   Callback from Data_Stream_Server indicating a streamed buffer
+ *          is not used anymore
+ *
+ * @param   pValue - pointer to the buffer
+ * @param   len - length of the buffer
+ *
+ * @return  none
+ */
+static void DSP_streamDoneCB( uint8 *pValue, uint16 len )
+{
+  if ( dsp_appCB && dsp_appCB->pfnStreamDoneCB )
+  {
+    dsp_appCB->pfnStreamDoneCB( pValue, len );
+  }
+}
+
+/*********************************************************************
+ * @fn      DSP_streamClosedCB
+ *
+ * @brief   Callback from Data_Stream_Server with the final streaming
+ *          counters of a terminated connection
+ *
+ * @param   connHandle - connection handle
+ * @param   pStats - counters, valid during the call only
+ *
+ * @return  none
+ */
+static void DSP_streamClosedCB( uint16 connHandle, DSS_streamStats_t *pStats )
+{
+  if ( dsp_appCB && dsp_appCB->pfnStreamClosedCB )
+  {
+    dsp_appCB->pfnStreamClosedCB( connHandle, pStats );
+  }
+}
+
 /*********************************************************************
 *********************************************************************/
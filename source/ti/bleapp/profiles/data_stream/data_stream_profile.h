@@ -57,6 +57,7 @@ extern "C"
  */
 
 #include <ti/bleapp/ble_app_util/inc/bleapputil_api.h>
+#include <ti/bleapp/services/data_stream/data_stream_server.h>
 
 /*********************************************************************
  * Profile Callback
@@ -67,10 +68,18 @@ typedef void (*DSP_onCccUpdate_t)( uint16 connHandle, uint16 pValue);
 // Callback when receiving data
 typedef void (*DSP_incomingData_t)( uint16 connHandle, char *pValue, uint16 len );
 
+// Callback when a buffer passed to DSP_streamData can be reused
+typedef void (*DSP_streamDone_t)( uint8 *pValue, uint16 len );
+
+// Callback with the final streaming counters of a terminated connection
+typedef void (*DSP_streamClosed_t)( uint16 connHandle, DSS_streamStats_t *pStats );
+
 typedef struct
 {
   DSP_onCccUpdate_t   pfnOnCccUpdateCb;  // Called when client characteristic configuration has been updated
   DSP_incomingData_t  pfnIncomingDataCB;     // Called when receiving data
+  DSP_streamDone_t    pfnStreamDoneCB;   // Called when a streamed buffer can be reused
+  DSP_streamClosed_t  pfnStreamClosedCB; // Called when a streaming connection terminates
 } DSP_cb_t;
 
 /*********************************************************************
@@ -100,6 +109,38 @@ bStatus_t DSP_start( DSP_cb_t *appCallbacks);
  */
 bStatus_t DSP_sendData( uint8 *pValue, uint16 len );
 
+/*
+ * @fn      DSP_streamData
+ *
+ * @brief   Stream data. Unlike DSP_sendData nothing is dropped when the
+ *          stack runs out of buffers: the data is queued for each
+ *          connection and sent as the controller frees buffers.
+ *          The buffer is not copied and must stay valid until
+ *          pfnStreamDoneCB is called for it.
+ *
+ * @param   pValue - pointer to data to send
+ * @param   len - length of data to send
+ *
+ * @return  SUCCESS - sent, the buffer can be reused right away
+ *          blePending - queued, wait for pfnStreamDoneCB
+ *          bleNoResources - queue full, try again after pfnStreamDoneCB
+ */
+bStatus_t DSP_streamData( uint8 *pValue, uint16 len );
+
+/*
+ * @fn      DSP_getStreamStats
+ *
+ * @brief   Get the streaming throughput counters of a connection.
+ *          The counters of a terminated connection are passed to
+ *          pfnStreamClosedCB instead.
+ *
+ * @param   connHandle - connection handle
+ * @param   pStats - counters output
+ *
+ * @return  SUCCESS or INVALIDPARAMETER
+ */
+bStatus_t DSP_getStreamStats( uint16 connHandle, DSS_streamStats_t *pStats );
+
 /*********************************************************************
 *********************************************************************/
 
@@ -53,6 +53,11 @@
 /* This Header file contains all BLE API and icall structure definition */
 #include "icall_ble_api.h"
 
+#ifdef GL_DB_NVS_INDEX
+#include "ti_drivers_config.h"
+#endif
+
+#include <ti/bleapp/util/record_store/record_store.h>
 #include <ti/bleapp/profiles/glucose/glucose_db.h>
 
 /*********************************************************************
@@ -67,11 +72,16 @@
  * LOCAL VARIABLES
  */
 
-// GL Measurements Data Base Array Of All Records
-static GLS_measRecord_t               gl_db_measRecordsArray[GL_DB_MAX_NUM_OF_RECORDS];
+// GL Measurements Data Base, keyed by sequence number
+static RecordStore_t                  gl_db_store;
+
+#ifndef GL_DB_NVS_INDEX
+// GL Measurements Data Base Storage when no NVS region is assigned
+static uint8                          gl_db_ram[GL_DB_RAM_SIZE];
+#endif
 
-// gl Current Number Of Measurements
-static GLS_DB_recordsInfo_entry_t     gl_db_recordsInfo;
+// Record returned by GL_DB_getMeasRecord
+static GLS_measRecord_t               gl_db_measRecord;
 
 /*********************************************************************
  * GLOBAL VARIABLES
@@ -90,56 +100,26 @@ static GLS_DB_recordsInfo_entry_t     gl_db_recordsInfo;
  * @fn      GL_DB_initDataBase
  *
  * @brief   This function initializes the gl's measurements records
- *          data base variables and array.
+ *          data base. When the data base is kept in NVS the records
+ *          stored before a reset are kept.
  *
- * @param   samplingInterval - Current Measurements Interval.
+ * @param   None.
  *
  * @return  SUCCESS or stack call status
  */
 bStatus_t GL_DB_initDataBase(void)
 {
-    uint32 i = 0;
-    bStatus_t status = SUCCESS;
-
-    // Go over all records in the data base.
-    for (i = 0; i < GL_DB_MAX_NUM_OF_RECORDS; i++)
-    {
-        // Update the record to be 0
-        gl_db_measRecordsArray[i].flags                               = 0;
-        gl_db_measRecordsArray[i].SequenceNum                         = 0;
-        gl_db_measRecordsArray[i].timeBase.year                       = 0;
-        gl_db_measRecordsArray[i].timeBase.month                      = 0;
-        gl_db_measRecordsArray[i].timeBase.day                        = 0;
-        gl_db_measRecordsArray[i].timeBase.hours                      = 0;
-        gl_db_measRecordsArray[i].timeBase.minutes                    = 0;
-        gl_db_measRecordsArray[i].timeBase.seconds                    = 0;
-        gl_db_measRecordsArray[i].TimeOffset                          = 0;
-        gl_db_measRecordsArray[i].glucoseConcen                       = 0;
-        gl_db_measRecordsArray[i].Type_SampleLocation.SampleLocation  = 0;
-        gl_db_measRecordsArray[i].Type_SampleLocation.Type            = 0;
-        gl_db_measRecordsArray[i].SensorStatus                        = 0;
-    }
-
-    // Reset the records info variables.
-    gl_db_recordsInfo.measDBMaxNumRecords = 0;
-    gl_db_recordsInfo.measDBHead          = 0;
-    gl_db_recordsInfo.measDBTail          = 0;
+    RecordStore_config_t config = {0};
 
-    return status;
-}
+#ifdef GL_DB_NVS_INDEX
+    config.nvsIndex = GL_DB_NVS_INDEX;
+#else
+    config.pRam     = gl_db_ram;
+    config.ramSize  = sizeof(gl_db_ram);
+#endif
+    config.recSize  = GLS_MEAS_MAX_RECORD_LEN;
 
-/*********************************************************************
- * @fn      GL_DB_isFull
- *
- * @brief   This function returns if the data base is full or not.
- *
- * @param   None.
- *
- * @return  TRUE in case of DB full, FALSE in case of DB not full.
- */
-static bStatus_t GL_DB_isFull(void)
-{
-    return (gl_db_recordsInfo.measDBMaxNumRecords == GL_DB_MAX_NUM_OF_RECORDS);
+    return RecordStore_open(&gl_db_store, &config);
 }
 
 /*********************************************************************
@@ -154,7 +134,7 @@ static bStatus_t GL_DB_isFull(void)
  */
 uint16 GL_DB_getCurrentNumOfRecords(void)
 {
-    return gl_db_recordsInfo.measDBMaxNumRecords;
+    return (uint16)RecordStore_count(&gl_db_store);
 }// End of GL_DB_getCurrentNumOfRecords().
 
 /*********************************************************************
@@ -163,75 +143,23 @@ uint16 GL_DB_getCurrentNumOfRecords(void)
  * @brief   This function gets the number of measurements records
  *          in the data base that greater or equal than the sequence number.
  *
- * @param   None.
+ * @param   SequenceNum - minimum sequence number.
  *
  * @return  GL_DB_NumOfRecords ValueGREATER
  */
 
 uint16 GL_DB_getNumOfRecordsGreaterOrEqual( uint16 SequenceNum)
 {
-    uint16 numOfRecords = 0;
-    uint16 HeadSequenceNum = 0;
-    uint16 TailSequenceNum = 0;
-
-    HeadSequenceNum = GL_DB_getFirstSequenceNum();
-    TailSequenceNum = GL_DB_getLastSequenceNum();
-
-    // Check valid input.
-    // In case the measRecordNum is NOT in between the head index and tail index record number or the array is empty,
-    // return ERROR
-    if ((SequenceNum > TailSequenceNum) || (SequenceNum < HeadSequenceNum) || (GL_DB_getCurrentNumOfRecords() == 0))
-    {
-        return numOfRecords;
-    }
-    numOfRecords = TailSequenceNum - SequenceNum + 1;
-
-    return numOfRecords;
-}// End of GL_DB_getCurrentNumOfRecords().
-
-/*********************************************************************
- * @fn      GL_DB_advanceIndexes
- *
- * @brief   This function advances the head and tail of the DB array.
- *
- * @param   None.
- *
- * @return  SUCCESS or stack call status.
- */
-static bStatus_t GL_DB_advanceIndexes(void)
-{
-    bStatus_t status = SUCCESS;
-
-    // Check if after the increment of the tail index we have reached the max number of records.
-    if (++(gl_db_recordsInfo.measDBTail) == GL_DB_MAX_NUM_OF_RECORDS)
-    {
-        // Wraparound.
-        gl_db_recordsInfo.measDBTail = 0;
-    }
-
-    // Increment the head only in case we are full.
-    if (GL_DB_isFull())
-    {
-        if (++(gl_db_recordsInfo.measDBHead) == GL_DB_MAX_NUM_OF_RECORDS)
-        {
-            gl_db_recordsInfo.measDBHead = 0;
-        }
-    }
-    // Increment the number of records in case we are not full
-    else
-    {
-        gl_db_recordsInfo.measDBMaxNumRecords++;
-    }
-
-    return (status);
-
-}// End of GL_DB_AdvanceIndexes().
+    return (uint16)RecordStore_countFrom(&gl_db_store, RecordStore_matchMinKey(&gl_db_store, SequenceNum));
+}// End of GL_DB_getNumOfRecordsGreaterOrEqual().
 
 /*********************************************************************
  * @fn      GL_DB_addMeasRecord
  *
  * @brief   This function add a measurement record to the data base.
- *
+ *          The oldest records are dropped when the data base is full.
+ *          A sequence number lower than the newest one is taken as a
+ *          wrap around and keeps the records in order after it.
  *
  * @param   pMeasRecord - pointer to the record's structure info.
  *
@@ -246,21 +174,14 @@ bStatus_t GL_DB_addMeasRecord( GLS_measRecord_t *pMeasRecord )
     {
         status = INVALIDPARAMETER;
     }
-    // Check we have enough space to insert the record in the data base.
-    // If not, We need to perform an insert in a cyclic manner.
     else
     {
-        // Insert the record in the incremented tail.
-        memcpy( gl_db_measRecordsArray + gl_db_recordsInfo.measDBTail, pMeasRecord, GLS_MEAS_MAX_RECORD_LEN);
-        //GL_DB_MeasRecordsArray[GL_DB_RecordsInfo.measDBTail] = *pMeasRecord;
-
-        // Advance the tail and head of the DB Array.
-        // In case the DB is full both head and tail are incremented.
-        // In case the DB is not full only the tail is incremented and the max
-        // number of records.
-        GL_DB_advanceIndexes();
-
-     }// End of else.
+        // Keyed by the sequence number extended to 32 bits, so a wrap
+        // around keeps the history
+        status = RecordStore_append(&gl_db_store,
+                                    RecordStore_extendKey(&gl_db_store, pMeasRecord->SequenceNum),
+                                    pMeasRecord);
+    }// End of else.
 
     return status;
 }// End of GL_DB_AddMeasRecord().
@@ -271,41 +192,60 @@ bStatus_t GL_DB_addMeasRecord( GLS_measRecord_t *pMeasRecord )
  * @brief   This function gets a measurement record (single) from the data base.
  *          Notice that the records number needs to be in the current records range.
  *
- * @param   SequenceNum    - the time offset of the wanted record to extract.
+ * @param   SequenceNum    - the sequence number of the wanted record to extract.
  * @param   pMeasRecord   - pointer to the record's structure info that
- *                          would be filled.
+ *                          would be filled. Valid until the next call.
  *
  * @return  SUCCESS or stack call status
  */
 bStatus_t GL_DB_getMeasRecord(uint16 SequenceNum, GLS_measRecord_t **pMeasRecord)
 {
-    bStatus_t status = SUCCESS;
-    uint16 SequenceIndex;
-    uint16 HeadSequenceNum;
-    uint16 TailSequenceNum;
-
-    HeadSequenceNum = GL_DB_getFirstSequenceNum();
-    TailSequenceNum = GL_DB_getLastSequenceNum();
+    uint32 cursor = GL_DB_findMeasRecords(SequenceNum);
 
-    // Check valid input.
-    // In case the measRecordNum is NOT in between the head index and tail index record number or the array is empty,
-    // return ERROR
-    if ((SequenceNum > TailSequenceNum) || (SequenceNum < HeadSequenceNum) || (GL_DB_getCurrentNumOfRecords() == 0))
+    if (GL_DB_readMeasRecords(&cursor, SequenceNum, &gl_db_measRecord, 1) == 0)
     {
-        status = INVALIDPARAMETER;
-    }
-    else
-    {
-      status = SUCCESS;
-      //difference between head and sequenceNum
-      SequenceIndex = (gl_db_recordsInfo.measDBHead + (SequenceNum - gl_db_measRecordsArray[gl_db_recordsInfo.measDBHead].SequenceNum)) % GL_DB_MAX_NUM_OF_RECORDS;
-      // Copy the record's info from the measurements array
-      *pMeasRecord = gl_db_measRecordsArray + SequenceIndex;
+        return INVALIDPARAMETER;
     }
 
-    return status;
+    *pMeasRecord = &gl_db_measRecord;
+
+    return SUCCESS;
 }// End of GL_DB_GetMeasRecord().
 
+/*********************************************************************
+ * @fn      GL_DB_findMeasRecords
+ *
+ * @brief   This function finds the oldest record with a sequence number
+ *          greater or equal than minSequenceNum, in O(log n).
+ *
+ * @param   minSequenceNum - minimum sequence number.
+ *
+ * @return  cursor to pass to GL_DB_readMeasRecords
+ */
+uint32 GL_DB_findMeasRecords(uint16 minSequenceNum)
+{
+    return RecordStore_find(&gl_db_store, RecordStore_matchMinKey(&gl_db_store, minSequenceNum));
+}// End of GL_DB_findMeasRecords().
+
+/*********************************************************************
+ * @fn      GL_DB_readMeasRecords
+ *
+ * @brief   This function reads the next batch of measurement records,
+ *          in sequence number order.
+ *
+ * @param   pCursor        - cursor from GL_DB_findMeasRecords, updated.
+ * @param   maxSequenceNum - maximum sequence number to read.
+ * @param   pMeasRecords   - array of numRecords records to fill.
+ * @param   numRecords     - maximum number of records to read.
+ *
+ * @return  number of records read, 0 at the end of the range
+ */
+uint16 GL_DB_readMeasRecords(uint32 *pCursor, uint16 maxSequenceNum,
+                             GLS_measRecord_t *pMeasRecords, uint16 numRecords)
+{
+    return RecordStore_read(&gl_db_store, pCursor, RecordStore_matchMaxKey(&gl_db_store, maxSequenceNum),
+                            pMeasRecords, NULL, numRecords);
+}// End of GL_DB_readMeasRecords().
 
 /*********************************************************************
  * @fn      GL_DB_getLastSequenceNum
@@ -319,22 +259,8 @@ bStatus_t GL_DB_getMeasRecord(uint16 SequenceNum, GLS_measRecord_t **pMeasRecord
 
 uint16 GL_DB_getLastSequenceNum()
 {
-    uint16 seqNum = 0;
-
-    if ( (GL_DB_isFull()) && (gl_db_recordsInfo.measDBTail == 0))
-    {
-        seqNum = gl_db_measRecordsArray[GL_DB_MAX_NUM_OF_RECORDS-1].SequenceNum;
-    }
-    else if (gl_db_recordsInfo.measDBTail == 0)
-    {
-        seqNum = gl_db_measRecordsArray[(gl_db_recordsInfo.measDBTail)].SequenceNum;
-    }
-    else
-    {
-        seqNum = gl_db_measRecordsArray[(gl_db_recordsInfo.measDBTail-1)].SequenceNum;
-    }
-    return seqNum;
-}// End of GL_DB_getCurrentNumOfRecords().
+    return (uint16)RecordStore_lastKey(&gl_db_store);
+}// End of GL_DB_getLastSequenceNum().
 
 /*********************************************************************
  * @fn      GL_DB_getFirstSequenceNum
@@ -348,8 +274,8 @@ uint16 GL_DB_getLastSequenceNum()
 
 uint16 GL_DB_getFirstSequenceNum()
 {
-  return gl_db_measRecordsArray[(gl_db_recordsInfo.measDBHead)].SequenceNum;
-}// End of GL_DB_getCurrentNumOfRecords().
+    return (uint16)RecordStore_firstKey(&gl_db_store);
+}// End of GL_DB_getFirstSequenceNum().
 
 
 /*********************************************************************
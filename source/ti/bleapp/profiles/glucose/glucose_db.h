@@ -53,6 +53,7 @@
  */
 
 #include <ti/bleapp/services/glucose/glucose_server.h>
+#include <ti/bleapp/util/record_store/record_store.h>
 
 /*********************************************************************
  * MACROS
@@ -62,17 +63,22 @@
  * TYPEDEFS
  */
 
-// Max Number of Records in the DB
+// The measurements are kept in the NVS region GL_DB_NVS_INDEX when it is
+// defined (a CONFIG_NVS_* index added in SysConfig), and survive resets.
+// Otherwise they are kept in a RAM area of GL_DB_RAM_SIZE bytes, sized to
+// always keep GL_DB_MAX_NUM_OF_RECORDS records.
+#ifndef GL_DB_MAX_NUM_OF_RECORDS
 #define GL_DB_MAX_NUM_OF_RECORDS   210
+#endif
 
-// GL Measurements Data Base Records Info
-// (This is due to the cyclic manner of the data base)
-typedef struct
-{
-  uint16               measDBMaxNumRecords;    // The current max number of records in the data base
-  uint16               measDBHead;             // The index of the minimum record - Head
-  uint16               measDBTail;             // The index of the maximum record - Tail
-} GLS_DB_recordsInfo_entry_t;
+#ifndef GL_DB_RAM_SIZE
+#define GL_DB_RAM_SIZE             RECORD_STORE_RAM_SIZE(GL_DB_MAX_NUM_OF_RECORDS, GLS_MEAS_MAX_RECORD_LEN)
+#endif
+
+// Number of records read from the DB at a time when sending records
+#ifndef GL_DB_READ_BATCH_SIZE
+#define GL_DB_READ_BATCH_SIZE      4
+#endif
 
 /*********************************************************************
  * Profile Callback
@@ -86,9 +92,10 @@ typedef struct
  * @fn      GL_DB_initDataBase
  *
  * @brief   This function initializes the GL's measurements records
- *          data base variables and array.
+ *          data base. When the data base is kept in NVS the records
+ *          stored before a reset are kept.
  *
- * @param   samplingInterval - Current Measurements Interval.
+ * @param   None.
  *
  * @return  SUCCESS or stack call status
  */
@@ -112,13 +119,41 @@ bStatus_t GL_DB_addMeasRecord( GLS_measRecord_t *pMeasRecord );
  * @brief   This function gets a measurement record (single) from the data base.
  *          Notice that the records number needs to be in the current records range.
  *
- * @param   timeOffset    - the time offset of the wanted record to extract.
+ * @param   SequenceNum   - the sequence number of the wanted record to extract.
  * @param   pMeasRecord   - pointer to the record's structure info that
- *                          would be filled.
+ *                          would be filled. Valid until the next call.
  *
  * @return  SUCCESS or stack call status
  */
-bStatus_t GL_DB_getMeasRecord(uint16 timeOffset, GLS_measRecord_t **pMeasRecord);
+bStatus_t GL_DB_getMeasRecord(uint16 SequenceNum, GLS_measRecord_t **pMeasRecord);
+
+/*********************************************************************
+ * @fn      GL_DB_findMeasRecords
+ *
+ * @brief   This function finds the oldest record with a sequence number
+ *          greater or equal than minSequenceNum, in O(log n).
+ *
+ * @param   minSequenceNum - minimum sequence number.
+ *
+ * @return  cursor to pass to GL_DB_readMeasRecords
+ */
+uint32 GL_DB_findMeasRecords(uint16 minSequenceNum);
+
+/*********************************************************************
+ * @fn      GL_DB_readMeasRecords
+ *
+ * @brief   This function reads the next batch of measurement records,
+ *          in sequence number order.
+ *
+ * @param   pCursor        - cursor from GL_DB_findMeasRecords, updated.
+ * @param   maxSequenceNum - maximum sequence number to read.
+ * @param   pMeasRecords   - array of numRecords records to fill.
+ * @param   numRecords     - maximum number of records to read.
+ *
+ * @return  number of records read, 0 at the end of the range
+ */
+uint16 GL_DB_readMeasRecords(uint32 *pCursor, uint16 maxSequenceNum,
+                             GLS_measRecord_t *pMeasRecords, uint16 numRecords);
 
 /*********************************************************************
  * @fn      GL_DB_GetCurrentNumOfRecords
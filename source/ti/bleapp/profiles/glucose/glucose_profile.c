@@ -169,6 +169,12 @@ bStatus_t GLP_start( GLP_cb_t *appCallbacks, uint16 feat, GLP_timeBase* gl_timeb
 
   // Init GL DB
   status |= GL_DB_initDataBase();
+
+  // Continue after the records kept from before a reset
+  if ( GL_DB_getCurrentNumOfRecords() > 0 )
+  {
+    glp_seqNum = GL_DB_getLastSequenceNum() + 1;
+  }
   // Return status value
   return ( status );
 }
@@ -588,23 +594,27 @@ static void GLP_sendRacpRsp( uint8 opCode, uint8 operator, uint8 reqOpCode,
  */
 static void GLP_sendRecords( uint16 minSequenceNum, uint16 maxSequenceNum )
 {
-  GLS_measRecord_t *measRecord = NULL;
+  GLS_measRecord_t measRecords[GL_DB_READ_BATCH_SIZE];
+  uint32 cursor = 0;
+  uint16 numRecords = 0;
   uint16 i = 0;
 
   // Mark RACP procedure as in progress
   glp_racpProc |= RACP_PROC_INPROGRESS;
 
-  // Find all GLC measurement records with corresponding time offset
-  for ( i = minSequenceNum; i <= maxSequenceNum; i++ )
+  // Find the first GLC measurement record in range, then read the
+  // records in batches
+  cursor = GL_DB_findMeasRecords( minSequenceNum );
+  while ( ( numRecords = GL_DB_readMeasRecords( &cursor, maxSequenceNum, measRecords,
+                                                GL_DB_READ_BATCH_SIZE ) ) > 0 )
   {
-    if ( glp_racpProc & RACP_PROC_ABORT )
+    for ( i = 0; i < numRecords; i++ )
     {
-      return;
-    }
-    // Check if the record with sequence number i exist in the data base
-    if ( GL_DB_getMeasRecord( i, &measRecord ) == SUCCESS )
-    {
-      GLP_SendMeasRecord(measRecord);
+      if ( glp_racpProc & RACP_PROC_ABORT )
+      {
+        return;
+      }
+      GLP_SendMeasRecord( &measRecords[i] );
     }
   }
 }
@@ -165,6 +165,16 @@ typedef enum
 
     OAD_REQ_ERASE_BONDS       = 0x13, //Erase bonds - This command is used to erase all BLE bonding info
                                            //on the device.
+
+    OAD_REQ_ENABLE_WINDOW     = 0x14, //Enable window - This command is used by a peer, before start OAD,
+                                      //to send blocks without waiting for a request per block.
+                                      //The target responds with its receive window.
+
+    OAD_RSP_BLK_WINDOW_NOTIF  = 0x15, //Send block window - This command is used to tell the peer which
+                                      //blocks it may send, and which blocks of the window are missing.
+
+    OAD_REQ_SET_IMG_FORMAT    = 0x16, //Set image format - This command is used by a peer, before start OAD,
+                                      //to send the image as a compressed or delta stream.
     OAD_RSP_CMD_NOT_SUPPORTED = 0xFF, //Error code returned when an external control command is received
                                                  //with an invalid opcode.
 
@@ -228,6 +238,53 @@ PACKED_TYPEDEF_STRUCT
     uint8       swVer[MCUBOOT_SW_VER_LEN]; //!< App version
 } swVersionPld_t;
 
+/*!
+ * Payload of a @ref OAD_REQ_SET_IMG_FORMAT command
+ */
+// Temporary workaround needed due to a collision on the __packed definition.
+#ifdef __IAR_SYSTEMS_ICC__
+typedef struct __attribute__((__packed__))
+#else
+PACKED_TYPEDEF_STRUCT
+#endif
+{
+    uint8       cmdID;            //!< Ext Ctrl Op-code
+    uint8       format;           //!< swUpdateImgFormat_e
+    uint32      streamLen;        //!< Length of the stream sent as blocks
+} imgFormatReqPld_t;
+
+/*!
+ * Response to a @ref OAD_REQ_ENABLE_WINDOW command
+ */
+// Temporary workaround needed due to a collision on the __packed definition.
+#ifdef __IAR_SYSTEMS_ICC__
+typedef struct __attribute__((__packed__))
+#else
+PACKED_TYPEDEF_STRUCT
+#endif
+{
+    uint8       cmdID;            //!< Ext Ctrl Op-code
+    uint8       status;           //!< Status of command
+    uint8       windowSize;       //!< Receive window in blocks
+} windowRspPld_t;
+
+/*!
+ * Block window payload, the peer may send the blocks of the window
+ * which are not marked as received in the bitmap
+ */
+// Temporary workaround needed due to a collision on the __packed definition.
+#ifdef __IAR_SYSTEMS_ICC__
+typedef struct __attribute__((__packed__))
+#else
+PACKED_TYPEDEF_STRUCT
+#endif
+{
+    uint8              cmdID;            //!< External control op-code
+    uint8              prevBlkStat;      //!< Status of previous block write
+    uint32             windowStart;      //!< First block not received
+    uint32             rcvdBitmap;       //!< Bit n set if block windowStart + n was received
+} blockWindowPld_t;
+
 /*!
  * This struct contains all the global information that the module needs
  */
@@ -245,6 +302,13 @@ typedef struct
     uint8               blkReqActive;     //!< flag whether to send the peer an update after each block
     uint8               imgIDRetries;     //!< Number of retries allowed on image identify
     uint32              stateTimeout;     //!< After inactivity time oad process will reset
+    uint8               windowSize;       //!< Receive window in blocks, 0 if blocks must come in order
+    uint32              windowStart;      //!< First block not received in windowed mode
+    uint32              windowSent;       //!< Window start last sent to the peer
+    uint32              stageAddr;        //!< Image offset of the first page in the staging buffer
+    uint8*              pStage;           //!< Staging buffer, whole pages are written to flash
+    uint8*              pBlkMap;          //!< Bitmap of the received blocks
+    uint8               imgFormat;        //!< swUpdateImgFormat_e of the blocks
 } oadModuleGlobalData_t;
 
 /*********************************************************************
@@ -297,6 +361,19 @@ typedef struct
  */
 #define OAD_DEFAULT_BLOCK_SIZE          240
 
+/*!
+ * Maximum OAD receive window in blocks, limited by the window bitmap
+ */
+#define OAD_WINDOW_MAX_BLOCKS           32
+
+/*!
+ * Number of flash pages staged in RAM in windowed mode. The window is
+ * sized so that every block of the window fits in the staging buffer.
+ */
+#ifndef OAD_WINDOW_STAGE_PAGES
+#define OAD_WINDOW_STAGE_PAGES          2
+#endif
+
 /*!
  * The following 2 definitions are for this function: HCI_LE_WriteSuggestedDefaultDataLenCmd
  * the explanation of them is indicated near the use of the function
@@ -346,10 +423,16 @@ static OADProfile_Status_e oadSendGenericExtCtrlRsp(uint8 cmdID ,uint8 stat);
 static OADProfile_Status_e oadSendBlockSizeRsp(oadProtocolOPCode_e cmdID ,uint16 oadBlkSz);
 static OADProfile_Status_e oadSendNextBlockReq(uint32 blkNum, uint8 status);
 static OADProfile_Status_e oadSendswVersionRsp();
+static OADProfile_Status_e oadSendWindowReq(uint8 stat);
 
 static void oadResetState(void);
 static OADProfile_Status_e oadImgIdentifyWrite(uint16 len, uint8 *pValue);
 static OADProfile_Status_e oadImgBlockWrite(uint8 len, uint8 *pValue);
+static OADProfile_Status_e oadImgBlockWriteWindow(uint32 blkNum, uint8 len, uint8 *pValue);
+static OADProfile_Status_e oadEnableWindow(void);
+static OADProfile_Status_e oadSetImageFormat(uint16 len, uint8 *pValue);
+static void oadSetTotalBlocks(void);
+static void oadFreeWindow(void);
 
 static void oadChangeMachineState(oadState_e next_state);
 static OADProfile_Status_e oadSetGlobalActiveConnHandle(uint16 connhandle);
@@ -412,6 +495,10 @@ bStatus_t OADProfile_start(OADProfile_AppCallback_t pOADAppCB)
     pOADModuleGlobalData->blkReqActive     = true;
     pOADModuleGlobalData->imgIDRetries     = OAD_IMG_ID_RETRIES;
     pOADModuleGlobalData->stateTimeout     = OAD_DEFAULT_INACTIVITY_TIME;
+    pOADModuleGlobalData->windowSize       = 0;
+    pOADModuleGlobalData->imgFormat        = SW_UPDATE_IMG_FORMAT_RAW;
+    pOADModuleGlobalData->pStage           = NULL;
+    pOADModuleGlobalData->pBlkMap          = NULL;
 
     /*
      * The following API call belongs to the previous implementation, it may not be needed anymore
@@ -527,6 +614,16 @@ void oadInvokeFromFWContextOAD(char *pData)
                     oadSendswVersionRsp();
                     break;
                 }
+                case OAD_REQ_ENABLE_WINDOW:
+                {
+                    oadEnableWindow();
+                    break;
+                }
+                case OAD_REQ_SET_IMG_FORMAT:
+                {
+                    oadSetImageFormat(pOADSrvWriteReq.len, pOADSrvWriteReq.pData);
+                    break;
+                }
                 case OAD_REQ_ERASE_BONDS:
                 {
                     // Control commands for erasing bonds
@@ -714,7 +811,14 @@ static OADProfile_Status_e oadEventHandleStateConfig(oadEvent_e event, uint16 da
             {
                 oadChangeMachineState(OAD_DOWNLOAD);
                 // Send the first block request to kick off the OAD
-                status = oadSendNextBlockReq(pOADModuleGlobalData->currentBlkNum, OAD_PROFILE_SUCCESS);
+                if(0 != pOADModuleGlobalData->windowSize)
+                {
+                    status = oadSendWindowReq(OAD_PROFILE_SUCCESS);
+                }
+                else
+                {
+                    status = oadSendNextBlockReq(pOADModuleGlobalData->currentBlkNum, OAD_PROFILE_SUCCESS);
+                }
             }
             break;
         }
@@ -766,6 +870,14 @@ static OADProfile_Status_e oadEventHandleStateDownload(oadEvent_e event, uint16
         case OAD_EVT_BLOCK_REQ:
         {
             status = oadImgBlockWrite(dataLen,pData);
+#ifdef SW_UPDATE_STREAM_VERIFY
+            // The digest was computed as the blocks were written, so the
+            // image is checked as soon as the last block is in
+            if((OAD_PROFILE_DL_COMPLETE == status) && (SUCCESS != SwUpdate_VerifyImage()))
+            {
+                status = OAD_PROFILE_VALIDATION_ERR;
+            }
+#endif
             if(OAD_PROFILE_SUCCESS == status)
             {
                 // If the block write was successful but the process
@@ -789,8 +901,12 @@ static OADProfile_Status_e oadEventHandleStateDownload(oadEvent_e event, uint16
                 oadResetState();
             }
 
-            // Request the next block
-            status = oadSendNextBlockReq(pOADModuleGlobalData->currentBlkNum, status);
+            // Request the next block. In windowed mode the download goes on
+            // without a request per block, oadImgBlockWrite sends the window
+            if((0 == pOADModuleGlobalData->windowSize) || (OAD_PROFILE_SUCCESS != status))
+            {
+                status = oadSendNextBlockReq(pOADModuleGlobalData->currentBlkNum, status);
+            }
             break;
         }
         case OAD_EVT_IMG_IDENTIFY_REQ:
@@ -938,6 +1054,42 @@ static OADProfile_Status_e oadSendNextBlockReq(uint32 blkNum, uint8 stat)
     return (status);
 }
 
+/*********************************************************************
+ * @fn      oadSendWindowReq
+ *
+ * @brief   Send the receive window to the peer: the first block not
+ *          received and which blocks after it were received.
+ *
+ * @param   stat - status of prev block
+ * @return  OAD_PROFILE_SUCCESS or INVALIDPARAMETER
+ */
+static OADProfile_Status_e oadSendWindowReq(uint8 stat)
+{
+    OADProfile_Status_e status = OAD_PROFILE_SUCCESS;
+
+    if(pOADModuleGlobalData->blkReqActive)
+    {
+        blockWindowPld_t rsp = {OAD_RSP_BLK_WINDOW_NOTIF, stat, pOADModuleGlobalData->windowStart, 0};
+        uint32 blkNum;
+        uint8 i;
+
+        for(i = 0; i < pOADModuleGlobalData->windowSize; i++)
+        {
+            blkNum = pOADModuleGlobalData->windowStart + i;
+            if((blkNum < pOADModuleGlobalData->totalBlocks) &&
+               (pOADModuleGlobalData->pBlkMap[blkNum >> 3] & BV(blkNum & 7)))
+            {
+                rsp.rcvdBitmap |= (1UL << i);
+            }
+        }
+
+        status = (OADProfile_Status_e)OADService_setParameter(OAD_SRV_CTRL_CMD,sizeof(blockWindowPld_t),(void *)&rsp);
+    }
+    pOADModuleGlobalData->windowSent = pOADModuleGlobalData->windowStart;
+
+    return (status);
+}
+
 /*********************************************************************
  * @fn      oadSendswVersionRsp
  *
@@ -1005,6 +1157,8 @@ static OADProfile_Status_e oadSendswVersionRsp()
     pOADModuleGlobalData->blkReqActive     = true;
     pOADModuleGlobalData->imgIDRetries     = OAD_IMG_ID_RETRIES;
     pOADModuleGlobalData->stateTimeout     = OAD_DEFAULT_INACTIVITY_TIME;
+    pOADModuleGlobalData->imgFormat        = SW_UPDATE_IMG_FORMAT_RAW;
+    oadFreeWindow();
 
     SwUpdate_Close();
     // Stop the inactivity timer if running
@@ -1046,22 +1200,14 @@ static OADProfile_Status_e oadImgIdentifyWrite(uint16 len, uint8 *pValue)
     }
     else
     {
+        // A new header sets the blocks back to the raw image
         pOADModuleGlobalData->candidateImgLen = swUpdateStatus;
+        pOADModuleGlobalData->imgFormat = SW_UPDATE_IMG_FORMAT_RAW;
     }
     // If image ID is accepted, set variables
     if(OAD_PROFILE_SUCCESS == status)
     {
-        // Calculate total number of OAD blocks, round up if needed
-        pOADModuleGlobalData->totalBlocks = (pOADModuleGlobalData->candidateImgLen) /
-                                            (pOADModuleGlobalData->imgBytesPerBlock);
-
-        // If there is a remainder after division, store it and round up
-        pOADModuleGlobalData->lastBlockSize = (pOADModuleGlobalData->candidateImgLen) %
-                                              (pOADModuleGlobalData->imgBytesPerBlock);
-        if( 0 != (pOADModuleGlobalData->lastBlockSize))
-        {
-            pOADModuleGlobalData->totalBlocks += 1;
-        }
+        oadSetTotalBlocks();
         // Image has been accepted, start the inactivity timer
         Util_startClock(&oadActivityClk);
     }
@@ -1069,6 +1215,28 @@ static OADProfile_Status_e oadImgIdentifyWrite(uint16 len, uint8 *pValue)
     return (status);
 }
 
+/*********************************************************************
+ * @fn      oadSetTotalBlocks
+ *
+ * @brief   Calculate the number of blocks of the candidate image
+ *
+ * @return  none
+ */
+static void oadSetTotalBlocks(void)
+{
+    // Calculate total number of OAD blocks, round up if needed
+    pOADModuleGlobalData->totalBlocks = (pOADModuleGlobalData->candidateImgLen) /
+                                        (pOADModuleGlobalData->imgBytesPerBlock);
+
+    // If there is a remainder after division, store it and round up
+    pOADModuleGlobalData->lastBlockSize = (pOADModuleGlobalData->candidateImgLen) %
+                                          (pOADModuleGlobalData->imgBytesPerBlock);
+    if( 0 != (pOADModuleGlobalData->lastBlockSize))
+    {
+        pOADModuleGlobalData->totalBlocks += 1;
+    }
+}
+
 /*********************************************************************
  * @fn      oadImgBlockWrite
  *
@@ -1111,8 +1279,14 @@ static OADProfile_Status_e oadImgBlockWrite(uint8 len, uint8 *pValue)
         expectedBlkSz = pOADModuleGlobalData->blkSize;
     }
 
+    // In windowed mode the blocks of the window may come in any order
+    if ((0 != pOADModuleGlobalData->windowSize) &&
+        (blkNum < pOADModuleGlobalData->totalBlocks) && (len == expectedBlkSz))
+    {
+        status = oadImgBlockWriteWindow(blkNum, (len - OAD_BLK_NUM_HDR_SZ), (pValue + OAD_BLK_NUM_HDR_SZ));
+    }
     // Check that this is the expected block number, and the block size is right
-    if ((pOADModuleGlobalData->currentBlkNum == blkNum) && (len == expectedBlkSz))
+    else if ((pOADModuleGlobalData->currentBlkNum == blkNum) && (len == expectedBlkSz))
     {
         // Calculate address to write as (start of OAD range) + (offset into range)
         uint32 blkStartAddr = (pOADModuleGlobalData->imgBytesPerBlock)*blkNum;
@@ -1137,6 +1311,231 @@ static OADProfile_Status_e oadImgBlockWrite(uint8 len, uint8 *pValue)
     return (status);
 }
 
+/*********************************************************************
+ * @fn      oadImgBlockWriteWindow
+ *
+ * @brief   Process an Image Block Write in windowed mode. The block is
+ *          copied to the staging buffer, and each page is written to
+ *          flash once all of its blocks were received.
+ *
+ * @param   blkNum - block number
+ * @param   len    - length of pValue, without the block number
+ * @param   pValue - pointer to the block data
+ *
+ * @return  OAD_PROFILE_SUCCESS, OAD_PROFILE_DL_COMPLETE or
+ *          OAD_PROFILE_FLASH_ERR
+ */
+static OADProfile_Status_e oadImgBlockWriteWindow(uint32 blkNum, uint8 len, uint8 *pValue)
+{
+    uint16 pageSize = SwUpdate_GetPageSize();
+    uint32 stageLen = (uint32)pageSize * OAD_WINDOW_STAGE_PAGES;
+    uint32 blkStartAddr = (pOADModuleGlobalData->imgBytesPerBlock) * blkNum;
+    uint32 rcvdEnd;
+
+    // A block received twice or outside of the staging buffer is dropped,
+    // send the window again so that the peer catches up
+    if ((pOADModuleGlobalData->pBlkMap[blkNum >> 3] & BV(blkNum & 7)) ||
+        (blkStartAddr < pOADModuleGlobalData->stageAddr) ||
+        (blkStartAddr + len > pOADModuleGlobalData->stageAddr + stageLen))
+    {
+        oadSendWindowReq(OAD_PROFILE_SUCCESS);
+        return (OAD_PROFILE_SUCCESS);
+    }
+
+    memcpy(pOADModuleGlobalData->pStage + (blkStartAddr - pOADModuleGlobalData->stageAddr), pValue, len);
+    pOADModuleGlobalData->pBlkMap[blkNum >> 3] |= BV(blkNum & 7);
+
+    // Move the window start over the received blocks
+    while ((pOADModuleGlobalData->windowStart < pOADModuleGlobalData->totalBlocks) &&
+           (pOADModuleGlobalData->pBlkMap[pOADModuleGlobalData->windowStart >> 3] &
+            BV(pOADModuleGlobalData->windowStart & 7)))
+    {
+        pOADModuleGlobalData->windowStart++;
+    }
+
+    if (pOADModuleGlobalData->windowStart == pOADModuleGlobalData->totalBlocks)
+    {
+        rcvdEnd = pOADModuleGlobalData->candidateImgLen;
+    }
+    else
+    {
+        rcvdEnd = (pOADModuleGlobalData->imgBytesPerBlock) * pOADModuleGlobalData->windowStart;
+    }
+
+    // Write the complete pages, each one with a single erase and write
+    while ((rcvdEnd >= pOADModuleGlobalData->stageAddr + pageSize) ||
+           ((rcvdEnd == pOADModuleGlobalData->candidateImgLen) && (rcvdEnd > pOADModuleGlobalData->stageAddr)))
+    {
+        uint16 writeLen = pageSize;
+
+        if (pOADModuleGlobalData->candidateImgLen - pOADModuleGlobalData->stageAddr < pageSize)
+        {
+            writeLen = pOADModuleGlobalData->candidateImgLen - pOADModuleGlobalData->stageAddr;
+        }
+
+        if (SUCCESS != SwUpdate_WriteBlock(pOADModuleGlobalData->stageAddr, writeLen, pOADModuleGlobalData->pStage))
+        {
+            return (OAD_PROFILE_FLASH_ERR);
+        }
+
+        memmove(pOADModuleGlobalData->pStage, pOADModuleGlobalData->pStage + pageSize, stageLen - pageSize);
+        memset(pOADModuleGlobalData->pStage + stageLen - pageSize, 0xFF, pageSize);
+        pOADModuleGlobalData->stageAddr += pageSize;
+    }
+
+    if (pOADModuleGlobalData->windowStart == pOADModuleGlobalData->totalBlocks)
+    {
+        pOADModuleGlobalData->currentBlkNum = pOADModuleGlobalData->totalBlocks;
+        oadFreeWindow();
+        return (OAD_PROFILE_DL_COMPLETE);
+    }
+
+    // Open more of the window once half of it was received, and report the
+    // missing blocks once the peer sent the last block of the window
+    if ((pOADModuleGlobalData->windowStart - pOADModuleGlobalData->windowSent >= (pOADModuleGlobalData->windowSize + 1) / 2) ||
+        (blkNum + 1 >= pOADModuleGlobalData->windowSent + pOADModuleGlobalData->windowSize) ||
+        (blkNum + 1 == pOADModuleGlobalData->totalBlocks))
+    {
+        oadSendWindowReq(OAD_PROFILE_SUCCESS);
+    }
+
+    return (OAD_PROFILE_SUCCESS);
+}
+
+/*********************************************************************
+ * @fn      oadEnableWindow
+ *
+ * @brief   Switch the download to windowed mode, allowed after the image
+ *          was identified and before the download starts. The receive
+ *          window is sent in the response.
+ *
+ * @return  OADProfile_Status_e
+ */
+static OADProfile_Status_e oadEnableWindow(void)
+{
+    windowRspPld_t rsp = {OAD_REQ_ENABLE_WINDOW, OAD_PROFILE_SUCCESS, 0};
+    uint16 pageSize;
+    uint32 windowSize;
+
+    if (OAD_CONFIG != pOADModuleGlobalData->state)
+    {
+        rsp.status = (OAD_IDLE == pOADModuleGlobalData->state) ? OAD_PROFILE_NOT_STARTED :
+                                                                 OAD_PROFILE_ALREADY_STARTED;
+    }
+    else if (0 == pOADModuleGlobalData->windowSize)
+    {
+        pageSize = SwUpdate_GetPageSize();
+
+        // Every block of the window must fit in the staging buffer, whatever
+        // the offset of the window start in its page
+        windowSize = ((uint32)pageSize * (OAD_WINDOW_STAGE_PAGES - 1)) / pOADModuleGlobalData->imgBytesPerBlock;
+        if (windowSize > OAD_WINDOW_MAX_BLOCKS)
+        {
+            windowSize = OAD_WINDOW_MAX_BLOCKS;
+        }
+
+        pOADModuleGlobalData->pStage = ICall_malloc((uint32)pageSize * OAD_WINDOW_STAGE_PAGES);
+        pOADModuleGlobalData->pBlkMap = ICall_malloc((pOADModuleGlobalData->totalBlocks + 7) >> 3);
+        if ((0 == windowSize) || (NULL == pOADModuleGlobalData->pStage) || (NULL == pOADModuleGlobalData->pBlkMap))
+        {
+            oadFreeWindow();
+            rsp.status = OAD_PROFILE_NO_RESOURCES;
+        }
+        else
+        {
+            memset(pOADModuleGlobalData->pStage, 0xFF, (uint32)pageSize * OAD_WINDOW_STAGE_PAGES);
+            memset(pOADModuleGlobalData->pBlkMap, 0, (pOADModuleGlobalData->totalBlocks + 7) >> 3);
+            pOADModuleGlobalData->windowSize  = windowSize;
+            pOADModuleGlobalData->windowStart = 0;
+            pOADModuleGlobalData->windowSent  = 0;
+            pOADModuleGlobalData->stageAddr   = 0;
+        }
+    }
+    rsp.windowSize = pOADModuleGlobalData->windowSize;
+
+    return ((OADProfile_Status_e)OADService_setParameter(OAD_SRV_CTRL_CMD,sizeof(windowRspPld_t),(void *)&rsp));
+}
+
+/*********************************************************************
+ * @fn      oadSetImageFormat
+ *
+ * @brief   Select the format of the blocks, allowed after the image was
+ *          identified and before the download or the window starts. For
+ *          a compressed or delta stream the blocks carry the stream, and
+ *          the image is rebuilt while it is written.
+ *
+ * @param   len     - length of pValue
+ * @param   pValue  - pointer to imgFormatReqPld_t
+ *
+ * @return  OADProfile_Status_e
+ */
+static OADProfile_Status_e oadSetImageFormat(uint16 len, uint8 *pValue)
+{
+    imgFormatReqPld_t req;
+    uint8 status = OAD_PROFILE_SUCCESS;
+    Status_t swUpdateStatus;
+
+    if (len < sizeof(imgFormatReqPld_t))
+    {
+        status = OAD_PROFILE_ERROR;
+    }
+    else if (OAD_CONFIG != pOADModuleGlobalData->state)
+    {
+        status = (OAD_IDLE == pOADModuleGlobalData->state) ? OAD_PROFILE_NOT_STARTED :
+                                                             OAD_PROFILE_ALREADY_STARTED;
+    }
+    else if ((0 != pOADModuleGlobalData->windowSize) ||
+             (SW_UPDATE_IMG_FORMAT_RAW != pOADModuleGlobalData->imgFormat))
+    {
+        // The block count, and the window block map, already follow the
+        // format that was set
+        status = OAD_PROFILE_ALREADY_STARTED;
+    }
+    else
+    {
+        memcpy(&req, pValue, sizeof(imgFormatReqPld_t));
+        swUpdateStatus = SwUpdate_SetImageFormat(req.format, req.streamLen);
+        if (INVALIDPARAMETER == swUpdateStatus)
+        {
+            status = OAD_PROFILE_EXT_NOT_SUPPORTED;
+        }
+        else if (SUCCESS != swUpdateStatus)
+        {
+            status = OAD_PROFILE_NO_RESOURCES;
+        }
+        else if (SW_UPDATE_IMG_FORMAT_RAW != req.format)
+        {
+            pOADModuleGlobalData->imgFormat = req.format;
+            pOADModuleGlobalData->candidateImgLen = req.streamLen;
+            oadSetTotalBlocks();
+        }
+    }
+
+    return (oadSendGenericExtCtrlRsp(OAD_REQ_SET_IMG_FORMAT, status));
+}
+
+/*********************************************************************
+ * @fn      oadFreeWindow
+ *
+ * @brief   Leave windowed mode and free its buffers
+ *
+ * @return  none
+ */
+static void oadFreeWindow(void)
+{
+    if (NULL != pOADModuleGlobalData->pStage)
+    {
+        ICall_free(pOADModuleGlobalData->pStage);
+        pOADModuleGlobalData->pStage = NULL;
+    }
+    if (NULL != pOADModuleGlobalData->pBlkMap)
+    {
+        ICall_free(pOADModuleGlobalData->pBlkMap);
+        pOADModuleGlobalData->pBlkMap = NULL;
+    }
+    pOADModuleGlobalData->windowSize = 0;
+}
+
 /*********************************************************************
  * @fn      oadChangeMachineState
  *
@@ -58,6 +58,7 @@
 #include <ti/bleapp/menu_module/menu_module.h>
 #include <app_main.h>
 #include "ble_stack_api.h"
+#include "util.h"
 
 /*********************************************************************
  * CONSTANTS
@@ -65,9 +66,35 @@
 // The size of the notification header is opcode + handle
 #define DSS_NOTI_HDR_SIZE   (ATT_OPCODE_SIZE + 2)
 
+// Delay before a stalled stream is pumped again when no completed packets
+// or connection event report resumes it, in milliseconds
+#ifndef DSS_STREAM_RETRY_MS
+#define DSS_STREAM_RETRY_MS 50
+#endif
+
 /*********************************************************************
  * TYPEDEFS
  */
+// Buffer queued by DSS_streamData, shared by all connections streaming it
+typedef struct
+{
+  uint8  *pValue;         // Buffer owned by the caller, NULL if the entry is free
+  uint16 len;             // Length of the buffer
+  uint8  refCount;        // Number of connections still sending the buffer
+} DSS_streamBuf_t;
+
+// Streaming state of one connection
+typedef struct
+{
+  uint16 connHandle;      // LINKDB_CONNHANDLE_INVALID if the entry is free
+  uint16 mtu;             // Cached ATT MTU of the connection
+  uint16 offset;          // Bytes of the head buffer already sent
+  uint8  stalled;         // The stack refused the last notification
+  uint8  qHead;           // Oldest entry of queue
+  uint8  qCount;          // Number of entries in queue
+  uint8  queue[DSS_STREAM_QUEUE_LEN];   // Indexes in dss_streamBufs
+  DSS_streamStats_t stats;
+} DSS_stream_t;
 
 /*********************************************************************
  * LOCAL VARIABLES
@@ -84,6 +111,17 @@ GATT_UUID( dss_dataOut_UUID, DSS_DATAOUT_UUID );
 
 static DSS_cb_t *dss_profileCBs = NULL;
 
+// Handle of the DataOut value, resolved once the service is registered
+static uint16 dss_dataOut_handle = GATT_INVALID_HANDLE;
+
+// Streaming state
+static DSS_streamBuf_t dss_streamBufs[DSS_STREAM_QUEUE_LEN];
+static DSS_stream_t dss_streams[MAX_NUM_BLE_CONNS];
+
+// Resumes stalled streams on an idle link, where the controller has no
+// packets in flight to report as completed
+static Clock_Struct dss_streamRetryClk;
+
 /*********************************************************************
  * Profile Attributes - variables
  */
@@ -152,6 +190,24 @@ static bStatus_t DSS_writeAttrCB( uint16 connHandle,
 
 static bStatus_t DSS_sendNotification( uint8 *pValue, uint16 len );
 
+static DSS_stream_t *DSS_findStream( uint16 connHandle );
+static DSS_stream_t *DSS_openStream( uint16 connHandle );
+static void DSS_flushStream( DSS_stream_t *pStream );
+static void DSS_streamPump( DSS_stream_t *pStream );
+static void DSS_streamRelease( uint8 bufIdx );
+static uint16 DSS_getMtu( uint16 connHandle );
+static void DSS_streamRetry( char *pData );
+#ifdef FREERTOS
+static void DSS_streamRetryClockCB( uint32_t arg );
+#else
+static void DSS_streamRetryClockCB( UArg arg );
+#endif // FREERTOS
+
+void DSS_connEventHandler( uint32 event, BLEAppUtil_msgHdr_t *pMsgData );
+void DSS_gattEventHandler( uint32 event, BLEAppUtil_msgHdr_t *pMsgData );
+void DSS_hciDataEventHandler( uint32 event, BLEAppUtil_msgHdr_t *pMsgData );
+void DSS_connNotiEventHandler( uint32 event, BLEAppUtil_msgHdr_t *pMsgData );
+
 /*********************************************************************
  * PROFILE CALLBACKS
  */
@@ -171,6 +227,38 @@ const gattServiceCBs_t dss_servCBs =
   NULL                            // Authorization callback function pointer
 };
 
+// Events handlers used to follow the connections that stream data
+BLEAppUtil_EventHandler_t dssConnHandler =
+{
+    .handlerType    = BLEAPPUTIL_GAP_CONN_TYPE,
+    .pEventHandler  = DSS_connEventHandler,
+    .eventMask      = BLEAPPUTIL_LINK_TERMINATED_EVENT
+};
+
+BLEAppUtil_EventHandler_t dssGATTHandler =
+{
+    .handlerType    = BLEAPPUTIL_GATT_TYPE,
+    .pEventHandler  = DSS_gattEventHandler,
+    .eventMask      = BLEAPPUTIL_ATT_MTU_UPDATED_EVENT
+};
+
+// Events handlers used to resume streaming once the controller has
+// free buffers again. Connection event reports are only received if the
+// application registered them with BLEAppUtil_registerConnNotifHandler.
+BLEAppUtil_EventHandler_t dssHciDataHandler =
+{
+    .handlerType    = BLEAPPUTIL_HCI_DATA_TYPE,
+    .pEventHandler  = DSS_hciDataEventHandler,
+    .eventMask      = BLEAPPUTIL_HCI_NUM_OF_COMPLETED_PACKETS_EVENT_CODE
+};
+
+BLEAppUtil_EventHandler_t dssConnNotiHandler =
+{
+    .handlerType    = BLEAPPUTIL_CONN_NOTI_TYPE,
+    .pEventHandler  = DSS_connNotiEventHandler,
+    .eventMask      = BLEAPPUTIL_CONN_NOTI_CONN_EVENT_ALL
+};
+
 /*********************************************************************
  * PUBLIC FUNCTIONS
  */
@@ -186,6 +274,8 @@ const gattServiceCBs_t dss_servCBs =
 bStatus_t DSS_addService( void )
 {
   bStatus_t status = SUCCESS;
+  gattAttribute_t *pAttr;
+  uint8 i;
 
   // Allocate Client Characteristic Configuration table
   dss_dataOut_config = (gattCharCfg_t *)ICall_malloc( sizeof(gattCharCfg_t) * MAX_NUM_BLE_CONNS );
@@ -202,6 +292,43 @@ bStatus_t DSS_addService( void )
                                         GATT_NUM_ATTRS( dss_attrTbl ),
                                         GATT_MAX_ENCRYPT_KEY_SIZE,
                                         &dss_servCBs );
+  if ( status != SUCCESS )
+  {
+    // Return status value
+    return ( status );
+  }
+
+  // The handles are assigned by the registration, resolve the one used
+  // for notifications once instead of on every send
+  pAttr = GATTServApp_FindAttr( dss_attrTbl, GATT_NUM_ATTRS( dss_attrTbl ), &dss_dataOut_val );
+  if ( pAttr != NULL )
+  {
+    dss_dataOut_handle = pAttr->handle;
+  }
+
+  for ( i = 0; i < MAX_NUM_BLE_CONNS; i++ )
+  {
+    dss_streams[i].connHandle = LINKDB_CONNHANDLE_INVALID;
+  }
+
+  // One-shot timer, started when a stream stalls
+  Util_constructClock( &dss_streamRetryClk, DSS_streamRetryClockCB,
+                       DSS_STREAM_RETRY_MS, 0, FALSE, 0 );
+
+  // Register the handlers driving the streams
+  status = BLEAppUtil_registerEventHandler( &dssConnHandler );
+  if ( status == SUCCESS )
+  {
+    status = BLEAppUtil_registerEventHandler( &dssGATTHandler );
+  }
+  if ( status == SUCCESS )
+  {
+    status = BLEAppUtil_registerEventHandler( &dssHciDataHandler );
+  }
+  if ( status == SUCCESS )
+  {
+    status = BLEAppUtil_registerEventHandler( &dssConnNotiHandler );
+  }
 
   // Return status value
   return ( status );
@@ -268,6 +395,238 @@ bStatus_t DSS_setParameter(uint8 param, void *pValue, uint16 len)
   return ( status );
 }
 
+/*********************************************************************
+ * @fn      DSS_streamData
+ *
+ * @brief   Queue data to be sent as notifications to every connection
+ *          that enabled them. The buffer is not copied, it is referenced
+ *          by each connection until all of it was handed to the stack.
+ *
+ * @param   pValue - pointer to data to send
+ * @param   len - length of data to send
+ *
+ * @return  SUCCESS - all data was handed to the stack
+ *          blePending - data is queued, pfnStreamDoneCB follows
+ *          bleNoResources - the stream queue is full
+ *          INVALIDPARAMETER
+ */
+bStatus_t DSS_streamData( uint8 *pValue, uint16 len )
+{
+  DSS_stream_t *pStream;
+  uint8 bufIdx;
+  uint8 i;
+
+  // Verify input parameters
+  if ( ( pValue == NULL ) || ( len == 0 ) || ( dss_dataOut_handle == GATT_INVALID_HANDLE ) )
+  {
+    return ( INVALIDPARAMETER );
+  }
+
+  // Find a free buffer entry
+  for ( bufIdx = 0; bufIdx < DSS_STREAM_QUEUE_LEN; bufIdx++ )
+  {
+    if ( dss_streamBufs[bufIdx].pValue == NULL )
+    {
+      break;
+    }
+  }
+  if ( bufIdx == DSS_STREAM_QUEUE_LEN )
+  {
+    return ( bleNoResources );
+  }
+
+  // Every subscribed connection must have room for one more buffer
+  for ( i = 0; i < MAX_NUM_BLE_CONNS; i++ )
+  {
+    gattCharCfg_t *pItem = &( dss_dataOut_config[i] );
+
+    if ( ( pItem->connHandle != LINKDB_CONNHANDLE_INVALID ) &&
+         ( pItem->value == GATT_CLIENT_CFG_NOTIFY ) )
+    {
+      pStream = DSS_findStream( pItem->connHandle );
+      if ( ( pStream != NULL ) && ( pStream->qCount == DSS_STREAM_QUEUE_LEN ) )
+      {
+        return ( bleNoResources );
+      }
+    }
+  }
+
+  // The extra reference is held while queuing, so that a buffer that is
+  // fully sent right away does not reach pfnStreamDoneCB
+  dss_streamBufs[bufIdx].pValue = pValue;
+  dss_streamBufs[bufIdx].len = len;
+  dss_streamBufs[bufIdx].refCount = 1;
+
+  for ( i = 0; i < MAX_NUM_BLE_CONNS; i++ )
+  {
+    gattCharCfg_t *pItem = &( dss_dataOut_config[i] );
+
+    if ( ( pItem->connHandle == LINKDB_CONNHANDLE_INVALID ) ||
+         ( pItem->value != GATT_CLIENT_CFG_NOTIFY ) )
+    {
+      continue;
+    }
+
+    pStream = DSS_findStream( pItem->connHandle );
+    if ( pStream == NULL )
+    {
+      pStream = DSS_openStream( pItem->connHandle );
+      if ( pStream == NULL )
+      {
+        continue;
+      }
+    }
+
+    pStream->queue[( pStream->qHead + pStream->qCount ) % DSS_STREAM_QUEUE_LEN] = bufIdx;
+    pStream->qCount++;
+    dss_streamBufs[bufIdx].refCount++;
+  }
+
+  // Send what the stack can take now
+  for ( i = 0; i < MAX_NUM_BLE_CONNS; i++ )
+  {
+    if ( dss_streams[i].connHandle != LINKDB_CONNHANDLE_INVALID )
+    {
+      DSS_streamPump( &dss_streams[i] );
+    }
+  }
+
+  if ( dss_streamBufs[bufIdx].refCount == 1 )
+  {
+    dss_streamBufs[bufIdx].pValue = NULL;
+    dss_streamBufs[bufIdx].refCount = 0;
+    return ( SUCCESS );
+  }
+
+  dss_streamBufs[bufIdx].refCount--;
+  return ( blePending );
+}
+
+/*********************************************************************
+ * @fn      DSS_getStreamStats
+ *
+ * @brief   Get the streaming counters of a connection.
+ *
+ * @param   connHandle - connection handle
+ * @param   pStats - counters output
+ *
+ * @return  SUCCESS or INVALIDPARAMETER
+ */
+bStatus_t DSS_getStreamStats( uint16 connHandle, DSS_streamStats_t *pStats )
+{
+  DSS_stream_t *pStream = DSS_findStream( connHandle );
+
+  if ( ( pStream == NULL ) || ( pStats == NULL ) )
+  {
+    return ( INVALIDPARAMETER );
+  }
+
+  *pStats = pStream->stats;
+
+  return ( SUCCESS );
+}
+
+/*********************************************************************
+ * @fn      DSS_connEventHandler
+ *
+ * @brief   Drop the stream of a terminated connection and report its
+ *          final counters
+ *
+ * @param   event - message event.
+ * @param   pMsgData - pointer to message data.
+ *
+ * @return  none
+ */
+void DSS_connEventHandler( uint32 event, BLEAppUtil_msgHdr_t *pMsgData )
+{
+  if ( event == BLEAPPUTIL_LINK_TERMINATED_EVENT )
+  {
+    DSS_stream_t *pStream = DSS_findStream( ((gapTerminateLinkEvent_t *)pMsgData)->connectionHandle );
+
+    if ( pStream != NULL )
+    {
+      DSS_flushStream( pStream );
+
+      // The entry is reused by the next connection, hand the counters,
+      // including the bytes dropped just above, out before freeing it
+      if ( dss_profileCBs && dss_profileCBs->pfnStreamClosedCB )
+      {
+        dss_profileCBs->pfnStreamClosedCB( pStream->connHandle, &pStream->stats );
+      }
+      pStream->connHandle = LINKDB_CONNHANDLE_INVALID;
+    }
+  }
+}
+
+/*********************************************************************
+ * @fn      DSS_gattEventHandler
+ *
+ * @brief   Keep the cached MTU of the streams up to date
+ *
+ * @param   event - message event.
+ * @param   pMsgData - pointer to message data.
+ *
+ * @return  none
+ */
+void DSS_gattEventHandler( uint32 event, BLEAppUtil_msgHdr_t *pMsgData )
+{
+  gattMsgEvent_t *gattMsg = (gattMsgEvent_t *)pMsgData;
+
+  if ( event == BLEAPPUTIL_ATT_MTU_UPDATED_EVENT )
+  {
+    DSS_stream_t *pStream = DSS_findStream( gattMsg->connHandle );
+
+    if ( pStream != NULL )
+    {
+      pStream->mtu = gattMsg->msg.mtuEvt.MTU;
+    }
+  }
+}
+
+/*********************************************************************
+ * @fn      DSS_hciDataEventHandler
+ *
+ * @brief   The controller released buffers, resume the stalled streams
+ *
+ * @param   event - message event.
+ * @param   pMsgData - pointer to message data.
+ *
+ * @return  none
+ */
+void DSS_hciDataEventHandler( uint32 event, BLEAppUtil_msgHdr_t *pMsgData )
+{
+  uint8 i;
+
+  for ( i = 0; i < MAX_NUM_BLE_CONNS; i++ )
+  {
+    if ( ( dss_streams[i].connHandle != LINKDB_CONNHANDLE_INVALID ) &&
+         ( dss_streams[i].qCount != 0 ) )
+    {
+      DSS_streamPump( &dss_streams[i] );
+    }
+  }
+}
+
+/*********************************************************************
+ * @fn      DSS_connNotiEventHandler
+ *
+ * @brief   A connection event ended, resume the stream of that connection
+ *
+ * @param   event - message event.
+ * @param   pMsgData - pointer to message data.
+ *
+ * @return  none
+ */
+void DSS_connNotiEventHandler( uint32 event, BLEAppUtil_msgHdr_t *pMsgData )
+{
+  DSS_stream_t *pStream = DSS_findStream( ((Gap_ConnEventRpt_t *)pMsgData)->handle );
+
+  if ( ( pStream != NULL ) && ( pStream->qCount != 0 ) )
+  {
+    DSS_streamPump( pStream );
+  }
+}
+
 /*********************************************************************
  * @fn      DSS_writeAttrCB
  *
@@ -388,9 +747,8 @@ static bStatus_t DSS_writeAttrCB( uint16 connHandle,
 static bStatus_t DSS_sendNotification(uint8 *pValue, uint16 len)
 {
   bStatus_t status = SUCCESS;
-  gattAttribute_t *pAttr = NULL;
   attHandleValueNoti_t noti = {0};
-  linkDBInfo_t connInfo = {0};
+  uint16 mtu = 0;
   uint16 offset = 0;
   uint8 i = 0;
 
@@ -400,9 +758,7 @@ static bStatus_t DSS_sendNotification(uint8 *pValue, uint16 len)
     return ( INVALIDPARAMETER );
   }
 
-  // Find the characteristic value attribute
-  pAttr = GATTServApp_FindAttr(dss_attrTbl, GATT_NUM_ATTRS(dss_attrTbl), &dss_dataOut_val);
-  if ( pAttr != NULL )
+  if ( dss_dataOut_handle != GATT_INVALID_HANDLE )
   {
 
     // Check the ccc value for each BLE connection
@@ -415,17 +771,18 @@ static bStatus_t DSS_sendNotification(uint8 *pValue, uint16 len)
            ( pItem->value == GATT_CLIENT_CFG_NOTIFY) )
       {
         // Find out what the maximum MTU size is for each connection
-        status = linkDB_GetInfo(pItem->connHandle, &connInfo);
+        mtu = DSS_getMtu(pItem->connHandle);
+        status = ( mtu != 0 ) ? SUCCESS : bleNotConnected;
         offset = 0;
 
         while ( status != bleTimeout && status != bleNotConnected &&  len > offset )
         {
           // Determine allocation size
           uint16_t allocLen = (len - offset);
-          if ( allocLen > ( connInfo.MTU - DSS_NOTI_HDR_SIZE ) )
+          if ( allocLen > ( mtu - DSS_NOTI_HDR_SIZE ) )
           {
             // If len > MTU split data to chunks of MTU size
-            allocLen = connInfo.MTU - DSS_NOTI_HDR_SIZE;
+            allocLen = mtu - DSS_NOTI_HDR_SIZE;
           }
 
           noti.len = allocLen;
@@ -434,7 +791,7 @@ static bStatus_t DSS_sendNotification(uint8 *pValue, uint16 len)
           {
             // If allocation was successful, copy out data and send it
             memcpy(noti.pValue, pValue + offset, noti.len);
-            noti.handle = pAttr->handle;
+            noti.handle = dss_dataOut_handle;
 
             // Send the data over BLE notifications
             status = GATT_Notification( pItem->connHandle, &noti, FALSE );
@@ -472,5 +829,270 @@ static bStatus_t DSS_sendNotification(uint8 *pValue, uint16 len)
   return ( status );
 }
 
+/*********************************************************************
+ * @fn      DSS_findStream
+ *
+ * @brief   Find the streaming state of a connection
+ *
+ * @param   connHandle - connection handle
+ *
+ * @return  pointer to the stream, or NULL if not found
+ */
+static DSS_stream_t *DSS_findStream( uint16 connHandle )
+{
+  uint8 i;
+
+  for ( i = 0; i < MAX_NUM_BLE_CONNS; i++ )
+  {
+    if ( dss_streams[i].connHandle == connHandle )
+    {
+      return ( &dss_streams[i] );
+    }
+  }
+
+  return ( NULL );
+}
+
+/*********************************************************************
+ * @fn      DSS_openStream
+ *
+ * @brief   Take a free stream entry for a connection and cache its MTU
+ *
+ * @param   connHandle - connection handle
+ *
+ * @return  pointer to the stream, or NULL if not connected or no entry
+ *          is free
+ */
+static DSS_stream_t *DSS_openStream( uint16 connHandle )
+{
+  DSS_stream_t *pStream;
+  linkDBInfo_t connInfo = {0};
+
+  if ( linkDB_GetInfo( connHandle, &connInfo ) != SUCCESS )
+  {
+    return ( NULL );
+  }
+
+  pStream = DSS_findStream( LINKDB_CONNHANDLE_INVALID );
+  if ( pStream != NULL )
+  {
+    memset( pStream, 0, sizeof( DSS_stream_t ) );
+    pStream->connHandle = connHandle;
+    pStream->mtu = connInfo.MTU;
+  }
+
+  return ( pStream );
+}
+
+/*********************************************************************
+ * @fn      DSS_flushStream
+ *
+ * @brief   Drop the data queued on a stream
+ *
+ * @param   pStream - stream to flush
+ *
+ * @return  none
+ */
+static void DSS_flushStream( DSS_stream_t *pStream )
+{
+  while ( pStream->qCount != 0 )
+  {
+    uint8 bufIdx = pStream->queue[pStream->qHead];
+
+    pStream->stats.bytesDropped += dss_streamBufs[bufIdx].len - pStream->offset;
+    pStream->offset = 0;
+    pStream->qHead = ( pStream->qHead + 1 ) % DSS_STREAM_QUEUE_LEN;
+    pStream->qCount--;
+    DSS_streamRelease( bufIdx );
+  }
+}
+
+/*********************************************************************
+ * @fn      DSS_streamPump
+ *
+ * @brief   Send notifications from the queue of a stream until it is
+ *          empty or the stack runs out of buffers, so that as many
+ *          notifications as the controller can take are packed in each
+ *          connection event.
+ *
+ * @param   pStream - stream to send from
+ *
+ * @return  none
+ */
+static void DSS_streamPump( DSS_stream_t *pStream )
+{
+  attHandleValueNoti_t noti = {0};
+  bStatus_t status;
+
+  // Notifications may have been disabled since the data was queued
+  if ( GATTServApp_ReadCharCfg( pStream->connHandle, dss_dataOut_config ) != GATT_CLIENT_CFG_NOTIFY )
+  {
+    DSS_flushStream( pStream );
+    return;
+  }
+
+  while ( pStream->qCount != 0 )
+  {
+    uint8 bufIdx = pStream->queue[pStream->qHead];
+    uint16 chunk = dss_streamBufs[bufIdx].len - pStream->offset;
+
+    if ( chunk > ( pStream->mtu - DSS_NOTI_HDR_SIZE ) )
+    {
+      chunk = pStream->mtu - DSS_NOTI_HDR_SIZE;
+    }
+
+    noti.pValue = (uint8 *)GATT_bm_alloc( pStream->connHandle, ATT_HANDLE_VALUE_NOTI, chunk, 0 );
+    if ( noti.pValue == NULL )
+    {
+      status = bleNoResources;
+    }
+    else
+    {
+      memcpy( noti.pValue, dss_streamBufs[bufIdx].pValue + pStream->offset, chunk );
+      noti.handle = dss_dataOut_handle;
+      noti.len = chunk;
+
+      status = GATT_Notification( pStream->connHandle, &noti, FALSE );
+      if ( status != SUCCESS )
+      {
+        GATT_bm_free( (gattMsg_t *)&noti, ATT_HANDLE_VALUE_NOTI );
+      }
+    }
+
+    if ( status != SUCCESS )
+    {
+      if ( ( status == bleNoResources ) || ( status == MSG_BUFFER_NOT_AVAIL ) ||
+           ( status == blePending ) || ( status == bleMemAllocError ) )
+      {
+        // Resumed by the next completed packets or connection event, or
+        // by the retry timer if the link is idle
+        if ( !pStream->stalled )
+        {
+          pStream->stalled = TRUE;
+          pStream->stats.stalls++;
+        }
+        Util_startClock( &dss_streamRetryClk );
+      }
+      else
+      {
+        // The link is gone, the terminated event frees the entry
+        DSS_flushStream( pStream );
+      }
+      return;
+    }
+
+    pStream->stalled = FALSE;
+    pStream->stats.bytesSent += chunk;
+    pStream->stats.notifications++;
+    pStream->offset += chunk;
+
+    if ( pStream->offset == dss_streamBufs[bufIdx].len )
+    {
+      pStream->offset = 0;
+      pStream->qHead = ( pStream->qHead + 1 ) % DSS_STREAM_QUEUE_LEN;
+      pStream->qCount--;
+      DSS_streamRelease( bufIdx );
+    }
+  }
+}
+
+/*********************************************************************
+ * @fn      DSS_streamRelease
+ *
+ * @brief   Drop one reference of a streamed buffer and give the buffer
+ *          back to the profile once no connection uses it anymore
+ *
+ * @param   bufIdx - index of the buffer in dss_streamBufs
+ *
+ * @return  none
+ */
+static void DSS_streamRelease( uint8 bufIdx )
+{
+  DSS_streamBuf_t *pBuf = &dss_streamBufs[bufIdx];
+  uint8 *pValue = pBuf->pValue;
+
+  if ( --pBuf->refCount != 0 )
+  {
+    return;
+  }
+
+  pBuf->pValue = NULL;
+
+  if ( dss_profileCBs && dss_profileCBs->pfnStreamDoneCB )
+  {
+    dss_profileCBs->pfnStreamDoneCB( pValue, pBuf->len );
+  }
+}
+
+/*********************************************************************
+ * @fn      DSS_streamRetry
+ *
+ * @brief   Pump the streams that still hold data. Runs in the BLEAppUtil
+ *          context.
+ *
+ * @param   pData - unused
+ *
+ * @return  none
+ */
+static void DSS_streamRetry( char *pData )
+{
+  uint8 i;
+
+  for ( i = 0; i < MAX_NUM_BLE_CONNS; i++ )
+  {
+    if ( ( dss_streams[i].connHandle != LINKDB_CONNHANDLE_INVALID ) &&
+         ( dss_streams[i].qCount != 0 ) )
+    {
+      DSS_streamPump( &dss_streams[i] );
+    }
+  }
+}
+
+/*********************************************************************
+ * @fn      DSS_streamRetryClockCB
+ *
+ * @brief   Retry timer callback, moves the retry to the BLEAppUtil context
+ *
+ * @param   arg - unused
+ *
+ * @return  none
+ */
+#ifdef FREERTOS
+static void DSS_streamRetryClockCB( uint32_t arg )
+#else
+static void DSS_streamRetryClockCB( UArg arg )
+#endif // FREERTOS
+{
+  BLEAppUtil_invokeFunctionNoData( DSS_streamRetry );
+}
+
+/*********************************************************************
+ * @fn      DSS_getMtu
+ *
+ * @brief   Get the ATT MTU of a connection, from the stream cache when
+ *          the connection is streaming
+ *
+ * @param   connHandle - connection handle
+ *
+ * @return  MTU, or 0 if not connected
+ */
+static uint16 DSS_getMtu( uint16 connHandle )
+{
+  DSS_stream_t *pStream = DSS_findStream( connHandle );
+  linkDBInfo_t connInfo = {0};
+
+  if ( pStream != NULL )
+  {
+    return ( pStream->mtu );
+  }
+
+  if ( linkDB_GetInfo( connHandle, &connInfo ) != SUCCESS )
+  {
+    return ( 0 );
+  }
+
+  return ( connInfo.MTU );
+}
+
 /*********************************************************************
 *********************************************************************/
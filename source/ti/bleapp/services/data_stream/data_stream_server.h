@@ -73,6 +73,12 @@ extern "C"
 // Maximum allowed length for incoming data
 #define DSS_MAX_DATA_IN_LEN 128
 
+// Number of buffers that can be queued for streaming at the same time.
+// Each connection can hold a reference to every one of them.
+#ifndef DSS_STREAM_QUEUE_LEN
+#define DSS_STREAM_QUEUE_LEN 4
+#endif
+
 /*********************************************************************
  * TYPEDEFS
  */
@@ -91,6 +97,15 @@ typedef struct
   uint16 value;
 } DSS_cccUpdate_t;
 
+// Streaming counters of one connection
+typedef struct
+{
+  uint32 bytesSent;       // Payload bytes handed to the stack
+  uint32 notifications;   // Notifications handed to the stack
+  uint32 bytesDropped;    // Queued bytes dropped on disconnect or CCC disable
+  uint16 stalls;          // Times the stack ran out of buffers while data was queued
+} DSS_streamStats_t;
+
 /*********************************************************************
  * Profile Callbacks
  */
@@ -100,10 +115,18 @@ typedef void (*DSS_onCccUpdate_t)( char *pValue );
 // Callback when data is received
 typedef void (*DSS_incomingData_t)( char *pValue );
 
+// Callback when a buffer queued by DSS_streamData is no longer used
+typedef void (*DSS_streamDone_t)( uint8 *pValue, uint16 len );
+
+// Callback with the final streaming counters of a terminated connection
+typedef void (*DSS_streamClosed_t)( uint16 connHandle, DSS_streamStats_t *pStats );
+
 typedef struct
 {
   DSS_onCccUpdate_t         pfnOnCccUpdateCB;     // Called when client characteristic configuration has been updated
   DSS_incomingData_t        pfnIncomingDataCB;    // Called when receiving data
+  DSS_streamDone_t          pfnStreamDoneCB;      // Called when a streamed buffer can be reused
+  DSS_streamClosed_t        pfnStreamClosedCB;    // Called when a streaming connection terminates
 } DSS_cb_t;
 
 /*********************************************************************
@@ -148,6 +171,37 @@ bStatus_t DSS_registerProfileCBs( DSS_cb_t *profileCallback );
  */
 bStatus_t DSS_setParameter( uint8 param, void *pValue, uint16 len);
 
+/*
+ * @fn      DSS_streamData
+ * @brief   Queue data to be sent as notifications to every connection
+ *          that enabled them. As many notifications as the stack has
+ *          buffers for are sent right away, the rest is sent when the
+ *          controller reports completed packets.
+ *          The buffer is not copied and must stay valid until
+ *          pfnStreamDoneCB is called for it.
+ * @param   pValue - pointer to data to send
+ * @param   len - length of data to send
+ * @return  SUCCESS - all data was handed to the stack, the buffer can
+ *                    be reused and pfnStreamDoneCB is not called
+ *          blePending - data is queued, pfnStreamDoneCB is called when
+ *                       the buffer can be reused
+ *          bleNoResources - the stream queue is full, nothing was queued
+ *          INVALIDPARAMETER
+ */
+bStatus_t DSS_streamData( uint8 *pValue, uint16 len );
+
+/*
+ * @fn      DSS_getStreamStats
+ * @brief   Get the streaming counters of a connection. The counters
+ *          start when the connection receives its first streamed data.
+ *          Once the connection terminates they are only reported,
+ *          through pfnStreamClosedCB.
+ * @param   connHandle - connection handle
+ * @param   pStats - counters output
+ * @return  SUCCESS or INVALIDPARAMETER
+ */
+bStatus_t DSS_getStreamStats( uint16 connHandle, DSS_streamStats_t *pStats );
+
 /*********************************************************************
 *********************************************************************/
 
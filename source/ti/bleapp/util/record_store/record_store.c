@@ -0,0 +1,872 @@
+/******************************************************************************
+
+@file  record_store.c
+
+ @brief Persistent time series record store, an append only log in
+        flash with a sparse RAM index, shared by the measurement data bases.
+
+Group: WCS, BTS
+Target Device: cc23xx
+
+******************************************************************************
+
+ Copyright (c) 2022-2024, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************
+
+
+*****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <string.h>
+
+#include "hal_types.h"
+#include "bcomdef.h"
+#include "ti/common/nv/crc.h"
+#include "ti/bleapp/util/record_store/record_store.h"
+
+/*********************************************************************
+ * MACROS
+ */
+
+// Marks a sector header written by this module ("RTS1")
+#define RECORD_STORE_MAGIC            0x31535452
+
+// Slot states, a slot whose header is still erased is free
+#define RECORD_STORE_SLOT_VALID       0xA5
+#define RECORD_STORE_SLOT_DEAD        0x00
+
+#define RECORD_STORE_ERASED_WORD      0xFFFFFFFF
+#define RECORD_STORE_ERASED_BYTE      0xFF
+
+// Period of the 16-bit keys extended by RecordStore_extendKey
+#define RECORD_STORE_KEY16_PERIOD     0x10000UL
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+// Header at the start of each sector in use
+typedef struct
+{
+    uint32 magic;             //!< RECORD_STORE_MAGIC
+    uint32 firstSeq;          //!< Sequence number of the first slot
+    uint16 slotSize;          //!< Slot size the sector was written with
+    uint16 reserved;
+    uint32 reserved2;
+} RecordStore_sectorHdr_t;
+
+// Header of each slot, written after the record and ending with the
+// state so that a reset while writing never leaves a slot that looks valid
+typedef struct
+{
+    uint32 key;               //!< Key of the record
+    uint16 reserved;
+    uint8  crc;               //!< CRC over key and record
+    uint8  state;             //!< RECORD_STORE_SLOT_VALID or RECORD_STORE_SLOT_DEAD
+} RecordStore_slotHdr_t;
+
+/*********************************************************************
+ * LOCAL FUNCTIONS - Prototypes
+ */
+static int_fast16_t RecordStore_flashRead(RecordStore_t *pStore, uint32 offset, void *pBuf, uint32 len);
+static int_fast16_t RecordStore_flashWrite(RecordStore_t *pStore, uint32 offset, const void *pBuf, uint32 len);
+static int_fast16_t RecordStore_flashErase(RecordStore_t *pStore, uint16 sector);
+static bStatus_t RecordStore_startSector(RecordStore_t *pStore, uint16 sector, uint32 firstSeq);
+static uint32 RecordStore_slotOffset(RecordStore_t *pStore, uint32 seq);
+static uint32 RecordStore_slotKey(RecordStore_t *pStore, uint32 seq);
+static uint16 RecordStore_sectorsWithData(RecordStore_t *pStore);
+static uint8 RecordStore_crc(uint32 key, const void *pRec, uint16 len);
+static bStatus_t RecordStore_recover(RecordStore_t *pStore);
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      RecordStore_open
+ *
+ * @brief   Open a store and rebuild its RAM index from flash
+ *
+ * @param   pStore - store to open
+ * @param   pConfig - store configuration
+ *
+ * @return  SUCCESS, INVALIDPARAMETER or FAILURE
+ */
+bStatus_t RecordStore_open(RecordStore_t *pStore, const RecordStore_config_t *pConfig)
+{
+    uint32 numSectors;
+
+    if ((pStore == NULL) || (pConfig == NULL) || (pConfig->recSize == 0))
+    {
+        return INVALIDPARAMETER;
+    }
+
+    memset(pStore, 0, sizeof(RecordStore_t));
+    pStore->recSize = pConfig->recSize;
+    pStore->slotSize = RECORD_STORE_SLOT_SIZE(pConfig->recSize);
+
+    if (pConfig->pRam != NULL)
+    {
+        pStore->pRam = pConfig->pRam;
+        pStore->sectorSize = RECORD_STORE_RAM_SECTOR_SIZE;
+        numSectors = pConfig->ramSize / RECORD_STORE_RAM_SECTOR_SIZE;
+    }
+    else
+    {
+        NVS_Params params;
+        NVS_Attrs attrs;
+
+        NVS_init();
+        NVS_Params_init(&params);
+        pStore->hNvs = NVS_open(pConfig->nvsIndex, &params);
+        if (pStore->hNvs == NULL)
+        {
+            return FAILURE;
+        }
+
+        NVS_getAttrs(pStore->hNvs, &attrs);
+        pStore->sectorSize = attrs.sectorSize;
+        numSectors = attrs.regionSize / attrs.sectorSize;
+    }
+
+    pStore->numSectors = (numSectors > RECORD_STORE_MAX_SECTORS) ? RECORD_STORE_MAX_SECTORS : numSectors;
+    pStore->slotsPerSector = (pStore->sectorSize - RECORD_STORE_SECTOR_HDR_SIZE) / pStore->slotSize;
+
+    // At least one sector must stay readable while the next one is erased
+    if ((pStore->numSectors < 2) || (pStore->slotsPerSector == 0))
+    {
+        return INVALIDPARAMETER;
+    }
+
+    if (pStore->hNvs == NULL)
+    {
+        // Nothing to recover from RAM
+        return RecordStore_clear(pStore);
+    }
+
+    return RecordStore_recover(pStore);
+}
+
+/*********************************************************************
+ * @fn      RecordStore_clear
+ *
+ * @brief   Erase all the records of a store
+ *
+ * @param   pStore - store to clear
+ *
+ * @return  SUCCESS or FAILURE
+ */
+bStatus_t RecordStore_clear(RecordStore_t *pStore)
+{
+    uint16 sector;
+
+    for (sector = 1; sector < pStore->numSectors; sector++)
+    {
+        if (RecordStore_flashErase(pStore, sector) != NVS_STATUS_SUCCESS)
+        {
+            return FAILURE;
+        }
+    }
+
+    pStore->headSector = 0;
+    pStore->tailSector = 0;
+    pStore->headSeq = 0;
+    pStore->nextSeq = 0;
+    pStore->lastKey = 0;
+
+    return RecordStore_startSector(pStore, 0, 0);
+}
+
+/*********************************************************************
+ * @fn      RecordStore_append
+ *
+ * @brief   Append a record, dropping the oldest sector when full
+ *
+ * @param   pStore - store to append to
+ * @param   key - key of the record
+ * @param   pRec - record, recSize bytes
+ *
+ * @return  SUCCESS, INVALIDPARAMETER or FAILURE
+ */
+bStatus_t RecordStore_append(RecordStore_t *pStore, uint32 key, const void *pRec)
+{
+    RecordStore_slotHdr_t hdr;
+    uint32 offset;
+    uint32 slot;
+
+    if ((pRec == NULL) || ((RecordStore_count(pStore) != 0) && (key < pStore->lastKey)))
+    {
+        return INVALIDPARAMETER;
+    }
+
+    slot = pStore->nextSeq - pStore->index[pStore->tailSector].firstSeq;
+    if (slot == pStore->slotsPerSector)
+    {
+        uint16 next = (pStore->tailSector + 1) % pStore->numSectors;
+
+        if (next == pStore->headSector)
+        {
+            // Full, the oldest sector makes room
+            pStore->headSector = (pStore->headSector + 1) % pStore->numSectors;
+            pStore->headSeq = pStore->index[pStore->headSector].firstSeq;
+        }
+
+        if (RecordStore_startSector(pStore, next, pStore->nextSeq) != SUCCESS)
+        {
+            return FAILURE;
+        }
+        pStore->tailSector = next;
+        slot = 0;
+    }
+
+    if (slot == 0)
+    {
+        pStore->index[pStore->tailSector].firstKey = key;
+    }
+
+    offset = RecordStore_slotOffset(pStore, pStore->nextSeq);
+
+    hdr.key = key;
+    hdr.crc = RecordStore_crc(key, pRec, pStore->recSize);
+    hdr.state = RECORD_STORE_SLOT_VALID;
+    hdr.reserved = 0xFFFF;
+
+    // The slot is used even if the write fails, it cannot be written twice
+    pStore->nextSeq++;
+    pStore->lastKey = key;
+
+    if ((RecordStore_flashWrite(pStore, offset + RECORD_STORE_SLOT_HDR_SIZE, pRec, pStore->recSize) != NVS_STATUS_SUCCESS) ||
+        (RecordStore_flashWrite(pStore, offset, &hdr, sizeof(hdr)) != NVS_STATUS_SUCCESS))
+    {
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/*********************************************************************
+ * @fn      RecordStore_count
+ *
+ * @brief   Number of records in the store
+ *
+ * @param   pStore - store
+ *
+ * @return  number of records
+ */
+uint32 RecordStore_count(RecordStore_t *pStore)
+{
+    return pStore->nextSeq - pStore->headSeq;
+}
+
+/*********************************************************************
+ * @fn      RecordStore_firstKey
+ *
+ * @brief   Key of the oldest record
+ *
+ * @param   pStore - store
+ *
+ * @return  key
+ */
+uint32 RecordStore_firstKey(RecordStore_t *pStore)
+{
+    return pStore->index[pStore->headSector].firstKey;
+}
+
+/*********************************************************************
+ * @fn      RecordStore_lastKey
+ *
+ * @brief   Key of the newest record
+ *
+ * @param   pStore - store
+ *
+ * @return  key
+ */
+uint32 RecordStore_lastKey(RecordStore_t *pStore)
+{
+    return pStore->lastKey;
+}
+
+/*********************************************************************
+ * @fn      RecordStore_extendKey
+ *
+ * @brief   Extend a wrapping 16-bit key to the key of a new record
+ *
+ * @param   pStore - store
+ * @param   key - 16-bit key of the new record
+ *
+ * @return  32-bit key
+ */
+uint32 RecordStore_extendKey(RecordStore_t *pStore, uint16 key)
+{
+    uint32 extKey = (pStore->lastKey & ~(RECORD_STORE_KEY16_PERIOD - 1)) | key;
+
+    if (extKey < pStore->lastKey)
+    {
+        extKey += RECORD_STORE_KEY16_PERIOD;
+    }
+
+    return extKey;
+}
+
+/*********************************************************************
+ * @fn      RecordStore_matchMinKey
+ *
+ * @brief   Map the 16-bit lower bound of a query to an extended key
+ *
+ * @param   pStore - store
+ * @param   key - 16-bit key
+ *
+ * @return  32-bit key, not lower than the oldest key
+ */
+uint32 RecordStore_matchMinKey(RecordStore_t *pStore, uint16 key)
+{
+    uint32 firstKey = RecordStore_firstKey(pStore);
+    uint32 extKey = (firstKey & ~(RECORD_STORE_KEY16_PERIOD - 1)) | key;
+
+    if (extKey < firstKey)
+    {
+        extKey += RECORD_STORE_KEY16_PERIOD;
+    }
+
+    return extKey;
+}
+
+/*********************************************************************
+ * @fn      RecordStore_matchMaxKey
+ *
+ * @brief   Map the 16-bit upper bound of a query to an extended key
+ *
+ * @param   pStore - store
+ * @param   key - 16-bit key
+ *
+ * @return  32-bit key, not higher than the newest key unless no stored
+ *          key has the same low 16 bits
+ */
+uint32 RecordStore_matchMaxKey(RecordStore_t *pStore, uint16 key)
+{
+    uint32 extKey = (pStore->lastKey & ~(RECORD_STORE_KEY16_PERIOD - 1)) | key;
+
+    if ((extKey > pStore->lastKey) && (extKey >= RECORD_STORE_KEY16_PERIOD))
+    {
+        extKey -= RECORD_STORE_KEY16_PERIOD;
+    }
+
+    return extKey;
+}
+
+/*********************************************************************
+ * @fn      RecordStore_find
+ *
+ * @brief   Find the oldest record with a key greater than or equal to key
+ *
+ * @param   pStore - store
+ * @param   key - key to look for
+ *
+ * @return  sequence number of the record, or nextSeq if there is none
+ */
+uint32 RecordStore_find(RecordStore_t *pStore, uint32 key)
+{
+    uint16 numSectors = RecordStore_sectorsWithData(pStore);
+    uint16 lo = 0;
+    uint16 hi = numSectors;
+    uint32 seqLo;
+    uint32 seqHi;
+
+    // First sector whose first key is not lower than key, from the RAM index
+    while (lo < hi)
+    {
+        uint16 mid = (lo + hi) / 2;
+
+        if (pStore->index[(pStore->headSector + mid) % pStore->numSectors].firstKey < key)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    if (lo == 0)
+    {
+        return pStore->headSeq;
+    }
+
+    // The record is in the previous sector, after its first slot, or it
+    // is the first slot of sector lo
+    seqLo = pStore->index[(pStore->headSector + lo - 1) % pStore->numSectors].firstSeq + 1;
+    seqHi = (lo < numSectors) ? pStore->index[(pStore->headSector + lo) % pStore->numSectors].firstSeq :
+                                pStore->nextSeq;
+
+    while (seqLo < seqHi)
+    {
+        uint32 mid = seqLo + (seqHi - seqLo) / 2;
+
+        if (RecordStore_slotKey(pStore, mid) < key)
+        {
+            seqLo = mid + 1;
+        }
+        else
+        {
+            seqHi = mid;
+        }
+    }
+
+    return seqLo;
+}
+
+/*********************************************************************
+ * @fn      RecordStore_countFrom
+ *
+ * @brief   Number of records with a key greater than or equal to key
+ *
+ * @param   pStore - store
+ * @param   key - minimum key
+ *
+ * @return  number of records
+ */
+uint32 RecordStore_countFrom(RecordStore_t *pStore, uint32 key)
+{
+    return pStore->nextSeq - RecordStore_find(pStore, key);
+}
+
+/*********************************************************************
+ * @fn      RecordStore_read
+ *
+ * @brief   Read a batch of records starting at sequence number *pSeq
+ *
+ * @param   pStore - store
+ * @param   pSeq - first sequence number to read, updated
+ * @param   maxKey - highest key to return
+ * @param   pRecs - output, room for maxRecs records
+ * @param   pKeys - output, room for maxRecs keys, or NULL
+ * @param   maxRecs - maximum number of records to return
+ *
+ * @return  number of records returned
+ */
+uint16 RecordStore_read(RecordStore_t *pStore, uint32 *pSeq, uint32 maxKey,
+                        void *pRecs, uint32 *pKeys, uint16 maxRecs)
+{
+    RecordStore_slotHdr_t hdr;
+    uint32 seq = *pSeq;
+    uint16 numRecs = 0;
+
+    // The records may have been dropped since the previous batch
+    if ((int32)(seq - pStore->headSeq) < 0)
+    {
+        seq = pStore->headSeq;
+    }
+
+    while ((numRecs < maxRecs) && (seq != pStore->nextSeq))
+    {
+        uint8 *pRec = (uint8 *)pRecs + (uint32)numRecs * pStore->recSize;
+        uint32 offset = RecordStore_slotOffset(pStore, seq);
+
+        RecordStore_flashRead(pStore, offset, &hdr, sizeof(hdr));
+
+        // Skip the slots left by a reset or a failed write
+        if (hdr.state != RECORD_STORE_SLOT_VALID)
+        {
+            seq++;
+            continue;
+        }
+
+        if (hdr.key > maxKey)
+        {
+            // End of the range
+            seq = pStore->nextSeq;
+            break;
+        }
+
+        RecordStore_flashRead(pStore, offset + RECORD_STORE_SLOT_HDR_SIZE, pRec, pStore->recSize);
+        seq++;
+
+        if (hdr.crc != RecordStore_crc(hdr.key, pRec, pStore->recSize))
+        {
+            continue;
+        }
+
+        if (pKeys != NULL)
+        {
+            pKeys[numRecs] = hdr.key;
+        }
+        numRecs++;
+    }
+
+    *pSeq = seq;
+
+    return numRecs;
+}
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      RecordStore_recover
+ *
+ * @brief   Rebuild the state of a store from the sector headers and
+ *          the newest sector. The store is cleared if the flash content
+ *          is not consistent.
+ *
+ * @param   pStore - store
+ *
+ * @return  SUCCESS or FAILURE
+ */
+static bStatus_t RecordStore_recover(RecordStore_t *pStore)
+{
+    RecordStore_sectorHdr_t sectorHdr;
+    RecordStore_slotHdr_t hdr;
+    uint32 validMask = 0;
+    uint32 minSeq = RECORD_STORE_ERASED_WORD;
+    uint32 maxSeq = 0;
+    uint16 numUsed;
+    uint16 sector;
+    uint16 i;
+    uint32 lo;
+    uint32 hi;
+
+    for (sector = 0; sector < pStore->numSectors; sector++)
+    {
+        RecordStore_flashRead(pStore, (uint32)sector * pStore->sectorSize, &sectorHdr, sizeof(sectorHdr));
+        if ((sectorHdr.magic != RECORD_STORE_MAGIC) || (sectorHdr.slotSize != pStore->slotSize))
+        {
+            continue;
+        }
+
+        validMask |= (1UL << sector);
+        pStore->index[sector].firstSeq = sectorHdr.firstSeq;
+        if (sectorHdr.firstSeq <= minSeq)
+        {
+            minSeq = sectorHdr.firstSeq;
+            pStore->headSector = sector;
+        }
+        if (sectorHdr.firstSeq >= maxSeq)
+        {
+            maxSeq = sectorHdr.firstSeq;
+            pStore->tailSector = sector;
+        }
+    }
+
+    if (validMask == 0)
+    {
+        return RecordStore_clear(pStore);
+    }
+
+    // The sectors in use must follow each other with consecutive slots
+    numUsed = ((pStore->tailSector + pStore->numSectors - pStore->headSector) % pStore->numSectors) + 1;
+    for (i = 0; i < numUsed; i++)
+    {
+        sector = (pStore->headSector + i) % pStore->numSectors;
+        if (!(validMask & (1UL << sector)) ||
+            (pStore->index[sector].firstSeq != minSeq + (uint32)i * pStore->slotsPerSector))
+        {
+            return RecordStore_clear(pStore);
+        }
+    }
+    pStore->headSeq = minSeq;
+
+    // Slots are filled in order, the first free slot of the newest sector
+    // is found by a binary search on the slot headers
+    lo = 0;
+    hi = pStore->slotsPerSector;
+    while (lo < hi)
+    {
+        uint32 mid = (lo + hi) / 2;
+
+        RecordStore_flashRead(pStore, (uint32)pStore->tailSector * pStore->sectorSize + RECORD_STORE_SECTOR_HDR_SIZE +
+                              mid * pStore->slotSize, &hdr, sizeof(hdr));
+        if ((hdr.key == RECORD_STORE_ERASED_WORD) && (hdr.state == RECORD_STORE_ERASED_BYTE))
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+    pStore->nextSeq = maxSeq + lo;
+
+    for (i = 0; i < numUsed; i++)
+    {
+        sector = (pStore->headSector + i) % pStore->numSectors;
+        pStore->index[sector].firstKey = RecordStore_slotKey(pStore, pStore->index[sector].firstSeq);
+    }
+
+    if (RecordStore_count(pStore) != 0)
+    {
+        pStore->lastKey = RecordStore_slotKey(pStore, pStore->nextSeq - 1);
+    }
+
+    // A reset between the record and header writes leaves a free looking
+    // slot that cannot be written again, retire it
+    if (lo < pStore->slotsPerSector)
+    {
+        uint32 offset = RecordStore_slotOffset(pStore, pStore->nextSeq);
+        uint8 data[8];
+        uint16 done;
+
+        for (done = 0; done < pStore->recSize; done += sizeof(data))
+        {
+            uint16 left = pStore->recSize - done;
+            uint16 len = (left > sizeof(data)) ? sizeof(data) : left;
+
+            RecordStore_flashRead(pStore, offset + RECORD_STORE_SLOT_HDR_SIZE + done, data, len);
+            for (i = 0; i < len; i++)
+            {
+                if (data[i] != RECORD_STORE_ERASED_BYTE)
+                {
+                    break;
+                }
+            }
+            if (i < len)
+            {
+                break;
+            }
+        }
+
+        if (done < pStore->recSize)
+        {
+            hdr.key = 0;
+            hdr.crc = 0;
+            hdr.state = RECORD_STORE_SLOT_DEAD;
+            hdr.reserved = 0;
+
+            if (lo == 0)
+            {
+                pStore->index[pStore->tailSector].firstKey = pStore->lastKey;
+            }
+            pStore->nextSeq++;
+            RecordStore_flashWrite(pStore, offset, &hdr, sizeof(hdr));
+        }
+    }
+
+    return SUCCESS;
+}
+
+/*********************************************************************
+ * @fn      RecordStore_startSector
+ *
+ * @brief   Erase a sector and mark it as holding the slots starting at
+ *          firstSeq
+ *
+ * @param   pStore - store
+ * @param   sector - sector to start
+ * @param   firstSeq - sequence number of its first slot
+ *
+ * @return  SUCCESS or FAILURE
+ */
+static bStatus_t RecordStore_startSector(RecordStore_t *pStore, uint16 sector, uint32 firstSeq)
+{
+    RecordStore_sectorHdr_t sectorHdr;
+
+    if (RecordStore_flashErase(pStore, sector) != NVS_STATUS_SUCCESS)
+    {
+        return FAILURE;
+    }
+
+    sectorHdr.magic = RECORD_STORE_MAGIC;
+    sectorHdr.firstSeq = firstSeq;
+    sectorHdr.slotSize = pStore->slotSize;
+    sectorHdr.reserved = 0xFFFF;
+    sectorHdr.reserved2 = RECORD_STORE_ERASED_WORD;
+
+    if (RecordStore_flashWrite(pStore, (uint32)sector * pStore->sectorSize, &sectorHdr, sizeof(sectorHdr)) != NVS_STATUS_SUCCESS)
+    {
+        return FAILURE;
+    }
+
+    pStore->index[sector].firstSeq = firstSeq;
+    pStore->index[sector].firstKey = pStore->lastKey;
+
+    return SUCCESS;
+}
+
+/*********************************************************************
+ * @fn      RecordStore_slotOffset
+ *
+ * @brief   Offset of the slot of a sequence number in the store. All
+ *          sectors but the newest are full, so the slot follows from
+ *          the distance to the oldest record.
+ *
+ * @param   pStore - store
+ * @param   seq - sequence number, in the store
+ *
+ * @return  offset in the NVS region or RAM area
+ */
+static uint32 RecordStore_slotOffset(RecordStore_t *pStore, uint32 seq)
+{
+    uint32 distance = seq - pStore->headSeq;
+    uint16 sector = (pStore->headSector + distance / pStore->slotsPerSector) % pStore->numSectors;
+
+    return (uint32)sector * pStore->sectorSize + RECORD_STORE_SECTOR_HDR_SIZE +
+           (distance % pStore->slotsPerSector) * pStore->slotSize;
+}
+
+/*********************************************************************
+ * @fn      RecordStore_slotKey
+ *
+ * @brief   Read the key of a slot. A slot without a valid header, left
+ *          by a reset, takes the key of the closest valid slot before
+ *          it so that keys stay ordered for the searches.
+ *
+ * @param   pStore - store
+ * @param   seq - sequence number, in the store
+ *
+ * @return  key
+ */
+static uint32 RecordStore_slotKey(RecordStore_t *pStore, uint32 seq)
+{
+    RecordStore_slotHdr_t hdr;
+
+    for (;;)
+    {
+        RecordStore_flashRead(pStore, RecordStore_slotOffset(pStore, seq), &hdr, sizeof(hdr));
+        if (hdr.state == RECORD_STORE_SLOT_VALID)
+        {
+            return hdr.key;
+        }
+        if (seq == pStore->headSeq)
+        {
+            return 0;
+        }
+        seq--;
+    }
+}
+
+/*********************************************************************
+ * @fn      RecordStore_sectorsWithData
+ *
+ * @brief   Number of sectors holding at least one slot
+ *
+ * @param   pStore - store
+ *
+ * @return  number of sectors
+ */
+static uint16 RecordStore_sectorsWithData(RecordStore_t *pStore)
+{
+    uint16 numUsed = ((pStore->tailSector + pStore->numSectors - pStore->headSector) % pStore->numSectors) + 1;
+
+    if (pStore->nextSeq == pStore->index[pStore->tailSector].firstSeq)
+    {
+        numUsed--;
+    }
+
+    return numUsed;
+}
+
+/*********************************************************************
+ * @fn      RecordStore_crc
+ *
+ * @brief   CRC of a slot
+ *
+ * @param   key - key of the record
+ * @param   pRec - record
+ * @param   len - record size
+ *
+ * @return  CRC
+ */
+static uint8 RecordStore_crc(uint32 key, const void *pRec, uint16 len)
+{
+    crc_t crc = crc_init();
+
+    crc = crc_update(crc, &key, sizeof(key));
+    crc = crc_update(crc, pRec, len);
+
+    return crc_finalize(crc);
+}
+
+/*********************************************************************
+ * @fn      RecordStore_flashRead
+ *
+ * @brief   Read from the store medium
+ *
+ * @return  NVS status
+ */
+static int_fast16_t RecordStore_flashRead(RecordStore_t *pStore, uint32 offset, void *pBuf, uint32 len)
+{
+    if (pStore->hNvs == NULL)
+    {
+        memcpy(pBuf, pStore->pRam + offset, len);
+        return NVS_STATUS_SUCCESS;
+    }
+
+    return NVS_read(pStore->hNvs, offset, pBuf, len);
+}
+
+/*********************************************************************
+ * @fn      RecordStore_flashWrite
+ *
+ * @brief   Program the store medium. Like flash, RAM bits can only be
+ *          cleared, so both media behave the same.
+ *
+ * @return  NVS status
+ */
+static int_fast16_t RecordStore_flashWrite(RecordStore_t *pStore, uint32 offset, const void *pBuf, uint32 len)
+{
+    if (pStore->hNvs == NULL)
+    {
+        const uint8 *pSrc = (const uint8 *)pBuf;
+        uint32 i;
+
+        for (i = 0; i < len; i++)
+        {
+            pStore->pRam[offset + i] &= pSrc[i];
+        }
+        return NVS_STATUS_SUCCESS;
+    }
+
+    return NVS_write(pStore->hNvs, offset, (void *)pBuf, len, NVS_WRITE_POST_VERIFY);
+}
+
+/*********************************************************************
+ * @fn      RecordStore_flashErase
+ *
+ * @brief   Erase one sector of the store medium
+ *
+ * @return  NVS status
+ */
+static int_fast16_t RecordStore_flashErase(RecordStore_t *pStore, uint16 sector)
+{
+    if (pStore->hNvs == NULL)
+    {
+        memset(pStore->pRam + (uint32)sector * pStore->sectorSize, RECORD_STORE_ERASED_BYTE, pStore->sectorSize);
+        return NVS_STATUS_SUCCESS;
+    }
+
+    return NVS_erase(pStore->hNvs, (uint32)sector * pStore->sectorSize, pStore->sectorSize);
+}
+
+/*********************************************************************
+*********************************************************************/
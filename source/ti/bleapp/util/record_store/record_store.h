@@ -0,0 +1,318 @@
+/******************************************************************************
+
+@file  record_store.h
+
+ @brief Persistent time series record store, an append only log in
+        flash with a sparse RAM index, shared by the measurement data bases.
+
+Group: WCS, BTS
+Target Device: cc23xx
+
+******************************************************************************
+
+ Copyright (c) 2022-2024, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************
+
+
+*****************************************************************************/
+
+#ifndef RECORD_STORE_H
+#define RECORD_STORE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include "hal_types.h"
+#include "bcomdef.h"
+#include <ti/drivers/NVS.h>
+
+/*********************************************************************
+ * MACROS
+ */
+
+// Maximum number of flash sectors of one store, sizes the RAM index
+#ifndef RECORD_STORE_MAX_SECTORS
+#define RECORD_STORE_MAX_SECTORS      32
+#endif
+
+// Sector size used when the store is kept in RAM
+#ifndef RECORD_STORE_RAM_SECTOR_SIZE
+#define RECORD_STORE_RAM_SECTOR_SIZE  512
+#endif
+
+// Size of the header in front of each record
+#define RECORD_STORE_SLOT_HDR_SIZE    8
+
+// Size of the header at the start of each sector
+#define RECORD_STORE_SECTOR_HDR_SIZE  16
+
+// Size of the slot of a record, header included, rounded up to 8 bytes
+#define RECORD_STORE_SLOT_SIZE(recSize) \
+    ((RECORD_STORE_SLOT_HDR_SIZE + (recSize) + 7) & ~7)
+
+// Number of slots in one sector of a store kept in RAM
+#define RECORD_STORE_RAM_SLOTS(recSize) \
+    ((RECORD_STORE_RAM_SECTOR_SIZE - RECORD_STORE_SECTOR_HDR_SIZE) / RECORD_STORE_SLOT_SIZE(recSize))
+
+// Size of a RAM area that always keeps at least numRecs records. Making
+// room drops a whole sector, so one sector comes on top of the records.
+#define RECORD_STORE_RAM_SIZE(numRecs, recSize) \
+    ((((numRecs) + RECORD_STORE_RAM_SLOTS(recSize) - 1) / RECORD_STORE_RAM_SLOTS(recSize) + 1) * \
+     RECORD_STORE_RAM_SECTOR_SIZE)
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+/*!
+ * Store configuration. When pRam is NULL the store lives in the NVS
+ * region nvsIndex and survives resets, otherwise it lives in pRam.
+ */
+typedef struct
+{
+    uint_least8_t nvsIndex;   //!< NVS region of the store
+    uint8         *pRam;      //!< RAM area of a volatile store, or NULL
+    uint32        ramSize;    //!< Size of pRam
+    uint16        recSize;    //!< Size of one record
+} RecordStore_config_t;
+
+/*!
+ * Sparse index, one entry per sector in use
+ */
+typedef struct
+{
+    uint32 firstSeq;          //!< Sequence number of the first slot of the sector
+    uint32 firstKey;          //!< Key of the first record of the sector
+} RecordStore_index_t;
+
+/*!
+ * Store state. Records get consecutive sequence numbers, which locate
+ * their slot directly, and carry a key that never decreases (sequence
+ * number or time offset of the measurement), used for range queries.
+ */
+typedef struct
+{
+    NVS_Handle    hNvs;       //!< NVS region, NULL for a volatile store
+    uint8         *pRam;      //!< RAM area of a volatile store
+    uint32        sectorSize; //!< Erase unit
+    uint16        numSectors; //!< Sectors used by the store
+    uint16        recSize;    //!< Size of one record
+    uint16        slotSize;   //!< Header and record, rounded up to 8 bytes
+    uint16        slotsPerSector;
+    uint16        headSector; //!< Sector holding the oldest records
+    uint16        tailSector; //!< Sector records are appended to
+    uint32        headSeq;    //!< Sequence number of the oldest record
+    uint32        nextSeq;    //!< Sequence number of the next record
+    uint32        lastKey;    //!< Key of the newest record
+    RecordStore_index_t index[RECORD_STORE_MAX_SECTORS];
+} RecordStore_t;
+
+/*********************************************************************
+ * API FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      RecordStore_open
+ *
+ * @brief   Open a store and rebuild its RAM index from flash. Only the
+ *          sector headers and the end of the newest sector are read.
+ *
+ * @param   pStore - store to open
+ * @param   pConfig - store configuration
+ *
+ * @return  SUCCESS, INVALIDPARAMETER or FAILURE
+ */
+extern bStatus_t RecordStore_open(RecordStore_t *pStore, const RecordStore_config_t *pConfig);
+
+/*********************************************************************
+ * @fn      RecordStore_clear
+ *
+ * @brief   Erase all the records of a store
+ *
+ * @param   pStore - store to clear
+ *
+ * @return  SUCCESS or FAILURE
+ */
+extern bStatus_t RecordStore_clear(RecordStore_t *pStore);
+
+/*********************************************************************
+ * @fn      RecordStore_append
+ *
+ * @brief   Append a record. When the store is full the oldest sector
+ *          of records is dropped.
+ *
+ * @param   pStore - store to append to
+ * @param   key - key of the record, not lower than the key of the
+ *                previous record
+ * @param   pRec - record, recSize bytes
+ *
+ * @return  SUCCESS, INVALIDPARAMETER or FAILURE
+ */
+extern bStatus_t RecordStore_append(RecordStore_t *pStore, uint32 key, const void *pRec);
+
+/*********************************************************************
+ * @fn      RecordStore_count
+ *
+ * @brief   Number of records in the store
+ *
+ * @param   pStore - store
+ *
+ * @return  number of records
+ */
+extern uint32 RecordStore_count(RecordStore_t *pStore);
+
+/*********************************************************************
+ * @fn      RecordStore_firstKey
+ *
+ * @brief   Key of the oldest record. Only valid if the store is not empty.
+ *
+ * @param   pStore - store
+ *
+ * @return  key
+ */
+extern uint32 RecordStore_firstKey(RecordStore_t *pStore);
+
+/*********************************************************************
+ * @fn      RecordStore_lastKey
+ *
+ * @brief   Key of the newest record. Only valid if the store is not empty.
+ *
+ * @param   pStore - store
+ *
+ * @return  key
+ */
+extern uint32 RecordStore_lastKey(RecordStore_t *pStore);
+
+/*********************************************************************
+ * @fn      RecordStore_extendKey
+ *
+ * @brief   Extend a 16-bit key that wraps around (sequence number, time
+ *          offset of a session) to the 32-bit key of a new record, so
+ *          that keys never decrease. A key lower than the low 16 bits of
+ *          the newest key counts as a wrap.
+ *
+ * @param   pStore - store
+ * @param   key - 16-bit key of the new record
+ *
+ * @return  key to pass to RecordStore_append
+ */
+extern uint32 RecordStore_extendKey(RecordStore_t *pStore, uint16 key);
+
+/*********************************************************************
+ * @fn      RecordStore_matchMinKey
+ *
+ * @brief   Map the 16-bit lower bound of a query to the extended key of
+ *          its oldest occurrence in the store, for keys appended with
+ *          RecordStore_extendKey.
+ *
+ * @param   pStore - store
+ * @param   key - 16-bit key
+ *
+ * @return  key to pass to RecordStore_find or RecordStore_countFrom
+ */
+extern uint32 RecordStore_matchMinKey(RecordStore_t *pStore, uint16 key);
+
+/*********************************************************************
+ * @fn      RecordStore_matchMaxKey
+ *
+ * @brief   Map the 16-bit upper bound of a query to the extended key of
+ *          its newest occurrence in the store, for keys appended with
+ *          RecordStore_extendKey.
+ *
+ * @param   pStore - store
+ * @param   key - 16-bit key
+ *
+ * @return  maxKey to pass to RecordStore_read
+ */
+extern uint32 RecordStore_matchMaxKey(RecordStore_t *pStore, uint16 key);
+
+/*********************************************************************
+ * @fn      RecordStore_find
+ *
+ * @brief   Find the oldest record with a key greater than or equal to
+ *          key. Binary search over the sector index, then over the slots
+ *          of one sector.
+ *
+ * @param   pStore - store
+ * @param   key - key to look for
+ *
+ * @return  sequence number of the record, the sequence number of the
+ *          next record to be appended if there is none
+ */
+extern uint32 RecordStore_find(RecordStore_t *pStore, uint32 key);
+
+/*********************************************************************
+ * @fn      RecordStore_countFrom
+ *
+ * @brief   Number of records with a key greater than or equal to key
+ *
+ * @param   pStore - store
+ * @param   key - minimum key
+ *
+ * @return  number of records
+ */
+extern uint32 RecordStore_countFrom(RecordStore_t *pStore, uint32 key);
+
+/*********************************************************************
+ * @fn      RecordStore_read
+ *
+ * @brief   Read a batch of records, oldest first, starting at sequence
+ *          number *pSeq and stopping after the last record with a key
+ *          lower than or equal to maxKey. Damaged records are skipped.
+ *          Call again with the updated *pSeq to get the next batch.
+ *
+ * @param   pStore - store
+ * @param   pSeq - in: first sequence number to read,
+ *                 out: sequence number to continue from
+ * @param   maxKey - highest key to return
+ * @param   pRecs - output, room for maxRecs records
+ * @param   pKeys - output, room for maxRecs keys, or NULL
+ * @param   maxRecs - maximum number of records to return
+ *
+ * @return  number of records returned, 0 at the end of the range
+ */
+extern uint16 RecordStore_read(RecordStore_t *pStore, uint32 *pSeq, uint32 maxKey,
+                               void *pRecs, uint32 *pKeys, uint16 maxRecs);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RECORD_STORE_H */
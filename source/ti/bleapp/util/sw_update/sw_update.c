@@ -56,12 +56,37 @@ Target Device: cc23xx
 #include "bootutil/image.h"
 #include "flash_interface.h"
 
+#ifdef SW_UPDATE_STREAM_VERIFY
+#include <ti/drivers/SHA2.h>
+#include <ti/drivers/sha2/SHA2LPF3SW.h>
+#endif
+
 /*********************************************************************
  * MACROS
  */
 
 #define SW_UPDATE_FLASH_PAGE(x,Ext)  Ext==0? FLASH_PAGE(x) :  EXT_FLASH_PAGE(x)
 
+/*
+ * Packed image stream, see SwUpdate_SetImageFormat. Each command starts
+ * with a token: 2 bits of op-code and a 6 bit length, 63 meaning that a
+ * varint with the rest of the length follows. Copies then carry a varint
+ * argument, literals carry their bytes.
+ */
+#define SW_UPDATE_OP(token)           ((token) >> 6)
+#define SW_UPDATE_OP_LITERAL          0   //!< length + 1 literal bytes
+#define SW_UPDATE_OP_COPY             1   //!< length + 4 bytes from distance bytes back in the new image
+#define SW_UPDATE_OP_COPY_BASE        2   //!< length + 4 bytes from the running image, at the same offset plus a zigzag delta
+#define SW_UPDATE_LEN_MASK            0x3F
+#define SW_UPDATE_MIN_COPY            4
+
+/*
+ * Running image used as the source of delta copies
+ */
+#ifdef APP_HDR_ADDR
+#define SW_UPDATE_BASE_IMG            ((const uint8 *)(APP_HDR_ADDR))
+#endif
+
 /*********************************************************************
  * LOCAL VARIABLES
  */
@@ -75,10 +100,48 @@ typedef struct
     struct image_header candidateImageHeader; //!< Store the candidate Image Header
     uint16              pageSize;             //!< Flash page size
     uint16              pageMask;             //!< Flash page mask
+#ifdef SW_UPDATE_STREAM_VERIFY
+    SHA2_Handle         hashHandle;           //!< Digest of the candidate image
+    uint32              hashEnd;              //!< Length of the hashed part of the image
+    uint32              writtenLen;           //!< Length of the image written in order so far
+    uint8               hashValid;            //!< FALSE if the image was not written in order
+#endif
+    uint32              imgLen;               //!< Length of the candidate image download
+    uint8               imgFormat;            //!< swUpdateImgFormat_e of the incoming data
+    uint32              streamLen;            //!< Length of the packed stream
+    uint32              streamPos;            //!< Packed bytes received
+    uint8*              pOutPage;             //!< Image page being rebuilt
+    uint32              outPageAddr;          //!< Image address of pOutPage
+    uint16              outFill;              //!< Bytes in pOutPage
+    uint32              outLen;               //!< Length of the image rebuilt from the stream
+    uint32              baseLen;              //!< Length of the running image for delta copies
+    uint8               decState;             //!< Stream decoder state
+    uint8               decOp;                //!< Op-code of the current command
+    uint8               decShift;             //!< Varint bit position
+    uint32              decLen;               //!< Length of the current command
+    uint32              decArg;               //!< Argument of the current command
 } swUpdateModuleGlobalData_t;
 
+/*!
+ * Packed stream decoder states
+ */
+typedef enum
+{
+    SW_UPDATE_DEC_TOKEN,       //!< Waiting for a token
+    SW_UPDATE_DEC_LEN,         //!< Reading the varint length
+    SW_UPDATE_DEC_ARG,         //!< Reading the varint argument of a copy
+    SW_UPDATE_DEC_LITERAL,     //!< Copying literals
+}swUpdateDecState_e;
+
 static swUpdateModuleGlobalData_t* pSwUpdateModuleGlobalData;
 
+#ifdef SW_UPDATE_STREAM_VERIFY
+// SHA2 instance used for the image digest, independent of SysConfig
+static SHA2LPF3SW_Object        swUpdateSha2Object;
+static const SHA2LPF3SW_HWAttrs swUpdateSha2HWAttrs = {0};
+static SHA2_Config              swUpdateSha2Config = {&swUpdateSha2Object, &swUpdateSha2HWAttrs};
+#endif
+
 #define HDR_OFFSET 0X0
 #define FLASH_OPEN 1
 
@@ -92,6 +155,17 @@ static swUpdateModuleGlobalData_t* pSwUpdateModuleGlobalData;
 /*********************************************************************
  * LOCAL FUNCTIONS - Prototypes
  */
+static Status_t swUpdateWriteRaw(uint32 blkStartAddr, uint16 len, uint8 *pValue);
+static Status_t swUpdateDecode(uint16 len, uint8 *pValue);
+static Status_t swUpdateCopy(void);
+static Status_t swUpdateOutByte(uint8 value);
+static Status_t swUpdateFlushOut(void);
+static void swUpdateResetStream(void);
+static uint8 swUpdateReadImage(uint32 addr, uint8 *pBuf, uint16 len);
+#ifdef SW_UPDATE_STREAM_VERIFY
+static void swUpdateStartDigest(void);
+static void swUpdateAddDigest(uint32 blkStartAddr, uint16 len, uint8 *pValue);
+#endif
 
 
 /*********************************************************************
@@ -119,7 +193,13 @@ Status_t SwUpdate_Open(swUpdateSource_e source)
         {
            return(FAILURE);
         }
+        pSwUpdateModuleGlobalData->pOutPage = NULL;
+        pSwUpdateModuleGlobalData->imgLen   = 0;
+#ifdef SW_UPDATE_STREAM_VERIFY
+        pSwUpdateModuleGlobalData->hashHandle = NULL;
+#endif
     }
+    swUpdateResetStream();
 
     // This variable controls whether the OAD module uses internal or external flash memory
     pSwUpdateModuleGlobalData->pageSize = hasExternalFlash()?EFL_PAGE_SIZE:INTFLASH_PAGE_SIZE;
@@ -144,6 +224,7 @@ Status_t SwUpdate_Open(swUpdateSource_e source)
  */
 void SwUpdate_Close(void)
 {
+    swUpdateResetStream();
     flash_close();
 }
 
@@ -174,8 +255,16 @@ int SwUpdate_CheckImageHeader(uint8 *imageHeader)
     }
     else
     {
-        candidateImageLength = pSwUpdateModuleGlobalData->candidateImageHeader.ih_img_size;
+        candidateImageLength = SW_UPDATE_IMAGE_LENGTH(&(pSwUpdateModuleGlobalData->candidateImageHeader));
     }
+    pSwUpdateModuleGlobalData->imgLen = candidateImageLength;
+
+    // A new image is raw until the peer selects another format
+    swUpdateResetStream();
+
+#ifdef SW_UPDATE_STREAM_VERIFY
+    swUpdateStartDigest();
+#endif
 
     return (candidateImageLength);
 }
@@ -238,7 +327,7 @@ Status_t SwUpdate_EraseImageSlot(uint8 imageSlot)
 {
     uint8 status = FLASH_SUCCESS;
 
-    uint32 imgLen = pSwUpdateModuleGlobalData->candidateImageHeader.ih_img_size;
+    uint32 imgLen = SW_UPDATE_IMAGE_LENGTH(&(pSwUpdateModuleGlobalData->candidateImageHeader));
     uint16 imgStartPage = 0;
     uint16 numFlashPages = imgLen/(pSwUpdateModuleGlobalData->pageSize);
 
@@ -265,7 +354,9 @@ Status_t SwUpdate_EraseImageSlot(uint8 imageSlot)
 /*********************************************************************
  * @fn      SwUpdate_WriteBlock
  *
- * @brief   Write image to flash block by block
+ * @brief   Write image to flash block by block. When the image comes as
+ *          a packed stream, blkStartAddr is the offset in the stream
+ *          and the blocks must come in order.
  *
  * @param   blkStartAddr - Address to write new block
  *          len - Block length, we assume that len can't be longer
@@ -276,6 +367,109 @@ Status_t SwUpdate_EraseImageSlot(uint8 imageSlot)
  *
  */
 Status_t SwUpdate_WriteBlock(uint32 blkStartAddr, uint16 len, uint8 *pValue)
+{
+    if(SW_UPDATE_IMG_FORMAT_RAW == pSwUpdateModuleGlobalData->imgFormat)
+    {
+        if((blkStartAddr > pSwUpdateModuleGlobalData->imgLen) ||
+           (len > pSwUpdateModuleGlobalData->imgLen - blkStartAddr))
+        {
+            return (FLASH_FAILURE);
+        }
+        return (swUpdateWriteRaw(blkStartAddr, len, pValue));
+    }
+
+    if((blkStartAddr != pSwUpdateModuleGlobalData->streamPos) ||
+       (blkStartAddr + len > pSwUpdateModuleGlobalData->streamLen))
+    {
+        return (FLASH_FAILURE);
+    }
+
+    return (swUpdateDecode(len, pValue));
+}
+
+/*********************************************************************
+ * @fn      SwUpdate_SetImageFormat
+ *
+ * @brief   Select how the next blocks of the candidate image are sent.
+ *          Must be called after SwUpdate_CheckImageHeader and before
+ *          the first block.
+ *
+ * @param   format - swUpdateImgFormat_e
+ *          streamLen - Length of the packed stream
+ *
+ * @return  SUCCESS, INVALIDPARAMETER if the format can't be used,
+ *          FAILURE if out of memory
+ *
+ */
+Status_t SwUpdate_SetImageFormat(uint8 format, uint32 streamLen)
+{
+    uint32 outLen = SW_UPDATE_IMAGE_LENGTH(&(pSwUpdateModuleGlobalData->candidateImageHeader));
+
+    swUpdateResetStream();
+
+    if(SW_UPDATE_IMG_FORMAT_RAW == format)
+    {
+        return (SUCCESS);
+    }
+
+    // The stream rebuilds the image described by the header, that must
+    // fit in the slot
+    if((0 == streamLen) || (outLen > pSwUpdateModuleGlobalData->imgLen) || (outLen > OFFCHIP_SLOT_SIZE))
+    {
+        return (INVALIDPARAMETER);
+    }
+
+    if(SW_UPDATE_IMG_FORMAT_DELTA == format)
+    {
+#ifdef SW_UPDATE_BASE_IMG
+        const struct image_header *pBaseHdr = (const struct image_header *)SW_UPDATE_BASE_IMG;
+
+        if(IMAGE_MAGIC != pBaseHdr->ih_magic)
+        {
+            return (INVALIDPARAMETER);
+        }
+        pSwUpdateModuleGlobalData->baseLen = SW_UPDATE_IMAGE_LENGTH(pBaseHdr);
+#else
+        return (INVALIDPARAMETER);
+#endif
+    }
+    else if(SW_UPDATE_IMG_FORMAT_PACKED != format)
+    {
+        return (INVALIDPARAMETER);
+    }
+
+    pSwUpdateModuleGlobalData->pOutPage = ICall_malloc(pSwUpdateModuleGlobalData->pageSize);
+    if(NULL == pSwUpdateModuleGlobalData->pOutPage)
+    {
+        return (FAILURE);
+    }
+
+    pSwUpdateModuleGlobalData->imgFormat = format;
+    pSwUpdateModuleGlobalData->streamLen = streamLen;
+    pSwUpdateModuleGlobalData->outLen    = outLen;
+
+    return (SUCCESS);
+}
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      swUpdateWriteRaw
+ *
+ * @brief   Write image bytes to flash, the page is erased when the
+ *          write reaches its start
+ *
+ * @param   blkStartAddr - Address to write new block
+ *          len - Block length, we assume that len can't be longer
+ *                than 1 page
+ *          pValue - Block data
+ *
+ * @return  SUCCESS or INVALIDPARAMETER
+ *
+ */
+static Status_t swUpdateWriteRaw(uint32 blkStartAddr, uint16 len, uint8 *pValue)
 {
     uint8 status = FLASH_SUCCESS;
     uint8 page = 0xFF;
@@ -307,5 +501,501 @@ Status_t SwUpdate_WriteBlock(uint32 blkStartAddr, uint16 len, uint8 *pValue)
         return (FLASH_FAILURE);
     }
 
+#ifdef SW_UPDATE_STREAM_VERIFY
+    swUpdateAddDigest(blkStartAddr, len, pValue);
+#endif
+
+    return (status);
+}
+
+/*********************************************************************
+ * @fn      SwUpdate_GetPageSize
+ *
+ * @brief   Size of the flash pages the image is written to. A block
+ *          that starts on a page boundary erases that page.
+ *
+ * @return  Page size in bytes
+ */
+uint16 SwUpdate_GetPageSize(void)
+{
+    return (pSwUpdateModuleGlobalData->pageSize);
+}
+
+/*********************************************************************
+ * @fn      swUpdateDecode
+ *
+ * @brief   Feed packed stream bytes to the decoder. The decoder keeps
+ *          its state between blocks, so commands may span blocks.
+ *
+ * @param   len - Length of pValue
+ *          pValue - Packed bytes
+ *
+ * @return  SUCCESS or FLASH_FAILURE
+ *
+ */
+static Status_t swUpdateDecode(uint16 len, uint8 *pValue)
+{
+    swUpdateModuleGlobalData_t *pData = pSwUpdateModuleGlobalData;
+    Status_t status = SUCCESS;
+    uint16 i = 0;
+
+    while((SUCCESS == status) && (i < len))
+    {
+        uint8 value = pValue[i++];
+
+        switch(pData->decState)
+        {
+            case SW_UPDATE_DEC_TOKEN:
+            {
+                pData->decOp = SW_UPDATE_OP(value);
+                pData->decLen = value & SW_UPDATE_LEN_MASK;
+                pData->decArg = 0;
+                pData->decShift = 0;
+                if(SW_UPDATE_LEN_MASK == pData->decLen)
+                {
+                    pData->decState = SW_UPDATE_DEC_LEN;
+                }
+                else if(SW_UPDATE_OP_LITERAL == pData->decOp)
+                {
+                    pData->decLen += 1;
+                    pData->decState = SW_UPDATE_DEC_LITERAL;
+                }
+                else if((SW_UPDATE_OP_COPY == pData->decOp) || (SW_UPDATE_OP_COPY_BASE == pData->decOp))
+                {
+                    pData->decLen += SW_UPDATE_MIN_COPY;
+                    pData->decState = SW_UPDATE_DEC_ARG;
+                }
+                else
+                {
+                    status = FLASH_FAILURE;
+                }
+                break;
+            }
+            case SW_UPDATE_DEC_LEN:
+            case SW_UPDATE_DEC_ARG:
+            {
+                uint32 *pVarint = (SW_UPDATE_DEC_LEN == pData->decState) ? &(pData->decLen) : &(pData->decArg);
+
+                if(pData->decShift > 28)
+                {
+                    status = FLASH_FAILURE;
+                    break;
+                }
+                *pVarint += (uint32)(value & 0x7F) << pData->decShift;
+                pData->decShift += 7;
+                if(value & 0x80)
+                {
+                    break;
+                }
+
+                pData->decShift = 0;
+                if(SW_UPDATE_DEC_ARG == pData->decState)
+                {
+                    status = swUpdateCopy();
+                    pData->decState = SW_UPDATE_DEC_TOKEN;
+                }
+                else if(SW_UPDATE_OP_LITERAL == pData->decOp)
+                {
+                    pData->decLen += 1;
+                    pData->decState = SW_UPDATE_DEC_LITERAL;
+                }
+                else if((SW_UPDATE_OP_COPY == pData->decOp) || (SW_UPDATE_OP_COPY_BASE == pData->decOp))
+                {
+                    pData->decLen += SW_UPDATE_MIN_COPY;
+                    pData->decState = SW_UPDATE_DEC_ARG;
+                }
+                else
+                {
+                    status = FLASH_FAILURE;
+                }
+                break;
+            }
+            case SW_UPDATE_DEC_LITERAL:
+            {
+                status = swUpdateOutByte(value);
+                if(0 == --(pData->decLen))
+                {
+                    pData->decState = SW_UPDATE_DEC_TOKEN;
+                }
+                break;
+            }
+            default:
+                status = FLASH_FAILURE;
+        }
+    }
+
+    pData->streamPos += len;
+
+    // Write the last partial page once the whole stream is in, the stream
+    // must have rebuilt the whole image
+    if((SUCCESS == status) && (pData->streamPos == pData->streamLen))
+    {
+        if(SW_UPDATE_DEC_TOKEN != pData->decState)
+        {
+            status = FLASH_FAILURE;
+        }
+        else if(0 != pData->outFill)
+        {
+            status = swUpdateFlushOut();
+        }
+        if((SUCCESS == status) && (pData->outPageAddr != pData->outLen))
+        {
+            status = FLASH_FAILURE;
+        }
+    }
+
+    return (status);
+}
+
+/*********************************************************************
+ * @fn      swUpdateCopy
+ *
+ * @brief   Run the copy command just decoded, from the rebuilt image or
+ *          from the running image
+ *
+ * @return  SUCCESS or FLASH_FAILURE
+ *
+ */
+static Status_t swUpdateCopy(void)
+{
+    swUpdateModuleGlobalData_t *pData = pSwUpdateModuleGlobalData;
+    uint32 outPos = pData->outPageAddr + pData->outFill;
+    Status_t status = SUCCESS;
+    uint8 buf[32];
+    uint32 src;
+
+    if(pData->decLen > pData->outLen - outPos)
+    {
+        return (FLASH_FAILURE);
+    }
+
+    if(SW_UPDATE_OP_COPY_BASE == pData->decOp)
+    {
+#ifdef SW_UPDATE_BASE_IMG
+        // Zigzag: even values are positive deltas, odd values negative
+        src = outPos + ((pData->decArg & 1) ? ~(pData->decArg >> 1) : (pData->decArg >> 1));
+        if((src > pData->baseLen) || (pData->decLen > pData->baseLen - src))
+        {
+            return (FLASH_FAILURE);
+        }
+        while((SUCCESS == status) && (pData->decLen > 0))
+        {
+            status = swUpdateOutByte(SW_UPDATE_BASE_IMG[src++]);
+            pData->decLen--;
+        }
+        return (status);
+#else
+        return (FLASH_FAILURE);
+#endif
+    }
+
+    if((0 == pData->decArg) || (pData->decArg > outPos))
+    {
+        return (FLASH_FAILURE);
+    }
+    src = outPos - pData->decArg;
+
+    while((SUCCESS == status) && (pData->decLen > 0))
+    {
+        if(src >= pData->outPageAddr)
+        {
+            // The source may overlap the bytes written by this copy
+            status = swUpdateOutByte(pData->pOutPage[src - pData->outPageAddr]);
+            src++;
+            pData->decLen--;
+        }
+        else
+        {
+            // Older bytes were already written to flash
+            uint16 chunk = sizeof(buf);
+            uint16 n;
+
+            if(chunk > pData->decLen)
+            {
+                chunk = pData->decLen;
+            }
+            if(chunk > pData->outPageAddr - src)
+            {
+                chunk = pData->outPageAddr - src;
+            }
+            if(FLASH_SUCCESS != swUpdateReadImage(src, buf, chunk))
+            {
+                return (FLASH_FAILURE);
+            }
+            for(n = 0; (SUCCESS == status) && (n < chunk); n++)
+            {
+                status = swUpdateOutByte(buf[n]);
+            }
+            src += chunk;
+            pData->decLen -= chunk;
+        }
+    }
+
+    return (status);
+}
+
+/*********************************************************************
+ * @fn      swUpdateOutByte
+ *
+ * @brief   Add a byte to the rebuilt image, writing each page when full
+ *
+ * @param   value - Image byte
+ *
+ * @return  SUCCESS, or FLASH_FAILURE past the end of the image
+ *
+ */
+static Status_t swUpdateOutByte(uint8 value)
+{
+    swUpdateModuleGlobalData_t *pData = pSwUpdateModuleGlobalData;
+
+    if(pData->outPageAddr + pData->outFill >= pData->outLen)
+    {
+        return (FLASH_FAILURE);
+    }
+    pData->pOutPage[pData->outFill++] = value;
+    if(pData->outFill == pData->pageSize)
+    {
+        return (swUpdateFlushOut());
+    }
+
+    return (SUCCESS);
+}
+
+/*********************************************************************
+ * @fn      swUpdateFlushOut
+ *
+ * @brief   Write the page being rebuilt to flash
+ *
+ * @return  SUCCESS or FLASH_FAILURE
+ *
+ */
+static Status_t swUpdateFlushOut(void)
+{
+    swUpdateModuleGlobalData_t *pData = pSwUpdateModuleGlobalData;
+    Status_t status;
+
+    status = swUpdateWriteRaw(pData->outPageAddr, pData->outFill, pData->pOutPage);
+    pData->outPageAddr += pData->outFill;
+    pData->outFill = 0;
+
+    return (status);
+}
+
+/*********************************************************************
+ * @fn      swUpdateResetStream
+ *
+ * @brief   Go back to raw image writes and free the decoder buffer
+ *
+ */
+static void swUpdateResetStream(void)
+{
+    swUpdateModuleGlobalData_t *pData = pSwUpdateModuleGlobalData;
+
+    if(NULL == pData)
+    {
+        return;
+    }
+    if(NULL != pData->pOutPage)
+    {
+        ICall_free(pData->pOutPage);
+        pData->pOutPage = NULL;
+    }
+    pData->imgFormat   = SW_UPDATE_IMG_FORMAT_RAW;
+    pData->streamLen   = 0;
+    pData->streamPos   = 0;
+    pData->outPageAddr = 0;
+    pData->outFill     = 0;
+    pData->outLen      = 0;
+    pData->baseLen     = 0;
+    pData->decState    = SW_UPDATE_DEC_TOKEN;
+}
+
+/*********************************************************************
+ * @fn      swUpdateReadImage
+ *
+ * @brief   Read from the candidate image, addressed like SwUpdate_WriteBlock
+ *
+ * @param   addr - Address to read
+ *          pBuf - Output buffer
+ *          len - Length to read
+ *
+ * @return  FLASH_SUCCESS or FLASH_FAILURE
+ */
+static uint8 swUpdateReadImage(uint32 addr, uint8 *pBuf, uint16 len)
+{
+    uint8 status = FLASH_SUCCESS;
+
+    while((FLASH_SUCCESS == status) && (len > 0))
+    {
+        uint32 offset = addr & (pSwUpdateModuleGlobalData->pageMask);
+        uint16 chunk = pSwUpdateModuleGlobalData->pageSize - offset;
+
+        if(chunk > len)
+        {
+            chunk = len;
+        }
+        status = readFlashPg(SW_UPDATE_FLASH_PAGE(addr,hasExternalFlash()), offset, pBuf, chunk);
+        addr += chunk;
+        pBuf += chunk;
+        len  -= chunk;
+    }
+
     return (status);
 }
+
+#ifdef SW_UPDATE_STREAM_VERIFY
+/*********************************************************************
+ * @fn      SwUpdate_VerifyImage
+ *
+ * @brief   Check the candidate image against the SHA256 TLV of its
+ *          trailer. The digest was computed while the blocks were
+ *          written, only the trailer is read back from flash.
+ *
+ * @return  SUCCESS or FAILURE
+ */
+Status_t SwUpdate_VerifyImage(void)
+{
+    uint8 digest[SHA2_DIGEST_LENGTH_BYTES_256];
+    uint8 expected[SHA2_DIGEST_LENGTH_BYTES_256];
+    struct image_tlv_info info;
+    struct image_tlv tlv;
+    uint32 addr;
+    uint32 end;
+    uint32 i;
+
+    // Blocks written out of order cannot be added on the fly, hash the
+    // image from flash instead
+    if(!pSwUpdateModuleGlobalData->hashValid)
+    {
+        uint8 buf[64];
+
+        SHA2_reset(pSwUpdateModuleGlobalData->hashHandle);
+        for(i = 0; i < pSwUpdateModuleGlobalData->hashEnd; i += sizeof(buf))
+        {
+            uint16 len = ((pSwUpdateModuleGlobalData->hashEnd - i) > sizeof(buf)) ?
+                         sizeof(buf) : (pSwUpdateModuleGlobalData->hashEnd - i);
+
+            if((FLASH_SUCCESS != swUpdateReadImage(i, buf, len)) ||
+               (SHA2_STATUS_SUCCESS != SHA2_addData(pSwUpdateModuleGlobalData->hashHandle, buf, len)))
+            {
+                return (FAILURE);
+            }
+        }
+    }
+    else if(pSwUpdateModuleGlobalData->writtenLen < pSwUpdateModuleGlobalData->hashEnd)
+    {
+        return (FAILURE);
+    }
+
+    if(SHA2_STATUS_SUCCESS != SHA2_finalize(pSwUpdateModuleGlobalData->hashHandle, digest))
+    {
+        return (FAILURE);
+    }
+    // The digest is final, a new verification needs the image again
+    pSwUpdateModuleGlobalData->hashValid = FALSE;
+
+    // The unprotected TLVs follow the hashed part of the image, up to the
+    // image length that was downloaded
+    addr = pSwUpdateModuleGlobalData->hashEnd;
+    if((FLASH_SUCCESS != swUpdateReadImage(addr, (uint8 *)&info, sizeof(info))) ||
+       (IMAGE_TLV_INFO_MAGIC != info.it_magic) ||
+       (SW_UPDATE_TLV_AREA_SIZE != info.it_tlv_tot))
+    {
+        return (FAILURE);
+    }
+    end = addr + info.it_tlv_tot;
+    addr += sizeof(info);
+
+    while(addr + sizeof(tlv) <= end)
+    {
+        if(FLASH_SUCCESS != swUpdateReadImage(addr, (uint8 *)&tlv, sizeof(tlv)))
+        {
+            return (FAILURE);
+        }
+        addr += sizeof(tlv);
+
+        if((IMAGE_TLV_SHA256 == tlv.it_type) && (SHA2_DIGEST_LENGTH_BYTES_256 == tlv.it_len))
+        {
+            if(FLASH_SUCCESS != swUpdateReadImage(addr, expected, sizeof(expected)))
+            {
+                return (FAILURE);
+            }
+            return ((0 == memcmp(digest, expected, sizeof(digest))) ? SUCCESS : FAILURE);
+        }
+        addr += tlv.it_len;
+    }
+
+    return (FAILURE);
+}
+
+/*********************************************************************
+ * @fn      swUpdateStartDigest
+ *
+ * @brief   Start the digest of a new candidate image. MCUboot hashes the
+ *          header, the image and the protected TLVs.
+ *
+ */
+static void swUpdateStartDigest(void)
+{
+    struct image_header *pHdr = &(pSwUpdateModuleGlobalData->candidateImageHeader);
+
+    if(NULL == pSwUpdateModuleGlobalData->hashHandle)
+    {
+        SHA2_Params params;
+
+        SHA2_init();
+        SHA2_Params_init(&params);
+        params.returnBehavior = SHA2_RETURN_BEHAVIOR_POLLING;
+        pSwUpdateModuleGlobalData->hashHandle = SHA2_construct(&swUpdateSha2Config, &params);
+    }
+    else
+    {
+        SHA2_reset(pSwUpdateModuleGlobalData->hashHandle);
+    }
+
+    pSwUpdateModuleGlobalData->hashEnd    = SW_UPDATE_IMAGE_LENGTH(pHdr) - SW_UPDATE_TLV_AREA_SIZE;
+    pSwUpdateModuleGlobalData->writtenLen = 0;
+    pSwUpdateModuleGlobalData->hashValid  = (NULL != pSwUpdateModuleGlobalData->hashHandle);
+}
+
+/*********************************************************************
+ * @fn      swUpdateAddDigest
+ *
+ * @brief   Add a block that was just written to the image digest
+ *
+ * @param   blkStartAddr - Address of the block
+ *          len - Block length
+ *          pValue - Block data
+ *
+ */
+static void swUpdateAddDigest(uint32 blkStartAddr, uint16 len, uint8 *pValue)
+{
+    uint32 hashLen = 0;
+
+    if(!pSwUpdateModuleGlobalData->hashValid)
+    {
+        return;
+    }
+
+    if(blkStartAddr != pSwUpdateModuleGlobalData->writtenLen)
+    {
+        pSwUpdateModuleGlobalData->hashValid = FALSE;
+        return;
+    }
+
+    if(blkStartAddr < pSwUpdateModuleGlobalData->hashEnd)
+    {
+        hashLen = pSwUpdateModuleGlobalData->hashEnd - blkStartAddr;
+        if(hashLen > len)
+        {
+            hashLen = len;
+        }
+        if(SHA2_STATUS_SUCCESS != SHA2_addData(pSwUpdateModuleGlobalData->hashHandle, pValue, hashLen))
+        {
+            pSwUpdateModuleGlobalData->hashValid = FALSE;
+        }
+    }
+    pSwUpdateModuleGlobalData->writtenLen += len;
+}
+
+#endif // SW_UPDATE_STREAM_VERIFY
@@ -62,6 +62,22 @@ extern "C"
  * MACROS
  */
 
+/*!
+ * Length of the unprotected TLV area that ends the images: the TLV info,
+ * and the SHA256, key hash and ECDSA P-256 signature TLVs of images signed
+ * with imgtool --pad-sig. The image header does not give it, a fixed size
+ * lets the download and the verification use the same image length.
+ */
+#ifndef SW_UPDATE_TLV_AREA_SIZE
+#define SW_UPDATE_TLV_AREA_SIZE   (4 + (4 + 32) + (4 + 32) + (4 + 72))
+#endif
+
+/*!
+ * Length of an image: header, body, protected TLVs and TLV area
+ */
+#define SW_UPDATE_IMAGE_LENGTH(pHdr)  ((uint32)(pHdr)->ih_hdr_size + (pHdr)->ih_img_size + \
+                                       (pHdr)->ih_protect_tlv_size + SW_UPDATE_TLV_AREA_SIZE)
+
 /*********************************************************************
  * TYPEDEFS
  */
@@ -73,6 +89,16 @@ typedef enum
     SW_UPDATE_SOURCE_OAD,          //!<this mode is for OAD
 }swUpdateSource_e;
 
+/*!
+ * Format of the candidate image data given to SwUpdate_WriteBlock
+ */
+typedef enum
+{
+    SW_UPDATE_IMG_FORMAT_RAW    = 0,  //!< Image bytes as they are written to flash
+    SW_UPDATE_IMG_FORMAT_PACKED = 1,  //!< Compressed stream, see tools/oad/oad_image_pack.py
+    SW_UPDATE_IMG_FORMAT_DELTA  = 2,  //!< Compressed stream that may also copy from the running image
+}swUpdateImgFormat_e;
+
 /*!
  * This error will return from SwUpdate_CheckImageHeader if there is problem with header
  */
@@ -108,7 +134,8 @@ extern void SwUpdate_Close(void);
  *
  * @param   image header
  *
- * @return  Image_len or INVALID_HEADER
+ * @return  Image_len, SW_UPDATE_IMAGE_LENGTH of the header or the slot
+ *          size with external flash, or INVALID_HEADER
  */
 extern int SwUpdate_CheckImageHeader(uint8 *imageHeader);
 
@@ -162,6 +189,48 @@ extern Status_t SwUpdate_EraseFlash(uint8 imageSlot);
  *
  */
 extern Status_t SwUpdate_WriteBlock(uint32 blkStartAddr, uint16 len, uint8 *pValue);
+
+/*********************************************************************
+ * @fn      SwUpdate_SetImageFormat
+ *
+ * @brief   Select how the next blocks of the candidate image are sent.
+ *          Must be called after SwUpdate_CheckImageHeader and before
+ *          the first block. For packed formats, blkStartAddr of
+ *          SwUpdate_WriteBlock is the offset in the stream and the
+ *          blocks must come in order.
+ *
+ * @param   format - swUpdateImgFormat_e
+ *          streamLen - Length of the packed stream
+ *
+ * @return  SUCCESS, INVALIDPARAMETER if the format can't be used,
+ *          FAILURE if out of memory
+ *
+ */
+extern Status_t SwUpdate_SetImageFormat(uint8 format, uint32 streamLen);
+
+/*********************************************************************
+ * @fn      SwUpdate_GetPageSize
+ *
+ * @brief   Size of the flash pages the image is written to. A block
+ *          that starts on a page boundary erases that page.
+ *
+ * @return  Page size in bytes
+ */
+extern uint16 SwUpdate_GetPageSize(void);
+
+#ifdef SW_UPDATE_STREAM_VERIFY
+/*********************************************************************
+ * @fn      SwUpdate_VerifyImage
+ *
+ * @brief   Check the candidate image against the SHA256 TLV of its
+ *          trailer. The digest is computed while SwUpdate_WriteBlock
+ *          writes the image, so only the trailer is read from flash.
+ *          The trailer must fill the image up to SW_UPDATE_IMAGE_LENGTH.
+ *
+ * @return  SUCCESS or FAILURE
+ */
+extern Status_t SwUpdate_VerifyImage(void);
+#endif
 /*********************************************************************
  * CONSTANTS
  */
@@ -158,6 +158,14 @@ typedef struct nvintf_nvproxy_t
     uint8_t  flag;    // User specifies requested operation by settings flags
 } NVINTF_nvProxy_t;
 
+// Item descriptor used by writeItems()
+typedef struct nvintf_batchitem_t
+{
+    NVINTF_itemID_t id;     // Item to write
+    uint16_t        len;    // Length of item data (0 is illegal)
+    void *          buffer; // Item data (NULL is illegal)
+} NVINTF_batchItem_t;
+
 //! Function pointer definition for the NVINTF_initNV() function
 typedef uint8_t (*NVINTF_initNV)(void *param);
 
@@ -219,6 +227,13 @@ typedef uint8_t (*NVINTF_eraseNV)(void);
 //! Function pointer definition for the NVINTF_getFreeNV() function
 typedef uint32_t (*NVINTF_getFreeNV)(void);
 
+//! Function pointer definition for the NVINTF_writeItems() function
+typedef uint8_t (*NVINTF_writeItems)(NVINTF_batchItem_t *items,
+                                     uint8_t count);
+
+//! Function pointer definition for the NVINTF_compactStep() function
+typedef uint8_t (*NVINTF_compactStep)(uint16_t minBytes);
+
 #ifdef ENABLE_SANITY_CHECK
 //! Function pointer definition for the NVINTF_sanityCheck() function
 typedef uint32_t (*NVINTF_sanityCheck)(void);
@@ -261,6 +276,10 @@ typedef struct nvintf_nvfuncts_t
     //! Sanity Check function
     NVINTF_sanityCheck sanityCheck;
 #endif
+    //! Write several items as one atomic group
+    NVINTF_writeItems writeItems;
+    //! Incremental compact NV function
+    NVINTF_compactStep compactStep;
 } NVINTF_nvFuncts_t;
 
 //*****************************************************************************
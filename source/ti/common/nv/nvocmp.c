@@ -53,6 +53,8 @@ This driver implements a non-volatile (NV) memory system that utilizes multi pag
 are ACTIVE and the remaining one page is available for "compaction" when the ACTIVE
 pages do not have enough empty space for data write operation. Compaction can occur
 'just in time' during a data write operation or 'on demand' by application request.
+The application can also compact one page at a time with compactStep(), typically
+from an idle hook, so that writes rarely have to wait for a compaction.
 The compaction process is designed to survive a power cycle before it completes. It
 will resume where it was interrupted and complete the process.
 
@@ -95,6 +97,16 @@ effectively disable this feature for cc23x0 and cc27xx.
 When RAM optimization is enabled, the user can configure the size of the
 working buffer by setting NVOCMP_RAM_BUFFER_SIZE, which defaults to 500.
 
+Related items can be written as one group with the writeItems() API. The items
+of a group are packed on one page, each with its VALID bit still unprogrammed,
+and followed by a driver 'batch marker' item that records the number of items
+and the bytes they span. Items that are not valid are ignored by searches and
+dropped by compaction, so a group interrupted by a power loss simply disappears.
+Programming the VALID bit of the marker commits the group. The item VALID bits
+are then programmed, the previous copies of the items are marked inactive and
+finally the marker itself is marked inactive. If power is lost after the commit
+the remaining steps are completed during initialization.
+
 */
 //*****************************************************************************
 // Use / Configuration
@@ -131,12 +143,12 @@ nvFps.initNV(NULL);
 nvFps.compactNV(NULL);
 status = nvFps.readItem(id, 0, len, buf);
 
-Note: Each item operation results in a traversal of the page starting at
-the most recently written item. This makes 'finding' items by 'trying' item IDs
-in order extremely inefficient. The doNext() API call allows the user to find,
-read, or delete items in one page traversal. However, this call requires the
-user to lock access to NV until the operation is complete so it should be used
-carefully and sparingly.
+Note: Unless NVOCMP_RAM_INDEX is defined, each item operation results in a
+traversal of the page starting at the most recently written item. This makes
+'finding' items by 'trying' item IDs in order extremely inefficient. The
+doNext() API call allows the user to find, read, or delete items in one page
+traversal. However, this call requires the user to lock access to NV until the
+operation is complete so it should be used carefully and sparingly.
 
 Note: The compile flag NVDEBUG can be passed to enable ASSERT and ALERT
 macros which provide assert and logging functionality. When this flag is used,
@@ -176,6 +188,22 @@ is enabled by default on this family of devices.
 NVOCMP_RAM_BUFFER_SIZE - Sets the size for the RAM buffer used when
 RAM optimization is enabled. Default value is 500.
 
+NVOCMP_RAM_INDEX - Enables a RAM table which maps the compressed ID of each
+active item to the page and offset of its newest header. The table is built
+when the driver initializes, updated on item writes and deletes, and rebuilt
+lazily after compaction. Read, update, delete and getItemLen then locate an
+item without traversing the NV pages. Each cached location is checked against
+the item header in Flash before use, so a stale entry only costs a fallback
+to the normal page traversal.
+NVOCMP_RAM_INDEX_SIZE - Number of items the RAM index can hold, 8 bytes each.
+Default value is 64. When more items are stored, lookups of the items that
+did not fit fall back to the normal page traversal.
+
+NVOCMP_BATCHMAX - Maximum number of items in one writeItems() group. Default
+value is 8.
+NVOCMP_BATCHBUFLEN - Size of the RAM buffer used by writeItems() to combine
+small items and item headers into one Flash write. Default value is 32.
+
 Dependencies:
 Requires NVS for NV access.
 Requires TI-RTOS GateMutexPri or POSIX mutex to be enabled in configuration.
@@ -275,11 +303,32 @@ Requires API's in a crc.h to implement CRC functionality.
 // in RAM before write, instead of header/data written separately
 #define NVOCMP_SMALLITEM    12
 
+// Maximum number of items in one writeItems() group
+#ifndef NVOCMP_BATCHMAX
+#define NVOCMP_BATCHMAX     8
+#endif
+
+// Size in bytes of the RAM buffer used to combine the pieces of a
+// writeItems() group into fewer Flash writes
+#ifndef NVOCMP_BATCHBUFLEN
+#define NVOCMP_BATCHBUFLEN  32
+#endif
+
+// Batch marker data: item count (1 byte) and group span (2 bytes)
+#define NVOCMP_BATCHDATALEN 3
+
+// Attempts at locating the copies replaced by a writeItems() group while
+// compactions keep moving them
+#define NVOCMP_BATCHLOCTRIES 3
+
 #if defined (NVOCMP_STATS)
 // NV item ID for driver diagnostics
 static const NVINTF_itemID_t diagId = NVOCMP_NVID_DIAG;
 #endif  // NVOCMP_STATS
 
+// NV item ID for the marker closing a writeItems() group
+static const NVINTF_itemID_t batchId = NVOCMP_NVID_BATCH;
+
 // CRC options
 // When not NULL, reads will result in a CRC check before returning
 #define NVOCMP_CRCONREAD    1
@@ -600,6 +649,21 @@ typedef struct
   uint16_t rlength;           // Length content to read
 } NVOCMP_itemInfo_t;
 
+// Location of the copy of an item replaced by a writeItems() group
+typedef struct
+{
+  uint8_t  hpage;             // Page of the item header
+  uint16_t hofs;              // Offset of the item header, 0 if none
+} NVOCMP_batchLoc_t;
+
+// Flash write combiner used by writeItems()
+typedef struct
+{
+  uint8_t  pg;                // Destination page
+  uint16_t ofs;               // Page offset of the first buffered byte
+  uint16_t fill;              // Number of buffered bytes
+} NVOCMP_stage_t;
+
 typedef enum NVOCMP_initAction {
   NVOCMP_NORMAL_INIT = 0,
   NVOCMP_NORMAL_RESUME,
@@ -655,6 +719,31 @@ typedef struct
   NVOCMP_compactInfo_t compactInfo;
   NVOCMP_pageInfo_t pageInfo[NVOCMP_NVPAGES];
 } NVOCMP_nvHandle_t;
+
+#ifdef NVOCMP_RAM_INDEX
+#ifndef NVOCMP_RAM_INDEX_SIZE
+#define NVOCMP_RAM_INDEX_SIZE   64
+#endif
+
+// RAM index states
+#define NVOCMP_RIDX_STALE       0   // Must be rebuilt before next lookup
+#define NVOCMP_RIDX_PARTIAL     1   // Hits are valid, misses need a page search
+#define NVOCMP_RIDX_COMPLETE    2   // Every active item is in the index
+
+typedef struct
+{
+  uint32_t cmpid;           // Compressed ID, sort key
+  uint16_t hofs;            // Offset of newest item header
+  uint8_t  hpage;           // Page of newest item header
+} NVOCMP_ramIdxEntry_t;
+
+typedef struct
+{
+  uint8_t  state;           // NVOCMP_RIDX_xxx
+  uint16_t count;           // Number of valid entries
+  NVOCMP_ramIdxEntry_t entry[NVOCMP_RAM_INDEX_SIZE];
+} NVOCMP_ramIdx_t;
+#endif
 //*****************************************************************************
 // Local variables
 //*****************************************************************************
@@ -704,6 +793,13 @@ static GateMutexPri_Handle NVOCMP_gMutexPri;
 // Small NV Item Buffer, for item construction
 static uint8_t NVOCMP_itemBuffer[NVOCMP_SMALLITEM];
 
+// Buffer to combine writeItems() data and headers
+static uint8_t NVOCMP_batchBuf[NVOCMP_BATCHBUFLEN];
+
+// Incremented whenever a compaction may move items, so a caller holding item
+// locations can tell they have to be looked up again
+static uint8_t NVOCMP_compactGen;
+
 // Function Pointer to an optional user provided voltage check function
 static bool (*NVOCMP_voltCheckFptr)(void);
 // Diagnostic counter for bad CRCs
@@ -714,12 +810,18 @@ static uint16_t NVOCMP_badCRCCount = 0;
 NVOCMP_initAction_t gAction;
 uint8_t NVOCMP_size;
 
+#ifdef NVOCMP_RAM_INDEX
+// Item location index, sorted by compressed ID
+static NVOCMP_ramIdx_t NVOCMP_ramIdx;
+#endif
+
 //*****************************************************************************
 // NV API Function Prototypes
 //*****************************************************************************
 
 static uint8_t    NVOCMP_initNvApi(void *param);
 static uint8_t    NVOCMP_compactNvApi(uint16_t min);
+static uint8_t    NVOCMP_compactStepApi(uint16_t min);
 static uint8_t    NVOCMP_createItemApi(NVINTF_itemID_t id, uint32_t len, void *buf);
 static uint8_t    NVOCMP_updateItemApi(NVINTF_itemID_t id, uint32_t len, void *buf);
 static uint8_t    NVOCMP_deleteItemApi(NVINTF_itemID_t id);
@@ -736,6 +838,7 @@ static void       NVOCMP_unlockNvApi(int32_t);
 static bool       NVOCMP_expectCompApi(uint16_t len);
 static uint8_t    NVOCMP_eraseNvApi(void);
 static uint32_t   NVOCMP_getFreeNvApi(void);
+static uint8_t    NVOCMP_writeItemsApi(NVINTF_batchItem_t *pItems, uint8_t count);
 
 #ifdef ENABLE_SANITY_CHECK
 static uint32_t   NVOCMP_sanityCheckApi(void);
@@ -764,6 +867,7 @@ static void       NVOCMP_setPageState(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg,
                                       NVOCMP_pageState_t state);
 static void       NVOCMP_setItemInactive(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg,
                                          uint16_t iOfs);
+static void       NVOCMP_clearAllActive(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg);
 static uint8_t    NVOCMP_readItem(NVOCMP_itemHdr_t *iHdr, uint16_t ofs, uint16_t len,
                                   void *pBuf, bool flag);
 static uint8_t    NVOCMP_checkItem(NVINTF_itemID_t *id, uint16_t len, NVOCMP_itemHdr_t *iHdr,
@@ -779,6 +883,25 @@ static uint8_t    NVOCMP_doRAMCRC(uint8_t *input, uint16_t len, uint8_t crc);
 static uint8_t    NVOCMP_verifyCRC(uint16_t iOfs, uint16_t len, uint8_t crc, uint8_t pg, bool flag);
 static uint8_t    NVOCMP_readByte(uint8_t pg, uint16_t ofs);
 static void       NVOCMP_writeByte(uint8_t pg, uint16_t ofs, uint8_t bwv);
+static void       NVOCMP_packHeader(NVOCMP_itemHdr_t *pHdr, uint8_t *pBuf, cmpIH_t cHdr,
+                                    bool pending);
+static void       NVOCMP_setItemValid(uint8_t pg, uint16_t iOfs);
+static void       NVOCMP_stagePut(NVOCMP_stage_t *pStage, uint8_t *pBuf, uint16_t len);
+static void       NVOCMP_stageFlush(NVOCMP_stage_t *pStage);
+static void       NVOCMP_applyBatch(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg, uint16_t mOfs,
+                                    NVOCMP_batchLoc_t *pOld);
+static void       NVOCMP_finishBatch(NVOCMP_nvHandle_t *pNvHandle);
+static bool       NVOCMP_hasInactive(NVOCMP_nvHandle_t *pNvHandle);
+static int8_t     NVOCMP_findActiveItem(NVOCMP_nvHandle_t *pNvHandle, NVOCMP_itemHdr_t *pHdr);
+
+#ifdef NVOCMP_RAM_INDEX
+static void       NVOCMP_buildIndex(NVOCMP_nvHandle_t *pNvHandle);
+static bool       NVOCMP_findIndex(NVOCMP_nvHandle_t *pNvHandle, NVOCMP_itemHdr_t *pHdr,
+                                   int8_t *pStatus);
+static uint16_t   NVOCMP_searchIndex(uint32_t cmpid, bool *pFound);
+static void       NVOCMP_insertIndex(uint32_t cmpid, uint8_t pg, uint16_t hofs, bool replace);
+static void       NVOCMP_removeIndex(uint8_t pg, uint16_t hofs);
+#endif
 
 #if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
 static uint8_t    NVOCMP_findDstPage(NVOCMP_nvHandle_t *pNvHandle);
@@ -828,6 +951,8 @@ void NVOCMP_loadApiPtrs(NVINTF_nvFuncts_t *pfn)
     pfn->expectComp   = &NVOCMP_expectCompApi;
     pfn->eraseNV      = &NVOCMP_eraseNvApi;
     pfn->getFreeNV    = &NVOCMP_getFreeNvApi;
+    pfn->writeItems   = &NVOCMP_writeItemsApi;
+    pfn->compactStep  = &NVOCMP_compactStepApi;
 #ifdef ENABLE_SANITY_CHECK
     pfn->sanityCheck  = &NVOCMP_sanityCheckApi;
 #endif
@@ -857,12 +982,14 @@ void NVOCMP_loadApiPtrsMin(NVINTF_nvFuncts_t *pfn)
     pfn->readContItem = NULL;
     pfn->writeItem    = &NVOCMP_writeItemApi;
     pfn->getItemLen   = NULL;
-    pfn->lockNV       = NULL;
-    pfn->unlockNV     = NULL;
-    pfn->doNext       = NULL;
+    pfn->lockNV       = &NVOCMP_lockNvApi;
+    pfn->unlockNV     = &NVOCMP_unlockNvApi;
+    pfn->doNext       = &NVOCMP_doNextApi;
     pfn->expectComp   = &NVOCMP_expectCompApi;
     pfn->eraseNV      = &NVOCMP_eraseNvApi;
     pfn->getFreeNV    = &NVOCMP_getFreeNvApi;
+    pfn->writeItems   = NULL;
+    pfn->compactStep  = NULL;
 #ifdef ENABLE_SANITY_CHECK
     pfn->sanityCheck  = &NVOCMP_sanityCheckApi;
 #endif
@@ -897,6 +1024,8 @@ void NVOCMP_loadApiPtrsExt(NVINTF_nvFuncts_t *pfn)
     pfn->expectComp   = &NVOCMP_expectCompApi;
     pfn->eraseNV      = &NVOCMP_eraseNvApi;
     pfn->getFreeNV    = &NVOCMP_getFreeNvApi;
+    pfn->writeItems   = &NVOCMP_writeItemsApi;
+    pfn->compactStep  = &NVOCMP_compactStepApi;
 #ifdef ENABLE_SANITY_CHECK
     pfn->sanityCheck  = &NVOCMP_sanityCheckApi;
 #endif
@@ -1019,7 +1148,7 @@ static uint8_t NVOCMP_initNvApi(void *param)
             return(NVOCMP_failF);
         }
 
-#ifndef NV_LINUX
+#if !defined(NV_LINUX) && !defined(__linux__)
         attr.type = PTHREAD_MUTEX_RECURSIVE;
 #else
         pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
@@ -1090,6 +1219,14 @@ static uint8_t NVOCMP_initNvApi(void *param)
 
         NVOCMP_initNv(&NVOCMP_nvHandle);
 
+        // Complete a writeItems() group committed before a power loss
+        NVOCMP_finishBatch(&NVOCMP_nvHandle);
+
+#ifdef NVOCMP_RAM_INDEX
+        // Locate all active items once so lookups need not search pages
+        NVOCMP_buildIndex(&NVOCMP_nvHandle);
+#endif
+
 #if defined (NVOCMP_STATS)
         {
             uint8_t err;
@@ -1155,6 +1292,12 @@ static uint8_t NVOCMP_eraseNvApi(void)
   NVOCMP_changePageState(&NVOCMP_nvHandle, NVOCMP_nvHandle.headPage, NVOCMP_PGRDY);
   NVOCMP_changePageState(&NVOCMP_nvHandle, NVOCMP_nvHandle.tailPage, NVOCMP_PGXDST);
 
+#ifdef NVOCMP_RAM_INDEX
+  // NV is empty, nothing left to index
+  NVOCMP_ramIdx.count = 0;
+  NVOCMP_ramIdx.state = NVOCMP_RIDX_COMPLETE;
+#endif
+
 #ifdef NV_LINUX
     if(err == NVINTF_SUCCESS)
     {
@@ -1200,6 +1343,37 @@ static uint32_t NVOCMP_getFreeNvApi(void)
   return(freespace);
 }
 
+/******************************************************************************
+ * @fn      NVOCMP_hasInactive
+ *
+ * @brief   Local function to check if compaction would reclaim any space
+ *
+ * @param   pNvHandle - pointer to NV handle
+ *
+ * @return  true if a data page holds inactive items
+ */
+static bool NVOCMP_hasInactive(NVOCMP_nvHandle_t *pNvHandle)
+{
+  uint8_t pg;
+  NVOCMP_pageHdr_t pageHdr;
+
+  for(pg = 0; pg < NVOCMP_NVSIZE; pg++)
+  {
+#if (NVOCMP_NVPAGES > NVOCMP_NVONEP)
+    if(pg == pNvHandle->tailPage)
+    {
+      continue;
+    }
+#endif
+    NVOCMP_read(pg, NVOCMP_PGHDROFS, (uint8_t *)&pageHdr, NVOCMP_PGHDRLEN);
+    if(!pageHdr.allActive)
+    {
+      return(true);
+    }
+  }
+  return(false);
+}
+
 /******************************************************************************
  * @fn      NVOCMP_compactNvApi
  *
@@ -1258,6 +1432,60 @@ static uint8_t NVOCMP_compactNvApi(uint16_t minAvail)
     NVOCMP_UNLOCK(err);
 }
 
+/******************************************************************************
+ * @fn      NVOCMP_compactStepApi
+ *
+ * @brief   API function to do a bounded amount of compaction. Each call
+ *          reclaims at most one NV page: the oldest page holding inactive
+ *          items has its active items moved to the compaction page and is
+ *          then erased. Pages holding only active items are not copied.
+ *          Meant to be called from an idle hook or a low priority task, so
+ *          that a write only has to compact when NV has no free room left.
+ *
+ * @param   minAvail - threshold size of free bytes in NV to do a step:
+ *                     0 = always, >0 = minimum free bytes to keep. Should
+ *                     stay well below the NV capacity, otherwise every call
+ *                     with any inactive item present costs a page erase.
+ *
+ * @return  NVINTF_SUCCESS or specific failure code
+ */
+static uint8_t NVOCMP_compactStepApi(uint16_t minAvail)
+{
+    uint8_t err = NVINTF_SUCCESS;
+
+    // Check voltage if possible
+    NVOCMP_FLASHACCESS(err)
+    if(err)
+    {
+      return(err);
+    }
+
+    // Prevent RTOS thread contention
+    NVOCMP_LOCK();
+    err = NVOCMP_failF;
+    // Check for a fatal error
+    if(err == NVINTF_SUCCESS)
+    {
+        if(((minAvail == 0) || (NVOCMP_getFreeNvApi() < minAvail)) &&
+           NVOCMP_hasInactive(&NVOCMP_nvHandle))
+        {
+            // Update mode compaction stops once one page is reclaimed
+            (void)NVOCMP_compactPage(&NVOCMP_nvHandle, NVOCMP_ITEMHDRLEN + 1);
+            // 'failW' indicates compaction status
+            err = NVOCMP_failW;
+        }
+    }
+
+#ifdef NV_LINUX
+    if(err == NVINTF_SUCCESS)
+    {
+        NV_LINUX_save();
+    }
+#endif
+
+    NVOCMP_UNLOCK(err);
+}
+
 //*****************************************************************************
 // API Functions - NV Data Items
 //*****************************************************************************
@@ -1301,8 +1529,7 @@ static uint8_t NVOCMP_createItemApi(NVINTF_itemID_t id, uint32_t len, void *pBuf
     // Prevent RTOS thread contention
     NVOCMP_LOCK();
 
-    err = NVOCMP_findItem(&NVOCMP_nvHandle, NVOCMP_nvHandle.actPage, NVOCMP_nvHandle.actOffset, &iHdr,
-                          NVOCMP_FINDSTRICT, NULL);
+    err = NVOCMP_findActiveItem(&NVOCMP_nvHandle, &iHdr);
 
     if(err == NVINTF_SUCCESS)
     {
@@ -1373,8 +1600,7 @@ static uint8_t NVOCMP_updateItemApi(NVINTF_itemID_t id, uint32_t len, void *pBuf
     // Prevent RTOS thread contention
     NVOCMP_LOCK();
 
-    err = NVOCMP_findItem(&NVOCMP_nvHandle, NVOCMP_nvHandle.actPage, NVOCMP_nvHandle.actOffset, &iHdr,
-                          NVOCMP_FINDSTRICT, NULL);
+    err = NVOCMP_findActiveItem(&NVOCMP_nvHandle, &iHdr);
 
     if(err == NVINTF_SUCCESS)
     {
@@ -1448,8 +1674,7 @@ static uint8_t NVOCMP_deleteItemApi(NVINTF_itemID_t id)
     // Prevent RTOS thread contention
     NVOCMP_LOCK();
 
-    err = NVOCMP_findItem(&NVOCMP_nvHandle, NVOCMP_nvHandle.actPage, NVOCMP_nvHandle.actOffset, &iHdr,
-                          NVOCMP_FINDSTRICT, NULL);
+    err = NVOCMP_findActiveItem(&NVOCMP_nvHandle, &iHdr);
 
     if(!err)
     {
@@ -1457,8 +1682,7 @@ static uint8_t NVOCMP_deleteItemApi(NVINTF_itemID_t id)
       NVOCMP_setItemInactive(&NVOCMP_nvHandle, iHdr.hpage, iHdr.hofs);
 
       // Verify that item has been removed
-      err = (NVOCMP_findItem(&NVOCMP_nvHandle, NVOCMP_nvHandle.actPage, NVOCMP_nvHandle.actOffset,
-                             &iHdr, NVOCMP_FINDSTRICT, NULL) == NVINTF_NOTFOUND) ?
+      err = (NVOCMP_findActiveItem(&NVOCMP_nvHandle, &iHdr) == NVINTF_NOTFOUND) ?
                              NVOCMP_failW : NVINTF_FAILURE;
 
       // If item did get deleted, report 'failW' status
@@ -1500,8 +1724,7 @@ static uint32_t NVOCMP_getItemLenApi(NVINTF_itemID_t id)
     NVOCMP_LOCK();
 
     // If there was any error, report zero length
-    len = (NVOCMP_findItem(&NVOCMP_nvHandle, NVOCMP_nvHandle.actPage, NVOCMP_nvHandle.actOffset, &iHdr,
-                           NVOCMP_FINDSTRICT, NULL) != NVINTF_SUCCESS) ? 0 : iHdr.len;
+    len = (NVOCMP_findActiveItem(&NVOCMP_nvHandle, &iHdr) != NVINTF_SUCCESS) ? 0 : iHdr.len;
 
     NVOCMP_UNLOCK(len);
 }
@@ -1595,8 +1818,7 @@ static uint8_t NVOCMP_readItemApi(NVINTF_itemID_t id, uint16_t ofs, uint16_t len
     // Prevent RTOS thread contention
     NVOCMP_LOCK();
 
-    err = NVOCMP_findItem(&NVOCMP_nvHandle, NVOCMP_nvHandle.actPage, NVOCMP_nvHandle.actOffset, &iHdr,
-                          NVOCMP_FINDSTRICT, NULL);
+    err = NVOCMP_findActiveItem(&NVOCMP_nvHandle, &iHdr);
 
     // Read Item
     if (!err)
@@ -1670,6 +1892,180 @@ static uint8_t NVOCMP_writeItemApi(NVINTF_itemID_t id, uint16_t len, void *pBuf)
     NVOCMP_UNLOCK(err);
 }
 
+/******************************************************************************
+ * @fn      NVOCMP_writeItemsApi
+ *
+ * @brief   API function to write a group of items atomically, creating the
+ *          items as needed. The group is stored in one pass: the lock is
+ *          taken once, free space is checked once and small items and item
+ *          headers are combined into as few Flash writes as possible. After
+ *          a power loss either all or none of the items hold the new data.
+ *          An item may only appear once in a group and SYSID 0 is reserved
+ *          for the driver.
+ *
+ * @param   pItems - array of items to write (NULL is illegal)
+ * @param   count  - number of items in the array (1 to NVOCMP_BATCHMAX)
+ *
+ * @return  NVINTF_SUCCESS or specific failure code
+ */
+static uint8_t NVOCMP_writeItemsApi(NVINTF_batchItem_t *pItems, uint8_t count)
+{
+    uint8_t err;
+    uint8_t i, j;
+    uint8_t dstPg;
+    uint16_t mOfs;
+    uint32_t span = 0;
+    uint16_t iLen;
+    cmpIH_t cHdr;
+    NVOCMP_itemHdr_t iHdr;
+    NVOCMP_stage_t stage;
+    NVOCMP_batchLoc_t oldLoc[NVOCMP_BATCHMAX];
+    uint8_t mData[NVOCMP_BATCHDATALEN];
+
+    // Parameter Sanity Check
+    if((pItems == NULL) || (count == 0) || (count > NVOCMP_BATCHMAX))
+    {
+        return(NVINTF_BADPARAM);
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        if((pItems[i].buffer == NULL) || (pItems[i].len == 0))
+        {
+            return(NVINTF_BADPARAM);
+        }
+        if(pItems[i].id.systemID == NVINTF_SYSID_NVDRVR)
+        {
+            return(NVINTF_BADSYSID);
+        }
+        err = NVOCMP_checkItem(&pItems[i].id, pItems[i].len, &iHdr, NVOCMP_FINDSTRICT);
+        if(err)
+        {
+            return(err);
+        }
+        for(j = 0; j < i; j++)
+        {
+            if(NVOCMP_CMPRID(pItems[j].id.systemID, pItems[j].id.itemID,
+                             pItems[j].id.subID) == iHdr.cmpid)
+            {
+                // Two copies of one item cannot be part of the same group
+                return(NVINTF_BADPARAM);
+            }
+        }
+        span += NVOCMP_ITEMHDRLEN + pItems[i].len;
+    }
+
+    // The whole group and its marker must fit on one page
+    if((span + NVOCMP_ITEMHDRLEN + NVOCMP_BATCHDATALEN) > NVOCMP_PGDATALEN)
+    {
+        return(NVINTF_BADLENGTH);
+    }
+    iLen = (uint16_t)span + NVOCMP_ITEMHDRLEN + NVOCMP_BATCHDATALEN;
+
+    // Check voltage if possible
+    NVOCMP_FLASHACCESS(err)
+    if(err)
+    {
+      return(err);
+    }
+
+    // Prevent RTOS thread contention
+    NVOCMP_LOCK();
+
+    if(NVOCMP_getDstPage(&NVOCMP_nvHandle, iLen) == NVOCMP_NULLPAGE)
+    {
+        // Won't fit on the active page, compact and check again
+        if(NVOCMP_compactPage(&NVOCMP_nvHandle, iLen) < iLen)
+        {
+            NVOCMP_ALERT(false, "Out of NV.")
+            err = (NVOCMP_failW != NVINTF_SUCCESS) ? NVOCMP_failW : NVINTF_BADLENGTH;
+            NVOCMP_UNLOCK(err);
+        }
+    }
+
+    // Locate the copies this group replaces. A search that meets a corrupted
+    // item compacts, which moves the copies found so far, so start over then.
+    for(j = 0; j < NVOCMP_BATCHLOCTRIES; j++)
+    {
+        uint8_t gen = NVOCMP_compactGen;
+
+        for(i = 0; i < count; i++)
+        {
+            (void)NVOCMP_checkItem(&pItems[i].id, pItems[i].len, &iHdr, NVOCMP_FINDSTRICT);
+            (void)NVOCMP_findActiveItem(&NVOCMP_nvHandle, &iHdr);
+            oldLoc[i].hpage = iHdr.hpage;
+            oldLoc[i].hofs  = iHdr.hofs;
+        }
+        if(gen == NVOCMP_compactGen)
+        {
+            break;
+        }
+    }
+    if(j == NVOCMP_BATCHLOCTRIES)
+    {
+        NVOCMP_ALERT(false, "NV items keep moving.")
+        NVOCMP_UNLOCK(NVINTF_FAILURE);
+    }
+
+    // A search that met a corrupted item may have compacted, confirm the room
+    dstPg = NVOCMP_getDstPage(&NVOCMP_nvHandle, iLen);
+    if((dstPg == NVOCMP_NULLPAGE) || (NVOCMP_failW != NVINTF_SUCCESS))
+    {
+        err = (NVOCMP_failW != NVINTF_SUCCESS) ? NVOCMP_failW : NVINTF_BADLENGTH;
+        NVOCMP_UNLOCK(err);
+    }
+
+    // Compaction skips pages holding only active items, and the pending items
+    // of a group torn by a power loss must remain reclaimable
+    NVOCMP_clearAllActive(&NVOCMP_nvHandle, dstPg);
+
+    // Program the group as pending items followed by a pending marker
+    stage.pg   = dstPg;
+    stage.ofs  = NVOCMP_nvHandle.actOffset;
+    stage.fill = 0;
+    for(i = 0; i < count; i++)
+    {
+        (void)NVOCMP_checkItem(&pItems[i].id, pItems[i].len, &iHdr, NVOCMP_FINDSTRICT);
+        NVOCMP_packHeader(&iHdr, (uint8_t *)pItems[i].buffer, cHdr, true);
+        NVOCMP_stagePut(&stage, (uint8_t *)pItems[i].buffer, iHdr.len);
+        NVOCMP_stagePut(&stage, cHdr, NVOCMP_ITEMHDRLEN);
+    }
+    mData[0] = count;
+    mData[1] = (uint8_t)(span & 0xFF);
+    mData[2] = (uint8_t)(span >> 8);
+    (void)NVOCMP_checkItem((NVINTF_itemID_t *)&batchId, NVOCMP_BATCHDATALEN, &iHdr,
+                           NVOCMP_FINDSTRICT);
+    NVOCMP_packHeader(&iHdr, mData, cHdr, true);
+    NVOCMP_stagePut(&stage, mData, NVOCMP_BATCHDATALEN);
+    NVOCMP_stagePut(&stage, cHdr, NVOCMP_ITEMHDRLEN);
+    NVOCMP_stageFlush(&stage);
+
+    // Space is used even if a write failed part way
+    mOfs = stage.ofs - NVOCMP_ITEMHDRLEN;
+    NVOCMP_nvHandle.actOffset = stage.ofs;
+    NVOCMP_nvHandle.pageInfo[dstPg].offset = stage.ofs;
+
+    if(NVOCMP_failW == NVINTF_SUCCESS)
+    {
+        // Commit point, the group is now valid as a whole
+        NVOCMP_setItemValid(dstPg, mOfs);
+        if(NVOCMP_failW == NVINTF_SUCCESS)
+        {
+            NVOCMP_applyBatch(&NVOCMP_nvHandle, dstPg, mOfs, oldLoc);
+        }
+    }
+    err = NVOCMP_failW;
+
+#ifdef NV_LINUX
+    if(err == NVINTF_SUCCESS)
+    {
+        NV_LINUX_save();
+    }
+#endif
+
+    NVOCMP_UNLOCK(err);
+}
+
 //*****************************************************************************
 // Extended API Functions
 //*****************************************************************************
@@ -1826,8 +2222,12 @@ static uint8_t NVOCMP_doNextApi(NVINTF_nvProxy_t * prx)
     hdr.itemid = prx->itemid;
     hdr.subid = prx->subid;
 
-    // Look for item
-    if (!NVOCMP_findItem(&NVOCMP_nvHandle, sPage, fOfs, &hdr, search, NULL))
+    // Look for item. findItem() searches all pages from sPage, so once the
+    // traversal has left the active page it can wrap around to newer pages
+    // and return items again: only pages as old as sPage, or older, count.
+    if (!NVOCMP_findItem(&NVOCMP_nvHandle, sPage, fOfs, &hdr, search, NULL) &&
+        (NVOCMP_ADDPAGE(NVOCMP_nvHandle.actPage, NVOCMP_NVSIZE - hdr.hpage) >=
+         NVOCMP_ADDPAGE(NVOCMP_nvHandle.actPage, NVOCMP_NVSIZE - sPage)))
     {
         iOfs = hdr.hofs;
         // store its attributes
@@ -2940,8 +3340,7 @@ static uint8_t NVOCMP_addItem(NVOCMP_nvHandle_t *pNvHandle, NVOCMP_itemHdr_t *iH
       hdr.sysid = iHdr->sysid;
       hdr.itemid = iHdr->itemid;
       hdr.subid = iHdr->subid;
-      (void)NVOCMP_findItem(pNvHandle, pNvHandle->actPage, pNvHandle->actOffset, &hdr,
-                            NVOCMP_FINDSTRICT, NULL);
+      (void)NVOCMP_findActiveItem(pNvHandle, &hdr);
       iHdr->hpage = hdr.hpage;
       iHdr->hofs = hdr.hofs;
     }
@@ -3160,25 +3559,10 @@ static void NVOCMP_writeItem(NVOCMP_nvHandle_t *pNvHandle, NVOCMP_itemHdr_t *pHd
     {
         cmpIH_t cHdr;
         uint16_t hOfs, dLen;
-        uint8_t newCRC;
 
-        // Compressed item header information <-- Lower Addr    Higher Addr-->
-        // Byte: [0]      [1]      [2]      [3]      [4]      [5]      [6]
-        // Item: SSSSSSII IIIIIIII SSSSSSSS SSLLLLLL LLLLLLCC CCCCCCAV SSSSSSSS
-        // LSB of field:         ^           ^            ^        ^          ^
-#if NVOCMP_HDRLE
-        cHdr[0] = (pHdr->sysid & 0x3F) | ((pHdr->itemid & 0x3) << 6);
-        cHdr[1] = (pHdr->itemid >> 2) & 0xFF;
-        cHdr[2] = pHdr->subid & 0xFF;
-        cHdr[3] = ((pHdr->subid >> 8) & 0x3) | ((pHdr->len & 0x3F) << 2);
-        cHdr[4] = (pHdr->len >> 6) & 0x3F;
-#else
-        cHdr[0] = ((pHdr->sysid << 2) | ((pHdr->itemid >> 8) & 0x3));
-        cHdr[1] = (pHdr->itemid & 0xFF);
-        cHdr[2] = ((pHdr->subid >> 2) & 0xFF);
-        cHdr[3] = ((pHdr->subid & 0x3) << 6) | ((pHdr->len >> 6) & 0x3F);
-        cHdr[4] = ((pHdr->len & 0x3F) << 2);
-#endif
+        // Build compressed header, including CRC over data and header
+        NVOCMP_packHeader(pHdr, pBuf, cHdr, false);
+
         // Header is located after the item data
         dLen = pHdr->len;
         hOfs = dstOff + dLen;
@@ -3188,24 +3572,7 @@ static void NVOCMP_writeItem(NVOCMP_nvHandle_t *pNvHandle, NVOCMP_itemHdr_t *pHd
             // Construct item in one buffer
             // Put data into buffer
             memcpy(NVOCMP_itemBuffer, (const void *)pBuf, dLen);
-            // Put most of header into buffer
-            memcpy(NVOCMP_itemBuffer + dLen, (const void *)cHdr,
-                   NVOCMP_HDRCRCINC);
-            // Calculate CRC
-            newCRC = NVOCMP_doRAMCRC(NVOCMP_itemBuffer, dLen +
-                                     NVOCMP_HDRCRCINC, 0);
-#if NVOCMP_HDRLE
-            // Insert CRC and last bytes
-            cHdr[4] |= ((newCRC & 0x3) << 6);
-            // Note NVOCMP_VALIDIDBIT set implicitly zero
-            cHdr[5] = ((newCRC >> 2) & 0x3F) | (NVOCMP_ACTIVEIDBIT << 6);
-#else
-            // Insert CRC and last bytes
-            cHdr[4] |= ((newCRC >> 6) & 0x3);
-            // Note NVOCMP_VALIDIDBIT set implicitly zero
-            cHdr[5] = ((newCRC & 0x3F) << 2) | NVOCMP_ACTIVEIDBIT;
-#endif
-            cHdr[6] = NVOCMP_SIGNATURE;
+            // Put header into buffer
             memcpy(NVOCMP_itemBuffer + dLen, (const void *)cHdr,
                    NVOCMP_ITEMHDRLEN);
             // NVS_write
@@ -3219,23 +3586,6 @@ static void NVOCMP_writeItem(NVOCMP_nvHandle_t *pNvHandle, NVOCMP_itemHdr_t *pHd
         else
         {
             // Write header/item separately
-            // Calculate CRC on data portion
-            newCRC = NVOCMP_doRAMCRC(pBuf, dLen, 0);
-            // Finish CRC using header portion
-            newCRC = NVOCMP_doRAMCRC(cHdr, NVOCMP_HDRCRCINC, newCRC);
-            // Complete Header with CRC, bits, and sig
-#if NVOCMP_HDRLE
-            // Insert CRC and last bytes
-            cHdr[4] |= ((newCRC & 0x3) << 6);
-            // Note NVOCMP_VALIDIDBIT set implicitly zero
-            cHdr[5] = ((newCRC >> 2) & 0x3F) | (NVOCMP_ACTIVEIDBIT << 6);
-#else
-            // Insert CRC and last bytes
-            cHdr[4] |= ((newCRC >> 6) & 0x3);
-            // Note NVOCMP_VALIDIDBIT set implicitly zero
-            cHdr[5] = ((newCRC & 0x3F) << 2) | NVOCMP_ACTIVEIDBIT;
-#endif
-            cHdr[6] = NVOCMP_SIGNATURE;
             // Write data
             NVOCMP_failW = NVOCMP_write(dstPg, dstOff, pBuf, dLen);
             // Write header
@@ -3259,6 +3609,13 @@ static void NVOCMP_writeItem(NVOCMP_nvHandle_t *pNvHandle, NVOCMP_itemHdr_t *pHd
         {
             NVOCMP_setItemInactive(pNvHandle, dstPg, hOfs);
         }
+#ifdef NVOCMP_RAM_INDEX
+        else
+        {
+            // This is now the newest copy of the item
+            NVOCMP_insertIndex(pHdr->cmpid, dstPg, hOfs, true);
+        }
+#endif
     }
     else
     {
@@ -3423,6 +3780,11 @@ static void NVOCMP_setItemInactive(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg,
 {
     uint8_t tmp;
 
+#ifdef NVOCMP_RAM_INDEX
+    // Forget the item if this was its indexed copy
+    NVOCMP_removeIndex(pg, iOfs);
+#endif
+
     // Get byte with validity bit
     tmp = NVOCMP_readByte(pg, iOfs + NVOCMP_HDRVLDOFS);
 
@@ -3435,6 +3797,24 @@ static void NVOCMP_setItemInactive(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg,
     // Mark the item as inactive
     NVOCMP_writeByte(pg, iOfs + NVOCMP_HDRVLDOFS, tmp);
 
+    NVOCMP_clearAllActive(pNvHandle, pg);
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_clearAllActive
+ *
+ * @brief   Clear the all-active mark of a page, so compaction no longer
+ *          skips it
+ *
+ * @param   pNvHandle - pointer to NV handle
+ * @param   pg - page
+ *
+ * @return  none
+ */
+static void NVOCMP_clearAllActive(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg)
+{
+    uint8_t tmp;
+
     if(pNvHandle->pageInfo[pg].allActive)
     {
       tmp = NVOCMP_readByte(pg, NVOCMP_PGHDRVER);
@@ -3445,45 +3825,356 @@ static void NVOCMP_setItemInactive(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg,
 }
 
 /******************************************************************************
- * @fn      NVOCMP_setCompactHdr
+ * @fn      NVOCMP_packHeader
  *
- * @brief   Set compact header
+ * @brief   Build the compressed header of an item, including the CRC8 over
+ *          the item data and header
  *
- * @param   dstPg - destination page to write the header
- * @param   pg - page of compaction
- * @param   offset - offset of compaction
- * @param   location - location of the header
+ * @param   pHdr - Pointer to item header holding IDs and length
+ * @param   pBuf - Pointer to item data
+ * @param   cHdr - Compressed header to fill in
+ * @param   pending - true to leave the VALID bit unprogrammed
  *
  * @return  none
  */
-static void NVOCMP_setCompactHdr(uint8_t dstPg, uint8_t pg, int16_t offset,
-                                 uint16_t location)
+static void NVOCMP_packHeader(NVOCMP_itemHdr_t *pHdr, uint8_t *pBuf, cmpIH_t cHdr,
+                              bool pending)
 {
-  NVOCMP_compactHdr_t hdr = DEFAULT_COMPACTHDR;
-  hdr.page = pg;
-  hdr.pageOffset = offset;
+    uint8_t newCRC;
 
-  NVOCMP_failW = NVOCMP_write(dstPg, (location + 1) * NVOCMP_COMPACTHDRLEN,
-                 (uint8_t *)&hdr, NVOCMP_COMPACTHDRLEN);
+    // Compressed item header information <-- Lower Addr    Higher Addr-->
+    // Byte: [0]      [1]      [2]      [3]      [4]      [5]      [6]
+    // Item: SSSSSSII IIIIIIII SSSSSSSS SSLLLLLL LLLLLLCC CCCCCCAV SSSSSSSS
+    // LSB of field:         ^           ^            ^        ^          ^
+#if NVOCMP_HDRLE
+    cHdr[0] = (pHdr->sysid & 0x3F) | ((pHdr->itemid & 0x3) << 6);
+    cHdr[1] = (pHdr->itemid >> 2) & 0xFF;
+    cHdr[2] = pHdr->subid & 0xFF;
+    cHdr[3] = ((pHdr->subid >> 8) & 0x3) | ((pHdr->len & 0x3F) << 2);
+    cHdr[4] = (pHdr->len >> 6) & 0x3F;
+#else
+    cHdr[0] = ((pHdr->sysid << 2) | ((pHdr->itemid >> 8) & 0x3));
+    cHdr[1] = (pHdr->itemid & 0xFF);
+    cHdr[2] = ((pHdr->subid >> 2) & 0xFF);
+    cHdr[3] = ((pHdr->subid & 0x3) << 6) | ((pHdr->len >> 6) & 0x3F);
+    cHdr[4] = ((pHdr->len & 0x3F) << 2);
+#endif
+    // Calculate CRC on data portion
+    newCRC = NVOCMP_doRAMCRC(pBuf, pHdr->len, 0);
+    // Finish CRC using header portion
+    newCRC = NVOCMP_doRAMCRC(cHdr, NVOCMP_HDRCRCINC, newCRC);
+    // Complete Header with CRC, bits, and sig
+#if NVOCMP_HDRLE
+    // Insert CRC and last bytes
+    cHdr[4] |= ((newCRC & 0x3) << 6);
+    // Note NVOCMP_VALIDIDBIT set implicitly zero
+    cHdr[5] = ((newCRC >> 2) & 0x3F) | (NVOCMP_ACTIVEIDBIT << 6);
+    if(pending)
+    {
+        cHdr[5] |= (NVOCMP_VALIDIDBIT << 6);
+    }
+#else
+    // Insert CRC and last bytes
+    cHdr[4] |= ((newCRC >> 6) & 0x3);
+    // Note NVOCMP_VALIDIDBIT set implicitly zero
+    cHdr[5] = ((newCRC & 0x3F) << 2) | NVOCMP_ACTIVEIDBIT;
+    if(pending)
+    {
+        cHdr[5] |= NVOCMP_VALIDIDBIT;
+    }
+#endif
+    cHdr[6] = NVOCMP_SIGNATURE;
 }
 
-#if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
 /******************************************************************************
- * @fn      NVOCMP_getCompactHdr
+ * @fn      NVOCMP_setItemValid
  *
- * @brief   Get compact header
+ * @brief   Mark a pending item as valid
  *
- * @param   dstPg - destination page to read the header
- * @param   location - location of the header
- * @param   pHdr - pointer to the header
+ * @param   pg - page where the item is located
+ * @param   iOfs - Offset to item header (lowest address)
  *
  * @return  none
  */
-static void NVOCMP_getCompactHdr(uint8_t dstPg, uint16_t location,
-                                 NVOCMP_compactHdr_t *pHdr)
+static void NVOCMP_setItemValid(uint8_t pg, uint16_t iOfs)
 {
-  NVOCMP_read(dstPg, (location + 1) * NVOCMP_COMPACTHDRLEN,
-              (uint8_t *)pHdr, NVOCMP_COMPACTHDRLEN);
+    uint8_t tmp;
+
+    // Get byte with validity bit
+    tmp = NVOCMP_readByte(pg, iOfs + NVOCMP_HDRVLDOFS);
+
+    // Program VALID_IDS_MARK
+#if NVOCMP_HDRLE
+    tmp &= ~(NVOCMP_VALIDIDBIT << 6);
+#else
+    tmp &= ~NVOCMP_VALIDIDBIT;
+#endif
+    NVOCMP_writeByte(pg, iOfs + NVOCMP_HDRVLDOFS, tmp);
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_stagePut
+ *
+ * @brief   Queue bytes for a Flash write. Consecutive small pieces are
+ *          combined in RAM, pieces too large to buffer are written directly.
+ *
+ * @param   pStage - pointer to write combiner state
+ * @param   pBuf - pointer to bytes to write
+ * @param   len - number of bytes to write
+ *
+ * @return  none
+ */
+static void NVOCMP_stagePut(NVOCMP_stage_t *pStage, uint8_t *pBuf, uint16_t len)
+{
+    if((pStage->fill + len) > NVOCMP_BATCHBUFLEN)
+    {
+        NVOCMP_stageFlush(pStage);
+        if(len >= NVOCMP_BATCHBUFLEN)
+        {
+            if(NVOCMP_failW == NVINTF_SUCCESS)
+            {
+                NVOCMP_failW = NVOCMP_write(pStage->pg, pStage->ofs, pBuf, len);
+            }
+            pStage->ofs += len;
+            return;
+        }
+    }
+
+    memcpy(&NVOCMP_batchBuf[pStage->fill], pBuf, len);
+    pStage->fill += len;
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_stageFlush
+ *
+ * @brief   Write out any bytes held by the write combiner
+ *
+ * @param   pStage - pointer to write combiner state
+ *
+ * @return  none
+ */
+static void NVOCMP_stageFlush(NVOCMP_stage_t *pStage)
+{
+    if(pStage->fill)
+    {
+        if(NVOCMP_failW == NVINTF_SUCCESS)
+        {
+            NVOCMP_failW = NVOCMP_write(pStage->pg, pStage->ofs, NVOCMP_batchBuf,
+                                        pStage->fill);
+        }
+        pStage->ofs += pStage->fill;
+        pStage->fill = 0;
+    }
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_applyBatch
+ *
+ * @brief   Complete a committed writeItems() group: mark its items valid,
+ *          retire the copies they replace and retire the group marker.
+ *          Every step can be repeated, so an interrupted call is simply
+ *          run again at the next initialization.
+ *
+ * @param   pNvHandle - pointer to NV handle
+ * @param   pg - page of the group
+ * @param   mOfs - offset of the group marker header
+ * @param   pOld - locations of replaced copies, NULL to search for them
+ *
+ * @return  none
+ */
+static void NVOCMP_applyBatch(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg, uint16_t mOfs,
+                              NVOCMP_batchLoc_t *pOld)
+{
+    uint8_t i;
+    uint16_t ofs;
+    uint16_t sOfs;
+    NVOCMP_itemHdr_t iHdr;
+    uint8_t mData[NVOCMP_BATCHDATALEN];
+
+    NVOCMP_read(pg, mOfs - NVOCMP_BATCHDATALEN, mData, NVOCMP_BATCHDATALEN);
+    ofs = mOfs - NVOCMP_BATCHDATALEN;
+    sOfs = mData[1] | (mData[2] << 8);
+    if(sOfs > (ofs - NVOCMP_PGDATAOFS))
+    {
+        NVOCMP_ALERT(false, "Batch marker corrupted.")
+        return;
+    }
+    sOfs = ofs - sOfs;
+
+    // Validate the items first so a compaction can no longer drop them
+    for(i = 0; (i < mData[0]) && (ofs > sOfs); i++)
+    {
+        ofs -= NVOCMP_ITEMHDRLEN;
+        NVOCMP_readHeader(pg, ofs, &iHdr, false);
+        if(!(iHdr.stats & NVOCMP_FOLLOWBIT) || (iHdr.len > (ofs - sOfs)))
+        {
+            NVOCMP_ALERT(false, "Batch item corrupted.")
+            break;
+        }
+        if(iHdr.stats & NVOCMP_VALIDIDBIT)
+        {
+            NVOCMP_setItemValid(pg, ofs);
+        }
+#ifdef NVOCMP_RAM_INDEX
+        NVOCMP_insertIndex(iHdr.cmpid, pg, ofs, true);
+#endif
+        ofs -= iHdr.len;
+    }
+
+    // Retire the copies replaced by the group
+    if(pOld)
+    {
+        for(i = 0; i < mData[0]; i++)
+        {
+            if(pOld[i].hofs > 0)
+            {
+                NVOCMP_setItemInactive(pNvHandle, pOld[i].hpage, pOld[i].hofs);
+            }
+        }
+    }
+    else
+    {
+        ofs = mOfs - NVOCMP_BATCHDATALEN;
+        for(i = 0; (i < mData[0]) && (ofs > sOfs); i++)
+        {
+            NVOCMP_itemHdr_t oHdr;
+
+            ofs -= NVOCMP_ITEMHDRLEN;
+            NVOCMP_readHeader(pg, ofs, &iHdr, false);
+            if(!(iHdr.stats & NVOCMP_FOLLOWBIT) || (iHdr.len > (ofs - sOfs)))
+            {
+                break;
+            }
+            // Any active copy older than the group is out of date
+            oHdr.sysid  = iHdr.sysid;
+            oHdr.itemid = iHdr.itemid;
+            oHdr.subid  = iHdr.subid;
+            if(NVOCMP_findItem(pNvHandle, pg, sOfs, &oHdr, NVOCMP_FINDSTRICT, NULL) ==
+               NVINTF_SUCCESS)
+            {
+                NVOCMP_setItemInactive(pNvHandle, oHdr.hpage, oHdr.hofs);
+            }
+            ofs -= iHdr.len;
+        }
+    }
+
+    // Group is complete
+    NVOCMP_setItemInactive(pNvHandle, pg, mOfs);
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_finishBatch
+ *
+ * @brief   Walk the item headers looking for a writeItems() group that was
+ *          committed but not completed before a power loss, and complete it
+ *
+ * @param   pNvHandle - pointer to NV handle
+ *
+ * @return  none
+ */
+static void NVOCMP_finishBatch(NVOCMP_nvHandle_t *pNvHandle)
+{
+    uint8_t p = pNvHandle->actPage;
+    uint16_t ofs = pNvHandle->actOffset;
+    uint32_t cid = NVOCMP_CMPRID(batchId.systemID, batchId.itemID, batchId.subID);
+
+    if(NVOCMP_failW != NVINTF_SUCCESS)
+    {
+        return;
+    }
+
+#if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
+    uint16_t nvSearched = 0;
+    for(p = pNvHandle->actPage; nvSearched < NVOCMP_NVSIZE; p = NVOCMP_DECPAGE(p), ofs = pNvHandle->pageInfo[p].offset)
+    {
+      nvSearched++;
+      if(p == pNvHandle->tailPage)
+      {
+        continue;
+      }
+#endif
+      while(ofs >= (NVOCMP_PGDATAOFS + NVOCMP_ITEMHDRLEN))
+      {
+          NVOCMP_itemHdr_t iHdr;
+
+          // Align to start of item header
+          ofs -= NVOCMP_ITEMHDRLEN;
+
+          // Read and decompress item header
+          NVOCMP_readHeader(p, ofs, &iHdr, false);
+
+          if(!(iHdr.stats & NVOCMP_FOLLOWBIT) || (iHdr.len >= ofs))
+          {
+              // Leave corruption to be handled by compaction
+              return;
+          }
+
+          if((iHdr.cmpid == cid) && (iHdr.len == NVOCMP_BATCHDATALEN) &&
+             (iHdr.stats & NVOCMP_ACTIVEIDBIT))
+          {
+              if(iHdr.stats & NVOCMP_VALIDIDBIT)
+              {
+                  // Group was never committed, retiring its marker flags
+                  // the page so compaction reclaims the dropped items
+                  NVOCMP_setItemInactive(pNvHandle, p, ofs);
+              }
+              else
+              {
+                  NVOCMP_ALERT(false, "Completing interrupted batch write.")
+                  NVOCMP_applyBatch(pNvHandle, p, ofs, NULL);
+                  // Only the last group written can be incomplete
+                  return;
+              }
+          }
+
+          // Jump to next item
+          ofs -= iHdr.len;
+      }
+#if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
+    }
+#endif
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_setCompactHdr
+ *
+ * @brief   Set compact header
+ *
+ * @param   dstPg - destination page to write the header
+ * @param   pg - page of compaction
+ * @param   offset - offset of compaction
+ * @param   location - location of the header
+ *
+ * @return  none
+ */
+static void NVOCMP_setCompactHdr(uint8_t dstPg, uint8_t pg, int16_t offset,
+                                 uint16_t location)
+{
+  NVOCMP_compactHdr_t hdr = DEFAULT_COMPACTHDR;
+  hdr.page = pg;
+  hdr.pageOffset = offset;
+
+  NVOCMP_failW = NVOCMP_write(dstPg, (location + 1) * NVOCMP_COMPACTHDRLEN,
+                 (uint8_t *)&hdr, NVOCMP_COMPACTHDRLEN);
+}
+
+#if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
+/******************************************************************************
+ * @fn      NVOCMP_getCompactHdr
+ *
+ * @brief   Get compact header
+ *
+ * @param   dstPg - destination page to read the header
+ * @param   location - location of the header
+ * @param   pHdr - pointer to the header
+ *
+ * @return  none
+ */
+static void NVOCMP_getCompactHdr(uint8_t dstPg, uint16_t location,
+                                 NVOCMP_compactHdr_t *pHdr)
+{
+  NVOCMP_read(dstPg, (location + 1) * NVOCMP_COMPACTHDRLEN,
+              (uint8_t *)pHdr, NVOCMP_COMPACTHDRLEN);
 }
 #endif
 
@@ -3952,6 +4643,280 @@ static int8_t NVOCMP_findItem(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg, uint16_t
 }
 #endif
 
+/******************************************************************************
+ * @fn      NVOCMP_findActiveItem
+ *
+ * @brief   Find the newest active copy of an item, searching all NV pages
+ *          from the most recently written item unless the RAM index can
+ *          answer directly
+ *
+ * @param   pNvHandle - pointer to NV handle
+ * @param   pHdr - pointer to item header holding the IDs to search for
+ *
+ * @return  NVINTF_SUCCESS, if the item is found
+ *          NVINTF_NOTFOUND, if the item is not found
+ */
+static int8_t NVOCMP_findActiveItem(NVOCMP_nvHandle_t *pNvHandle, NVOCMP_itemHdr_t *pHdr)
+{
+    int8_t status;
+
+#ifdef NVOCMP_RAM_INDEX
+    if(NVOCMP_findIndex(pNvHandle, pHdr, &status))
+    {
+        return(status);
+    }
+#endif
+
+    status = NVOCMP_findItem(pNvHandle, pNvHandle->actPage, pNvHandle->actOffset, pHdr,
+                             NVOCMP_FINDSTRICT, NULL);
+
+#ifdef NVOCMP_RAM_INDEX
+    if(status == NVINTF_SUCCESS)
+    {
+        // Remember where it was found
+        NVOCMP_insertIndex(pHdr->cmpid, pHdr->hpage, pHdr->hofs, true);
+    }
+#endif
+
+    return(status);
+}
+
+#ifdef NVOCMP_RAM_INDEX
+/******************************************************************************
+ * @fn      NVOCMP_buildIndex
+ *
+ * @brief   Rebuild the RAM index by walking every item header once, from the
+ *          most recently written item backwards. If a corrupted header is
+ *          met the walk stops and the index is left partial, so the regular
+ *          page search gets a chance to recover the NV area.
+ *
+ * @param   pNvHandle - pointer to NV handle
+ *
+ * @return  none
+ */
+static void NVOCMP_buildIndex(NVOCMP_nvHandle_t *pNvHandle)
+{
+    uint8_t p = pNvHandle->actPage;
+    uint16_t ofs = pNvHandle->actOffset;
+
+    NVOCMP_ramIdx.count = 0;
+    NVOCMP_ramIdx.state = NVOCMP_RIDX_COMPLETE;
+
+#if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
+    uint16_t nvSearched = 0;
+    for(p = pNvHandle->actPage; nvSearched < NVOCMP_NVSIZE; p = NVOCMP_DECPAGE(p), ofs = pNvHandle->pageInfo[p].offset)
+    {
+      nvSearched++;
+      if(p == pNvHandle->tailPage)
+      {
+        continue;
+      }
+#endif
+      while(ofs >= (NVOCMP_PGDATAOFS + NVOCMP_ITEMHDRLEN))
+      {
+          NVOCMP_itemHdr_t iHdr;
+
+          // Align to start of item header
+          ofs -= NVOCMP_ITEMHDRLEN;
+
+          // Read and decompress item header
+          NVOCMP_readHeader(p, ofs, &iHdr, false);
+
+          if(!(iHdr.stats & NVOCMP_FOLLOWBIT) || (iHdr.len >= ofs))
+          {
+              NVOCMP_ALERT(false, "Index build stopped at corrupted item.")
+              NVOCMP_ramIdx.state = NVOCMP_RIDX_PARTIAL;
+              return;
+          }
+
+          if((iHdr.stats & NVOCMP_ACTIVEIDBIT) &&
+            !(iHdr.stats & NVOCMP_VALIDIDBIT))
+          {
+              // Newest copy is met first, older duplicates are ignored
+              NVOCMP_insertIndex(iHdr.cmpid, p, ofs, false);
+          }
+
+          // Jump to next item
+          ofs -= iHdr.len;
+      }
+#if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
+    }
+#endif
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_findIndex
+ *
+ * @brief   Look up an item in the RAM index. A cached location is only
+ *          trusted after the item header found there has been checked.
+ *
+ * @param   pNvHandle - pointer to NV handle
+ * @param   pHdr - pointer to item header holding the IDs to search for
+ * @param   pStatus - search result, valid when true is returned
+ *
+ * @return  true if the index resolved the search, false if a page search
+ *          is still needed
+ */
+static bool NVOCMP_findIndex(NVOCMP_nvHandle_t *pNvHandle, NVOCMP_itemHdr_t *pHdr,
+                             int8_t *pStatus)
+{
+    bool found;
+    uint16_t pos;
+    uint32_t cid = NVOCMP_CMPRID(pHdr->sysid, pHdr->itemid, pHdr->subid);
+
+    if(NVOCMP_ramIdx.state == NVOCMP_RIDX_STALE)
+    {
+        NVOCMP_buildIndex(pNvHandle);
+    }
+
+    pos = NVOCMP_searchIndex(cid, &found);
+    if(found)
+    {
+        NVOCMP_itemHdr_t iHdr;
+        NVOCMP_ramIdxEntry_t *pEntry = &NVOCMP_ramIdx.entry[pos];
+
+        NVOCMP_readHeader(pEntry->hpage, pEntry->hofs, &iHdr, false);
+        if((iHdr.cmpid == cid) &&
+           (iHdr.stats & NVOCMP_ACTIVEIDBIT) &&
+          !(iHdr.stats & NVOCMP_VALIDIDBIT))
+        {
+            memcpy(pHdr, &iHdr, sizeof(NVOCMP_itemHdr_t));
+            *pStatus = NVINTF_SUCCESS;
+            return(true);
+        }
+
+        // Entry is out of date, drop it and let the page search decide
+        NVOCMP_ALERT(false, "Stale index entry.")
+        NVOCMP_ramIdx.count--;
+        memmove(&NVOCMP_ramIdx.entry[pos], &NVOCMP_ramIdx.entry[pos + 1],
+                (NVOCMP_ramIdx.count - pos) * sizeof(NVOCMP_ramIdxEntry_t));
+        NVOCMP_ramIdx.state = NVOCMP_RIDX_PARTIAL;
+        return(false);
+    }
+
+    if(NVOCMP_ramIdx.state == NVOCMP_RIDX_COMPLETE)
+    {
+        pHdr->hofs = 0;
+        *pStatus = NVINTF_NOTFOUND;
+        return(true);
+    }
+
+    return(false);
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_searchIndex
+ *
+ * @brief   Binary search of the RAM index
+ *
+ * @param   cmpid - compressed ID to search for
+ * @param   pFound - set to true if cmpid is in the index
+ *
+ * @return  position of cmpid, or position where it would be inserted
+ */
+static uint16_t NVOCMP_searchIndex(uint32_t cmpid, bool *pFound)
+{
+    uint16_t lo = 0;
+    uint16_t hi = NVOCMP_ramIdx.count;
+
+    while(lo < hi)
+    {
+        uint16_t mid = (lo + hi) >> 1;
+
+        if(NVOCMP_ramIdx.entry[mid].cmpid < cmpid)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    *pFound = (lo < NVOCMP_ramIdx.count) && (NVOCMP_ramIdx.entry[lo].cmpid == cmpid);
+    return(lo);
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_insertIndex
+ *
+ * @brief   Add an item location to the RAM index. If the index is full the
+ *          item is left out and the index is marked partial.
+ *
+ * @param   cmpid - compressed ID of the item
+ * @param   pg - page of the item header
+ * @param   hofs - offset of the item header
+ * @param   replace - true to overwrite the location of an indexed item
+ *
+ * @return  none
+ */
+static void NVOCMP_insertIndex(uint32_t cmpid, uint8_t pg, uint16_t hofs, bool replace)
+{
+    bool found;
+    uint16_t pos;
+
+    if(NVOCMP_ramIdx.state == NVOCMP_RIDX_STALE)
+    {
+        // Whole index is rebuilt on next lookup
+        return;
+    }
+
+    pos = NVOCMP_searchIndex(cmpid, &found);
+    if(!found)
+    {
+        if(NVOCMP_ramIdx.count >= NVOCMP_RAM_INDEX_SIZE)
+        {
+            NVOCMP_ramIdx.state = NVOCMP_RIDX_PARTIAL;
+            return;
+        }
+        memmove(&NVOCMP_ramIdx.entry[pos + 1], &NVOCMP_ramIdx.entry[pos],
+                (NVOCMP_ramIdx.count - pos) * sizeof(NVOCMP_ramIdxEntry_t));
+        NVOCMP_ramIdx.count++;
+        NVOCMP_ramIdx.entry[pos].cmpid = cmpid;
+    }
+    else if(!replace)
+    {
+        return;
+    }
+
+    NVOCMP_ramIdx.entry[pos].hpage = pg;
+    NVOCMP_ramIdx.entry[pos].hofs = hofs;
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_removeIndex
+ *
+ * @brief   Remove an item from the RAM index if its indexed copy is the one
+ *          at the given location. Older copies being retired are ignored.
+ *
+ * @param   pg - page of the item header
+ * @param   hofs - offset of the item header
+ *
+ * @return  none
+ */
+static void NVOCMP_removeIndex(uint8_t pg, uint16_t hofs)
+{
+    bool found;
+    uint16_t pos;
+    NVOCMP_itemHdr_t iHdr;
+
+    if((NVOCMP_ramIdx.state == NVOCMP_RIDX_STALE) || (NVOCMP_ramIdx.count == 0))
+    {
+        return;
+    }
+
+    NVOCMP_readHeader(pg, hofs, &iHdr, false);
+    pos = NVOCMP_searchIndex(iHdr.cmpid, &found);
+    if(found && (NVOCMP_ramIdx.entry[pos].hpage == pg) &&
+       (NVOCMP_ramIdx.entry[pos].hofs == hofs))
+    {
+        NVOCMP_ramIdx.count--;
+        memmove(&NVOCMP_ramIdx.entry[pos], &NVOCMP_ramIdx.entry[pos + 1],
+                (NVOCMP_ramIdx.count - pos) * sizeof(NVOCMP_ramIdxEntry_t));
+    }
+}
+#endif
+
 #if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
 /******************************************************************************
  * @fn      NVOCMP_cleanPage
@@ -4097,6 +5062,13 @@ static int16_t NVOCMP_compactPage(NVOCMP_nvHandle_t *pNvHandle, uint16_t nBytes)
     return(0);
   }
 
+  // Items are about to move
+  NVOCMP_compactGen++;
+#ifdef NVOCMP_RAM_INDEX
+  // Rebuild the index on next lookup
+  NVOCMP_ramIdx.state = NVOCMP_RIDX_STALE;
+#endif
+
   while(compactPages)
   {
     if(pNvHandle->compactInfo.xSrcPages == 0)
@@ -4292,6 +5264,13 @@ static int16_t NVOCMP_compactPage(NVOCMP_nvHandle_t *pNvHandle, uint16_t nBytes)
     return(0);
   }
 
+  // Items are about to move
+  NVOCMP_compactGen++;
+#ifdef NVOCMP_RAM_INDEX
+  // Rebuild the index on next lookup
+  NVOCMP_ramIdx.state = NVOCMP_RIDX_STALE;
+#endif
+
   NVOCMP_writeByte(srcPg, NVOCMP_COMPMODEOFS, NVOCMP_PGCSRC);
   pNvHandle->pageInfo[srcPg].mode = NVOCMP_PGCSRC;
 
@@ -64,6 +64,7 @@ extern "C"
 
 // NV driver item ID definitions
 #define NVOCMP_NVID_DIAG {NVINTF_SYSID_NVDRVR, 1, 0}
+#define NVOCMP_NVID_BATCH {NVINTF_SYSID_NVDRVR, 2, 0}
 
 //*****************************************************************************
 // Typedefs
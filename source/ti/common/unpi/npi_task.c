@@ -180,12 +180,6 @@ static Queue_Handle npiSyncRxQueue;
 //!        processed.
 static int8_t syncTransactionInProgress = 0;
 
-//! \brief Pointer to last tx message.  This is freed once confirmation is
-//!        is received that the buffer has been transmitted
-//!        (ie. NPITASK_TRANSPORT_TX_DONE_EVENT)
-//!
-static uint8_t *lastQueuedTxMsg;
-
 #ifdef ICALL_EVENTS
 static ICall_SyncHandle syncEvent = NULL;
 #else //!ICALL_EVENTS
@@ -288,9 +282,9 @@ static uint8_t NPITask_routeHostToSS(_npiFrame_t *pNPIMsg);
 static uint8_t NPITask_routeICallToSS(ICall_ServiceEnum src, uint8_t *pGenMsg);
 #endif //USE_ICALL
 
-//! \brief Function that transforms NPI Frame struct into a byte array. This is
-//         necessary to send data over NPI Transport Layer
-static uint8_t * NPITask_SerializeFrame(_npiFrame_t *pNPIMsg);
+//! \brief Function that writes an NPI Frame struct as a byte array into the
+//         NPI Transport Layer transmit buffer
+static void NPITask_SerializeFrame(_npiFrame_t *pNPIMsg, uint8_t *pSerMsg);
 
 //! \brief Function that transforms byte contents of NPI RxBuf into an NPI Frame
 //!        struct that can be routed.
@@ -362,12 +356,11 @@ void NPITask_Fxn(UArg a0, UArg a1)
                 NPITL_handleRemRdyEvent();
 #endif // NPI_FLOW_CTRL = 1
             }
-            // TX Frame has been successfully sent
+            // TX Frame has been successfully sent. Frames are serialized
+            // straight into the transport layer buffer so there is nothing
+            // left to free here.
             if (NPITask_events & NPITASK_TX_DONE_EVENT)
             {
-              //Deallocate most recent message being transmitted.
-              NPIUtil_free(lastQueuedTxMsg);
-              lastQueuedTxMsg = NULL;
 #ifndef ICALL_EVENTS
               NPITask_events &= ~NPITASK_TX_DONE_EVENT;
 #endif //ICALL_EVENTS
@@ -558,7 +551,6 @@ uint8_t NPITask_open(NPI_Params *params)
 #ifndef ICALL_EVENTS
     NPITask_events = 0;
 #endif //ICALL_EVENTS
-    lastQueuedTxMsg = NULL;
 
 #ifndef ICALL_EVENTS
 #ifndef USE_ICALL
@@ -640,12 +632,6 @@ uint8_t NPITask_close(void)
     Queue_delete(&npiSyncRxQueue);
     Queue_delete(&npiSyncTxQueue);
 
-    // Free any message buffers for in-flight messages
-    if (lastQueuedTxMsg != NULL)
-    {
-      NPIUtil_free(lastQueuedTxMsg);
-    }
-
     // Delete NPI task
     NPIUtil_free(npiTaskStack);
     Task_delete(&npiTaskHandle);
@@ -868,40 +854,26 @@ void NPITask_freeFrame(_npiFrame_t *frame)
 // Serialize and Deserialize functions
 
 // -----------------------------------------------------------------------------
-//! \brief      Function creates a byte array from an NPI Frame struct
-//!
-//!             *** Whoever calls this function is responsible for freeing the
-//!             the created byte array
+//! \brief      Function writes an NPI Frame struct as a byte array to the
+//!             given buffer
 //!
 //! \param[in]  pNPIMsg     Pointer to message that will be serialized
+//! \param[out] pSerMsg     Buffer of at least dataLen + NPI_MSG_HDR_LENGTH
+//!                         bytes, normally reserved in the NPI TL TX buffer
 //!
-//! \return     uint8_t*    Equivalent byte array of the NPI Frame
+//! \return     void
 // -----------------------------------------------------------------------------
-static uint8_t * NPITask_SerializeFrame(_npiFrame_t *pNPIMsg)
+static void NPITask_SerializeFrame(_npiFrame_t *pNPIMsg, uint8_t *pSerMsg)
 {
-    uint8_t *pSerMsg;
-
-    // Allocate byte array for the entire message
-    pSerMsg = NPIUtil_malloc(pNPIMsg->dataLen + NPI_MSG_HDR_LENGTH);
-
-    if (pSerMsg != NULL)
-    {
-        // Packet Format [ Len1 ][ Len0 ][ Cmd0 ][ Cmd 1 ][ Data Payload ]
-        // Fill in Header
-        pSerMsg[0] = (uint8)(pNPIMsg->dataLen & 0xFF);
-        pSerMsg[1] = (uint8)(pNPIMsg->dataLen >> 8);
-        pSerMsg[2] = pNPIMsg->cmd0;
-        pSerMsg[3] = pNPIMsg->cmd1;
-
-        // Copy Data Payload
-        memcpy(&pSerMsg[4],pNPIMsg->pData,pNPIMsg->dataLen);
-    }
-    else
-    {
-      HAL_ASSERT(HAL_ASSERT_CAUSE_OUT_OF_MEMORY);
-    }
-
-    return pSerMsg;
+    // Packet Format [ Len1 ][ Len0 ][ Cmd0 ][ Cmd 1 ][ Data Payload ]
+    // Fill in Header
+    pSerMsg[0] = (uint8)(pNPIMsg->dataLen & 0xFF);
+    pSerMsg[1] = (uint8)(pNPIMsg->dataLen >> 8);
+    pSerMsg[2] = pNPIMsg->cmd0;
+    pSerMsg[3] = pNPIMsg->cmd1;
+
+    // Copy Data Payload
+    memcpy(&pSerMsg[4],pNPIMsg->pData,pNPIMsg->dataLen);
 }
 
 
@@ -947,8 +919,10 @@ static _npiFrame_t * NPITask_DeserializeFrame(void)
 // "Processor" functions
 
 // -----------------------------------------------------------------------------
-//! \brief      Dequeue next message in the ASYNC TX Queue and send to serial
-//!             interface.
+//! \brief      Dequeue messages in the TX Queue and send them to the serial
+//!             interface. ASYNC messages are serialized back to back into the
+//!             transport layer buffer for as long as they fit, so that they
+//!             are sent to the host in a single transaction.
 //!
 //! \param[in]  txQ    queue handle to be processed
 //!
@@ -957,40 +931,61 @@ static _npiFrame_t * NPITask_DeserializeFrame(void)
 static void NPITask_ProcessTXQ(Queue_Handle txQ)
 {
     _npiFrame_t *pMsg = NULL;
+    uint8_t *pSerMsg = NULL;
+    uint8_t numFrames = 0;
     _npiCSKey_t key;
 
-    // Must block task pre-emption so that the higher priority tasks
-    // are not also manipulated txQ at the same time
-    key = NPIUtil_EnterCS();
-    pMsg = (_npiFrame_t *) NPIUtil_dequeueMsg(txQ);
-    NPIUtil_ExitCS(key);
-
-    if (pMsg != NULL)
+    do
     {
-        // Serialize NPI Frame to be sent over Transport Layer
-        if(lastQueuedTxMsg != NULL)
+        // Must block task pre-emption so that the higher priority tasks
+        // are not also manipulated txQ at the same time
+        key = NPIUtil_EnterCS();
+        pMsg = (_npiFrame_t *) NPIUtil_peekMsg(txQ);
+        if (pMsg != NULL)
         {
-          NPIUtil_free(lastQueuedTxMsg);
-          lastQueuedTxMsg = NULL;
+            pSerMsg = NPITL_reserveTxFrameTL(pMsg->dataLen + NPI_MSG_HDR_LENGTH);
+
+            // A message that does not fit behind the ones already reserved
+            // stays queued for the next transaction. One that cannot be
+            // reserved on its own is dropped.
+            if (pSerMsg != NULL || numFrames == 0)
+            {
+                NPIUtil_dequeueMsg(txQ);
+            }
         }
-        lastQueuedTxMsg = NPITask_SerializeFrame(pMsg);
+        NPIUtil_ExitCS(key);
 
-        if (lastQueuedTxMsg != NULL)
+        if (pMsg == NULL || (pSerMsg == NULL && numFrames != 0))
         {
-          // Write byte array over Transport Layer
-          // We have already checked if TL is busy so we assume write succeeds
-          NPITL_writeTL(lastQueuedTxMsg, pMsg->dataLen + NPI_MSG_HDR_LENGTH);
-          // If the message is a synchronous response or request
-          if (NPI_GET_MSG_TYPE(pMsg) == NPI_MSG_TYPE_SYNCREQ ||
-              NPI_GET_MSG_TYPE(pMsg) == NPI_MSG_TYPE_SYNCRSP)
-          {
-              // Decrement the outstanding Sync REQ/RSP flag.
-              syncTransactionInProgress--;
-          }
+            break;
+        }
+
+        if (pSerMsg != NULL)
+        {
+            // Serialize NPI Frame straight into the Transport Layer buffer
+            NPITask_SerializeFrame(pMsg, pSerMsg);
+            numFrames++;
+
+            // If the message is a synchronous response or request
+            if (NPI_GET_MSG_TYPE(pMsg) == NPI_MSG_TYPE_SYNCREQ ||
+                NPI_GET_MSG_TYPE(pMsg) == NPI_MSG_TYPE_SYNCRSP)
+            {
+                // Decrement the outstanding Sync REQ/RSP flag.
+                syncTransactionInProgress--;
+            }
         }
 
         //Free NPI frame
         NPITask_freeFrame(pMsg);
+
+    // SYNC messages are sent one per transaction
+    } while (pSerMsg != NULL && txQ == npiTxQueue);
+
+    if (numFrames != 0)
+    {
+        // Write reserved frames over Transport Layer
+        // We have already checked if TL is busy so we assume write succeeds
+        NPITL_sendTxFramesTL();
     }
 }
 
@@ -1122,7 +1117,7 @@ static void NPITask_transportDoneCallBack(uint16_t sizeRx, uint16_t sizeTx)
         }
     }
 
-    if (sizeTx && lastQueuedTxMsg)
+    if (sizeTx)
     {
       txcomplete++;
 #ifdef ICALL_EVENTS
@@ -88,6 +88,14 @@
 #define LocRDY_DISABLE()
 #endif // NPI_FLOW_CTRL = 1
 
+#if defined(NPI_USE_UART) && (NPI_FLOW_CTRL == 0)
+// Without flow control the UART receiver parses back to back frames, so
+// several queued frames can share one write. Each additional frame is
+// preceded by the FCS of the frame before it and its own SOF.
+#define NPITL_TX_COALESCE
+#define NPITL_FRAME_SEP_LEN  2
+#endif // NPI_USE_UART && NPI_FLOW_CTRL = 0
+
 //*****************************************************************************
 // Typedefs
 //*****************************************************************************
@@ -124,9 +132,16 @@ uint8_t *npiTxBuf;
 //! \brief Number of bytes in NPI Transport Layer transmit buffer
 static uint16_t npiTxBufLen = 0;
 
+//! \brief Number of bytes of reserved frames waiting to be sent
+static uint16_t npiTxFrameLen = 0;
+
 //! \brief Size of allocated Tx and Rx buffers
 uint16_t npiBufSize = 0;
 
+//! \brief Offset of the received frame in npiRxBuf. Set by the transport
+//!        when several frames of one read are handed up in place.
+uint16_t npiRxBufOffset = 0;
+
 npiTLCallBacks taskCBs;
 
 #if (NPI_FLOW_CTRL == 1)
@@ -443,8 +458,8 @@ static void NPITL_remRdyPINHwiFxn(PIN_Handle hPin, PIN_Id pinId)
 // -----------------------------------------------------------------------------
 static void NPITL_transmissionCallBack(uint16_t Rxlen, uint16_t Txlen)
 {
-    npiRxBufHead = 0;
-    npiRxBufTail = Rxlen;
+    npiRxBufHead = npiRxBufOffset;
+    npiRxBufTail = npiRxBufOffset + Rxlen;
 
     // Only set TX Active flag false if a tx was taking place
     if (Txlen > 0)
@@ -569,6 +584,89 @@ void NPITL_writeBypassSafeTL(uint8_t *buf, uint16_t len)
 #endif // NPI_FLOW_CTRL = 1
 }
 
+// -----------------------------------------------------------------------------
+//! \brief      This routine reserves room for a serialized NPI frame directly
+//!             in the transport layer transmit buffer. Frames reserved before
+//!             the next call to NPITL_sendTxFramesTL() are sent together in a
+//!             single transaction where the transport allows it.
+//!
+//! \param[in]  len - Length of the frame (header and payload).
+//!
+//! \return     uint8_t* - Pointer to write the frame to, or NULL if NPI is
+//!                        busy or the frame does not fit.
+// -----------------------------------------------------------------------------
+uint8_t *NPITL_reserveTxFrameTL(uint16_t len)
+{
+    uint8_t *pFrame = NULL;
+
+    if (NPITL_checkNpiBusy())
+    {
+        return NULL;
+    }
+
+    if (npiTxFrameLen == 0)
+    {
+        // First frame starts at the second byte of npiTxBuf, the same as
+        // NPITL_writeTL(), leaving room for the SOF.
+        if (len <= npiBufSize)
+        {
+            pFrame = &npiTxBuf[1];
+            npiTxFrameLen = len;
+        }
+    }
+#ifdef NPITL_TX_COALESCE
+    else if ((npiTxFrameLen + NPITL_FRAME_SEP_LEN + len +
+              NPITL_FRAME_SEP_LEN) <= npiBufSize)
+    {
+        pFrame = &npiTxBuf[1 + npiTxFrameLen + NPITL_FRAME_SEP_LEN];
+        npiTxFrameLen += NPITL_FRAME_SEP_LEN + len;
+    }
+#endif // NPITL_TX_COALESCE
+
+    return pFrame;
+}
+
+// -----------------------------------------------------------------------------
+//! \brief      This routine sends all frames reserved with
+//!             NPITL_reserveTxFrameTL() in one transport transaction.
+//!
+//! \return     uint8_t - NPI Error Code value
+// -----------------------------------------------------------------------------
+uint8_t NPITL_sendTxFramesTL(void)
+{
+#if (NPI_FLOW_CTRL == 1)
+    _npiCSKey_t key;
+    key = NPIUtil_EnterCS();
+#endif // NPI_FLOW_CTRL = 1
+
+    // Check to make sure NPI is not currently in a transaction. Reserved
+    // frames are dropped in that case, as NPITL_writeTL() does.
+    if (NPITL_checkNpiBusy() || npiTxFrameLen == 0)
+    {
+        npiTxFrameLen = 0;
+
+#if (NPI_FLOW_CTRL == 1)
+        NPIUtil_ExitCS(key);
+#endif // NPI_FLOW_CTRL = 1
+
+        return NPI_BUSY;
+    }
+
+    npiTxBufLen = npiTxFrameLen;
+    npiTxFrameLen = 0;
+    npiTxActive = TRUE;
+    txPktCount++;
+
+    transportWrite(npiTxBufLen);
+
+#if (NPI_FLOW_CTRL == 1)
+    LocRDY_ENABLE();
+    NPIUtil_ExitCS(key);
+#endif // NPI_FLOW_CTRL = 1
+
+    return NPI_SUCCESS;
+}
+
 // -----------------------------------------------------------------------------
 //! \brief      This routine returns the max size receive buffer.
 //!
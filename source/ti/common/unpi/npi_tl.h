@@ -168,6 +168,27 @@ uint8_t NPITL_writeTL(uint8_t *buf, uint16_t len);
 // -----------------------------------------------------------------------------
 void NPITL_writeBypassSafeTL(uint8_t *buf, uint16_t len);
 
+// -----------------------------------------------------------------------------
+//! \brief      This routine reserves room for a serialized NPI frame directly
+//!             in the transport layer transmit buffer. Frames reserved before
+//!             the next call to NPITL_sendTxFramesTL() are sent together in a
+//!             single transaction where the transport allows it.
+//!
+//! \param[in]  len - Length of the frame (header and payload).
+//!
+//! \return     uint8_t* - Pointer to write the frame to, or NULL if NPI is
+//!                        busy or the frame does not fit.
+// -----------------------------------------------------------------------------
+uint8_t *NPITL_reserveTxFrameTL(uint16_t len);
+
+// -----------------------------------------------------------------------------
+//! \brief      This routine sends all frames reserved with
+//!             NPITL_reserveTxFrameTL() in one transport transaction.
+//!
+//! \return     uint8_t - NPI Error Code value
+// -----------------------------------------------------------------------------
+uint8_t NPITL_sendTxFramesTL(void);
+
 // -----------------------------------------------------------------------------
 //! \brief      This routine is used to handle an Rem RDY edge from the app
 //!             context. Certain operations such as UART_read() cannot be
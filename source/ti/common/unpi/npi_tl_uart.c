@@ -106,6 +106,9 @@ static uint16_t TransportRxLen = 0;
 //! \brief Length of bytes to send from NPI TL Tx Buffer
 static uint16_t TransportTxLen = 0;
 
+//! \brief SOF of the next packet was the last byte of the previous read
+static uint8_t RxSofPending = FALSE;
+
 //! \brief UART Object. Initialized in board specific files
 extern UARTCC26XX_Object uartCC26XXObjects[];
 
@@ -113,6 +116,7 @@ extern UARTCC26XX_Object uartCC26XXObjects[];
 extern uint8_t *npiRxBuf;
 extern uint8_t *npiTxBuf;
 extern uint16_t npiBufSize;
+extern uint16_t npiRxBufOffset;
 
 //*****************************************************************************
 // Function Prototypes
@@ -353,14 +357,14 @@ void NPITLUART_readCallBack(UART_Handle handle, void *ptr, size_t size)
           npiTransmitCB)
     {
         // The Rx Buffer can contain more than the one valid packet
-        // Must only return the number of bytes for the first valid packet and
-        // shift the remaining bytes to the beginning of the RX buffer after the
-        // CB has completed
+        // Each packet is handed up in place at npiRxBufOffset. The remaining
+        // bytes are only moved to the beginning of the RX buffer once all
+        // complete packets have been consumed
 
         // SOF has already been removed from npiRxBuf here. It is removed
         // when bytes are copied from the ISR Rx buffer to npiRxBuf
-        packetSize = (uint16) npiRxBuf[0];
-        packetSize += ((uint16) npiRxBuf[1]) << 8;
+        packetSize = (uint16) npiRxBuf[npiRxBufOffset];
+        packetSize += ((uint16) npiRxBuf[npiRxBufOffset + 1]) << 8;
         packetSize += NPI_UART_MSG_HDR_LEN;
 
         npiTransmitCB(packetSize,0);
@@ -371,7 +375,7 @@ void NPITLUART_readCallBack(UART_Handle handle, void *ptr, size_t size)
         while(sofIndex < TransportRxLen)
         {
 
-            if (npiRxBuf[sofIndex] == NPI_UART_MSG_SOF)
+            if (npiRxBuf[npiRxBufOffset + sofIndex] == NPI_UART_MSG_SOF)
             {
                 break;
             }
@@ -379,14 +383,22 @@ void NPITLUART_readCallBack(UART_Handle handle, void *ptr, size_t size)
             sofIndex++;
         }
 
+        // A SOF received as the last byte still starts the next packet
+        RxSofPending = (sofIndex == TransportRxLen - 1);
+
         // New RX len does not include bytes prior to and include the
         // next found SOF byte. If no next SOF byte then len is 0
         TransportRxLen = (TransportRxLen == sofIndex) ? 0 :
                               TransportRxLen - sofIndex - 1;
+        npiRxBufOffset += sofIndex + 1;
+    }
 
-        // Copy all bytes following next found SOF to beginning of the RX buf
-        // and check again for another valid packet
-        memcpy(npiRxBuf,&npiRxBuf[sofIndex + 1],TransportRxLen);
+    // Move any partial packet to the beginning of the RX buf so that the
+    // next ISR RX is appended to it
+    if (npiRxBufOffset != 0)
+    {
+        memmove(npiRxBuf, &npiRxBuf[npiRxBufOffset], TransportRxLen);
+        npiRxBufOffset = 0;
     }
 
     UART_read(uartHandle, &isrRxBuf[0], UART_ISR_BUF_SIZE);
@@ -411,6 +423,14 @@ uint16_t NPITLUART_readIsrBuf(size_t size)
     size = ((TransportRxLen + size) > npiBufSize)?
             npiBufSize - TransportRxLen : size;
 
+    if (RxSofPending && size != 0)
+    {
+        // SOF was already received at the end of the previous read
+        memcpy(&npiRxBuf[TransportRxLen],&isrRxBuf[0],size);
+        TransportRxLen += size;
+        RxSofPending = FALSE;
+    }
+    else
     // Check if this is the first byte in the message. If it is then
     // make sure it is equal to SOF but do not write it into the
     // Transport RX Buf. If it is not SOF then ignore all bytes in ISR
@@ -419,6 +439,9 @@ uint16_t NPITLUART_readIsrBuf(size_t size)
         // Start the copying of the message but skip SOF byte
         memcpy(&npiRxBuf[TransportRxLen],&isrRxBuf[1],size-1);
         TransportRxLen += (size - 1);
+
+        // If only the SOF was received the packet follows in the next read
+        RxSofPending = (size == 1);
     }
     else if (TransportRxLen != 0)
     {
@@ -448,6 +471,7 @@ void NPITLUART_readTransport(void)
 #endif // NPI_FLOW_CTRL = 1
 
     TransportRxLen = 0;
+    RxSofPending = FALSE;
     UART_read(uartHandle, &isrRxBuf[0], UART_ISR_BUF_SIZE);
 
     NPIUtil_ExitCS(key);
@@ -463,11 +487,31 @@ void NPITLUART_readTransport(void)
 // -----------------------------------------------------------------------------
 uint16_t NPITLUART_writeTransport(uint16_t len)
 {
+    uint16_t idx;
+    uint16_t frameLen;
     _npiCSKey_t key;
     key = NPIUtil_EnterCS();
 
-    npiTxBuf[NPI_UART_MSG_SOF_IDX] = NPI_UART_MSG_SOF;
-    npiTxBuf[len + 1] = NPITLUART_calcFCS((uint8_t *)&npiTxBuf[1],len);
+    // npiTxBuf may hold several frames reserved by the NPI TL, each one
+    // followed by room for its FCS and the next frame's SOF. Walk the
+    // length fields to frame each of them.
+    for (idx = NPI_UART_MSG_SOF_IDX; idx < len; idx += frameLen + 2)
+    {
+        frameLen = (uint16) npiTxBuf[idx + 1];
+        frameLen += ((uint16) npiTxBuf[idx + 2]) << 8;
+        frameLen += NPI_UART_MSG_HDR_LEN;
+
+        // A single buffer that is not an NPI frame is framed as a whole
+        if (frameLen > (len - idx))
+        {
+            frameLen = len - idx;
+        }
+
+        npiTxBuf[idx] = NPI_UART_MSG_SOF;
+        npiTxBuf[idx + frameLen + 1] = NPITLUART_calcFCS((uint8_t *)&npiTxBuf[idx + 1],
+                                                         frameLen);
+    }
+
     TransportTxLen = len + 2;
 
 #if (NPI_FLOW_CTRL == 1)
@@ -502,14 +546,23 @@ uint16_t NPITLUART_writeTransport(uint16_t len)
 // -----------------------------------------------------------------------------
 uint8_t NPITLUART_validPacketFound(void)
 {
+    uint8_t *pPkt = &npiRxBuf[npiRxBufOffset];
     uint16_t payloadLen;
     uint8_t fcs;
 
+    // The length field may not have been received yet
+    if (TransportRxLen < NPI_UART_MSG_NON_PAYLOAD_LEN)
+    {
+        return(NPI_INCOMPLETE_PKT);
+    }
+
     // SOF has already been removed from npiRxBuf here. It is removed
     // when bytes are copied from the ISR Rx buffer to npiRxBuf
-    payloadLen = (uint16) npiRxBuf[0];
-    payloadLen += ((uint16) npiRxBuf[1]) << 8;
+    payloadLen = (uint16) pPkt[0];
+    payloadLen += ((uint16) pPkt[1]) << 8;
 
+    // Leftover bytes are moved to the beginning of npiRxBuf before the next
+    // read, so a frame only needs to fit the buffer from offset 0
     if ((payloadLen + NPI_UART_MSG_NON_PAYLOAD_LEN) > npiBufSize)
     {
       // Bad Frame Length, impossible to receive it entierely.
@@ -526,9 +579,9 @@ uint8_t NPITLUART_validPacketFound(void)
     }
 
     // Calculate FCS of this message
-    fcs = NPITLUART_calcFCS((uint8_t *)npiRxBuf, payloadLen + NPI_UART_MSG_HDR_LEN);
+    fcs = NPITLUART_calcFCS(pPkt, payloadLen + NPI_UART_MSG_HDR_LEN);
 
-    if (fcs != npiRxBuf[payloadLen + NPI_UART_MSG_HDR_LEN])
+    if (fcs != pPkt[payloadLen + NPI_UART_MSG_HDR_LEN])
     {
         // Invalid FCS, Flush RX buffer before returning error
         TransportRxLen = 0;
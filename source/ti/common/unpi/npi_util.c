@@ -234,3 +234,23 @@ uint8_t *NPIUtil_dequeueMsg(Queue_Handle msgQueue)
 
   return NULL;
 }
+
+// -----------------------------------------------------------------------------
+//! \brief   Returns the message at the head of the RTOS queue without
+//!          removing it.
+//!
+//! \param   msgQueue - queue handle.
+//!
+//! \return  pointer to the head message, NULL if the queue is empty.
+// -----------------------------------------------------------------------------
+uint8_t *NPIUtil_peekMsg(Queue_Handle msgQueue)
+{
+  queueRec_t *pRec = Queue_head(msgQueue);
+
+  if (pRec != (queueRec_t *)msgQueue)
+  {
+    return pRec->pData;
+  }
+
+  return NULL;
+}
@@ -171,6 +171,16 @@ extern uint8_t NPIUtil_enqueueMsg(Queue_Handle msgQueue,
 // -----------------------------------------------------------------------------
 extern uint8_t * NPIUtil_dequeueMsg(Queue_Handle msgQueue);
 
+// -----------------------------------------------------------------------------
+//! \brief   Returns the message at the head of the RTOS queue without
+//!          removing it.
+//!
+//! \param   msgQueue - queue handle.
+//!
+//! \return  pointer to the head message, NULL if the queue is empty.
+// -----------------------------------------------------------------------------
+extern uint8_t * NPIUtil_peekMsg(Queue_Handle msgQueue);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,857 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* -----------------------------------------------------------------------------
+ *  Includes
+ * -----------------------------------------------------------------------------
+ */
+#include <ti/drivers/UART2.h>
+
+#include <ti/display/Display.h>
+#include <ti/display/DisplayUart2.h>
+#include <ti/display/DisplayUart2Async.h>
+
+#include <string.h>
+
+#include <ti/drivers/dpl/ClockP.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+#include <ti/drivers/dpl/SystemP.h>
+#include <ti/drivers/dpl/TaskP.h>
+
+/* -----------------------------------------------------------------------------
+ *  Constants and macros
+ * -----------------------------------------------------------------------------
+ */
+#define DISPLAY_UART_ESC_MOVEPOS_FMT         \
+    "\x1b\x37"    /* Save cursor position */ \
+    "\x1b[10r"    /* Retransmit scroll    */ \
+    "\x1b[%d;%dH" /* Move cursor fmt str  */
+
+#define DISPLAY_UART_ESC_RESTOREPOS "\x1b\x38" /* Restore saved cursor pos */
+
+#define DISPLAY_UART_ESC_CLEAR_CUR_LEFT  "\x1b[1K" /* Clear cursor left  */
+#define DISPLAY_UART_ESC_CLEAR_CUR_RIGHT "\x1b[0K" /* Clear cursor right */
+#define DISPLAY_UART_ESC_CLEAR_BOTH      "\x1b[2K" /* Clear line         */
+#define DISPLAY_UART_ESC_CLEARSEQ_LEN    4
+
+/* Room kept for the end of a line: restore position, or CR LF */
+#define DISPLAY_UART_TRAILER_LEN 2
+
+/* Longest conversion specification replayed, e.g. "%-10.10s" */
+#define DISPLAY_UART_SPEC_LEN 16
+
+/* Characters allowed between '%' and the conversion character */
+#define DISPLAY_UART_SPEC_FLAGS "-+ #0123456789.*l"
+
+/* -----------------------------------------------------------------------------
+ *                           Local variables
+ * -----------------------------------------------------------------------------
+ */
+/* Display function table for asynchronous UART ANSI implementation */
+const Display_FxnTable DisplayUart2Async_fxnTable = {
+    DisplayUart2Async_init,
+    DisplayUart2Async_open,
+    DisplayUart2Async_clear,
+    DisplayUart2Async_clearLines,
+    DisplayUart2Async_vprintf,
+    DisplayUart2Async_close,
+    DisplayUart2Async_control,
+    DisplayUart2Async_getType,
+};
+
+/* Initial VT100 configuration. Must be in RAM to avoid DMA to read from flash
+   (workaround for devices where DMA cannot access all of flash) */
+static char DisplayUart2Async_escInitial[] = "\x1b\x63"    /* Reset terminal */
+                                             "\x1b[2J"     /* Clear entire screen */
+                                             "\x1b[10r"    /* Scrolling region from line 10 */
+                                             "\x1b[11;1H"; /* Set initial cursor to line 11 */
+
+/* Clear screen */
+static const char DisplayUart2Async_escClearScreen[] = "\x1b[2J";
+
+/* -----------------------------------------------------------------------------
+ *                                          Functions
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * @fn          DisplayUart2Async_capture
+ *
+ * @brief       Record the arguments of a print into a line
+ *
+ * @descr       Walks the conversion specifications of fmt the way
+ *              SystemP_vsnprintf() does, and copies each argument, and the
+ *              content of each %s, so the line can be formatted later.
+ *
+ * @param       pLine - line to fill
+ * @param       fmt - format string
+ * @param       va - format arguments
+ *
+ * @return      void
+ */
+static void DisplayUart2Async_capture(DisplayUart2Async_Line *pLine, const char *fmt, va_list va)
+{
+    uint8_t numArgs = 0;
+    size_t strLen   = 0;
+    const char *str;
+    size_t len;
+    char c;
+
+    pLine->fmt = fmt;
+
+    while (((c = *fmt++) != '\0') && (numArgs < DisplayUart2Async_MAX_ARGS))
+    {
+        if (c != '%')
+        {
+            continue;
+        }
+
+        /* Flags, field width and precision; '*' takes an int argument */
+        while (((c = *fmt) != '\0') && (strchr(DISPLAY_UART_SPEC_FLAGS, c) != NULL))
+        {
+            if ((c == '*') && (numArgs < DisplayUart2Async_MAX_ARGS))
+            {
+                pLine->args[numArgs++].i = va_arg(va, int);
+            }
+            fmt++;
+        }
+
+        if ((c == '\0') || (numArgs == DisplayUart2Async_MAX_ARGS))
+        {
+            break;
+        }
+        fmt++;
+
+        switch (c)
+        {
+            case 'd':
+            case 'i':
+            case 'c':
+                pLine->args[numArgs++].i = va_arg(va, int);
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                pLine->args[numArgs++].u = va_arg(va, unsigned int);
+                break;
+            case 'p':
+                pLine->args[numArgs++].p = va_arg(va, void *);
+                break;
+            case 'f':
+                pLine->args[numArgs++].d = va_arg(va, double);
+                break;
+            case 's':
+                /* Copy what fits and keep its offset, the line is copied
+                 * around. The last byte of strArgs always ends a string. */
+                str = va_arg(va, const char *);
+                if (strLen >= DisplayUart2Async_STR_ARGS_LEN)
+                {
+                    pLine->args[numArgs++].u = DisplayUart2Async_STR_ARGS_LEN - 1;
+                    break;
+                }
+                len = 0;
+                if (str != NULL)
+                {
+                    while ((len < DisplayUart2Async_STR_ARGS_LEN - strLen - 1) && (str[len] != '\0'))
+                    {
+                        len++;
+                    }
+                    memcpy(&pLine->strArgs[strLen], str, len);
+                }
+                pLine->strArgs[strLen + len] = '\0';
+                pLine->args[numArgs++].u     = strLen;
+                strLen += len + 1;
+                break;
+            default:
+                /* "%%" and unsupported conversions take no argument */
+                break;
+        }
+    }
+}
+
+/*!
+ * @fn          DisplayUart2Async_replay
+ *
+ * @brief       Format a recorded print
+ *
+ * @descr       Formats the conversion specifications of the line one at a
+ *              time with SystemP_snprintf(), using the recorded arguments.
+ *              Formatting stops at the first specification without one.
+ *
+ * @param       pLine - line recorded by DisplayUart2Async_capture()
+ * @param       buf - output buffer
+ * @param       size - size of buf, at least 1
+ *
+ * @return      Number of characters written, excluding the terminating
+ *              null, or size if the output was truncated.
+ */
+static size_t DisplayUart2Async_replay(const DisplayUart2Async_Line *pLine, char *buf, size_t size)
+{
+    const char *fmt = pLine->fmt;
+    uint8_t argIdx  = 0;
+    char spec[DISPLAY_UART_SPEC_LEN];
+    size_t specLen;
+    size_t len = 0;
+    int ret    = 0;
+    char c;
+
+    while (((c = *fmt++) != '\0') && (len < size))
+    {
+        if (c != '%')
+        {
+            if (len == size - 1)
+            {
+                len = size;
+                break;
+            }
+            buf[len++] = c;
+            continue;
+        }
+
+        /* Rebuild the specification, with '*' replaced by its value */
+        spec[0] = '%';
+        specLen = 1;
+        while (((c = *fmt) != '\0') && (strchr(DISPLAY_UART_SPEC_FLAGS, c) != NULL))
+        {
+            if (c == '*')
+            {
+                /* An int takes up to 11 characters */
+                if ((argIdx == DisplayUart2Async_MAX_ARGS) || (specLen + 12 >= DISPLAY_UART_SPEC_LEN))
+                {
+                    specLen = DISPLAY_UART_SPEC_LEN;
+                    break;
+                }
+                specLen += SystemP_snprintf(&spec[specLen],
+                                            DISPLAY_UART_SPEC_LEN - specLen,
+                                            "%d",
+                                            pLine->args[argIdx++].i);
+            }
+            else if (specLen < DISPLAY_UART_SPEC_LEN - 2)
+            {
+                spec[specLen++] = c;
+            }
+            fmt++;
+        }
+
+        if ((c == '\0') || (specLen >= DISPLAY_UART_SPEC_LEN - 1))
+        {
+            break;
+        }
+        fmt++;
+
+        spec[specLen++] = c;
+        spec[specLen]   = '\0';
+
+        if ((argIdx == DisplayUart2Async_MAX_ARGS) && (c != '%'))
+        {
+            break;
+        }
+
+        switch (c)
+        {
+            case 'd':
+            case 'i':
+            case 'c':
+                ret = SystemP_snprintf(buf + len, size - len, spec, pLine->args[argIdx++].i);
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                ret = SystemP_snprintf(buf + len, size - len, spec, pLine->args[argIdx++].u);
+                break;
+            case 'p':
+                ret = SystemP_snprintf(buf + len, size - len, spec, pLine->args[argIdx++].p);
+                break;
+            case 's':
+                ret = SystemP_snprintf(buf + len, size - len, spec, &pLine->strArgs[pLine->args[argIdx++].u]);
+                break;
+            case 'f':
+                ret = SystemP_snprintf(buf + len, size - len, spec, pLine->args[argIdx++].d);
+                break;
+            default:
+                ret = SystemP_snprintf(buf + len, size - len, spec);
+                break;
+        }
+
+        /* snprintf returns the length it needed, size marks the truncation */
+        len = ((size_t)ret < size - len) ? len + ret : size;
+    }
+
+    if (len < size)
+    {
+        buf[len] = '\0';
+    }
+
+    return (len);
+}
+
+/*!
+ * @fn          DisplayUart2Async_formatLine
+ *
+ * @brief       Format a line with its cursor movement and clearing sequences
+ *
+ * @param       hDisplay - pointer to Display_Config struct
+ * @param       pLine - line to format
+ * @param       buf - output buffer
+ * @param       size - size of buf
+ *
+ * @return      Number of characters written, or size if the line did not fit
+ */
+static size_t DisplayUart2Async_formatLine(Display_Handle hDisplay,
+                                           const DisplayUart2Async_Line *pLine,
+                                           char *buf,
+                                           size_t size)
+{
+    DisplayUart2Async_Object *object = (DisplayUart2Async_Object *)hDisplay->object;
+    const char *lineClearSeq         = object->lineClearSeq;
+    uint8_t column                   = pLine->column;
+    size_t strSize                   = 0;
+    int ret;
+
+    /* Smallest line: move, clear, one character and trailer */
+    if (size < sizeof(DISPLAY_UART_ESC_MOVEPOS_FMT) + DISPLAY_UART_ESC_CLEARSEQ_LEN + 8)
+    {
+        return (size);
+    }
+
+    if (pLine->line != DisplayUart2_SCROLLING)
+    {
+        /* A cleared line is erased entirely from its first column */
+        if (pLine->fmt == NULL)
+        {
+            lineClearSeq = DISPLAY_UART_ESC_CLEAR_BOTH;
+            column       = 0;
+        }
+
+        /* Add cursor movement escape sequence */
+        ret = SystemP_snprintf(buf, size, DISPLAY_UART_ESC_MOVEPOS_FMT, pLine->line + 1, column + 1);
+        strSize += ret;
+
+        /* Add line clearing escape sequence */
+        if (lineClearSeq)
+        {
+            memcpy(buf + strSize, lineClearSeq, DISPLAY_UART_ESC_CLEARSEQ_LEN);
+            strSize += DISPLAY_UART_ESC_CLEARSEQ_LEN;
+        }
+    }
+
+    if (pLine->fmt != NULL)
+    {
+        ret = DisplayUart2Async_replay(pLine, buf + strSize, size - strSize - DISPLAY_UART_TRAILER_LEN);
+        if ((size_t)ret >= size - strSize - DISPLAY_UART_TRAILER_LEN)
+        {
+            return (size);
+        }
+        strSize += ret;
+    }
+
+    if (pLine->line != DisplayUart2_SCROLLING)
+    {
+        memcpy(buf + strSize, DISPLAY_UART_ESC_RESTOREPOS, DISPLAY_UART_TRAILER_LEN);
+    }
+    else
+    {
+        buf[strSize]     = '\r';
+        buf[strSize + 1] = '\n';
+    }
+
+    return (strSize + DISPLAY_UART_TRAILER_LEN);
+}
+
+/*!
+ * @fn          DisplayUart2Async_appendLine
+ *
+ * @brief       Add a line to the output buffer, sending the buffer first if
+ *              the line does not fit behind its content
+ *
+ * @param       hDisplay - pointer to Display_Config struct
+ * @param       pLine - line to add
+ * @param       strSize - number of characters in the output buffer
+ *
+ * @return      New number of characters in the output buffer
+ */
+static size_t DisplayUart2Async_appendLine(Display_Handle hDisplay, const DisplayUart2Async_Line *pLine, size_t strSize)
+{
+    DisplayUart2Async_Object *object   = (DisplayUart2Async_Object *)hDisplay->object;
+    DisplayUart2Async_HWAttrs *hwAttrs = (DisplayUart2Async_HWAttrs *)hDisplay->hwAttrs;
+    size_t len;
+
+    len = DisplayUart2Async_formatLine(hDisplay, pLine, hwAttrs->strBuf + strSize, hwAttrs->strBufLen - strSize);
+    if ((len == hwAttrs->strBufLen - strSize) && (strSize != 0))
+    {
+        UART2_write(object->hUart, hwAttrs->strBuf, strSize, NULL);
+        strSize = 0;
+        len     = DisplayUart2Async_formatLine(hDisplay, pLine, hwAttrs->strBuf, hwAttrs->strBufLen);
+    }
+
+    /* A line longer than the whole buffer is dropped */
+    if (len == hwAttrs->strBufLen - strSize)
+    {
+        return (strSize);
+    }
+
+    return (strSize + len);
+}
+
+/*!
+ * @fn          DisplayUart2Async_flush
+ *
+ * @brief       Format the lines changed since the last flush and send them
+ *
+ * @descr       Each line is copied out with interrupts disabled and then
+ *              formatted, so printing is never held up by formatting.
+ *
+ * @param       hDisplay - pointer to Display_Config struct
+ *
+ * @return      void
+ */
+static void DisplayUart2Async_flush(Display_Handle hDisplay)
+{
+    DisplayUart2Async_Object *object   = (DisplayUart2Async_Object *)hDisplay->object;
+    DisplayUart2Async_HWAttrs *hwAttrs = (DisplayUart2Async_HWAttrs *)hDisplay->hwAttrs;
+    DisplayUart2Async_Line line;
+    size_t strSize = 0;
+    bool clearScreen;
+    bool dirty;
+    uintptr_t key;
+    uint8_t i;
+
+    key                 = HwiP_disable();
+    clearScreen         = object->clearScreen;
+    object->clearScreen = false;
+    HwiP_restore(key);
+
+    if (clearScreen)
+    {
+        memcpy(hwAttrs->strBuf, DisplayUart2Async_escClearScreen, sizeof(DisplayUart2Async_escClearScreen) - 1);
+        strSize = sizeof(DisplayUart2Async_escClearScreen) - 1;
+    }
+
+    for (i = 0; i < hwAttrs->numLines; i++)
+    {
+        key   = HwiP_disable();
+        dirty = hwAttrs->lines[i].dirty;
+        if (dirty)
+        {
+            line                    = hwAttrs->lines[i];
+            hwAttrs->lines[i].dirty = false;
+        }
+        HwiP_restore(key);
+
+        if (dirty)
+        {
+            strSize = DisplayUart2Async_appendLine(hDisplay, &line, strSize);
+        }
+    }
+
+    while (true)
+    {
+        key   = HwiP_disable();
+        dirty = (object->scrollCount != 0);
+        if (dirty)
+        {
+            line               = hwAttrs->scrollLines[object->scrollHead];
+            object->scrollHead = (object->scrollHead + 1) % hwAttrs->numScrollLines;
+            object->scrollCount--;
+        }
+        HwiP_restore(key);
+
+        if (!dirty)
+        {
+            break;
+        }
+
+        strSize = DisplayUart2Async_appendLine(hDisplay, &line, strSize);
+    }
+
+    if (strSize != 0)
+    {
+        UART2_write(object->hUart, hwAttrs->strBuf, strSize, NULL);
+    }
+}
+
+/*!
+ * @fn          DisplayUart2Async_kick
+ *
+ * @brief       Wake up the output task, unless already woken. Called with
+ *              interrupts disabled.
+ *
+ * @param       object - display object
+ *
+ * @return      true if the output task must be posted
+ */
+static bool DisplayUart2Async_kick(DisplayUart2Async_Object *object)
+{
+    if (object->kicked)
+    {
+        return (false);
+    }
+
+    object->kicked = true;
+
+    return (true);
+}
+
+/*!
+ * @fn          DisplayUart2Async_taskFxn
+ *
+ * @brief       Output task: waits for changes, lets them coalesce for one
+ *              refresh period, then sends them.
+ *
+ * @param       arg - pointer to Display_Config struct
+ *
+ * @return      void
+ */
+static void DisplayUart2Async_taskFxn(void *arg)
+{
+    Display_Handle hDisplay            = (Display_Handle)arg;
+    DisplayUart2Async_Object *object   = (DisplayUart2Async_Object *)hDisplay->object;
+    DisplayUart2Async_HWAttrs *hwAttrs = (DisplayUart2Async_HWAttrs *)hDisplay->hwAttrs;
+    uint32_t periodTicks               = hwAttrs->refreshPeriodUs / ClockP_getSystemTickPeriod();
+    uintptr_t key;
+
+    while (true)
+    {
+        SemaphoreP_pend(object->kickSem, SemaphoreP_WAIT_FOREVER);
+
+        /* Returns early on DISPLAYUART2ASYNC_CMD_FLUSH */
+        SemaphoreP_pend(object->flushSem, periodTicks);
+
+        /* Changes from here on need a new refresh */
+        key            = HwiP_disable();
+        object->kicked = false;
+        HwiP_restore(key);
+
+        DisplayUart2Async_flush(hDisplay);
+    }
+}
+
+/*!
+ * @fn          DisplayUart2Async_init
+ *
+ * @brief       Does nothing.
+ *
+ * @return      void
+ */
+void DisplayUart2Async_init(Display_Handle handle)
+{}
+
+/*!
+ * @fn          DisplayUart2Async_open
+ *
+ * @brief       Initialize the UART transport and start the output task
+ *
+ * @descr       Opens the UART index specified in the HWAttrs, clears the line
+ *              slots and constructs the output task and its semaphores
+ *
+ * @param       hDisplay - pointer to Display_Config struct
+ * @param       params - display parameters
+ *
+ * @return      Pointer to Display_Config struct
+ */
+Display_Handle DisplayUart2Async_open(Display_Handle hDisplay, Display_Params *params)
+{
+    DisplayUart2Async_HWAttrs *hwAttrs = (DisplayUart2Async_HWAttrs *)hDisplay->hwAttrs;
+    DisplayUart2Async_Object *object   = (DisplayUart2Async_Object *)hDisplay->object;
+
+    UART2_Params uartParams;
+    TaskP_Params taskParams;
+
+    UART2_Params_init(&uartParams);
+    uartParams.baudRate  = hwAttrs->baudRate;
+    uartParams.writeMode = UART2_Mode_BLOCKING;
+
+    memset(hwAttrs->lines, 0, hwAttrs->numLines * sizeof(DisplayUart2Async_Line));
+    object->kicked       = false;
+    object->clearScreen  = false;
+    object->scrollHead   = 0;
+    object->scrollCount  = 0;
+    object->droppedLines = 0;
+
+    switch (params->lineClearMode)
+    {
+        case DISPLAY_CLEAR_BOTH:
+            object->lineClearSeq = DISPLAY_UART_ESC_CLEAR_BOTH;
+            break;
+        case DISPLAY_CLEAR_LEFT:
+            object->lineClearSeq = DISPLAY_UART_ESC_CLEAR_CUR_LEFT;
+            break;
+        case DISPLAY_CLEAR_RIGHT:
+            object->lineClearSeq = DISPLAY_UART_ESC_CLEAR_CUR_RIGHT;
+            break;
+        default: /* fall-through */
+        case DISPLAY_CLEAR_NONE:
+            object->lineClearSeq = NULL;
+            break;
+    }
+
+    object->hUart = UART2_open(hwAttrs->uartIdx, &uartParams);
+    if (NULL == object->hUart)
+    {
+        return NULL;
+    }
+
+    /* Send VT100 initial configuration to terminal */
+    UART2_write(object->hUart, DisplayUart2Async_escInitial, sizeof(DisplayUart2Async_escInitial) - 1, NULL);
+
+    object->kickSem  = SemaphoreP_constructBinary(&object->kickSemStruct, 0);
+    object->flushSem = SemaphoreP_constructBinary(&object->flushSemStruct, 0);
+
+    TaskP_Params_init(&taskParams);
+    taskParams.name      = "DisplayUart2Async";
+    taskParams.arg       = hDisplay;
+    taskParams.priority  = hwAttrs->taskPriority;
+    taskParams.stack     = hwAttrs->taskStack;
+    taskParams.stackSize = hwAttrs->taskStackSize;
+
+    if (TaskP_construct(&object->task, DisplayUart2Async_taskFxn, &taskParams) == NULL)
+    {
+        SemaphoreP_destruct(&object->kickSemStruct);
+        SemaphoreP_destruct(&object->flushSemStruct);
+        UART2_close(object->hUart);
+        object->hUart = NULL;
+        return NULL;
+    }
+
+    return hDisplay;
+}
+
+/*!
+ * @fn          DisplayUart2Async_clear
+ *
+ * @brief       Clear the screen and all the line slots
+ *
+ * @param       hDisplay - pointer to Display_Config struct
+ *
+ * @return      void
+ */
+void DisplayUart2Async_clear(Display_Handle hDisplay)
+{
+    DisplayUart2Async_Object *object   = (DisplayUart2Async_Object *)hDisplay->object;
+    DisplayUart2Async_HWAttrs *hwAttrs = (DisplayUart2Async_HWAttrs *)hDisplay->hwAttrs;
+    bool post;
+    uintptr_t key;
+    uint8_t i;
+
+    key = HwiP_disable();
+    for (i = 0; i < hwAttrs->numLines; i++)
+    {
+        hwAttrs->lines[i].dirty = false;
+    }
+    object->scrollCount = 0;
+    object->clearScreen = true;
+    post                = DisplayUart2Async_kick(object);
+    HwiP_restore(key);
+
+    if (post)
+    {
+        SemaphoreP_post(object->kickSem);
+    }
+}
+
+/*!
+ * @fn          DisplayUart2Async_clearLines
+ *
+ * @brief       Clear the specified display lines (inclusive).
+ *
+ * @param       hDisplay - pointer to Display_Config struct
+ * @param       lineFrom - line index (0 .. )
+ * @param       lineTo - line index (0 .. )
+ *
+ * @return      void
+ */
+void DisplayUart2Async_clearLines(Display_Handle hDisplay, uint8_t lineFrom, uint8_t lineTo)
+{
+    DisplayUart2Async_Object *object   = (DisplayUart2Async_Object *)hDisplay->object;
+    DisplayUart2Async_HWAttrs *hwAttrs = (DisplayUart2Async_HWAttrs *)hDisplay->hwAttrs;
+    bool post = false;
+    uintptr_t key;
+    uint32_t curLine;
+
+    if (lineTo <= lineFrom)
+    {
+        lineTo = lineFrom;
+    }
+
+    for (curLine = lineFrom; (curLine <= lineTo) && (curLine < hwAttrs->numLines); curLine++)
+    {
+        key                           = HwiP_disable();
+        hwAttrs->lines[curLine].fmt   = NULL;
+        hwAttrs->lines[curLine].line  = curLine;
+        hwAttrs->lines[curLine].dirty = true;
+        post |= DisplayUart2Async_kick(object);
+        HwiP_restore(key);
+    }
+
+    if (post)
+    {
+        SemaphoreP_post(object->kickSem);
+    }
+}
+
+/*!
+ * @fn          DisplayUart2Async_vprintf
+ *
+ * @brief       Record a text string for a line, to be sent by the output task
+ *
+ * @descr       The arguments are captured on the stack and copied to the line
+ *              slot with interrupts disabled, replacing its previous content.
+ *
+ * @param       hDisplay - pointer to Display_Config struct
+ * @param       line - line index (0..)
+ * @param       column - column index (0..)
+ * @param       fmt - format string, must remain valid
+ * @param       aN - optional format arguments
+ *
+ * @return      void
+ */
+void DisplayUart2Async_vprintf(Display_Handle hDisplay, uint8_t line, uint8_t column, const char *fmt, va_list va)
+{
+    DisplayUart2Async_Object *object   = (DisplayUart2Async_Object *)hDisplay->object;
+    DisplayUart2Async_HWAttrs *hwAttrs = (DisplayUart2Async_HWAttrs *)hDisplay->hwAttrs;
+    DisplayUart2Async_Line newLine;
+    DisplayUart2Async_Line *pLine;
+    bool post = false;
+    uintptr_t key;
+
+    if (line == DisplayUart2_SCROLLING)
+    {
+        if (hwAttrs->numScrollLines == 0)
+        {
+            return;
+        }
+    }
+    else if (line >= hwAttrs->numLines)
+    {
+        return;
+    }
+
+    DisplayUart2Async_capture(&newLine, fmt, va);
+    newLine.line   = line;
+    newLine.column = column;
+    newLine.dirty  = true;
+
+    key = HwiP_disable();
+
+    if (line == DisplayUart2_SCROLLING)
+    {
+        if (object->scrollCount == hwAttrs->numScrollLines)
+        {
+            /* Ring full, overwrite the oldest line */
+            object->scrollHead = (object->scrollHead + 1) % hwAttrs->numScrollLines;
+            object->scrollCount--;
+            object->droppedLines++;
+        }
+        pLine = &hwAttrs->scrollLines[(object->scrollHead + object->scrollCount) % hwAttrs->numScrollLines];
+        object->scrollCount++;
+    }
+    else
+    {
+        pLine = &hwAttrs->lines[line];
+    }
+
+    *pLine = newLine;
+    post   = DisplayUart2Async_kick(object);
+
+    HwiP_restore(key);
+
+    if (post)
+    {
+        SemaphoreP_post(object->kickSem);
+    }
+}
+
+/*!
+ * @fn          DisplayUart2Async_close
+ *
+ * @brief       Stops the output task and closes the UART handle
+ *
+ * @descr       Lines not yet sent are discarded.
+ *
+ * @param       hDisplay - pointer to Display_Config struct
+ *
+ * @return      void
+ */
+void DisplayUart2Async_close(Display_Handle hDisplay)
+{
+    DisplayUart2Async_Object *object = (DisplayUart2Async_Object *)hDisplay->object;
+
+    TaskP_destruct(&object->task);
+    SemaphoreP_destruct(&object->kickSemStruct);
+    SemaphoreP_destruct(&object->flushSemStruct);
+
+    UART2_close(object->hUart);
+    object->hUart = NULL;
+}
+
+/*!
+ * @fn          DisplayUart2Async_control
+ *
+ * @brief       Function for setting control parameters of the Display driver
+ *              after it has been opened.
+ *
+ * @param       hDisplay - pointer to Display_Config struct
+ * @param       cmd - command to execute, ::DISPLAYUART2ASYNC_CMD_FLUSH
+ * @param       arg - argument to the command
+ *
+ * @return      ::DISPLAY_STATUS_SUCCESS, or ::DISPLAY_STATUS_UNDEFINEDCMD for
+ *              other commands
+ */
+int DisplayUart2Async_control(Display_Handle hDisplay, unsigned int cmd, void *arg)
+{
+    DisplayUart2Async_Object *object = (DisplayUart2Async_Object *)hDisplay->object;
+
+    if (cmd != DISPLAYUART2ASYNC_CMD_FLUSH)
+    {
+        return DISPLAY_STATUS_UNDEFINEDCMD;
+    }
+
+    /* Cut the refresh period short, if the output task is waiting in it */
+    SemaphoreP_post(object->flushSem);
+
+    return DISPLAY_STATUS_SUCCESS;
+}
+
+/*!
+ * @fn          DisplayUart2Async_getType
+ *
+ * @brief       Returns type of transport
+ *
+ * @return      Display type UART
+ */
+unsigned int DisplayUart2Async_getType(void)
+{
+    return Display_Type_UART | Display_Type_ANSI;
+}
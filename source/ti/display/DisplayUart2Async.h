@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/** ============================================================================
+ *  @file       DisplayUart2Async.h
+ *
+ *  @brief      Display.h implementation for deferred ANSI UART output
+ *
+ *  # DisplayUart2Async specifics #
+ *
+ *  DisplayUart2Async produces the same ANSI/VT100 output as DisplayUart2Ansi,
+ *  but takes the console I/O out of the calling context. Display_printf()
+ *  only records the format string and copies its arguments into the slot of
+ *  the target line, replacing what was previously printed there. A low
+ *  priority task wakes up at most once per refresh period, formats the lines
+ *  that changed and sends them all with a single UART2_write().
+ *
+ *  A line printed many times within one refresh period therefore costs one
+ *  argument copy per print and is formatted and sent once, with its latest
+ *  content. Lines printed with the `DisplayUart2_SCROLLING` line specifier
+ *  are a log rather than a screen position: they are queued in a ring of
+ *  slots instead and, if the ring is full, the oldest is overwritten.
+ *
+ *  Since formatting happens later:
+ *    * The format string is kept by reference and must remain valid, as
+ *      string literals do.
+ *    * Up to #DisplayUart2Async_MAX_ARGS arguments are recorded.
+ *    * The content of `%s` arguments is copied, truncated to what fits in
+ *      #DisplayUart2Async_STR_ARGS_LEN bytes for all `%s` of the call.
+ *
+ *  Display_control() accepts #DISPLAYUART2ASYNC_CMD_FLUSH to send the pending
+ *  lines without waiting for the end of the refresh period.
+ *
+ *  # Usage Example #
+ *
+ *  @code
+ *  #include <ti/display/Display.h>
+ *  #include <ti/display/DisplayUart2Async.h>
+ *
+ *  #define MAXPRINTLEN 512
+ *
+ *  DisplayUart2Async_Object displayUart2AsyncObject;
+ *  static char uartStringBuf[MAXPRINTLEN];
+ *  static DisplayUart2Async_Line displayLines[24];
+ *  static DisplayUart2Async_Line displayScrollLines[8];
+ *  static uint8_t displayTaskStack[1024];
+ *
+ *  const DisplayUart2Async_HWAttrs displayUart2AsyncHWAttrs = {
+ *      .uartIdx          = CONFIG_DISPLAY_UART,
+ *      .baudRate         = 115200,
+ *      .strBuf           = uartStringBuf,
+ *      .strBufLen        = MAXPRINTLEN,
+ *      .lines            = displayLines,
+ *      .numLines         = 24,
+ *      .scrollLines      = displayScrollLines,
+ *      .numScrollLines   = 8,
+ *      .refreshPeriodUs  = 50000,
+ *      .taskPriority     = 1,
+ *      .taskStack        = displayTaskStack,
+ *      .taskStackSize    = sizeof(displayTaskStack),
+ *  };
+ *
+ *  const Display_Config Display_config[] = {
+ *      {
+ *          .fxnTablePtr = &DisplayUart2Async_fxnTable,
+ *          .object      = &displayUart2AsyncObject,
+ *          .hwAttrs     = &displayUart2AsyncHWAttrs
+ *      }
+ *  };
+ *  @endcode
+ *
+ *  ============================================================================
+ */
+
+#ifndef ti_display_DisplayUart2Async__include
+#define ti_display_DisplayUart2Async__include
+
+#include <ti/drivers/dpl/SemaphoreP.h>
+#include <ti/drivers/dpl/TaskP.h>
+#include <ti/drivers/UART2.h>
+#include <ti/display/Display.h>
+#include <ti/display/DisplayUart2.h>
+#include <stdint.h>
+
+/*!
+ *  Send the pending lines now. The refresh period restarts after they are
+ *  sent. arg is unused.
+ */
+#define DISPLAYUART2ASYNC_CMD_FLUSH (DISPLAY_CMD_RESERVED + 0)
+
+/*! Maximum number of arguments recorded per Display_printf() call */
+#ifndef DisplayUart2Async_MAX_ARGS
+    #define DisplayUart2Async_MAX_ARGS 6
+#endif
+
+/*! Bytes available per line for the content of its `%s` arguments */
+#ifndef DisplayUart2Async_STR_ARGS_LEN
+    #define DisplayUart2Async_STR_ARGS_LEN 64
+#endif
+
+extern const Display_FxnTable DisplayUart2Async_fxnTable;
+
+/*!
+ *  @brief      Recorded Display_printf() argument, %s are an offset in strArgs
+ */
+typedef union
+{
+    int32_t i;
+    uint32_t u;
+    void *p;
+    double d;
+} DisplayUart2Async_Arg;
+
+/*!
+ *  @brief      Content of one display line
+ *
+ *  The application provides the arrays of lines, it must not access their
+ *  fields.
+ */
+typedef struct
+{
+    /*! Format string, NULL when the line is cleared */
+    const char *fmt;
+    DisplayUart2Async_Arg args[DisplayUart2Async_MAX_ARGS];
+    char strArgs[DisplayUart2Async_STR_ARGS_LEN];
+    uint8_t line;
+    uint8_t column;
+    /*! Changed since it was last sent */
+    bool dirty;
+} DisplayUart2Async_Line;
+
+/*!
+ *  @brief      DisplayUart2Async Hardware attributes
+ *
+ *  A pointer to a variable of this type is passed as hwAttrs in the
+ *  Display_config entry. Display_printf() to a line at or beyond numLines
+ *  is dropped, as are Display_clearLines() past it.
+ */
+typedef struct
+{
+    /*! Index of uart in UART_config[] */
+    unsigned int uartIdx;
+    /*! Baud rate for uart */
+    unsigned int baudRate;
+    /*! Buffer for formatting messages, sent with one write when it fits */
+    char *strBuf;
+    /*! Size of buffer */
+    uint16_t strBufLen;
+    /*! One slot per fixed screen line */
+    DisplayUart2Async_Line *lines;
+    /*! Number of elements of lines */
+    uint8_t numLines;
+    /*! Ring of slots for the scrolling section, can be NULL */
+    DisplayUart2Async_Line *scrollLines;
+    /*! Number of elements of scrollLines */
+    uint8_t numScrollLines;
+    /*! Minimum time between two writes, in microseconds */
+    uint32_t refreshPeriodUs;
+    /*! Priority of the output task, lower than the application tasks */
+    int taskPriority;
+    /*! Stack of the output task */
+    void *taskStack;
+    /*! Size of taskStack in bytes */
+    size_t taskStackSize;
+} DisplayUart2Async_HWAttrs;
+
+/*!
+ *  @brief      DisplayUart2Async Object
+ *
+ *  The application must not access any member variables of this structure!
+ */
+typedef struct
+{
+    UART2_Handle hUart;
+    char *lineClearSeq;
+    TaskP_Struct task;
+    /*! Posted on the first change after a flush */
+    SemaphoreP_Struct kickSemStruct;
+    SemaphoreP_Handle kickSem;
+    /*! Posted by DISPLAYUART2ASYNC_CMD_FLUSH */
+    SemaphoreP_Struct flushSemStruct;
+    SemaphoreP_Handle flushSem;
+    /*! Output task has been posted and has not yet taken the lines */
+    bool kicked;
+    /*! Screen clear requested */
+    bool clearScreen;
+    /*! Oldest queued scrolling line and number of queued lines */
+    uint8_t scrollHead;
+    uint8_t scrollCount;
+    /*! Scrolling lines overwritten before they were sent */
+    uint32_t droppedLines;
+} DisplayUart2Async_Object, *DisplayUart2Async_Handle;
+
+void DisplayUart2Async_init(Display_Handle handle);
+Display_Handle DisplayUart2Async_open(Display_Handle handle, Display_Params *params);
+void DisplayUart2Async_clear(Display_Handle handle);
+void DisplayUart2Async_clearLines(Display_Handle handle, uint8_t fromLine, uint8_t toLine);
+void DisplayUart2Async_vprintf(Display_Handle handle, uint8_t line, uint8_t column, const char *fmt, va_list va);
+void DisplayUart2Async_close(Display_Handle handle);
+int DisplayUart2Async_control(Display_Handle handle, unsigned int cmd, void *arg);
+unsigned int DisplayUart2Async_getType(void);
+
+#endif /* ti_display_DisplayUart2Async__include */
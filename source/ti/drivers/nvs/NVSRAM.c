@@ -308,7 +308,7 @@ int_fast16_t NVSRAM_write(NVS_Handle handle, size_t offset, void *buffer, size_t
          *  this is satisfied by the following test:
          *     src == (src & dst)
          */
-        dstBuf = (uint8_t *)((uint32_t)(hwAttrs->regionBase) + offset);
+        dstBuf = (uint8_t *)((uintptr_t)(hwAttrs->regionBase) + offset);
         srcBuf = buffer;
         for (i = 0; i < bufferSize; i++)
         {
@@ -320,7 +320,7 @@ int_fast16_t NVSRAM_write(NVS_Handle handle, size_t offset, void *buffer, size_t
         }
     }
 
-    dstBuf = (uint8_t *)((uint32_t)(hwAttrs->regionBase) + offset);
+    dstBuf = (uint8_t *)((uintptr_t)(hwAttrs->regionBase) + offset);
     srcBuf = buffer;
     memcpy((void *)dstBuf, (void *)srcBuf, bufferSize);
 
@@ -380,7 +380,7 @@ static int_fast16_t doErase(NVS_Handle handle, size_t offset, size_t size)
         return (rangeStatus);
     }
 
-    sectorBase = (void *)((uint32_t)hwAttrs->regionBase + offset);
+    sectorBase = (void *)((uintptr_t)hwAttrs->regionBase + offset);
 
     memset(sectorBase, 0xFF, size);
 
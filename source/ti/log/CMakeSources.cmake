@@ -1,6 +1,6 @@
 cmake_minimum_required(VERSION 3.21.3)
 
-set(SOURCES_COMMON LogSinkBuf.c LogSinkUART.c)
+set(SOURCES_COMMON LogSinkBuf.c LogSinkCompact.c LogSinkUART.c)
 
 set(SOURCES_ITM LogSinkITM.c)
 
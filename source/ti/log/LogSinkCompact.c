@@ -0,0 +1,509 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== LogSinkCompact.c ========
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/TimestampP.h>
+
+#include <ti/log/LogSinkCompact.h>
+
+#define LogSinkCompact_MAX_ARGS   (8)
+#define LogSinkCompact_VARINT_MAX (5)
+#define LogSinkCompact_PTR_SIZE   (sizeof(const char *))
+
+/* Global LogSinkCompact instance reference for use with singleton
+ * implementations of printf.
+ */
+Log_SINK_COMPACT_USE(CONFIG_ti_log_LogSinkCompact_0);
+
+/*
+ *  ======== encodeVarint ========
+ *  Write v as an LEB128 varint and return the number of bytes used.
+ */
+static uint32_t encodeVarint(uint8_t *dst, uint32_t v)
+{
+    uint32_t n = 0;
+
+    while (v >= 0x80)
+    {
+        dst[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    dst[n++] = (uint8_t)v;
+
+    return n;
+}
+
+/*
+ *  ======== peekVarint ========
+ *  Decode a varint stored at offset bytes past the ring tail. Returns the
+ *  number of bytes it occupies.
+ */
+static uint32_t peekVarint(LogSinkCompact_Handle inst, uint32_t offset, uint32_t *v)
+{
+    uint32_t pos   = inst->tail + offset;
+    uint32_t value = 0;
+    uint32_t shift = 0;
+    uint32_t n     = 0;
+    uint8_t byte;
+
+    do
+    {
+        if (pos >= inst->size)
+        {
+            pos -= inst->size;
+        }
+        byte = inst->buffer[pos++];
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        shift += 7;
+        n++;
+    } while ((byte & 0x80) && (n < LogSinkCompact_VARINT_MAX));
+
+    *v = value;
+    return n;
+}
+
+/*
+ *  ======== ringPut ========
+ */
+static void ringPut(LogSinkCompact_Handle inst, const uint8_t *src, uint32_t len)
+{
+    uint32_t first = inst->size - inst->head;
+
+    if (len < first)
+    {
+        memcpy(&inst->buffer[inst->head], src, len);
+        inst->head += len;
+    }
+    else
+    {
+        memcpy(&inst->buffer[inst->head], src, first);
+        memcpy(inst->buffer, src + first, len - first);
+        inst->head = len - first;
+    }
+    inst->used += len;
+}
+
+/*
+ *  ======== ringGet ========
+ */
+static void ringGet(LogSinkCompact_Handle inst, uint8_t *dst, uint32_t len)
+{
+    uint32_t first = inst->size - inst->tail;
+
+    if (len < first)
+    {
+        memcpy(dst, &inst->buffer[inst->tail], len);
+        inst->tail += len;
+    }
+    else
+    {
+        memcpy(dst, &inst->buffer[inst->tail], first);
+        memcpy(dst + first, inst->buffer, len - first);
+        inst->tail = len - first;
+    }
+    inst->used -= len;
+}
+
+/*
+ *  ======== releaseOldest ========
+ *  Advance past the oldest record and fold its delta into the base timestamp.
+ *  Returns the total number of bytes the record occupied. Must be called with
+ *  interrupts disabled.
+ */
+static uint32_t releaseOldest(LogSinkCompact_Handle inst)
+{
+    uint32_t recLen;
+    uint32_t slot;
+    uint32_t delta;
+    uint32_t lenBytes  = peekVarint(inst, 0, &recLen);
+    uint32_t slotBytes = peekVarint(inst, lenBytes, &slot);
+
+    peekVarint(inst, lenBytes + slotBytes, &delta);
+    inst->baseTimestamp += delta;
+
+    return lenBytes + recLen;
+}
+
+/*
+ *  ======== reserve ========
+ *  Make room for len bytes according to the buffer type. Must be called with
+ *  interrupts disabled.
+ */
+static bool reserve(LogSinkCompact_Handle inst, uint32_t len)
+{
+    uint32_t recBytes;
+
+    if (len > inst->size)
+    {
+        return false;
+    }
+
+    if (inst->bufType != LogSinkBuf_Type_CIRCULAR)
+    {
+        return (inst->size - inst->used) >= len;
+    }
+
+    while ((inst->size - inst->used) < len)
+    {
+        recBytes = releaseOldest(inst);
+        inst->tail += recBytes;
+        if (inst->tail >= inst->size)
+        {
+            inst->tail -= inst->size;
+        }
+        inst->used -= recBytes;
+        inst->dropped++;
+        inst->totalDropped++;
+    }
+
+    return true;
+}
+
+/*
+ *  ======== LogSinkCompact_store ========
+ *  Store a record whose arguments have already been encoded. Only the delta
+ *  timestamp and the record framing are computed with interrupts disabled.
+ */
+static void LogSinkCompact_store(LogSinkCompact_Handle inst,
+                                 uint32_t headerPtr,
+                                 const uint8_t *args,
+                                 uint32_t argsLen,
+                                 const uint8_t *data,
+                                 uint32_t dataLen)
+{
+    uintptr_t key;
+    uint32_t now;
+    uint8_t prefix[3 * LogSinkCompact_VARINT_MAX];
+    uint8_t fields[2 * LogSinkCompact_VARINT_MAX];
+    uint32_t fieldsLen;
+    uint32_t prefixLen;
+
+    fieldsLen = encodeVarint(fields, (headerPtr - LogSinkCompact_LOG_PTR_BASE) / LogSinkCompact_PTR_SIZE);
+
+    /* disable interrupts */
+    key = HwiP_disable();
+
+    now = TimestampP_getNative32();
+    fieldsLen += encodeVarint(&fields[fieldsLen], now - inst->lastTimestamp);
+
+    prefixLen = encodeVarint(prefix, fieldsLen + argsLen + dataLen);
+    memcpy(&prefix[prefixLen], fields, fieldsLen);
+    prefixLen += fieldsLen;
+
+    if (!reserve(inst, prefixLen + argsLen + dataLen))
+    {
+        inst->dropped++;
+        inst->totalDropped++;
+        HwiP_restore(key);
+        return;
+    }
+
+    inst->lastTimestamp = now;
+
+    ringPut(inst, prefix, prefixLen);
+    ringPut(inst, args, argsLen);
+    if (dataLen != 0)
+    {
+        ringPut(inst, data, dataLen);
+    }
+
+    /* enable interrupts */
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== LogSinkCompact_printf ========
+ */
+static void LogSinkCompact_printf(LogSinkCompact_Handle inst, uint32_t headerPtr, uint32_t numArgs, va_list argptr)
+{
+    uint8_t args[LogSinkCompact_MAX_ARGS * LogSinkCompact_VARINT_MAX];
+    uint32_t argsLen = 0;
+    uint32_t arg;
+    uint32_t i;
+
+    for (i = 0; i < numArgs; i++)
+    {
+        arg = (uint32_t)va_arg(argptr, uintptr_t);
+        /* zigzag so that small negative values stay short */
+        argsLen += encodeVarint(&args[argsLen], (arg << 1) ^ (uint32_t)((int32_t)arg >> 31));
+    }
+
+    LogSinkCompact_store(inst, headerPtr, args, argsLen, NULL, 0);
+}
+
+/*
+ *  ======== LogSinkCompact_printfDepInjection ========
+ */
+void LogSinkCompact_printfDepInjection(const Log_Module *handle,
+                                       uint32_t header,
+                                       uint32_t headerPtr,
+                                       uint32_t numArgs,
+                                       ...)
+{
+    va_list argptr;
+
+    /* Guard against more arguments being passed in than supported */
+    if (numArgs > LogSinkCompact_MAX_ARGS)
+    {
+        numArgs = LogSinkCompact_MAX_ARGS;
+    }
+
+    va_start(argptr, numArgs);
+    LogSinkCompact_printf((LogSinkCompact_Handle)handle->sinkConfig, headerPtr, numArgs, argptr);
+    va_end(argptr);
+}
+
+/*
+ *  ======== LogSinkCompact_printfDepInjection0 ========
+ */
+void LogSinkCompact_printfDepInjection0(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, headerPtr);
+    LogSinkCompact_printf((LogSinkCompact_Handle)handle->sinkConfig, headerPtr, 0, argptr);
+    va_end(argptr);
+}
+
+/*
+ *  ======== LogSinkCompact_printfDepInjection1 ========
+ */
+void LogSinkCompact_printfDepInjection1(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, headerPtr);
+    LogSinkCompact_printf((LogSinkCompact_Handle)handle->sinkConfig, headerPtr, 1, argptr);
+    va_end(argptr);
+}
+
+/*
+ *  ======== LogSinkCompact_printfDepInjection2 ========
+ */
+void LogSinkCompact_printfDepInjection2(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, headerPtr);
+    LogSinkCompact_printf((LogSinkCompact_Handle)handle->sinkConfig, headerPtr, 2, argptr);
+    va_end(argptr);
+}
+
+/*
+ *  ======== LogSinkCompact_printfDepInjection3 ========
+ */
+void LogSinkCompact_printfDepInjection3(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, headerPtr);
+    LogSinkCompact_printf((LogSinkCompact_Handle)handle->sinkConfig, headerPtr, 3, argptr);
+    va_end(argptr);
+}
+
+/*
+ *  ======== LogSinkCompact_printfSingleton ========
+ *
+ *  This implementation purposefully does not use the handle argument but
+ *  instead references a single, global LogSinkCompact_Instance structure.
+ */
+void LogSinkCompact_printfSingleton(const Log_Module *handle, uint32_t header, uint32_t headerPtr, uint32_t numArgs, ...)
+{
+    va_list argptr;
+
+    /* Guard against more arguments being passed in than supported */
+    if (numArgs > LogSinkCompact_MAX_ARGS)
+    {
+        numArgs = LogSinkCompact_MAX_ARGS;
+    }
+
+    va_start(argptr, numArgs);
+    LogSinkCompact_printf(&LogSinkCompact_CONFIG_ti_log_LogSinkCompact_0_config, headerPtr, numArgs, argptr);
+    va_end(argptr);
+}
+
+/*
+ *  ======== LogSinkCompact_printfSingleton0 ========
+ */
+void LogSinkCompact_printfSingleton0(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, headerPtr);
+    LogSinkCompact_printf(&LogSinkCompact_CONFIG_ti_log_LogSinkCompact_0_config, headerPtr, 0, argptr);
+    va_end(argptr);
+}
+
+/*
+ *  ======== LogSinkCompact_printfSingleton1 ========
+ */
+void LogSinkCompact_printfSingleton1(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, headerPtr);
+    LogSinkCompact_printf(&LogSinkCompact_CONFIG_ti_log_LogSinkCompact_0_config, headerPtr, 1, argptr);
+    va_end(argptr);
+}
+
+/*
+ *  ======== LogSinkCompact_printfSingleton2 ========
+ */
+void LogSinkCompact_printfSingleton2(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, headerPtr);
+    LogSinkCompact_printf(&LogSinkCompact_CONFIG_ti_log_LogSinkCompact_0_config, headerPtr, 2, argptr);
+    va_end(argptr);
+}
+
+/*
+ *  ======== LogSinkCompact_printfSingleton3 ========
+ */
+void LogSinkCompact_printfSingleton3(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, headerPtr);
+    LogSinkCompact_printf(&LogSinkCompact_CONFIG_ti_log_LogSinkCompact_0_config, headerPtr, 3, argptr);
+    va_end(argptr);
+}
+
+/*
+ *  ======== LogSinkCompact_bufDepInjection ========
+ */
+void LogSinkCompact_bufDepInjection(const Log_Module *handle,
+                                    uint32_t header,
+                                    uint32_t headerPtr,
+                                    uint8_t *data,
+                                    size_t size)
+{
+    uint8_t sizeField[LogSinkCompact_VARINT_MAX];
+    uint32_t sizeLen;
+
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    sizeLen = encodeVarint(sizeField, (uint32_t)size);
+
+    LogSinkCompact_store((LogSinkCompact_Handle)handle->sinkConfig, headerPtr, sizeField, sizeLen, data, (uint32_t)size);
+}
+
+/*
+ *  ======== LogSinkCompact_read ========
+ */
+size_t LogSinkCompact_read(LogSinkCompact_Handle inst, uint8_t *dst, size_t size)
+{
+    uintptr_t key;
+    uint32_t recLen;
+    uint32_t recBytes;
+    uint32_t baseTimestamp;
+    uint32_t dropped;
+    uint32_t payload = 0;
+    uint32_t headerLen;
+    uint8_t header[LogSinkCompact_FRAME_HEADER_MAX];
+    uint8_t *records = dst + LogSinkCompact_FRAME_HEADER_MAX;
+    size_t capacity;
+
+    if (size <= LogSinkCompact_FRAME_HEADER_MAX)
+    {
+        return 0;
+    }
+    capacity = size - LogSinkCompact_FRAME_HEADER_MAX;
+
+    key = HwiP_disable();
+
+    baseTimestamp = inst->baseTimestamp;
+    dropped       = inst->dropped;
+    inst->dropped = 0;
+
+    /* Copy one record per critical section. If the writer discards the record
+     * we would have read next, the frame base no longer matches and the frame
+     * is closed; the loss is reported in the next one.
+     */
+    while (inst->used != 0 && inst->dropped == 0)
+    {
+        recBytes = peekVarint(inst, 0, &recLen);
+        recBytes += recLen;
+        if (recBytes > capacity - payload)
+        {
+            break;
+        }
+
+        releaseOldest(inst);
+        ringGet(inst, &records[payload], recBytes);
+        payload += recBytes;
+
+        HwiP_restore(key);
+        key = HwiP_disable();
+    }
+
+    HwiP_restore(key);
+
+    if (payload == 0 && dropped == 0)
+    {
+        return 0;
+    }
+
+    /* Build the frame header now that the payload length is known, and move
+     * it in front of the records.
+     */
+    headerLen = 1;
+    header[0] = LogSinkCompact_FRAME_SYNC;
+    {
+        uint8_t fields[2 * LogSinkCompact_VARINT_MAX];
+        uint32_t fieldsLen = encodeVarint(fields, baseTimestamp);
+        fieldsLen += encodeVarint(&fields[fieldsLen], dropped);
+
+        headerLen += encodeVarint(&header[headerLen], fieldsLen + payload);
+        memcpy(&header[headerLen], fields, fieldsLen);
+        headerLen += fieldsLen;
+    }
+
+    memmove(dst + headerLen, records, payload);
+    memcpy(dst, header, headerLen);
+
+    return headerLen + payload;
+}
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated - http://www.ti.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*!****************************************************************************
+ *  @file       LogSinkCompact.h
+ *  @brief      <b>PRELIMINARY</b> LogSinkCompact interface
+ *
+ *  @warning    These APIs are <b>PRELIMINARY</b>, and subject to
+ *              change in the next few months.
+ *
+ *  LogSinkCompact is a storage sink that keeps log records in a byte ring
+ *  buffer using a variable length encoding. Where #LogSinkBuf spends 36 bytes
+ *  on every record regardless of content, a LogSinkCompact record only spends
+ *  as many bytes as its values need. A typical #Log_printf statement with two
+ *  small arguments occupies 5 to 8 bytes, so the same amount of SRAM or UART
+ *  bandwidth holds several times more records.
+ *
+ *  The sink does not own a transport. The application drains complete records
+ *  with #LogSinkCompact_read and forwards the resulting frames over whatever
+ *  link it has available, or a debugger dumps them from memory. The host tool
+ *  tools/log/LogSinkCompact/logsinkcompact_decode.py turns the frames back into
+ *  text using the .log_data and .log_ptr sections of the application ELF file.
+ *
+ *  # Encoding
+ *  Unsigned values are stored as LEB128 varints: 7 bits per byte, least
+ *  significant group first, with bit 7 set on every byte except the last.
+ *  #Log_printf arguments are zigzag mapped first so that small negative values
+ *  stay short as well.
+ *
+ *  Every record is stored as:
+ *
+ *  Field       | Encoding | Contents
+ *  ----------- | -------- | -------------------------------------------------
+ *  length      | varint   | Number of bytes in the rest of the record
+ *  slot        | varint   | Index of the metadata pointer in .log_ptr
+ *  delta       | varint   | Timestamp ticks since the previous record
+ *  arguments   | varint   | #Log_printf only: one zigzag value per argument
+ *  size, data  | varint   | #Log_buf only: buffer size followed by raw bytes
+ *
+ *  The slot is computed from the metadata pointer address that every log call
+ *  site passes to the sink, as (headerPtr - #LogSinkCompact_LOG_PTR_BASE) / 4.
+ *  The number of arguments and the record type are not stored, since the host
+ *  recovers both from the metadata string.
+ *
+ *  #LogSinkCompact_read wraps the records it returns in a frame:
+ *
+ *  Field       | Encoding | Contents
+ *  ----------- | -------- | -------------------------------------------------
+ *  sync        | byte     | #LogSinkCompact_FRAME_SYNC
+ *  length      | varint   | Number of bytes in the rest of the frame
+ *  timestamp   | varint   | Timestamp the first record's delta is relative to
+ *  dropped     | varint   | Records lost since the previous frame
+ *  records     | bytes    | Zero or more complete records
+ *
+ *  # Buffer types
+ *  - #LogSinkBuf_Type_LINEAR: once full, new records are discarded and
+ *    counted as dropped until the buffer is drained.
+ *  - #LogSinkBuf_Type_CIRCULAR: the oldest records are discarded to make room
+ *    for new ones. The timestamp of a discarded record is folded into the
+ *    frame base, so absolute time is kept across the loss.
+ *
+ *  A record that is larger than the whole buffer is always dropped.
+ *
+ *  # Usage
+ *  @code
+ *  #include <ti/log/LogSinkCompact.h>
+ *
+ *  Log_SINK_COMPACT_DEFINE(CONFIG_ti_log_LogSinkCompact_0, LogSinkBuf_Type_CIRCULAR, 1024);
+ *  Log_MODULE_DEFINE(MyModule,
+ *                    Log_MODULE_INIT_SINK_COMPACT(CONFIG_ti_log_LogSinkCompact_0,
+ *                                                 Log_ALL,
+ *                                                 LogSinkCompact_printfSingleton,
+ *                                                 LogSinkCompact_bufDepInjection,
+ *                                                 NULL));
+ *
+ *  // Later, from a low priority context
+ *  uint8_t frame[128];
+ *  size_t n = LogSinkCompact_read(&LogSinkCompact_CONFIG_ti_log_LogSinkCompact_0_config,
+ *                                 frame, sizeof(frame));
+ *  @endcode
+ ******************************************************************************
+ */
+
+#ifndef ti_log_LogSinkCompact__include
+#define ti_log_LogSinkCompact__include
+
+#include <ti/log/Log.h>
+#include <ti/log/LogSinkBuf.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define Log_TI_LOG_SINK_COMPACT_VERSION 0.1.0
+
+/*!
+ *  @brief Load address of the .log_ptr section
+ *
+ *  Must match the LOG_PTR origin in the linker command file. The host decoder
+ *  takes the address from the .log_ptr section header of the ELF file.
+ */
+#ifndef LogSinkCompact_LOG_PTR_BASE
+#define LogSinkCompact_LOG_PTR_BASE (0x94000008)
+#endif
+
+/*! First byte of every frame returned by #LogSinkCompact_read */
+#define LogSinkCompact_FRAME_SYNC (0xC7)
+
+/*! Largest number of bytes a frame header can occupy */
+#define LogSinkCompact_FRAME_HEADER_MAX (1 + 3 * 5)
+
+/*!
+ *  @brief Largest #Log_printf record: length, slot, delta and 8 arguments
+ */
+#define LogSinkCompact_PRINTF_RECORD_MAX (1 + 10 * 5)
+
+/*
+ *  ======== LogSinkCompact_Instance ========
+ */
+typedef struct LogSinkCompact_Instance
+{
+    uint8_t bufType;
+    uint8_t *buffer;
+    uint32_t size;          /* Capacity of buffer in bytes */
+    uint32_t head;          /* Offset of the next byte to write */
+    uint32_t tail;          /* Offset of the oldest record */
+    uint32_t used;          /* Number of bytes currently stored */
+    uint32_t baseTimestamp; /* Timestamp the oldest record's delta is relative to */
+    uint32_t lastTimestamp; /* Timestamp of the newest record */
+    uint32_t dropped;       /* Records lost since the last read */
+    uint32_t totalDropped;  /* Records lost since startup */
+} LogSinkCompact_Instance;
+
+/*
+ *  ======== LogSinkCompact_Handle ========
+ */
+typedef LogSinkCompact_Instance *LogSinkCompact_Handle;
+
+/*!
+ *  @brief  Move complete records out of the sink.
+ *
+ *  Copies as many complete records as fit into @c dst, prefixed by a frame
+ *  header, and releases their space in the ring buffer. A frame is produced
+ *  even when no records are pending, as long as records have been dropped
+ *  since the previous call, so that the host learns about the loss.
+ *
+ *  Interrupts are disabled while each record is copied. The function may be
+ *  called from task or interrupt context.
+ *
+ *  @param[in]  handle  LogSinkCompact sink handle
+ *
+ *  @param[out] dst     Destination for the frame
+ *
+ *  @param[in]  size    Size of @c dst in bytes. Must be larger than
+ *                      #LogSinkCompact_FRAME_HEADER_MAX plus the largest
+ *                      record for progress to be made.
+ *
+ *  @return Number of bytes written to @c dst, 0 if there was nothing to read
+ */
+extern size_t LogSinkCompact_read(LogSinkCompact_Handle handle, uint8_t *dst, size_t size);
+
+/*!
+ *  @cond NODOC
+ *  @brief  Encode and store a #Log_printf statement into a byte ring buffer.
+ *
+ *  This is a singleton implementation. It assumes that there is only one
+ *  #LogSinkCompact_Instance object in the application and that this instance
+ *  is called LogSinkCompact_CONFIG_ti_log_LogSinkCompact_0_config.
+ *
+ *  @note Applications must not call this function directly. This is a helper
+ *  function to implement #Log_printf
+ *
+ *  @param[in]  handle     Unused handle
+ *
+ *  @param[in]  header     Metadata pointer
+ *
+ *  @param[in]  headerPtr  Pointer to metadata pointer
+ *
+ *  @param[in]  numArgs    Number of arguments
+ *
+ *  @param[in]  ...        Variable number of arguments
+ */
+extern void LogSinkCompact_printfSingleton(const Log_Module *handle,
+                                           uint32_t header,
+                                           uint32_t headerPtr,
+                                           uint32_t numArgs,
+                                           ...);
+
+extern void LogSinkCompact_printfSingleton0(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...);
+
+extern void LogSinkCompact_printfSingleton1(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...);
+
+extern void LogSinkCompact_printfSingleton2(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...);
+
+extern void LogSinkCompact_printfSingleton3(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...);
+/*! @endcond NODOC */
+
+/*!
+ *  @cond NODOC
+ *  @brief  Encode and store a #Log_printf statement into a byte ring buffer.
+ *
+ *  This is a dependency injection implementation. It is able to support an
+ *  arbitrary number of LogSinkCompact instances by passing in the sink state
+ *  through @c handle.
+ *
+ *  @note Applications must not call this function directly. This is a helper
+ *  function to implement #Log_printf
+ *
+ *  @param[in]  handle     Handle to the module and sink instance
+ *
+ *  @param[in]  header     Metadata pointer
+ *
+ *  @param[in]  headerPtr  Pointer to metadata pointer
+ *
+ *  @param[in]  numArgs    Number of arguments
+ *
+ *  @param[in]  ...        Variable number of arguments
+ */
+extern void LogSinkCompact_printfDepInjection(const Log_Module *handle,
+                                              uint32_t header,
+                                              uint32_t headerPtr,
+                                              uint32_t numArgs,
+                                              ...);
+
+extern void LogSinkCompact_printfDepInjection0(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...);
+
+extern void LogSinkCompact_printfDepInjection1(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...);
+
+extern void LogSinkCompact_printfDepInjection2(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...);
+
+extern void LogSinkCompact_printfDepInjection3(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...);
+/*! @endcond NODOC */
+
+/*!
+ *  @cond NODOC
+ *  @brief  Encode and store a #Log_buf statement into a byte ring buffer.
+ *
+ *  @note Applications must not call this function directly. This is a helper
+ *  function to implement #Log_buf
+ *
+ *  @param[in]  handle     LogSinkCompact sink handle
+ *
+ *  @param[in]  header     Metadata pointer
+ *
+ *  @param[in]  headerPtr  Pointer to metadata pointer
+ *
+ *  @param[in]  data       Data buffer to log
+ *
+ *  @param[in]  size       Size in bytes of array to store
+ */
+extern void LogSinkCompact_bufDepInjection(const Log_Module *handle,
+                                           uint32_t header,
+                                           uint32_t headerPtr,
+                                           uint8_t *data,
+                                           size_t size);
+/*! @endcond NODOC */
+
+/*
+ * Helpers to define/use instance.
+ */
+#define Log_SINK_COMPACT_DEFINE(name, type, num_bytes)                                                   \
+    static uint8_t logSinkCompact_##name##_buffer[num_bytes];                                            \
+    LogSinkCompact_Instance LogSinkCompact_##name##_config = {.bufType = type,                           \
+                                                              .buffer  = logSinkCompact_##name##_buffer, \
+                                                              .size    = num_bytes}
+#define Log_SINK_COMPACT_USE(name) extern LogSinkCompact_Instance LogSinkCompact_##name##_config
+#define Log_MODULE_INIT_SINK_COMPACT(name, _levels, printfDelegate, bufDelegate, _dynamicLevelsPtr)                   \
+    {                                                                                                                 \
+        .sinkConfig = &LogSinkCompact_##name##_config, .printf = printfDelegate, .printf0 = printfDelegate##0,        \
+        .printf1 = printfDelegate##1, .printf2 = printfDelegate##2, .printf3 = printfDelegate##3, .buf = bufDelegate, \
+        .levels = _levels, .dynamicLevelsPtr = _dynamicLevelsPtr,                                                     \
+    }
+
+_Log_DEFINE_LOG_VERSION(LogSinkCompact, Log_TI_LOG_SINK_COMPACT_VERSION);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* ti_log_LogSinkCompact__include */
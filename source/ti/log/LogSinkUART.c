@@ -113,6 +113,70 @@ static void LogSinkUART_storePacket(RingBuf_Handle ringObject, unsigned char *pa
     } while ((linearSpace > 0) && (writeCount > 0));
 }
 
+#if defined(LogSinkUART_DEFERRED_FLUSH)
+/*
+ *  =========== LogSinkUART_postWrite ==========
+ *  Hand a segment of the ring buffer over to UART2. The segment must already be
+ *  recorded in object->writeSize so that the write callback can release it.
+ */
+static void LogSinkUART_postWrite(LogSinkUART_Object *object, unsigned char *srcAddr, size_t size)
+{
+    uintptr_t key;
+
+    if (UART2_write(object->uartHandle, srcAddr, size, NULL) != UART2_STATUS_SUCCESS)
+    {
+        /* Data stays in the ring buffer and is retried on the next flush */
+        key               = HwiP_disable();
+        object->writeSize = 0;
+        object->chainSize = 0;
+        object->writeErrors++;
+        HwiP_restore(key);
+    }
+}
+
+/*
+ *  =========== LogSinkUART_writeCallback ==========
+ *  Called by UART2 when a segment has been sent. Releases the segment and
+ *  posts the wrapped part of the reservation, if any.
+ */
+static void LogSinkUART_writeCallback(UART2_Handle handle, void *buf, size_t count, void *userArg, int_fast16_t status)
+{
+    uintptr_t key;
+    unsigned char *srcAddr;
+    size_t available;
+    LogSinkUART_Object *object = (LogSinkUART_Object *)userArg;
+
+    key = HwiP_disable();
+
+    RingBuf_getConsume(&object->ringObj, count);
+    object->bytesSent += count;
+    object->writes++;
+
+    if ((status != UART2_STATUS_SUCCESS) || (object->chainSize == 0))
+    {
+        object->writeSize = 0;
+        object->chainSize = 0;
+        HwiP_restore(key);
+        return;
+    }
+
+    /* The first segment ended at the end of the ring buffer, so the read
+     * pointer is now at its start.
+     */
+    available = RingBuf_getPointer(&object->ringObj, &srcAddr);
+    if (available > object->chainSize)
+    {
+        available = object->chainSize;
+    }
+    object->writeSize = available;
+    object->chainSize = 0;
+
+    HwiP_restore(key);
+
+    LogSinkUART_postWrite(object, srcAddr, available);
+}
+#endif
+
 /*
  *  ======== LogSinkUART_flush ========
  */
@@ -125,7 +189,6 @@ void LogSinkUART_flush(void)
         LogSinkUART_Config *config = (LogSinkUART_Config *)&LogSinkUART_config[i];
         LogSinkUART_Object *object = config->object;
 
-        size_t bytesWritten;    /* Number of bytes written to the UART */
         int available;          /* Number of available linear bytes in ring buffer */
         unsigned char *srcAddr; /* Address in ring buffer where data can be read from */
         size_t readCount;       /* Number of bytes left to read */
@@ -134,6 +197,27 @@ void LogSinkUART_flush(void)
 
         /* If there is no data to flush go to the next ring buffer */
         readCount = RingBuf_getCount(&object->ringObj);
+#if defined(LogSinkUART_DEFERRED_FLUSH)
+        /* A write in progress owns the pending data and chains the rest */
+        if ((readCount == 0) || (object->writeSize != 0))
+        {
+            HwiP_restore(key);
+            continue;
+        }
+
+        /* Reserve everything that is pending: the linear segment now and the
+         * wrapped segment, if any, from the write callback.
+         */
+        available         = RingBuf_getPointer(&object->ringObj, &srcAddr);
+        object->writeSize = available;
+        object->chainSize = readCount - available;
+
+        HwiP_restore(key);
+
+        LogSinkUART_postWrite(object, srcAddr, available);
+#else
+        size_t bytesWritten; /* Number of bytes written to the UART */
+
         if (readCount == 0)
         {
             HwiP_restore(key);
@@ -145,10 +229,62 @@ void LogSinkUART_flush(void)
         UART2_write(object->uartHandle, srcAddr, available, &bytesWritten);
         RingBuf_getConsume(&object->ringObj, bytesWritten);
 
+        object->bytesSent += bytesWritten;
+        if (bytesWritten != 0)
+        {
+            object->writes++;
+        }
+
         HwiP_restore(key);
+#endif
     }
 }
 
+/*
+ *  ======== LogSinkUART_getStats ========
+ */
+void LogSinkUART_getStats(uint_least8_t index, LogSinkUART_Stats *stats)
+{
+    uintptr_t key;
+    LogSinkUART_Config *config         = (LogSinkUART_Config *)&LogSinkUART_config[index];
+    LogSinkUART_Object *object         = config->object;
+    LogSinkUART_HWAttrs const *hwAttrs = config->hwAttrs;
+
+    key = HwiP_disable();
+
+    stats->bytesSent      = object->bytesSent;
+    stats->writes         = object->writes;
+    stats->writeErrors    = object->writeErrors;
+    stats->packetsDropped = object->packetsDropped;
+    stats->startTimestamp = object->startTimestamp;
+    stats->bufSize        = hwAttrs->bufSize;
+    stats->bufUsed        = RingBuf_getCount(&object->ringObj);
+    stats->bufHighWater   = RingBuf_getMaxCount(&object->ringObj);
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== LogSinkUART_resetStats ========
+ */
+void LogSinkUART_resetStats(uint_least8_t index)
+{
+    uintptr_t key;
+    LogSinkUART_Config *config = (LogSinkUART_Config *)&LogSinkUART_config[index];
+    LogSinkUART_Object *object = config->object;
+
+    key = HwiP_disable();
+
+    object->bytesSent        = 0;
+    object->writes           = 0;
+    object->writeErrors      = 0;
+    object->packetsDropped   = 0;
+    object->startTimestamp   = TimestampP_getNative32();
+    object->ringObj.maxCount = RingBuf_getCount(&object->ringObj);
+
+    HwiP_restore(key);
+}
+
 /*
  *  ======== LogSinkUART_init ========
  */
@@ -167,10 +303,24 @@ void LogSinkUART_init(uint_least8_t index)
     /* Construct ring buffer for intermediate storage */
     RingBuf_construct(&object->ringObj, hwAttrs->bufPtr, hwAttrs->bufSize);
 
+    object->writeSize      = 0;
+    object->chainSize      = 0;
+    object->bytesSent      = 0;
+    object->writes         = 0;
+    object->writeErrors    = 0;
+    object->packetsDropped = 0;
+    object->startTimestamp = TimestampP_getNative32();
+
     /* Setup and open UART2 */
     UART2_Params_init(&uartParams);
 
+#if defined(LogSinkUART_DEFERRED_FLUSH)
+    uartParams.writeMode     = UART2_Mode_CALLBACK;
+    uartParams.writeCallback = LogSinkUART_writeCallback;
+    uartParams.userArg       = object;
+#else
     uartParams.writeMode  = UART2_Mode_NONBLOCKING;
+#endif
     uartParams.baudRate   = hwAttrs->baudRate;
     uartParams.parityType = hwAttrs->parity;
 
@@ -208,6 +358,7 @@ void LogSinkUART_printf(LogSinkUART_Config *config, uint32_t headerPtr, uint32_t
     /* Check if the ring buffer is full */
     if (RingBuf_isFull(&object->ringObj))
     {
+        object->packetsDropped++;
         HwiP_restore(key);
         return;
     }
@@ -242,6 +393,7 @@ void LogSinkUART_printf(LogSinkUART_Config *config, uint32_t headerPtr, uint32_t
          */
         packet[0]  = headerPtr & LogSinkUART_OVERFLOW_MASK;
         packetSize = LogSinkUART_OVERFLOW_PACKET_SIZE;
+        object->packetsDropped++;
     }
 
     /* Store packet in intermediate storage */
@@ -441,6 +593,7 @@ void LogSinkUART_bufDepInjection(const Log_Module *handle,
     /* Check if the ring buffer is full */
     if (RingBuf_isFull(&object->ringObj))
     {
+        object->packetsDropped++;
         HwiP_restore(key);
         return;
     }
@@ -472,6 +625,7 @@ void LogSinkUART_bufDepInjection(const Log_Module *handle,
          * about which buffer it is is conserved.
          */
         packet[0] = headerPtr & LogSinkUART_OVERFLOW_MASK;
+        object->packetsDropped++;
         LogSinkUART_storePacket(&object->ringObj, (unsigned char *)packet, LogSinkUART_OVERFLOW_PACKET_SIZE);
     }
 
@@ -211,6 +211,21 @@
  *
  *  The Idle-loop/task will always be run before the power management loop.
  *
+ *  ### Deferred flush
+ *  When the library is built with @c LogSinkUART_DEFERRED_FLUSH defined, the
+ *  UART2 driver is opened in #UART2_Mode_CALLBACK instead. The flush function
+ *  then only disables interrupts long enough to reserve the pending bytes of
+ *  the ring buffer, and hands the first linear segment to UART2 straight from
+ *  the ring buffer, without copying it into the UART2 transmit buffer. The
+ *  write callback releases the sent bytes and posts the wrapped segment, if
+ *  any, so a wrapped ring buffer is drained by a single flush. Log statements
+ *  keep filling the free part of the ring buffer while a write is ongoing.
+ *  Calling the flush function again while a write is ongoing does nothing.
+ *
+ *  In both modes LogSinkUART_getStats() reports how many bytes were sent, how
+ *  many packets were dropped and the ring buffer high-water mark, which can be
+ *  used to size the ring buffer for a given log rate.
+ *
  *  Since each OS has a different implementation of the Idle-loop/task, the
  *  installation of the hook function will also be different for each OS. The
  *  automatic installation is currently supported for FreeRTOS and TI-RTOS 7
@@ -379,10 +394,38 @@ typedef struct
  */
 typedef struct
 {
-    UART2_Handle uartHandle; /*!< UART2 handle */
-    RingBuf_Object ringObj;  /*!< Intermediate ring buffer */
+    UART2_Handle uartHandle;  /*!< UART2 handle */
+    RingBuf_Object ringObj;   /*!< Intermediate ring buffer */
+    size_t writeSize;         /*!< Bytes of the ring buffer owned by UART2 */
+    size_t chainSize;         /*!< Bytes of the wrapped segment still to post */
+    uint32_t bytesSent;       /*!< Bytes handed over to UART2 */
+    uint32_t writes;          /*!< Number of completed UART2 writes */
+    uint32_t writeErrors;     /*!< Number of failed UART2 writes */
+    uint32_t packetsDropped;  /*!< Log packets replaced by an overflow packet or
+                               *   lost, since init or the last reset */
+    uint32_t startTimestamp;  /*!< TimestampP_getNative32() when counting started */
 } LogSinkUART_Object;
 
+/*!
+ *  @brief      LogSinkUART statistics
+ *
+ *  Throughput is @c bytesSent divided by the time elapsed since
+ *  @c startTimestamp. Both timestamps are native 32-bit timestamps; their unit
+ *  is described by TimestampP_nativeFormat32.
+ */
+typedef struct
+{
+    uint32_t bytesSent;      /*!< Bytes written to the UART since the last reset */
+    uint32_t writes;         /*!< Number of completed UART2 writes */
+    uint32_t writeErrors;    /*!< Number of failed UART2 writes */
+    uint32_t packetsDropped; /*!< Log packets replaced by an overflow packet or
+                              *   lost, since init or the last reset */
+    uint32_t startTimestamp; /*!< Native timestamp when counting started */
+    size_t bufSize;          /*!< Size of the intermediate ring buffer */
+    size_t bufUsed;          /*!< Bytes currently waiting in the ring buffer */
+    size_t bufHighWater;     /*!< Largest number of bytes that were waiting */
+} LogSinkUART_Stats;
+
 /*!
  *  @brief  LogSinkUART Global configuration
  *
@@ -430,6 +473,23 @@ typedef LogSinkUART_Instance *LogSinkUART_Handle;
  */
 extern void LogSinkUART_flush(void);
 
+/*!
+ *  @brief  Read the throughput and drop counters of a LogSinkUART sink.
+ *
+ *  @param[in]  index  Index of the sink in @p LogSinkUART_config[]
+ *
+ *  @param[out] stats  Counters since LogSinkUART_init() or the last call to
+ *                     LogSinkUART_resetStats()
+ */
+extern void LogSinkUART_getStats(uint_least8_t index, LogSinkUART_Stats *stats);
+
+/*!
+ *  @brief  Restart the counters of a LogSinkUART sink.
+ *
+ *  @param[in]  index  Index of the sink in @p LogSinkUART_config[]
+ */
+extern void LogSinkUART_resetStats(uint_least8_t index);
+
 /*!
  *  @brief  Initialize a given LogSinkUART sink.
  *
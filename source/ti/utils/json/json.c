@@ -48,12 +48,30 @@ typedef struct
     uint32_t validNum;
 } JSON_objectInternal;
 
+typedef struct
+{
+    parse_stream_T *stream;
+    uint8_t *tokenBuf;
+    JSON_objectInternal *jsonObject;
+    uint8_t textStart;
+    uint32_t validNum;
+} JSON_parserInternal;
+
 /* Header needed in order to create template lib representation */
 #define TEMPLATE_MIN_HEADER_SIZE (12u)
 #define VALIDATION_NUMBER        (0xDEADFACE)
 
 #define ARRAY_TO_OBJ_EXTRA_CHARS_NUM (6)
 
+/* What the json text fed to a parser started with */
+#define TEXT_START_NOT_YET (0u)
+#define TEXT_START_OBJECT  (1u)
+#define TEXT_START_ARRAY   (2u)
+
+/* A json array is parsed as the value of an object named "#" - see Json_parse() */
+#define ARRAY_TO_OBJ_PREFIX "{\"#\":"
+#define ARRAY_TO_OBJ_SUFFIX "}"
+
 extern int sprintf(char *str, const char *format, ...);
 
 /* Utility function - In case input_text contains white spaces at the beginning, skip it */
@@ -268,6 +286,153 @@ int16_t Json_parse(Json_Handle objHandle, char *jsonText, uint16_t jsonTextLen)
     return (JSON_RC__INVALID_OBJECT_HANDLE);
 }
 
+int16_t Json_createParser(Json_Handle *parserHandle, Json_Handle objHandle, uint16_t maxTokenSize)
+{
+    json_rc_T rcode;
+    uint16_t contextSize;
+    JSON_parserInternal *pParser;
+
+    /* Validating object handle */
+    if ((objHandle != 0) && (((JSON_objectInternal *)objHandle)->validNum == VALIDATION_NUMBER))
+    {
+        JSON_objectInternal *pJsonInfo = (JSON_objectInternal *)objHandle;
+        /* Validating that the template pointer in the Json object is valid */
+        if (pJsonInfo->jsonTemplate->validNum == VALIDATION_NUMBER)
+        {
+            if (maxTokenSize == 0)
+            {
+                maxTokenSize = JSON_DEFAULT_TOKEN_SIZE;
+            }
+
+            pParser = (JSON_parserInternal *)(malloc(sizeof(JSON_parserInternal)));
+            if (pParser)
+            {
+                /* The parse context is followed by the token buffer, with room for the parser's sentinel */
+                contextSize     = __JSON_ParseStreamContextSize();
+                pParser->stream = (parse_stream_T *)(malloc((size_t)contextSize + maxTokenSize + 1u));
+                if (pParser->stream)
+                {
+                    pParser->tokenBuf   = (uint8_t *)pParser->stream + contextSize;
+                    pParser->jsonObject = pJsonInfo;
+                    pParser->textStart  = TEXT_START_NOT_YET;
+
+                    /* Empties the Json object and gets the parser ready for the first chunk */
+                    rcode = __JSON_ParseStreamBegin(pParser->stream,
+                                                    pJsonInfo->jsonInternal,
+                                                    pJsonInfo->jsonInternalSizeMAX,
+                                                    pJsonInfo->jsonTemplate->data,
+                                                    pJsonInfo->jsonTemplate->len,
+                                                    pParser->tokenBuf,
+                                                    maxTokenSize + 1u);
+                    if (rcode == JSON_RC__OK)
+                    {
+                        /* Setting the validNum with validation number to validate the handle */
+                        pParser->validNum = VALIDATION_NUMBER;
+                        /* Returning the parser handle we created */
+                        *parserHandle     = (Json_Handle)pParser;
+                        return (rcode);
+                    }
+                    free(pParser->stream);
+                    free(pParser);
+                    return (rcode);
+                }
+                free(pParser);
+            }
+            return (JSON_RC__MEMORY_ALLOCATION_ERROR);
+        }
+        return (JSON_RC__INVALID_TEMPLATE_HANDLE);
+    }
+    return (JSON_RC__INVALID_OBJECT_HANDLE);
+}
+
+int16_t Json_destroyParser(Json_Handle parserHandle)
+{
+    /* Validating parser handle */
+    if ((parserHandle != 0) && (((JSON_parserInternal *)parserHandle)->validNum == VALIDATION_NUMBER))
+    {
+        JSON_parserInternal *pParser = (JSON_parserInternal *)parserHandle;
+        free(pParser->stream);
+        /* initialize the validation number to 0 */
+        pParser->validNum = 0;
+        free(pParser);
+        return (JSON_RC__OK);
+    }
+    return (JSON_RC__INVALID_PARSER_HANDLE);
+}
+
+int16_t Json_parseChunk(Json_Handle parserHandle, const char *chunk, uint16_t chunkLen)
+{
+    json_rc_T rcode;
+    /* Validating parser handle, and the object it fills */
+    if ((parserHandle != 0) && (((JSON_parserInternal *)parserHandle)->validNum == VALIDATION_NUMBER) &&
+        (((JSON_parserInternal *)parserHandle)->jsonObject->validNum == VALIDATION_NUMBER))
+    {
+        JSON_parserInternal *pParser = (JSON_parserInternal *)parserHandle;
+
+        if (pParser->textStart == TEXT_START_NOT_YET)
+        {
+            /* In case the chunk contains white spaces at the beginning of the json text, skip it */
+            skipWS((char **)&chunk, &chunkLen);
+            if (chunkLen == 0)
+            {
+                return (JSON_RC__OK);
+            }
+
+            /* A Json array is parsed as the value of an object name "#", just as in Json_parse() */
+            if (chunk[0] == '[')
+            {
+                pParser->textStart = TEXT_START_ARRAY;
+                rcode              = __JSON_ParseStreamFeed(pParser->stream,
+                                                ARRAY_TO_OBJ_PREFIX,
+                                                sizeof(ARRAY_TO_OBJ_PREFIX) - 1);
+                if (rcode < JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
+                {
+                    return (rcode);
+                }
+            }
+            else
+            {
+                pParser->textStart = TEXT_START_OBJECT;
+            }
+        }
+
+        rcode = __JSON_ParseStreamFeed(pParser->stream, chunk, chunkLen);
+        if (rcode > JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
+        {
+            return (JSON_RC__OK);
+        }
+        return (rcode);
+    }
+    return (JSON_RC__INVALID_PARSER_HANDLE);
+}
+
+int16_t Json_parseFinish(Json_Handle parserHandle)
+{
+    json_rc_T rcode;
+    uint16_t jsonInternalBuffSize;
+    /* Validating parser handle, and the object it fills */
+    if ((parserHandle != 0) && (((JSON_parserInternal *)parserHandle)->validNum == VALIDATION_NUMBER) &&
+        (((JSON_parserInternal *)parserHandle)->jsonObject->validNum == VALIDATION_NUMBER))
+    {
+        JSON_parserInternal *pParser = (JSON_parserInternal *)parserHandle;
+
+        if (pParser->textStart == TEXT_START_ARRAY)
+        {
+            __JSON_ParseStreamFeed(pParser->stream, ARRAY_TO_OBJ_SUFFIX, sizeof(ARRAY_TO_OBJ_SUFFIX) - 1);
+        }
+
+        rcode = __JSON_ParseStreamEnd(pParser->stream, &jsonInternalBuffSize);
+        if (rcode > JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
+        {
+            /* Update current json internal representation size */
+            pParser->jsonObject->jsonInternalSize = jsonInternalBuffSize;
+            return (JSON_RC__OK);
+        }
+        return (rcode);
+    }
+    return (JSON_RC__INVALID_PARSER_HANDLE);
+}
+
 int16_t Json_getArrayMembersCount(Json_Handle objHandle, const char *pKey)
 {
     json_rc_T rcode;
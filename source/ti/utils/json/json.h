@@ -272,6 +272,27 @@
  *  }
  *  @endcode
  *
+ *  A JSON text received in pieces, e.g. over UART or BLE, does not need to be
+ *  reassembled first. A parser created on the object takes the text chunk by
+ *  chunk, split at any point, and keeps only its nesting state and the token
+ *  being received:
+ *  @code
+ *  void snippet() {
+ *      Json_Handle parserHandle;
+ *
+ *      // Room for the longest string, number or raw value in the JSON text
+ *      Json_createParser(&parserHandle, objectHandle, 64);
+ *
+ *      // For every chunk received
+ *      Json_parseChunk(parserHandle, chunk, chunkLen);
+ *
+ *      // Once the whole JSON text was received
+ *      Json_parseFinish(parserHandle);
+ *
+ *      Json_destroyParser(parserHandle);
+ *  }
+ *  @endcode
+ *
  *  @remark Floating point values are not parsed correctly and should not be
  *  used. This will be fixed in a future release and is tracked by TIUTILS-8.
  *
@@ -302,6 +323,8 @@ typedef size_t Json_Handle;
 
 #define JSON_DEFAULT_SIZE (1024u)
 
+#define JSON_DEFAULT_TOKEN_SIZE (64u)
+
 /*!
  *  @brief      This function creates internal template from the
  *              template text.
@@ -429,6 +452,93 @@ int16_t Json_destroyObject(Json_Handle objHandle);
  */
 int16_t Json_parse(Json_Handle objHandle, char *jsonText, uint16_t jsonTextLen);
 
+/*!
+ *  @brief      Create a parser, converting json text received in chunks
+ *              into the internal representation of a json object
+ *
+ *  The json object is emptied, and is filled as the chunks are parsed.
+ *  Besides the token buffer, the memory needed by the parser does not depend
+ *  on the size of the json text.
+ *
+ *  @param[out] parserHandle    pointer to the parser handle
+ *  @param[in]  objHandle       json object handle, created by Json_createObject()
+ *  @param[in]  maxTokenSize    size of the longest token expected in the json
+ *                              text: a string or property name with its quotes,
+ *                              a number, or a whole raw value. If 0,
+ *                              #JSON_DEFAULT_TOKEN_SIZE is used.
+ *
+ *  @remark     The user must free the created parser using Json_destroyParser()
+ *
+ *  @return     Success: #JSON_RC__OK
+ *  @return     Failure: negative error code
+ *
+ *  @par        Example
+ *  @code
+ *  uint16_t ret;
+ *  Json_Handle p;
+ *
+ *  ret = Json_createParser(&p, h, 64);
+ *  @endcode
+ *
+ *  @sa     Json_parseChunk()
+ *  @sa     Json_parseFinish()
+ *  @sa     Json_destroyParser()
+ */
+int16_t Json_createParser(Json_Handle *parserHandle, Json_Handle objHandle, uint16_t maxTokenSize);
+
+/*!
+ *  @brief      This function frees the parser's memory
+ *
+ *  @param[in]  parserHandle    parser handle, created by Json_createParser()
+ *
+ *  @return     Success: #JSON_RC__OK
+ *  @return     Failure: negative error code
+ *
+ *  @sa     Json_createParser()
+ */
+int16_t Json_destroyParser(Json_Handle parserHandle);
+
+/*!
+ *  @brief      Parse the next chunk of the json text
+ *
+ *  Chunks may be split at any character, including within a string or a
+ *  number. The chunk is not referenced once the function returns.
+ *
+ *  @param[in]  parserHandle    parser handle
+ *  @param[in]  chunk           pointer to the chunk of json text
+ *  @param[in]  chunkLen        chunk size
+ *
+ *  @return     Success: #JSON_RC__OK
+ *  @return     Failure: negative error code. The json text cannot be parsed
+ *              any further.
+ *
+ *  @par        Example
+ *  @code
+ *  uint16_t ret;
+ *
+ *  ret = Json_parseChunk(p, "{\"name\":\"Jo", 11);
+ *  ret = Json_parseChunk(p, "hn\",\"age\":30}", 13);
+ *  ret = Json_parseFinish(p);
+ *  @endcode
+ *
+ *  @sa     Json_parseFinish()
+ */
+int16_t Json_parseChunk(Json_Handle parserHandle, const char *chunk, uint16_t chunkLen);
+
+/*!
+ *  @brief      Conclude parsing, once the whole json text was passed to
+ *              Json_parseChunk()
+ *
+ *  @param[in]  parserHandle    parser handle
+ *
+ *  @return     Success: #JSON_RC__OK. The json object holds the same values
+ *              Json_parse() would have given for the whole json text.
+ *  @return     Failure: negative error code
+ *
+ *  @sa     Json_parseChunk()
+ */
+int16_t Json_parseFinish(Json_Handle parserHandle);
+
 /*!
  *  @brief      Retrieve the number of array elements in the provided key
  *
@@ -337,6 +337,46 @@ json_rc_T __JSON_Parse(__O void *json_internal,
     return (rc);
 }
 
+/*****************************************************************************/
+uint16_t __JSON_ParseStreamContextSize(void)
+{
+    return (ParseStreamContextSize());
+}
+
+/*****************************************************************************/
+json_rc_T __JSON_ParseStreamBegin(__O parse_stream_T *stream,
+                                  __O void *json_internal,
+                                  _I_ uint16_t json_internal_size,
+                                  _I_ void *json_template,
+                                  _I_ uint16_t json_template_size,
+                                  _IO_ uint8_t *token_buf,
+                                  _I_ uint16_t token_buf_size)
+{
+    uint16_t minimal_internal_size = json_internal_size;
+    json_rc_T rc;
+
+    rc = __JSON_Init(json_internal, &minimal_internal_size, json_template, json_template_size);
+
+    if (rc > JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
+    {
+        rc = ParseStreamBegin(stream, json_internal, json_internal_size, token_buf, token_buf_size);
+    }
+
+    return (rc);
+}
+
+/*****************************************************************************/
+json_rc_T __JSON_ParseStreamFeed(_IO_ parse_stream_T *stream, _I_ char *json_text, _I_ uint16_t json_text_size)
+{
+    return (ParseStreamFeed(stream, json_text, json_text_size));
+}
+
+/*****************************************************************************/
+json_rc_T __JSON_ParseStreamEnd(_IO_ parse_stream_T *stream, __O uint16_t *json_internal_size)
+{
+    return (ParseStreamEnd(stream, json_internal_size));
+}
+
 /*****************************************************************************/
 static _INLINE_ json_rc_T EmitCharacter(_IO_ io_data_stream_cb_T *output, _I_ char character_to_emit)
 {
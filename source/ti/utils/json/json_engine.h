@@ -99,6 +99,7 @@ typedef enum json_rc_TAG
     JSON_RC__MEMORY_ALLOCATION_ERROR = -300,
     JSON_RC__INVALID_TEMPLATE_HANDLE = -301,
     JSON_RC__INVALID_OBJECT_HANDLE   = -302,
+    JSON_RC__INVALID_PARSER_HANDLE   = -303,
 
     JSON_RC__UNEXPECTED_ERROR = -16384
 
@@ -165,6 +166,60 @@ json_rc_T __JSON_Parse(__O void *json_internal,
                        _I_ uint16_t json_template_size,
                        _I_ uint32_t flags);
 
+/* Context of a push-style parse.  Opaque - allocate __JSON_ParseStreamContextSize() bytes */
+typedef struct parse_stream_TAG parse_stream_T;
+
+/*!
+    \brief     External function returning the size of the context needed for a push-style parse
+
+    \return    Size in bytes
+ */
+uint16_t __JSON_ParseStreamContextSize(void);
+
+/*!
+    \brief     External function for starting a push-style parse of a JSON text into internal representation
+
+    \return    json_rc_T
+
+    \param[out]   stream                Context of the parse, __JSON_ParseStreamContextSize() bytes
+    \param[out]   json_internal         Buffer for internal representation of data
+    \param[in]    json_internal_size    Max buffer size
+    \param[in]    json_template         Buffer containing template describing the JSON
+    \param[in]    json_template_size    Size of template
+    \param[in]    token_buf             Buffer for the token being gathered.  Kept until the parse ends
+    \param[in]    token_buf_size        Size of token buffer - the longest token in the JSON text, plus one
+
+    \sa           __JSON_ParseStreamFeed(), __JSON_ParseStreamEnd()
+ */
+json_rc_T __JSON_ParseStreamBegin(__O parse_stream_T *stream,
+                                  __O void *json_internal,
+                                  _I_ uint16_t json_internal_size,
+                                  _I_ void *json_template,
+                                  _I_ uint16_t json_template_size,
+                                  _IO_ uint8_t *token_buf,
+                                  _I_ uint16_t token_buf_size);
+
+/*!
+    \brief     External function for feeding the next chunk of JSON text to a push-style parse
+
+    \return    json_rc_T
+
+    \param[inout] stream                Context of the parse
+    \param[in]    json_text             Chunk of JSON text.  May be split anywhere - even inside a token
+    \param[in]    json_text_size        Size of chunk
+ */
+json_rc_T __JSON_ParseStreamFeed(_IO_ parse_stream_T *stream, _I_ char *json_text, _I_ uint16_t json_text_size);
+
+/*!
+    \brief     External function for ending a push-style parse, once the whole JSON text was fed
+
+    \return    json_rc_T
+
+    \param[inout] stream                Context of the parse
+    \param[out]   json_internal_size    Used buffer size
+ */
+json_rc_T __JSON_ParseStreamEnd(_IO_ parse_stream_T *stream, __O uint16_t *json_internal_size);
+
 /*!
     \brief     External function for building a JSON text-buffer from internal representation
 
@@ -175,6 +175,7 @@ typedef struct sm_state_TAG
     sm_state_id_T stateID;
     json_rc_T bestCaseRc;
     uint16_t tentativeHash;
+    int32_t ignoredNestingLevel; /* Nesting level still to be skipped when the input ended mid-leaves, or -1 */
 #if defined(ALLOW_PARSING__JSON)
     property_in_map_T propertyFromTemplate;
 #endif
@@ -305,10 +306,9 @@ static _INLINE_ json_rc_T ExpectCharacter(_IO_ in_data_stream_cb_T *input_text,
 }
 
 /*****************************************************************************/
-static _INLINE_ void IgnoreCurrentAndHigherNestingLeaves(_IO_ in_data_stream_cb_T *input_text)
+static _INLINE_ int32_t IgnoreCurrentAndHigherNestingLeaves(_IO_ in_data_stream_cb_T *input_text,
+                                                             _IO_ int32_t nesting_level)
 {
-    int32_t nesting_level = 0;
-
     while ((nesting_level >= 0) && (input_text->position < input_text->dataBufSize))
     {
         if ((input_text->dataBuf[input_text->position] == '{') || (input_text->dataBuf[input_text->position] == '['))
@@ -323,6 +323,9 @@ static _INLINE_ void IgnoreCurrentAndHigherNestingLeaves(_IO_ in_data_stream_cb_
 
         input_text->position++;
     }
+
+    /* Negative once the leaves were skipped.  Otherwise, the input ended in the middle of them */
+    return (nesting_level);
 }
 
 /*****************************************************************************/
@@ -1172,7 +1175,7 @@ static sm_func_rc_T IncreaseNesting_Common(_IO_ sm_state_T *state)
 {
     if (state->nesting.position + 1 >= JSON_MAXIMUM_NESTING)
     {
-        IgnoreCurrentAndHigherNestingLeaves(&state->input);
+        state->ignoredNestingLevel = IgnoreCurrentAndHigherNestingLeaves(&state->input, 0);
 
         UpdateBestCaseRc(&state->bestCaseRc, JSON_RC__RECOVERED__NESTING_EXCEEDED__IGNORING_LEAVES);
 
@@ -2250,6 +2253,8 @@ static _INLINE_ void InitializeState(_IO_ sm_state_T *state,
 
     state->stateID = STATE_START;
 
+    state->ignoredNestingLevel = -1;
+
     /*  state->BestCaseRc            = JSON_RC__OK ; ... No need because of MemSet(0) */
 
     if (IS_FULL_PARSE(parse_pass_type))
@@ -2258,6 +2263,93 @@ static _INLINE_ void InitializeState(_IO_ sm_state_T *state,
     }
 }
 
+/*****************************************************************************/
+/* Runs the state machine over the input, one token at a time.               */
+/* Unless end_of_input is set, reaching the end of the input only means that */
+/*  more input is to come, so no END_OF_FILE token is generated.            */
+/*****************************************************************************/
+static json_rc_T ProcessInput(_IO_ sm_state_T *state, _IO_ sm_func_rc_T *transition_rc, _I_ bool end_of_input)
+{
+    uint8_t token;
+    json_rc_T rc;
+
+    SkipWhitespace(&state->input);
+
+    while (((state->input.position < state->input.dataBufSize) ||
+            (end_of_input && (state->input.position == state->input.dataBufSize))) &&
+           (state->stateID != STATE_END) && (state->bestCaseRc > JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE) &&
+           (*transition_rc == SM_TRANSITION__SUCCEEDED))
+    {
+        rc = IdentifyToken(state, &token);
+
+        if (rc < JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
+        {
+            return (rc);
+        }
+        else
+        {
+            UpdateBestCaseRc(&state->bestCaseRc, rc);
+        }
+
+        *transition_rc = StateMachineClick(state, token);
+    }
+
+    return (JSON_RC__OK);
+}
+
+/*****************************************************************************/
+static json_rc_T ConcludeParse(_IO_ sm_state_T *state,
+                               __O uint16_t *phase_output_size,
+                               _I_ sm_func_rc_T transition_rc)
+{
+#if defined(ALLOW_PARSING__TEMPLATE) && defined(ALLOW_PARSING__JSON)
+    if (IS_TEMPLATE_PARSE(state->parsePassType))
+#endif
+#if defined(ALLOW_PARSING__TEMPLATE)
+    {
+        json_template_header_T *template_header;
+
+        if (IS_FINAL_PASS(state->parsePassType))
+        {
+            *phase_output_size = state->positionForStrings;
+        }
+        else
+        {
+            template_header = (json_template_header_T *)state->output.dataBuf;
+
+            *phase_output_size = state->output.position; /*@ Use json_header->MaximumSize, json_header->CurrentSize */
+
+            template_header->propertyTableSize = state->output.position - sizeof(json_template_header_T);
+        }
+    }
+#endif /* defined(ALLOW_PARSING__TEMPLATE) */
+#if defined(ALLOW_PARSING__TEMPLATE) && defined(ALLOW_PARSING__JSON)
+    else
+#endif
+#if defined(ALLOW_PARSING__JSON)
+    {
+        json_internal_header_T *json_header = (json_internal_header_T *)state->output.dataBuf;
+
+        *phase_output_size = json_header->currentSize;
+    }
+#endif
+
+    if (state->bestCaseRc > JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
+    {
+        if (state->stateID != STATE_END)
+        {
+            return (JSON_RC__PARSING_FAILURE);
+        }
+
+        if (transition_rc != SM_TRANSITION__SUCCEEDED)
+        {
+            return (JSON_RC__PARSING_FAILURE);
+        }
+    }
+
+    return (state->bestCaseRc);
+}
+
 /*****************************************************************************/
 /* The only syntax-checking done here are:                                   */
 /* 1. Looking for end-of-string according to json_text_len,                  */
@@ -2271,9 +2363,7 @@ json_rc_T ParseCommon(_I_ parse_pass_T parse_pass_type,
                       _I_ uint16_t input_text_size)
 {
     sm_state_T state;
-    uint8_t token;
-    uint16_t properties_counter = 0u;
-    sm_func_rc_T transition_rc  = SM_TRANSITION__SUCCEEDED;
+    sm_func_rc_T transition_rc = SM_TRANSITION__SUCCEEDED;
     json_rc_T rc;
 
 #if defined(ALLOW_PARSING__TEMPLATE) && defined(ALLOW_PARSING__JSON)
@@ -2302,78 +2392,349 @@ json_rc_T ParseCommon(_I_ parse_pass_T parse_pass_type,
 
     InitializeState(&state, output_buf, *phase_output_size, input_text, input_text_size, parse_pass_type);
 
-    SkipWhitespace(&state.input);
-    /*-----------------------------------------------------------------------*/
-    while ((state.input.position <= state.input.dataBufSize) && (state.stateID != STATE_END) &&
-           (state.bestCaseRc > JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE) &&
-           (transition_rc == SM_TRANSITION__SUCCEEDED))
+    rc = ProcessInput(&state, &transition_rc, true);
+
+    if (rc < JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
     {
-        rc = IdentifyToken(&state, &token);
+        return (rc);
+    }
 
-        if (rc < JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
-        {
-            return (rc);
-        }
-        else
-        {
-            UpdateBestCaseRc(&state.bestCaseRc, rc);
-        }
+    return (ConcludeParse(&state, phase_output_size, transition_rc));
+}
 
-        if (token == TOKEN_TYPE__PROPERTY_NAME)
-        {
-            properties_counter++;
-        }
+/*****************************************************************************/
+#if defined(ALLOW_PARSING__JSON)
 
-        transition_rc = StateMachineClick(&state, token);
-    }
-    /*-----------------------------------------------------------------------*/
-#if defined(ALLOW_PARSING__TEMPLATE) && defined(ALLOW_PARSING__JSON)
-    if (IS_TEMPLATE_PARSE(state.parsePassType))
+/*****************************************************************************/
+/* Push-style parsing.                                                       */
+/* The input arrives in chunks, split at arbitrary points.  Characters are   */
+/*  gathered into the token buffer until a whole token is available, and the */
+/*  token is then run through the same state machine as in ParseCommon().    */
+/* Only the state machine (nesting included) and the current token are kept, */
+/*  so the memory needed does not depend on the size of the JSON text.       */
+/*****************************************************************************/
+
+/* Follows the token in the token buffer.  Number scanning does not check the */
+/*  input's size, and stops at any character which cannot be part of a number */
+#define STREAM_TOKEN_SENTINEL 0x7Fu
+
+typedef enum stream_lexer_state_TAG
+{
+    STREAM_LEXER__BETWEEN_TOKENS  = 0x00,
+    STREAM_LEXER__STRING          = 0x01,
+    STREAM_LEXER__STRING_ESCAPE   = 0x02,
+    STREAM_LEXER__EXPECT_COLON    = 0x03, /* Property-name is complete.  The ':' belongs to its token */
+    STREAM_LEXER__LITERAL         = 0x04, /* Number or keyword - ends at whitespace or at a structural character */
+    STREAM_LEXER__RAW             = 0x05, /* 'raw' property - the whole object is a single token */
+    STREAM_LEXER__IGNORING_LEAVES = 0x06  /* Nesting exceeded - skipping till the nesting level is back */
+} stream_lexer_state_T;
+
+#ifdef _MSC_VER
+    #pragma warning(disable:4820) /* bytes padding added after data member */
 #endif
-#if defined(ALLOW_PARSING__TEMPLATE)
+
+struct parse_stream_TAG
+{
+    sm_state_T state;
+    sm_func_rc_T transitionRc;
+    json_rc_T rc;
+    stream_lexer_state_T lexerState;
+    int32_t nestingLevel; /* For STREAM_LEXER__RAW and STREAM_LEXER__IGNORING_LEAVES */
+    uint8_t *tokenBuf;
+    uint16_t tokenBufSize; /* Not including the sentinel */
+    uint16_t tokenLen;
+};
+
+#ifdef _MSC_VER
+    #pragma warning(default:4820)
+#endif
+
+/*****************************************************************************/
+static _INLINE_ bool IsStructuralCharacter(_I_ uint8_t character)
+{
+    return ((character == '{') || (character == '}') || (character == '[') || (character == ']') ||
+            (character == ',') || (character == ':'));
+}
+
+/*****************************************************************************/
+static json_rc_T StreamStatus(_I_ parse_stream_T *stream)
+{
+    if (stream->rc < JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
     {
-        json_template_header_T *template_header;
+        return (stream->rc);
+    }
 
-        if (IS_FINAL_PASS(state.parsePassType))
-        {
-            *phase_output_size = state.positionForStrings;
-        }
-        else
-        {
-            template_header = (json_template_header_T *)output_buf;
+    if (stream->state.bestCaseRc < JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
+    {
+        return (stream->state.bestCaseRc);
+    }
 
-            *phase_output_size = state.output.position; /*@ Use json_header->MaximumSize, json_header->CurrentSize */
+    if (stream->transitionRc != SM_TRANSITION__SUCCEEDED)
+    {
+        return (JSON_RC__PARSING_FAILURE);
+    }
 
-            template_header->propertyTableSize = state.output.position - sizeof(json_template_header_T);
-        }
+    return (JSON_RC__OK);
+}
+
+/*****************************************************************************/
+static _INLINE_ void StreamAppendToToken(_IO_ parse_stream_T *stream, _I_ uint8_t character)
+{
+    if (stream->tokenLen >= stream->tokenBufSize)
+    {
+        stream->rc = JSON_RC__PARSING_BUFFER_SIZE_EXCEEDED;
+
+        return;
     }
-#endif /* defined(ALLOW_PARSING__TEMPLATE) */
-#if defined(ALLOW_PARSING__TEMPLATE) && defined(ALLOW_PARSING__JSON)
-    else
-#endif
-#if defined(ALLOW_PARSING__JSON)
+
+    stream->tokenBuf[stream->tokenLen++] = character;
+}
+
+/*****************************************************************************/
+static void StreamFlushToken(_IO_ parse_stream_T *stream)
+{
+    json_rc_T rc;
+
+    stream->lexerState = STREAM_LEXER__BETWEEN_TOKENS;
+
+    if (stream->rc < JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
     {
-        json_internal_header_T *json_header = (json_internal_header_T *)output_buf;
+        return;
+    }
 
-        *phase_output_size = json_header->currentSize;
+    stream->tokenBuf[stream->tokenLen] = STREAM_TOKEN_SENTINEL;
+
+    stream->state.input.dataBuf     = stream->tokenBuf;
+    stream->state.input.dataBufSize = stream->tokenLen;
+    stream->state.input.position    = 0u;
+
+    rc = ProcessInput(&stream->state, &stream->transitionRc, false);
+
+    if (rc < JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
+    {
+        stream->rc = rc;
     }
-#endif
 
-    if (state.bestCaseRc > JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
+    stream->tokenLen = 0u;
+
+    /*******************************************************************/
+    /* Nesting exceeded ==> Leaves are ignored, including those in the */
+    /*  input still to come.                                           */
+    /*******************************************************************/
+    if (stream->state.ignoredNestingLevel >= 0)
     {
-        if (state.stateID != STATE_END)
-        {
-            return (JSON_RC__PARSING_FAILURE);
-        }
+        stream->nestingLevel = stream->state.ignoredNestingLevel;
+        stream->lexerState   = STREAM_LEXER__IGNORING_LEAVES;
 
-        if (transition_rc != SM_TRANSITION__SUCCEEDED)
+        stream->state.ignoredNestingLevel = -1;
+    }
+}
+
+/*****************************************************************************/
+uint16_t ParseStreamContextSize(void)
+{
+    return (sizeof(parse_stream_T));
+}
+
+/*****************************************************************************/
+json_rc_T ParseStreamBegin(__O parse_stream_T *stream,
+                           _IO_ void *output_buf,
+                           _I_ uint16_t output_buf_size,
+                           _IO_ uint8_t *token_buf,
+                           _I_ uint16_t token_buf_size)
+{
+    if (output_buf_size < sizeof(json_internal_header_T))
+    {
+        return (JSON_RC__PARSING_BUFFER_SIZE_EXCEEDED);
+    }
+
+    if (token_buf_size < 2u) /* At least one character, and the sentinel */
+    {
+        return (JSON_RC__PARSING_BUFFER_SIZE_EXCEEDED);
+    }
+
+    InitializeState(&stream->state, output_buf, output_buf_size, NULL, 0u, PARSE_PASS__JSON);
+
+    stream->transitionRc = SM_TRANSITION__SUCCEEDED;
+    stream->rc           = JSON_RC__OK;
+    stream->lexerState   = STREAM_LEXER__BETWEEN_TOKENS;
+    stream->nestingLevel = 0;
+    stream->tokenBuf     = token_buf;
+    stream->tokenBufSize = token_buf_size - 1u;
+    stream->tokenLen     = 0u;
+
+    return (JSON_RC__OK);
+}
+
+/*****************************************************************************/
+json_rc_T ParseStreamFeed(_IO_ parse_stream_T *stream, _I_ char *input_text, _I_ uint16_t input_text_size)
+{
+    in_data_stream_cb_T leaves;
+    uint16_t position = 0u;
+    uint8_t character;
+
+    while ((position < input_text_size) && (StreamStatus(stream) == JSON_RC__OK))
+    {
+        character = (uint8_t)input_text[position];
+
+        switch (stream->lexerState)
         {
-            return (JSON_RC__PARSING_FAILURE);
+            case STREAM_LEXER__BETWEEN_TOKENS:
+                if (character > ' ')
+                {
+                    StreamAppendToToken(stream, character);
+
+                    if (character == '"')
+                    {
+                        stream->lexerState = STREAM_LEXER__STRING;
+                    }
+                    else if ((character == '{') && IsRawTypeExpected(&stream->state))
+                    {
+                        stream->lexerState   = STREAM_LEXER__RAW;
+                        stream->nestingLevel = 0;
+                    }
+                    else if (IsStructuralCharacter(character))
+                    {
+                        StreamFlushToken(stream);
+                    }
+                    else
+                    {
+                        stream->lexerState = STREAM_LEXER__LITERAL;
+                    }
+                }
+                position++;
+                break;
+
+            case STREAM_LEXER__STRING:
+                StreamAppendToToken(stream, character);
+
+                if (character == '\\')
+                {
+                    stream->lexerState = STREAM_LEXER__STRING_ESCAPE;
+                }
+                else if (character == '"')
+                {
+                    if ((stream->state.stateID == STATE_OBJECT_VALUE) || (stream->state.stateID == STATE_ARRAY_VALUE))
+                    {
+                        StreamFlushToken(stream);
+                    }
+                    else
+                    {
+                        stream->lexerState = STREAM_LEXER__EXPECT_COLON;
+                    }
+                }
+                position++;
+                break;
+
+            case STREAM_LEXER__STRING_ESCAPE:
+                StreamAppendToToken(stream, character);
+
+                stream->lexerState = STREAM_LEXER__STRING;
+                position++;
+                break;
+
+            case STREAM_LEXER__EXPECT_COLON:
+                if (character == ':')
+                {
+                    StreamAppendToToken(stream, character);
+                    StreamFlushToken(stream);
+                    position++;
+                }
+                else if (character <= ' ')
+                {
+                    position++;
+                }
+                else
+                {
+                    /* Missing ':' - let the state machine decide. The character is not consumed */
+                    StreamFlushToken(stream);
+                }
+                break;
+
+            case STREAM_LEXER__LITERAL:
+                if ((character <= ' ') || (character == '"') || IsStructuralCharacter(character))
+                {
+                    /* The character is not consumed */
+                    StreamFlushToken(stream);
+                }
+                else
+                {
+                    StreamAppendToToken(stream, character);
+                    position++;
+                }
+                break;
+
+            case STREAM_LEXER__RAW:
+                StreamAppendToToken(stream, character);
+
+                if ((character == '{') || (character == '['))
+                {
+                    stream->nestingLevel++;
+                }
+                else if ((character == '}') || (character == ']'))
+                {
+                    stream->nestingLevel--;
+                }
+
+                if (stream->nestingLevel < 0)
+                {
+                    StreamFlushToken(stream);
+                }
+                position++;
+                break;
+
+            case STREAM_LEXER__IGNORING_LEAVES:
+            default:
+                leaves.dataBuf     = (const uint8_t *)input_text;
+                leaves.dataBufSize = input_text_size;
+                leaves.position    = position;
+
+                stream->nestingLevel = IgnoreCurrentAndHigherNestingLeaves(&leaves, stream->nestingLevel);
+
+                position = leaves.position;
+
+                if (stream->nestingLevel < 0)
+                {
+                    stream->lexerState = STREAM_LEXER__BETWEEN_TOKENS;
+                }
+                break;
         }
     }
 
-    return (state.bestCaseRc);
+    return (StreamStatus(stream));
 }
+
+/*****************************************************************************/
+json_rc_T ParseStreamEnd(_IO_ parse_stream_T *stream, __O uint16_t *phase_output_size)
+{
+    /********************************************************************/
+    /* A pending token ends with the input.  An incomplete string or    */
+    /*  raw value is handled just as at the end of a ParseCommon() text */
+    /********************************************************************/
+    if ((stream->lexerState != STREAM_LEXER__BETWEEN_TOKENS) &&
+        (stream->lexerState != STREAM_LEXER__IGNORING_LEAVES))
+    {
+        StreamFlushToken(stream);
+    }
+
+    if (stream->rc > JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
+    {
+        stream->state.input.dataBuf     = stream->tokenBuf;
+        stream->state.input.dataBufSize = 0u;
+        stream->state.input.position    = 0u;
+
+        stream->rc = ProcessInput(&stream->state, &stream->transitionRc, true);
+    }
+
+    if (stream->rc < JSON_RC__RECOVERABLE_ERROR__MINIMUM_VALUE)
+    {
+        return (stream->rc);
+    }
+
+    return (ConcludeParse(&stream->state, phase_output_size, stream->transitionRc));
+}
+
+#endif /* defined(ALLOW_PARSING__JSON) */
 /*****************************************************************************/
 /*****************************************************************************/
 /*****************************************************************************/
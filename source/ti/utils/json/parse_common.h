@@ -325,6 +325,28 @@ json_rc_T ParseCommon(_I_ parse_pass_T parse_pass_type,
                       _I_ char *input_text, /* JSON OR partly templetized JSON */
                       _I_ uint16_t input_text_size);
 
+#if defined(ALLOW_PARSING__JSON)
+
+/*****************************************************************************/
+/* Push-style counterpart of ParseCommon(PARSE_PASS__JSON, ...).             */
+/* The JSON text is fed in chunks which may be split at any character.       */
+/* token_buf must hold the longest single token (string with its quotes,     */
+/*  number, keyword, or whole 'raw' value) plus one character.               */
+/*****************************************************************************/
+uint16_t ParseStreamContextSize(void);
+
+json_rc_T ParseStreamBegin(__O parse_stream_T *stream,
+                           _IO_ void *output_buf, /* Internal Representation, already initialized */
+                           _I_ uint16_t output_buf_size,
+                           _IO_ uint8_t *token_buf,
+                           _I_ uint16_t token_buf_size);
+
+json_rc_T ParseStreamFeed(_IO_ parse_stream_T *stream, _I_ char *input_text, _I_ uint16_t input_text_size);
+
+json_rc_T ParseStreamEnd(_IO_ parse_stream_T *stream, __O uint16_t *phase_output_size);
+
+#endif /* defined(ALLOW_PARSING__JSON) */
+
 #ifdef __cplusplus
 }
 #endif
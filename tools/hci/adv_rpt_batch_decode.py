@@ -0,0 +1,311 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024, Texas Instruments Incorporated - http://www.ti.com
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# *  Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+# *  Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# *  Neither the name of Texas Instruments Incorporated nor the names of
+#    its contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+# THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+# OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+# WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+# OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+"""Decode advertising reports from an HCI event capture.
+
+The host TL forwards each GAP advertising report as an
+HCI_EXT_GAP_ADV_SCAN_EVENT (0x0613) carrying GAP_EVT_ADV_REPORT. When built
+with HOST_TL_ADV_RPT_BATCH it packs several reports into one
+HCI_EXT_GAP_ADV_RPT_BATCH_EVENT (0x0627) instead:
+
+    opcode (2)  status (1)  numReports (1)  report * numReports
+
+Every report uses the same 24 byte layout as in HCI_EXT_GAP_ADV_SCAN_EVENT,
+followed by dataLen bytes of advertising data:
+
+    evtType addrType addr(6) primPhy secPhy advSid txPower rssi
+    directAddrType directAddr(6) periodicAdvInt(2) dataLen(2)
+
+Batches of more than 255 bytes are sent as HCI extended events (packet type
+0x05 with a two byte length). Both formats decode to the same report list.
+
+The capture is the controller-to-host byte stream (H4 framing), either raw
+binary or hex text. Other packets are skipped.
+
+With --replay the reports of a capture are packed again the way the target
+does, so the number of UART events and bytes saved by a given batch length
+and RSSI threshold can be checked, and the packed stream is decoded back and
+compared with the input.
+
+Usage:
+    adv_rpt_batch_decode.py capture.bin
+    adv_rpt_batch_decode.py capture.txt --hex
+    adv_rpt_batch_decode.py capture.bin --replay --batch-len 255 --rssi-delta 3
+"""
+
+import argparse
+import struct
+import sys
+
+HCI_EVENT_PACKET = 0x04
+HCI_EXTENDED_EVENT_PACKET = 0x05
+HCI_VE_EVENT_CODE = 0xFF
+
+HCI_EXT_GAP_ADV_SCAN_EVENT = 0x0613
+HCI_EXT_GAP_ADV_RPT_BATCH_EVENT = 0x0627
+
+GAP_EVT_ADV_REPORT = 1 << 22
+
+REPORT_FMT = '<BB6sBBBbbB6sHH'
+REPORT_LEN = struct.calcsize(REPORT_FMT)
+REPORT_FIELDS = ('evtType', 'addrType', 'addr', 'primPhy', 'secPhy',
+                 'advSid', 'txPower', 'rssi', 'directAddrType',
+                 'directAddr', 'periodicAdvInt')
+
+# evtType bits 5-6: data status, 0 when the report is complete
+EVT_TYPE_DATA_STATUS = 0x60
+
+BATCH_HDR_LEN = 4
+# Larger reports are split across several HCI_EXT_GAP_ADV_SCAN_EVENTs
+MAX_REPORT_DATA_SIZE = 200
+BATCH_MAX_REPORTS = 0xFF
+
+
+class DecodeError(Exception):
+    pass
+
+
+def parse_report(buf, off):
+    """Return (report dict, offset past the report)."""
+    if off + REPORT_LEN > len(buf):
+        raise DecodeError('truncated report at offset %d' % off)
+    fields = struct.unpack_from(REPORT_FMT, buf, off)
+    rpt = dict(zip(REPORT_FIELDS, fields[:-1]))
+    data_len = fields[-1]
+    off += REPORT_LEN
+    if off + data_len > len(buf):
+        raise DecodeError('truncated report data at offset %d' % off)
+    rpt['data'] = bytes(buf[off:off + data_len])
+    return rpt, off + data_len
+
+
+def build_report(rpt):
+    return struct.pack(REPORT_FMT, *([rpt[f] for f in REPORT_FIELDS] +
+                                     [len(rpt['data'])])) + rpt['data']
+
+
+def hci_events(stream):
+    """Yield the parameters of every vendor specific event in stream."""
+    off = 0
+    while off < len(stream):
+        pkt = stream[off]
+        if pkt == HCI_EVENT_PACKET and off + 3 <= len(stream):
+            code, plen = stream[off + 1], stream[off + 2]
+            params = stream[off + 3:off + 3 + plen]
+            off += 3 + plen
+            if code == HCI_VE_EVENT_CODE and len(params) == plen:
+                yield params
+        elif pkt == HCI_EXTENDED_EVENT_PACKET and off + 3 <= len(stream):
+            plen = stream[off + 1] | (stream[off + 2] << 8)
+            params = stream[off + 3:off + 3 + plen]
+            off += 3 + plen
+            if len(params) == plen:
+                yield params
+        else:
+            # Not an event, resynchronize on the next byte
+            off += 1
+
+
+def decode(stream):
+    """Return (reports, number of events carrying them)."""
+    reports = []
+    events = 0
+    pending = None
+    for params in hci_events(stream):
+        if len(params) < 3:
+            continue
+        opcode = params[0] | (params[1] << 8)
+        if opcode == HCI_EXT_GAP_ADV_RPT_BATCH_EVENT:
+            if len(params) < BATCH_HDR_LEN:
+                raise DecodeError('truncated batch header')
+            off = BATCH_HDR_LEN
+            for _ in range(params[3]):
+                rpt, off = parse_report(params, off)
+                reports.append(rpt)
+            if off != len(params):
+                raise DecodeError('%d trailing bytes in batch' % (len(params) - off))
+            events += 1
+        elif opcode == HCI_EXT_GAP_ADV_SCAN_EVENT and len(params) >= 7:
+            event = struct.unpack_from('<I', params, 3)[0]
+            if event != GAP_EVT_ADV_REPORT:
+                continue
+            rpt, _ = parse_report(params, 7)
+            events += 1
+            # Reports above 200 bytes are split, the fragments flagged as
+            # incomplete with more to come
+            if pending is not None:
+                pending['data'] += rpt['data']
+                pending['evtType'] = rpt['evtType']
+                rpt = pending
+            if (rpt['evtType'] & EVT_TYPE_DATA_STATUS) == 0x20:
+                pending = rpt
+                continue
+            pending = None
+            reports.append(rpt)
+    return reports, events
+
+
+def is_duplicate(rpt, table, rssi_delta, table_size):
+    """Mirror host_tl_advBatchIsDuplicate(), updating table."""
+    if rssi_delta == 0 or (rpt['evtType'] & EVT_TYPE_DATA_STATUS):
+        return False
+    key = (rpt['addr'], rpt['addrType'], rpt['evtType'], rpt['advSid'])
+    last = table.get(key)
+    if last is not None and last[1] == rpt['data'] and \
+            abs(rpt['rssi'] - last[0]) < rssi_delta:
+        return True
+    if last is None and len(table) >= table_size:
+        # The target replaces entries round robin, the oldest one here
+        del table[next(iter(table))]
+    table[key] = (rpt['rssi'], rpt['data'])
+    return False
+
+
+def unbatched(rpt):
+    """Return rpt as HCI_EXT_GAP_ADV_SCAN_EVENTs, split as the target does."""
+    out = bytearray()
+    data = rpt['data']
+    off = 0
+    while True:
+        frag = dict(rpt, data=data[off:off + MAX_REPORT_DATA_SIZE])
+        off += len(frag['data'])
+        if off < len(data):
+            frag['evtType'] = (rpt['evtType'] & ~EVT_TYPE_DATA_STATUS) | 0x20
+        params = struct.pack('<HBI', HCI_EXT_GAP_ADV_SCAN_EVENT, 0,
+                             GAP_EVT_ADV_REPORT) + build_report(frag)
+        out.extend(bytes((HCI_EVENT_PACKET, HCI_VE_EVENT_CODE, len(params))))
+        out.extend(params)
+        if off >= len(data):
+            return bytes(out)
+
+
+def pack(reports, batch_len, rssi_delta, table_size):
+    """Pack reports as the target does, without the flush timer."""
+    out = bytearray()
+    body = bytearray()
+    count = 0
+    events = 0
+    forwarded = []
+    table = {}
+
+    def flush():
+        nonlocal body, count, events
+        if count == 0:
+            return
+        params = struct.pack('<HBB', HCI_EXT_GAP_ADV_RPT_BATCH_EVENT, 0, count) + body
+        if len(params) < 0x100:
+            out.extend(bytes((HCI_EVENT_PACKET, HCI_VE_EVENT_CODE, len(params))))
+        else:
+            out.extend(struct.pack('<BH', HCI_EXTENDED_EVENT_PACKET, len(params)))
+        out.extend(params)
+        body = bytearray()
+        count = 0
+        events += 1
+
+    for rpt in reports:
+        if is_duplicate(rpt, table, rssi_delta, table_size):
+            continue
+        forwarded.append(rpt)
+        rec = build_report(rpt)
+        if len(rec) > batch_len - BATCH_HDR_LEN:
+            # Sent on its own after the queued reports, as without batching
+            flush()
+            out.extend(unbatched(rpt))
+            events += (len(rpt['data']) + MAX_REPORT_DATA_SIZE - 1) // MAX_REPORT_DATA_SIZE
+            continue
+        if BATCH_HDR_LEN + len(body) + len(rec) > batch_len:
+            flush()
+        body += rec
+        count += 1
+        if count == BATCH_MAX_REPORTS:
+            flush()
+    flush()
+    return bytes(out), events, forwarded
+
+
+def read_capture(path, is_hex):
+    with open(path, 'rb') as f:
+        raw = f.read()
+    if is_hex:
+        return bytes.fromhex(''.join(raw.decode('ascii').split()))
+    return raw
+
+
+def format_report(rpt):
+    addr = ':'.join('%02X' % b for b in reversed(rpt['addr']))
+    return '%s type=%d evt=0x%02X sid=%d rssi=%d phy=%d/%d len=%d %s' % (
+        addr, rpt['addrType'], rpt['evtType'], rpt['advSid'], rpt['rssi'],
+        rpt['primPhy'], rpt['secPhy'], len(rpt['data']), rpt['data'].hex())
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('capture', help='controller to host H4 byte stream')
+    parser.add_argument('--hex', action='store_true',
+                        help='the capture is hex text instead of binary')
+    parser.add_argument('--replay', action='store_true',
+                        help='pack the reports again and report the savings')
+    parser.add_argument('--batch-len', type=int, default=255,
+                        help='HOST_TL_ADV_BATCH_LEN (default 255)')
+    parser.add_argument('--rssi-delta', type=int, default=0,
+                        help='HOST_TL_ADV_BATCH_RSSI_DELTA (default 0)')
+    parser.add_argument('--dup-table', type=int, default=16,
+                        help='HOST_TL_ADV_DUP_TBL_SIZE (default 16)')
+    args = parser.parse_args(argv)
+
+    try:
+        stream = read_capture(args.capture, args.hex)
+        reports, events = decode(stream)
+
+        if not args.replay:
+            for rpt in reports:
+                print(format_report(rpt))
+            print('%d reports in %d events' % (len(reports), events),
+                  file=sys.stderr)
+            return 0
+
+        packed, batch_events, forwarded = pack(reports, args.batch_len,
+                                               args.rssi_delta, args.dup_table)
+        decoded, _ = decode(packed)
+        if decoded != forwarded:
+            raise DecodeError('packed stream does not decode to the input reports')
+        in_bytes = sum(3 + len(p) for p in hci_events(stream))
+        print('reports   %d in, %d forwarded' % (len(reports), len(forwarded)))
+        print('events    %d in, %d batched' % (events, batch_events))
+        print('bytes     %d in, %d batched' % (in_bytes, len(packed)))
+    except (DecodeError, OSError, ValueError) as e:
+        print('error: %s' % e, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,305 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024, Texas Instruments Incorporated - http://www.ti.com
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# *  Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+# *  Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# *  Neither the name of Texas Instruments Incorporated nor the names of
+#    its contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+# THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+# OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+# WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+# OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""Decode frames produced by LogSinkCompact_read().
+
+The frame and record layout is described in source/ti/log/LogSinkCompact.h.
+Metadata strings are looked up in the .log_ptr and .log_data sections of the
+application ELF file, so only the standard library is required.
+
+Usage:
+    logsinkcompact_decode.py app.out frames.bin
+    logsinkcompact_decode.py app.out - < /dev/ttyACM0
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+FRAME_SYNC = 0xC7
+VARINT_MAX = 5
+
+OPCODE_BUFFER = "LOG_OPCODE_BUFFER"
+
+
+class DecodeError(Exception):
+    pass
+
+
+def read_varint(data, pos):
+    """Return (value, new position) for the LEB128 varint at data[pos]."""
+    value = 0
+    for i in range(VARINT_MAX):
+        if pos >= len(data):
+            raise DecodeError("truncated varint")
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << (7 * i)
+        if not byte & 0x80:
+            return value & 0xFFFFFFFF, pos
+    raise DecodeError("varint too long")
+
+
+def unzigzag(value):
+    """Undo the zigzag mapping, returning the raw 32-bit argument."""
+    return ((value >> 1) ^ -(value & 1)) & 0xFFFFFFFF
+
+
+class ElfSections:
+    """Minimal reader for the section headers of an ELF file."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.image = f.read()
+        if self.image[:4] != b"\x7fELF":
+            raise DecodeError("%s is not an ELF file" % path)
+        self.is64 = self.image[4] == 2
+        self.endian = "<" if self.image[5] == 1 else ">"
+        self.ptr_size = 8 if self.is64 else 4
+        self.sections = {}
+        self._read_sections()
+
+    def _read_sections(self):
+        e = self.endian
+        if self.is64:
+            shoff, = struct.unpack_from(e + "Q", self.image, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(e + "HHH", self.image, 0x3A)
+            fmt = e + "IIQQQQIIQQ"
+        else:
+            shoff, = struct.unpack_from(e + "I", self.image, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(e + "HHH", self.image, 0x2E)
+            fmt = e + "IIIIIIIIII"
+
+        headers = [struct.unpack_from(fmt, self.image, shoff + i * shentsize) for i in range(shnum)]
+        strtab = headers[shstrndx]
+        for sh in headers:
+            name_off, sh_type, _, addr, offset, size = sh[:6]
+            start = strtab[4] + name_off
+            name = self.image[start:self.image.index(b"\0", start)].decode()
+            # SHT_NOBITS sections have no contents in the file
+            contents = b"" if sh_type == 8 else self.image[offset:offset + size]
+            self.sections[name] = (addr, contents)
+
+    def section(self, name):
+        if name not in self.sections:
+            raise DecodeError("ELF file has no %s section" % name)
+        return self.sections[name]
+
+
+class Metadata:
+    """Log call site metadata as emitted by _Log_PLACE_FORMAT_IN_SECTOR."""
+
+    FIELDS = ("opcode", "file", "line", "level", "module", "format", "nargs")
+
+    def __init__(self, raw):
+        parts = raw.split("\x1e")
+        if len(parts) != len(self.FIELDS):
+            raise DecodeError("malformed metadata string %r" % raw)
+        for name, value in zip(self.FIELDS, parts):
+            setattr(self, name, _unquote(value))
+        self.nargs = int(self.nargs)
+        if self.module.startswith("LogMod_"):
+            self.module = self.module[len("LogMod_"):]
+
+
+def _unquote(token):
+    """Strip the quotes and escapes added by stringizing a string literal."""
+    token = token.strip()
+    if len(token) >= 2 and token[0] == '"' and token[-1] == '"':
+        # Adjacent literals such as "a" "b" stringize to "\"a\" \"b\""
+        token = "".join(re.findall(r'"((?:[^"\\]|\\.)*)"', token))
+        token = token.encode("latin-1").decode("unicode_escape")
+    return token
+
+
+class MetadataTable:
+    """Maps record slots to call site metadata."""
+
+    def __init__(self, elf, ptr_base=None):
+        data_addr, data = elf.section(".log_data")
+        ptr_addr, ptrs = elf.section(".log_ptr")
+        fmt = elf.endian + ("Q" if elf.ptr_size == 8 else "I")
+
+        self.ptr_base = ptr_addr if ptr_base is None else ptr_base
+        skip = (self.ptr_base - ptr_addr) // elf.ptr_size
+        self.slots = []
+        for off in range(max(skip, 0) * elf.ptr_size, len(ptrs), elf.ptr_size):
+            target, = struct.unpack_from(fmt, ptrs, off)
+            start = target - data_addr
+            if start < 0 or start >= len(data):
+                self.slots.append(None)
+                continue
+            end = data.index(b"\0", start)
+            self.slots.append(Metadata(data[start:end].decode("latin-1")))
+
+    def lookup(self, slot):
+        if slot >= len(self.slots) or self.slots[slot] is None:
+            raise DecodeError("unknown metadata slot %d" % slot)
+        return self.slots[slot]
+
+
+_SPEC = re.compile(r"%([-+ #0]*)(\d*|\*)(?:\.(\d+))?(hh|h|ll|l|z|t|j)?([diouxXcsp%])")
+
+
+def format_printf(fmt, args):
+    """Apply 32-bit Log_printf arguments to a C format string."""
+    args = list(args)
+
+    def repl(m):
+        flags, width, prec, _, conv = m.groups()
+        if conv == "%":
+            return "%"
+        if not args:
+            return m.group(0)
+        value = args.pop(0)
+        if conv in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            conv = "d"
+        elif conv == "u":
+            conv = "d"
+        elif conv == "c":
+            value = chr(value & 0xFF)
+        elif conv in "sp":
+            # String arguments are target addresses that cannot be resolved
+            return "0x%08x" % value
+        spec = "%" + flags + (width if width != "*" else "") + ("." + prec if prec else "") + conv
+        return spec % value
+
+    return _SPEC.sub(repl, fmt)
+
+
+class Record:
+    def __init__(self, timestamp, meta, args=None, data=None):
+        self.timestamp = timestamp
+        self.meta = meta
+        self.args = args
+        self.data = data
+
+    def text(self):
+        if self.data is not None:
+            return "%s %s" % (self.meta.format, self.data.hex(" "))
+        return format_printf(self.meta.format, self.args)
+
+
+def parse_record(rec, table):
+    """Return (slot, delta, metadata, payload) of a single record body."""
+    slot, pos = read_varint(rec, 0)
+    delta, pos = read_varint(rec, pos)
+    meta = table.lookup(slot)
+
+    if meta.opcode == OPCODE_BUFFER:
+        size, pos = read_varint(rec, pos)
+        if pos + size != len(rec):
+            raise DecodeError("buffer record size mismatch")
+        return delta, meta, None, bytes(rec[pos:])
+
+    args = []
+    while pos < len(rec):
+        value, pos = read_varint(rec, pos)
+        args.append(unzigzag(value))
+    if len(args) != meta.nargs:
+        raise DecodeError("expected %d arguments, got %d" % (meta.nargs, len(args)))
+    return delta, meta, args, None
+
+
+def decode_stream(stream, table):
+    """Yield Record objects and (dropped count) integers from raw frame bytes.
+
+    Bytes that do not form a valid frame are skipped until the next sync byte,
+    so decoding resumes after a corrupted or truncated transfer.
+    """
+    pos = 0
+    while True:
+        pos = stream.find(bytes([FRAME_SYNC]), pos)
+        if pos < 0:
+            return
+        try:
+            length, body = read_varint(stream, pos + 1)
+            end = body + length
+            if end > len(stream):
+                return
+            timestamp, p = read_varint(stream, body)
+            dropped, p = read_varint(stream, p)
+            records = []
+            while p < end:
+                rec_len, p = read_varint(stream, p)
+                if p + rec_len > end:
+                    raise DecodeError("record overruns frame")
+                delta, meta, args, data = parse_record(stream[p:p + rec_len], table)
+                timestamp = (timestamp + delta) & 0xFFFFFFFF
+                records.append(Record(timestamp, meta, args, data))
+                p += rec_len
+        except DecodeError:
+            pos += 1
+            continue
+
+        if dropped:
+            yield dropped
+        for record in records:
+            yield record
+        pos = end
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode LogSinkCompact frames")
+    parser.add_argument("elf", help="application ELF file (.out)")
+    parser.add_argument("input", help="file with raw frames, or - for stdin")
+    parser.add_argument("--ptr-base", type=lambda v: int(v, 0),
+                        help="LogSinkCompact_LOG_PTR_BASE if it differs from the .log_ptr address")
+    parser.add_argument("--tick-us", type=float,
+                        help="timestamp tick period in microseconds; ticks are printed if omitted")
+    opts = parser.parse_args()
+
+    table = MetadataTable(ElfSections(opts.elf), opts.ptr_base)
+    if opts.input == "-":
+        stream = sys.stdin.buffer.read()
+    else:
+        with open(opts.input, "rb") as f:
+            stream = f.read()
+
+    for item in decode_stream(stream, table):
+        if isinstance(item, int):
+            print("*** %d record(s) dropped" % item)
+            continue
+        if opts.tick_us:
+            stamp = "%14.3f us" % (item.timestamp * opts.tick_us)
+        else:
+            stamp = "%10u" % item.timestamp
+        print("%s  [%s] %s: %s" % (stamp, item.meta.module, item.meta.level, item.text()))
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except DecodeError as err:
+        sys.exit("error: %s" % err)
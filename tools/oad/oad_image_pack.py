@@ -0,0 +1,301 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024, Texas Instruments Incorporated - http://www.ti.com
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# *  Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+# *  Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# *  Neither the name of Texas Instruments Incorporated nor the names of
+#    its contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+# THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+# OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+# WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+# OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""Pack an MCUboot image into the compressed OAD stream.
+
+The stream is decoded on the target by SwUpdate_WriteBlock() once the peer
+selected the format with the OAD_REQ_SET_IMG_FORMAT control command. It is
+a sequence of commands, each one starting with a token byte: the top two
+bits are the op-code and the low six bits the length, 63 meaning that a
+LEB128 varint with the rest of the length follows.
+
+    0  literal      length + 1 bytes follow the token
+    1  copy         length + 4 bytes, varint distance back in the new image
+    2  copy base    length + 4 bytes from the running image, varint zigzag
+                    delta from the offset being written
+
+Without --base the stream only uses literals and copies (format 1). With
+--base, the image running on the target, copies from it are used as well
+(format 2); the target must run exactly that image.
+
+Usage:
+    oad_image_pack.py app_v2.bin app_v2.oadz
+    oad_image_pack.py app_v2.bin app_v2.oadd --base app_v1.bin --verify
+"""
+
+import argparse
+import sys
+
+OP_LITERAL = 0
+OP_COPY = 1
+OP_COPY_BASE = 2
+
+LEN_MASK = 0x3F
+MIN_COPY = 4
+VARINT_MAX = 5
+
+FORMAT_PACKED = 1
+FORMAT_DELTA = 2
+
+IMAGE_MAGIC = 0x96F3B83D
+IMAGE_TLV_INFO_MAGIC = 0x6907
+
+HASH_LEN = 4
+CHAIN_DEPTH = 32
+
+
+class DecodeError(Exception):
+    pass
+
+
+def write_varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def read_varint(data, pos):
+    """Return (value, new position) for the LEB128 varint at data[pos]."""
+    value = 0
+    for shift in range(0, 7 * VARINT_MAX, 7):
+        if pos >= len(data):
+            raise DecodeError("truncated varint")
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, pos
+    raise DecodeError("varint too long")
+
+
+def zigzag(delta):
+    return (delta << 1) if delta >= 0 else ((-delta << 1) - 1)
+
+
+def unzigzag(value):
+    return (value >> 1) if not value & 1 else -((value >> 1) + 1)
+
+
+def token(op, length, bias):
+    """Encode the token, and the varint length if needed, of a command."""
+    n = length - bias
+    if n < LEN_MASK:
+        return bytes([(op << 6) | n])
+    return bytes([(op << 6) | LEN_MASK]) + write_varint(n - LEN_MASK)
+
+
+def image_length(image):
+    """Length of the MCUboot image up to the end of its TLV area, the length
+    the target downloads and verifies, or the file length."""
+    if len(image) >= 16 and int.from_bytes(image[0:4], "little") == IMAGE_MAGIC:
+        hdr_size = int.from_bytes(image[8:10], "little")
+        protect_tlv_size = int.from_bytes(image[10:12], "little")
+        img_size = int.from_bytes(image[12:16], "little")
+        length = hdr_size + img_size + protect_tlv_size
+        if (length + 4 <= len(image) and
+                int.from_bytes(image[length:length + 2], "little") == IMAGE_TLV_INFO_MAGIC):
+            length += int.from_bytes(image[length + 2:length + 4], "little")
+        return min(len(image), length)
+    return len(image)
+
+
+class Matcher:
+    """Hash chains over the first HASH_LEN bytes of each position."""
+
+    def __init__(self, data):
+        self.data = data
+        self.chains = {}
+
+    def insert(self, pos):
+        if pos + HASH_LEN <= len(self.data):
+            key = self.data[pos:pos + HASH_LEN]
+            chain = self.chains.setdefault(key, [])
+            chain.append(pos)
+            if len(chain) > 2 * CHAIN_DEPTH:
+                del chain[:CHAIN_DEPTH]
+
+    def candidates(self, key):
+        return reversed(self.chains.get(key, [])[-CHAIN_DEPTH:])
+
+
+def match_length(a, a_pos, b, b_pos, limit):
+    n = 0
+    while n < limit and a[a_pos + n] == b[b_pos + n]:
+        n += 1
+    return n
+
+
+def pack(image, base=None):
+    """Return the packed stream of image."""
+    out = bytearray()
+    literals = bytearray()
+    own = Matcher(image)
+    base_matcher = None
+    if base:
+        base_matcher = Matcher(base)
+        for pos in range(len(base)):
+            base_matcher.insert(pos)
+    last_delta = 0
+
+    def flush_literals():
+        start = 0
+        while start < len(literals):
+            run = literals[start:start + 0x10000]
+            out.extend(token(OP_LITERAL, len(run), 1))
+            out.extend(run)
+            start += len(run)
+        literals.clear()
+
+    pos = 0
+    while pos < len(image):
+        best_len, best_cmd = 0, None
+        remaining = len(image) - pos
+        key = image[pos:pos + HASH_LEN]
+
+        if remaining >= MIN_COPY:
+            for cand in own.candidates(key):
+                n = match_length(image, cand, image, pos, remaining)
+                cost = 1 + len(write_varint(pos - cand))
+                if n - cost > best_len - (best_cmd[2] if best_cmd else 0):
+                    best_len, best_cmd = n, (OP_COPY, pos - cand, cost)
+            if base_matcher:
+                # The same offset as the previous copy is the usual case,
+                # code moved by a few bytes
+                cands = [pos + last_delta] + list(base_matcher.candidates(key))
+                for cand in cands:
+                    if cand < 0 or cand >= len(base):
+                        continue
+                    n = match_length(base, cand, image, pos,
+                                     min(remaining, len(base) - cand))
+                    arg = zigzag(cand - pos)
+                    cost = 1 + len(write_varint(arg))
+                    if n - cost > best_len - (best_cmd[2] if best_cmd else 0):
+                        best_len, best_cmd = n, (OP_COPY_BASE, arg, cost)
+
+        if best_cmd is None or best_len < MIN_COPY or best_len <= best_cmd[2]:
+            literals.append(image[pos])
+            own.insert(pos)
+            pos += 1
+            continue
+
+        op, arg, _ = best_cmd
+        flush_literals()
+        out.extend(token(op, best_len, MIN_COPY))
+        out.extend(write_varint(arg))
+        if op == OP_COPY_BASE:
+            last_delta = unzigzag(arg)
+        for i in range(pos, pos + best_len):
+            own.insert(i)
+        pos += best_len
+
+    flush_literals()
+    return bytes(out)
+
+
+def unpack(stream, base=None):
+    """Decode a stream the way the target does."""
+    out = bytearray()
+    pos = 0
+    while pos < len(stream):
+        tok = stream[pos]
+        pos += 1
+        op, length = tok >> 6, tok & LEN_MASK
+        if length == LEN_MASK:
+            extra, pos = read_varint(stream, pos)
+            length += extra
+        if op == OP_LITERAL:
+            length += 1
+            if pos + length > len(stream):
+                raise DecodeError("truncated literal")
+            out.extend(stream[pos:pos + length])
+            pos += length
+        elif op in (OP_COPY, OP_COPY_BASE):
+            length += MIN_COPY
+            arg, pos = read_varint(stream, pos)
+            if op == OP_COPY:
+                if arg == 0 or arg > len(out):
+                    raise DecodeError("copy distance out of range")
+                src = len(out) - arg
+                for i in range(length):
+                    out.append(out[src + i])
+            else:
+                if base is None:
+                    raise DecodeError("copy from base without a base image")
+                src = len(out) + unzigzag(arg)
+                if src < 0 or src + length > len(base):
+                    raise DecodeError("copy from base out of range")
+                out.extend(base[src:src + length])
+        else:
+            raise DecodeError("reserved op-code")
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image", help="signed MCUboot image to send")
+    parser.add_argument("output", help="packed stream")
+    parser.add_argument("--base", help="image running on the target")
+    parser.add_argument("--verify", action="store_true",
+                        help="decode the stream and compare with the image")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+    # The target rebuilds exactly the image described by its header
+    image = image[:image_length(image)]
+    base = None
+    if args.base:
+        with open(args.base, "rb") as f:
+            base = f.read()
+        base = base[:image_length(base)]
+
+    stream = pack(image, base)
+
+    if args.verify and unpack(stream, base) != image:
+        sys.exit("error: stream does not decode to the image")
+
+    with open(args.output, "wb") as f:
+        f.write(stream)
+
+    print("format %d, image %d bytes, stream %d bytes (%.1f%%)" % (
+        FORMAT_DELTA if base else FORMAT_PACKED, len(image), len(stream),
+        100.0 * len(stream) / max(len(image), 1)))
+
+
+if __name__ == "__main__":
+    main()